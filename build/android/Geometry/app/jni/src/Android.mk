@@ -20,6 +20,8 @@ LOCAL_C_INCLUDES += $(PROJ_PATH)/source
 LOCAL_PATH = $(PROJ_PATH)
 LOCAL_SRC_FILES := $(subst $(LOCAL_PATH)/,, \
 	$(LOCAL_PATH)/source/GLApp.cpp \
+	$(LOCAL_PATH)/source/GLBenchmark.cpp \
+	$(LOCAL_PATH)/source/GLNetBenchmark.cpp \
 	$(LOCAL_PATH)/source/GLGameScene.cpp \
 	$(LOCAL_PATH)/source/GLInputController.cpp \
 	$(LOCAL_PATH)/source/GLLoadingScene.cpp \
@@ -23,6 +23,7 @@ namespace cugl {
             bool awake;
             bool bullet;
             b2Vec2 linearVelocity;
+            float angularVelocity;
             bool sleepingAllowed;
             bool fixedRotation;
             float gravityScale;
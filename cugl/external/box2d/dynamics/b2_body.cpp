@@ -439,6 +439,65 @@ void b2Body::SetTransform(const b2Vec2& position, float angle)
 	m_world->m_newContacts = true;
 }
 
+void b2Body::SetPose(const b2Vec2& position, float angle, const b2Vec2& linear, float angular)
+{
+	b2Assert(m_world->IsLocked() == false);
+	if (m_world->IsLocked() == true)
+	{
+		return;
+	}
+
+	m_xf.q.Set(angle);
+	m_xf.p = position;
+
+	m_sweep.c = b2Mul(m_xf, m_sweep.localCenter);
+	m_sweep.a = angle;
+
+	m_sweep.c0 = m_sweep.c;
+	m_sweep.a0 = angle;
+
+	if (m_type != b2_staticBody)
+	{
+		m_linearVelocity = linear;
+		m_angularVelocity = angular;
+	}
+
+	m_flags |= e_poseFlag;
+}
+
+void b2Body::SetFrozen(bool flag)
+{
+	b2Assert(m_world->IsLocked() == false);
+	if (m_world->IsLocked() == true || flag == IsFrozen())
+	{
+		return;
+	}
+
+	if (flag)
+	{
+		if (m_type != b2_dynamicBody)
+		{
+			return;
+		}
+
+		// Infinite mass, so the solvers cannot move it
+		m_flags |= e_frozenFlag;
+		m_invMass = 0.0f;
+		m_invI = 0.0f;
+		m_linearVelocity.SetZero();
+		m_angularVelocity = 0.0f;
+		m_force.SetZero();
+		m_torque = 0.0f;
+	}
+	else
+	{
+		// The mass and rotational inertia are kept, so the inverses are easy to restore
+		m_flags &= ~e_frozenFlag;
+		m_invMass = m_mass > 0.0f ? 1.0f / m_mass : 0.0f;
+		m_invI = (m_I > 0.0f && (m_flags & e_fixedRotationFlag) == 0) ? 1.0f / m_I : 0.0f;
+	}
+}
+
 void b2Body::SynchronizeFixtures()
 {
 	b2BroadPhase* broadPhase = &m_world->m_contactManager.m_broadPhase;
@@ -69,6 +69,8 @@ b2World::b2World(const b2Vec2& gravity)
 	m_contactManager.m_allocator = &m_blockAllocator;
 
 	memset(&m_profile, 0, sizeof(b2Profile));
+	m_islandCount = 0;
+	m_toiCount = 0;
 }
 
 b2World::~b2World()
@@ -428,7 +430,7 @@ void b2World::Solve(const b2TimeStep& step)
 			continue;
 		}
 
-		if (seed->IsAwake() == false || seed->IsEnabled() == false)
+		if (seed->IsAwake() == false || seed->IsEnabled() == false || seed->IsFrozen())
 		{
 			continue;
 		}
@@ -454,8 +456,8 @@ void b2World::Solve(const b2TimeStep& step)
 			island.Add(b);
 
 			// To keep islands as small as possible, we don't
-			// propagate islands across static bodies.
-			if (b->GetType() == b2_staticBody)
+			// propagate islands across static (or frozen) bodies.
+			if (b->GetType() == b2_staticBody || b->IsFrozen())
 			{
 				continue;
 			}
@@ -537,6 +539,7 @@ void b2World::Solve(const b2TimeStep& step)
 
 		b2Profile profile;
 		island.Solve(&profile, step, m_gravity, m_allowSleep);
+		++m_islandCount;
 		m_profile.solveInit += profile.solveInit;
 		m_profile.solveVelocity += profile.solveVelocity;
 		m_profile.solvePosition += profile.solvePosition;
@@ -544,9 +547,9 @@ void b2World::Solve(const b2TimeStep& step)
 		// Post solve cleanup.
 		for (int32 i = 0; i < island.m_bodyCount; ++i)
 		{
-			// Allow static bodies to participate in other islands.
+			// Allow static (and frozen) bodies to participate in other islands.
 			b2Body* b = island.m_bodies[i];
-			if (b->GetType() == b2_staticBody)
+			if (b->GetType() == b2_staticBody || b->IsFrozen())
 			{
 				b->m_flags &= ~b2Body::e_islandFlag;
 			}
@@ -648,8 +651,8 @@ void b2World::SolveTOI(const b2TimeStep& step)
 				b2BodyType typeB = bB->m_type;
 				b2Assert(typeA == b2_dynamicBody || typeB == b2_dynamicBody);
 
-				bool activeA = bA->IsAwake() && typeA != b2_staticBody;
-				bool activeB = bB->IsAwake() && typeB != b2_staticBody;
+				bool activeA = bA->IsAwake() && typeA != b2_staticBody && bA->IsFrozen() == false;
+				bool activeB = bB->IsAwake() && typeB != b2_staticBody && bB->IsFrozen() == false;
 
 				// Is at least one body active (awake and dynamic or kinematic)?
 				if (activeA == false && activeB == false)
@@ -743,6 +746,7 @@ void b2World::SolveTOI(const b2TimeStep& step)
 		minContact->Update(m_contactManager.m_contactListener);
 		minContact->m_flags &= ~b2Contact::e_toiFlag;
 		++minContact->m_toiCount;
+		++m_toiCount;
 
 		// Is the contact solid?
 		if (minContact->IsEnabled() == false || minContact->IsTouching() == false)
@@ -905,6 +909,9 @@ void b2World::SolveTOI(const b2TimeStep& step)
 void b2World::Step(float dt, int32 velocityIterations, int32 positionIterations)
 {
 	b2Timer stepTimer;
+	memset(&m_profile, 0, sizeof(b2Profile));
+	m_islandCount = 0;
+	m_toiCount = 0;
 
 	// If new fixtures were added, we need to find the new contacts.
 	if (m_newContacts)
@@ -979,6 +986,45 @@ void b2World::ClearForces()
 	}
 }
 
+int32 b2World::SynchronizePoses()
+{
+	b2Assert(IsLocked() == false);
+	if (IsLocked())
+	{
+		return 0;
+	}
+
+	b2BroadPhase* broadPhase = &m_contactManager.m_broadPhase;
+	int32 count = 0;
+	for (b2Body* body = m_bodyList; body; body = body->GetNext())
+	{
+		if ((body->m_flags & b2Body::e_poseFlag) == 0)
+		{
+			continue;
+		}
+
+		// The pose is not swept, so each AABB only needs to be computed once
+		body->m_flags &= ~b2Body::e_poseFlag;
+		for (b2Fixture* f = body->m_fixtureList; f; f = f->m_next)
+		{
+			for (int32 i = 0; i < f->m_proxyCount; ++i)
+			{
+				b2FixtureProxy* proxy = f->m_proxies + i;
+				f->m_shape->ComputeAABB(&proxy->aabb, body->m_xf, proxy->childIndex);
+				broadPhase->MoveProxy(proxy->proxyId, proxy->aabb, b2Vec2_zero);
+			}
+		}
+		++count;
+	}
+
+	if (count > 0)
+	{
+		// Check for new contacts the next step
+		m_newContacts = true;
+	}
+	return count;
+}
+
 struct b2WorldQueryWrapper
 {
 	bool QueryCallback(int32 proxyId)
@@ -162,6 +162,28 @@ public:
 	/// @param angle the world rotation in radians.
 	void SetTransform(const b2Vec2& position, float angle);
 
+	/// Set the transform and velocities of the body without moving its broad-phase proxies.
+	/// This is a cheap alternative to SetTransform for copying poses in bulk. The proxies
+	/// are deferred until the next call to b2World::SynchronizePoses, which must be called
+	/// before the next call to b2World::Step.
+	/// @param position the world position of the body's local origin.
+	/// @param angle the world rotation in radians.
+	/// @param linear the linear velocity of the center of mass.
+	/// @param angular the angular velocity in radians/second.
+	void SetPose(const b2Vec2& position, float angle, const b2Vec2& linear, float angular);
+
+	/// Hold a dynamic body still, or release it. The solver treats a frozen body like a
+	/// static body: it has infinite mass, it never seeds or joins an island, and its contacts
+	/// are only updated when they touch an active body. This is used to re-simulate a few
+	/// bodies of a large world. Freezing zeroes the velocities, which are not restored on
+	/// release, but it leaves the sleep state alone. Changing the mass of a frozen body
+	/// releases its mass (but not the flag), so do not do that.
+	/// @param flag set to true to freeze the body, false to release it.
+	void SetFrozen(bool flag);
+
+	/// Is this body frozen?
+	bool IsFrozen() const;
+
 	/// Get the body transform for the body's origin.
 	/// @return the world transform of the body's origin.
 	const b2Transform& GetTransform() const;
@@ -417,7 +439,9 @@ private:
 		e_bulletFlag		= 0x0008,
 		e_fixedRotationFlag	= 0x0010,
 		e_enabledFlag		= 0x0020,
-		e_toiFlag			= 0x0040
+		e_toiFlag			= 0x0040,
+		e_poseFlag			= 0x0080,
+		e_frozenFlag		= 0x0100
 	};
 
 	b2Body(const b2BodyDef* bd, b2World* world);
@@ -663,6 +687,11 @@ inline bool b2Body::IsAwake() const
 	return (m_flags & e_awakeFlag) == e_awakeFlag;
 }
 
+inline bool b2Body::IsFrozen() const
+{
+	return (m_flags & e_frozenFlag) == e_frozenFlag;
+}
+
 inline bool b2Body::IsEnabled() const
 {
 	return (m_flags & e_enabledFlag) == e_enabledFlag;
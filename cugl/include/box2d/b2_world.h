@@ -109,6 +109,12 @@ public:
 	/// @see SetAutoClearForces
 	void ClearForces();
 
+	/// Move the broad-phase proxies of all bodies positioned with b2Body::SetPose.
+	/// This is one pass over the body list, and should be called once after a batch of
+	/// SetPose calls and before the next call to Step.
+	/// @return the number of bodies synchronized.
+	int32 SynchronizePoses();
+
 	/// Call this to draw shapes and other debug draw data. This is intentionally non-const.
 	void DebugDraw();
 
@@ -207,9 +213,16 @@ public:
 	/// Get the contact manager for testing.
 	const b2ContactManager& GetContactManager() const;
 
-	/// Get the current profile.
+	/// Get the profile of the last time step. Phases that did not run in the
+	/// last time step are zero.
 	const b2Profile& GetProfile() const;
 
+	/// Get the number of islands solved in the last time step.
+	int32 GetIslandCount() const { return m_islandCount; }
+
+	/// Get the number of time of impact events solved in the last time step.
+	int32 GetTOICount() const { return m_toiCount; }
+
 	/// Dump the world into the log file.
 	/// @warning this should be called outside of a time step.
 	void Dump();
@@ -259,6 +272,8 @@ private:
 	bool m_stepComplete;
 
 	b2Profile m_profile;
+	int32 m_islandCount;
+	int32 m_toiCount;
 };
 
 inline b2Body* b2World::GetBodyList()
@@ -50,6 +50,8 @@
 #include <cugl/util/CUThreadPool.h>
 #include <cugl/util/CUDebug.h>
 #include <cugl/assets/CULoader.h>
+#include <cugl/assets/CUAssetWatcher.h>
+#include <unordered_set>
 #include <typeinfo>
 #include <atomic>
 
@@ -77,6 +79,15 @@ namespace cugl {
  * still be used after an asset manager is destroyed, provided that they still
  * have a smart pointer referencing them.
  *
+ * Assets loaded from a JSON directory can be hot reloaded.  When watching
+ * is enabled (see {@link #startWatching}), the asset manager monitors the
+ * asset files and the directory itself.  When a file changes, only the
+ * assets defined by that file are reloaded, together with any scene that
+ * references them.  Textures are replaced in place, so any existing smart
+ * pointers will see the new image.  All other assets are replaced in the
+ * loader, and so objects should fetch them again when notified by the
+ * reload listener.
+ *
  * IMPORTANT: This class is not even remotely thread-safe.  Do not call any of
  * these methods outside of the main CUGL thread.
  */
@@ -97,6 +108,44 @@ protected:
     
     /** Wait variable to create a load barrier for directories. */
     std::atomic<bool> _wait;
+    
+    /** The directory entries of the loaded assets, by type and key */
+    std::unordered_map<size_t,std::unordered_map<std::string,std::shared_ptr<JsonValue>>> _entries;
+    /** The asset files, mapped to the (type, key) of the assets they define */
+    std::unordered_map<std::string,std::vector<std::pair<size_t,std::string>>> _sources;
+    /** The asset directory files, mapped to their relative paths */
+    std::unordered_map<std::string,std::string> _directories;
+    /** The file watcher for hot reloading (nullptr if not watching) */
+    std::shared_ptr<AssetWatcher> _watcher;
+    /** The listener notified after each asset is hot reloaded */
+    LoaderCallback _reloader;
+    /** The number of completed hot reloads */
+    Uint32 _reloadCount;
+    /** The latency of the most recent hot reload in microseconds */
+    Uint64 _reloadLatency;
+    /** The total latency of all hot reloads in microseconds */
+    Uint64 _reloadTotal;
+
+    /** The memory budget of each asset type in bytes (0 for unlimited) */
+    std::unordered_map<size_t,size_t> _budgets;
+    /** The memory budget of all assets in bytes (0 for unlimited) */
+    size_t _budget;
+    /** The peak memory usage of each asset type in bytes */
+    std::unordered_map<size_t,size_t> _peaks;
+    /** The peak memory usage of all assets in bytes */
+    size_t _peak;
+    /** The keys of the evicted assets, by type */
+    mutable std::unordered_map<size_t,std::unordered_set<std::string>> _evicted;
+    /** The number of assets evicted to meet the budgets */
+    Uint64 _evictCount;
+    /** The number of bytes evicted to meet the budgets */
+    Uint64 _evictBytes;
+    /** The number of evicted assets restored on demand */
+    mutable Uint64 _restoreCount;
+    /** The time that the memory telemetry was last reset */
+    Timestamp _evictStart;
+    /** The main thread, which is the only thread that may restore assets */
+    SDL_threadID _mainThread;
 
     /**
      * Synchronously reads an asset category from a JSON file
@@ -172,6 +221,82 @@ protected:
      */
     bool purgeCategory(size_t hash, const std::shared_ptr<JsonValue>& json);
 
+    /**
+     * Records the directory entries for an asset category
+     *
+     * This method records the entries so that they may be reloaded when
+     * their asset files change.  It must be called in the main thread.
+     *
+     * @param hash  The hash of the asset type
+     * @param json  The child of asset directory with these assets
+     */
+    void recordCategory(size_t hash, const std::shared_ptr<JsonValue>& json);
+    
+    /**
+     * Forgets the directory entries for an asset category
+     *
+     * This method is the inverse of {@link #recordCategory}, and is called
+     * when the assets are unloaded.
+     *
+     * @param hash  The hash of the asset type
+     * @param json  The child of asset directory with these assets
+     */
+    void forgetCategory(size_t hash, const std::shared_ptr<JsonValue>& json);
+    
+    /**
+     * Returns the asset type hash for the given category name
+     *
+     * The category names are the keys of a JSON asset directory (e.g.
+     * "textures"). This method returns 0 if the category is unknown.
+     *
+     * @param name  The category name
+     *
+     * @return the asset type hash for the given category name
+     */
+    static size_t categoryHash(const std::string& name);
+    
+    /**
+     * Reloads the assets defined by the given files
+     *
+     * This method is called (in the main thread) when the asset watcher
+     * detects changes.  Any scene that references a reloaded asset is
+     * rebuilt as well.  Changes to an asset directory reload those entries
+     * which have changed.
+     *
+     * @param files The absolute paths of the changed files
+     * @param stamp The time the first change was detected
+     */
+    void refresh(const std::vector<std::string>& files, const Timestamp& stamp);
+
+    /**
+     * Evicts assets of the given type until it is within the given budget
+     *
+     * Only assets loaded from a JSON directory may be evicted, as those are
+     * the only assets that we can restore. In addition, an asset is only
+     * evicted if the asset manager is its sole owner.
+     *
+     * @param hash      The hash of the asset type
+     * @param budget    The memory budget in bytes
+     *
+     * @return the number of assets evicted
+     */
+    size_t evict(size_t hash, size_t budget);
+
+    /**
+     * Synchronously restores a missing asset of the given type
+     *
+     * This method is called by {@link #get} when an asset is missing. It
+     * restores the asset if it was evicted, or if the loader can build it
+     * on demand (see {@link BaseLoader#request}). It does nothing unless
+     * it is called in the main thread.
+     *
+     * @param hash  The hash of the asset type
+     * @param key   The key associated with the asset
+     *
+     * @return true if the asset was restored
+     */
+    bool restore(size_t hash, const std::string& key) const;
+    
     /**
      * Synchronizes the asset manager to wait until all assets have finished.
      *
@@ -210,7 +335,10 @@ public:
      * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an asset 
      * manager on the heap, use one of the static constructors instead.
      */
-    AssetManager() : _preload(false), _wait(false) {}
+    AssetManager() : _preload(false), _wait(false),
+    _reloadCount(0), _reloadLatency(0), _reloadTotal(0),
+    _budget(0), _peak(0), _evictCount(0), _evictBytes(0), _restoreCount(0),
+    _mainThread(0) {}
     
     /**
      * Deletes this asset manager, disposing of all resources.
@@ -461,6 +589,10 @@ public:
      * the method is parameterized by the type, it is safe to reuse keys for
      * different types.  However, this is not recommended.
      *
+     * If the asset was evicted to meet a memory budget, or is part of a
+     * deferred scene subtree, and this method is called in the main thread,
+     * the asset is synchronously restored.
+     *
      * @param  key  The key to identify the given asset
      *
      * @return the asset for the given key.
@@ -475,7 +607,11 @@ public:
         }
         
         std::shared_ptr<Loader<T>> loader = std::dynamic_pointer_cast<Loader<T>>(it->second);
-        return loader->get(key);
+        std::shared_ptr<T> result = loader->get(key);
+        if (result == nullptr && restore(hash,key)) {
+            result = loader->get(key);
+        }
+        return result;
     }
     
     /**
@@ -493,6 +629,22 @@ public:
     std::shared_ptr<T> get(const char* key) const {
         return get<T>(std::string(key));
     }
+
+    /**
+     * Returns the asset for the given key.
+     *
+     * This version takes an interned key, which avoids allocating a string
+     * for keys that are looked up every frame. Otherwise, it is identical
+     * to the string version.
+     *
+     * @param  key  The interned key to identify the given asset
+     *
+     * @return the asset for the given key.
+     */
+    template<typename T>
+    std::shared_ptr<T> get(const Symbol key) const {
+        return get<T>(key.str());
+    }
     
     /**
      * Loads an asset and assigns it to the given key.
@@ -1006,6 +1158,288 @@ public:
     bool unloadDirectory(const char* directory) {
         return unloadDirectory(std::string(directory));
     }
+    
+#pragma mark -
+#pragma mark Hot Reloading
+    /**
+     * Starts watching the asset files for changes.
+     *
+     * Once watching, any asset loaded from a JSON directory will be reloaded
+     * when its file changes.  The JSON directory files are watched as well,
+     * so that editing an entry (or a scene) will reload it.  Assets loaded
+     * directly from a file, without a directory, are not watched.
+     *
+     * Changes are reported in batches, once the files have not changed for
+     * the given interval. This keeps us from reloading a file that is still
+     * being written. The assets are reloaded in the main thread.
+     *
+     * @param interval  The quiet interval in milliseconds
+     *
+     * @return true if watching was started
+     */
+    bool startWatching(Uint32 interval=50);
+    
+    /**
+     * Stops watching the asset files for changes.
+     *
+     * Any changes already detected, but not yet reloaded, are discarded.
+     */
+    void stopWatching();
+    
+    /**
+     * Returns true if the asset files are being watched for changes.
+     *
+     * @return true if the asset files are being watched for changes.
+     */
+    bool isWatching() const {
+        return _watcher != nullptr && _watcher->isActive();
+    }
+    
+    /**
+     * Synchronously reloads the asset for the given key.
+     *
+     * The type of the asset is specified by the template parameter T.  The
+     * asset must have been loaded from a JSON directory.  This method
+     * does not reload any scenes that depend upon this asset.
+     *
+     * @param key   The key associated with the asset
+     *
+     * @return true if the asset was successfully reloaded
+     */
+    template<typename T>
+    bool reload(const std::string& key) {
+        size_t hash = typeid(T).hash_code();
+        auto it = _handlers.find(hash);
+        auto jt = _entries.find(hash);
+        if (it == _handlers.end() || jt == _entries.end()) {
+            return false;
+        }
+        auto kt = jt->second.find(key);
+        if (kt == jt->second.end()) {
+            return false;
+        }
+        return it->second->reload(kt->second);
+    }
+    
+    /**
+     * Returns the listener notified after each asset is hot reloaded.
+     *
+     * The listener is called in the main thread with the key of each asset
+     * reloaded (including rebuilt scenes) and whether it was successful.
+     * Objects that hold a reference to a reloaded asset other than a
+     * texture should fetch it again from this asset manager.
+     *
+     * @return the listener notified after each asset is hot reloaded.
+     */
+    const LoaderCallback& getReloadListener() const { return _reloader; }
+    
+    /**
+     * Sets the listener notified after each asset is hot reloaded.
+     *
+     * The listener is called in the main thread with the key of each asset
+     * reloaded (including rebuilt scenes) and whether it was successful.
+     * Objects that hold a reference to a reloaded asset other than a
+     * texture should fetch it again from this asset manager.
+     *
+     * @param listener  The listener notified after each asset is hot reloaded.
+     */
+    void setReloadListener(LoaderCallback listener) { _reloader = listener; }
+    
+    /**
+     * Returns the number of completed hot reloads.
+     *
+     * Each batch of file changes counts as a single reload.
+     *
+     * @return the number of completed hot reloads.
+     */
+    Uint32 getReloadCount() const { return _reloadCount; }
+    
+    /**
+     * Returns the latency of the most recent hot reload in milliseconds.
+     *
+     * The latency is the time from when the file change was detected to
+     * the start of the first animation frame after the reloaded assets
+     * were drawn.
+     *
+     * @return the latency of the most recent hot reload in milliseconds.
+     */
+    float getReloadLatency() const { return _reloadLatency/1000.0f; }
+    
+    /**
+     * Returns the average latency of all hot reloads in milliseconds.
+     *
+     * The latency is the time from when the file change was detected to
+     * the start of the first animation frame after the reloaded assets
+     * were drawn.
+     *
+     * @return the average latency of all hot reloads in milliseconds.
+     */
+    float getAverageReloadLatency() const {
+        return _reloadCount == 0 ? 0.0f : _reloadTotal/(1000.0f*_reloadCount);
+    }
+
+#pragma mark -
+#pragma mark Memory Management
+    /**
+     * Returns the memory budget for all assets in bytes.
+     *
+     * A budget of 0 means that the memory usage is unlimited.
+     *
+     * @return the memory budget for all assets in bytes.
+     */
+    size_t getBudget() const { return _budget; }
+    
+    /**
+     * Sets the memory budget for all assets in bytes.
+     *
+     * When the budget is exceeded, {@link #trim} evicts the least recently
+     * used assets from each type in proportion to its usage. A budget of 0
+     * means that the memory usage is unlimited. Setting a budget trims the
+     * assets immediately.
+     *
+     * @param bytes The memory budget for all assets in bytes
+     */
+    void setBudget(size_t bytes) {
+        _budget = bytes;
+        trim();
+    }
+    
+    /**
+     * Returns the memory budget for the given asset type in bytes.
+     *
+     * The type of the asset is specified by the template parameter T. A
+     * budget of 0 means that the memory usage is unlimited.
+     *
+     * @return the memory budget for the given asset type in bytes.
+     */
+    template<typename T>
+    size_t getBudget() const {
+        auto it = _budgets.find(typeid(T).hash_code());
+        return it == _budgets.end() ? 0 : it->second;
+    }
+    
+    /**
+     * Sets the memory budget for the given asset type in bytes.
+     *
+     * The type of the asset is specified by the template parameter T. When
+     * the budget is exceeded, {@link #trim} evicts the least recently used
+     * assets of that type. A budget of 0 means that the memory usage is
+     * unlimited. Setting a budget trims the assets immediately.
+     *
+     * @param bytes The memory budget for the given asset type in bytes
+     */
+    template<typename T>
+    void setBudget(size_t bytes) {
+        _budgets[typeid(T).hash_code()] = bytes;
+        trim();
+    }
+    
+    /**
+     * Returns the memory usage of all assets in bytes.
+     *
+     * This is an estimate computed by the individual loaders. See the method
+     * {@link BaseLoader#getMemoryUsage} for details.
+     *
+     * @return the memory usage of all assets in bytes.
+     */
+    size_t getMemoryUsage() const;
+    
+    /**
+     * Returns the memory usage of the given asset type in bytes.
+     *
+     * The type of the asset is specified by the template parameter T. This
+     * is an estimate computed by the loader. See the method
+     * {@link BaseLoader#getMemoryUsage} for details.
+     *
+     * @return the memory usage of the given asset type in bytes.
+     */
+    template<typename T>
+    size_t getMemoryUsage() const {
+        auto it = _handlers.find(typeid(T).hash_code());
+        return it == _handlers.end() ? 0 : it->second->getMemoryUsage();
+    }
+    
+    /**
+     * Returns the peak memory usage of all assets in bytes.
+     *
+     * The usage is sampled each time the assets are trimmed, before any
+     * assets are evicted.
+     *
+     * @return the peak memory usage of all assets in bytes.
+     */
+    size_t getPeakUsage() const { return _peak; }
+    
+    /**
+     * Returns the peak memory usage of the given asset type in bytes.
+     *
+     * The type of the asset is specified by the template parameter T. The
+     * usage is sampled each time the assets are trimmed, before any assets
+     * are evicted.
+     *
+     * @return the peak memory usage of the given asset type in bytes.
+     */
+    template<typename T>
+    size_t getPeakUsage() const {
+        auto it = _peaks.find(typeid(T).hash_code());
+        return it == _peaks.end() ? 0 : it->second;
+    }
+    
+    /**
+     * Returns the number of assets evicted to meet the budgets.
+     *
+     * @return the number of assets evicted to meet the budgets.
+     */
+    Uint64 getEvictionCount() const { return _evictCount; }
+    
+    /**
+     * Returns the number of bytes evicted to meet the budgets.
+     *
+     * @return the number of bytes evicted to meet the budgets.
+     */
+    Uint64 getEvictedBytes() const { return _evictBytes; }
+    
+    /**
+     * Returns the number of evicted assets restored on demand.
+     *
+     * A high value relative to {@link #getEvictionCount} means that the
+     * budgets are too small for the working set of the game.
+     *
+     * @return the number of evicted assets restored on demand.
+     */
+    Uint64 getRestoreCount() const { return _restoreCount; }
+    
+    /**
+     * Returns the number of assets evicted per second.
+     *
+     * The rate is measured from the last call to {@link #resetTelemetry}
+     * (or the initialization of this asset manager).
+     *
+     * @return the number of assets evicted per second.
+     */
+    float getEvictionRate() const;
+    
+    /**
+     * Resets the peak usage and eviction statistics.
+     */
+    void resetTelemetry();
+    
+    /**
+     * Evicts the least recently used assets to meet the memory budgets.
+     *
+     * Only assets loaded from a JSON directory may be evicted, and only if
+     * the asset manager is their sole owner. Hence this method never
+     * invalidates an asset in use. An evicted asset is restored when it is
+     * next requested with {@link #get}.
+     *
+     * This method is called automatically after a directory is loaded
+     * synchronously. It is never called while assets are loading
+     * asynchronously, as restoring an asset outside of the main thread is not
+     * safe. Hence games that load asynchronously should call this method once
+     * loading is complete.
+     *
+     * @return the number of assets evicted
+     */
+    size_t trim();
 
 };
 
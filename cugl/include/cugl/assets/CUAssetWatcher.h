@@ -0,0 +1,366 @@
+//
+//  CUAssetWatcher.h
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides a class to monitor asset files for changes. It is
+//  used by the asset manager to support hot reloading, so that an edited
+//  texture, sound, or JSON file can be reloaded without restarting the game.
+//
+//  On Linux, this class uses inotify to watch the directories that contain
+//  the asset files.  We watch the directories and not the files, because
+//  most editors save files by writing a temporary file and renaming it.  On
+//  all other platforms, this class polls the file modification times.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#ifndef __CU_ASSET_WATCHER_H__
+#define __CU_ASSET_WATCHER_H__
+#include <cugl/base/CUBase.h>
+#include <cugl/util/CUTimestamp.h>
+#include <cugl/util/CUDebug.h>
+#include <SDL/SDL.h>
+#include <unordered_map>
+#include <functional>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <mutex>
+
+namespace cugl {
+
+/**
+ * This class monitors a collection of files for changes.
+ *
+ * Files are identified by their absolute path. Relative paths are resolved
+ * against the application asset directory, just like {@link JsonReader}.
+ * Once started, the watcher runs in its own thread and reports changes to
+ * the listener in batches. A batch is reported once the file system has
+ * been quiet for one interval. This keeps us from reloading a file that an
+ * editor is still in the middle of writing.
+ *
+ * The listener is called in the watcher thread, not the main thread. It
+ * should use {@link Application#schedule} to defer any work that touches
+ * the assets. The timestamp passed to the listener is the time that the
+ * first change in the batch was detected.
+ *
+ * On Linux, changes are detected with inotify. On all other platforms, the
+ * watcher polls the file modification times once per interval. As file
+ * times only have a resolution of a second, polling can miss a change if
+ * the file is saved twice in the same second.
+ */
+class AssetWatcher {
+public:
+    /**
+     * @typedef Listener
+     *
+     * This type represents a listener for changed files.
+     *
+     * The listener is given the absolute paths of all files that changed
+     * in the most recent batch, together with the time that the first
+     * change was detected. It is called in the watcher thread.
+     *
+     * The function type is equivalent to
+     *
+     *      std::function<void(const std::vector<std::string>& files, const Timestamp& stamp)>
+     *
+     * @param files     The files that have changed
+     * @param stamp     The time the first change was detected
+     */
+    typedef std::function<void(const std::vector<std::string>& files,
+                               const Timestamp& stamp)> Listener;
+
+private:
+    /** This macro disables the copy constructor (not allowed on watchers) */
+    CU_DISALLOW_COPY_AND_ASSIGN(AssetWatcher);
+
+    /** The watched files, mapped to their last modification time */
+    std::unordered_map<std::string,Uint64> _files;
+    /** The watched directories, mapped to their reference count */
+    std::unordered_map<std::string,Uint32> _dirs;
+    /** The inotify watch descriptors (Linux only), mapped to directories */
+    std::unordered_map<int,std::string> _handles;
+    /** A mutex protecting the files and directories */
+    std::mutex _mutex;
+
+    /** The listener for changed files */
+    Listener _listener;
+    /** The polling (and quiet) interval in milliseconds */
+    Uint32 _interval;
+    /** The inotify file descriptor (-1 if unsupported) */
+    int _notify;
+    /** The watcher thread */
+    SDL_Thread* _thread;
+    /** Whether the watcher thread is running */
+    std::atomic<bool> _active;
+
+    /**
+     * The body function of the watcher thread.
+     *
+     * This function detects the changes and reports them to the listener.
+     *
+     * @param data  A pointer to this watcher
+     *
+     * @return 0 on thread completion
+     */
+    static int monitor(void* data);
+
+    /**
+     * Waits for at most one interval, adding any changed files to pending.
+     *
+     * This method uses inotify if it is available, and polls the files
+     * otherwise.
+     *
+     * @param pending   The files changed so far
+     *
+     * @return true if any file changed during this interval
+     */
+    bool scan(std::vector<std::string>& pending);
+
+    /**
+     * Starts watching the given directory, increasing its reference count.
+     *
+     * This method assumes that the mutex is held.
+     *
+     * @param dir   The absolute path of the directory
+     */
+    void attachDirectory(const std::string& dir);
+
+    /**
+     * Stops watching the given directory, decreasing its reference count.
+     *
+     * This method assumes that the mutex is held.
+     *
+     * @param dir   The absolute path of the directory
+     */
+    void detachDirectory(const std::string& dir);
+
+#pragma mark Constructors
+public:
+    /**
+     * Creates a degenerate asset watcher with no files.
+     *
+     * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an object on
+     * the heap, use one of the static constructors instead.
+     */
+    AssetWatcher();
+
+    /**
+     * Deletes this asset watcher, stopping the watcher thread.
+     */
+    ~AssetWatcher() { dispose(); }
+
+    /**
+     * Stops the watcher thread and releases all resources.
+     *
+     * You must reinitialize the watcher to use it again.
+     */
+    void dispose();
+
+    /**
+     * Initializes an asset watcher with a 50 millisecond interval.
+     *
+     * The watcher will not be active until {@link #start} is called.
+     *
+     * @return true if initialization was successful.
+     */
+    bool init() { return init(50); }
+
+    /**
+     * Initializes an asset watcher with the given interval.
+     *
+     * The interval is how long the file system must be quiet before a batch
+     * of changes is reported. When polling, it is also the polling period.
+     * The watcher will not be active until {@link #start} is called.
+     *
+     * @param interval  The interval in milliseconds
+     *
+     * @return true if initialization was successful.
+     */
+    bool init(Uint32 interval);
+
+    /**
+     * Returns a newly allocated asset watcher with a 50 millisecond interval.
+     *
+     * The watcher will not be active until {@link #start} is called.
+     *
+     * @return a newly allocated asset watcher with a 50 millisecond interval.
+     */
+    static std::shared_ptr<AssetWatcher> alloc() {
+        std::shared_ptr<AssetWatcher> result = std::make_shared<AssetWatcher>();
+        return (result->init() ? result : nullptr);
+    }
+
+    /**
+     * Returns a newly allocated asset watcher with the given interval.
+     *
+     * The interval is how long the file system must be quiet before a batch
+     * of changes is reported. When polling, it is also the polling period.
+     * The watcher will not be active until {@link #start} is called.
+     *
+     * @param interval  The interval in milliseconds
+     *
+     * @return a newly allocated asset watcher with the given interval.
+     */
+    static std::shared_ptr<AssetWatcher> alloc(Uint32 interval) {
+        std::shared_ptr<AssetWatcher> result = std::make_shared<AssetWatcher>();
+        return (result->init(interval) ? result : nullptr);
+    }
+
+#pragma mark File Management
+    /**
+     * Returns the absolute path for the given asset file.
+     *
+     * Relative paths are resolved against the application asset directory.
+     *
+     * @param path  The (relative or absolute) path to the file
+     *
+     * @return the absolute path for the given asset file.
+     */
+    static std::string resolve(const std::string& path);
+
+    /**
+     * Starts watching the given file.
+     *
+     * The file does not need to exist yet; it will be reported once it
+     * is created. Relative paths are resolved against the application
+     * asset directory. This method may be called while the watcher is
+     * active.
+     *
+     * @param path  The (relative or absolute) path to the file
+     *
+     * @return true if the file was not already watched
+     */
+    bool watch(const std::string& path);
+
+    /**
+     * Stops watching the given file.
+     *
+     * This method may be called while the watcher is active.
+     *
+     * @param path  The (relative or absolute) path to the file
+     *
+     * @return true if the file was being watched
+     */
+    bool unwatch(const std::string& path);
+
+    /**
+     * Stops watching all files.
+     *
+     * This method may be called while the watcher is active.
+     */
+    void unwatchAll();
+
+    /**
+     * Returns true if the given file is being watched.
+     *
+     * @param path  The (relative or absolute) path to the file
+     *
+     * @return true if the given file is being watched.
+     */
+    bool isWatched(const std::string& path);
+
+    /**
+     * Returns the number of files being watched.
+     *
+     * @return the number of files being watched.
+     */
+    size_t size();
+
+#pragma mark Monitoring
+    /**
+     * Returns the listener for changed files.
+     *
+     * @return the listener for changed files.
+     */
+    const Listener& getListener() const { return _listener; }
+
+    /**
+     * Sets the listener for changed files.
+     *
+     * The listener is called in the watcher thread. This method should not
+     * be called while the watcher is active.
+     *
+     * @param listener  The listener for changed files
+     */
+    void setListener(Listener listener) {
+        CUAssertLog(!_active.load(), "Cannot change the listener of an active watcher");
+        _listener = listener;
+    }
+
+    /**
+     * Returns the interval in milliseconds.
+     *
+     * The interval is how long the file system must be quiet before a batch
+     * of changes is reported. When polling, it is also the polling period.
+     *
+     * @return the interval in milliseconds.
+     */
+    Uint32 getInterval() const { return _interval; }
+
+    /**
+     * Returns true if changes are detected by the operating system.
+     *
+     * If this value is false, the watcher polls the file modification times.
+     *
+     * @return true if changes are detected by the operating system.
+     */
+    bool isNative() const { return _notify >= 0; }
+
+    /**
+     * Starts the watcher thread.
+     *
+     * @return true if the watcher thread was started.
+     */
+    bool start();
+
+    /**
+     * Stops the watcher thread.
+     *
+     * This method blocks until the watcher thread has completed, which
+     * takes at most one interval.
+     */
+    void stop();
+
+    /**
+     * Returns true if the watcher thread is running.
+     *
+     * @return true if the watcher thread is running.
+     */
+    bool isActive() const { return _active.load(); }
+};
+
+}
+
+#endif /* __CU_ASSET_WATCHER_H__ */
@@ -220,6 +220,18 @@ protected:
      * @return true if the asset was successfully loaded
      */
     bool read(const std::shared_ptr<JsonValue>& json, LoaderCallback callback, bool async) override;
+
+    /**
+     * Returns the number of bytes used by the given font.
+     *
+     * This is the size of the font atlas textures (see
+     * {@link Font#getAtlasBytes}).
+     *
+     * @param asset The font to measure
+     *
+     * @return the number of bytes used by the given font.
+     */
+    virtual size_t measure(const std::shared_ptr<Font>& asset) const override;
     
     
 public:
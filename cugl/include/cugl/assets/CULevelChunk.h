@@ -0,0 +1,389 @@
+//
+//  CULevelChunk.h
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides a single chunk of a streamed level. Large levels are
+//  divided into a grid of spatial chunks, and each chunk stores the scene
+//  graph JSON, polygons, and physics obstacles in its region. Chunks are
+//  stored in a compact binary format so that they can be read quickly in a
+//  background thread. See LevelStreamer for how chunks are loaded.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#ifndef __CU_LEVEL_CHUNK_H__
+#define __CU_LEVEL_CHUNK_H__
+#include <cugl/assets/CUJsonValue.h>
+#include <cugl/physics2/CUObstacle.h>
+#include <cugl/scene2/graph/CUSceneNode.h>
+#include <cugl/math/CUPoly2.h>
+#include <cugl/math/CURect.h>
+#include <vector>
+#include <string>
+#include <memory>
+
+namespace cugl {
+
+/**
+ * This class is a single chunk of a streamed level.
+ *
+ * A chunk is the content of one cell of the level grid. It has three parts:
+ * an (optional) scene graph in the JSON format of {@link Scene2Loader}, a
+ * list of polygons, and a list of body descriptions. The body descriptions
+ * are turned into physics obstacles by {@link #buildObstacles}. Polygon
+ * bodies refer to the polygon list by index, and the polygons may also be
+ * used by the game for other purposes (such as terrain rendering).
+ *
+ * All positions in a chunk are in physics (world) coordinates, not chunk
+ * coordinates. The scene graph is attached as is, so its layout should be
+ * relative to the node that the chunks are attached to.
+ *
+ * Chunks are stored as binary files written by {@link #save}. All values are
+ * stored in the byte order of {@link BinaryWriter}, in the following order:
+ *
+ *      Header:     "CULC", the format version, the column and row (Sint32),
+ *                  and the chunk bounds (four floats)
+ *      Scene:      The length of the scene JSON (Uint32; 0 for none) followed
+ *                  by the JSON text
+ *      Polygons:   The number of polygons (Uint32). For each polygon, the
+ *                  number of vertices (Uint32) and their coordinates (floats),
+ *                  followed by the number of indices (Uint32) and the indices
+ *                  (Uint32)
+ *      Bodies:     The number of bodies (Uint32). For each body, the shape,
+ *                  body type and sensor flag (Uint8), the position, angle,
+ *                  size, density, friction and restitution (floats), the
+ *                  polygon index (Uint32), and the length and text of the
+ *                  name
+ *
+ * Reading a chunk and building its obstacles does not touch the physics
+ * world or the GPU, so both may be done in a background thread. Adding the
+ * obstacles to a world and building the scene graph must be done in the main
+ * thread.
+ */
+class LevelChunk {
+public:
+    /**
+     * This enum lists the shape of a chunk body.
+     */
+    enum class Shape : Uint8 {
+        /** A {@link physics2::BoxObstacle} */
+        BOX     = 0,
+        /** A {@link physics2::WheelObstacle} (the radius is the size width) */
+        WHEEL   = 1,
+        /** A {@link physics2::CapsuleObstacle} */
+        CAPSULE = 2,
+        /** A {@link physics2::PolygonObstacle} of one of the chunk polygons */
+        POLYGON = 3
+    };
+
+    /**
+     * This class describes a physics body in a chunk.
+     *
+     * For polygon bodies, the position is the rotational center of the body,
+     * and the polygon vertices are in world coordinates.
+     */
+    class Body {
+    public:
+        /** The name of the obstacle */
+        std::string name;
+        /** The obstacle shape */
+        Shape shape;
+        /** The body type (static, kinematic, dynamic) */
+        b2BodyType type;
+        /** Whether the obstacle is a sensor */
+        bool sensor;
+        /** The obstacle position */
+        Vec2 position;
+        /** The obstacle angle in radians */
+        float angle;
+        /** The obstacle size (the radius is the width for wheels) */
+        Size size;
+        /** The obstacle density */
+        float density;
+        /** The obstacle friction */
+        float friction;
+        /** The obstacle restitution */
+        float restitution;
+        /** The index of the polygon for polygon bodies */
+        Uint32 polygon;
+
+        /**
+         * Creates a static unit box at the origin
+         */
+        Body() : shape(Shape::BOX), type(b2_staticBody), sensor(false),
+        angle(0), size(1,1), density(1), friction(0), restitution(0), polygon(0) {}
+    };
+
+protected:
+    /** The column of this chunk in the level grid */
+    int _col;
+    /** The row of this chunk in the level grid */
+    int _row;
+    /** The region of the level covered by this chunk */
+    Rect _bounds;
+    /** The scene graph of this chunk (may be nullptr) */
+    std::shared_ptr<JsonValue> _scene;
+    /** The polygons of this chunk */
+    std::vector<Poly2> _polygons;
+    /** The body descriptions of this chunk */
+    std::vector<Body> _bodies;
+    /** The obstacles built from the body descriptions */
+    std::vector<std::shared_ptr<physics2::Obstacle>> _obstacles;
+    /** The scene graph node built from the JSON (managed by the streamer) */
+    std::shared_ptr<scene2::SceneNode> _node;
+    /** Whether this chunk has been initialized */
+    bool _active;
+
+#pragma mark -
+#pragma mark Constructors
+public:
+    /**
+     * Creates a degenerate level chunk.
+     *
+     * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an object on
+     * the heap, use one of the static constructors instead.
+     */
+    LevelChunk() : _col(0), _row(0), _active(false) {}
+
+    /**
+     * Deletes this level chunk, disposing all resources
+     */
+    ~LevelChunk() { dispose(); }
+
+    /**
+     * Disposes all of the resources used by this chunk.
+     *
+     * The obstacles are released, but they are not removed from any physics
+     * world. A disposed chunk can be safely reinitialized.
+     */
+    void dispose();
+
+    /**
+     * Initializes an empty chunk for the given grid cell.
+     *
+     * This initializer is for building chunks in code, typically in a tool
+     * that divides a level into chunks and calls {@link #save}.
+     *
+     * @param col       The column of the chunk in the level grid
+     * @param row       The row of the chunk in the level grid
+     * @param bounds    The region of the level covered by the chunk
+     *
+     * @return true if initialization was successful.
+     */
+    bool init(int col, int row, const Rect bounds);
+
+    /**
+     * Initializes a chunk from the given binary file.
+     *
+     * The file must be in the format described in the class documentation.
+     * Relative paths are resolved as in {@link BinaryReader}. This method
+     * is safe to call in a background thread.
+     *
+     * @param file  The chunk file
+     *
+     * @return true if initialization was successful.
+     */
+    bool initWithFile(const std::string file);
+
+    /**
+     * Returns a newly allocated empty chunk for the given grid cell.
+     *
+     * @param col       The column of the chunk in the level grid
+     * @param row       The row of the chunk in the level grid
+     * @param bounds    The region of the level covered by the chunk
+     *
+     * @return a newly allocated empty chunk for the given grid cell.
+     */
+    static std::shared_ptr<LevelChunk> alloc(int col, int row, const Rect bounds) {
+        std::shared_ptr<LevelChunk> result = std::make_shared<LevelChunk>();
+        return (result->init(col,row,bounds) ? result : nullptr);
+    }
+
+    /**
+     * Returns a newly allocated chunk from the given binary file.
+     *
+     * The file must be in the format described in the class documentation.
+     * Relative paths are resolved as in {@link BinaryReader}. This method
+     * is safe to call in a background thread.
+     *
+     * @param file  The chunk file
+     *
+     * @return a newly allocated chunk from the given binary file.
+     */
+    static std::shared_ptr<LevelChunk> allocWithFile(const std::string file) {
+        std::shared_ptr<LevelChunk> result = std::make_shared<LevelChunk>();
+        return (result->initWithFile(file) ? result : nullptr);
+    }
+
+    /**
+     * Writes this chunk to the given binary file.
+     *
+     * The file will be in the format described in the class documentation.
+     *
+     * @param file  The chunk file
+     *
+     * @return true if the chunk was successfully written
+     */
+    bool save(const std::string file) const;
+
+#pragma mark -
+#pragma mark Attributes
+    /**
+     * Returns the column of this chunk in the level grid.
+     *
+     * @return the column of this chunk in the level grid.
+     */
+    int getColumn() const { return _col; }
+
+    /**
+     * Returns the row of this chunk in the level grid.
+     *
+     * @return the row of this chunk in the level grid.
+     */
+    int getRow() const { return _row; }
+
+    /**
+     * Returns the region of the level covered by this chunk.
+     *
+     * @return the region of the level covered by this chunk.
+     */
+    const Rect& getBounds() const { return _bounds; }
+
+    /**
+     * Returns the scene graph JSON of this chunk.
+     *
+     * This value is nullptr if the chunk has no scene graph.
+     *
+     * @return the scene graph JSON of this chunk.
+     */
+    const std::shared_ptr<JsonValue>& getScene() const { return _scene; }
+
+    /**
+     * Sets the scene graph JSON of this chunk.
+     *
+     * The JSON should be in the format of {@link Scene2Loader#build}.
+     *
+     * @param scene The scene graph JSON of this chunk.
+     */
+    void setScene(const std::shared_ptr<JsonValue>& scene) { _scene = scene; }
+
+    /**
+     * Returns the polygons of this chunk.
+     *
+     * @return the polygons of this chunk.
+     */
+    const std::vector<Poly2>& getPolygons() const { return _polygons; }
+
+    /**
+     * Adds a polygon to this chunk, returning its index.
+     *
+     * The polygon should be triangulated if it is to be used by a body.
+     *
+     * @param poly  The polygon to add
+     *
+     * @return the index of the new polygon
+     */
+    Uint32 addPolygon(const Poly2& poly) {
+        _polygons.push_back(poly);
+        return (Uint32)(_polygons.size()-1);
+    }
+
+    /**
+     * Returns the body descriptions of this chunk.
+     *
+     * @return the body descriptions of this chunk.
+     */
+    const std::vector<Body>& getBodies() const { return _bodies; }
+
+    /**
+     * Adds a body description to this chunk.
+     *
+     * @param body  The body description to add
+     */
+    void addBody(const Body& body) { _bodies.push_back(body); }
+
+    /**
+     * Returns the approximate memory used by this chunk in bytes.
+     *
+     * This includes the polygon data, the body descriptions and the obstacles,
+     * but not the scene graph.
+     *
+     * @return the approximate memory used by this chunk in bytes.
+     */
+    size_t getMemory() const;
+
+#pragma mark -
+#pragma mark Content
+    /**
+     * Builds the obstacles for the body descriptions.
+     *
+     * The obstacles are not added to any physics world, so this method is
+     * safe to call in a background thread. Bodies that fail to build (such
+     * as polygon bodies with a bad polygon index) are skipped.
+     *
+     * @return the number of obstacles built
+     */
+    size_t buildObstacles();
+
+    /**
+     * Returns the obstacles built by {@link #buildObstacles}.
+     *
+     * @return the obstacles built by {@link #buildObstacles}.
+     */
+    const std::vector<std::shared_ptr<physics2::Obstacle>>& getObstacles() const {
+        return _obstacles;
+    }
+
+    /**
+     * Returns the scene graph node for this chunk.
+     *
+     * This value is assigned by the streamer in the main thread. It is
+     * nullptr if the chunk has no scene graph or is not resident.
+     *
+     * @return the scene graph node for this chunk.
+     */
+    const std::shared_ptr<scene2::SceneNode>& getNode() const { return _node; }
+
+    /**
+     * Sets the scene graph node for this chunk.
+     *
+     * This value is assigned by the streamer in the main thread.
+     *
+     * @param node  The scene graph node for this chunk.
+     */
+    void setNode(const std::shared_ptr<scene2::SceneNode>& node) { _node = node; }
+};
+
+}
+
+#endif /* __CU_LEVEL_CHUNK_H__ */
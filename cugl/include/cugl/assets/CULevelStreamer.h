@@ -0,0 +1,484 @@
+//
+//  CULevelStreamer.h
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides chunk-based streaming for large levels. A level is
+//  divided offline into a grid of chunks (see LevelChunk). At runtime, only
+//  the chunks near a focus point (typically the camera or the player) are
+//  resident. Chunks are read in a background thread, and their physics bodies
+//  and scene graphs are added at the start of the next physics step. Hence
+//  the memory footprint and load time of a level depend on the streaming
+//  radius, and not on the size of the level.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#ifndef __CU_LEVEL_STREAMER_H__
+#define __CU_LEVEL_STREAMER_H__
+#include <cugl/assets/CULevelChunk.h>
+#include <cugl/assets/CUScene2Loader.h>
+#include <cugl/physics2/CUObstacleWorld.h>
+#include <cugl/util/CUThreadPool.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+
+namespace cugl {
+
+/**
+ * This class streams the chunks of a large level around a focus point.
+ *
+ * A streamed level is a directory with a JSON manifest and one binary file
+ * per chunk (see {@link LevelChunk#save}). The manifest has the following
+ * attributes:
+ *
+ *      "origin":   A two-element array with the bottom left corner of the
+ *                  level in physics coordinates (default [0,0])
+ *      "chunk":    A two-element array with the size of each chunk in
+ *                  physics coordinates
+ *      "grid":     A two-element array with the number of columns and rows
+ *
+ * The chunk in column c and row r is the file "c_r.chunk", relative to the
+ * manifest. Rows are numbered from the bottom of the level. Chunks may be
+ * missing, in which case that cell of the level is empty.
+ *
+ * Each call to {@link #update} finds the chunk containing the focus point.
+ * Any chunk within the streaming radius (measured in chunks) that is not
+ * resident is read in a background thread. Any resident chunk further than
+ * radius+1 chunks away is unloaded. This hysteresis prevents chunks from
+ * being loaded and unloaded repeatedly when the focus is near a chunk border.
+ * Hence at most (2*radius+3)^2 chunks are ever resident.
+ *
+ * Chunks that have finished reading are inserted in {@link #update}, up to a
+ * limit per frame. The obstacles of a chunk are added to the physics world
+ * as a batch, but deferred until the next call to
+ * {@link physics2::ObstacleWorld#update}, so they always appear at a step
+ * boundary. The same is true for the obstacles of unloaded chunks. If the
+ * streamer has a scene loader and a root node, the scene graph of each chunk
+ * is built and attached to the root. As scene graphs may refer to textures,
+ * they are built in the main thread. Chunk scenes are not added to the
+ * asset dictionary, so any deferred subtrees in them are never expanded.
+ *
+ * The obstacles of a chunk are owned by the chunk. If a dynamic obstacle
+ * leaves its chunk, it is still removed when its chunk is unloaded. Games
+ * that need persistent objects should add them to the world separately.
+ */
+class LevelStreamer {
+private:
+    /** This macro disables the copy constructor (not allowed on streamers) */
+    CU_DISALLOW_COPY_AND_ASSIGN(LevelStreamer);
+
+protected:
+    /** The directory containing the chunk files */
+    std::string _directory;
+    /** The bottom left corner of the level */
+    Vec2 _origin;
+    /** The size of a single chunk */
+    Size _chunksize;
+    /** The number of columns in the level grid */
+    int _cols;
+    /** The number of rows in the level grid */
+    int _rows;
+    /** The streaming radius in chunks */
+    Uint32 _radius;
+    /** The maximum number of chunks to insert each update */
+    Uint32 _inserts;
+    /** The column of the chunk containing the focus */
+    int _col;
+    /** The row of the chunk containing the focus */
+    int _row;
+
+    /** The physics world for the chunk obstacles */
+    std::shared_ptr<physics2::ObstacleWorld> _world;
+    /** The scene graph node for the chunk scenes (may be nullptr) */
+    std::shared_ptr<scene2::SceneNode> _root;
+    /** The loader to build the chunk scenes (may be nullptr) */
+    std::shared_ptr<Scene2Loader> _loader;
+    /** The worker threads to read chunks */
+    std::shared_ptr<ThreadPool> _workers;
+
+    /** The resident chunks */
+    std::unordered_map<Uint64, std::shared_ptr<LevelChunk>> _resident;
+    /** The chunks requested but not yet inserted */
+    std::unordered_set<Uint64> _pending;
+    /** The chunks that have no file (so are never requested again) */
+    std::unordered_set<Uint64> _missing;
+    /** The chunks read by the workers, waiting to be inserted */
+    std::vector<std::pair<Uint64,std::shared_ptr<LevelChunk>>> _ready;
+    /** The mutex for the ready chunks */
+    std::mutex _mutex;
+
+    /**
+     * Returns the key for the given grid cell
+     *
+     * @param col   The chunk column
+     * @param row   The chunk row
+     *
+     * @return the key for the given grid cell
+     */
+    static Uint64 makeKey(int col, int row) {
+        return ((Uint64)(Uint32)col << 32) | (Uint32)row;
+    }
+
+    /**
+     * Returns true if the given grid cell is within range of the focus
+     *
+     * @param col       The chunk column
+     * @param row       The chunk row
+     * @param radius    The range in chunks
+     *
+     * @return true if the given grid cell is within range of the focus
+     */
+    bool inRange(int col, int row, Uint32 radius) const {
+        return std::abs(col-_col) <= (int)radius && std::abs(row-_row) <= (int)radius;
+    }
+
+    /**
+     * Requests the chunk in the given grid cell
+     *
+     * The chunk is read in a background thread.
+     *
+     * @param col   The chunk column
+     * @param row   The chunk row
+     */
+    void request(int col, int row);
+
+    /**
+     * Reads the chunk in the given file.
+     *
+     * This method is executed in a worker thread. The obstacles are built,
+     * but not added to the world.
+     *
+     * @param key   The chunk key
+     * @param file  The chunk file
+     */
+    void read(Uint64 key, const std::string file);
+
+    /**
+     * Inserts a chunk into the world and the scene graph.
+     *
+     * This method must be called in the main thread.
+     *
+     * @param key   The chunk key
+     * @param chunk The chunk to insert
+     */
+    void insert(Uint64 key, const std::shared_ptr<LevelChunk>& chunk);
+
+    /**
+     * Removes a chunk from the world and the scene graph.
+     *
+     * This method must be called in the main thread.
+     *
+     * @param chunk The chunk to remove
+     */
+    void remove(const std::shared_ptr<LevelChunk>& chunk);
+
+public:
+    /**
+     * The listener for chunk insertion.
+     *
+     * This function is called in the main thread after the obstacles of a
+     * chunk are queued and its scene graph (if any) is attached. It is useful
+     * for attaching game specific data, such as scene nodes to obstacles.
+     */
+    std::function<void(const std::shared_ptr<LevelChunk>& chunk)> onLoad;
+
+    /**
+     * The listener for chunk removal.
+     *
+     * This function is called in the main thread before the obstacles of
+     * a chunk are removed and its scene graph (if any) is detached.
+     */
+    std::function<void(const std::shared_ptr<LevelChunk>& chunk)> onUnload;
+
+#pragma mark -
+#pragma mark Constructors
+    /**
+     * Creates a degenerate level streamer.
+     *
+     * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an object on
+     * the heap, use one of the static constructors instead.
+     */
+    LevelStreamer();
+
+    /**
+     * Deletes this level streamer, disposing all resources
+     */
+    ~LevelStreamer() { dispose(); }
+
+    /**
+     * Disposes all of the resources used by this streamer.
+     *
+     * This method blocks until any chunk being read is complete. All resident
+     * chunks are removed from the world and the scene graph. A disposed
+     * streamer can be safely reinitialized.
+     */
+    void dispose();
+
+    /**
+     * Initializes a streamer for the level with the given manifest.
+     *
+     * The manifest is a JSON file, as described in the class documentation.
+     * If the path is relative, it is relative to the asset directory. The
+     * chunk obstacles are added to the given world. As there is no scene
+     * loader, the chunk scene graphs are ignored.
+     *
+     * No chunks are loaded until the first call to {@link #update}.
+     *
+     * @param manifest  The level manifest
+     * @param world     The physics world for the chunk obstacles
+     *
+     * @return true if initialization was successful.
+     */
+    bool init(const std::string manifest,
+              const std::shared_ptr<physics2::ObstacleWorld>& world) {
+        return init(manifest,world,nullptr,nullptr);
+    }
+
+    /**
+     * Initializes a streamer for the level with the given manifest.
+     *
+     * The manifest is a JSON file, as described in the class documentation.
+     * If the path is relative, it is relative to the asset directory. The
+     * chunk obstacles are added to the given world. If the loader and root
+     * are not nullptr, the chunk scene graphs are built with the loader and
+     * attached to the root.
+     *
+     * No chunks are loaded until the first call to {@link #update}.
+     *
+     * @param manifest  The level manifest
+     * @param world     The physics world for the chunk obstacles
+     * @param root      The scene graph node for the chunk scenes
+     * @param loader    The loader to build the chunk scenes
+     * @param radius    The streaming radius in chunks
+     * @param threads   The number of threads to read chunks
+     *
+     * @return true if initialization was successful.
+     */
+    bool init(const std::string manifest,
+              const std::shared_ptr<physics2::ObstacleWorld>& world,
+              const std::shared_ptr<scene2::SceneNode>& root,
+              const std::shared_ptr<Scene2Loader>& loader,
+              Uint32 radius=1, Uint32 threads=1);
+
+    /**
+     * Returns a newly allocated streamer for the level with the given manifest.
+     *
+     * The manifest is a JSON file, as described in the class documentation.
+     * If the path is relative, it is relative to the asset directory. The
+     * chunk obstacles are added to the given world. As there is no scene
+     * loader, the chunk scene graphs are ignored.
+     *
+     * No chunks are loaded until the first call to {@link #update}.
+     *
+     * @param manifest  The level manifest
+     * @param world     The physics world for the chunk obstacles
+     *
+     * @return a newly allocated streamer for the level with the given manifest.
+     */
+    static std::shared_ptr<LevelStreamer> alloc(const std::string manifest,
+                                                const std::shared_ptr<physics2::ObstacleWorld>& world) {
+        std::shared_ptr<LevelStreamer> result = std::make_shared<LevelStreamer>();
+        return (result->init(manifest,world) ? result : nullptr);
+    }
+
+    /**
+     * Returns a newly allocated streamer for the level with the given manifest.
+     *
+     * The manifest is a JSON file, as described in the class documentation.
+     * If the path is relative, it is relative to the asset directory. The
+     * chunk obstacles are added to the given world. If the loader and root
+     * are not nullptr, the chunk scene graphs are built with the loader and
+     * attached to the root.
+     *
+     * No chunks are loaded until the first call to {@link #update}.
+     *
+     * @param manifest  The level manifest
+     * @param world     The physics world for the chunk obstacles
+     * @param root      The scene graph node for the chunk scenes
+     * @param loader    The loader to build the chunk scenes
+     * @param radius    The streaming radius in chunks
+     * @param threads   The number of threads to read chunks
+     *
+     * @return a newly allocated streamer for the level with the given manifest.
+     */
+    static std::shared_ptr<LevelStreamer> alloc(const std::string manifest,
+                                                const std::shared_ptr<physics2::ObstacleWorld>& world,
+                                                const std::shared_ptr<scene2::SceneNode>& root,
+                                                const std::shared_ptr<Scene2Loader>& loader,
+                                                Uint32 radius=1, Uint32 threads=1) {
+        std::shared_ptr<LevelStreamer> result = std::make_shared<LevelStreamer>();
+        return (result->init(manifest,world,root,loader,radius,threads) ? result : nullptr);
+    }
+
+#pragma mark -
+#pragma mark Attributes
+    /**
+     * Returns the bounds of the level in physics coordinates.
+     *
+     * @return the bounds of the level in physics coordinates.
+     */
+    Rect getBounds() const {
+        return Rect(_origin.x,_origin.y,_cols*_chunksize.width,_rows*_chunksize.height);
+    }
+
+    /**
+     * Returns the size of a single chunk in physics coordinates.
+     *
+     * @return the size of a single chunk in physics coordinates.
+     */
+    const Size& getChunkSize() const { return _chunksize; }
+
+    /**
+     * Returns the streaming radius in chunks.
+     *
+     * Chunks within this many chunks of the focus (in either direction) are
+     * loaded. Chunks further than radius+1 chunks are unloaded.
+     *
+     * @return the streaming radius in chunks.
+     */
+    Uint32 getRadius() const { return _radius; }
+
+    /**
+     * Sets the streaming radius in chunks.
+     *
+     * Chunks within this many chunks of the focus (in either direction) are
+     * loaded. Chunks further than radius+1 chunks are unloaded. The change
+     * takes effect at the next call to {@link #update}.
+     *
+     * @param radius    The streaming radius in chunks.
+     */
+    void setRadius(Uint32 radius) { _radius = radius; }
+
+    /**
+     * Returns the maximum number of chunks inserted in each update.
+     *
+     * Inserting a chunk activates its obstacles and builds its scene graph.
+     * Limiting the insertions spreads this cost over several frames. A value
+     * of 0 means there is no limit. The default is 1.
+     *
+     * @return the maximum number of chunks inserted in each update.
+     */
+    Uint32 getInsertLimit() const { return _inserts; }
+
+    /**
+     * Sets the maximum number of chunks inserted in each update.
+     *
+     * Inserting a chunk activates its obstacles and builds its scene graph.
+     * Limiting the insertions spreads this cost over several frames. A value
+     * of 0 means there is no limit. The default is 1.
+     *
+     * @param limit The maximum number of chunks inserted in each update.
+     */
+    void setInsertLimit(Uint32 limit) { _inserts = limit; }
+
+    /**
+     * Returns the number of resident chunks.
+     *
+     * @return the number of resident chunks.
+     */
+    size_t getResidentCount() const { return _resident.size(); }
+
+    /**
+     * Returns the number of chunks requested but not yet inserted.
+     *
+     * @return the number of chunks requested but not yet inserted.
+     */
+    size_t getPendingCount() const { return _pending.size(); }
+
+    /**
+     * Returns the resident chunk in the given grid cell.
+     *
+     * This method returns nullptr if the chunk is not resident.
+     *
+     * @param col   The chunk column
+     * @param row   The chunk row
+     *
+     * @return the resident chunk in the given grid cell.
+     */
+    std::shared_ptr<LevelChunk> getChunk(int col, int row) const;
+
+    /**
+     * Returns true if every chunk within the streaming radius is resident.
+     *
+     * Missing chunks (cells with no file) count as resident. This method is
+     * useful for holding the game (e.g. on a loading screen) until the area
+     * around the player has been loaded.
+     *
+     * @return true if every chunk within the streaming radius is resident.
+     */
+    bool isSettled() const;
+
+#pragma mark -
+#pragma mark Streaming
+    /**
+     * Streams the chunks around the given focus point.
+     *
+     * This method must be called in the main thread, and should be called
+     * once a frame before the physics world is updated. It requests the
+     * chunks within the streaming radius, unloads the chunks out of range,
+     * and inserts chunks that have finished reading (up to the insert
+     * limit).
+     *
+     * @param focus The focus point in physics coordinates
+     */
+    void update(const Vec2 focus);
+
+    /**
+     * Blocks until every chunk around the focus point is resident.
+     *
+     * This method is equivalent to calling {@link #update} until the
+     * streamer {@link #isSettled}, ignoring the insert limit. It is useful
+     * for loading the starting area of a level.
+     *
+     * @param focus The focus point in physics coordinates
+     */
+    void settle(const Vec2 focus);
+
+    /**
+     * Unloads all resident chunks.
+     *
+     * Outstanding requests are cancelled, though chunks currently being read
+     * will finish reading before they are discarded.
+     */
+    void unloadAll();
+};
+
+}
+
+#endif /* __CU_LEVEL_STREAMER_H__ */
@@ -51,8 +51,12 @@
 #include <functional>
 #include <unordered_map>
 #include <unordered_set>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <cugl/assets/CUJsonValue.h>
 #include <cugl/util/CUThreadPool.h>
+#include <cugl/util/CUSymbol.h>
 
 namespace cugl {
 
@@ -197,6 +201,28 @@ protected:
         return purge(json->key());
     }
     
+    /**
+     * Synchronously reloads the asset for the given directory entry
+     *
+     * This method is used to support hot reloading.  The default
+     * implementation purges the asset and reads it again, so objects that
+     * reference the old asset will continue to use it. Loaders that can
+     * replace an asset in place (e.g. {@link TextureLoader}) should override
+     * this method so that existing references see the new contents.
+     *
+     * You will notice that this method is essentially identical to reload.
+     * We separated the methods because overloading and virtual methods do
+     * not place nice.
+     *
+     * @param json      The directory entry for the asset
+     *
+     * @return true if the asset was successfully reloaded
+     */
+    virtual bool refresh(const std::shared_ptr<JsonValue>& json) {
+        purge(json);
+        return read(json,nullptr,false);
+    }
+    
     /**
      * Returns true if the key maps to a loaded asset.
      *
@@ -209,6 +235,22 @@ protected:
      * @return true if the key maps to a loaded asset.
      */
     virtual bool verify(const std::string key) const { return false; }
+    
+    /**
+     * Synchronously materializes a missing asset on demand
+     *
+     * Some loaders (e.g. {@link Scene2Loader}) defer part of their work
+     * until an asset is first needed. This method is called when such an
+     * asset is requested before it exists. It must be called in the main
+     * thread. You will notice that this method is essentially identical to
+     * request.  We separated the methods because overloading and virtual
+     * methods do not place nice.
+     *
+     * @param key   The key associated with the asset
+     *
+     * @return true if the asset was materialized
+     */
+    virtual bool demand(const std::string key) { return false; }
    
     
 public:
@@ -492,6 +534,73 @@ public:
      */
     virtual void unloadAll() {}
     
+    /**
+     * Synchronously reloads the asset for the given JSON entry
+     *
+     * This method is used by {@link AssetManager} to support hot reloading.
+     * See the description of the specific implementation for whether
+     * existing references to the asset will see the new contents.
+     *
+     * @param  json  the JSON entry (and key) associated with the asset
+     *
+     * @return true if the asset was successfully reloaded
+     */
+    bool reload(const std::shared_ptr<JsonValue>& json) {
+        return refresh(json);
+    }
+    
+
+#pragma mark Memory Management
+    /**
+     * Returns the number of bytes used by the assets in this loader.
+     *
+     * This value is an estimate of the memory (CPU or GPU) held by the
+     * assets, and is used by {@link AssetManager} to enforce its budgets.
+     * Assets that share memory with another asset, such as subtextures,
+     * are not counted twice.
+     *
+     * This method is abstract and should be overridden in child classes to
+     * support the appropriate asset type. The default returns 0, meaning
+     * that the assets are not tracked.
+     *
+     * @return the number of bytes used by the assets in this loader.
+     */
+    virtual size_t getMemoryUsage() const { return 0; }
+
+    /**
+     * Evicts the least recently used assets until usage is at most target.
+     *
+     * An asset may only be evicted if this loader is its sole owner, so
+     * eviction never invalidates a pointer held elsewhere in the game. The
+     * filter further restricts eviction to the keys for which it returns
+     * true. If the filter is nullptr, any unreferenced asset may be evicted.
+     * Eviction stops early if there are no more candidates, so the usage
+     * may remain above the target.
+     *
+     * This method is abstract and should be overridden in child classes to
+     * support the appropriate asset type.
+     *
+     * @param target    The target memory usage in bytes
+     * @param filter    The keys that may be evicted
+     *
+     * @return the keys of the evicted assets
+     */
+    virtual std::vector<std::string> evict(size_t /*target*/, const std::function<bool(const std::string& key)>& /*filter*/) {
+        return std::vector<std::string>();
+    }
+
+    /**
+     * Returns a new tick of the logical clock for asset usage.
+     *
+     * This clock is shared by all loaders, so that usage times may be
+     * compared across asset types.
+     *
+     * @return a new tick of the logical clock for asset usage.
+     */
+    static Uint64 tick() {
+        static std::atomic<Uint64> clock(0);
+        return ++clock;
+    }
 
 #pragma mark Progress Monitoring
     /**
@@ -516,6 +625,22 @@ public:
         return verify(key);
     }
 
+    /**
+     * Synchronously materializes a missing asset on demand
+     *
+     * Some loaders (e.g. {@link Scene2Loader}) defer part of their work
+     * until an asset is first needed. This method materializes such an
+     * asset, and is used by {@link AssetManager#get} when an asset is
+     * missing. It must be called in the main thread.
+     *
+     * @param key   The key associated with the asset
+     *
+     * @return true if the asset was materialized
+     */
+    bool request(const std::string key) {
+        return demand(key);
+    }
+
     /**
      * Returns the number of assets currently loaded.
      *
@@ -602,6 +727,27 @@ protected:
     /** The assets we are expecting that are not yet loaded */
     std::unordered_set<std::string> _queue;
 
+    /** The last time (in clock ticks) each asset was accessed */
+    mutable std::unordered_map<std::string, Uint64> _usage;
+    /** A mutex for the usage times, as scenes may be built off thread */
+    mutable std::mutex _usemutex;
+
+    /**
+     * Returns the number of bytes used by the given asset.
+     *
+     * Assets that share their memory with another asset (e.g. subtextures)
+     * should return 0. Those assets are never evicted.
+     *
+     * This method is abstract and should be overridden in child classes to
+     * support the appropriate asset type. The default returns 0, meaning
+     * that the asset is not tracked.
+     *
+     * @param asset The asset to measure
+     *
+     * @return the number of bytes used by the given asset.
+     */
+    virtual size_t measure(const std::shared_ptr<T>& /*asset*/) const { return 0; }
+
     /**
      * Returns the set of active keys in this loader.
      *
@@ -652,6 +798,28 @@ protected:
         return _assets.find(key) != _assets.end();
     }
     
+    /**
+     * Synchronously reloads the asset for the given directory entry
+     *
+     * This method purges the asset and reads it again, so objects that
+     * reference the old asset will continue to use it. If the asset fails
+     * to load (e.g. the file is only partially written), the old asset is
+     * restored so that the key remains valid.
+     *
+     * @param json      The directory entry for the asset
+     *
+     * @return true if the asset was successfully reloaded
+     */
+    bool refresh(const std::shared_ptr<JsonValue>& json) override {
+        std::shared_ptr<T> previous = get(json->key());
+        unload(json);
+        bool success = load(json);
+        if (!success && previous != nullptr && !verify(json->key())) {
+            _assets[json->key()] = previous;
+        }
+        return success;
+    }
+    
 public:
 #pragma mark Constructors
     /**
@@ -674,9 +842,14 @@ public:
      *
      * @return the asset pointer for the given key
      */
-    std::shared_ptr<T> get(const std::string key) const {
+    std::shared_ptr<T> get(const std::string& key) const {
         auto it = _assets.find(key);
-        return (it == _assets.end() ? nullptr : it->second);
+        if (it == _assets.end()) {
+            return nullptr;
+        }
+        std::lock_guard<std::mutex> lock(_usemutex);
+        _usage[key] = tick();
+        return it->second;
     }
     
     /**
@@ -691,6 +864,18 @@ public:
      */
     std::shared_ptr<T> operator[](const std::string key) const { return get(key); }
 
+    /**
+     * Returns the asset for the given key.
+     *
+     * This version takes an interned key, which avoids allocating a string
+     * for keys that are looked up every frame.
+     *
+     * @param key   The interned key associated with the asset
+     *
+     * @return the asset pointer for the given key
+     */
+    std::shared_ptr<T> get(const Symbol key) const { return get(key.str()); }
+
 #pragma mark Asset Loading
     /**
      * Returns the number of assets currently loaded.
@@ -724,6 +909,73 @@ public:
      */
     void unloadAll() override {
         _assets.clear();
+        std::lock_guard<std::mutex> lock(_usemutex);
+        _usage.clear();
+    }
+
+#pragma mark Memory Management
+    /**
+     * Returns the number of bytes used by the assets in this loader.
+     *
+     * This value is the sum of {@link #measure} over all loaded assets.
+     *
+     * @return the number of bytes used by the assets in this loader.
+     */
+    size_t getMemoryUsage() const override {
+        size_t total = 0;
+        for (auto it = _assets.begin(); it != _assets.end(); ++it) {
+            total += measure(it->second);
+        }
+        return total;
+    }
+
+    /**
+     * Evicts the least recently used assets until usage is at most target.
+     *
+     * An asset may only be evicted if this loader is its sole owner, so
+     * eviction never invalidates a pointer held elsewhere in the game. The
+     * filter further restricts eviction to the keys for which it returns
+     * true. If the filter is nullptr, any unreferenced asset may be evicted.
+     * Eviction stops early if there are no more candidates, so the usage
+     * may remain above the target.
+     *
+     * @param target    The target memory usage in bytes
+     * @param filter    The keys that may be evicted
+     *
+     * @return the keys of the evicted assets
+     */
+    std::vector<std::string> evict(size_t target, const std::function<bool(const std::string& key)>& filter) override {
+        struct Candidate {
+            Uint64 time;
+            size_t bytes;
+            std::string key;
+        };
+
+        size_t total = 0;
+        std::vector<Candidate> candidates;
+        std::vector<std::string> result;
+        std::lock_guard<std::mutex> lock(_usemutex);
+        for (auto it = _assets.begin(); it != _assets.end(); ++it) {
+            size_t bytes = measure(it->second);
+            total += bytes;
+            if (bytes > 0 && it->second.use_count() == 1 && (!filter || filter(it->first))) {
+                auto jt = _usage.find(it->first);
+                candidates.push_back({jt == _usage.end() ? 0 : jt->second, bytes, it->first});
+            }
+        }
+        if (total <= target) {
+            return result;
+        }
+
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const Candidate& a, const Candidate& b) { return a.time < b.time; });
+        for (auto it = candidates.begin(); it != candidates.end() && total > target; ++it) {
+            _assets.erase(it->key);
+            _usage.erase(it->key);
+            total -= it->bytes;
+            result.push_back(it->key);
+        }
+        return result;
     }
 };
 
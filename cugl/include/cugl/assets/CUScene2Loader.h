@@ -143,6 +143,9 @@ protected:
     
     /** The type map for managing layout */
     std::unordered_map<std::string,Form> _forms;
+
+    /** The placeholders for deferred subtrees, by asset key */
+    std::unordered_map<std::string,std::weak_ptr<scene2::SceneNode>> _deferred;
     
     /**
      * Records the given Node with this loader, so that it may be unloaded later.
@@ -234,6 +237,22 @@ protected:
      */
     virtual bool purge(const std::shared_ptr<JsonValue>& json) override;
     
+    /**
+     * Synchronously reloads the asset for the given directory entry
+     *
+     * This method rebuilds the scene from the directory entry, using the
+     * current versions of any assets (textures, fonts, widgets) that it
+     * references. The new scene replaces the old one (and all of its
+     * named descendants) in the asset dictionary. Objects that reference
+     * the old scene will continue to use it, so they should fetch the
+     * scene again after it is reloaded.
+     *
+     * @param json      The directory entry for the asset
+     *
+     * @return true if the asset was successfully reloaded
+     */
+    virtual bool refresh(const std::shared_ptr<JsonValue>& json) override;
+    
     /**
      * Attaches all generate nodes to the asset dictionary.
      *
@@ -248,6 +267,47 @@ protected:
      */
     bool attach(const std::string& key, const std::shared_ptr<scene2::SceneNode>& node);
 
+    /**
+     * Detaches a previously attached node tree from the asset dictionary.
+     *
+     * This method is the inverse of {@link #attach}, and assumes that the
+     * keys for the descendants were generated by that method.
+     *
+     * @param key       The key to access the asset
+     * @param node      The scene asset
+     */
+    void detach(const std::string& key, const std::shared_ptr<scene2::SceneNode>& node);
+
+    /**
+     * Replaces the placeholder of a deferred subtree with the given node.
+     *
+     * The node takes the place of the placeholder in its parent, and is
+     * positioned by the layout manager of the parent. The node (and all of
+     * its named descendants) are then attached to the asset dictionary.
+     * This method must be called in the main thread.
+     *
+     * @param holder    The placeholder for the deferred subtree
+     * @param node      The materialized subtree
+     *
+     * @return true if the node was successfully attached
+     */
+    bool replace(const std::shared_ptr<scene2::SceneNode>& holder,
+                 const std::shared_ptr<scene2::SceneNode>& node);
+    
+    /**
+     * Materializes the deferred subtree containing the given key.
+     *
+     * The key may either be the key of the deferred subtree, or the key of
+     * one of its descendants. In the latter case, any deferred subtrees
+     * nested inside of the first one are materialized as well. This method
+     * must be called in the main thread.
+     *
+     * @param key   The key associated with the asset
+     *
+     * @return true if the asset was materialized
+     */
+    virtual bool demand(const std::string key) override;
+
 	/**
 	 * Translates the JSON of a widget to the JSON of the node that it encodes.
 	 *
@@ -319,6 +379,7 @@ public:
     void dispose() override {
         _manager = nullptr;
         _assets.clear();
+        _deferred.clear();
         _loader = nullptr;
         _types.clear();
         _forms.clear();
@@ -378,8 +439,17 @@ public:
      *                  layout-specific format.
      *      "children": Any child Nodes of this one. This JSON object has a
      *                  named attribute for each child.
+     *      "deferred": Whether to defer building this subtree until it is
+     *                  first drawn or accessed (see {@link #expand}).
      *
-     * With the exception of "type", all of these attributes are JSON objects.
+     * With the exception of "type" and "deferred", all of these attributes
+     * are JSON objects. The root of the scene is never deferred. Children
+     * that fail to build are omitted from their parent.
+     *
+     * Deferred placeholders are only registered with this loader when the
+     * scene is attached to the asset dictionary. A scene built directly with
+     * this method, such as a {@link LevelStreamer} chunk, keeps any deferred
+     * subtrees as empty placeholders that are never expanded.
      *
      * @param key       The key to access the scene after loading
      * @param json      The JSON object defining the scene
@@ -388,6 +458,75 @@ public:
      */
     std::shared_ptr<scene2::SceneNode> build(const std::string& key, const std::shared_ptr<JsonValue>& json) const;
     
+    /**
+     * Unloads all assets present in this loader.
+     *
+     * Any deferred subtrees that have not been materialized are discarded.
+     */
+    void unloadAll() override {
+        Loader<scene2::SceneNode>::unloadAll();
+        _deferred.clear();
+    }
+    
+#pragma mark -
+#pragma mark Deferred Subtrees
+    /**
+     * Returns true if the given key refers to an unmaterialized subtree.
+     *
+     * A subtree is deferred if its widget has the attribute "deferred" set
+     * to true. Such a subtree is built as a placeholder node, which has the
+     * position and size of the subtree (if specified in its "data"), but
+     * draws nothing. The subtree is materialized when the placeholder is
+     * first drawn, when any key inside of it is requested from the asset
+     * manager, or when it is explicitly expanded. Until then, neither the
+     * subtree nor its descendants are in the asset dictionary.
+     *
+     * @param key   The key associated with the subtree
+     *
+     * @return true if the given key refers to an unmaterialized subtree.
+     */
+    bool isDeferred(const std::string& key) const;
+    
+    /**
+     * Returns the number of deferred subtrees that are not yet materialized.
+     *
+     * @return the number of deferred subtrees that are not yet materialized.
+     */
+    size_t deferredCount() const { return _deferred.size(); }
+    
+    /**
+     * Synchronously materializes the given deferred subtree.
+     *
+     * The subtree replaces its placeholder in the scene graph, and it (and
+     * all of its named descendants) are added to the asset dictionary. Any
+     * deferred subtrees nested inside of it remain deferred. This method
+     * must be called in the main thread.
+     *
+     * @param key   The key associated with the subtree
+     *
+     * @return true if the subtree was materialized
+     */
+    bool expand(const std::string& key);
+    
+    /**
+     * Asynchronously materializes the given deferred subtree.
+     *
+     * The scene nodes are built in the thread pool of this loader, while
+     * the subtree replaces its placeholder in the main thread, via
+     * {@link Application#schedule}. If this loader has no thread pool,
+     * the subtree is materialized synchronously in the next animation frame.
+     * This method is called automatically when a placeholder is first drawn.
+     *
+     * The optional callback function will be called with the key of the
+     * subtree when it is materialized or fails to materialize.
+     *
+     * @param key       The key associated with the subtree
+     * @param callback  An optional callback for when the subtree is built
+     *
+     * @return true if the subtree was queued for materialization
+     */
+    bool expandAsync(const std::string& key, LoaderCallback callback=nullptr);
+    
 };
     
 }
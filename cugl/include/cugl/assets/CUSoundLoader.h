@@ -141,6 +141,18 @@ protected:
      */
     virtual bool read(const std::shared_ptr<JsonValue>& json,
                       LoaderCallback callback, bool async) override;
+
+    /**
+     * Returns the number of bytes used by the given sound.
+     *
+     * This is the size of the in-memory sample buffer. Streamed samples
+     * only hold a small page buffer, and so return 0.
+     *
+     * @param asset The sound to measure
+     *
+     * @return the number of bytes used by the given sound.
+     */
+    virtual size_t measure(const std::shared_ptr<Sound>& asset) const override;
     
     
 public:
@@ -236,6 +236,33 @@ protected:
      */
     virtual bool purge(const std::shared_ptr<JsonValue>& json) override;
     
+    /**
+     * Synchronously reloads the asset for the given directory entry
+     *
+     * If the texture is already loaded, the image is replaced in place
+     * (see {@link Texture#set}). Therefore any object that references the
+     * texture, including any atlas subtextures, will see the new image.
+     * The texture settings (filters, wrap, mipmaps) are reapplied from the
+     * directory entry. If the texture is not loaded, it is read as normal.
+     *
+     * @param json      The directory entry for the asset
+     *
+     * @return true if the asset was successfully reloaded
+     */
+    virtual bool refresh(const std::shared_ptr<JsonValue>& json) override;
+
+    /**
+     * Returns the number of bytes used by the given texture.
+     *
+     * This is the size of the pixel data on the GPU, including mipmaps.
+     * Subtextures share the memory of their parent, and so return 0.
+     *
+     * @param asset The texture to measure
+     *
+     * @return the number of bytes used by the given texture.
+     */
+    virtual size_t measure(const std::shared_ptr<Texture>& asset) const override;
+    
 public:
 #pragma mark -
 #pragma mark Constructors
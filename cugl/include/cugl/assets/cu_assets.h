@@ -32,6 +32,7 @@
 #include "CUJsonValue.h"
 #include "CUWidgetValue.h"
 #include "CUAssetManager.h"
+#include "CUAssetWatcher.h"
 #include "CUTextureLoader.h"
 #include "CUFontLoader.h"
 #include "CUSoundLoader.h"
@@ -39,5 +40,7 @@
 #include "CUWidgetLoader.h"
 #include "CUScene2Loader.h"
 #include "CUGenericLoader.h"
+#include "CULevelChunk.h"
+#include "CULevelStreamer.h"
 
 #endif /* __CU_ASSETS_PKG_H__ */
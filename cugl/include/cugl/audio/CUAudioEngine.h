@@ -42,6 +42,7 @@
 #include <cugl/audio/CUAudioDevices.h>
 #include <cugl/audio/CUSound.h>
 #include <cugl/util/CUTimestamp.h>
+#include <cugl/util/CUSymbol.h>
 #include <unordered_map>
 #include <functional>
 #include <vector>
@@ -450,7 +451,7 @@ public:
      *
      * @return true if there was an available channel for the sound
      */
-    bool play(const std::string key, const std::shared_ptr<Sound>& sound,
+    bool play(const std::string& key, const std::shared_ptr<Sound>& sound,
               bool loop=false, float volume=1.0f, bool force=false);
 
     /**
@@ -483,8 +484,48 @@ public:
      *
      * @return true if there was an available channel for the sound
      */
-    bool play(const std::string key, const std::shared_ptr<audio::AudioNode>& graph,
+    bool play(const std::string& key, const std::shared_ptr<audio::AudioNode>& graph,
               bool loop=false, float volume=1.0f, bool force=false);
+
+    /**
+     * Plays the given sound, and associates it with the specified key.
+     *
+     * This version of play takes an interned key. This avoids allocating a
+     * new string every time a sound effect is played from a constant key.
+     * Otherwise, it is identical to the string version.
+     *
+     * @param  key      The reference key for the sound effect
+     * @param  sound    The sound effect to play
+     * @param  loop     Whether to loop the sound effect continuously
+     * @param  volume   The music volume (relative to the default asset volume)
+     * @param  force    Whether to force another sound to stop.
+     *
+     * @return true if there was an available channel for the sound
+     */
+    bool play(const Symbol key, const std::shared_ptr<Sound>& sound,
+              bool loop=false, float volume=1.0f, bool force=false) {
+        return play(key.str(),sound,loop,volume,force);
+    }
+
+    /**
+     * Plays the given audio node, and associates it with the specified key.
+     *
+     * This version of play takes an interned key. This avoids allocating a
+     * new string every time a sound effect is played from a constant key.
+     * Otherwise, it is identical to the string version.
+     *
+     * @param  key      The reference key for the sound effect
+     * @param  graph    The audio graph to play
+     * @param  loop     Whether to loop the sound effect continuously
+     * @param  volume   The music volume (relative to the default instance volume)
+     * @param  force    Whether to force another sound to stop.
+     *
+     * @return true if there was an available channel for the sound
+     */
+    bool play(const Symbol key, const std::shared_ptr<audio::AudioNode>& graph,
+              bool loop=false, float volume=1.0f, bool force=false) {
+        return play(key.str(),graph,loop,volume,force);
+    }
     
     /**
      * Returns the number of slots available for sound effects.
@@ -511,7 +552,7 @@ public:
      *
      * @return the current state of the sound effect for the given key.
      */
-    State getState(const std::string key) const;
+    State getState(const std::string& key) const;
 
     /**
      * Returns true if the key is associated with an active sound.
@@ -520,10 +561,21 @@ public:
      *
      * @return true if the key is associated with an active sound.
      */
-    bool isActive(const std::string key) const {
+    bool isActive(const std::string& key) const {
         return _actives.find(key) != _actives.end();
     }
 
+    /**
+     * Returns true if the key is associated with an active sound.
+     *
+     * @param  key  the interned reference key for the sound effect
+     *
+     * @return true if the key is associated with an active sound.
+     */
+    bool isActive(const Symbol key) const {
+        return _actives.find(key.str()) != _actives.end();
+    }
+
     /**
      * Returns the identifier for the asset attached to the given key.
      *
@@ -535,7 +587,7 @@ public:
      *
      * @return the identifier for the asset attached to the given key.
      */
-    const std::string getSource(const std::string key) const;
+    const std::string getSource(const std::string& key) const;
 
     /**
      * Returns true if the sound effect is in a continuous loop.
@@ -547,7 +599,7 @@ public:
      *
      * @return true if the sound effect is in a continuous loop.
      */
-    bool isLoop(const std::string key) const;
+    bool isLoop(const std::string& key) const;
 
     /**
      * Sets whether the sound effect is in a continuous loop.
@@ -558,7 +610,7 @@ public:
      * @param  key  the reference key for the sound effect
      * @param  loop whether the sound effect is in a continuous loop
      */
-    void setLoop(const std::string key, bool loop);
+    void setLoop(const std::string& key, bool loop);
 
     /**
      * Returns the current volume of the sound effect.
@@ -576,7 +628,7 @@ public:
      *
      * @return the current volume of the sound effect
      */
-    float getVolume(const std::string key) const;
+    float getVolume(const std::string& key) const;
 
     /**
      * Sets the current volume of the sound effect.
@@ -593,7 +645,7 @@ public:
      * @param  key      the reference key for the sound effect
      * @param  volume   the current volume of the sound effect
      */
-    void setVolume(const std::string key, float volume);
+    void setVolume(const std::string& key, float volume);
 
     /**
      * Returns the stereo pan of the sound effect.
@@ -636,7 +688,7 @@ public:
      * @param  key  the reference key for the sound effect
      * @param  pan  the stereo pan of the sound effect
      */
-    void setPanFactor(const std::string key, float pan);
+    void setPanFactor(const std::string& key, float pan);
 
     /**
      * Returns the duration of the sound effect, in seconds.
@@ -651,7 +703,7 @@ public:
      *
      * @return the duration of the sound effect, in seconds.
      */
-    float getDuration(const std::string key) const;
+    float getDuration(const std::string& key) const;
 
     /**
      * Returns the elapsed time of the sound effect, in seconds
@@ -670,7 +722,7 @@ public:
      *
      * @return the elapsed time of the sound effect, in seconds
      */
-    float getTimeElapsed(const std::string key) const;
+    float getTimeElapsed(const std::string& key) const;
 
     /**
      * Sets the elapsed time of the sound effect, in seconds
@@ -688,7 +740,7 @@ public:
      * @param  key  the reference key for the sound effect
      * @param  time the new position of the sound effect
      */
-    void setTimeElapsed(const std::string key, float time);
+    void setTimeElapsed(const std::string& key, float time);
 
     /**
      * Returns the time remaining for the sound effect, in seconds
@@ -706,7 +758,7 @@ public:
      *
      * @return the time remaining for the sound effect, in seconds
      */
-    float geTimeRemaining(const std::string key) const;
+    float geTimeRemaining(const std::string& key) const;
 
     /**
      * Sets the time remaining for the sound effect, in seconds
@@ -723,7 +775,7 @@ public:
      * @param  key  the reference key for the sound effect
      * @param  time the new time remaining for the sound effect
      */
-    void setTimeRemaining(const std::string key, float time);
+    void setTimeRemaining(const std::string& key, float time);
 
     /**
      * Removes the sound effect for the given key, stopping it immediately
@@ -743,7 +795,20 @@ public:
      * @param  key  the reference key for the sound effect
      * @param fade  the number of seconds to fade out
      */
-    void clear(const std::string key,float fade=DEFAULT_FADE);
+    void clear(const std::string& key,float fade=DEFAULT_FADE);
+
+    /**
+     * Clears the sound effect for the given key.
+     *
+     * This version takes an interned key. Otherwise, it is identical to the
+     * string version.
+     *
+     * @param  key  the interned reference key for the sound effect
+     * @param  fade the number of seconds to fade out
+     */
+    void clear(const Symbol key,float fade=DEFAULT_FADE) {
+        clear(key.str(),fade);
+    }
 
     /**
      * Pauses the sound effect for the given key.
@@ -760,7 +825,7 @@ public:
      * @param  key  the reference key for the sound effect
      * @param fade  the number of seconds to fade out
      */
-    void pause(const std::string key,float fade=DEFAULT_FADE);
+    void pause(const std::string& key,float fade=DEFAULT_FADE);
 
     /**
      * Resumes the sound effect for the given key.
@@ -769,7 +834,7 @@ public:
      *
      * @param  key  the reference key for the sound effect
      */
-    void resume(std::string key);
+    void resume(const std::string& key);
 
     /**
      * Sets the callback for sound effects
@@ -70,6 +70,15 @@ namespace  cugl {
  * it is compact and ideal for real-time sound generation. It is also good
  * enough for procedural sound generation in most games.
  *
+ * Alternatively, a waveform may be put in wavetable mode (see
+ * {@link setWavetable}). In this mode, all waveforms other than noise are
+ * read from precomputed band-limited tables, with one table per octave of
+ * the fundamental frequency. These tables are built once and shared by all
+ * waveforms. The cost of a wavetable oscillator is the same for every type,
+ * and is much lower than the analytic PolyBLEP and BLIT algorithms. The naive
+ * and band-limited versions of a waveform share the same table, so in this
+ * mode every waveform is band-limited.
+ *
  * The audio graph should only be accessed in the main thread.  In addition,
  * no methods marked as AUDIO THREAD ONLY should ever be accessed by the user.
  *
@@ -187,6 +196,8 @@ protected:
     std::atomic<bool>   _newfreq;
     /** The duration in seconds; -1 if infinite */
     std::atomic<double> _duration;
+    /** Whether to read the waveform from a precomputed wavetable */
+    std::atomic<bool>   _wavetable;
 
     /** The random generator for noise */
     std::minstd_rand0   _random;
@@ -323,6 +334,7 @@ public:
      *      "rate":     An int, representing the sample rate
      *      "volume":   A float, representing the volume
      *      "duration"  A float, representing the duration in seconds
+     *      "wavetable" A boolean, indicating whether to use wavetable mode
      *
      * All attributes are optional.  There are no required attributes. The
      * recognized shapes are as follows: noise, sine, native triangle, naive
@@ -378,6 +390,34 @@ public:
      */
     void setUpper(bool upper);
 
+    /**
+     * Returns true if this waveform is read from a precomputed wavetable.
+     *
+     * In wavetable mode, all waveforms other than noise are read from
+     * band-limited tables using interpolated lookups. The tables are
+     * mipmapped by octave, so that no harmonic exceeds the Nyquist frequency.
+     * The naive and band-limited versions of a waveform share the same table.
+     *
+     * @return true if this waveform is read from a precomputed wavetable.
+     */
+    bool isWavetable() const;
+    
+    /**
+     * Sets whether this waveform is read from a precomputed wavetable.
+     *
+     * In wavetable mode, all waveforms other than noise are read from
+     * band-limited tables using interpolated lookups. The tables are
+     * mipmapped by octave, so that no harmonic exceeds the Nyquist frequency.
+     * The naive and band-limited versions of a waveform share the same table.
+     *
+     * The tables are shared by all waveforms, and are built the first time
+     * they are needed. This method builds the tables for the current type
+     * so that this cost is not paid in the audio thread.
+     *
+     * @param value Whether this waveform is read from a precomputed wavetable.
+     */
+    void setWavetable(bool value);
+
     /**
      * Returns the fundamental frequency of this waveform.
      *
@@ -266,7 +266,7 @@ public:
      *
      * @return the number of frames actually read (-1 on error).
      */
-    Sint32 decode(float* buffer);
+    virtual Sint32 decode(float* buffer);
 
 };
     }
@@ -145,19 +145,43 @@ public:
         return _blocksize;
     }
     
+    /**
+     * Returns the number of encoded bytes in a single page
+     *
+     * This is the amount of data read from the file for each page.
+     *
+     * @return the number of encoded bytes in a single page
+     */
+    Uint32 getBlockAlign() const {
+        return _wavefmt.blockalign;
+    }
+    
     /**
      * Reads a single page from the given file.
      *
      * The buffer should be able to store block size * channels * 2 bytes of
-     * data (the latter 2 representing sizeof(Sint16) ). If the read fails,
-     * this method returns -1.
+     * data (the latter 2 representing sizeof(Sint16) ). The samples are
+     * stored in native byte order. If the read fails, this method returns -1.
      *
      * @param source    The source file
      * @param buffer    The buffer to store the decoded data
      *
      * @return the number of bytes read (or -1 on error)
      */
-    virtual Sint32 read(SDL_RWops* source, Uint8* buffer) = 0;
+    Sint32 read(SDL_RWops* source, Uint8* buffer);
+    
+    /**
+     * Decodes a single encoded block into the given buffer.
+     *
+     * The block must have {@link getBlockAlign} many bytes, and the buffer
+     * must be able to store block size * channels many samples (in native
+     * byte order). Decoding state is local to each block, so this method
+     * is safe to call on different blocks from different threads.
+     *
+     * @param block     The encoded block
+     * @param output    The buffer to store the decoded samples
+     */
+    virtual void decode(const Uint8* block, Sint16* output) const = 0;
 };
    
 
@@ -320,6 +344,25 @@ public:
      */
     virtual Sint32 pagein(float* buffer) override;
     
+    /**
+     * Decodes the entire audio file, storing its value in buffer.
+     *
+     * The buffer should be able to hold channels * frames many elements.
+     * The data is interpretted as floats and channels are all interleaved.
+     * If the method returns -1, then an error occurred during reading.
+     *
+     * ADPCM blocks are independent of one another. Therefore, for ADPCM
+     * data this method reads the encoded data in a single pass and decodes
+     * the blocks in parallel. The helper threads are shared by all decoders,
+     * so preloading many sounds at once does not oversubscribe the CPU.
+     * Other encodings are paged in as normal.
+     *
+     * @param buffer    The buffer to store the audio data
+     *
+     * @return the number of frames actually read (-1 on error).
+     */
+    virtual Sint32 decode(float* buffer) override;
+    
     /**
      * Sets the current page of this decoder
      *
@@ -68,18 +68,64 @@ namespace cugl {
  */
 class AudioPanner : public AudioNode {
 private:
+    /**
+     * This class represents a single panning state.
+     *
+     * The panner keeps three of these states so that the field and matrix can
+     * be updated without blocking the audio thread. At any time, one state is
+     * owned by the audio thread (the front), one by the main thread (the
+     * back), and the third is the most recently published state waiting to
+     * be picked up by the audio thread.
+     */
+    class Mixer {
+    public:
+        /** The number of input channels for this matrix */
+        Uint8  field;
+        /** The panning matrix (channels x field; may be nullptr) */
+        float* matrix;
+        /** The capacity of the matrix */
+        Uint32 matcap;
+        /** An intermediate read buffer for the input (may be nullptr) */
+        float* buffer;
+        /** The capacity of the read buffer */
+        Uint32 bufcap;
+        
+        /**
+         * Creates an empty panning state
+         */
+        Mixer() : field(0), matrix(nullptr), matcap(0), buffer(nullptr), bufcap(0) {}
+    };
+    
     /** The channel size of the input node */
     Uint8 _field;
-    
-    /** The intermediate read buffer */
-    float* _buffer;
-    /** The capacity of the intermediate buffer */
+    /** The number of frames to read from the input at a time */
     Uint32 _capacity;
     
     /** The audio input node */
     std::shared_ptr<AudioNode> _input;
-    /** The panning matrix */
-    std::atomic<float>* _mapper;
+    /** The panning matrix (field x channels; main thread only) */
+    float* _mapper;
+    
+    /** The panning states (front, back, and published) */
+    Mixer _mixers[3];
+    /** The index of the published state, together with a fresh bit */
+    std::atomic<Uint8> _mixstate;
+    /** The index of the state owned by the audio thread */
+    Uint8 _mixfront;
+    /** The index of the state owned by the main thread */
+    Uint8 _mixback;
+    
+    /**
+     * Publishes the current field and panning matrix to the audio thread
+     *
+     * This method writes the current field and matrix to the state owned by
+     * the main thread and swaps it with the published state. The audio thread
+     * picks up the change at the start of its next read, and the state that
+     * it releases becomes the new back state. Hence no state is freed or
+     * resized while the audio thread is using it, and neither thread ever
+     * waits on the other.
+     */
+    void publish();
 
 #pragma mark -
 #pragma mark Constructors
@@ -40,7 +40,7 @@
 #define __CU_AUDIO_REDISTRIBUTOR_H__
 #include <SDL/SDL.h>
 #include "CUAudioNode.h"
-#include <mutex>
+#include <atomic>
 
 namespace cugl {
 
@@ -65,7 +65,12 @@ namespace cugl {
  * channels, in much the same way that a matrix decoder works. However, unlike
  * a matrix decoder, it is possible to use a redistributor to reduce the number
  * of channels (with a matrix whose rows are less that is columns). Furthermore,
- * a redistributor does not support phase shifting.
+ * a redistributor does not support phase shifting. The default redistribution
+ * algorithms are themselves represented as matrices, so all redistribution
+ * uses the mixing kernels in {@link dsp::DSPMath}.
+ *
+ * Changes to the matrix are published to the audio thread without locks. The
+ * audio thread will pick up the new matrix at the start of its next read.
  *
  * The audio graph should only be accessed in the main thread.  In addition,
  * no methods marked as AUDIO THREAD ONLY should ever be accessed by the user.
@@ -74,66 +79,67 @@ namespace cugl {
  */
 class AudioRedistributor : public AudioNode {
 private:
-    /** Mutex to protect more sophisticated synchronization */
-    mutable std::mutex _buffmtex;
-
+    /**
+     * This class represents a single redistribution state.
+     *
+     * The redistributor keeps three of these states so that the matrix can be
+     * updated without blocking the audio thread. At any time, one state is
+     * owned by the audio thread (the front), one by the main thread (the
+     * back), and the third is the most recently published state waiting to
+     * be picked up by the audio thread.
+     */
+    class Mixer {
+    public:
+        /** The number of input channels for this matrix */
+        Uint8  conduits;
+        /** Whether the matrix is the identity (so no mixing is necessary) */
+        bool   identity;
+        /** The redistribution matrix (channels x conduits; may be nullptr) */
+        float* matrix;
+        /** The capacity of the matrix */
+        Uint32 matcap;
+        /** An intermediate read buffer for the input (may be nullptr) */
+        float* buffer;
+        /** The capacity of the read buffer */
+        Uint32 bufcap;
+        
+        /**
+         * Creates an empty redistribution state
+         */
+        Mixer() : conduits(0), identity(false), matrix(nullptr), matcap(0), buffer(nullptr), bufcap(0) {}
+    };
+    
     /** The audio input node */
     std::shared_ptr<AudioNode> _input;
     /** The currently supported input channels size */
     std::atomic<Uint8> _conduits;
 
-    /** The distribution function for default behavior */
-    std::function<void(const float*, float*, size_t)> _director;
-    
-    /** The redistribution matrix (may be nullptr) */
+    /** The user-specified redistribution matrix (nullptr for the default) */
     float* _matrix;
-    /** The size of the redistribution matrix (may be 0) */
-    std::atomic<Uint32> _matsize;
+    /** The size of the user-specified redistribution matrix (may be 0) */
+    Uint32 _matsize;
     
-    /** An intermediate buffer for downscaling (may be nullptr) */
-    float* _buffer;
-    /** The capacity of the buffer */
-    Uint32 _pagesize;
+    /** The redistribution states (front, back, and published) */
+    Mixer _mixers[3];
+    /** The index of the published state, together with a fresh bit */
+    std::atomic<Uint8> _mixstate;
+    /** The index of the state owned by the audio thread */
+    Uint8 _mixfront;
+    /** The index of the state owned by the main thread */
+    Uint8 _mixback;
     
-    /**
-     * Redistribute from buffer input to buffer output
-     *
-     * The buffer input should have {@link #getConduits()} channels
-     * worth of data, while output should support {@link #getChannels()}
-     * channels. However, this method is safe to call in-place,
-     * provided that the buffer is large enough to support the
-     * new output data.
-     *
-     * This version of the method assumes that output has more channels
-     * than input. This distinction is necessary to support in-place
-     * redistribution. The value size is specified in terms of frames,
-     * not samples, so that it does not include any channel information.
-     *
-     * @param input     The input buffer
-     * @param output    The output buffer
-     * @param size      The number of audio frames to process
-     */
-    void scaleUp(const float* input, float* output, size_t size);
+    /** The number of frames to read from the input at a time */
+    Uint32 _pagesize;
     
     /**
-     * Redistribute from buffer input to buffer output
-     *
-     * The buffer input should have {@link #getConduits()} channels
-     * worth of data, while output should support {@link #getChannels()}
-     * channels. However, this method is safe to call in-place,
-     * provided that the buffer is large enough to support the
-     * new output data.
-     *
-     * This version of the method assumes that input has more channels
-     * than output. This distinction is necessary to support in-place
-     * redistribution. The value size is specified in terms of frames,
-     * not samples, so that it does not include any channel information.
+     * Publishes the current redistribution settings to the audio thread
      *
-     * @param input     The input buffer
-     * @param output    The output buffer
-     * @param size      The number of audio frames to process
+     * This method writes the current number of conduits and matrix to the
+     * state owned by the main thread and swaps it with the published state.
+     * The audio thread picks up the change at the start of its next read.
+     * Neither thread ever waits on the other.
      */
-    void scaleDown(const float* input, float* output, size_t);
+    void publish();
 
 public:
 #pragma mark -
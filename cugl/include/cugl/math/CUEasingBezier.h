@@ -73,35 +73,48 @@ protected:
     /** The C3 coefficient */
     Vec2 _c3;
     
-    /** The rootset of the polynomial x-component (cached for efficiency). */
-    std::vector<float> _rootset;
-     
+    /** The parameter t for evenly spaced x values (size is one more than the cells) */
+    std::vector<float> _table;
+    /** Whether each table cell is too flat for Newton's method (1 if so) */
+    std::vector<Uint8> _flat;
+    /** Whether any table cell is too flat for Newton's method */
+    bool _hasflat;
+
+    /**
+     * Builds the lookup table for inverting the x-component.
+     *
+     * The table stores the parameter t for evenly spaced values of x,
+     * computed to double precision. It also marks the cells where the
+     * x-component is too flat for Newton's method to converge quickly.
+     * This only happens when a handle lies on the boundary of the unit
+     * square (e.g. {@link EasingFunction::Type::EXPO_IN_OUT}).
+     */
+    void buildTable();
+
     /**
-     * Stores the roots of a x^2 + b x + c into the rootset.
+     * Returns the parameter t for x in the given cell, using bisection.
      *
-     * This is a helper function for computing the root set from the
-     * bezier polynomial.
+     * This is the slow path for cells marked as flat. It is still
+     * constant time, as the number of iterations is fixed.
      *
-     * @param a The 2nd degree coefficient
-     * @param b The linear coefficient
-     * @param c The constant factor
+     * @param x     The x value to invert
+     * @param cell  The table cell containing x
+     *
+     * @return the parameter t for x in the given cell, using bisection.
      */
-    void solveQuadraticEquation(float a, float b, float c);
-    
+    float bisect(float x, size_t cell) const;
+
     /**
-     * Stores the roots of a x^3 + b x^2 + c x + d into the rootset.
+     * Returns the value of the polynomial y-component at parameter t.
      *
-     * This is a helper function for computing the root set from the
-     * bezier polynomial.
+     * @param t The bezier parameter
      *
-     * @param a The 3rd degree coefficient
-     * @param b The 2nd degree coefficient
-     * @param c The linear coefficient
-     * @param d The constant factor
+     * @return the value of the polynomial y-component at parameter t.
      */
-    void solveCubicEquation(float a, float b, float c, float d);
-   
-    
+    float polyY(float t) const {
+        return ((_c3.y*t+_c2.y)*t+_c1.y)*t;
+    }
+
 #pragma mark -
 #pragma mark Constructors
 public:
@@ -247,11 +260,37 @@ public:
     /**
      * Returns the value of the easing function at t.
      *
-     * The easing function is only well-defined when 0 <= t <= 1.
+     * The easing function is only well-defined when 0 <= t <= 1. Values
+     * outside of this range are clamped.
+     *
+     * This method is constant time. It looks up an initial guess for the
+     * bezier parameter in a precomputed table of 256 cells, and refines it
+     * with two Newton iterations. For any curve whose handles have x-values
+     * strictly inside (0,1) the error is less than 5e-5 (less than 5e-6 for
+     * the standard easing types). If a handle x-value is 0 or 1, the curve
+     * may have a vertical tangent, and the error near that tangent is limited
+     * by float precision (about 1e-2 for {@link EasingFunction::Type::EXPO_IN_OUT}).
+     *
+     * @param t The time value to ease
      *
      * @return the value of the easing function at t.
      */
-    float evaluate(float t);
+    float evaluate(float t) const;
+
+    /**
+     * Evaluates the easing function for an array of time values.
+     *
+     * This method is equivalent to calling {@link #evaluate} on each
+     * element of input, storing the result in output. However, it is
+     * vectorized when {@link CU_MATH_VECTOR_SSE} or {@link CU_MATH_VECTOR_NEON64}
+     * is defined, and so it is the preferred way to ease many tweens that
+     * share the same curve. The arrays may be the same.
+     *
+     * @param input     The time values to ease
+     * @param output    The array to store the eased values
+     * @param size      The number of values to ease
+     */
+    void evaluate(const float* input, float* output, size_t size) const;
 
     /**
      * Returns a pointer to the function represented by this object.
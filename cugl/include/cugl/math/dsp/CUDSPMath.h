@@ -196,6 +196,252 @@ public:
      */
     static size_t ease(float* data, float bound, float knee, size_t size);
 
+#pragma mark Conversion Methods
+    /**
+     * Converts a buffer of signed bytes into a buffer of floats
+     *
+     * Each value is multiplied by scale after conversion. So a scale of
+     * 1/128 will map the bytes onto the range [-1,1).
+     *
+     * @param input     The input buffer
+     * @param output    The output buffer
+     * @param size      The number of elements to convert
+     * @param scale     The scalar to multiply by
+     *
+     * @return the number of elements successfully converted
+     */
+    static size_t s8_to_float(const Sint8* input, float* output, size_t size, float scale);
+
+    /**
+     * Converts a buffer of unsigned bytes into a buffer of floats
+     *
+     * The bytes are centered on 128 (so 128 converts to 0), and each value
+     * is multiplied by scale after conversion. So a scale of 1/128 will map
+     * the bytes onto the range [-1,1).
+     *
+     * @param input     The input buffer
+     * @param output    The output buffer
+     * @param size      The number of elements to convert
+     * @param scale     The scalar to multiply by
+     *
+     * @return the number of elements successfully converted
+     */
+    static size_t u8_to_float(const Uint8* input, float* output, size_t size, float scale);
+
+    /**
+     * Converts a buffer of signed shorts into a buffer of floats
+     *
+     * Each value is multiplied by scale after conversion. So a scale of
+     * 1/32768 will map the shorts onto the range [-1,1). If swap is true,
+     * the endianness of each short is reversed before it is converted.
+     *
+     * @param input     The input buffer
+     * @param output    The output buffer
+     * @param size      The number of elements to convert
+     * @param scale     The scalar to multiply by
+     * @param swap      Whether to swap the endianness of the input
+     *
+     * @return the number of elements successfully converted
+     */
+    static size_t s16_to_float(const Sint16* input, float* output, size_t size, float scale, bool swap=false);
+
+    /**
+     * Converts a buffer of signed ints into a buffer of floats
+     *
+     * Each value is multiplied by scale after conversion. So a scale of
+     * 1/2^31 will map the ints onto the range [-1,1). If swap is true,
+     * the endianness of each int is reversed before it is converted.
+     *
+     * @param input     The input buffer
+     * @param output    The output buffer
+     * @param size      The number of elements to convert
+     * @param scale     The scalar to multiply by
+     * @param swap      Whether to swap the endianness of the input
+     *
+     * @return the number of elements successfully converted
+     */
+    static size_t s32_to_float(const Sint32* input, float* output, size_t size, float scale, bool swap=false);
+
+    /**
+     * Converts a buffer of floats into a buffer of signed bytes
+     *
+     * The floats are assumed to be in the range [-1,1]. Values outside of
+     * this range are clamped, with -1 converting to the minimum byte and
+     * 1 converting to the maximum.
+     *
+     * @param input     The input buffer
+     * @param output    The output buffer
+     * @param size      The number of elements to convert
+     *
+     * @return the number of elements successfully converted
+     */
+    static size_t float_to_s8(const float* input, Sint8* output, size_t size);
+
+    /**
+     * Converts a buffer of floats into a buffer of unsigned bytes
+     *
+     * The floats are assumed to be in the range [-1,1]. Values outside of
+     * this range are clamped, with -1 converting to the minimum byte and
+     * 1 converting to the maximum.
+     *
+     * @param input     The input buffer
+     * @param output    The output buffer
+     * @param size      The number of elements to convert
+     *
+     * @return the number of elements successfully converted
+     */
+    static size_t float_to_u8(const float* input, Uint8* output, size_t size);
+
+    /**
+     * Converts a buffer of floats into a buffer of signed shorts
+     *
+     * The floats are assumed to be in the range [-1,1]. Values outside of
+     * this range are clamped, with -1 converting to the minimum short and
+     * 1 converting to the maximum. If swap is true, the endianness of each
+     * short is reversed before it is stored.
+     *
+     * @param input     The input buffer
+     * @param output    The output buffer
+     * @param size      The number of elements to convert
+     * @param swap      Whether to swap the endianness of the output
+     *
+     * @return the number of elements successfully converted
+     */
+    static size_t float_to_s16(const float* input, Sint16* output, size_t size, bool swap=false);
+
+    /**
+     * Converts a buffer of floats into a buffer of unsigned shorts
+     *
+     * The floats are assumed to be in the range [-1,1]. Values outside of
+     * this range are clamped, with -1 converting to the minimum short and
+     * 1 converting to the maximum. If swap is true, the endianness of each
+     * short is reversed before it is stored.
+     *
+     * @param input     The input buffer
+     * @param output    The output buffer
+     * @param size      The number of elements to convert
+     * @param swap      Whether to swap the endianness of the output
+     *
+     * @return the number of elements successfully converted
+     */
+    static size_t float_to_u16(const float* input, Uint16* output, size_t size, bool swap=false);
+
+    /**
+     * Converts a buffer of floats into a buffer of signed ints
+     *
+     * The floats are assumed to be in the range [-1,1]. Values outside of
+     * this range are clamped, with -1 converting to the minimum int and
+     * 1 converting to the maximum. Values inside this range have 24 bits
+     * of precision (the precision of a float). If swap is true, the
+     * endianness of each int is reversed before it is stored.
+     *
+     * @param input     The input buffer
+     * @param output    The output buffer
+     * @param size      The number of elements to convert
+     * @param swap      Whether to swap the endianness of the output
+     *
+     * @return the number of elements successfully converted
+     */
+    static size_t float_to_s32(const float* input, Sint32* output, size_t size, bool swap=false);
+
+    /**
+     * Reverses the endianness of a buffer of floats
+     *
+     * It is safe for output to be the same as the input buffer.
+     *
+     * @param input     The input buffer
+     * @param output    The output buffer
+     * @param size      The number of elements to swap
+     *
+     * @return the number of elements successfully swapped
+     */
+    static size_t swap_float(const float* input, float* output, size_t size);
+
+#pragma mark Interleave Methods
+    /**
+     * Interleaves several planar channels into a single buffer
+     *
+     * The array input should have one buffer for each channel, in the order
+     * that they should appear in the output. Each of those buffers must
+     * have (at least) frames many elements. The output buffer must be able
+     * to hold channels * frames many elements.
+     *
+     * @param input     The planar channel buffers
+     * @param output    The interleaved output buffer
+     * @param channels  The number of channels
+     * @param frames    The number of frames to interleave
+     *
+     * @return the number of frames successfully interleaved
+     */
+    static size_t interleave(const float* const* input, float* output, size_t channels, size_t frames);
+
+    /**
+     * Deinterleaves a single buffer into several planar channels
+     *
+     * The array output should have one buffer for each channel of the input.
+     * Each of those buffers must be able to hold (at least) frames many
+     * elements. The input buffer must have channels * frames many elements.
+     *
+     * @param input     The interleaved input buffer
+     * @param output    The planar channel buffers
+     * @param channels  The number of channels
+     * @param frames    The number of frames to deinterleave
+     *
+     * @return the number of frames successfully deinterleaved
+     */
+    static size_t deinterleave(const float* input, float* const* output, size_t channels, size_t frames);
+
+#pragma mark Matrix Mixing
+    /**
+     * Mixes the channels of input into output with the given matrix
+     *
+     * The matrix should be an MxN matrix in row major order, where N is the
+     * number of input channels (conduits) and M is the number of output
+     * channels. Each output frame is the product of this matrix with the
+     * corresponding input frame. The input buffer must have conduits * frames
+     * many elements, and the output buffer must be able to hold channels *
+     * frames many elements. The buffers should not overlap.
+     *
+     * The common layouts (mono, stereo, 5.1 and 7.1 to stereo, as well as
+     * stereo to 5.1) have specialized kernels. All other layouts use a
+     * general purpose loop.
+     *
+     * @param input     The interleaved input buffer
+     * @param output    The interleaved output buffer
+     * @param matrix    The mixing matrix
+     * @param conduits  The number of input channels
+     * @param channels  The number of output channels
+     * @param frames    The number of frames to mix
+     *
+     * @return the number of frames successfully mixed
+     */
+    static size_t mix_matrix(const float* input, float* output, const float* matrix,
+                             size_t conduits, size_t channels, size_t frames);
+
+#pragma mark Wavetable Methods
+    /**
+     * Fills output with interpolated samples from a periodic table
+     *
+     * The table should have 2^bits + 1 elements, where the last element is a
+     * copy of the first (so that interpolation can wrap around). The phase
+     * is a 32 bit fixed point value, where 2^32 represents a full period of
+     * the table. Each sample advances the phase by step (wrapping around on
+     * overflow), and is linearly interpolated between adjacent table entries.
+     *
+     * The value bits must be between 1 and 31.
+     *
+     * @param table     The periodic table
+     * @param bits      The number of bits in a table index
+     * @param phase     The initial phase as a fixed point value
+     * @param step      The phase increment per sample
+     * @param output    The output buffer
+     * @param size      The number of samples to generate
+     *
+     * @return the number of samples successfully generated
+     */
+    static size_t wavetable(const float* table, Uint32 bits, Uint32 phase, Uint32 step,
+                            float* output, size_t size);
+
     // TODO: Add convolution
 
 };
@@ -518,6 +518,24 @@ public:
      * @return a reference to the buffer for chaining.
      */
     cugl::Mesh<SpriteVertex2>* getMesh(cugl::Mesh<SpriteVertex2>* mesh, Color4 color) const;
+
+    /**
+     * Returns a mesh representing the path extrusion, reusing the given buffer
+     *
+     * The buffer is cleared before the extrusion is added, but its vertex and
+     * index storage keeps its capacity. The buffer is then moved into the
+     * result, so a mesh taken from a {@link MeshPool} can be filled without any
+     * allocation. It is unsafe to use the original buffer after this call.
+     *
+     * If the calculation is not yet performed, this method will return the
+     * empty mesh.
+     *
+     * @param buffer    The buffer to reuse
+     * @param color     The default mesh color
+     *
+     * @return a mesh representing the path extrusion.
+     */
+    cugl::Mesh<SpriteVertex2> getMesh(cugl::Mesh<SpriteVertex2>&& buffer, Color4 color) const;
     
     /**
      * Returns a mesh representing the path extrusion.
@@ -558,6 +576,25 @@ public:
      */
     cugl::Mesh<SpriteVertex2>* getMesh(cugl::Mesh<SpriteVertex2>* mesh, Color4 inner, Color4 outer) const;
 
+    /**
+     * Returns a mesh representing the path extrusion, reusing the given buffer
+     *
+     * The buffer is cleared before the extrusion is added, but its vertex and
+     * index storage keeps its capacity. The buffer is then moved into the
+     * result, so a mesh taken from a {@link MeshPool} can be filled without any
+     * allocation. It is unsafe to use the original buffer after this call.
+     *
+     * If the calculation is not yet performed, this method will return the
+     * empty mesh.
+     *
+     * @param buffer    The buffer to reuse
+     * @param inner     The interior mesh color
+     * @param outer     The exterior mesh color
+     *
+     * @return a mesh representing the path extrusion.
+     */
+    cugl::Mesh<SpriteVertex2> getMesh(cugl::Mesh<SpriteVertex2>&& buffer, Color4 inner, Color4 outer) const;
+
     
     /**
      * Returns the side information for the vertex at the given index
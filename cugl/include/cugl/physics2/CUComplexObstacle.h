@@ -102,6 +102,12 @@ namespace cugl {
             std::vector<b2Joint*>  _realjoints;
             /** Potential joints for connecting the multiple bodies */
             std::vector<b2Joint*>  _drawjoints;
+            /** The real bodies of the components, packed for syncing */
+            std::vector<b2Body*>   _realchildren;
+            /** The draw bodies of the components, parallel to _realchildren */
+            std::vector<b2Body*>   _drawchildren;
+            /** The components that must be synced individually (nested complex obstacles) */
+            std::vector<Obstacle*> _nested;
 
 #pragma mark -
 #pragma mark Scene Graph Internals
@@ -1092,7 +1098,7 @@ namespace cugl {
             *
             * @return a (weak) reference to Box2D body for this obstacle.
             */
-            virtual b2Body* getDrawBody() override { return _realbody; }
+            virtual b2Body* getDrawBody() override { return _drawbody; }
 
             /*
             * Returns the necessary BodyData class in order to update this body in another game instance
@@ -1109,6 +1115,28 @@ namespace cugl {
             */
             virtual void syncBodies() override;
 
+            /**
+             * Copies the pose of the real bodies to the draw bodies, if they changed.
+             *
+             * This method syncs the root body and every component body. The
+             * component bodies are packed into parallel arrays when physics is
+             * activated, so they are synced in a single loop with no virtual
+             * calls. Components that do not have a body of their own (such as
+             * nested complex obstacles) are synced individually.
+             *
+             * @return true if any draw body pose was changed
+             */
+            virtual bool syncPose() override;
+
+            /**
+             * Returns the number of component bodies packed for syncing.
+             *
+             * This value is 0 if physics is not active.
+             *
+             * @return the number of component bodies packed for syncing.
+             */
+            size_t getChildBodyCount() const { return _realchildren.size(); }
+
             /**
              * Returns the collection of component physics objects.
              *
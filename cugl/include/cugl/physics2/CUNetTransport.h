@@ -0,0 +1,521 @@
+//
+//  CUNetTransport.h
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides the transport interface for networked physics. A
+//  transport is an unreliable, unordered datagram channel between peers, which
+//  is all that a physics session needs (lost state is replaced by newer state).
+//  This module also provides an in-process loopback network with configurable
+//  latency and packet loss, for testing and benchmarking sessions without a
+//  real network. See CUUDPTransport.h for the socket implementation.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#ifndef __CU_NET_TRANSPORT_H__
+#define __CU_NET_TRANSPORT_H__
+#include <SDL/SDL.h>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <random>
+
+/** The largest payload (in bytes) that a transport should send in one packet */
+#define NET_MAX_PACKET  1200
+/** The peer address of an invalid (or unknown) peer */
+#define NET_NO_PEER     0xFFFFFFFF
+
+namespace cugl {
+    namespace physics2 {
+
+#pragma mark -
+#pragma mark Transport Interface
+/**
+ * This class is the abstract interface of a datagram transport.
+ *
+ * A transport sends and receives packets between peers. Peers are identified
+ * by an integer address local to the transport. Delivery is unreliable and
+ * unordered: packets may be lost, duplicated or reordered. This is the usual
+ * contract of UDP, and it is sufficient for state replication, as any lost
+ * state is soon replaced by newer state.
+ *
+ * All methods are non-blocking. In particular, {@link #receive} returns false
+ * immediately if no packet is available. A transport also counts the packets
+ * and payload bytes that pass through it, so that sessions can be profiled.
+ * The counts do not include any protocol headers below the transport.
+ */
+class NetTransport {
+protected:
+    /** The number of packets sent */
+    Uint64 _packetsSent;
+    /** The number of payload bytes sent */
+    Uint64 _bytesSent;
+    /** The number of packets received */
+    Uint64 _packetsReceived;
+    /** The number of payload bytes received */
+    Uint64 _bytesReceived;
+
+public:
+#pragma mark Constructors
+    /**
+     * Creates a transport with zero statistics.
+     */
+    NetTransport() : _packetsSent(0), _bytesSent(0), _packetsReceived(0), _bytesReceived(0) {}
+
+    /**
+     * Deletes this transport, disposing all resources
+     */
+    virtual ~NetTransport() {}
+
+    /**
+     * Closes this transport, releasing all resources.
+     *
+     * Once closed, a transport can neither send nor receive packets.
+     */
+    virtual void close() = 0;
+
+#pragma mark Communication
+    /**
+     * Returns true if this transport is open.
+     *
+     * @return true if this transport is open.
+     */
+    virtual bool isOpen() const = 0;
+
+    /**
+     * Returns the address of this transport.
+     *
+     * This is the address that other peers on the same network use to send
+     * packets to this transport. It may be NET_NO_PEER if the address is not
+     * meaningful to other peers (as is the case for sockets).
+     *
+     * @return the address of this transport.
+     */
+    virtual Uint32 getAddress() const = 0;
+
+    /**
+     * Sends a packet to the given peer.
+     *
+     * This method returns true if the packet was handed off to the network.
+     * That is no guarantee that the packet will arrive.
+     *
+     * @param peer  The address of the destination peer
+     * @param data  The packet payload
+     * @param size  The number of bytes in the payload
+     *
+     * @return true if the packet was sent.
+     */
+    virtual bool send(Uint32 peer, const Uint8* data, size_t size) = 0;
+
+    /**
+     * Receives the next available packet, if any.
+     *
+     * The payload is stored in data, which is resized to fit. This method
+     * returns false immediately if there is no packet available.
+     *
+     * @param peer  The address of the source peer
+     * @param data  The buffer to store the payload
+     *
+     * @return true if a packet was received.
+     */
+    virtual bool receive(Uint32& peer, std::vector<Uint8>& data) = 0;
+
+    /**
+     * Forgets the given peer.
+     *
+     * A transport that learns its peers from the packets it receives should
+     * forget them once they are no longer needed, as otherwise any sender
+     * adds to its memory. The address may be reused for a later peer. By
+     * default this method does nothing.
+     *
+     * @param peer  The address of the peer to forget
+     */
+    virtual void removePeer(Uint32) {}
+
+#pragma mark Statistics
+    /**
+     * Returns the number of packets sent since the last reset.
+     *
+     * @return the number of packets sent since the last reset.
+     */
+    Uint64 getPacketsSent() const { return _packetsSent; }
+
+    /**
+     * Returns the number of payload bytes sent since the last reset.
+     *
+     * @return the number of payload bytes sent since the last reset.
+     */
+    Uint64 getBytesSent() const { return _bytesSent; }
+
+    /**
+     * Returns the number of packets received since the last reset.
+     *
+     * @return the number of packets received since the last reset.
+     */
+    Uint64 getPacketsReceived() const { return _packetsReceived; }
+
+    /**
+     * Returns the number of payload bytes received since the last reset.
+     *
+     * @return the number of payload bytes received since the last reset.
+     */
+    Uint64 getBytesReceived() const { return _bytesReceived; }
+
+    /**
+     * Resets all of the transport statistics to zero.
+     */
+    void resetStats() {
+        _packetsSent = 0;
+        _bytesSent = 0;
+        _packetsReceived = 0;
+        _bytesReceived = 0;
+    }
+};
+
+#pragma mark -
+#pragma mark Loopback Network
+/**
+ * This class is an in-process network connecting loopback transports.
+ *
+ * Packets sent on this network are queued for delivery after a fixed latency,
+ * and are dropped at random with the given loss rate. The network has its own
+ * clock, which only advances with {@link #update}. This makes sessions on the
+ * network deterministic (given a random seed), which is what we want for tests
+ * and benchmarks. As the latency is constant, packets between two endpoints
+ * are never reordered.
+ *
+ * Endpoints are created with {@link LoopbackTransport#alloc}. This class is
+ * thread safe, so the endpoints may be used from different threads.
+ */
+class LoopbackNetwork {
+private:
+    /** A packet in flight */
+    class Packet {
+    public:
+        /** The network time at which the packet is delivered */
+        double time;
+        /** The address of the sender */
+        Uint32 source;
+        /** The packet payload */
+        std::vector<Uint8> data;
+    };
+
+    /** The packets in flight for each endpoint */
+    std::vector<std::deque<Packet>> _inboxes;
+    /** Whether each endpoint is open */
+    std::vector<bool> _open;
+    /** The recycled payload buffers */
+    std::vector<std::vector<Uint8>> _buffers;
+    /** The current network time in seconds */
+    double _time;
+    /** The one-way latency in seconds */
+    float _latency;
+    /** The probability that a packet is dropped */
+    float _loss;
+    /** The number of packets dropped */
+    Uint64 _dropped;
+    /** The random generator for packet loss */
+    std::minstd_rand _random;
+    /** The mutex protecting the inboxes */
+    mutable std::mutex _mutex;
+
+public:
+#pragma mark Constructors
+    /**
+     * Creates a degenerate loopback network.
+     *
+     * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an object on
+     * the heap, use one of the static constructors instead.
+     */
+    LoopbackNetwork() : _time(0), _latency(0), _loss(0), _dropped(0) {}
+
+    /**
+     * Deletes this network, disposing all resources
+     */
+    ~LoopbackNetwork() { dispose(); }
+
+    /**
+     * Disposes all of the resources used by this network.
+     *
+     * All packets in flight are discarded, and all endpoints are closed.
+     */
+    void dispose();
+
+    /**
+     * Initializes a loopback network with the given latency and loss.
+     *
+     * The latency is the one-way delay of each packet. The loss is the
+     * probability (0 to 1) that a packet is dropped. The seed makes the
+     * packet loss reproducible.
+     *
+     * @param latency   The one-way latency in seconds
+     * @param loss      The probability that a packet is dropped
+     * @param seed      The random seed for packet loss
+     *
+     * @return true if initialization was successful.
+     */
+    bool init(float latency=0, float loss=0, Uint32 seed=0);
+
+    /**
+     * Returns a newly allocated loopback network with the given latency and loss.
+     *
+     * The latency is the one-way delay of each packet. The loss is the
+     * probability (0 to 1) that a packet is dropped. The seed makes the
+     * packet loss reproducible.
+     *
+     * @param latency   The one-way latency in seconds
+     * @param loss      The probability that a packet is dropped
+     * @param seed      The random seed for packet loss
+     *
+     * @return a newly allocated loopback network with the given latency and loss.
+     */
+    static std::shared_ptr<LoopbackNetwork> alloc(float latency=0, float loss=0, Uint32 seed=0) {
+        std::shared_ptr<LoopbackNetwork> result = std::make_shared<LoopbackNetwork>();
+        return (result->init(latency,loss,seed) ? result : nullptr);
+    }
+
+#pragma mark Attributes
+    /**
+     * Returns the one-way latency in seconds.
+     *
+     * @return the one-way latency in seconds.
+     */
+    float getLatency() const { return _latency; }
+
+    /**
+     * Sets the one-way latency in seconds.
+     *
+     * The change only applies to packets sent after this call.
+     *
+     * @param latency   The one-way latency in seconds.
+     */
+    void setLatency(float latency) { _latency = latency; }
+
+    /**
+     * Returns the probability that a packet is dropped.
+     *
+     * @return the probability that a packet is dropped.
+     */
+    float getLoss() const { return _loss; }
+
+    /**
+     * Sets the probability that a packet is dropped.
+     *
+     * @param loss  The probability that a packet is dropped.
+     */
+    void setLoss(float loss) { _loss = loss; }
+
+    /**
+     * Returns the current network time in seconds.
+     *
+     * @return the current network time in seconds.
+     */
+    double getTime() const { return _time; }
+
+    /**
+     * Returns the number of packets dropped by this network.
+     *
+     * @return the number of packets dropped by this network.
+     */
+    Uint64 getDropped() const { return _dropped; }
+
+    /**
+     * Advances the network clock by the given amount.
+     *
+     * Packets are only delivered once the clock passes their delivery time.
+     *
+     * @param dt    The elapsed time in seconds
+     */
+    void update(float dt);
+
+#pragma mark Endpoints
+    /**
+     * Returns the address of a newly opened endpoint.
+     *
+     * @return the address of a newly opened endpoint.
+     */
+    Uint32 open();
+
+    /**
+     * Closes the endpoint with the given address.
+     *
+     * Any packets in flight to the endpoint are discarded.
+     *
+     * @param address   The endpoint address
+     */
+    void close(Uint32 address);
+
+    /**
+     * Posts a packet from one endpoint to another.
+     *
+     * This method returns false if either endpoint is closed. A packet lost to
+     * the loss rate still counts as posted.
+     *
+     * @param source    The address of the sender
+     * @param dest      The address of the receiver
+     * @param data      The packet payload
+     * @param size      The number of bytes in the payload
+     *
+     * @return true if the packet was posted.
+     */
+    bool post(Uint32 source, Uint32 dest, const Uint8* data, size_t size);
+
+    /**
+     * Polls the next delivered packet for the given endpoint.
+     *
+     * This method returns false if no packet has reached the endpoint yet.
+     *
+     * @param dest      The address of the receiver
+     * @param source    The address of the sender
+     * @param data      The buffer to store the payload
+     *
+     * @return true if a packet was delivered.
+     */
+    bool poll(Uint32 dest, Uint32& source, std::vector<Uint8>& data);
+};
+
+#pragma mark -
+#pragma mark Loopback Transport
+/**
+ * This class is an endpoint on a {@link LoopbackNetwork}.
+ *
+ * The address of a loopback transport is its endpoint address on the network.
+ * Packets may be sent to any other endpoint on the same network.
+ */
+class LoopbackTransport : public NetTransport {
+protected:
+    /** The network of this endpoint */
+    std::shared_ptr<LoopbackNetwork> _network;
+    /** The address of this endpoint */
+    Uint32 _address;
+
+public:
+#pragma mark Constructors
+    /**
+     * Creates a degenerate loopback transport.
+     *
+     * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an object on
+     * the heap, use one of the static constructors instead.
+     */
+    LoopbackTransport() : NetTransport(), _address(NET_NO_PEER) {}
+
+    /**
+     * Deletes this transport, disposing all resources
+     */
+    ~LoopbackTransport() { close(); }
+
+    /**
+     * Closes this transport, releasing all resources.
+     *
+     * Once closed, a transport can neither send nor receive packets.
+     */
+    virtual void close() override;
+
+    /**
+     * Initializes a transport as a new endpoint on the given network.
+     *
+     * @param network   The loopback network
+     *
+     * @return true if initialization was successful.
+     */
+    bool init(const std::shared_ptr<LoopbackNetwork>& network);
+
+    /**
+     * Returns a newly allocated transport as a new endpoint on the given network.
+     *
+     * @param network   The loopback network
+     *
+     * @return a newly allocated transport as a new endpoint on the given network.
+     */
+    static std::shared_ptr<LoopbackTransport> alloc(const std::shared_ptr<LoopbackNetwork>& network) {
+        std::shared_ptr<LoopbackTransport> result = std::make_shared<LoopbackTransport>();
+        return (result->init(network) ? result : nullptr);
+    }
+
+#pragma mark Communication
+    /**
+     * Returns true if this transport is open.
+     *
+     * @return true if this transport is open.
+     */
+    virtual bool isOpen() const override { return _network != nullptr; }
+
+    /**
+     * Returns the address of this transport.
+     *
+     * This is the endpoint address on the loopback network.
+     *
+     * @return the address of this transport.
+     */
+    virtual Uint32 getAddress() const override { return _address; }
+
+    /**
+     * Returns the network of this endpoint.
+     *
+     * @return the network of this endpoint.
+     */
+    const std::shared_ptr<LoopbackNetwork>& getNetwork() const { return _network; }
+
+    /**
+     * Sends a packet to the given peer.
+     *
+     * This method returns true if the packet was handed off to the network.
+     * That is no guarantee that the packet will arrive.
+     *
+     * @param peer  The address of the destination peer
+     * @param data  The packet payload
+     * @param size  The number of bytes in the payload
+     *
+     * @return true if the packet was sent.
+     */
+    virtual bool send(Uint32 peer, const Uint8* data, size_t size) override;
+
+    /**
+     * Receives the next available packet, if any.
+     *
+     * The payload is stored in data, which is resized to fit. This method
+     * returns false immediately if there is no packet available.
+     *
+     * @param peer  The address of the source peer
+     * @param data  The buffer to store the payload
+     *
+     * @return true if a packet was received.
+     */
+    virtual bool receive(Uint32& peer, std::vector<Uint8>& data) override;
+};
+
+    }
+}
+
+#endif /* __CU_NET_TRANSPORT_H__ */
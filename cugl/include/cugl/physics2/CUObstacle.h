@@ -881,6 +881,36 @@ namespace cugl {
             */
             virtual void syncBodies() {}
 
+            /**
+             * Copies the pose of the real body to the draw body, if it changed.
+             *
+             * This is a cheaper version of {@link #syncBodies} used by the
+             * obstacle world every frame. Unlike that method, it only calls the
+             * Box2D setters for flags that have changed, and it skips the pose
+             * entirely if the bodies are already in the same place (which is
+             * always the case for static and sleeping bodies). The pose and
+             * velocities are written with b2Body::SetPose, which defers the
+             * broad-phase update. Hence you must call b2World::SynchronizePoses
+             * on the draw world before it is stepped.
+             *
+             * @return true if the draw body pose was changed
+             */
+            virtual bool syncPose();
+
+            /**
+             * Copies the pose of the given real body to the draw body, if it changed.
+             *
+             * This is the body of {@link #syncPose()}, factored out so that composite
+             * objects can sync their component bodies in a single loop, without a
+             * virtual call per component.  Neither body may be nullptr.
+             *
+             * @param real  The body in the real world
+             * @param draw  The matching body in the draw world
+             *
+             * @return true if the draw body pose was changed
+             */
+            static bool syncPose(b2Body* real, b2Body* draw);
+
             /**
              * Creates the physics Body(s) for this object, adding them to the world.
              *
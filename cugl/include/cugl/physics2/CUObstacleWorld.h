@@ -86,6 +86,74 @@ class Obstacle;
  * functions while the program is running.
  */
 class ObstacleWorld : public b2ContactListener, b2DestructionListener, b2ContactFilter {
+public:
+    /**
+     * This class is the physics profile of a single update.
+     *
+     * The timings are the Box2D profile (in milliseconds) summed over all of
+     * the ministeps of the update, including the final step of the draw world.
+     * The islands and TOI events are summed in the same way. The population
+     * counts (bodies, awake bodies, contacts and proxies) are those of the
+     * real world at the end of the update.
+     *
+     * Profiles may be added together, which is how {@link PhysicsProfiler}
+     * computes averages over many frames.
+     */
+    class Profile {
+    public:
+        /** The total time to step the worlds */
+        float step;
+        /** The time to update the contacts (narrow phase) */
+        float collide;
+        /** The time to solve the islands */
+        float solve;
+        /** The time to initialize the island constraints */
+        float solveInit;
+        /** The time to solve the velocity constraints */
+        float solveVelocity;
+        /** The time to solve the position constraints */
+        float solvePosition;
+        /** The time to update the broad phase */
+        float broadphase;
+        /** The time to solve the time of impact events */
+        float solveTOI;
+        /** The time to sync the draw world to the real world */
+        float sync;
+        /** The number of ministeps of the real world */
+        Uint32 ministeps;
+        /** The number of bodies in the real world */
+        Uint32 bodies;
+        /** The number of awake, non-static bodies in the real world */
+        Uint32 awake;
+        /** The number of islands solved */
+        Uint32 islands;
+        /** The number of contacts in the real world */
+        Uint32 contacts;
+        /** The number of broad phase proxies in the real world */
+        Uint32 proxies;
+        /** The number of time of impact events solved */
+        Uint32 tois;
+        
+        /**
+         * Creates a zero profile
+         */
+        Profile() { reset(); }
+        
+        /**
+         * Resets all values of this profile to zero.
+         */
+        void reset();
+        
+        /**
+         * Adds the given profile to this one, field by field.
+         *
+         * @param other The profile to add
+         *
+         * @return this profile after modification
+         */
+        Profile& operator+=(const Profile& other);
+    };
+
 protected:
     /** Reference to the Box2D world */
     b2World* _real_world;
@@ -108,10 +176,21 @@ protected:
     
     /** The list of objects in this world */
     std::vector<std::shared_ptr<Obstacle>> _objects;
+    /** The objects to add at the start of the next update */
+    std::vector<std::shared_ptr<Obstacle>> _pending;
+    /** Whether to garbage collect at the start of the next update */
+    bool _collect;
     
     /** The boundary of the world */
     Rect _bounds;
     
+    /** The time (in microseconds) to sync the draw world in the last update */
+    Uint64 _syncTime;
+    /** The number of draw bodies moved in the last update */
+    size_t _syncCount;
+    /** The physics profile of the last update */
+    Profile _profile;
+    
     /** Whether or not to activate the collision listener */
     bool _collide;
     /** Whether or not to activate the filter listener */
@@ -119,7 +198,6 @@ protected:
     /** Whether or not to activate the destruction listener */
     bool _destroy;
     
-    
 #pragma mark -
 #pragma mark Constructors
 public:
@@ -258,7 +336,8 @@ public:
     /** 
      * Returns the amount of time for a single engine step.
      *
-     * This attribute is only relevant if isLockStep() is true.
+     * This attribute is only relevant if isLockStep() is true. It is also the
+     * longest engine step taken by {@link #step}.
      *
      * @return the amount of time for a single engine step.
      */
@@ -267,8 +346,9 @@ public:
     /**
      * Sets the amount of time for a single engine step.
      *
-     * This attribute is only relevant if isLockStep() is true. Any change will take 
-     * effect at the time of the next call to update.
+     * This attribute is only relevant if isLockStep() is true. It is also the
+     * longest engine step taken by {@link #step}. Any change will take effect
+     * at the time of the next call to update.
      *
      * @param  step the amount of time for a single engine step.
      */
@@ -337,6 +417,65 @@ public:
      * @param dt Number of seconds since last animation frame
      */
     void update(float dt);
+
+    /**
+     * Advances the real world by a single fixed tick.
+     *
+     * Unlike {@link #update}, this method carries no time from one call to the
+     * next. The tick is divided into equal engine steps no longer than the step
+     * size (see {@link #getStepsize}), so a tick of the same length is always
+     * simulated the same way. This is what allows a tick to be replayed, as in
+     * network prediction.
+     *
+     * Only the real world is stepped. The obstacles are not updated, and the draw
+     * world is left as it is. Call {@link #syncDraw} once the ticks for this
+     * frame are done.
+     *
+     * @param dt    The length of the tick in seconds
+     */
+    void step(float dt);
+
+    /**
+     * Synchronizes the draw world with the real world.
+     *
+     * This copies every real body to its draw body, and then updates the
+     * obstacles (and hence the scene graph). It is the companion of {@link #step}.
+     * The draw world is not stepped, so the draw bodies are exactly the real
+     * bodies afterwards.
+     *
+     * @param dt    The time since the last synchronization in seconds
+     */
+    void syncDraw(float dt);
+    
+    /**
+     * Returns the time (in microseconds) to sync the draw world in the last update.
+     *
+     * This is the time to copy the real bodies to the draw bodies, including the
+     * broad-phase update of the draw world. It does not include the draw world step.
+     *
+     * @return the time (in microseconds) to sync the draw world in the last update.
+     */
+    Uint64 getSyncTime() const { return _syncTime; }
+    
+    /**
+     * Returns the number of draw bodies moved in the last update.
+     *
+     * Static and sleeping bodies do not move, and so are not counted.
+     *
+     * @return the number of draw bodies moved in the last update.
+     */
+    size_t getSyncCount() const { return _syncCount; }
+    
+    /**
+     * Returns the physics profile of the last update.
+     *
+     * The profile aggregates the Box2D profile over all ministeps of the
+     * update and both the real and the draw world. See {@link Profile} for
+     * the meaning of each value.
+     *
+     * @return the physics profile of the last update.
+     */
+    const Profile& getProfile() const { return _profile; }
     
     /**
      * Returns the bounds for the world controller.
@@ -345,6 +484,17 @@ public:
      */
     const Rect getBounds() const { return _bounds; }
     
+    /**
+     * Sets the bounds for the world controller.
+     *
+     * The bounds are only used to check new obstacles (see {@link #inBounds}).
+     * Worlds that grow over time, such as a streamed level, should set the
+     * bounds to the area currently loaded.
+     *
+     * @param bounds    The bounds for the world controller.
+     */
+    void setBounds(const Rect bounds) { _bounds = bounds; }
+    
     /**
      * Returns true if the object is in bounds.
      *
@@ -398,6 +548,59 @@ public:
      */
     void removeObstacle(Obstacle* obj);
     
+    /**
+     * Adds a batch of obstacles to the physics world
+     *
+     * This method is the batch version of {@link #addObstacle}, and should be
+     * used when adding many obstacles at once (e.g. when a level chunk is
+     * loaded). If defer is true, the obstacles are not activated until the
+     * start of the next call to {@link #update}. This guarantees that the
+     * obstacles are added at a step boundary, and allows this method to be
+     * called from inside of a collision callback.
+     *
+     * The obstacles will be retained by this world, preventing them from being
+     * garbage collected.
+     *
+     * @param objs  The obstacles to add
+     * @param defer Whether to wait until the next update to add the obstacles
+     */
+    void addObstacles(const std::vector<std::shared_ptr<Obstacle>>& objs, bool defer=false);
+    
+    /**
+     * Removes a batch of obstacles from the physics world
+     *
+     * This method marks the obstacles for removal and garbage collects them
+     * in a single pass over the world. If defer is true, the collection does
+     * not happen until the start of the next call to {@link #update}. This
+     * guarantees that the obstacles are removed at a step boundary, and allows
+     * this method to be called from inside of a collision callback.
+     *
+     * Obstacles queued by {@link #addObstacles} that have not been added yet
+     * are simply dropped.
+     *
+     * @param objs  The obstacles to remove
+     * @param defer Whether to wait until the next update to remove the obstacles
+     */
+    void removeObstacles(const std::vector<std::shared_ptr<Obstacle>>& objs, bool defer=false);
+    
+    /**
+     * Returns the number of obstacles waiting to be added at the next update.
+     *
+     * @return the number of obstacles waiting to be added at the next update.
+     */
+    size_t getPendingCount() const { return _pending.size(); }
+    
+    /**
+     * Applies any deferred additions and removals.
+     *
+     * Removals are applied first, so an obstacle that is queued for addition
+     * and then marked for removal is never activated. This method is called
+     * at the start of every {@link #update} and {@link #step}, but it may be
+     * called earlier by code that needs the obstacle list to stay fixed over
+     * several steps.
+     */
+    void applyPending();
+    
     /**
      * Remove all objects marked for removal.
      *
@@ -0,0 +1,524 @@
+//
+//  CUPhysicsPredictor.h
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides a predicting client for a networked physics session.
+//  A plain PhysicsClient shows the world as the server last saw it, so local
+//  inputs take a round trip to have any effect. A predictor instead runs ahead
+//  of the server, applying its inputs at once. It keeps the inputs and the
+//  predicted state of recent ticks, so that when the server state for a tick
+//  arrives, it can rewind to that tick and replay its inputs to the present.
+//  The jump this causes is blended out through the draw bodies.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#ifndef __CU_PHYSICS_PREDICTOR_H__
+#define __CU_PHYSICS_PREDICTOR_H__
+#include <cugl/physics2/CUPhysicsSession.h>
+
+/** The default number of ticks that a predictor can rewind */
+#define DEFAULT_NET_WINDOW      8
+/** The default prediction error (in physics units or radians) that forces a replay */
+#define DEFAULT_NET_TOLERANCE   0.01f
+/** The default time (in seconds) that a predictor update may take */
+#define DEFAULT_NET_BUDGET      0.010f
+
+namespace cugl {
+    namespace physics2 {
+
+#pragma mark -
+#pragma mark Physics Predictor
+/**
+ * This class is a client of a networked physics session that predicts ahead.
+ *
+ * A predictor simulates its world at the fixed tick of the server, but ahead
+ * of it. It aims to be far enough ahead that its input for a tick reaches the
+ * server before the server simulates that tick. That lead is computed from the
+ * round trip time (see {@link #getRoundTrip}), and the predictor gains or
+ * loses a tick at a time to keep it.
+ *
+ * The input for a tick is an opaque array of bytes, set with {@link #setInput}.
+ * Before each tick, the input is passed to {@link #onInput}, which should
+ * apply it to the world. The same input is sent to the server, which passes
+ * it to {@link PhysicsServer#onInput} before simulating the same tick. The
+ * two functions should do the same thing.
+ *
+ * The predictor records the input and the state of every obstacle for the
+ * ticks in its window. When the server state for a tick arrives, it is
+ * compared with the prediction for that tick. If any body is off by more than
+ * the tolerance, it is rewound to that tick (with the server state), together
+ * with every body that touches it. All other bodies are frozen in place for
+ * the replay (see b2Body::SetFrozen), so Box2D treats them as static and does
+ * not simulate them. Those that touch a rewound body follow their recorded
+ * prediction, tick by tick, so that the rewound bodies collide with them where
+ * they were at the time. The recorded inputs are then replayed to the present in
+ * one batch, and the difference between the old and the new present is
+ * blended out over the smoothing time, exactly as for a {@link PhysicsClient}.
+ *
+ * The cost of a replay is proportional to the number of bodies rewound, times
+ * the number of ticks replayed. Each update has a time budget (see
+ * {@link #setBudget}), and the replay gets whatever the forward ticks leave of
+ * it. The mispredicted bodies are rewound worst first, for as long as they fit.
+ * The rest are deferred. Their state for the tick is still the server state,
+ * so they are mispredicted again by the next server state, and are replayed
+ * then. Nothing is replayed if not even the worst body fits, unless the server
+ * states of a whole window have been deferred in a row. Then the worst body is
+ * replayed anyway, and the bodies that do not fit take the server state as is,
+ * so that no body drifts from the server for longer than the window.
+ *
+ * A state older than the window cannot be replayed, and is applied as is.
+ * So is any state received when the world has gained or lost obstacles since
+ * that tick.
+ */
+class PhysicsPredictor : public PhysicsClient {
+protected:
+    /** The predicted state of a single obstacle */
+    class Snapshot {
+    public:
+        /** The obstacle id */
+        Uint32 id;
+        /** The body position */
+        b2Vec2 position;
+        /** The body angle */
+        float angle;
+        /** The linear velocity */
+        b2Vec2 linear;
+        /** The angular velocity */
+        float angular;
+        /** Whether the body is awake */
+        bool awake;
+        /** Whether the obstacle has a body */
+        bool valid;
+    };
+
+    /** A predicted tick */
+    class Frame {
+    public:
+        /** The tick (0 if this frame is unused) */
+        Uint32 tick;
+        /** The input applied before the tick */
+        std::vector<Uint8> input;
+        /** The state of each obstacle after the tick, by index in the world */
+        std::vector<Snapshot> bodies;
+    };
+
+    /** The predicted ticks, indexed by tick modulo the size */
+    std::vector<Frame> _history;
+    /** The number of ticks that can be rewound */
+    Uint32 _window;
+    /** The latest tick simulated */
+    Uint32 _present;
+    /** Whether the predictor has caught up with the server */
+    bool _predicting;
+    /** The time not yet simulated */
+    float _accum;
+    /** The prediction error that forces a replay */
+    float _tolerance;
+    /** The time (in seconds) that an update may take */
+    float _budget;
+    /** The average time (in microseconds) to simulate a tick */
+    double _tickCost;
+    /** The average work of a replay (see {@link #affect}) */
+    double _fitWork;
+    /** The average time (in microseconds) of a replay tick (0 if unknown) */
+    double _fitTime;
+    /** The variance of the work of a replay */
+    double _fitVar;
+    /** The covariance of the work and the time of a replay tick */
+    double _fitCov;
+    /** The number of server states in a row that were not replayed for lack of time */
+    Uint32 _starved;
+    /** The average time (in microseconds) of an update after the forward ticks */
+    double _tailCost;
+    /** The number of awake bodies after the last tick */
+    size_t _awake;
+    /** The input for the next tick */
+    std::vector<Uint8> _input;
+    /** The server states not yet reconciled */
+    std::vector<Record> _states;
+    /** The server tick of the states not yet reconciled */
+    Uint32 _stateTick;
+    /** The obstacles that were mispredicted by the server tick being reconciled */
+    std::vector<size_t> _diverged;
+    /** The prediction error of each obstacle (only valid for those mispredicted) */
+    std::vector<float> _misses;
+    /** The state of each obstacle before a replay */
+    std::vector<Snapshot> _saved;
+    /** Whether each obstacle is rewound by the current replay (empty if none) */
+    std::vector<bool> _affected;
+    /** The obstacles most recently added to the affected set by {@link #affect} */
+    std::vector<size_t> _frontier;
+    /** The frozen obstacles that touch an affected obstacle in a replay */
+    std::vector<size_t> _boundary;
+    /** The inputs to send to the server */
+    std::vector<const std::vector<Uint8>*> _submitted;
+    /** The number of ticks replayed in the last update */
+    Uint32 _replayed;
+    /** The number of bodies rewound in the last update */
+    size_t _restored;
+    /** The number of mispredicted bodies left for a later state in the last update */
+    size_t _deferred;
+    /** The time (in microseconds) to reconcile in the last update */
+    Uint64 _replayTime;
+
+    /**
+     * Stores a state packet from the server, to be reconciled.
+     *
+     * Only the latest tick is kept. Older states are discarded.
+     *
+     * @param data  The packet payload
+     * @param size  The number of bytes in the payload
+     */
+    virtual void apply(const Uint8* data, size_t size) override;
+
+    /**
+     * Reconciles the stored server states with the prediction.
+     *
+     * This replays the mispredicted bodies, worst first, for as many as fit
+     * in the given time. The rest are deferred to a later server state.
+     *
+     * @param spare The time (in microseconds) left for the replay
+     */
+    void reconcile(double spare);
+
+    /**
+     * Adds an obstacle, and every obstacle touching it, to the affected set.
+     *
+     * This follows touching contacts and joints, but never crosses a static
+     * body. The obstacles added are stored in {@link #_frontier}. The work is
+     * the number of obstacles added, plus their contacts and joints. The cost
+     * of a replay tick is proportional to the work.
+     *
+     * @param index The index of the obstacle in the world
+     *
+     * @return the work added to a replay tick
+     */
+    size_t affect(size_t index);
+
+    /**
+     * Adds the given body to the affected set, unless it is static or already there.
+     *
+     * The obstacle of the body is added to {@link #_frontier}.
+     *
+     * @param body  The body to add
+     */
+    void touch(b2Body* body);
+
+    /**
+     * Rewinds the affected obstacles to the given frame, and replays it to the present.
+     *
+     * The other obstacles are frozen for the replay, and are returned to their
+     * present state afterwards. Those that touch an affected obstacle follow
+     * their recorded prediction during the replay.
+     *
+     * If an obstacle is added or removed during the replay (such as by
+     * {@link #onInput}), the replay is abandoned (see {@link #abandon}).
+     *
+     * @param frame The frame to rewind to
+     *
+     * @return true if the replay reached the present
+     */
+    bool replay(const Frame& frame);
+
+    /**
+     * Abandons a replay after the obstacles of the world have changed.
+     *
+     * The indices of the replay no longer match the world, so the obstacles are
+     * found again by id. Every obstacle is released and returned to its state
+     * before the replay. The affected obstacles then take their state in the
+     * given frame, exactly as for a {@link PhysicsClient}.
+     *
+     * @param frame The frame of the replay
+     */
+    void abandon(const Frame& frame);
+
+    /**
+     * Moves an obstacle to a state of the given frame, exactly as a {@link PhysicsClient}.
+     *
+     * The snapshot is ignored if it is not for this obstacle. The difference
+     * is blended out over the smoothing time.
+     *
+     * @param index The index of the obstacle in the world
+     * @param snap  The state to take
+     */
+    void conform(size_t index, const Snapshot& snap);
+
+    /**
+     * Applies the input of the given frame, steps the world, and records the result.
+     *
+     * @param frame The frame to simulate
+     */
+    void simulate(Frame& frame);
+
+    /**
+     * Records the state of every obstacle in the given frame.
+     *
+     * During a replay, only the affected obstacles are recorded.
+     *
+     * @param frame The frame to record
+     */
+    void record(Frame& frame);
+
+    /**
+     * Sends the inputs in the window to the server.
+     *
+     * Inputs are sent redundantly, so that a lost packet does not lose one.
+     */
+    void send();
+
+    /**
+     * Returns the tick that this predictor should have simulated by now.
+     *
+     * This is the server tick at which an input sent now arrives, plus a
+     * small margin for jitter.
+     *
+     * @return the tick that this predictor should have simulated by now.
+     */
+    Uint32 target() const;
+
+public:
+    /**
+     * The function to apply a local input to the world.
+     *
+     * This function is called before the given tick is simulated, including
+     * when the tick is replayed.
+     */
+    std::function<void(Uint32 tick, const Uint8* data, size_t size)> onInput;
+
+#pragma mark Constructors
+    /**
+     * Creates a degenerate physics predictor.
+     *
+     * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an object on
+     * the heap, use one of the static constructors instead.
+     */
+    PhysicsPredictor();
+
+    /**
+     * Deletes this predictor, disposing all resources
+     */
+    ~PhysicsPredictor() { dispose(); }
+
+    /**
+     * Disposes all of the resources used by this predictor.
+     *
+     * If the predictor is connected, it tells the server that it is leaving.
+     * The world and transport are released, but not closed. A disposed
+     * predictor can be safely reinitialized.
+     */
+    virtual void dispose() override;
+
+    /**
+     * Initializes a predictor for the given world and server.
+     *
+     * The predictor takes over the stepping of the world. The game should
+     * call {@link #update} instead of {@link ObstacleWorld#update}. The
+     * predictor connects to the server on the first update.
+     *
+     * @param world     The client copy of the world
+     * @param transport The transport to the server
+     * @param server    The address of the server on the transport
+     * @param window    The number of ticks that can be rewound
+     *
+     * @return true if initialization was successful.
+     */
+    bool init(const std::shared_ptr<ObstacleWorld>& world,
+              const std::shared_ptr<NetTransport>& transport, Uint32 server,
+              Uint32 window=DEFAULT_NET_WINDOW);
+
+    /**
+     * Returns a newly allocated predictor for the given world and server.
+     *
+     * The predictor takes over the stepping of the world. The game should
+     * call {@link #update} instead of {@link ObstacleWorld#update}. The
+     * predictor connects to the server on the first update.
+     *
+     * @param world     The client copy of the world
+     * @param transport The transport to the server
+     * @param server    The address of the server on the transport
+     * @param window    The number of ticks that can be rewound
+     *
+     * @return a newly allocated predictor for the given world and server.
+     */
+    static std::shared_ptr<PhysicsPredictor> alloc(const std::shared_ptr<ObstacleWorld>& world,
+                                                   const std::shared_ptr<NetTransport>& transport,
+                                                   Uint32 server, Uint32 window=DEFAULT_NET_WINDOW) {
+        std::shared_ptr<PhysicsPredictor> result = std::make_shared<PhysicsPredictor>();
+        return (result->init(world,transport,server,window) ? result : nullptr);
+    }
+
+#pragma mark Attributes
+    /**
+     * Returns the number of ticks that can be rewound.
+     *
+     * @return the number of ticks that can be rewound.
+     */
+    Uint32 getWindow() const { return _window; }
+
+    /**
+     * Returns the latest tick simulated.
+     *
+     * Once the predictor is predicting, this is ahead of the server tick.
+     *
+     * @return the latest tick simulated.
+     */
+    Uint32 getPresentTick() const { return _present; }
+
+    /**
+     * Returns true if the predictor is running ahead of the server.
+     *
+     * A predictor starts to predict once it has measured the round trip
+     * time to the server. Until then, it behaves as a {@link PhysicsClient}.
+     *
+     * @return true if the predictor is running ahead of the server.
+     */
+    bool isPredicting() const { return _predicting; }
+
+    /**
+     * Returns the prediction error that forces a replay.
+     *
+     * A replay happens if the position (in physics units) or the angle (in
+     * radians) of any body is off by more than this amount.
+     *
+     * @return the prediction error that forces a replay.
+     */
+    float getTolerance() const { return _tolerance; }
+
+    /**
+     * Sets the prediction error that forces a replay.
+     *
+     * A replay happens if the position (in physics units) or the angle (in
+     * radians) of any body is off by more than this amount. If the tolerance
+     * is 0, any error forces a replay.
+     *
+     * @param tolerance The prediction error that forces a replay.
+     */
+    void setTolerance(float tolerance) { _tolerance = tolerance; }
+
+    /**
+     * Returns the time (in seconds) that an update may take.
+     *
+     * The replay gets what is left of this budget after the forward ticks
+     * of the update. Its cost is estimated from the measured cost of earlier
+     * replays, per body and tick. Mispredicted bodies that do not fit are
+     * deferred to a later server state (see the class description).
+     *
+     * @return the time (in seconds) that an update may take.
+     */
+    float getBudget() const { return _budget; }
+
+    /**
+     * Sets the time (in seconds) that an update may take.
+     *
+     * The replay gets what is left of this budget after the forward ticks
+     * of the update. Its cost is estimated from the measured cost of earlier
+     * replays, per body and tick. Mispredicted bodies that do not fit are
+     * deferred to a later server state (see the class description). A
+     * negative budget replays every mispredicted body.
+     *
+     * @param budget    The time (in seconds) that an update may take.
+     */
+    void setBudget(float budget) { _budget = budget; }
+
+    /**
+     * Returns the input for the next tick.
+     *
+     * @return the input for the next tick.
+     */
+    const std::vector<Uint8>& getInput() const { return _input; }
+
+    /**
+     * Sets the input for the next tick.
+     *
+     * The input is used for every tick until it is changed. An input may be
+     * no more than 255 bytes. Any more are not sent to the server.
+     *
+     * @param data  The input bytes
+     * @param size  The number of input bytes
+     */
+    void setInput(const Uint8* data, size_t size) { _input.assign(data,data+size); }
+
+#pragma mark Statistics
+    /**
+     * Returns the number of ticks replayed in the last update.
+     *
+     * @return the number of ticks replayed in the last update.
+     */
+    Uint32 getReplayTicks() const { return _replayed; }
+
+    /**
+     * Returns the number of bodies rewound in the last update.
+     *
+     * @return the number of bodies rewound in the last update.
+     */
+    size_t getRestored() const { return _restored; }
+
+    /**
+     * Returns the number of mispredicted bodies left for a later state in the last update.
+     *
+     * This is nonzero only when the replay of every mispredicted body did not
+     * fit in the budget.
+     *
+     * @return the number of mispredicted bodies left for a later state in the last update.
+     */
+    size_t getDeferred() const { return _deferred; }
+
+    /**
+     * Returns the time (in microseconds) to reconcile in the last update.
+     *
+     * This includes the rewind and the replay, but not the ticks that
+     * advance the present.
+     *
+     * @return the time (in microseconds) to reconcile in the last update.
+     */
+    Uint64 getReplayTime() const { return _replayTime; }
+
+#pragma mark Simulation
+    /**
+     * Advances the predictor by the given amount of time.
+     *
+     * This reconciles any server states that have arrived, simulates the
+     * ticks that fit in the elapsed time (with a tick more or less to keep
+     * the lead on the server), and sends the recent inputs to the server.
+     * It then synchronizes the draw world and applies the visual error.
+     *
+     * @param dt    The elapsed time in seconds
+     */
+    virtual void update(float dt) override;
+};
+
+    }
+}
+
+#endif /* __CU_PHYSICS_PREDICTOR_H__ */
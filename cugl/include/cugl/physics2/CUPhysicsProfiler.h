@@ -0,0 +1,305 @@
+//
+//  CUPhysicsProfiler.h
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides a rolling profiler for the physics engine. It records
+//  the per-frame profile of one or more obstacle worlds, and computes averages
+//  and percentiles over a window of recent frames. These statistics can be
+//  displayed with a ProfilerNode or written to a CSV or JSON file, so that
+//  the physics cost can be measured in production builds.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#ifndef __CU_PHYSICS_PROFILER_H__
+#define __CU_PHYSICS_PROFILER_H__
+#include <cugl/physics2/CUObstacleWorld.h>
+#include <cugl/assets/CUJsonValue.h>
+#include <vector>
+#include <memory>
+#include <string>
+
+/** The default number of frames in the profiler window */
+#define DEFAULT_PROFILE_WINDOW  120
+
+namespace cugl {
+    namespace physics2 {
+
+#pragma mark -
+#pragma mark Physics Profiler
+/**
+ * This class is a rolling profiler for one or more obstacle worlds.
+ *
+ * Each call to {@link #update} sums the profiles of the attached worlds (see
+ * {@link ObstacleWorld#getProfile}) and records the result in a ring buffer
+ * of recent frames. Profiles from other sources may be recorded directly with
+ * {@link #record}. The profiler can then report the average, the maximum, or
+ * any percentile of each value over the window. Percentiles are computed per
+ * value, so the p95 profile is not necessarily the profile of a single frame.
+ *
+ * This class should be updated once per frame, after all of the attached
+ * worlds have been updated. It is not thread safe.
+ */
+class PhysicsProfiler {
+protected:
+    /** The worlds whose profiles are summed each update */
+    std::vector<std::shared_ptr<ObstacleWorld>> _worlds;
+    /** The ring buffer of recorded frames */
+    std::vector<ObstacleWorld::Profile> _history;
+    /** The position of the next frame in the ring buffer */
+    size_t _head;
+    /** The number of frames recorded (at most the window size) */
+    size_t _count;
+    /** The total number of frames recorded since the last reset */
+    Uint64 _frames;
+
+#pragma mark Constructors
+public:
+    /**
+     * Creates a degenerate physics profiler.
+     *
+     * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an object on
+     * the heap, use one of the static constructors instead.
+     */
+    PhysicsProfiler() : _head(0), _count(0), _frames(0) {}
+
+    /**
+     * Deletes this physics profiler, disposing all resources
+     */
+    ~PhysicsProfiler() { dispose(); }
+
+    /**
+     * Disposes all of the resources used by this profiler.
+     *
+     * All worlds are detached. A disposed profiler can be safely reinitialized.
+     */
+    void dispose();
+
+    /**
+     * Initializes a profiler with the given window size.
+     *
+     * The window is the number of recent frames used to compute statistics.
+     *
+     * @param window    The number of frames in the window
+     *
+     * @return true if initialization was successful.
+     */
+    bool init(size_t window=DEFAULT_PROFILE_WINDOW);
+
+    /**
+     * Returns a newly allocated profiler with the given window size.
+     *
+     * The window is the number of recent frames used to compute statistics.
+     *
+     * @param window    The number of frames in the window
+     *
+     * @return a newly allocated profiler with the given window size.
+     */
+    static std::shared_ptr<PhysicsProfiler> alloc(size_t window=DEFAULT_PROFILE_WINDOW) {
+        std::shared_ptr<PhysicsProfiler> result = std::make_shared<PhysicsProfiler>();
+        return (result->init(window) ? result : nullptr);
+    }
+
+#pragma mark -
+#pragma mark Recording
+    /**
+     * Attaches a world to this profiler.
+     *
+     * The profile of each attached world is added to the frame recorded by
+     * {@link #update}. Attaching a world twice has no effect.
+     *
+     * @param world The world to attach
+     */
+    void attach(const std::shared_ptr<ObstacleWorld>& world);
+
+    /**
+     * Detaches a world from this profiler.
+     *
+     * Detaching a world does not affect any frames already recorded.
+     *
+     * @param world The world to detach
+     */
+    void detach(const std::shared_ptr<ObstacleWorld>& world);
+
+    /**
+     * Returns the worlds attached to this profiler.
+     *
+     * @return the worlds attached to this profiler.
+     */
+    const std::vector<std::shared_ptr<ObstacleWorld>>& getWorlds() const {
+        return _worlds;
+    }
+
+    /**
+     * Records the summed profile of the attached worlds as a new frame.
+     *
+     * This method should be called once per frame, after the worlds have
+     * been updated.
+     */
+    void update();
+
+    /**
+     * Records the given profile as a new frame.
+     *
+     * If the window is full, the oldest frame is discarded.
+     *
+     * @param profile   The profile to record
+     */
+    void record(const ObstacleWorld::Profile& profile);
+
+    /**
+     * Discards all recorded frames.
+     *
+     * The attached worlds are unaffected.
+     */
+    void reset();
+
+#pragma mark -
+#pragma mark Statistics
+    /**
+     * Returns the number of frames in the profiler window.
+     *
+     * @return the number of frames in the profiler window.
+     */
+    size_t getWindow() const { return _history.size(); }
+
+    /**
+     * Returns the number of frames currently in the window.
+     *
+     * This is never more than {@link #getWindow}.
+     *
+     * @return the number of frames currently in the window.
+     */
+    size_t getCount() const { return _count; }
+
+    /**
+     * Returns the total number of frames recorded since the last reset.
+     *
+     * @return the total number of frames recorded since the last reset.
+     */
+    Uint64 getFrames() const { return _frames; }
+
+    /**
+     * Returns the frame at the given position in the window.
+     *
+     * Position 0 is the oldest frame in the window, while position
+     * {@link #getCount}-1 is the most recent.
+     *
+     * @param index The position in the window
+     *
+     * @return the frame at the given position in the window.
+     */
+    const ObstacleWorld::Profile& getFrame(size_t index) const;
+
+    /**
+     * Returns the most recently recorded frame.
+     *
+     * If no frames have been recorded, this is a zero profile.
+     *
+     * @return the most recently recorded frame.
+     */
+    ObstacleWorld::Profile getLast() const;
+
+    /**
+     * Returns the average profile over the window.
+     *
+     * The integer counts are rounded to the nearest value.
+     *
+     * @return the average profile over the window.
+     */
+    ObstacleWorld::Profile getAverage() const;
+
+    /**
+     * Returns the maximum profile over the window.
+     *
+     * This is the same as {@link #getPercentile} with value 100.
+     *
+     * @return the maximum profile over the window.
+     */
+    ObstacleWorld::Profile getMaximum() const { return getPercentile(100); }
+
+    /**
+     * Returns the given percentile of the profile over the window.
+     *
+     * The percentile is computed separately for each value with the nearest
+     * rank method. The percent should be between 0 and 100.
+     *
+     * @param percent   The percentile to compute
+     *
+     * @return the given percentile of the profile over the window.
+     */
+    ObstacleWorld::Profile getPercentile(float percent) const;
+
+#pragma mark -
+#pragma mark Output
+    /**
+     * Returns a JSON summary of the window.
+     *
+     * The summary is an object with the number of frames, and the average,
+     * median (p50), p95 and maximum profiles. Each profile is an object keyed
+     * by the value names used in the CSV header.
+     *
+     * @return a JSON summary of the window.
+     */
+    std::shared_ptr<JsonValue> toJson() const;
+
+    /**
+     * Writes the frames in the window to the given CSV file.
+     *
+     * The file has a header row naming each value, followed by one row per
+     * frame from oldest to most recent. Times are in milliseconds. Relative
+     * paths are resolved as in {@link TextWriter}.
+     *
+     * @param file  The CSV file
+     *
+     * @return true if the file was successfully written
+     */
+    bool writeCSV(const std::string file) const;
+
+    /**
+     * Writes the JSON summary of the window to the given file.
+     *
+     * See {@link #toJson} for the format. Relative paths are resolved as in
+     * {@link JsonWriter}.
+     *
+     * @param file  The JSON file
+     *
+     * @return true if the file was successfully written
+     */
+    bool writeJson(const std::string file) const;
+};
+
+    }
+}
+
+#endif /* __CU_PHYSICS_PROFILER_H__ */
@@ -0,0 +1,758 @@
+//
+//  CUPhysicsSession.h
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides a networked physics session for an ObstacleWorld.
+//  The server is authoritative: it steps its world at a fixed tick and
+//  broadcasts the state of the moving bodies to all clients. A client keeps
+//  simulating its own copy of the world, and applies the server state to the
+//  real bodies as it arrives. The jump this causes is hidden by smoothing the
+//  error through the draw bodies, which are only used for display.
+//
+//  Sessions communicate through a NetTransport, so the same session runs over
+//  UDP or over an in-process loopback network.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#ifndef __CU_PHYSICS_SESSION_H__
+#define __CU_PHYSICS_SESSION_H__
+#include <cugl/physics2/CUObstacleWorld.h>
+#include <cugl/physics2/CUNetTransport.h>
+#include <box2d/b2_math.h>
+#include <unordered_map>
+#include <functional>
+#include <vector>
+#include <memory>
+#include <map>
+
+/** The default server tick in seconds */
+#define DEFAULT_NET_TICK        (1.0f/60.0f)
+/** The default number of ticks between full state updates */
+#define DEFAULT_NET_KEYFRAME    30
+/** The default time constant (in seconds) to smooth a client correction */
+#define DEFAULT_NET_SMOOTHING   0.1f
+/** The default correction distance (in physics units) that snaps instead of smoothing */
+#define DEFAULT_NET_SNAP        2.0f
+/** The default time (in seconds) before a silent client is dropped */
+#define DEFAULT_NET_TIMEOUT     5.0f
+
+namespace cugl {
+    namespace physics2 {
+
+#pragma mark -
+#pragma mark Physics Server
+/**
+ * This class is the authoritative server of a networked physics session.
+ *
+ * The server steps its world at a fixed tick, regardless of the frame rate.
+ * After each tick, it broadcasts the state of the bodies that moved to every
+ * client. A body is identified by its obstacle id (see {@link Obstacle#setId}),
+ * so the client worlds must assign the same ids to the same obstacles. Static
+ * bodies are never sent. Sleeping bodies are only sent in a keyframe, which
+ * is a full update sent every few ticks (and whenever a client joins). This
+ * recovers from any lost packets without sending the whole world every tick.
+ *
+ * The state of a tick is split across as many packets as necessary, so that
+ * no packet is larger than NET_MAX_PACKET. Each packet is self-contained.
+ *
+ * Clients send a heartbeat while connected. As a client may leave without
+ * notice (or its notice may be lost), a client is dropped if the server has
+ * not heard from it for the timeout. The server echoes each heartbeat, so
+ * that the client can measure the round trip time.
+ *
+ * Clients may also send inputs (see {@link PhysicsPredictor}). An input is
+ * an opaque array of bytes stamped with the tick it is meant for. Before each
+ * tick, the server passes every input due by that tick to {@link #onInput},
+ * which should apply it to the world (typically as forces on the body of
+ * that client). An input that arrives after its tick is applied at the next
+ * tick, rather than dropped.
+ *
+ * Only the root body of an obstacle is replicated. The component bodies of a
+ * {@link ComplexObstacle} are left to the client simulation.
+ */
+class PhysicsServer {
+protected:
+    /** The inputs of a single client */
+    class Inputs {
+    public:
+        /** The latest tick received */
+        Uint32 received;
+        /** The inputs not yet applied, by tick */
+        std::map<Uint32, std::vector<Uint8>> pending;
+    };
+
+    /** The authoritative world */
+    std::shared_ptr<ObstacleWorld> _world;
+    /** The transport to the clients */
+    std::shared_ptr<NetTransport> _transport;
+    /** The addresses of the connected clients */
+    std::vector<Uint32> _clients;
+    /** The server clock when each client was last heard from */
+    std::vector<double> _heard;
+    /** The inputs of each client, by address */
+    std::unordered_map<Uint32, Inputs> _inputs;
+    /** The server clock in seconds */
+    double _clock;
+    /** The time before a silent client is dropped */
+    float _timeout;
+    /** The fixed tick in seconds */
+    float _step;
+    /** The time not yet simulated */
+    float _accum;
+    /** The number of ticks simulated */
+    Uint32 _tick;
+    /** The number of ticks between keyframes */
+    Uint32 _keyrate;
+    /** Whether the next broadcast must be a keyframe */
+    bool _keyframe;
+    /** The buffer for outgoing packets */
+    std::vector<Uint8> _packet;
+    /** The buffer for incoming packets */
+    std::vector<Uint8> _incoming;
+    /** The time (in microseconds) to step the world in the last tick */
+    Uint64 _stepTime;
+    /** The time (in microseconds) to broadcast the state in the last tick */
+    Uint64 _sendTime;
+    /** The number of bytes sent in the last tick */
+    Uint64 _tickBytes;
+    /** The number of bodies sent in the last tick */
+    size_t _tickBodies;
+
+    /**
+     * Processes all of the packets received from the clients.
+     *
+     * This also drops any client that has timed out.
+     */
+    void receive();
+
+    /**
+     * Stores the inputs of an input message from the given client.
+     *
+     * @param client    The client address
+     * @param data      The packet payload
+     * @param size      The number of bytes in the payload
+     */
+    void store(Uint32 client, const Uint8* data, size_t size);
+
+    /**
+     * Drops the client at the given position in the client list.
+     *
+     * The transport forgets the client too.
+     *
+     * @param pos   The position of the client
+     */
+    void drop(size_t pos);
+
+    /**
+     * Sends the state of the world to all clients.
+     */
+    void broadcast();
+
+    /**
+     * Sends the given packet to all clients.
+     *
+     * @param size  The number of bytes of the packet buffer to send
+     */
+    void post(size_t size);
+
+public:
+    /**
+     * The function to apply a client input to the world.
+     *
+     * This function is called before the given tick is simulated. The tick
+     * is the one that the input was stamped with. It is earlier than the
+     * current tick if the input arrived late.
+     */
+    std::function<void(Uint32 client, Uint32 tick, const Uint8* data, size_t size)> onInput;
+
+#pragma mark Constructors
+    /**
+     * Creates a degenerate physics server.
+     *
+     * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an object on
+     * the heap, use one of the static constructors instead.
+     */
+    PhysicsServer();
+
+    /**
+     * Deletes this server, disposing all resources
+     */
+    ~PhysicsServer() { dispose(); }
+
+    /**
+     * Disposes all of the resources used by this server.
+     *
+     * The world and transport are released, but not closed. A disposed
+     * server can be safely reinitialized.
+     */
+    void dispose();
+
+    /**
+     * Initializes a server for the given world and transport.
+     *
+     * The server takes over the stepping of the world. The game should call
+     * {@link #update} instead of {@link ObstacleWorld#update}.
+     *
+     * @param world     The authoritative world
+     * @param transport The transport to the clients
+     * @param step      The fixed tick in seconds
+     *
+     * @return true if initialization was successful.
+     */
+    bool init(const std::shared_ptr<ObstacleWorld>& world,
+              const std::shared_ptr<NetTransport>& transport,
+              float step=DEFAULT_NET_TICK);
+
+    /**
+     * Returns a newly allocated server for the given world and transport.
+     *
+     * The server takes over the stepping of the world. The game should call
+     * {@link #update} instead of {@link ObstacleWorld#update}.
+     *
+     * @param world     The authoritative world
+     * @param transport The transport to the clients
+     * @param step      The fixed tick in seconds
+     *
+     * @return a newly allocated server for the given world and transport.
+     */
+    static std::shared_ptr<PhysicsServer> alloc(const std::shared_ptr<ObstacleWorld>& world,
+                                                const std::shared_ptr<NetTransport>& transport,
+                                                float step=DEFAULT_NET_TICK) {
+        std::shared_ptr<PhysicsServer> result = std::make_shared<PhysicsServer>();
+        return (result->init(world,transport,step) ? result : nullptr);
+    }
+
+#pragma mark Attributes
+    /**
+     * Returns the authoritative world.
+     *
+     * @return the authoritative world.
+     */
+    const std::shared_ptr<ObstacleWorld>& getWorld() const { return _world; }
+
+    /**
+     * Returns the transport to the clients.
+     *
+     * @return the transport to the clients.
+     */
+    const std::shared_ptr<NetTransport>& getTransport() const { return _transport; }
+
+    /**
+     * Returns the fixed tick in seconds.
+     *
+     * @return the fixed tick in seconds.
+     */
+    float getStep() const { return _step; }
+
+    /**
+     * Returns the number of ticks simulated.
+     *
+     * @return the number of ticks simulated.
+     */
+    Uint32 getTick() const { return _tick; }
+
+    /**
+     * Returns the number of ticks between keyframes.
+     *
+     * @return the number of ticks between keyframes.
+     */
+    Uint32 getKeyframeRate() const { return _keyrate; }
+
+    /**
+     * Sets the number of ticks between keyframes.
+     *
+     * A keyframe sends every non-static body, including those asleep. If the
+     * rate is 0, every tick is a keyframe.
+     *
+     * @param rate  The number of ticks between keyframes.
+     */
+    void setKeyframeRate(Uint32 rate) { _keyrate = rate; }
+
+    /**
+     * Returns the time (in seconds) before a silent client is dropped.
+     *
+     * @return the time (in seconds) before a silent client is dropped.
+     */
+    float getTimeout() const { return _timeout; }
+
+    /**
+     * Sets the time (in seconds) before a silent client is dropped.
+     *
+     * If the timeout is 0, clients are only dropped when they leave.
+     *
+     * @param timeout   The time (in seconds) before a silent client is dropped.
+     */
+    void setTimeout(float timeout) { _timeout = timeout; }
+
+    /**
+     * Returns the addresses of the connected clients.
+     *
+     * @return the addresses of the connected clients.
+     */
+    const std::vector<Uint32>& getClients() const { return _clients; }
+
+    /**
+     * Returns the number of connected clients.
+     *
+     * @return the number of connected clients.
+     */
+    size_t getClientCount() const { return _clients.size(); }
+
+#pragma mark Simulation
+    /**
+     * Advances the server by the given amount of time.
+     *
+     * This processes any client packets, and then simulates as many fixed
+     * ticks as fit in the elapsed time (plus any time left over from the last
+     * call). The state is broadcast after every tick. Each tick is simulated
+     * with {@link ObstacleWorld#step}, so that clients can replay it exactly.
+     * The draw world is synchronized once all of the ticks are done.
+     *
+     * @param dt    The elapsed time in seconds
+     *
+     * @return the number of ticks simulated
+     */
+    Uint32 update(float dt);
+
+    /**
+     * Simulates a single tick and broadcasts the result.
+     *
+     * This applies the client inputs due by this tick, but does not process
+     * any client packets. It does not synchronize the draw world.
+     */
+    void tick();
+
+#pragma mark Statistics
+    /**
+     * Returns the time (in microseconds) to step the world in the last tick.
+     *
+     * @return the time (in microseconds) to step the world in the last tick.
+     */
+    Uint64 getStepTime() const { return _stepTime; }
+
+    /**
+     * Returns the time (in microseconds) to broadcast the state in the last tick.
+     *
+     * This includes both encoding the state and sending it to every client.
+     *
+     * @return the time (in microseconds) to broadcast the state in the last tick.
+     */
+    Uint64 getSendTime() const { return _sendTime; }
+
+    /**
+     * Returns the number of payload bytes sent in the last tick.
+     *
+     * This is the total over all clients.
+     *
+     * @return the number of payload bytes sent in the last tick.
+     */
+    Uint64 getTickBytes() const { return _tickBytes; }
+
+    /**
+     * Returns the number of bodies sent in the last tick.
+     *
+     * This is the number of bodies in the state, not multiplied by clients.
+     *
+     * @return the number of bodies sent in the last tick.
+     */
+    size_t getTickBodies() const { return _tickBodies; }
+};
+
+#pragma mark -
+#pragma mark Physics Client
+/**
+ * This class is a client of a networked physics session.
+ *
+ * A client simulates its own copy of the world, so that bodies move smoothly
+ * between server updates. When a server state arrives, it is applied to the
+ * real bodies at once, but not to the draw bodies. Instead, the difference
+ * between the old and the new pose is kept as a visual error, which is added
+ * to the draw body and decays over the smoothing time. Corrections larger than
+ * the snap distance (such as teleports) are applied without smoothing.
+ *
+ * Because the error is applied to the draw bodies, the game should position
+ * its scene graph from the obstacles (e.g. {@link Obstacle#getPosition})
+ * after calling {@link #update}, as it would after {@link ObstacleWorld#update}.
+ *
+ * States are matched to obstacles by id (see {@link Obstacle#setId}). States
+ * older than the latest one applied are ignored.
+ */
+class PhysicsClient {
+protected:
+    /** The visual error of a corrected body */
+    class Correction {
+    public:
+        /** The position error */
+        Vec2 offset;
+        /** The angle error in radians */
+        float angle;
+    };
+
+    /** The server state of a single body */
+    class Record {
+    public:
+        /** The obstacle id */
+        Uint32 id;
+        /** The body position */
+        b2Vec2 position;
+        /** The body angle */
+        float angle;
+        /** The linear velocity */
+        b2Vec2 linear;
+        /** The angular velocity */
+        float angular;
+        /** Whether the body is awake */
+        bool awake;
+        /** Whether the body is enabled */
+        bool enabled;
+        /** Whether the body is a bullet */
+        bool bullet;
+    };
+
+    /** The client copy of the world */
+    std::shared_ptr<ObstacleWorld> _world;
+    /** The transport to the server */
+    std::shared_ptr<NetTransport> _transport;
+    /** The address of the server */
+    Uint32 _server;
+    /** Whether the server has accepted this client */
+    bool _connected;
+    /** The time until the next connection attempt (or heartbeat) */
+    float _retry;
+    /** The client clock in seconds */
+    double _clock;
+    /** The smoothed round trip time in seconds (negative if not yet measured) */
+    float _rtt;
+    /** The server tick of the latest echo */
+    Uint32 _echoTick;
+    /** The client clock when the latest echo arrived */
+    double _echoTime;
+    /** The server tick of the latest state applied */
+    Uint32 _tick;
+    /** The server tick length in seconds */
+    float _step;
+    /** The time constant to smooth a correction */
+    float _smoothing;
+    /** The correction distance that snaps instead of smoothing */
+    float _snap;
+    /** The index of each obstacle in the world, by id */
+    std::unordered_map<Uint32, size_t> _obstacles;
+    /** Whether the obstacle index was rebuilt in this update */
+    bool _remapped;
+    /** The visual error of each corrected body, by id */
+    std::unordered_map<Uint32, Correction> _errors;
+    /** The buffer for incoming packets */
+    std::vector<Uint8> _incoming;
+    /** The buffer for decoded body states */
+    std::vector<Record> _records;
+    /** The buffer for outgoing packets */
+    std::vector<Uint8> _outgoing;
+    /** The number of bodies corrected in the last update */
+    size_t _corrected;
+
+    /**
+     * Advances the client clock, and sends a connection request or heartbeat if due.
+     *
+     * @param dt    The elapsed time in seconds
+     */
+    void heartbeat(float dt);
+
+    /**
+     * Processes all of the packets received from the server.
+     */
+    void receive();
+
+    /**
+     * Records an echo of the client clock from the server.
+     *
+     * @param tick  The server tick when the echo was sent
+     * @param sent  The client clock (in milliseconds) that was echoed
+     */
+    void measure(Uint32 tick, Uint32 sent);
+
+    /**
+     * Applies a state packet from the server.
+     *
+     * @param data  The packet payload
+     * @param size  The number of bytes in the payload
+     */
+    virtual void apply(const Uint8* data, size_t size);
+
+    /**
+     * Decodes a state packet from the server into {@link #_records}.
+     *
+     * This method returns false if the packet is malformed.
+     *
+     * @param data  The packet payload
+     * @param size  The number of bytes in the payload
+     * @param tick  The server tick of the state
+     *
+     * @return true if the packet was decoded.
+     */
+    bool decode(const Uint8* data, size_t size, Uint32& tick);
+
+    /**
+     * Sends the given inputs to the server.
+     *
+     * The inputs are for consecutive ticks, starting at the given one. Inputs
+     * that do not fit in a single packet are not sent.
+     *
+     * @param first     The tick of the first input
+     * @param inputs    The inputs in tick order
+     */
+    void submit(Uint32 first, const std::vector<const std::vector<Uint8>*>& inputs);
+
+    /**
+     * Applies the given server state to a real body at the present time.
+     *
+     * The difference between the old and the new pose is added to the visual
+     * error of the body.
+     *
+     * @param body  The real body
+     * @param state The server state of the body
+     */
+    void correct(b2Body* body, const Record& state);
+
+    /**
+     * Adds the given pose difference to the visual error of a body.
+     *
+     * The error is dropped (so the body snaps) if it exceeds the snap distance.
+     *
+     * @param id        The obstacle id
+     * @param offset    The position difference (old minus new)
+     * @param angle     The angle difference (old minus new)
+     */
+    void blend(Uint32 id, const b2Vec2& offset, float angle);
+
+    /**
+     * Applies the decaying visual error to the draw bodies.
+     *
+     * @param dt    The elapsed time in seconds
+     */
+    void smooth(float dt);
+
+    /**
+     * Returns the obstacle with the given id, or nullptr if there is none.
+     *
+     * @param id    The obstacle id
+     *
+     * @return the obstacle with the given id.
+     */
+    Obstacle* lookup(Uint32 id);
+
+    /**
+     * Returns the index of the obstacle with the given id in the world.
+     *
+     * If there is no such obstacle, this returns the number of obstacles.
+     *
+     * @param id    The obstacle id
+     *
+     * @return the index of the obstacle with the given id in the world.
+     */
+    size_t locate(Uint32 id);
+
+    /**
+     * Sends a message with the client clock to the server.
+     *
+     * @param type  The message type
+     */
+    void signal(Uint8 type);
+
+public:
+#pragma mark Constructors
+    /**
+     * Creates a degenerate physics client.
+     *
+     * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an object on
+     * the heap, use one of the static constructors instead.
+     */
+    PhysicsClient();
+
+    /**
+     * Deletes this client, disposing all resources
+     */
+    virtual ~PhysicsClient() { dispose(); }
+
+    /**
+     * Disposes all of the resources used by this client.
+     *
+     * If the client is connected, it tells the server that it is leaving. The
+     * world and transport are released, but not closed. A disposed client can
+     * be safely reinitialized.
+     */
+    virtual void dispose();
+
+    /**
+     * Initializes a client for the given world and server.
+     *
+     * The client takes over the stepping of the world. The game should call
+     * {@link #update} instead of {@link ObstacleWorld#update}. The client
+     * connects to the server on the first update.
+     *
+     * @param world     The client copy of the world
+     * @param transport The transport to the server
+     * @param server    The address of the server on the transport
+     *
+     * @return true if initialization was successful.
+     */
+    bool init(const std::shared_ptr<ObstacleWorld>& world,
+              const std::shared_ptr<NetTransport>& transport, Uint32 server);
+
+    /**
+     * Returns a newly allocated client for the given world and server.
+     *
+     * The client takes over the stepping of the world. The game should call
+     * {@link #update} instead of {@link ObstacleWorld#update}. The client
+     * connects to the server on the first update.
+     *
+     * @param world     The client copy of the world
+     * @param transport The transport to the server
+     * @param server    The address of the server on the transport
+     *
+     * @return a newly allocated client for the given world and server.
+     */
+    static std::shared_ptr<PhysicsClient> alloc(const std::shared_ptr<ObstacleWorld>& world,
+                                                const std::shared_ptr<NetTransport>& transport,
+                                                Uint32 server) {
+        std::shared_ptr<PhysicsClient> result = std::make_shared<PhysicsClient>();
+        return (result->init(world,transport,server) ? result : nullptr);
+    }
+
+#pragma mark Attributes
+    /**
+     * Returns the client copy of the world.
+     *
+     * @return the client copy of the world.
+     */
+    const std::shared_ptr<ObstacleWorld>& getWorld() const { return _world; }
+
+    /**
+     * Returns the transport to the server.
+     *
+     * @return the transport to the server.
+     */
+    const std::shared_ptr<NetTransport>& getTransport() const { return _transport; }
+
+    /**
+     * Returns true if the server has accepted this client.
+     *
+     * @return true if the server has accepted this client.
+     */
+    bool isConnected() const { return _connected; }
+
+    /**
+     * Returns the server tick of the latest state applied.
+     *
+     * @return the server tick of the latest state applied.
+     */
+    Uint32 getServerTick() const { return _tick; }
+
+    /**
+     * Returns the server tick length in seconds.
+     *
+     * This value is only meaningful once the client is connected.
+     *
+     * @return the server tick length in seconds.
+     */
+    float getServerStep() const { return _step; }
+
+    /**
+     * Returns the smoothed round trip time to the server in seconds.
+     *
+     * This is measured from the echo of the connection request and of each
+     * heartbeat. It is negative until the first echo arrives.
+     *
+     * @return the smoothed round trip time to the server in seconds.
+     */
+    float getRoundTrip() const { return _rtt; }
+
+    /**
+     * Returns the time constant to smooth a correction.
+     *
+     * The visual error of a correction decays by a factor of e every time
+     * constant. If this value is 0, corrections are never smoothed.
+     *
+     * @return the time constant to smooth a correction.
+     */
+    float getSmoothing() const { return _smoothing; }
+
+    /**
+     * Sets the time constant to smooth a correction.
+     *
+     * The visual error of a correction decays by a factor of e every time
+     * constant. If this value is 0, corrections are never smoothed.
+     *
+     * @param time  The time constant to smooth a correction.
+     */
+    void setSmoothing(float time) { _smoothing = time; }
+
+    /**
+     * Returns the correction distance that snaps instead of smoothing.
+     *
+     * @return the correction distance that snaps instead of smoothing.
+     */
+    float getSnapDistance() const { return _snap; }
+
+    /**
+     * Sets the correction distance that snaps instead of smoothing.
+     *
+     * @param distance  The correction distance that snaps instead of smoothing.
+     */
+    void setSnapDistance(float distance) { _snap = distance; }
+
+    /**
+     * Returns the number of bodies corrected in the last update.
+     *
+     * @return the number of bodies corrected in the last update.
+     */
+    size_t getCorrections() const { return _corrected; }
+
+#pragma mark Simulation
+    /**
+     * Advances the client by the given amount of time.
+     *
+     * This applies any server states that have arrived, steps the world, and
+     * then applies the visual error to the draw bodies. If the client is not
+     * yet connected, it (re)sends its connection request. Otherwise, it sends
+     * a periodic heartbeat so that the server does not drop it.
+     *
+     * @param dt    The elapsed time in seconds
+     */
+    virtual void update(float dt);
+};
+
+    }
+}
+
+#endif /* __CU_PHYSICS_SESSION_H__ */
@@ -0,0 +1,263 @@
+//
+//  CUProfilerNode.h
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides a scene graph node to display a physics profiler. It
+//  draws a bar graph of the recent frames, with each bar divided into the
+//  major phases of the physics step. If it has a font, it also displays the
+//  average and p95 times together with the world population counts. It is
+//  intended as a debugging overlay on top of a game scene.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#ifndef __CU_PROFILER_NODE_H__
+#define __CU_PROFILER_NODE_H__
+#include <cugl/physics2/CUPhysicsProfiler.h>
+#include <cugl/scene2/graph/CUSceneNode.h>
+#include <cugl/render/CUFont.h>
+
+/** The default frame budget of the profiler graph in milliseconds */
+#define DEFAULT_PROFILE_BUDGET  (1000.0f/60.0f)
+
+namespace cugl {
+    namespace physics2 {
+
+#pragma mark -
+#pragma mark ProfilerNode
+/**
+ * This is a scene graph node to display a physics profiler.
+ *
+ * The node draws a bar for each frame in the profiler window, from oldest on
+ * the left to most recent on the right. Each bar is divided into the collide,
+ * solve, TOI and sync phases of the frame (bottom to top). The full height of
+ * the node is the frame budget, which is 1/60 of a second by default. Bars
+ * that exceed the budget are clipped.
+ *
+ * If the node has a font, it also displays the average and p95 step times,
+ * followed by the average population counts, at the top left of the node.
+ * The background is drawn with the node color, which is a translucent black
+ * by default. The alpha of the node color is also applied to the bars.
+ *
+ * This node does not update the profiler. That is the responsibility of the
+ * game, as the profiler should be updated after the physics update.
+ */
+class ProfilerNode : public scene2::SceneNode {
+protected:
+    /** The profiler to display */
+    std::shared_ptr<PhysicsProfiler> _profiler;
+    /** The font for the summary text (may be nullptr) */
+    std::shared_ptr<Font> _font;
+    /** The frame budget in milliseconds (the height of the graph) */
+    float _budget;
+
+public:
+#pragma mark Constructors
+    /**
+     * Creates an uninitialized node.
+     *
+     * You must initialize this node before use.
+     *
+     * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate a Node on the
+     * heap, use one of the static constructors instead.
+     */
+    ProfilerNode();
+
+    /**
+     * Deletes this node, disposing all resources
+     */
+    ~ProfilerNode() { dispose(); }
+
+    /**
+     * Disposes all of the resources used by this node.
+     *
+     * A disposed Node can be safely reinitialized. Any children owned by this
+     * node will be released. They will be deleted if no other object owns them.
+     *
+     * It is unsafe to call this on a Node that is still currently inside of
+     * a scene graph.
+     */
+    virtual void dispose() override;
+
+    /**
+     * Initializes a node to display the given profiler.
+     *
+     * The node will only display the bar graph, as it has no font.
+     *
+     * @param profiler  The profiler to display
+     * @param size      The content size of the node
+     *
+     * @return true if initialization was successful.
+     */
+    bool init(const std::shared_ptr<PhysicsProfiler>& profiler, const Size size) {
+        return initWithFont(profiler,size,nullptr);
+    }
+
+    /**
+     * Initializes a node to display the given profiler with the given font.
+     *
+     * The font is used to display the summary text. If it is nullptr, the
+     * node will only display the bar graph.
+     *
+     * @param profiler  The profiler to display
+     * @param size      The content size of the node
+     * @param font      The font for the summary text
+     *
+     * @return true if initialization was successful.
+     */
+    bool initWithFont(const std::shared_ptr<PhysicsProfiler>& profiler, const Size size,
+                      const std::shared_ptr<Font>& font);
+
+    /**
+     * Performs a shallow copy of this Node into dst.
+     *
+     * No children from this node are copied, and no children of dst are
+     * modified. In addition, the parents of both Nodes are unchanged. However,
+     * all other attributes of this node are copied. The profiler and font are
+     * shared, not copied.
+     *
+     * @param dst   The Node to copy into
+     *
+     * @return A reference to dst for chaining.
+     */
+    virtual std::shared_ptr<SceneNode> copy(const std::shared_ptr<SceneNode>& dst) const override;
+
+#pragma mark -
+#pragma mark Static Constructors
+    /**
+     * Returns a newly allocated node to display the given profiler.
+     *
+     * The node will only display the bar graph, as it has no font.
+     *
+     * @param profiler  The profiler to display
+     * @param size      The content size of the node
+     *
+     * @return a newly allocated node to display the given profiler.
+     */
+    static std::shared_ptr<ProfilerNode> alloc(const std::shared_ptr<PhysicsProfiler>& profiler,
+                                               const Size size) {
+        std::shared_ptr<ProfilerNode> result = std::make_shared<ProfilerNode>();
+        return (result->init(profiler,size) ? result : nullptr);
+    }
+
+    /**
+     * Returns a newly allocated node to display the given profiler with the given font.
+     *
+     * The font is used to display the summary text. If it is nullptr, the
+     * node will only display the bar graph.
+     *
+     * @param profiler  The profiler to display
+     * @param size      The content size of the node
+     * @param font      The font for the summary text
+     *
+     * @return a newly allocated node to display the given profiler with the given font.
+     */
+    static std::shared_ptr<ProfilerNode> allocWithFont(const std::shared_ptr<PhysicsProfiler>& profiler,
+                                                       const Size size,
+                                                       const std::shared_ptr<Font>& font) {
+        std::shared_ptr<ProfilerNode> result = std::make_shared<ProfilerNode>();
+        return (result->initWithFont(profiler,size,font) ? result : nullptr);
+    }
+
+#pragma mark -
+#pragma mark Attributes
+    /**
+     * Returns the profiler displayed by this node.
+     *
+     * @return the profiler displayed by this node.
+     */
+    const std::shared_ptr<PhysicsProfiler>& getProfiler() const { return _profiler; }
+
+    /**
+     * Sets the profiler displayed by this node.
+     *
+     * @param profiler  The profiler displayed by this node.
+     */
+    void setProfiler(const std::shared_ptr<PhysicsProfiler>& profiler) { _profiler = profiler; }
+
+    /**
+     * Returns the font for the summary text.
+     *
+     * If this value is nullptr, the node only displays the bar graph.
+     *
+     * @return the font for the summary text.
+     */
+    const std::shared_ptr<Font>& getFont() const { return _font; }
+
+    /**
+     * Sets the font for the summary text.
+     *
+     * If this value is nullptr, the node only displays the bar graph.
+     *
+     * @param font  The font for the summary text.
+     */
+    void setFont(const std::shared_ptr<Font>& font) { _font = font; }
+
+    /**
+     * Returns the frame budget in milliseconds.
+     *
+     * The budget is the time represented by the full height of the graph.
+     *
+     * @return the frame budget in milliseconds.
+     */
+    float getBudget() const { return _budget; }
+
+    /**
+     * Sets the frame budget in milliseconds.
+     *
+     * The budget is the time represented by the full height of the graph.
+     *
+     * @param budget    The frame budget in milliseconds.
+     */
+    void setBudget(float budget) { _budget = budget; }
+
+#pragma mark -
+#pragma mark Rendering
+    /**
+     * Draws this Node via the given SpriteBatch.
+     *
+     * This method draws the background, the bar graph and (if there is a
+     * font) the summary text of the profiler.
+     *
+     * @param batch     The SpriteBatch to draw with.
+     * @param transform The global transformation matrix.
+     * @param tint      The tint to blend with the Node color.
+     */
+    virtual void draw(const std::shared_ptr<SpriteBatch>& batch,
+                      const Affine2& transform, Color4 tint) override;
+};
+
+    }
+}
+
+#endif /* __CU_PROFILER_NODE_H__ */
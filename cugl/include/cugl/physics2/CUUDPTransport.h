@@ -0,0 +1,229 @@
+//
+//  CUUDPTransport.h
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides a UDP implementation of the networked physics
+//  transport. It wraps a single non-blocking IPv4 datagram socket. Remote
+//  peers are assigned integer addresses as they are added (or as they first
+//  send a packet), so that sessions never need to deal with socket addresses.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#ifndef __CU_UDP_TRANSPORT_H__
+#define __CU_UDP_TRANSPORT_H__
+#include <cugl/physics2/CUNetTransport.h>
+#include <unordered_map>
+#include <string>
+
+namespace cugl {
+    namespace physics2 {
+
+#pragma mark -
+#pragma mark UDP Transport
+/**
+ * This class is a transport over a UDP socket.
+ *
+ * The socket is IPv4 and non-blocking. It is bound to the given port on all
+ * interfaces, or to an ephemeral port if the port is 0 (use {@link #getPort}
+ * to find the port actually bound).
+ *
+ * Peers are identified by integer addresses local to this transport. A peer
+ * is added explicitly with {@link #addPeer}, which is how a client names its
+ * server. A packet from an unknown host and port automatically adds that
+ * peer, which is how a server learns about its clients. So the owner must
+ * call {@link #removePeer} for any peer it does not keep, or a bound socket
+ * will remember every host that ever sent to it.
+ *
+ * This class is not thread safe.
+ */
+class UDPTransport : public NetTransport {
+private:
+    /** The socket handle (a SOCKET on Windows, a file descriptor elsewhere) */
+    intptr_t _socket;
+    /** The port bound by the socket */
+    Uint16 _port;
+    /** The IPv4 address (network order) of each peer */
+    std::vector<Uint32> _hosts;
+    /** The port (network order) of each peer */
+    std::vector<Uint16> _ports;
+    /** The peer address of each host and port (packed as a single key) */
+    std::unordered_map<Uint64, Uint32> _peers;
+    /** The addresses of removed peers, to be reused */
+    std::vector<Uint32> _unused;
+    /** The buffer for incoming datagrams */
+    std::vector<Uint8> _buffer;
+
+    /**
+     * Returns the peer address for the given host and port, adding it if necessary.
+     *
+     * @param host  The IPv4 address in network order
+     * @param port  The port in network order
+     *
+     * @return the peer address for the given host and port
+     */
+    Uint32 lookup(Uint32 host, Uint16 port);
+
+public:
+#pragma mark Constructors
+    /**
+     * Creates a degenerate UDP transport with no socket.
+     *
+     * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an object on
+     * the heap, use one of the static constructors instead.
+     */
+    UDPTransport();
+
+    /**
+     * Deletes this transport, disposing all resources
+     */
+    ~UDPTransport() { close(); }
+
+    /**
+     * Closes this transport, releasing all resources.
+     *
+     * The socket is closed, and all peers are forgotten.
+     */
+    virtual void close() override;
+
+    /**
+     * Initializes a transport bound to the given port.
+     *
+     * If the port is 0, the socket is bound to an ephemeral port.
+     *
+     * @param port  The port to bind
+     *
+     * @return true if initialization was successful.
+     */
+    bool init(Uint16 port=0);
+
+    /**
+     * Returns a newly allocated transport bound to the given port.
+     *
+     * If the port is 0, the socket is bound to an ephemeral port.
+     *
+     * @param port  The port to bind
+     *
+     * @return a newly allocated transport bound to the given port.
+     */
+    static std::shared_ptr<UDPTransport> alloc(Uint16 port=0) {
+        std::shared_ptr<UDPTransport> result = std::make_shared<UDPTransport>();
+        return (result->init(port) ? result : nullptr);
+    }
+
+#pragma mark Peers
+    /**
+     * Returns the port bound by this transport.
+     *
+     * @return the port bound by this transport.
+     */
+    Uint16 getPort() const { return _port; }
+
+    /**
+     * Returns the peer address for the given host and port.
+     *
+     * The host may be a numeric IPv4 address or a host name. The peer is added
+     * if it is not already known. This method returns NET_NO_PEER if the host
+     * cannot be resolved.
+     *
+     * @param host  The host name or IPv4 address
+     * @param port  The port of the host
+     *
+     * @return the peer address for the given host and port.
+     */
+    Uint32 addPeer(const std::string& host, Uint16 port);
+
+    /**
+     * Returns the number of peers known to this transport.
+     *
+     * @return the number of peers known to this transport.
+     */
+    size_t getPeerCount() const { return _peers.size(); }
+
+    /**
+     * Forgets the given peer.
+     *
+     * The address may be reused for a later peer. Nothing can be sent to
+     * the address until then.
+     *
+     * @param peer  The address of the peer to forget
+     */
+    virtual void removePeer(Uint32 peer) override;
+
+#pragma mark Communication
+    /**
+     * Returns true if this transport is open.
+     *
+     * @return true if this transport is open.
+     */
+    virtual bool isOpen() const override;
+
+    /**
+     * Returns NET_NO_PEER, as sockets are addressed by host and port.
+     *
+     * @return NET_NO_PEER
+     */
+    virtual Uint32 getAddress() const override { return NET_NO_PEER; }
+
+    /**
+     * Sends a packet to the given peer.
+     *
+     * This method returns true if the packet was handed off to the socket.
+     * That is no guarantee that the packet will arrive.
+     *
+     * @param peer  The address of the destination peer
+     * @param data  The packet payload
+     * @param size  The number of bytes in the payload
+     *
+     * @return true if the packet was sent.
+     */
+    virtual bool send(Uint32 peer, const Uint8* data, size_t size) override;
+
+    /**
+     * Receives the next available packet, if any.
+     *
+     * The payload is stored in data, which is resized to fit. This method
+     * returns false immediately if there is no packet available.
+     *
+     * @param peer  The address of the source peer
+     * @param data  The buffer to store the payload
+     *
+     * @return true if a packet was received.
+     */
+    virtual bool receive(Uint32& peer, std::vector<Uint8>& data) override;
+};
+
+    }
+}
+
+#endif /* __CU_UDP_TRANSPORT_H__ */
@@ -37,5 +37,11 @@
 #include "CUPolygonObstacle.h"
 #include "CUCapsuleObstacle.h"
 #include "CUObstacleSelector.h"
+#include "CUPhysicsProfiler.h"
+#include "CUProfilerNode.h"
+#include "CUNetTransport.h"
+#include "CUUDPTransport.h"
+#include "CUPhysicsSession.h"
+#include "CUPhysicsPredictor.h"
 
 #endif /* __CU_PHYSICS_2_PKG_H__ */
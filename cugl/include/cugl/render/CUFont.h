@@ -443,6 +443,14 @@ protected:
     /** The atlas storing any particular character */
     std::unordered_map<Uint32, size_t> _atlasmap;
 
+    // Direct-indexed glyph tables (mirrors of the maps above)
+    /** The dense index (plus one) of each glyph below the table limit, or 0 if absent */
+    std::vector<Uint16> _glyphindex;
+    /** The metrics of the glyphs in the dense index */
+    std::vector<Metrics> _glyphtable;
+    /** The kerning matrix for the glyphs in the dense index (empty if too large) */
+    std::vector<Sint16> _kerntable;
+
     // GlyphRun generation
     /** Whether to generate an impromptu atlas for missing glyphs */
     bool _fallback;
@@ -1114,6 +1122,45 @@ public:
      * @return the tracking adjustments to fit the text in the given width
      */
     std::vector<int> getTracking(const char* substr, const char* end, float width);
+
+    /**
+     * Stores the tracking adjustments to fit the text in the given vector
+     *
+     * Unlike kerning, tracking is used to dynamically adjust the spaces between
+     * characters. The purpose is to fix the text to the given width exactly (or
+     * as close as possible).  Usually this means shrinking the space when the
+     * text is larger than the width.  But in the case of justification, it may
+     * also be used to increase the space. The number of tracking measurements
+     * is one less than the number of characters.
+     *
+     * All tracking is measured in integer offsets. That is because text looks
+     * more uniform when glyph positions are at integral values (otherwise the
+     * texture may shimmer on movement). Whenever possible, the algorithm will
+     * try to track the text to within 1 unit of the width (under, not over).
+     * In the case of shrinking, this may not be possible if the shrink limit
+     * is too low.
+     *
+     * Tracking adjustments will be uniform between non-space characters. If
+     * any non-uniform adjustments need to be made, they will be made around
+     * white-space.
+     *
+     * The C-style string substr need not be null-terminated. Instead, the
+     * termination is indicated by the parameter end. This provides efficient
+     * substring processing. The string may either be in UTF8 or ASCII; the
+     * method will handle conversion automatically.
+     *
+     * The adjustments are stored in the vector adjusts, which is cleared first.
+     * As the vector keeps its capacity, this version allows a caller to compute
+     * tracking every frame without allocating.
+     *
+     * @param adjusts   The vector to store the tracking adjustments
+     * @param substr    The start of the string to measure
+     * @param end       The end of the string to measure
+     * @param width     The line width
+     *
+     * @return the number of tracking adjustments
+     */
+    size_t getTracking(std::vector<int>& adjusts, const char* substr, const char* end, float width);
     
 #pragma mark -
 #pragma mark Atlas Support
@@ -1295,6 +1342,16 @@ public:
      */
     const std::vector<std::shared_ptr<Texture>> getAtlases();
 
+    /**
+     * Returns the number of bytes used by the atlas textures.
+     *
+     * Only atlases that have been stored as OpenGL textures are counted.
+     * This value is used for memory accounting in {@link FontLoader}.
+     *
+     * @return the number of bytes used by the atlas textures.
+     */
+    size_t getAtlasBytes() const;
+
     /**
      * Returns true if the given unicode character has atlas support.
      *
@@ -1390,7 +1447,7 @@ public:
      *
      * @return a set of glyph runs to render the given string
      */
-    std::unordered_map<GLuint, std::shared_ptr<GlyphRun>> getGlyphs(const std::string text, const Vec2 origin);
+    std::unordered_map<GLuint, std::shared_ptr<GlyphRun>> getGlyphs(const std::string& text, const Vec2 origin);
 
     /**
      * Returns a set of glyph runs to render the given (sub)string
@@ -1486,7 +1543,7 @@ public:
      *
      * @return a set of glyph runs to render the given string
      */
-    std::unordered_map<GLuint, std::shared_ptr<GlyphRun>> getGlyphs(const std::string text, const Vec2 origin,
+    std::unordered_map<GLuint, std::shared_ptr<GlyphRun>> getGlyphs(const std::string& text, const Vec2 origin,
                                                                     const Rect rect, float track=0);
 
     /**
@@ -1589,7 +1646,7 @@ public:
      *
      * @return the number of glyphs successfully processed
      */
-    size_t getGlyphs(std::unordered_map<GLuint, std::shared_ptr<GlyphRun>>& runs, const std::string text, const Vec2 origin);
+    size_t getGlyphs(std::unordered_map<GLuint, std::shared_ptr<GlyphRun>>& runs, const std::string& text, const Vec2 origin);
     
     /**
      * Stores the glyph runs to render the given string in the given map
@@ -1749,7 +1806,7 @@ public:
      *
      * @return the number of glyphs successfully processed
      */
-    size_t getGlyphs(std::unordered_map<GLuint, std::shared_ptr<GlyphRun>>& runs, const std::string text,
+    size_t getGlyphs(std::unordered_map<GLuint, std::shared_ptr<GlyphRun>>& runs, const std::string& text,
                      const Vec2 origin, const Rect rect, float track=0);
     
     /**
@@ -1858,7 +1915,7 @@ public:
      *
      * @return a (line) mesh of the quad outlines for the text glyphs
      */
-    Mesh<SpriteVertex2> getGlyphBoxes(const std::string text, const Vec2 origin);
+    Mesh<SpriteVertex2> getGlyphBoxes(const std::string& text, const Vec2 origin);
     
     /**
      * Returns a (line) mesh of the quad outlines for the text glyphs.
@@ -1947,7 +2004,7 @@ public:
      *
      * @return a (line) mesh of the quad outlines for the text glyphs
      */
-    Mesh<SpriteVertex2> getGlyphBoxes(const std::string text, const Vec2 origin,
+    Mesh<SpriteVertex2> getGlyphBoxes(const std::string& text, const Vec2 origin,
                                       const Rect rect, float track=0);
     
     /**
@@ -2033,7 +2090,7 @@ public:
      *
      * @return the number of quads generated
      */
-    size_t getGlyphBoxes(Mesh<SpriteVertex2>& mesh, const std::string text, const Vec2 origin);
+    size_t getGlyphBoxes(Mesh<SpriteVertex2>& mesh, const std::string& text, const Vec2 origin);
     
     /**
      * Stores the quad outlines for the text glyphs in the given mesh.
@@ -2119,7 +2176,7 @@ public:
      *
      * @return the number of quads generated
      */
-    size_t getGlyphBoxes(Mesh<SpriteVertex2>& mesh, const std::string text,
+    size_t getGlyphBoxes(Mesh<SpriteVertex2>& mesh, const std::string& text,
                          const Vec2 origin, const Rect rect, float track=0);
     
     /**
@@ -2235,6 +2292,65 @@ private:
      */
     void gatherKerning(const std::deque<Uint32>& glyphs);
     
+    /**
+     * Rebuilds the direct-indexed glyph tables from the glyph maps.
+     *
+     * The glyph maps are convenient for construction, but a hash look-up per
+     * character (and per pair of characters) dominates text layout. So once
+     * the glyphs are gathered, the metrics of every glyph in the basic
+     * multilingual plane are copied to a table indexed by code point, and
+     * the kerning is copied to a dense matrix. The matrix is omitted if the
+     * character set is too large, in which case kerning uses the map.
+     */
+    void buildTables();
+
+    /**
+     * Returns a pointer to the cached metrics for the given character.
+     *
+     * This method uses the direct-indexed table where possible. It returns
+     * nullptr if the character has not been gathered.
+     *
+     * @param thechar   The Unicode character to look up
+     *
+     * @return a pointer to the cached metrics for the given character.
+     */
+    const Metrics* findMetrics(Uint32 thechar) const {
+        if (thechar < _glyphindex.size() && _glyphindex[thechar]) {
+            return &_glyphtable[_glyphindex[thechar]-1];
+        }
+        auto it = _glyphsize.find(thechar);
+        return it == _glyphsize.end() ? nullptr : &(it->second);
+    }
+
+    /**
+     * Returns the cached kerning between the two characters.
+     *
+     * This method uses the kerning matrix where possible. It returns 0 if
+     * the pair has not been gathered.
+     *
+     * @param a     The first Unicode character in the pair
+     * @param b     The second Unicode character in the pair
+     *
+     * @return the cached kerning between the two characters.
+     */
+    int findKerning(Uint32 a, Uint32 b) const {
+        if (!_kerntable.empty() && a < _glyphindex.size() && b < _glyphindex.size()) {
+            size_t ia = _glyphindex[a];
+            size_t ib = _glyphindex[b];
+            if (ia && ib) {
+                return _kerntable[(ia-1)*_glyphtable.size()+(ib-1)];
+            }
+        }
+        auto it = _kernmap.find(a);
+        if (it != _kernmap.end()) {
+            auto jt = it->second.find(b);
+            if (jt != it->second.end()) {
+                return (int)jt->second;
+            }
+        }
+        return 0;
+    }
+
     /**
      * Returns the metrics for the given character if available.
      *
@@ -0,0 +1,448 @@
+//
+//  CUGLState.h
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides a central cache of the OpenGL state. All of the render
+//  classes (SpriteBatch, Texture, Shader, UniformBuffer, VertexBuffer and
+//  RenderTarget) change the OpenGL state through this module instead of
+//  calling OpenGL directly. That way a change to a value that is already set
+//  (such as rebinding the current texture or resetting the blend function) is
+//  filtered before it reaches the driver. The module counts both the issued
+//  and the filtered calls so that the savings can be measured.
+//
+//  This class is a static class. It cannot be allocated, as there is only one
+//  OpenGL context per application. Because OpenGL is not thread safe, neither
+//  is this class. It should only be used on the main (rendering) thread.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#ifndef __CU_GL_STATE_H__
+#define __CU_GL_STATE_H__
+#include <cugl/base/CUBase.h>
+
+namespace cugl {
+
+/**
+ * This class is a central cache of the OpenGL state.
+ *
+ * Each method of this class wraps the OpenGL function of the same name. If
+ * the cached value shows that the call would not change the OpenGL state,
+ * the call is filtered. Otherwise it is passed to OpenGL and the cache is
+ * updated. The cache covers the current program, the active texture unit,
+ * the 2D texture bound to each unit, the buffer, vertex array and framebuffer
+ * bindings, the viewport, the common capabilities (blending, culling, depth,
+ * stencil and scissor tests), and the blend, mask and stencil functions.
+ * Calls for other targets or capabilities are always passed through.
+ *
+ * All state starts out unknown, so the first call to each method is always
+ * issued. The cache is only correct if all state changes go through this
+ * class. Any code that calls OpenGL directly (such as a third party library)
+ * must call {@link #invalidate} before returning control to CUGL.
+ *
+ * Objects must also be deleted through this class. OpenGL silently unbinds
+ * an object when it is deleted, and its name may be reused by the next
+ * object allocated. Deleting through this class keeps the cache correct.
+ *
+ * The getters of this class return the cached value if it is known. Otherwise
+ * they query OpenGL, which is much slower than the cache. This allows the
+ * render classes to check their binding state without stalling the pipeline.
+ */
+class GLState {
+public:
+#pragma mark Cache Control
+    /**
+     * Marks all of the OpenGL state as unknown.
+     *
+     * This method should be called whenever the OpenGL state is changed
+     * outside of this class. The next call to each method will be issued,
+     * whatever its value. This method does not reset the statistics.
+     */
+    static void invalidate();
+
+    /**
+     * Sets whether redundant state changes are filtered.
+     *
+     * If this value is false, all calls are passed to OpenGL, though the
+     * cache is still updated. This is useful for measuring the effect of the
+     * cache. This value is true by default.
+     *
+     * @param value Whether redundant state changes are filtered
+     */
+    static void setFiltering(bool value);
+
+    /**
+     * Returns true if redundant state changes are filtered.
+     *
+     * If this value is false, all calls are passed to OpenGL, though the
+     * cache is still updated. This is useful for measuring the effect of the
+     * cache. This value is true by default.
+     *
+     * @return true if redundant state changes are filtered.
+     */
+    static bool isFiltering();
+
+#pragma mark -
+#pragma mark Statistics
+    /**
+     * Returns the number of state changes passed to OpenGL.
+     *
+     * This value is cumulative since the last call to {@link #resetStats}.
+     *
+     * @return the number of state changes passed to OpenGL.
+     */
+    static Uint64 getIssued();
+
+    /**
+     * Returns the number of redundant state changes filtered by the cache.
+     *
+     * This value is cumulative since the last call to {@link #resetStats}.
+     *
+     * @return the number of redundant state changes filtered by the cache.
+     */
+    static Uint64 getFiltered();
+
+    /**
+     * Resets the issued and filtered counters to 0.
+     */
+    static void resetStats();
+
+#pragma mark -
+#pragma mark Programs
+    /**
+     * Makes the given program the current shader program.
+     *
+     * @param program   The program to use (0 for none)
+     */
+    static void useProgram(GLuint program);
+
+    /**
+     * Returns the current shader program.
+     *
+     * @return the current shader program.
+     */
+    static GLuint getProgram();
+
+#pragma mark -
+#pragma mark Textures
+    /**
+     * Sets the active texture unit.
+     *
+     * The unit should be an offset from GL_TEXTURE0, as in OpenGL.
+     *
+     * @param unit  The active texture unit
+     */
+    static void activeTexture(GLenum unit);
+
+    /**
+     * Returns the active texture unit.
+     *
+     * The unit is an offset from GL_TEXTURE0, as in OpenGL.
+     *
+     * @return the active texture unit.
+     */
+    static GLenum getActiveTexture();
+
+    /**
+     * Binds the texture to the given target of the active texture unit.
+     *
+     * Only GL_TEXTURE_2D is cached. Other targets are always issued.
+     *
+     * @param target    The texture target
+     * @param texture   The texture to bind (0 for none)
+     */
+    static void bindTexture(GLenum target, GLuint texture);
+
+    /**
+     * Returns the 2D texture bound to the given texture unit.
+     *
+     * The unit should be an offset from GL_TEXTURE0, as in OpenGL. This
+     * method does not change the active texture unit.
+     *
+     * @param unit  The texture unit
+     *
+     * @return the 2D texture bound to the given texture unit.
+     */
+    static GLuint getTexture(GLenum unit);
+
+    /**
+     * Deletes the given texture, removing it from the cache.
+     *
+     * @param texture   The texture to delete
+     */
+    static void deleteTexture(GLuint texture);
+
+#pragma mark -
+#pragma mark Buffers
+    /**
+     * Binds the buffer to the given target.
+     *
+     * Only GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER, and GL_UNIFORM_BUFFER
+     * are cached. Other targets are always issued. As in OpenGL, the element
+     * array buffer is part of the state of the current vertex array.
+     *
+     * @param target    The buffer target
+     * @param buffer    The buffer to bind (0 for none)
+     */
+    static void bindBuffer(GLenum target, GLuint buffer);
+
+    /**
+     * Returns the buffer bound to the given target.
+     *
+     * @param target    The buffer target
+     *
+     * @return the buffer bound to the given target.
+     */
+    static GLuint getBuffer(GLenum target);
+
+    /**
+     * Binds the buffer to the given index of an indexed target.
+     *
+     * Only GL_UNIFORM_BUFFER is cached. Other targets are always issued. If
+     * the call is issued, OpenGL also binds the buffer to the generic target.
+     * As a filtered call does not, code should not rely on this side effect.
+     *
+     * @param target    The indexed buffer target
+     * @param index     The binding index
+     * @param buffer    The buffer to bind (0 for none)
+     */
+    static void bindBufferBase(GLenum target, GLuint index, GLuint buffer);
+
+    /**
+     * Binds a range of the buffer to the given index of an indexed target.
+     *
+     * Only GL_UNIFORM_BUFFER is cached. Other targets are always issued. If
+     * the call is issued, OpenGL also binds the buffer to the generic target.
+     * As a filtered call does not, code should not rely on this side effect.
+     *
+     * @param target    The indexed buffer target
+     * @param index     The binding index
+     * @param buffer    The buffer to bind
+     * @param offset    The start of the range in bytes
+     * @param size      The size of the range in bytes
+     */
+    static void bindBufferRange(GLenum target, GLuint index, GLuint buffer,
+                                GLintptr offset, GLsizeiptr size);
+
+    /**
+     * Returns the buffer bound to the given index of an indexed target.
+     *
+     * @param target    The indexed buffer target
+     * @param index     The binding index
+     *
+     * @return the buffer bound to the given index of an indexed target.
+     */
+    static GLuint getBufferBase(GLenum target, GLuint index);
+
+    /**
+     * Deletes the given buffer, removing it from the cache.
+     *
+     * @param buffer    The buffer to delete
+     */
+    static void deleteBuffer(GLuint buffer);
+
+    /**
+     * Binds the given vertex array.
+     *
+     * @param array The vertex array to bind (0 for none)
+     */
+    static void bindVertexArray(GLuint array);
+
+    /**
+     * Returns the currently bound vertex array.
+     *
+     * @return the currently bound vertex array.
+     */
+    static GLuint getVertexArray();
+
+    /**
+     * Deletes the given vertex array, removing it from the cache.
+     *
+     * @param array The vertex array to delete
+     */
+    static void deleteVertexArray(GLuint array);
+
+#pragma mark -
+#pragma mark Framebuffers
+    /**
+     * Binds the framebuffer to the given target.
+     *
+     * The target GL_FRAMEBUFFER binds both the draw and the read framebuffer.
+     *
+     * @param target        The framebuffer target
+     * @param framebuffer   The framebuffer to bind
+     */
+    static void bindFramebuffer(GLenum target, GLuint framebuffer);
+
+    /**
+     * Returns the framebuffer bound to the given target.
+     *
+     * The target GL_FRAMEBUFFER is the same as GL_DRAW_FRAMEBUFFER.
+     *
+     * @param target    The framebuffer target
+     *
+     * @return the framebuffer bound to the given target.
+     */
+    static GLuint getFramebuffer(GLenum target);
+
+    /**
+     * Deletes the given framebuffer, removing it from the cache.
+     *
+     * @param framebuffer   The framebuffer to delete
+     */
+    static void deleteFramebuffer(GLuint framebuffer);
+
+    /**
+     * Sets the OpenGL viewport.
+     *
+     * @param x         The left edge of the viewport
+     * @param y         The bottom edge of the viewport
+     * @param width     The viewport width
+     * @param height    The viewport height
+     */
+    static void viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+    /**
+     * Stores the current viewport in the given array.
+     *
+     * The array must have room for four values: x, y, width, and height.
+     *
+     * @param viewport  The array to store the viewport
+     */
+    static void getViewport(GLint* viewport);
+
+#pragma mark -
+#pragma mark Capabilities
+    /**
+     * Enables the given capability.
+     *
+     * Only GL_BLEND, GL_CULL_FACE, GL_DEPTH_TEST, GL_STENCIL_TEST, and
+     * GL_SCISSOR_TEST are cached. Other capabilities are always issued.
+     *
+     * @param cap   The capability to enable
+     */
+    static void enable(GLenum cap);
+
+    /**
+     * Disables the given capability.
+     *
+     * Only GL_BLEND, GL_CULL_FACE, GL_DEPTH_TEST, GL_STENCIL_TEST, and
+     * GL_SCISSOR_TEST are cached. Other capabilities are always issued.
+     *
+     * @param cap   The capability to disable
+     */
+    static void disable(GLenum cap);
+
+    /**
+     * Returns true if the given capability is enabled.
+     *
+     * @param cap   The capability to query
+     *
+     * @return true if the given capability is enabled.
+     */
+    static bool isEnabled(GLenum cap);
+
+    /**
+     * Sets whether the depth buffer is writable.
+     *
+     * @param flag  Whether the depth buffer is writable
+     */
+    static void depthMask(GLboolean flag);
+
+    /**
+     * Sets which color components are writable.
+     *
+     * @param red       Whether the red component is writable
+     * @param green     Whether the green component is writable
+     * @param blue      Whether the blue component is writable
+     * @param alpha     Whether the alpha component is writable
+     */
+    static void colorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha);
+
+#pragma mark -
+#pragma mark Blending
+    /**
+     * Sets the blend equation for both the RGB and alpha components.
+     *
+     * @param mode  The blend equation
+     */
+    static void blendEquation(GLenum mode);
+
+    /**
+     * Sets the blend function for both the RGB and alpha components.
+     *
+     * @param sfactor   The source blend factor
+     * @param dfactor   The destination blend factor
+     */
+    static void blendFunc(GLenum sfactor, GLenum dfactor);
+
+    /**
+     * Sets the blend function separately for the RGB and alpha components.
+     *
+     * @param srcRGB    The source RGB blend factor
+     * @param dstRGB    The destination RGB blend factor
+     * @param srcAlpha  The source alpha blend factor
+     * @param dstAlpha  The destination alpha blend factor
+     */
+    static void blendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha);
+
+#pragma mark -
+#pragma mark Stencils
+    /**
+     * Sets the stencil write mask for both front and back faces.
+     *
+     * @param mask  The stencil write mask
+     */
+    static void stencilMask(GLuint mask);
+
+    /**
+     * Sets the stencil test function for both front and back faces.
+     *
+     * @param func  The stencil test function
+     * @param ref   The stencil reference value
+     * @param mask  The stencil test mask
+     */
+    static void stencilFunc(GLenum func, GLint ref, GLuint mask);
+
+    /**
+     * Sets the stencil operations for both front and back faces.
+     *
+     * @param sfail     The operation when the stencil test fails
+     * @param dpfail    The operation when the depth test fails
+     * @param dppass    The operation when both tests pass
+     */
+    static void stencilOp(GLenum sfail, GLenum dpfail, GLenum dppass);
+
+    /**
+     * Sets the stencil operations for the given face(s).
+     *
+     * @param face      The face (GL_FRONT, GL_BACK, or GL_FRONT_AND_BACK)
+     * @param sfail     The operation when the stencil test fails
+     * @param dpfail    The operation when the depth test fails
+     * @param dppass    The operation when both tests pass
+     */
+    static void stencilOpSeparate(GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass);
+};
+
+}
+
+#endif /* __CU_GL_STATE_H__ */
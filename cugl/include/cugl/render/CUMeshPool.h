@@ -0,0 +1,161 @@
+//
+//  CUMeshPool.h
+//  Cornell University Game Library (CUGL)
+//
+//  This template provides a pool of recycled meshes. Meshes that are created
+//  and discarded every frame (such as glyph runs or extruded paths) allocate
+//  their vertex and index buffers every frame. A mesh pool keeps discarded
+//  meshes, so that the next mesh requested reuses their buffers. As the
+//  buffers keep their capacity, a steady-state scene stops allocating once
+//  the pool is warm.
+//
+//  Like Mesh, this is a template because the vertex data varies from shader
+//  to shader. It is a value class and does not use the shared-pointer
+//  architecture. It is not thread safe.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#ifndef __CU_MESH_POOL_H__
+#define __CU_MESH_POOL_H__
+#include <vector>
+#include <cugl/render/CUMesh.h>
+
+/** The default number of meshes retained by a mesh pool */
+#define DEFAULT_MESH_POOL   32
+
+namespace cugl {
+
+/**
+ * This class is a pool of recycled meshes.
+ *
+ * A mesh is taken from the pool with {@link #acquire} and returned to it with
+ * {@link #recycle}. Both transfer the mesh by move, so no vertex data is ever
+ * copied. A recycled mesh is cleared, but its vertex and index buffers keep
+ * their capacity. The next acquired mesh therefore only allocates if it is
+ * larger than any mesh recycled so far.
+ *
+ * The pool retains at most {@link #getCapacity} meshes. Any mesh recycled
+ * to a full pool (or without any storage to reuse) is simply discarded.
+ */
+template <typename T>
+class MeshPool {
+private:
+    /** The recycled meshes */
+    std::vector<Mesh<T>> _meshes;
+    /** The maximum number of meshes retained */
+    size_t _capacity;
+
+public:
+    /**
+     * Creates a mesh pool with the given capacity.
+     *
+     * The capacity is the maximum number of meshes retained by the pool.
+     *
+     * @param capacity  The maximum number of meshes retained
+     */
+    MeshPool(size_t capacity=DEFAULT_MESH_POOL) : _capacity(capacity) {
+        _meshes.reserve(capacity);
+    }
+
+    /**
+     * Returns a mesh from this pool with the given command.
+     *
+     * The mesh is empty, but it reuses the buffers of a recycled mesh when
+     * one is available. Otherwise it is a new mesh.
+     *
+     * @param command   The drawing command of the mesh
+     *
+     * @return a mesh from this pool with the given command.
+     */
+    Mesh<T> acquire(GLenum command=GL_TRIANGLES) {
+        if (_meshes.empty()) {
+            Mesh<T> result;
+            result.command = command;
+            return result;
+        }
+        Mesh<T> result(std::move(_meshes.back()));
+        _meshes.pop_back();
+        result.command = command;
+        return result;
+    }
+
+    /**
+     * Returns the given mesh to this pool.
+     *
+     * The mesh is cleared, but its buffers keep their capacity. It is unsafe
+     * to use the original mesh after this method is called.
+     *
+     * @param mesh  The mesh to recycle
+     */
+    void recycle(Mesh<T>&& mesh) {
+        if (_meshes.size() >= _capacity ||
+            (mesh.vertices.capacity() == 0 && mesh.indices.capacity() == 0)) {
+            return;
+        }
+        mesh.clear();
+        _meshes.push_back(std::move(mesh));
+    }
+
+    /**
+     * Returns the number of meshes available in this pool.
+     *
+     * @return the number of meshes available in this pool.
+     */
+    size_t available() const { return _meshes.size(); }
+
+    /**
+     * Returns the maximum number of meshes retained by this pool.
+     *
+     * @return the maximum number of meshes retained by this pool.
+     */
+    size_t getCapacity() const { return _capacity; }
+
+    /**
+     * Sets the maximum number of meshes retained by this pool.
+     *
+     * If the pool has more meshes than the new capacity, the excess meshes
+     * are released.
+     *
+     * @param capacity  The maximum number of meshes retained
+     */
+    void setCapacity(size_t capacity) {
+        _capacity = capacity;
+        if (_meshes.size() > capacity) {
+            _meshes.resize(capacity);
+        }
+        _meshes.reserve(capacity);
+    }
+
+    /**
+     * Releases all of the meshes in this pool.
+     *
+     * The capacity is unchanged.
+     */
+    void clear() {
+        _meshes.clear();
+    }
+};
+
+}
+
+#endif /* __CU_MESH_POOL_H__ */
@@ -104,6 +104,12 @@ namespace cugl {
  * pushed into the vertex data itself.  For example, it is faster to transform quads 
  * in the CPU than it is in the GPU.
  *
+ * To keep uniform costs down, the active uniforms are reflected when the shader
+ * is linked, so looking up a uniform by name never queries the driver. Every
+ * setter also compares the new value to the last value sent, and skips the
+ * OpenGL call if it is unchanged. Code that sets the same uniforms every frame
+ * should resolve a {@link UniformHandle} once and use the handle setters.
+ *
  * Because of the limitations of OpenGLES, this class only supports vertex and 
  * fragment shaders -- it does not support tesselation or geometry shaders.  
  * Furthermore, keep in mind that Apple has deprecated OpenGL. MacOS devices are 
@@ -118,6 +124,65 @@ namespace cugl {
  * query methods.
  */
 class Shader {
+public:
+    /**
+     * This class is the reflection of a single active uniform.
+     *
+     * Uniforms are reflected when the shader is linked, and stored in a flat
+     * table. The position of a uniform in this table is its slot. Uniforms
+     * in a uniform block have no location, and are set with a
+     * {@link UniformBuffer} instead.
+     */
+    class Uniform {
+    public:
+        /** The uniform variable name (arrays are reported as "name[0]") */
+        std::string name;
+        /** The uniform type (GL_FLOAT_VEC4, GL_SAMPLER_2D, etc.) */
+        GLenum type;
+        /** The number of array elements (1 for a non-array uniform) */
+        GLint size;
+        /** The program location (-1 for uniforms in a block) */
+        GLint location;
+        /** The uniform block index (-1 for uniforms not in a block) */
+        GLint block;
+        /** The byte offset of the shadow value (if any) */
+        size_t offset;
+        /** The size of the shadow value in bytes (0 if not shadowed) */
+        size_t bytes;
+    };
+    
+    /**
+     * This class is a precomputed reference to a uniform.
+     *
+     * A handle is resolved once with {@link Shader#getUniformHandle}, and can
+     * then be passed to the handle setters of the same shader. Those setters
+     * skip both the name lookup and the location lookup of the shadow cache.
+     * A handle for a uniform that is not active in the shader is invalid, and
+     * any attempt to set it is ignored.
+     *
+     * Handles are specific to a shader program, and become stale if the
+     * shader is disposed.
+     */
+    class UniformHandle {
+    public:
+        /** The program location of the uniform */
+        GLint location;
+        /** The slot of the uniform in the reflection table */
+        GLint slot;
+        
+        /**
+         * Creates an invalid handle
+         */
+        UniformHandle() : location(-1), slot(-1) {}
+        
+        /**
+         * Returns true if this handle refers to an active uniform.
+         *
+         * @return true if this handle refers to an active uniform.
+         */
+        bool isValid() const { return location >= 0; }
+    };
+
 #pragma mark Values
 protected:
     /** The OpenGL program for this shader */
@@ -148,6 +213,20 @@ protected:
     std::unordered_map<std::string, GLint>  _uniblocksizes;
     /** Mappings of uniforms to a uniform block */
     std::unordered_map<GLint, GLint>        _uniblockfields;
+    /** The reflected uniforms of this shader, indexed by slot */
+    std::vector<Uniform> _uniformtable;
+    /** The slots of the uniforms, keyed by name */
+    std::unordered_map<std::string, GLint> _uniformslots;
+    /** The slots of the uniforms, keyed by location */
+    std::unordered_map<GLint, GLint>        _locationslots;
+    /** The last value sent to each shadowed uniform */
+    std::vector<Uint8> _shadow;
+    /** Whether the shadow value of each slot is valid */
+    std::vector<bool>  _shadowed;
+    /** The number of uniform values sent to OpenGL */
+    Uint64 _uniformsent;
+    /** The number of uniform values skipped as unchanged */
+    Uint64 _uniformskip;
 
     
 #pragma mark -
@@ -204,10 +283,44 @@ private:
     /**
      * Querys all of the shader uniforms and caches them for fast look-ups
      *
-     * This includes uniform buffer blocks as well.
+     * This includes uniform buffer blocks as well. It also builds the
+     * reflection table and the shadow cache.
      */
     void cacheUniforms();
     
+    /**
+     * Returns true if the value of the given slot must be sent to OpenGL.
+     *
+     * If the slot is shadowed and its last value is the same as data, this
+     * method returns false. Otherwise it records data as the new shadow value
+     * and returns true. If cache is false, the shadow value is invalidated
+     * instead (this is the case for transposed matrices).
+     *
+     * @param slot  The uniform slot
+     * @param data  The uniform value
+     * @param size  The size of the uniform value in bytes
+     * @param cache Whether the value may be cached
+     *
+     * @return true if the value of the given slot must be sent to OpenGL.
+     */
+    bool updateSlot(GLint slot, const void* data, size_t size, bool cache=true);
+    
+    /**
+     * Returns true if the value of the given location must be sent to OpenGL.
+     *
+     * This method is the same as {@link #updateSlot}, except that it looks up
+     * the slot of the location first. Locations that are not in the reflection
+     * table (such as array elements) are always sent.
+     *
+     * @param pos   The uniform location
+     * @param data  The uniform value
+     * @param size  The size of the uniform value in bytes
+     * @param cache Whether the value may be cached
+     *
+     * @return true if the value of the given location must be sent to OpenGL.
+     */
+    bool updateShadow(GLint pos, const void* data, size_t size, bool cache=true);
+    
     
 #pragma mark -
 #pragma mark Constructors
@@ -217,7 +330,8 @@ public:
      *
      * You must initialize the shader to add a source and compile it.
      */
-    Shader() :  _program(0), _vertShader(0), _fragShader(0) {};
+    Shader() :  _program(0), _vertShader(0), _fragShader(0),
+    _uniformsent(0), _uniformskip(0) {};
 
     /**
      * Deletes this shader, disposing all resources.
@@ -349,7 +463,7 @@ public:
      *
      * @return the program offset of the given attribute
      */
-    GLint getAttributeLocation(const std::string name) const;
+    GLint getAttributeLocation(const std::string& name) const;
     
     /**
      * Returns the size (in bytes) of the given attribute
@@ -360,7 +474,7 @@ public:
      *
      * @return the size (in bytes) of the given attribute
      */
-    GLint getAttributeSize(const std::string name) const;
+    GLint getAttributeSize(const std::string& name) const;
 
     /**
      * Returns the type of the given attribute
@@ -371,7 +485,7 @@ public:
      *
      * @return the type of the given attribute
      */
-    GLenum getAttributeType(const std::string name) const;
+    GLenum getAttributeType(const std::string& name) const;
 
     /**
      * Returns the program offset of the given output variable.
@@ -394,7 +508,7 @@ public:
      *
      * @return the program offset of the given output variable.
      */
-    GLint getOutputLocation(const std::string name) const;
+    GLint getOutputLocation(const std::string& name) const;
 
     
 #pragma mark -
@@ -415,7 +529,7 @@ public:
      *
      * @return the program offset of the given uniform
      */
-    GLint getUniformLocation(const std::string name) const;
+    GLint getUniformLocation(const std::string& name) const;
 
     /**
      * Returns the size (in bytes) of the given uniform
@@ -426,7 +540,7 @@ public:
      *
      * @return the size (in bytes) of the given uniform
      */
-    GLint getUniformSize(const std::string name) const;
+    GLint getUniformSize(const std::string& name) const;
 
     /**
      * Returns the type of the given uniform
@@ -437,8 +551,69 @@ public:
      *
      * @return the type of the given uniform
      */
-    GLenum getUniformType(const std::string name) const;
+    GLenum getUniformType(const std::string& name) const;
 
+    /**
+     * Returns the reflection table of the active uniforms.
+     *
+     * The table is built when the shader is linked. The position of each
+     * uniform in this table is its slot.
+     *
+     * @return the reflection table of the active uniforms.
+     */
+    const std::vector<Uniform>& getUniformTable() const { return _uniformtable; }
+    
+    /**
+     * Returns a handle for the given uniform.
+     *
+     * The handle should be resolved once (such as when the shader is attached)
+     * and then used with the handle setters. If name is not an active uniform
+     * with a location, the handle is invalid.
+     *
+     * @param name  The uniform variable name
+     *
+     * @return a handle for the given uniform.
+     */
+    UniformHandle getUniformHandle(const std::string& name) const;
+    
+#pragma mark -
+#pragma mark Shadow Cache
+    /**
+     * Invalidates the shadow values of all uniforms.
+     *
+     * Every uniform setter compares the new value with the last value sent,
+     * and skips the OpenGL call if it is unchanged. Uniform values belong to
+     * the program, so this cache is correct as long as all uniforms are set
+     * through this class. Call this method if the program uniforms are ever
+     * modified with raw OpenGL calls.
+     */
+    void invalidateUniforms();
+    
+    /**
+     * Returns the number of uniform values sent to OpenGL.
+     *
+     * This count is for diagnostics, and may be reset with
+     * {@link #resetUniformStats}.
+     *
+     * @return the number of uniform values sent to OpenGL.
+     */
+    Uint64 getUniformsSent() const { return _uniformsent; }
+    
+    /**
+     * Returns the number of uniform values skipped by the shadow cache.
+     *
+     * This count is for diagnostics, and may be reset with
+     * {@link #resetUniformStats}.
+     *
+     * @return the number of uniform values skipped by the shadow cache.
+     */
+    Uint64 getUniformsSkipped() const { return _uniformskip; }
+    
+    /**
+     * Resets the uniform call statistics to zero.
+     */
+    void resetUniformStats() { _uniformsent = 0; _uniformskip = 0; }
+    
     
 #pragma mark -
 #pragma mark Sampler Properties
@@ -466,7 +641,7 @@ public:
      *
      * @return the program offset of the given sampler variable
      */
-    GLint getSamplerLocation(const std::string name) const;
+    GLint getSamplerLocation(const std::string& name) const;
 
     /**
      * Sets the given sampler variable to a texture bindpoint.
@@ -502,7 +677,7 @@ public:
      * @param name      The name of the sampler variable
      * @param bpoint   The bindpoint for the sampler
      */
-    void setSampler(const std::string name, GLuint bpoint);
+    void setSampler(const std::string& name, GLuint bpoint);
 
     /**
      * Sets the given sampler variable to the bindpoint of the given texture.
@@ -534,7 +709,7 @@ public:
      * @param name      The name of the sampler variable
      * @param texture   The texture to initialize the bindpoint
      */
-    void setSampler(const std::string name, const std::shared_ptr<Texture>& texture);
+    void setSampler(const std::string& name, const std::shared_ptr<Texture>& texture);
     
     /**
      * Returns the texture bindpoint associated with the given sampler variable.
@@ -560,7 +735,7 @@ public:
      *
      * @return the texture bindpoint associated with the given sampler variable.
      */
-    GLuint getSampler(const std::string name) const;
+    GLuint getSampler(const std::string& name) const;
     
     
 #pragma mark -
@@ -639,7 +814,7 @@ public:
      * @param name      The name of the uniform block in the shader
      * @param bpoint   The bindpoint for the uniform block
      */
-    void setUniformBlock(const std::string name, GLuint bpoint);
+    void setUniformBlock(const std::string& name, GLuint bpoint);
 
     /**
      * Sets the given uniform block variable to the bindpoint of the given uniform buffer.
@@ -679,7 +854,7 @@ public:
      * @param name      The name of the uniform block in the shader
      * @param buffer    The buffer to bind to this uniform block
      */
-    void setUniformBlock(const std::string name,
+    void setUniformBlock(const std::string& name,
                          const std::shared_ptr<UniformBuffer>& buffer);
 
     /**
@@ -706,7 +881,7 @@ public:
      *
      * @return the buffer bindpoint associated with the given uniform block.
      */
-    GLuint getUniformBlock(const std::string name) const;
+    GLuint getUniformBlock(const std::string& name) const;
 
     
 #pragma mark -
@@ -729,7 +904,7 @@ public:
      * @param name  The name of the uniform
      * @param vec   The value for the uniform
      */
-    void setUniformVec2(const std::string name, const Vec2 vec);
+    void setUniformVec2(const std::string& name, const Vec2 vec);
 
     /**
      * Returns true if it can access the given uniform as a vector.
@@ -755,7 +930,7 @@ public:
      *
      * @return true if it can access the given uniform as a vector.
      */
-    bool getUniformVec2(const std::string name, Vec2& vec) const;
+    bool getUniformVec2(const std::string& name, Vec2& vec) const;
     
     /**
      * Sets the given uniform to a vector value.
@@ -775,7 +950,7 @@ public:
      * @param name  The name of the uniform
      * @param vec   The value for the uniform
      */
-    void setUniformVec3(const std::string name, const Vec3 vec);
+    void setUniformVec3(const std::string& name, const Vec3 vec);
 
     /**
      * Returns true if it can access the given uniform as a vector.
@@ -801,7 +976,7 @@ public:
      *
      * @return true if it can access the given uniform as a vector.
      */
-    bool getUniformVec3(const std::string name, Vec3& vec) const;
+    bool getUniformVec3(const std::string& name, Vec3& vec) const;
 
     /**
      * Sets the given uniform to a vector value.
@@ -821,7 +996,7 @@ public:
      * @param name  The name of the uniform
      * @param vec   The value for the uniform
      */
-    void setUniformVec4(const std::string name, const Vec4 vec);
+    void setUniformVec4(const std::string& name, const Vec4 vec);
 
     /**
      * Returns true if it can access the given uniform as a vector.
@@ -847,7 +1022,7 @@ public:
      *
      * @return true if it can access the given uniform as a vector.
      */
-    bool getUniformVec4(const std::string name, Vec4& vec) const;
+    bool getUniformVec4(const std::string& name, Vec4& vec) const;
 
     /**
      * Sets the given uniform to a color value.
@@ -867,7 +1042,7 @@ public:
      * @param name  The name of the uniform
      * @param color The value for the uniform
      */
-    void setUniformColor4(const std::string name, const Color4 color);
+    void setUniformColor4(const std::string& name, const Color4 color);
 
     /**
      * Returns true if it can access the given uniform as a color.
@@ -893,7 +1068,7 @@ public:
      *
      * @return true if it can access the given uniform as a color.
      */
-    bool getUniformColor4(const std::string name, Color4& color) const;
+    bool getUniformColor4(const std::string& name, Color4& color) const;
 
     /**
      * Sets the given uniform to a color value.
@@ -913,7 +1088,7 @@ public:
      * @param name  The name of the uniform
      * @param color The value for the uniform
      */
-    void setUniformColor4f(const std::string name, const Color4f color);
+    void setUniformColor4f(const std::string& name, const Color4f color);
 
     /**
      * Returns true if it can access the given uniform as a color.
@@ -939,7 +1114,7 @@ public:
      *
      * @return true if it can access the given uniform as a color.
      */
-    bool getUniformColor4f(const std::string name, Color4f& color) const;
+    bool getUniformColor4f(const std::string& name, Color4f& color) const;
 
     /**
      * Sets the given uniform to a matrix value.
@@ -961,7 +1136,7 @@ public:
      * @param name  The name of the uniform
      * @param mat   The value for the uniform
      */
-    void setUniformMat4(const std::string name, const Mat4& mat);
+    void setUniformMat4(const std::string& name, const Mat4& mat);
 
     /**
      * Returns true if it can access the given uniform as a matrix.
@@ -987,7 +1162,7 @@ public:
      *
      * @return true if it can access the given uniform as a matrix.
      */
-    bool getUniformMat4(const std::string name, Mat4& mat) const;
+    bool getUniformMat4(const std::string& name, Mat4& mat) const;
 
     /**
      * Sets the given uniform to an affine transform.
@@ -1013,7 +1188,7 @@ public:
      * @param name  The name of the uniform
      * @param mat   The value for the uniform
      */
-    void setUniformAffine2(const std::string name, const Affine2& mat);
+    void setUniformAffine2(const std::string& name, const Affine2& mat);
 
     /**
      * Returns true if it can access the given uniform as an affine transform.
@@ -1041,7 +1216,7 @@ public:
      *
      * @return true if it can access the given uniform as an affine transform.
      */
-    bool getUniformAffine2(const std::string name, Affine2& mat) const;
+    bool getUniformAffine2(const std::string& name, Affine2& mat) const;
 
     /**
      * Sets the given uniform to a quaternion.
@@ -1061,7 +1236,7 @@ public:
      * @param name  The name of the uniform
      * @param quat  The value for the uniform
      */
-    void setUniformQuaternion(const std::string name, const Quaternion& quat);
+    void setUniformQuaternion(const std::string& name, const Quaternion& quat);
 
     /**
      * Returns true if it can access the given uniform as a quaternion.
@@ -1087,7 +1262,7 @@ public:
      *
      * @return true if it can access the given uniform as a quaternion.
      */
-    bool getUniformQuaternion(const std::string name, Quaternion& quat) const;
+    bool getUniformQuaternion(const std::string& name, Quaternion& quat) const;
 
 
 #pragma mark -
@@ -1112,7 +1287,7 @@ public:
      * @param name  The name of the uniform
      * @param v0    The value for the uniform
      */
-    void setUniform1f(const std::string name, GLfloat v0);
+    void setUniform1f(const std::string& name, GLfloat v0);
 
     /**
      * Sets the given uniform to a pair of float values.
@@ -1136,7 +1311,7 @@ public:
      * @param v0    The first value for the uniform
      * @param v1    The second value for the uniform
      */
-    void setUniform2f(const std::string name, GLfloat v0, GLfloat v1);
+    void setUniform2f(const std::string& name, GLfloat v0, GLfloat v1);
 
     /**
      * Sets the given uniform to a trio of float values.
@@ -1162,7 +1337,7 @@ public:
      * @param v1    The second value for the uniform
      * @param v2    The third value for the uniform
      */
-    void setUniform3f(const std::string name, GLfloat v0, GLfloat v1, GLfloat v2);
+    void setUniform3f(const std::string& name, GLfloat v0, GLfloat v1, GLfloat v2);
 
     /**
      * Sets the given uniform to a quartet of float values.
@@ -1190,7 +1365,7 @@ public:
      * @param v2    The third value for the uniform
      * @param v3    The fourth value for the uniform
      */
-    void setUniform4f(const std::string name, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3);
+    void setUniform4f(const std::string& name, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3);
 
     /**
      * Sets the given uniform to a single int value.
@@ -1212,7 +1387,7 @@ public:
      * @param name  The name of the uniform
      * @param v0    The value for the uniform
      */
-    void setUniform1i(const std::string name, GLint v0);
+    void setUniform1i(const std::string& name, GLint v0);
 
     /**
      * Sets the given uniform to a pair of int values.
@@ -1236,7 +1411,7 @@ public:
      * @param v0    The first value for the uniform
      * @param v1    The second value for the uniform
      */
-    void setUniform2i(const std::string name, GLint v0, GLint v1);
+    void setUniform2i(const std::string& name, GLint v0, GLint v1);
 
     /**
      * Sets the given uniform to a trio of int values.
@@ -1262,7 +1437,7 @@ public:
      * @param v1    The second value for the uniform
      * @param v2    The third value for the uniform
      */
-    void setUniform3i(const std::string name, GLint v0, GLint v1, GLint v2);
+    void setUniform3i(const std::string& name, GLint v0, GLint v1, GLint v2);
 
     /**
      * Sets the given uniform to a quartet of int values.
@@ -1290,7 +1465,7 @@ public:
      * @param v2    The third value for the uniform
      * @param v3    The fourth value for the uniform
      */
-    void setUniform4i(const std::string name, GLint v0, GLint v1, GLint v2, GLint v3);
+    void setUniform4i(const std::string& name, GLint v0, GLint v1, GLint v2, GLint v3);
 
     /**
      * Sets the given uniform to a single unsigned value.
@@ -1312,7 +1487,7 @@ public:
      * @param name  The name of the uniform
      * @param v0    The value for the uniform
      */
-    void setUniform1ui(const std::string name, GLuint v0);
+    void setUniform1ui(const std::string& name, GLuint v0);
 
     /**
      * Sets the given uniform to a pair of unsigned values.
@@ -1336,7 +1511,7 @@ public:
      * @param v0    The first value for the uniform
      * @param v1    The second value for the uniform
      */
-    void setUniform2ui(const std::string name, GLuint v0, GLuint v1);
+    void setUniform2ui(const std::string& name, GLuint v0, GLuint v1);
 
     /**
      * Sets the given uniform to a trio of unsigned values.
@@ -1362,7 +1537,7 @@ public:
      * @param v1    The second value for the uniform
      * @param v2    The third value for the uniform
      */
-    void setUniform3ui(const std::string name, GLuint v0, GLuint v1, GLuint v2);
+    void setUniform3ui(const std::string& name, GLuint v0, GLuint v1, GLuint v2);
 
     /**
      * Sets the given uniform to a quartet of unsigned values.
@@ -1390,7 +1565,7 @@ public:
      * @param v2    The third value for the uniform
      * @param v3    The fourth value for the uniform
      */
-    void setUniform4ui(const std::string name, GLuint v0, GLuint v1, GLuint v2, GLuint v3);
+    void setUniform4ui(const std::string& name, GLuint v0, GLuint v1, GLuint v2, GLuint v3);
 
     /**
      * Sets the given uniform to an array of 1-element floats.
@@ -1414,7 +1589,7 @@ public:
      * @param count The number of elements in the array
      * @param value The array of floats
      */
-    void setUniform1fv(const std::string name, GLsizei count, const GLfloat *value);
+    void setUniform1fv(const std::string& name, GLsizei count, const GLfloat *value);
 
     /**
      * Sets the given uniform to an array of 2-element floats.
@@ -1438,7 +1613,7 @@ public:
      * @param count The number of elements in the array
      * @param value The array of floats
      */
-    void setUniform2fv(const std::string name, GLsizei count, const GLfloat *value);
+    void setUniform2fv(const std::string& name, GLsizei count, const GLfloat *value);
 
     /**
      * Sets the given uniform to an array of 3-element floats.
@@ -1462,7 +1637,7 @@ public:
      * @param count The number of elements in the array
      * @param value The array of floats
      */
-    void setUniform3fv(const std::string name, GLsizei count, const GLfloat *value);
+    void setUniform3fv(const std::string& name, GLsizei count, const GLfloat *value);
 
     /**
      * Sets the given uniform to an array of 4-element floats.
@@ -1486,7 +1661,7 @@ public:
      * @param count The number of elements in the array
      * @param value The array of floats
      */
-    void setUniform4fv(const std::string name, GLsizei count, const GLfloat *value);
+    void setUniform4fv(const std::string& name, GLsizei count, const GLfloat *value);
 
     /**
      * Sets the given uniform to an array of 1-element ints.
@@ -1510,7 +1685,7 @@ public:
      * @param count The number of elements in the array
      * @param value The array of ints
      */
-    void setUniform1iv(const std::string name, GLsizei count, const GLint *value);
+    void setUniform1iv(const std::string& name, GLsizei count, const GLint *value);
 
     /**
      * Sets the given uniform to an array of 2-element ints.
@@ -1534,7 +1709,7 @@ public:
      * @param count The number of elements in the array
      * @param value The array of ints
      */
-    void setUniform2iv(const std::string name, GLsizei count, const GLint *value);
+    void setUniform2iv(const std::string& name, GLsizei count, const GLint *value);
 
     
     /**
@@ -1557,7 +1732,7 @@ public:
      * @param count The number of elements in the array
      * @param value The array of ints
      */
-    void setUniform3iv(const std::string name, GLsizei count, const GLint *value);
+    void setUniform3iv(const std::string& name, GLsizei count, const GLint *value);
 
     /**
      * Sets the given uniform to an array of 4-element ints.
@@ -1581,7 +1756,7 @@ public:
      * @param count The number of elements in the array
      * @param value The array of ints
      */
-    void setUniform4iv(const std::string name, GLsizei count, const GLint *value);
+    void setUniform4iv(const std::string& name, GLsizei count, const GLint *value);
 
     /**
      * Sets the given uniform to an array of 1-element unsigned ints.
@@ -1605,7 +1780,7 @@ public:
      * @param count The number of elements in the array
      * @param value The array of unsigned ints
      */
-    void setUniform1uiv(const std::string name, GLsizei count, const GLuint *value);
+    void setUniform1uiv(const std::string& name, GLsizei count, const GLuint *value);
 
     /**
      * Sets the given uniform to an array of 2-element unsigned ints.
@@ -1629,7 +1804,7 @@ public:
      * @param count The number of elements in the array
      * @param value The array of unsigned ints
      */
-    void setUniform2uiv(const std::string name, GLsizei count, const GLuint *value);
+    void setUniform2uiv(const std::string& name, GLsizei count, const GLuint *value);
 
     /**
      * Sets the given uniform to an array of 3-element unsigned ints.
@@ -1653,7 +1828,7 @@ public:
      * @param count The number of elements in the array
      * @param value The array of unsigned ints
      */
-    void setUniform3uiv(const std::string name, GLsizei count, const GLuint *value);
+    void setUniform3uiv(const std::string& name, GLsizei count, const GLuint *value);
 
     /**
      * Sets the given uniform to an array of 4-element unsigned ints.
@@ -1677,7 +1852,7 @@ public:
      * @param count The number of elements in the array
      * @param value The array of unsigned ints
      */
-    void setUniform4uiv(const std::string name, GLsizei count, const GLuint *value);
+    void setUniform4uiv(const std::string& name, GLsizei count, const GLuint *value);
     
     /**
      * Sets the given uniform to an array 2x2 matrices.
@@ -1703,7 +1878,7 @@ public:
      * @param value The array of matrices
      * @param tpose Whether to transpose the matrices
      */
-    void setUniformMatrix2fv(const std::string name, GLsizei count, const GLfloat *value, GLboolean tpose=false);
+    void setUniformMatrix2fv(const std::string& name, GLsizei count, const GLfloat *value, GLboolean tpose=false);
 
     /**
      * Sets the given uniform to an array 3x3 matrices.
@@ -1729,7 +1904,7 @@ public:
      * @param value The array of matrices
      * @param tpose Whether to transpose the matrices
      */
-    void setUniformMatrix3fv(const std::string name, GLsizei count, const GLfloat *value, GLboolean tpose=false);
+    void setUniformMatrix3fv(const std::string& name, GLsizei count, const GLfloat *value, GLboolean tpose=false);
 
     /**
      * Sets the given uniform to an array 4x4 matrices.
@@ -1755,7 +1930,7 @@ public:
      * @param value The array of matrices
      * @param tpose Whether to transpose the matrices
      */
-    void setUniformMatrix4fv(const std::string name, GLsizei count, const GLfloat *value, GLboolean tpose=false);
+    void setUniformMatrix4fv(const std::string& name, GLsizei count, const GLfloat *value, GLboolean tpose=false);
 
     /**
      * Sets the given uniform to an array 2x3 matrices.
@@ -1781,7 +1956,7 @@ public:
      * @param value The array of matrices
      * @param tpose Whether to transpose the matrices
      */
-    void setUniformMatrix2x3fv(const std::string name, GLsizei count, const GLfloat *value, GLboolean tpose=false);
+    void setUniformMatrix2x3fv(const std::string& name, GLsizei count, const GLfloat *value, GLboolean tpose=false);
 
     
     /**
@@ -1808,7 +1983,7 @@ public:
      * @param value The array of matrices
      * @param tpose Whether to transpose the matrices
      */
-    void setUniformMatrix3x2fv(const std::string name, GLsizei count, const GLfloat *value, GLboolean tpose=false);
+    void setUniformMatrix3x2fv(const std::string& name, GLsizei count, const GLfloat *value, GLboolean tpose=false);
     
     /**
      * Sets the given uniform to an array 2x4 matrices.
@@ -1834,7 +2009,7 @@ public:
      * @param value The array of matrices
      * @param tpose Whether to transpose the matrices
      */
-    void setUniformMatrix2x4fv(const std::string name, GLsizei count, const GLfloat *value, GLboolean tpose=false);
+    void setUniformMatrix2x4fv(const std::string& name, GLsizei count, const GLfloat *value, GLboolean tpose=false);
 
     /**
      * Sets the given uniform to an array 4x2 matrices.
@@ -1860,7 +2035,7 @@ public:
      * @param value The array of matrices
      * @param tpose Whether to transpose the matrices
      */
-    void setUniformMatrix4x2fv(const std::string name, GLsizei count, const GLfloat *value, GLboolean tpose=false);
+    void setUniformMatrix4x2fv(const std::string& name, GLsizei count, const GLfloat *value, GLboolean tpose=false);
 
     /**
      * Sets the given uniform to an array 3x4 matrices.
@@ -1886,7 +2061,7 @@ public:
      * @param value The array of matrices
      * @param tpose Whether to transpose the matrices
      */
-    void setUniformMatrix3x4fv(const std::string name, GLsizei count, const GLfloat *value, GLboolean tpose=false);
+    void setUniformMatrix3x4fv(const std::string& name, GLsizei count, const GLfloat *value, GLboolean tpose=false);
     
     /**
      * Sets the given uniform to an array 4x3 matrices.
@@ -1912,7 +2087,7 @@ public:
      * @param value The array of matrices
      * @param tpose Whether to transpose the matrices
      */
-    void setUniformMatrix4x3fv(const std::string name, GLsizei count, const GLfloat *value, GLboolean tpose=false);
+    void setUniformMatrix4x3fv(const std::string& name, GLsizei count, const GLfloat *value, GLboolean tpose=false);
 
     /**
      * Gets the given uniform as an array of float values
@@ -1940,7 +2115,7 @@ public:
      *
      * @return true if data was successfully read into value
      */
-    bool getUniformfv(const std::string name, GLsizei size, GLfloat *value) const;
+    bool getUniformfv(const std::string& name, GLsizei size, GLfloat *value) const;
 
     /**
      * Gets the given uniform as an array of integer values
@@ -1968,7 +2143,7 @@ public:
      *
      * @return true if data was successfully read into value
      */
-    bool getUniformiv(const std::string name, GLsizei size, GLint *value) const;
+    bool getUniformiv(const std::string& name, GLsizei size, GLint *value) const;
 
     /**
      * Gets the given uniform as an array of unsigned integer values
@@ -1996,7 +2171,104 @@ public:
      *
      * @return true if data was successfully read into value
      */
-    bool getUniformuiv(const std::string name, GLsizei size, GLuint *value) const;
+    bool getUniformuiv(const std::string& name, GLsizei size, GLuint *value) const;
+    
+    
+#pragma mark -
+#pragma mark Handle Uniforms
+    /**
+     * Sets the given uniform to a single float value.
+     *
+     * This method will only succeed if the shader is actively bound. It will
+     * silently fail (with no error) if the handle is invalid.
+     *
+     * @param handle    The uniform handle
+     * @param v0        The value for the uniform
+     */
+    void setUniform1f(const UniformHandle& handle, GLfloat v0);
+
+    /**
+     * Sets the given uniform to a pair of float values.
+     *
+     * This method will only succeed if the shader is actively bound. It will
+     * silently fail (with no error) if the handle is invalid.
+     *
+     * @param handle    The uniform handle
+     * @param v0        The first value for the uniform
+     * @param v1        The second value for the uniform
+     */
+    void setUniform2f(const UniformHandle& handle, GLfloat v0, GLfloat v1);
+
+    /**
+     * Sets the given uniform to a single int value.
+     *
+     * This method will only succeed if the shader is actively bound. It will
+     * silently fail (with no error) if the handle is invalid.
+     *
+     * @param handle    The uniform handle
+     * @param v0        The value for the uniform
+     */
+    void setUniform1i(const UniformHandle& handle, GLint v0);
+
+    /**
+     * Sets the given uniform to a vector value.
+     *
+     * This method will only succeed if the shader is actively bound. It will
+     * silently fail (with no error) if the handle is invalid.
+     *
+     * @param handle    The uniform handle
+     * @param vec       The value for the uniform
+     */
+    void setUniformVec2(const UniformHandle& handle, const Vec2 vec);
+
+    /**
+     * Sets the given uniform to a vector value.
+     *
+     * This method will only succeed if the shader is actively bound. It will
+     * silently fail (with no error) if the handle is invalid.
+     *
+     * @param handle    The uniform handle
+     * @param vec       The value for the uniform
+     */
+    void setUniformVec4(const UniformHandle& handle, const Vec4 vec);
+
+    /**
+     * Sets the given uniform to a color value.
+     *
+     * This method will only succeed if the shader is actively bound. It will
+     * silently fail (with no error) if the handle is invalid.
+     *
+     * @param handle    The uniform handle
+     * @param color     The value for the uniform
+     */
+    void setUniformColor4f(const UniformHandle& handle, const Color4f color) {
+        setUniformVec4(handle, (Vec4)color);
+    }
+
+    /**
+     * Sets the given uniform to a matrix value.
+     *
+     * This method will only succeed if the shader is actively bound. It will
+     * silently fail (with no error) if the handle is invalid.
+     *
+     * @param handle    The uniform handle
+     * @param mat       The value for the uniform
+     */
+    void setUniformMat4(const UniformHandle& handle, const Mat4& mat);
+
+    /**
+     * Sets the given uniform to an affine transform.
+     *
+     * Affine transforms are passed to a shader as a 3x3 matrix on
+     * homogenous coordinates.
+     *
+     * This method will only succeed if the shader is actively bound. It will
+     * silently fail (with no error) if the handle is invalid.
+     *
+     * @param handle    The uniform handle
+     * @param mat       The value for the uniform
+     */
+    void setUniformAffine2(const UniformHandle& handle, const Affine2& mat);
 };
     
 }
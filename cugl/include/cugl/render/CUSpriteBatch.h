@@ -49,8 +49,11 @@
 
 #include <SDL/SDL.h>
 #include <vector>
+#include <unordered_map>
 #include "CUSpriteVertex.h"
 #include "CUMesh.h"
+#include "CUMeshPool.h"
+#include "CUShader.h"
 #include <cugl/math/CUMathBase.h>
 #include <cugl/math/CUMat4.h>
 #include <cugl/math/CUColor4.h>
@@ -65,12 +68,12 @@ namespace cugl {
 class VertexBuffer;
 class UniformBuffer;
 class TextLayout;
-class Shader;
 class Affine2;
 class Texture;
 class Gradient;
 class Scissor;
 class Font;
+class GlyphRun;
 class Rect;
 class Poly2;
 class Path2;
@@ -857,6 +860,14 @@ private:
     std::shared_ptr<VertexBuffer>  _vertbuff;
     /** The vertex buffer for this sprite batch */
     std::shared_ptr<UniformBuffer> _unifbuff;
+    /** The handle of the perspective uniform */
+    Shader::UniformHandle _uPerspective;
+    /** The handle of the draw type uniform */
+    Shader::UniformHandle _uType;
+    /** The handle of the depth uniform */
+    Shader::UniformHandle _uDepth;
+    /** The handle of the blur uniform */
+    Shader::UniformHandle _uBlur;
     
     /** The sprite batch vertex mesh */
     SpriteVertex2* _vertData;
@@ -878,6 +889,8 @@ private:
     bool _inflight;
     /** The drawing context history */
     std::vector<Context*> _history;
+    /** The released drawing contexts, reused by record */
+    std::vector<Context*> _contextpool;
     
     /** The active color */
     Color4 _color;
@@ -887,6 +900,11 @@ private:
     /** The active scissor mask */
     std::shared_ptr<Scissor>  _scissor;
 
+    /** The recycled meshes for transient drawing */
+    MeshPool<SpriteVertex2> _meshpool;
+    /** The glyph runs reused by each call to drawText (keyed by atlas) */
+    std::unordered_map<GLuint, std::shared_ptr<GlyphRun>> _glyphruns;
+
     // Monitoring values
     /** The number of vertices drawn in this pass (so far) */
     unsigned int _vertTotal;
@@ -2583,6 +2601,29 @@ public:
 
 #pragma mark -
 #pragma mark Direct Mesh Drawing
+    /**
+     * Returns the packed vertex color tinted by the given color.
+     *
+     * This is the tint applied to mesh vertices by {@link #drawMesh} when
+     * tint is true. Each channel is multiplied by the tint channel and
+     * rounded, so tinting by white is the identity. It is exposed so that
+     * nodes which cache tinted vertices produce exactly the same colors.
+     *
+     * @param color The packed vertex color
+     * @param tint  The tint color
+     *
+     * @return the packed vertex color tinted by the given color.
+     */
+    static GLuint tintColor(GLuint color, const Color4 tint) {
+        // Packed colors are stored in memory as r, g, b, a
+        Uint8* bytes = reinterpret_cast<Uint8*>(&color);
+        bytes[0] = (Uint8)((bytes[0]*tint.r+127)/255);
+        bytes[1] = (Uint8)((bytes[1]*tint.g+127)/255);
+        bytes[2] = (Uint8)((bytes[2]*tint.b+127)/255);
+        bytes[3] = (Uint8)((bytes[3]*tint.a+127)/255);
+        return color;
+    }
+
     /**
      * Draws the given mesh with the current texture and/or gradient.
      *
@@ -2629,6 +2670,69 @@ public:
      */
     void drawMesh(const Mesh<SpriteVertex2>& mesh, const Affine2& transform, bool tint = true);
 
+    /**
+     * Draws the given mesh with the current texture and/or gradient, recycling it.
+     *
+     * This method is identical to the version taking a mesh reference, except
+     * that the sprite batch takes ownership of the mesh. Once it is drawn, its
+     * buffers are returned to the mesh pool of this sprite batch, so that they
+     * may be reused by {@link #acquireMesh}. This is the preferred way to draw
+     * transient meshes, such as those created each frame.
+     *
+     * It is unsafe to use the original mesh after this method is called.
+     *
+     * @param mesh      The sprite mesh
+     * @param position  The coordinate offset for the mesh
+     * @param tint      Whether to tint with the active color
+     */
+    void drawMesh(Mesh<SpriteVertex2>&& mesh, const Vec2 position, bool tint = true);
+
+    /**
+     * Draws the given mesh with the current texture and/or gradient, recycling it.
+     *
+     * This method is identical to the version taking a mesh reference, except
+     * that the sprite batch takes ownership of the mesh. Once it is drawn, its
+     * buffers are returned to the mesh pool of this sprite batch, so that they
+     * may be reused by {@link #acquireMesh}. This is the preferred way to draw
+     * transient meshes, such as those created each frame.
+     *
+     * It is unsafe to use the original mesh after this method is called.
+     *
+     * @param mesh      The sprite mesh
+     * @param transform The coordinate transform
+     * @param tint      Whether to tint with the active color
+     */
+    void drawMesh(Mesh<SpriteVertex2>&& mesh, const Affine2& transform, bool tint = true);
+
+    /**
+     * Returns an empty mesh from the mesh pool of this sprite batch.
+     *
+     * The mesh reuses the buffers of a previously recycled mesh if possible,
+     * so filling it will not allocate unless it is larger than any recycled
+     * mesh. The mesh should be returned with the move version of
+     * {@link #drawMesh} or with {@link #recycleMesh}.
+     *
+     * @param command   The drawing command of the mesh
+     *
+     * @return an empty mesh from the mesh pool of this sprite batch.
+     */
+    Mesh<SpriteVertex2> acquireMesh(GLenum command=GL_TRIANGLES) {
+        return _meshpool.acquire(command);
+    }
+
+    /**
+     * Returns the given mesh to the mesh pool of this sprite batch.
+     *
+     * The mesh buffers keep their capacity and will be reused by the next
+     * call to {@link #acquireMesh}. It is unsafe to use the original mesh
+     * after this method is called.
+     *
+     * @param mesh  The mesh to recycle
+     */
+    void recycleMesh(Mesh<SpriteVertex2>&& mesh) {
+        _meshpool.recycle(std::move(mesh));
+    }
+
     /**
      * Draws the vertices in a triangle fan with the current texture and/or gradient.
      *
@@ -2759,7 +2863,7 @@ public:
      * @param font      The font to render the text
      * @param position  The left edge of the text baseline
      */
-    void drawText(const std::string text, const std::shared_ptr<Font>& font, const Vec2 position);
+    void drawText(const std::string& text, const std::shared_ptr<Font>& font, const Vec2 position);
     
     /**
      * Draws the text with the specified font and transform
@@ -2780,7 +2884,7 @@ public:
      * @param origin    The rotational origin relative to the baseline
      * @param transform The coordinate transform
      */
-    void drawText(const std::string text, const std::shared_ptr<Font>& font, const Vec2 origin, const Affine2& transform);
+    void drawText(const std::string& text, const std::shared_ptr<Font>& font, const Vec2 origin, const Affine2& transform);
 
     /**
      * Draws the text layout at the specified position
@@ -2838,6 +2942,24 @@ private:
      */
     GLenum getCommand() const;
 
+    /**
+     * Clears the glyph runs used by drawText for reuse.
+     *
+     * The meshes keep their capacity, so the next call to drawText does not
+     * allocate. The glyph contents are not cleared, as they are never read
+     * by this class and clearing them would release their storage. Runs for
+     * one-time atlases (whose texture is no longer referenced by any font)
+     * are removed.
+     */
+    void clearGlyphRuns();
+
+    /**
+     * Draws the glyph runs used by drawText with the given transform.
+     *
+     * @param transform The coordinate transform
+     */
+    void drawGlyphRuns(const Affine2& transform);
+
     /**
      * Records the current drawing context, freezing it.
      *
@@ -2848,9 +2970,11 @@ private:
     void record();
     
     /**
-     * Deletes the recorded uniforms.
+     * Releases the recorded uniforms.
      *
-     * This method is called upon flushing or cleanup.
+     * The contexts are returned to a pool to be reused by {@link #record}, so
+     * that a batch does not allocate contexts once it has warmed up. This
+     * method is called upon flushing or cleanup.
      */
     void unwind();
     
@@ -2863,6 +2987,14 @@ private:
      */
     void setUniformBlock(Context* context);
     
+    /**
+     * Resolves the uniform handles of the current shader.
+     *
+     * This method is called whenever the shader is assigned, so that the
+     * uniforms are never looked up by name while flushing.
+     */
+    void resolveUniforms();
+    
     /**
      * Updates the shader with the current blur offsets
      *
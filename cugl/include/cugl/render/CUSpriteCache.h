@@ -0,0 +1,121 @@
+//
+//  CUSpriteCache.h
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides a cache of pre-transformed, pre-tinted sprite
+//  vertices. Scene graph nodes like NinePatch and Label already cache their
+//  meshes, but SpriteBatch still has to transform and tint every vertex on
+//  every frame. Most UI widgets do not move between frames, so this cache
+//  stores the final vertices and hands them to the batch as a block copy.
+//
+//  Unlike most classes in CUGL, this class is designed to be used on the
+//  stack (or as a field), like Mesh. It has no static constructors.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#ifndef __CU_SPRITE_CACHE_H__
+#define __CU_SPRITE_CACHE_H__
+#include <cugl/render/CUMesh.h>
+#include <cugl/render/CUSpriteVertex.h>
+#include <cugl/math/CUAffine2.h>
+#include <cugl/math/CUColor4.h>
+
+namespace cugl {
+
+/**
+ * This class is a cache of transformed and tinted sprite vertices.
+ *
+ * A cache stores a copy of a source mesh with the global transform applied
+ * to the positions and the tint applied to the colors. A cached mesh can be
+ * drawn with {@link SpriteBatch#drawMesh} with the identity transform and
+ * no tint, which the batch handles with a single block copy.
+ *
+ * The cache is only built once the same transform and tint are seen on two
+ * consecutive draws. That way animated nodes, whose transform changes every
+ * frame, never pay for building a cache they cannot use. The owner must call
+ * {@link #invalidate} whenever the source mesh changes.
+ *
+ * The cached vertex colors match the tinting of {@link SpriteBatch} exactly.
+ */
+class SpriteCache {
+private:
+    /** The transformed and tinted vertices */
+    Mesh<SpriteVertex2> _mesh;
+    /** The transform of the last draw */
+    Affine2 _transform;
+    /** The tint of the last draw */
+    Color4 _tint;
+    /** The cache state (0 = empty, 1 = seen once, 2 = built) */
+    Uint8 _state;
+
+public:
+    /**
+     * Creates an empty sprite cache.
+     */
+    SpriteCache() : _state(0) {}
+
+    /**
+     * Invalidates this cache.
+     *
+     * This method should be called whenever the source mesh changes. The
+     * cache memory is kept so that it can be reused by the next build.
+     */
+    void invalidate() { _state = 0; }
+
+    /**
+     * Returns true if this cache holds a built mesh.
+     *
+     * @return true if this cache holds a built mesh.
+     */
+    bool isBuilt() const { return _state == 2; }
+
+    /**
+     * Returns true if the cache may be drawn for this transform and tint.
+     *
+     * If the transform and tint match the previous call, the cache is built
+     * (if necessary) from the source mesh and this method returns true. The
+     * owner should then draw {@link #getMesh} with the identity transform
+     * and no tint. Otherwise, this method records the new transform and tint
+     * and returns false, and the owner should draw the source mesh as usual.
+     *
+     * @param source    The source mesh
+     * @param transform The global transform
+     * @param tint      The tint color
+     *
+     * @return true if the cache may be drawn for this transform and tint.
+     */
+    bool update(const Mesh<SpriteVertex2>& source, const Affine2& transform, Color4 tint);
+
+    /**
+     * Returns the cached mesh.
+     *
+     * This mesh is only valid if {@link #update} returned true.
+     *
+     * @return the cached mesh.
+     */
+    const Mesh<SpriteVertex2>& getMesh() const { return _mesh; }
+};
+
+}
+
+#endif /* __CU_SPRITE_CACHE_H__ */
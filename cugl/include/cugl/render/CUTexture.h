@@ -406,6 +406,28 @@ public:
      */
     const Texture& set(const void *data);
 
+    /**
+     * Sets this texture to have the contents of the given buffer and size.
+     *
+     * This method replaces the texture image in place, keeping the same
+     * OpenGL texture. Therefore any object that references this texture
+     * (such as a scene graph node or subtexture) will see the new image.
+     * This is how textures are hot-reloaded by {@link TextureLoader}.
+     *
+     * The buffer must have the same data format as this texture, and it
+     * must be size width*height*bytesize. If this texture had mipmaps,
+     * they will be rebuilt. This method may not be called on a subtexture.
+     *
+     * This method is only successful if the texture is currently active.
+     *
+     * @param data      The buffer to read into the texture
+     * @param width     The new texture width in pixels
+     * @param height    The new texture height in pixels
+     *
+     * @return a reference to this (modified) texture for chaining.
+     */
+    const Texture& set(const void *data, int width, int height);
+
     
 #pragma mark -
 #pragma mark Attributes
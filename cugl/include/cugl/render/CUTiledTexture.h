@@ -0,0 +1,489 @@
+//
+//  CUTiledTexture.h
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides a streaming texture for very large images, such as
+//  level backgrounds. A single texture is limited by the maximum texture size
+//  of the GPU, and must be entirely resident in memory. A tiled texture is an
+//  image that has been split offline into a pyramid of fixed size tiles, one
+//  pyramid level per mipmap level. Only the tiles that are visible are loaded,
+//  and they are decoded in a background thread and uploaded in the main thread.
+//  The tiles are kept in a cache of fixed capacity, so the memory use of this
+//  texture is constant, regardless of the size of the image.
+//
+//  The tiles are stored as image files in a directory, together with a JSON
+//  manifest describing the image. Use the static method bake to produce this
+//  directory from a source image.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#ifndef __CU_TILED_TEXTURE_H__
+#define __CU_TILED_TEXTURE_H__
+#include <cugl/render/CUTexture.h>
+#include <cugl/util/CUThreadPool.h>
+#include <cugl/math/CURect.h>
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <list>
+
+namespace cugl {
+
+/**
+ * This class is a streaming texture for very large images.
+ *
+ * A tiled texture is an image that has been split offline into a pyramid of
+ * tiles. Level 0 of the pyramid is the image at full resolution, and each
+ * level after is half the size of the previous one. The last level fits in
+ * a single tile. Every tile has the same size (edge tiles are padded), and
+ * is stored as an image file in the directory of the manifest. Use the static
+ * method {@link #bake} to produce a tiled texture from an image file.
+ *
+ * The manifest is a JSON file with the following attributes:
+ *
+ *      "width":    The width of the image in pixels
+ *      "height":   The height of the image in pixels
+ *      "tile":     The size of each (square) tile in pixels
+ *      "levels":   The number of levels in the pyramid
+ *      "format":   The file extension of the tiles (e.g. "png")
+ *
+ * The tile in column c and row r of level l is the file "l/c_r.format",
+ * relative to the manifest. Rows are numbered from the top of the image.
+ *
+ * Tiles are requested with the method {@link #select}, typically once a frame
+ * by {@link scene2::TiledTextureNode}. Missing tiles are decoded in a
+ * background thread and uploaded to the GPU by {@link #update}. The owner of
+ * the texture must call this method once per frame in the main thread, as
+ * the nodes that draw the texture do not. Until a tile is available,
+ * {@link #select} falls back to the part of a coarser tile that covers the
+ * same region. The tiles of the last level are never evicted, so there is
+ * always something to draw once they have been loaded.
+ *
+ * Resident tiles are kept in an LRU cache of fixed capacity. Hence the memory
+ * footprint of this texture is capacity*tile*tile*4 bytes, independent of the
+ * size of the image.
+ */
+class TiledTexture {
+public:
+    /**
+     * This class is a rectangle of a tile texture to draw.
+     *
+     * The bounds are in image (level 0) pixel coordinates, with the origin at
+     * the bottom left corner of the image. The texture coordinates are in the
+     * texture itself, which is either the tile at the selected level, or a
+     * coarser tile covering the same region.
+     */
+    class Patch {
+    public:
+        /** The tile texture */
+        std::shared_ptr<Texture> texture;
+        /** The region of the image covered, in level 0 pixel coordinates */
+        Rect bounds;
+        /** The texture coordinate of the left edge */
+        float minS;
+        /** The texture coordinate of the right edge */
+        float maxS;
+        /** The texture coordinate of the top edge */
+        float minT;
+        /** The texture coordinate of the bottom edge */
+        float maxT;
+    };
+
+private:
+    /** This macro disables the copy constructor (not allowed on textures) */
+    CU_DISALLOW_COPY_AND_ASSIGN(TiledTexture);
+
+    /**
+     * This class is a resident tile in the cache.
+     */
+    class Entry {
+    public:
+        /** The tile texture */
+        std::shared_ptr<Texture> texture;
+        /** The position of this tile in the LRU list */
+        std::list<Uint64>::iterator position;
+        /** The last frame this tile was selected */
+        Uint64 frame;
+    };
+
+    /**
+     * This class is a tile decoded by a worker thread.
+     */
+    class Decoded {
+    public:
+        /** The tile key */
+        Uint64 key;
+        /** The pixel data, in RGBA format */
+        std::vector<Uint8> pixels;
+    };
+
+    /** The directory containing the tile files */
+    std::string _directory;
+    /** The file extension of the tile files */
+    std::string _format;
+    /** The width of the image in pixels */
+    Uint32 _width;
+    /** The height of the image in pixels */
+    Uint32 _height;
+    /** The size of each tile in pixels */
+    Uint32 _tilesize;
+    /** The number of levels in the pyramid */
+    Uint32 _levels;
+
+    /** The maximum number of resident tiles */
+    Uint32 _capacity;
+    /** The maximum number of tiles to upload per frame */
+    Uint32 _uploads;
+    /** The current frame */
+    Uint64 _frame;
+
+    /** The resident tiles */
+    std::unordered_map<Uint64,Entry> _cache;
+    /** The resident tiles, from the most to the least recently used */
+    std::list<Uint64> _lru;
+    /** The tile textures available for reuse */
+    std::vector<std::shared_ptr<Texture>> _spares;
+
+    /** The thread pool for decoding tiles */
+    std::shared_ptr<ThreadPool> _workers;
+    /** The requested tiles, mapped to the last frame they were requested */
+    std::unordered_map<Uint64,Uint64> _pending;
+    /** The tiles decoded, but not yet uploaded */
+    std::vector<Decoded> _decoded;
+    /** A mutex protecting the pending and decoded tiles */
+    std::mutex _mutex;
+
+    /**
+     * Returns the key for the given tile.
+     *
+     * @param level The pyramid level
+     * @param col   The tile column
+     * @param row   The tile row (from the top)
+     *
+     * @return the key for the given tile.
+     */
+    static Uint64 makeKey(Uint32 level, Uint32 col, Uint32 row) {
+        return ((Uint64)level << 48) | ((Uint64)row << 24) | (Uint64)col;
+    }
+
+    /**
+     * Returns the resident tile for the given key, or nullptr if not resident.
+     *
+     * This method marks the tile as used in the current frame.
+     *
+     * @param key   The tile key
+     *
+     * @return the resident tile for the given key, or nullptr if not resident.
+     */
+    Entry* touch(Uint64 key);
+
+    /**
+     * Requests the given tile, if it is not already requested.
+     *
+     * The tile is decoded in a worker thread, and uploaded by a later call
+     * to {@link #update}.
+     *
+     * @param key   The tile key
+     */
+    void request(Uint64 key);
+
+    /**
+     * Decodes the given tile in a worker thread.
+     *
+     * The tile is skipped if it is no longer requested.
+     *
+     * @param key   The tile key
+     */
+    void decode(Uint64 key);
+
+    /**
+     * Uploads the given decoded tile to the GPU, adding it to the cache.
+     *
+     * This method may evict the least recently used tile. Tiles in the last
+     * level, and tiles used or uploaded in the current frame, are never evicted. If no
+     * tile can be evicted, the tile is discarded.
+     *
+     * @param tile  The decoded tile
+     *
+     * @return true if the tile was added to the cache
+     */
+    bool upload(Decoded& tile);
+
+    /**
+     * Returns the file for the given tile.
+     *
+     * @param key   The tile key
+     *
+     * @return the file for the given tile.
+     */
+    std::string getTileFile(Uint64 key) const;
+
+public:
+#pragma mark Constructors
+    /**
+     * Creates an uninitialized tiled texture.
+     *
+     * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an object on
+     * the heap, use one of the static constructors instead.
+     */
+    TiledTexture();
+
+    /**
+     * Deletes this tiled texture, disposing all resources
+     */
+    ~TiledTexture() { dispose(); }
+
+    /**
+     * Disposes all of the resources used by this tiled texture.
+     *
+     * This method blocks until any tile being decoded is complete. A disposed
+     * texture can be safely reinitialized.
+     */
+    void dispose();
+
+    /**
+     * Initializes a tiled texture from the given manifest.
+     *
+     * The manifest is a JSON file, as described in the class documentation.
+     * Relative paths are resolved against the application asset directory.
+     * The texture will keep at most 64 tiles resident, and will decode tiles
+     * in a single background thread.
+     *
+     * @param manifest  The manifest file
+     *
+     * @return true if initialization was successful.
+     */
+    bool initWithFile(const std::string& manifest) {
+        return initWithFile(manifest,64,1);
+    }
+
+    /**
+     * Initializes a tiled texture from the given manifest.
+     *
+     * The manifest is a JSON file, as described in the class documentation.
+     * Relative paths are resolved against the application asset directory.
+     * The capacity is the maximum number of resident tiles. It should be
+     * large enough to cover the screen at least twice over, plus the tiles
+     * of the last level.
+     *
+     * @param manifest  The manifest file
+     * @param capacity  The maximum number of resident tiles
+     * @param threads   The number of threads for decoding tiles
+     *
+     * @return true if initialization was successful.
+     */
+    bool initWithFile(const std::string& manifest, Uint32 capacity, Uint32 threads);
+
+    /**
+     * Returns a newly allocated tiled texture from the given manifest.
+     *
+     * The manifest is a JSON file, as described in the class documentation.
+     * Relative paths are resolved against the application asset directory.
+     * The texture will keep at most 64 tiles resident, and will decode tiles
+     * in a single background thread.
+     *
+     * @param manifest  The manifest file
+     *
+     * @return a newly allocated tiled texture from the given manifest.
+     */
+    static std::shared_ptr<TiledTexture> allocWithFile(const std::string& manifest) {
+        std::shared_ptr<TiledTexture> result = std::make_shared<TiledTexture>();
+        return (result->initWithFile(manifest) ? result : nullptr);
+    }
+
+    /**
+     * Returns a newly allocated tiled texture from the given manifest.
+     *
+     * The manifest is a JSON file, as described in the class documentation.
+     * Relative paths are resolved against the application asset directory.
+     * The capacity is the maximum number of resident tiles. It should be
+     * large enough to cover the screen at least twice over, plus the tiles
+     * of the last level.
+     *
+     * @param manifest  The manifest file
+     * @param capacity  The maximum number of resident tiles
+     * @param threads   The number of threads for decoding tiles
+     *
+     * @return a newly allocated tiled texture from the given manifest.
+     */
+    static std::shared_ptr<TiledTexture> allocWithFile(const std::string& manifest,
+                                                       Uint32 capacity, Uint32 threads) {
+        std::shared_ptr<TiledTexture> result = std::make_shared<TiledTexture>();
+        return (result->initWithFile(manifest,capacity,threads) ? result : nullptr);
+    }
+
+    /**
+     * Splits the given image into a tiled texture in the given directory.
+     *
+     * This is an offline tool. It loads the entire source image into memory,
+     * and so it should not be used at runtime. The directory will contain the
+     * manifest "tiles.json" and a subdirectory for each pyramid level. Each
+     * level is downsampled from the previous one with a box filter. All tiles
+     * are saved as PNG files.
+     *
+     * @param source    The source image file
+     * @param directory The directory to store the tiles
+     * @param tilesize  The size of each tile in pixels
+     *
+     * @return true if the image was successfully split
+     */
+    static bool bake(const std::string& source, const std::string& directory, Uint32 tilesize = 512);
+
+#pragma mark Attributes
+    /**
+     * Returns the width of the image in pixels.
+     *
+     * @return the width of the image in pixels.
+     */
+    Uint32 getWidth() const { return _width; }
+
+    /**
+     * Returns the height of the image in pixels.
+     *
+     * @return the height of the image in pixels.
+     */
+    Uint32 getHeight() const { return _height; }
+
+    /**
+     * Returns the size of the image in pixels.
+     *
+     * @return the size of the image in pixels.
+     */
+    Size getSize() const { return Size((float)_width,(float)_height); }
+
+    /**
+     * Returns the size of each (square) tile in pixels.
+     *
+     * @return the size of each (square) tile in pixels.
+     */
+    Uint32 getTileSize() const { return _tilesize; }
+
+    /**
+     * Returns the number of levels in the tile pyramid.
+     *
+     * @return the number of levels in the tile pyramid.
+     */
+    Uint32 getLevels() const { return _levels; }
+
+    /**
+     * Returns the maximum number of resident tiles.
+     *
+     * @return the maximum number of resident tiles.
+     */
+    Uint32 getCapacity() const { return _capacity; }
+
+    /**
+     * Returns the number of resident tiles.
+     *
+     * @return the number of resident tiles.
+     */
+    size_t getResidentCount() const { return _cache.size(); }
+
+    /**
+     * Returns the number of tiles requested, but not yet uploaded.
+     *
+     * @return the number of tiles requested, but not yet uploaded.
+     */
+    size_t getPendingCount();
+
+    /**
+     * Returns the maximum number of tiles uploaded per frame.
+     *
+     * Uploading a tile is a synchronous texture update. Limiting the number
+     * of uploads per frame smooths out the cost of a camera jump. The default
+     * is 4.
+     *
+     * @return the maximum number of tiles uploaded per frame.
+     */
+    Uint32 getUploadLimit() const { return _uploads; }
+
+    /**
+     * Sets the maximum number of tiles uploaded per frame.
+     *
+     * Uploading a tile is a synchronous texture update. Limiting the number
+     * of uploads per frame smooths out the cost of a camera jump. The default
+     * is 4.
+     *
+     * @param limit The maximum number of tiles uploaded per frame.
+     */
+    void setUploadLimit(Uint32 limit) { _uploads = limit; }
+
+#pragma mark Streaming
+    /**
+     * Returns the pyramid level for the given texel density.
+     *
+     * The density is the number of image pixels per screen pixel. The level
+     * is the coarsest one that still has at least one texel per pixel.
+     *
+     * @param density   The number of image pixels per screen pixel
+     *
+     * @return the pyramid level for the given texel density.
+     */
+    Uint32 getLevel(float density) const;
+
+    /**
+     * Uploads decoded tiles and starts a new frame.
+     *
+     * This method must be called in the main thread, once per frame, before
+     * any calls to {@link #select}. It uploads at most {@link #getUploadLimit}
+     * tiles, and cancels any requests that were not renewed in the previous
+     * frame.
+     */
+    void update();
+
+    /**
+     * Stores the patches needed to draw the given region in patches.
+     *
+     * The region is in image pixel coordinates, with the origin at the bottom
+     * left corner. The tiles are chosen from the given level. Any tile that is
+     * not resident is requested, and the corresponding part of the finest
+     * resident coarser tile is drawn instead. Regions with no resident tile
+     * (which can only happen in the first few frames) are skipped.
+     *
+     * The patches are appended to the given vector, which is not cleared.
+     *
+     * @param region    The region to draw, in image pixel coordinates
+     * @param level     The pyramid level to draw
+     * @param patches   The vector to store the patches
+     *
+     * @return the number of patches added
+     */
+    size_t select(const Rect& region, Uint32 level, std::vector<Patch>& patches);
+};
+
+}
+
+#endif /* __CU_TILED_TEXTURE_H__ */
@@ -30,18 +30,22 @@
 
 #include "CUSpriteVertex.h"
 #include "CUTexture.h"
+#include "CUTiledTexture.h"
 #include "CUMesh.h"
+#include "CUMeshPool.h"
 #include "CUScissor.h"
 #include "CUGradient.h"
 #include "CUGlyphRun.h"
 #include "CUFont.h"
 #include "CUTextAlignment.h"
 #include "CUTextLayout.h"
+#include "CUGLState.h"
 #include "CUShader.h"
 #include "CUUniformBuffer.h"
 #include "CURenderTarget.h"
 #include "CUSpriteBatch.h"
 #include "CUSpriteSheet.h"
+#include "CUSpriteCache.h"
 #include "CUCamera.h"
 #include "CUOrthographicCamera.h"
 #include "CUPerspectiveCamera.h"
@@ -141,6 +141,12 @@ public:
      * The important state of the target is stored in the given state parameter.
      * The semantics of this state is action-dependent.
      *
+     * If the {@link ActionManager} has a thread pool, this method may be
+     * called from a worker thread, concurrently with actions on other nodes.
+     * Therefore it may only modify the target node and the state parameter.
+     * It must not modify the action itself, or any other node (including the
+     * parent or children of the target).
+     *
      * @param target    The node to act on
      * @param state     The relevant node state
      * @param dt        The elapsed time to animate.
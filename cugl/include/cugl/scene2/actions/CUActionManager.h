@@ -42,6 +42,8 @@
 #define __CU_ACTION_MANAGER_H__
 
 #include "CUAction.h"
+#include <cugl/util/CUSymbol.h>
+#include <cugl/util/CUThreadPool.h>
 #include <SDL/SDL.h>
 #include <unordered_map>
 #include <unordered_set>
@@ -67,6 +69,15 @@ namespace cugl {
  *
  * An action manager is not implemented as a singleton.  However, you typically
  * only need one manager per application.
+ *
+ * Scenes with many thousands of animated nodes can spread the update over
+ * several cores by attaching a {@link ThreadPool} to the manager. Actions are
+ * grouped by target node, and each group is updated in order on a single
+ * thread, so two actions on the same node never race. Actions on different
+ * nodes may run concurrently, so an action may only modify its own target
+ * (see {@link Action#update}). Completed actions are always removed on the
+ * calling thread after all groups are done, in the same order as a serial
+ * update, so the results do not depend on the number of threads.
  */
 class ActionManager {
 #pragma mark ActionInstance
@@ -83,6 +94,9 @@ class ActionManager {
      */
     class ActionInstance {
     public:
+        /** The key identifying this instance */
+        Symbol key;
+        
         /** The node the action is performed on */
         std::shared_ptr<scene2::SceneNode> target;
         
@@ -104,6 +118,9 @@ class ActionManager {
         /** Whether or not this instance is currently paused */
         bool  paused;
         
+        /** Whether this action reached its duration in the last update */
+        bool  complete;
+        
     public:
         /**
          * Creates a new degenerate ActionInstance on the stack.
@@ -111,7 +128,7 @@ class ActionManager {
          * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an object on
          * the heap, use one of the static constructors instead.
          */
-        ActionInstance() : state(0), duration(0.0f), elapsed(0.0f), paused(false) {}
+        ActionInstance() : state(0), duration(0.0f), elapsed(0.0f), paused(false), complete(false) {}
         
         /**
          * Deletes this action instance, disposing all resources
@@ -122,11 +139,54 @@ class ActionManager {
 #pragma mark Values
 protected:
     /** A map that associates nodes with their (multiple) animations */
-    std::unordered_map<SceneNode*, std::unordered_set<std::string>> _keys;
+    std::unordered_map<SceneNode*, std::unordered_set<Symbol>> _keys;
     
     /** A map that associates keys with animations */
-    std::unordered_map<std::string, ActionInstance*> _actions;
+    std::unordered_map<Symbol, ActionInstance*> _actions;
     
+    /** The thread pool for parallel updates (may be nullptr) */
+    std::shared_ptr<ThreadPool> _threads;
+    /** The minimum number of active animations for a parallel update */
+    size_t _threshold;
+    /** The active animations grouped by target node */
+    std::vector<ActionInstance*> _queue;
+    /** The start of each parallel task in the queue (plus the end) */
+    std::vector<size_t> _tasks;
+    /** Whether the queue must be rebuilt before the next update */
+    bool _dirty;
+
+#pragma mark Internal Helpers
+    /**
+     * Updates the given animation by dt seconds
+     *
+     * This method marks the animation as complete if it reaches its duration,
+     * but it does not remove it. It is safe to call this method concurrently
+     * on animations with different targets.
+     *
+     * @param instance  The animation to update
+     * @param dt        The number of seconds to animate
+     */
+    static void step(ActionInstance* instance, float dt);
+
+    /**
+     * Rebuilds the queue of animations grouped by target node
+     *
+     * The queue is divided into contiguous tasks, one for each thread of the
+     * thread pool (plus the calling thread). Tasks are only divided between
+     * target nodes. The queue is cached until the set of animations, or the
+     * thread pool, changes.
+     */
+    void rebuild();
+
+    /**
+     * Updates all non-paused animations by dt seconds using the thread pool
+     *
+     * The calling thread performs the first task in the queue and waits for
+     * the others to finish. This method does not remove completed animations.
+     *
+     * @param dt    The number of seconds to animate
+     */
+    void parallelUpdate(float dt);
 
 public:
 #pragma mark Constructors
@@ -136,7 +196,7 @@ public:
      * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an object on 
      * the heap, use one of the static constructors instead.
      */
-    ActionManager() {}
+    ActionManager() : _threshold(1024), _dirty(false) {}
     
     /**
      * Deletes this action manager, disposing all resources
@@ -178,7 +238,19 @@ public:
      *
      * @return true if the given key represents an active animation
      */
-    bool isActive(std::string key) const;
+    bool isActive(const Symbol key) const;
+    
+    /**
+     * Returns true if the given key represents an active animation
+     *
+     * @param key       The identifying key
+     *
+     * @return true if the given key represents an active animation
+     */
+    bool isActive(const std::string& key) const {
+        Symbol name;
+        return Symbol::find(key,name) && isActive(name);
+    }
     
     /**
      * Actives an animation with the given target and action
@@ -191,7 +263,24 @@ public:
      *
      * @return true if the animation was successfully started
      */
-    bool activate(std::string key,
+    bool activate(const std::string& key,
+                  const std::shared_ptr<Action>& action,
+                  const std::shared_ptr<SceneNode>& target) {
+        return activate(Symbol(key),action,target, nullptr);
+    };
+
+    /**
+     * Actives an animation with the given target and action
+     *
+     * This method will fail if the provided key is already in use.
+     *
+     * @param key       The identifying key
+     * @param action    The action to animate with
+     * @param target    The node to animate on
+     *
+     * @return true if the animation was successfully started
+     */
+    bool activate(const Symbol key,
                   const std::shared_ptr<Action>& action,
                   const std::shared_ptr<SceneNode>& target) {
         return activate(key,action,target, nullptr);
@@ -214,7 +303,30 @@ public:
      *
      * @return true if the animation was successfully started
      */
-    bool activate(std::string key,
+    bool activate(const std::string& key,
+                  const std::shared_ptr<Action>& action,
+                  const std::shared_ptr<SceneNode>& target,
+                  std::function<float(float)> easing) {
+        return activate(Symbol(key),action,target,easing);
+    }
+    
+    /**
+     * Actives an animation with the given target and action
+     *
+     * The easing function allows for effects like bouncing or elasticity in
+     * the linear interpolation. If null, the animation will use the standard
+     * linear easing.
+     *
+     * This method will fail if the provided key is already in use.
+     *
+     * @param key       The identifying key
+     * @param action    The action to animate with
+     * @param target    The node to animate on
+     * @param easing    The easing (interpolation) function
+     *
+     * @return true if the animation was successfully started
+     */
+    bool activate(const Symbol key,
                   const std::shared_ptr<Action>& action,
                   const std::shared_ptr<SceneNode>& target,
                   std::function<float(float)> easing);
@@ -232,7 +344,25 @@ public:
      *
      * @return true if the animation was successfully removed
      */
-    bool remove(std::string key);
+    bool remove(const Symbol key);
+    
+    /**
+     * Removes the animation for the given key.
+     *
+     * This act will immediately stop the animation.  The animated node will
+     * continue to have whatever state it had when the animation stopped.
+     *
+     * If there is no animation for the give key (e.g. the animation is complete)
+     * this method will return false.
+     *
+     * @param key       The identifying key
+     *
+     * @return true if the animation was successfully removed
+     */
+    bool remove(const std::string& key) {
+        Symbol name;
+        return Symbol::find(key,name) && remove(name);
+    }
 
     /**
      * Updates all non-paused animations by dt seconds
@@ -241,10 +371,63 @@ public:
      * to reach its duration, the animation is removed and the key is once
      * again available.
      *
+     * If this manager has a thread pool and at least {@link #getParallelThreshold}
+     * active animations, the animations are updated in parallel. Completed
+     * animations are removed on the calling thread in either case.
+     *
      * @param dt    The number of seconds to animate
      */
     void update(float dt);
 
+#pragma mark -
+#pragma mark Parallel Updates
+    /**
+     * Returns the thread pool for parallel updates.
+     *
+     * If this value is nullptr, all animations are updated on the calling
+     * thread.
+     *
+     * @return the thread pool for parallel updates.
+     */
+    const std::shared_ptr<ThreadPool>& getThreadPool() const { return _threads; }
+
+    /**
+     * Sets the thread pool for parallel updates.
+     *
+     * The pool may be shared with other systems, but {@link #update} blocks
+     * until its tasks are done, so tasks queued ahead of them will stall the
+     * update. If this value is nullptr, all animations are updated on the
+     * calling thread.
+     *
+     * @param threads   The thread pool for parallel updates.
+     */
+    void setThreadPool(const std::shared_ptr<ThreadPool>& threads) {
+        _threads = threads;
+        _dirty = true;
+    }
+
+    /**
+     * Returns the minimum number of active animations for a parallel update.
+     *
+     * Below this number, the cost of waking the worker threads outweighs the
+     * benefit, and the animations are updated on the calling thread. The
+     * default is 1024.
+     *
+     * @return the minimum number of active animations for a parallel update.
+     */
+    size_t getParallelThreshold() const { return _threshold; }
+
+    /**
+     * Sets the minimum number of active animations for a parallel update.
+     *
+     * Below this number, the cost of waking the worker threads outweighs the
+     * benefit, and the animations are updated on the calling thread. The
+     * default is 1024.
+     *
+     * @param threshold The minimum number of active animations for a parallel update.
+     */
+    void setParallelThreshold(size_t threshold) { _threshold = threshold; }
+
 #pragma mark -
 #pragma mark Pausing
     /**
@@ -257,7 +440,22 @@ public:
      *
      * @return true if the animation for the given key is paused
      */
-    bool isPaused(std::string key);
+    bool isPaused(const Symbol key);
+    
+    /**
+     * Returns true if the animation for the given key is paused
+     *
+     * This method will return false if there is no active animation with the
+     * given key.
+     *
+     * @param key       The identifying key
+     *
+     * @return true if the animation for the given key is paused
+     */
+    bool isPaused(const std::string& key) {
+        Symbol name;
+        return Symbol::find(key,name) && isPaused(name);
+    }
 
     /** 
      * Pauses the animation for the given key.
@@ -267,7 +465,22 @@ public:
      *
      * @param key       The identifying key
      */
-    void pause(std::string key);
+    void pause(const Symbol key);
+    
+    /**
+     * Pauses the animation for the given key.
+     *
+     * If there is no active animation for the given key, or if it is already
+     * paused, this method does nothing.
+     *
+     * @param key       The identifying key
+     */
+    void pause(const std::string& key) {
+        Symbol name;
+        if (Symbol::find(key,name)) {
+            pause(name);
+        }
+    }
 
     /**
      * Unpauses the animation for the given key.
@@ -277,7 +490,22 @@ public:
      *
      * @param key       The identifying key
      */
-    void unpause(std::string key);
+    void unpause(const Symbol key);
+    
+    /**
+     * Unpauses the animation for the given key.
+     *
+     * If there is no active animation for the given key, or if it is not
+     * currently paused, this method does nothing.
+     *
+     * @param key       The identifying key
+     */
+    void unpause(const std::string& key) {
+        Symbol name;
+        if (Symbol::find(key,name)) {
+            unpause(name);
+        }
+    }
 
 #pragma mark -
 #pragma mark Node Management
@@ -36,6 +36,7 @@
 #include "graph/CUWireNode.h"
 #include "graph/CUPathNode.h"
 #include "graph/CUSpriteNode.h"
+#include "graph/CUTiledTextureNode.h"
 #include "graph/CUOrderedNode.h"
 #include "graph/CUCanvasNode.h"
 #include "ui/CUButton.h"
@@ -67,10 +67,11 @@ namespace cugl {
  * Any order other than a pre-order traversal comes as a cost, as we must
  * cache the scene graph transform and color context of each node (these
  * values are computed naturally from the recursive calls of a pre-order
- * traversal). In addition, we must call std::sort (currently IntroSort)
- * on all of the descendants every single render pass. However, as long
- * as the number of children of this node is reasonably sized, this should
- * not be an issue.
+ * traversal). These contexts are stored in a flat array that is reused
+ * every render pass, so the cost is linear in the number of descendants.
+ * The orders {@link #ASCEND} and {@link #DESCEND} must additionally sort
+ * the descendants each pass. They use a radix sort on a packed 64-bit key,
+ * which is also linear in the number of descendants.
  *
  * An OrderedNode is a render barrier. This means that if one OrderedNode
  * (the first node) is a descendant of another OrderedNode (the second node),
@@ -114,9 +115,7 @@ public:
          *
          * Children with lower priorities will appear at the back of the scene.
          *
-         * The algorithm for std::sort is an unstable sorting algorithm and does
-         * not handle ties well. Hence all ties are broken by the pre-order
-         * traveral value.
+         * All ties are broken by the pre-order traveral value.
          */
         ASCEND,
 
@@ -125,9 +124,7 @@ public:
          *
          * Children with higher priorities will appear at the back of the scene.
          *
-         * The algorithm for std::sort is an unstable sorting algorithm and does
-         * not handle ties well. Hence all ties are broken by the pre-order
-         * traveral value.
+         * All ties are broken by the pre-order traveral value.
          */
         DESCEND,
 
@@ -177,58 +174,36 @@ protected:
      * the scissor value. Normally these are managed by the call stack during
      * a recursive call. To reorder rendering, we have to make this explicit.
      *
-     * This class is essentially a struct with a sort order.
+     * This class is essentially a struct. Entries are stored by value in a
+     * flat array that is reused every frame, so they should remain cheap to
+     * copy and should never own the node that they draw.
      */
-    class Context {
+    class Entry {
     public:
-        /** The parent of this inner class (as C++ does not have this Java feature) */
-        OrderedNode* parent;
-        /** The node to be drawn at this step */
-        std::shared_ptr<SceneNode> node;
+        /** The node to be drawn at this step (owned by the scene graph) */
+        SceneNode* node;
         /** The scissor value (possibly nullptr) */
         std::shared_ptr<Scissor> scissor;
         /** The drawing transform */
         Affine2 transform;
         /** The tint color */
         Color4 tint;
-        /** The canonical order (for pre-order and post-order traversals) */
-        Uint32 canonical;
-        
-        /**
-         * Creates a drawing context with the given parent object
-         *
-         * @param parent    The parent object for the inner class
-         */
-        Context(OrderedNode* parent);
-        
-        /**
-         * Creates a copy of the given drawing context
-         *
-         * @param copy      The drawing context to copy
-         */
-        Context(const Context& copy);
-
-        /**
-         * Deletes this drawing context, disposing of all resources.
-         */
-        ~Context();
-
-        /**
-         * Returns the value *a < *b
-         *
-         * This function implements a sort order on drawing contexts and
-         * is used to sort the render queue.
-         *
-         * @param a        The first (pointer) to compare
-         * @param b        The first (pointer) to compare
-         *
-         * @return the value *a < *b
-         */
-        static bool sortCompare(Context* a, Context* b);
+        /** Whether this node is a render barrier */
+        bool barrier;
     };
 
-    /** The render queue (always use a deque for this functionality) */
-    std::deque<Context*> _entries;
+    /** The render queue, in canonical (traversal) order */
+    std::vector<Entry> _entries;
+    /** The packed sort keys (priority in the high bits, canonical index in the low bits) */
+    std::vector<Uint64> _keys;
+    /** A scratch buffer for radix sorting the sort keys */
+    std::vector<Uint64> _scratch;
+    /** A stack of sibling keys for the sorted pre-order and post-order traversals */
+    std::vector<Uint64> _siblings;
+    /** A pool of scissors reused by the descendants of this node */
+    std::vector<std::shared_ptr<Scissor>> _clips;
+    /** The number of scissors in the pool used this frame */
+    size_t _clipsUsed;
     /** The global scissor context (necessary as sprite batches manage this normally) */
     std::shared_ptr<Scissor> _viewport;
     /** The current render order */
@@ -238,15 +213,39 @@ protected:
      * Adds the given node ot the render queue.
      *
      * This method replaces {@link #render} to provide a delayed render command
-     * (via a queue of {@link Context} objects). This method is recursive.
-     * However, it will stop when it encounters any other {@link OrderedNode}
-     * objects.
+     * (via a queue of {@link Entry} objects). This method is recursive.
+     * However, it will stop when it encounters any render barrier (such as
+     * another {@link OrderedNode}).
      *
      * @param node      The descendant node to render.
      * @param transform The global transformation matrix.
      * @param tint      The tint to blend with the node color.
      */
-    void visit(const std::shared_ptr<SceneNode>& node, const Affine2& transform, Color4 tint);
+    void visit(SceneNode* node, const Affine2& transform, Color4 tint);
+    
+    /**
+     * Adds the children of the given node to the render queue.
+     *
+     * If the render order sorts siblings by priority, the children are
+     * visited in sorted order (with ties broken by child position).
+     * Otherwise they are visited in the order that they are stored.
+     *
+     * @param children  The children to visit.
+     * @param transform The global transformation matrix.
+     * @param tint      The tint to blend with the node color.
+     */
+    void visitChildren(const std::vector<std::shared_ptr<SceneNode>>& children,
+                       const Affine2& transform, Color4 tint);
+    
+    /**
+     * Sorts the render queue by priority using the packed sort keys.
+     *
+     * This method is only necessary for the orders {@link Order#ASCEND} and
+     * {@link Order#DESCEND}. All other orders are resolved by the traversal
+     * itself. The keys are sorted with an LSD radix sort, which skips any
+     * byte that is the same for all keys. Ties are broken by canonical order.
+     */
+    void sortEntries();
     
 #pragma mark -
 #pragma mark Constructors
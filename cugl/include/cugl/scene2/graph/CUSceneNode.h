@@ -44,6 +44,7 @@
 
 #include <cugl/math/cu_math.h>
 #include <cugl/util/CUDebug.h>
+#include <cugl/util/CUSymbol.h>
 #include <cugl/render/CUSpriteBatch.h>
 #include <cugl/render/CUScissor.h>
 #include <cugl/assets/CUJsonValue.h>
@@ -204,17 +205,20 @@ protected:
     std::string _name;
 
     /**
-     * A cached has value of _name.
+     * The interned value of _name.
      *
-     * This value is used to speed up look-ups by string.
+     * This value is used to speed up look-ups by name.
      */
-    size_t _hashOfName;
+    Symbol _symbol;
 
     /** The class name for the specific subclass */
     std::string _classname;
 
     /** The rendering priority; used by {@link OrderedNode} */
     float _priority;
+    
+    /** Whether this node is a render barrier for {@link OrderedNode} */
+    bool _isBarrier;
 
     /** The defining JSON data for this node (if any) */
     std::shared_ptr<JsonValue> _json;
@@ -578,7 +582,18 @@ public:
      *
      * @return a string that is used to identify the node.
      */
-    const std::string getName() const { return _name; }
+    const std::string& getName() const { return _name; }
+    
+    /**
+     * Returns the interned name of this node.
+     *
+     * This is the same as {@link #getName}, except that it is represented
+     * as a {@link Symbol}. Look-ups by symbol compare handles instead of
+     * strings, and so should be preferred in code that runs every frame.
+     *
+     * @return the interned name of this node.
+     */
+    Symbol getSymbol() const { return _symbol; }
     
     /**
      * Sets a string that is used to identify the node.
@@ -589,9 +604,9 @@ public:
      *
      * @param name  A string that is used to identify the node.
      */
-    void setName(const std::string name) {
+    void setName(const std::string& name) {
         _name = name;
-        _hashOfName = std::hash<std::string>()(_name);
+        _symbol = Symbol(name);
     }
 
     /**
@@ -604,6 +619,19 @@ public:
      */
     const std::string getClassName() const { return _classname; }
 
+    /**
+     * Returns true if this node is a render barrier.
+     *
+     * A render barrier is a node that is rendered as a single unit by any
+     * {@link OrderedNode} ancestor. Its descendants are never interleaved
+     * with the other descendants of that ancestor. This flag is set by the
+     * constructor of a subclass (such as {@link OrderedNode}), so that it
+     * can be checked without comparing class names.
+     *
+     * @return true if this node is a render barrier.
+     */
+    bool isRenderBarrier() const { return _isBarrier; }
+
     /**
      * Returns a string representation of this node for debugging purposes.
      *
@@ -1593,7 +1621,25 @@ public:
      *
      * @return the (first) child with the given name.
      */
-    std::shared_ptr<SceneNode> getChildByName(const std::string name) const;
+    std::shared_ptr<SceneNode> getChildByName(const std::string& name) const;
+    
+    /**
+     * Returns the (first) child with the given name.
+     *
+     * If there is more than one child of the given name, it returns the first
+     * one that is found. For the base SceneNode class, children are always
+     * enumerated in the order that they are added. However, this is not
+     * guaranteed for all subclasses of SceneNode. Hence it is very important
+     * that names be unique.
+     *
+     * This version compares the interned names of the children, and so
+     * does not perform any string comparisons.
+     *
+     * @param name  An identifier to find the child node.
+     *
+     * @return the (first) child with the given name.
+     */
+    std::shared_ptr<SceneNode> getChildByName(const Symbol name) const;
     
     /**
      * Returns the (first) child with the given name, typecast to a shared T pointer.
@@ -1614,7 +1660,27 @@ public:
      * @return the (first) child with the given name, typecast to a shared T pointer.
      */
     template <typename T>
-    inline std::shared_ptr<T> getChildByName(const std::string name) const {
+    inline std::shared_ptr<T> getChildByName(const std::string& name) const {
+        return std::dynamic_pointer_cast<T>(getChildByName(name));
+    }
+    
+    /**
+     * Returns the (first) child with the given name, typecast to a shared T pointer.
+     *
+     * This method is provided to simplify the polymorphism of a scene graph.
+     * While all children are a subclass of type Node, you may want to access
+     * them by their specific subclass.  If the child is not an instance of
+     * type T (or a subclass), this method returns nullptr.
+     *
+     * This version compares the interned names of the children, and so
+     * does not perform any string comparisons.
+     *
+     * @param name  An identifier to find the child node.
+     *
+     * @return the (first) child with the given name, typecast to a shared T pointer.
+     */
+    template <typename T>
+    inline std::shared_ptr<T> getChildByName(const Symbol name) const {
         return std::dynamic_pointer_cast<T>(getChildByName(name));
     }
 
@@ -1785,7 +1851,20 @@ public:
      *
      * @param name  A string to identify the node.
      */
-    void removeChildByName(const std::string name);
+    void removeChildByName(const std::string& name);
+    
+    /**
+     * Removes a child from the Node by name.
+     *
+     * If there is more than one child of the given name, it removes the first
+     * one that is found. For the base SceneNode class, children are always
+     * enumerated in the order that they are added.  However, this is not
+     * guaranteed for subclasses of SceneNode. Hence it is very important
+     * that names be unique.
+     *
+     * @param name  A symbol to identify the node.
+     */
+    void removeChildByName(const Symbol name);
     
     /**
      * Removes all children from this Node.
@@ -0,0 +1,284 @@
+//
+//  CUTiledTextureNode.h
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides a scene graph node for drawing a tiled texture. A
+//  tiled texture is a streaming texture for images that are too large to be
+//  a single texture, such as level backgrounds. This node only draws (and
+//  hence only loads) the tiles that are visible to the camera, at a level of
+//  detail appropriate for the camera zoom.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#ifndef __CU_TILED_TEXTURE_NODE_H__
+#define __CU_TILED_TEXTURE_NODE_H__
+#include <cugl/scene2/graph/CUSceneNode.h>
+#include <cugl/render/CUTiledTexture.h>
+#include <cugl/render/CUSpriteVertex.h>
+#include <cugl/render/CUCamera.h>
+#include <vector>
+
+namespace cugl {
+
+    /**
+     * The classes to construct an 2-d scene graph.
+     *
+     * This namespace was chosen to future-proof the game engine. We will
+     * eventually want to add 3-d scene graphs as well, and this namespace
+     * will prevent any collisions with those scene graph nodes.
+     */
+    namespace scene2 {
+
+#pragma mark -
+#pragma mark TiledTextureNode
+/**
+ * This is a scene graph node for drawing a tiled texture.
+ *
+ * A {@link TiledTexture} is a streaming texture for images that are too large
+ * to fit in a single texture. This node stretches the image over its content
+ * area, just like a {@link PolygonNode} with a rectangle. However, it only
+ * draws the tiles that are visible to the camera. In addition, it chooses the
+ * pyramid level so that there is roughly one image pixel per screen pixel.
+ *
+ * The camera is the one attached to the scene of this node, unless a camera
+ * is assigned with {@link #setCamera}. If the node has no camera, it uses the
+ * perspective of the sprite batch to determine what is visible, and always
+ * draws the finest level.
+ *
+ * This node does not update its texture. The owner of the texture must call
+ * {@link TiledTexture#update} once per frame, typically in the update pass of
+ * the application, before the scene is drawn. Hence a texture may be shared
+ * by several nodes without advancing more than once a frame.
+ */
+class TiledTextureNode : public SceneNode {
+protected:
+    /** The tiled texture */
+    std::shared_ptr<TiledTexture> _texture;
+    /** The camera override (nullptr to use the scene camera) */
+    std::shared_ptr<Camera> _camera;
+    /** The pyramid level bias (positive values choose coarser levels) */
+    float _bias;
+    /** The pyramid level drawn in the last frame */
+    Uint32 _level;
+    /** The patches to draw (cached to reduce allocations) */
+    std::vector<TiledTexture::Patch> _patches;
+
+#pragma mark -
+#pragma mark Constructors
+public:
+    /**
+     * Creates an uninitialized node.
+     *
+     * You must initialize this node before use.
+     *
+     * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate a Node on the
+     * heap, use one of the static constructors instead.
+     */
+    TiledTextureNode();
+
+    /**
+     * Deletes this node, disposing all resources
+     */
+    ~TiledTextureNode() { dispose(); }
+
+    /**
+     * Disposes all of the resources used by this node.
+     *
+     * A disposed Node can be safely reinitialized. Any children owned by this
+     * node will be released. They will be deleted if no other object owns them.
+     *
+     * It is unsafe to call this on a Node that is still currently inside of
+     * a scene graph.
+     */
+    virtual void dispose() override;
+
+    /**
+     * Initializes a node with the given tiled texture.
+     *
+     * The content size of this node is the size of the image in pixels.
+     *
+     * @param texture   The tiled texture
+     *
+     * @return true if initialization was successful.
+     */
+    bool initWithTexture(const std::shared_ptr<TiledTexture>& texture);
+
+    /**
+     * Initializes a node with the tiled texture of the given manifest.
+     *
+     * The content size of this node is the size of the image in pixels.
+     * See {@link TiledTexture} for a description of the manifest.
+     *
+     * @param manifest  The tiled texture manifest
+     *
+     * @return true if initialization was successful.
+     */
+    bool initWithFile(const std::string& manifest) {
+        return initWithTexture(TiledTexture::allocWithFile(manifest));
+    }
+
+    /**
+     * Performs a shallow copy of this Node into dst.
+     *
+     * No children from this node are copied, and no children of dst are
+     * modified. In addition, the parents of both Nodes are unchanged. However,
+     * all other attributes of this node are copied. The tiled texture is
+     * shared, not copied.
+     *
+     * @param dst   The Node to copy into
+     *
+     * @return A reference to dst for chaining.
+     */
+    virtual std::shared_ptr<SceneNode> copy(const std::shared_ptr<SceneNode>& dst) const override;
+
+#pragma mark -
+#pragma mark Static Constructors
+    /**
+     * Returns a newly allocated node with the given tiled texture.
+     *
+     * The content size of this node is the size of the image in pixels.
+     *
+     * @param texture   The tiled texture
+     *
+     * @return a newly allocated node with the given tiled texture.
+     */
+    static std::shared_ptr<TiledTextureNode> allocWithTexture(const std::shared_ptr<TiledTexture>& texture) {
+        std::shared_ptr<TiledTextureNode> node = std::make_shared<TiledTextureNode>();
+        return (node->initWithTexture(texture) ? node : nullptr);
+    }
+
+    /**
+     * Returns a newly allocated node with the tiled texture of the given manifest.
+     *
+     * The content size of this node is the size of the image in pixels.
+     * See {@link TiledTexture} for a description of the manifest.
+     *
+     * @param manifest  The tiled texture manifest
+     *
+     * @return a newly allocated node with the tiled texture of the given manifest.
+     */
+    static std::shared_ptr<TiledTextureNode> allocWithFile(const std::string& manifest) {
+        std::shared_ptr<TiledTextureNode> node = std::make_shared<TiledTextureNode>();
+        return (node->initWithFile(manifest) ? node : nullptr);
+    }
+
+#pragma mark -
+#pragma mark Attributes
+    /**
+     * Returns the tiled texture for this node.
+     *
+     * @return the tiled texture for this node.
+     */
+    const std::shared_ptr<TiledTexture>& getTexture() const { return _texture; }
+
+    /**
+     * Sets the tiled texture for this node.
+     *
+     * This method does not change the content size of this node.
+     *
+     * @param texture   The tiled texture for this node.
+     */
+    void setTexture(const std::shared_ptr<TiledTexture>& texture) { _texture = texture; }
+
+    /**
+     * Returns the camera used to determine the visible tiles.
+     *
+     * If this value is nullptr, the node uses the camera of its scene.
+     *
+     * @return the camera used to determine the visible tiles.
+     */
+    const std::shared_ptr<Camera>& getCamera() const { return _camera; }
+
+    /**
+     * Sets the camera used to determine the visible tiles.
+     *
+     * If this value is nullptr, the node uses the camera of its scene.
+     *
+     * @param camera    The camera used to determine the visible tiles.
+     */
+    void setCamera(const std::shared_ptr<Camera>& camera) { _camera = camera; }
+
+    /**
+     * Returns the pyramid level bias.
+     *
+     * The bias is added to the (base 2) logarithm of the texel density when
+     * choosing the level. Positive values choose coarser levels, trading
+     * sharpness for fewer tiles. The default is 0.
+     *
+     * @return the pyramid level bias.
+     */
+    float getLevelBias() const { return _bias; }
+
+    /**
+     * Sets the pyramid level bias.
+     *
+     * The bias is added to the (base 2) logarithm of the texel density when
+     * choosing the level. Positive values choose coarser levels, trading
+     * sharpness for fewer tiles. The default is 0.
+     *
+     * @param bias  The pyramid level bias.
+     */
+    void setLevelBias(float bias) { _bias = bias; }
+
+    /**
+     * Returns the pyramid level drawn in the last frame.
+     *
+     * @return the pyramid level drawn in the last frame.
+     */
+    Uint32 getLevel() const { return _level; }
+
+#pragma mark -
+#pragma mark Rendering
+    /**
+     * Draws this Node via the given SpriteBatch.
+     *
+     * This method only draws the visible tiles of the texture. Any missing
+     * tiles are requested, and drawn from a coarser level in the meantime.
+     *
+     * @param batch     The SpriteBatch to draw with.
+     * @param transform The global transformation matrix.
+     * @param tint      The tint to blend with the Node color.
+     */
+    virtual void draw(const std::shared_ptr<SpriteBatch>& batch,
+                      const Affine2& transform, Color4 tint) override;
+
+private:
+    /** This macro disables the copy constructor (not allowed on scene graphs) */
+    CU_DISALLOW_COPY_AND_ASSIGN(TiledTextureNode);
+};
+
+    }
+}
+
+#endif /* __CU_TILED_TEXTURE_NODE_H__ */
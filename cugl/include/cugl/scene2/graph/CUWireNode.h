@@ -132,7 +132,7 @@ public:
      */
     WireNode() : TexturedNode(), _traversal(poly2::Traversal::CLOSED) {
         _classname = "WireNode";
-        _name = "WireNode";
+        setName("WireNode");
     }
     
     /**
@@ -95,7 +95,7 @@ protected:
     };
     
     /** The map of keys to layout information */
-    std::unordered_map<std::string,Entry> _entries;
+    std::unordered_map<Symbol,Entry> _entries;
     
 #pragma mark -
 #pragma mark Constructors
@@ -219,10 +219,10 @@ protected:
     };
 
     /** The priority ordering of this layout */
-    std::vector<std::string> _priority;
+    std::vector<Symbol> _priority;
     
     /** The map of keys to layout information */
-    std::unordered_map<std::string,Entry> _entries;
+    std::unordered_map<Symbol,Entry> _entries;
     
     /** Whether the layout is horizontal or vertical */
     bool _horizontal;
@@ -90,7 +90,7 @@ protected:
     };
     
     /** The map of keys to layout information */
-    std::unordered_map<std::string,Entry> _entries;
+    std::unordered_map<Symbol,Entry> _entries;
     /** The number of columns of grid regions */
     Uint32 _gwidth;
     /** The number of rows of grid regions */
@@ -32,6 +32,7 @@
 #ifndef __CU_LAYOUT_H__
 #define __CU_LAYOUT_H__
 #include <cugl/scene2/graph/CUSceneNode.h>
+#include <cugl/util/CUSymbol.h>
 #include <cugl/assets/CUJsonValue.h>
 
 namespace  cugl {
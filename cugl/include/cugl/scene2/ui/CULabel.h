@@ -45,6 +45,7 @@
 #include <string>
 #include <cugl/scene2/graph/CUSceneNode.h>
 #include <cugl/render/CUTextAlignment.h>
+#include <cugl/render/CUSpriteCache.h>
 
 namespace cugl {
 
@@ -130,6 +131,10 @@ protected:
     Rect _bounds;
     /** The glyph runs to render */
     std::unordered_map<GLuint, std::shared_ptr<GlyphRun>> _glyphrun;
+    /** The transformed glyph runs from the last stable draw (in map order) */
+    std::vector<SpriteCache> _cache;
+    /** The transformed drop shadow runs from the last stable draw (in map order) */
+    std::vector<SpriteCache> _shadow;
 
 public:
 #pragma mark -
@@ -1370,6 +1375,14 @@ protected:
      */
     void updateColor();
 
+    /**
+     * Invalidates the cached vertices of the glyph runs.
+     *
+     * This method must be called whenever the glyph runs change. It also sizes
+     * the caches to match the glyph runs.
+     */
+    void invalidateCache();
+
     /**
      * Resizes the content bounds to fit the text.
      */
@@ -51,6 +51,7 @@
 #include <cugl/render/CUMesh.h>
 #include <cugl/render/CUSpriteVertex.h>
 #include <cugl/render/CUSpriteBatch.h>
+#include <cugl/render/CUSpriteCache.h>
 
 namespace cugl {
     /**
@@ -89,6 +90,8 @@ protected:
     bool _rendered;
     /** The render vertices for this node */
     Mesh<SpriteVertex2> _mesh;
+    /** The transformed vertices from the last stable draw */
+    SpriteCache _cache;
     /** The render indices for this node */
     std::vector<Uint32> _indices;
     
@@ -53,6 +53,8 @@
 #ifndef __CU_SCROLL_PANE_H__
 #define __CU_SCROLL_PANE_H__
 #include <cugl/scene2/graph/CUSceneNode.h>
+#include <functional>
+#include <deque>
 
 namespace cugl {
     /**
@@ -125,8 +127,49 @@ namespace cugl {
  * block the rotation. If this is a problem you should either ignore spin
  * input in your application or set {@link #setConstrained} to false. However,
  * the latter will mean that the user can navigate outside of the backing area.
+ *
+ * Scroll panes can also be used as a virtualized list (see {@link #setList}).
+ * A list does not have a child for each row. Instead, it only has nodes for
+ * the rows that are visible (plus a small margin). As the pane is navigated,
+ * row nodes that scroll out of view are recycled and rebound to the rows that
+ * scroll into view. Hence the cost of a list is proportional to the number of
+ * visible rows, and not the total number of rows.
  */
 class ScrollPane : public SceneNode {
+public:
+    /**
+     * @typedef RowFactory
+     *
+     * This type represents a function to create a row node for a list.
+     *
+     * The node is bound to a row with a {@link RowBinder} before it is
+     * shown. Row nodes are recycled, so the factory is only called when
+     * there are more visible rows than nodes.
+     *
+     * The function type is equivalent to
+     *
+     *      std::function<std::shared_ptr<SceneNode>()>
+     */
+    typedef std::function<std::shared_ptr<SceneNode>()> RowFactory;
+
+    /**
+     * @typedef RowBinder
+     *
+     * This type represents a function to bind a row node to a list row.
+     *
+     * The binder should update the contents of the node (e.g. the text of
+     * its labels) for the given row. It should not position the node, as
+     * that is done by the scroll pane.
+     *
+     * The function type is equivalent to
+     *
+     *      std::function<void(size_t row, const std::shared_ptr<SceneNode>& node)>
+     *
+     * @param row   The list row
+     * @param node  The row node to update
+     */
+    typedef std::function<void(size_t row, const std::shared_ptr<SceneNode>& node)> RowBinder;
+
 #pragma mark Values
 protected:
     /** The interior rectangle representing the internal content bounds */
@@ -152,6 +195,51 @@ protected:
     /** The masking scissor for this scroll pane */
     std::shared_ptr<Scissor> _panemask;
 
+    /** Whether this scroll pane is a virtualized list */
+    bool _listmode;
+    /** The number of rows in the list */
+    size_t _rowcount;
+    /** The height of each row in the list */
+    float _rowheight;
+    /** The number of extra rows to bind above and below the visible rows */
+    Uint32 _rowmargin;
+    /** The list row of the first row node */
+    size_t _rowfirst;
+    /** The row nodes for the consecutive rows starting at _rowfirst */
+    std::deque<std::shared_ptr<SceneNode>> _rowslots;
+    /** The unused row nodes (hidden children of this pane) */
+    std::vector<std::shared_ptr<SceneNode>> _rowpool;
+    /** The function to create new row nodes */
+    RowFactory _rowfactory;
+    /** The function to bind row nodes to list rows */
+    RowBinder _rowbinder;
+
+    /**
+     * Binds row nodes to the list rows that are visible.
+     *
+     * Row nodes for rows that are no longer visible (or in the margin) are
+     * hidden and returned to the pool. Rows that have become visible are
+     * assigned a node from the pool, or a new one if the pool is empty.
+     * Rows that stay visible are not rebound.
+     */
+    void layoutRows();
+
+    /**
+     * Returns a row node bound to the given list row.
+     *
+     * @param row   The list row
+     *
+     * @return a row node bound to the given list row.
+     */
+    std::shared_ptr<SceneNode> acquireRow(size_t row);
+
+    /**
+     * Hides the given row node and returns it to the pool.
+     *
+     * @param node  The row node to recycle
+     */
+    void recycleRow(const std::shared_ptr<SceneNode>& node);
+
 #pragma mark -
 #pragma mark Constructors
 public:
@@ -867,6 +955,123 @@ public:
      */
     void resetPane();
 
+#pragma mark -
+#pragma mark List Virtualization
+    /**
+     * Makes this scroll pane a virtualized list with the given rows.
+     *
+     * The list is a single column of rows of the given height, with row 0 at
+     * the top. The interior is resized to fit all of the rows (or the content
+     * size, whichever is larger), and the pane is reset to show row 0.
+     *
+     * The pane only has nodes for the visible rows (plus the row margin).
+     * Row nodes are created by the factory as needed, and bound to a row
+     * with the binder. The binder is only called when a node is assigned to
+     * a new row, so it is not called every frame. Use {@link #refreshRows}
+     * if the data for the visible rows has changed.
+     *
+     * Row nodes are positioned with their bottom left corner at the bottom
+     * left corner of their row. They are children of this pane, but they
+     * should not be modified except by the binder. Any layout manager for
+     * this pane should ignore them.
+     *
+     * @param rows      The number of rows
+     * @param height    The height of each row
+     * @param factory   The function to create a row node
+     * @param binder    The function to bind a row node to a row
+     */
+    void setList(size_t rows, float height, RowFactory factory, RowBinder binder);
+
+    /**
+     * Removes the virtualized list from this scroll pane.
+     *
+     * All row nodes are removed from this pane. The interior is unchanged.
+     */
+    void clearList();
+
+    /**
+     * Returns true if this scroll pane is a virtualized list.
+     *
+     * @return true if this scroll pane is a virtualized list.
+     */
+    bool isList() const { return _listmode; }
+
+    /**
+     * Returns the number of rows in the list.
+     *
+     * @return the number of rows in the list.
+     */
+    size_t getRowCount() const { return _rowcount; }
+
+    /**
+     * Sets the number of rows in the list.
+     *
+     * The interior is resized to fit the rows, keeping the top of the list
+     * in place, so appending rows does not disturb the current scroll
+     * position. Rows that stay visible are not rebound. Call
+     * {@link #refreshRows} if their data has changed as well.
+     *
+     * @param rows  The number of rows in the list.
+     */
+    void setRowCount(size_t rows);
+
+    /**
+     * Returns the height of each row in the list.
+     *
+     * @return the height of each row in the list.
+     */
+    float getRowHeight() const { return _rowheight; }
+
+    /**
+     * Returns the number of extra rows bound above and below the visible rows.
+     *
+     * The margin allows small scrolls without binding any rows. The default
+     * is 2.
+     *
+     * @return the number of extra rows bound above and below the visible rows.
+     */
+    Uint32 getRowMargin() const { return _rowmargin; }
+
+    /**
+     * Sets the number of extra rows bound above and below the visible rows.
+     *
+     * The margin allows small scrolls without binding any rows. The default
+     * is 2.
+     *
+     * @param margin    The number of extra rows bound above and below the visible rows.
+     */
+    void setRowMargin(Uint32 margin);
+
+    /**
+     * Returns the number of row nodes bound to list rows.
+     *
+     * This is the number of visible rows plus the margin. It does not include
+     * the unused nodes in the pool.
+     *
+     * @return the number of row nodes bound to list rows.
+     */
+    size_t getBoundRowCount() const { return _rowslots.size(); }
+
+    /**
+     * Returns the row node bound to the given list row.
+     *
+     * This method returns nullptr if the row is not visible (or in the
+     * margin), and so has no node.
+     *
+     * @param row   The list row
+     *
+     * @return the row node bound to the given list row.
+     */
+    std::shared_ptr<SceneNode> getRowNode(size_t row) const;
+
+    /**
+     * Rebinds all of the row nodes to their rows.
+     *
+     * This method should be called when the data for the visible rows has
+     * changed.
+     */
+    void refreshRows();
+
 #pragma mark -
 #pragma mark Rendering
     /**
@@ -865,6 +865,104 @@ namespace cugl {
      */
     size_t getUTF8Length(const char* substr, const char* end);
 
+    /**
+     * Returns true if str is a valid UTF8 string.
+     *
+     * ASCII runs are validated several bytes at a time (using SIMD where
+     * available), so this method is very fast on mostly ASCII text.
+     *
+     * @param str   The string to test
+     *
+     * @return true if str is a valid UTF8 string.
+     */
+    bool isValidUTF8(const std::string& str);
+
+    /**
+     * Returns true if substr is a valid UTF8 string.
+     *
+     * The C-style string substr need not be null-terminated. Instead,
+     * the termination is indicated by the parameter end. This provides
+     * efficient substring processing.
+     *
+     * ASCII runs are validated several bytes at a time (using SIMD where
+     * available), so this method is very fast on mostly ASCII text.
+     *
+     * @param substr    The start of the string to test
+     * @param end       The end of the string to test
+     *
+     * @return true if substr is a valid UTF8 string.
+     */
+    bool isValidUTF8(const char* substr, const char* end);
+
+    /**
+     * Returns a pointer to the first non-ASCII byte of substr.
+     *
+     * If substr is entirely ASCII, this function returns end. The bytes are
+     * scanned several at a time (using SIMD where available). Text decoders
+     * can use this to copy ASCII runs without decoding them.
+     *
+     * @param substr    The start of the string to scan
+     * @param end       The end of the string to scan
+     *
+     * @return a pointer to the first non-ASCII byte of substr.
+     */
+    const char* skipASCII(const char* substr, const char* end);
+
+    /**
+     * Returns the code point at substr, advancing substr to the next one.
+     *
+     * This is a fast, unchecked alternative to the utf8 iterators. ASCII
+     * characters require a single comparison. The string should be validated
+     * with {@link isValidUTF8} first. An invalid lead byte or a truncated
+     * sequence produces the replacement character 0xFFFD, but this function
+     * never reads beyond end.
+     *
+     * @param substr    The current position in the string (updated)
+     * @param end       The end of the string
+     *
+     * @return the code point at substr.
+     */
+    inline Uint32 nextCodePoint(const char*& substr, const char* end) {
+        Uint32 code = (Uint8)*substr++;
+        if (code < 0x80) {
+            return code;
+        }
+
+        int extra;
+        if ((code & 0xE0) == 0xC0) {
+            extra = 1; code &= 0x1F;
+        } else if ((code & 0xF0) == 0xE0) {
+            extra = 2; code &= 0x0F;
+        } else if ((code & 0xF8) == 0xF0) {
+            extra = 3; code &= 0x07;
+        } else {
+            return 0xFFFD;
+        }
+        if (end-substr < extra) {
+            substr = end;
+            return 0xFFFD;
+        }
+        while (extra--) {
+            code = (code << 6) | ((Uint8)*substr++ & 0x3F);
+        }
+        return code;
+    }
+
+    /**
+     * Appends the code points for the elements of substr to result.
+     *
+     * This is a version of {@link getCodePoints} that allows the caller to
+     * reuse a buffer. ASCII runs are copied without decoding. The string
+     * should be validated with {@link isValidUTF8} first.
+     *
+     * @param substr    The start of the string to convert
+     * @param end       The end of the string to convert
+     * @param result    The buffer to store the code points
+     *
+     * @return the number of code points appended
+     */
+    size_t getCodePoints(const char* substr, const char* end, std::vector<Uint32>& result);
+
 
     }
 }
@@ -0,0 +1,269 @@
+//
+//  CUSymbol.h
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides interned strings (symbols). Much of the engine uses
+//  strings as keys (asset keys, node names, action keys, sound keys). These
+//  strings are hashed and compared on every look-up.  A symbol is a handle
+//  to a single, shared copy of a string, so two symbols are equal if and
+//  only if their handles are equal. This makes hashing and comparison O(1).
+//
+//  Symbols are never freed.  They should be used for a bounded set of names,
+//  like the keys in an asset directory, and not for arbitrary user text.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#ifndef __CU_SYMBOL_H__
+#define __CU_SYMBOL_H__
+#include <SDL/SDL.h>
+#include <functional>
+#include <string>
+
+namespace cugl {
+
+/**
+ * This class represents an interned string.
+ *
+ * A symbol is a handle to the unique copy of a string in a global table.
+ * Creating a symbol from a string requires a hash table look-up (and a
+ * lock, as symbols may be created in any thread). However, once created,
+ * symbols are hashed and compared by their handle. This makes them ideal
+ * keys for hash tables that are queried every frame.
+ *
+ * The default symbol is the empty string. Symbols are never removed from
+ * the global table, and the string of a symbol is valid for the lifetime
+ * of the program. Hence they should be used for a bounded set of names,
+ * such as asset keys and node names, and not for arbitrary user text.
+ *
+ * Symbols may only be created from strings explicitly. This prevents
+ * ambiguity between the string and the symbol versions of a method.
+ */
+class Symbol {
+public:
+    /**
+     * This struct is an entry in the global symbol table.
+     *
+     * The entry caches the string hash so that symbols can be used with
+     * classes that key on the string hash.
+     */
+    struct Entry {
+        /** The interned string */
+        std::string name;
+        /** The string hash of the name */
+        size_t hash;
+        /** The unique id of the symbol (0 for the empty string) */
+        Uint32 id;
+    };
+
+private:
+    /** The table entry for this symbol */
+    const Entry* _entry;
+
+    /**
+     * Returns the table entry for the empty string.
+     *
+     * @return the table entry for the empty string.
+     */
+    static const Entry* blank();
+
+    /**
+     * Returns the table entry for the given string, adding it if necessary
+     *
+     * @param name  The string to intern
+     *
+     * @return the table entry for the given string
+     */
+    static const Entry* intern(const std::string& name);
+
+public:
+    /**
+     * Creates a symbol for the empty string.
+     */
+    Symbol() : _entry(blank()) {}
+
+    /**
+     * Creates a symbol for the given string.
+     *
+     * The string is added to the global table if it is not already there.
+     *
+     * @param name  The string to intern
+     */
+    explicit Symbol(const std::string& name) : _entry(intern(name)) {}
+
+    /**
+     * Creates a symbol for the given string.
+     *
+     * The string is added to the global table if it is not already there.
+     *
+     * @param name  The string to intern
+     */
+    explicit Symbol(const char* name) : _entry(intern(std::string(name))) {}
+
+    /**
+     * Returns the symbol for the given string, if it exists.
+     *
+     * Unlike the constructor, this method does not add the string to the
+     * global table. If the string has not been interned, this method returns
+     * false and leaves the symbol unchanged.
+     *
+     * @param name      The string to look up
+     * @param symbol    The symbol to store the result
+     *
+     * @return true if the string has been interned
+     */
+    static bool find(const std::string& name, Symbol& symbol);
+
+    /**
+     * Returns the number of symbols in the global table.
+     *
+     * This value includes the empty symbol.
+     *
+     * @return the number of symbols in the global table.
+     */
+    static size_t count();
+
+#pragma mark Attributes
+    /**
+     * Returns the interned string.
+     *
+     * The reference is valid for the lifetime of the program.
+     *
+     * @return the interned string.
+     */
+    const std::string& str() const { return _entry->name; }
+
+    /**
+     * Returns the interned string as a C-string.
+     *
+     * The pointer is valid for the lifetime of the program.
+     *
+     * @return the interned string as a C-string.
+     */
+    const char* c_str() const { return _entry->name.c_str(); }
+
+    /**
+     * Returns the unique id of this symbol.
+     *
+     * Ids are assigned in the order that the strings are interned, starting
+     * at 0 for the empty string. Ids are not stable across runs, and should
+     * not be serialized.
+     *
+     * @return the unique id of this symbol.
+     */
+    Uint32 id() const { return _entry->id; }
+
+    /**
+     * Returns the hash of the interned string.
+     *
+     * This is the same value as std::hash<std::string> for the string.
+     *
+     * @return the hash of the interned string.
+     */
+    size_t hash() const { return _entry->hash; }
+
+    /**
+     * Returns true if this is the symbol for the empty string.
+     *
+     * @return true if this is the symbol for the empty string.
+     */
+    bool empty() const { return _entry->id == 0; }
+
+#pragma mark Comparisons
+    /**
+     * Returns true if this symbol is equal to the given symbol.
+     *
+     * @param other The symbol to compare against
+     *
+     * @return true if this symbol is equal to the given symbol.
+     */
+    bool operator==(const Symbol other) const { return _entry == other._entry; }
+
+    /**
+     * Returns true if this symbol is not equal to the given symbol.
+     *
+     * @param other The symbol to compare against
+     *
+     * @return true if this symbol is not equal to the given symbol.
+     */
+    bool operator!=(const Symbol other) const { return _entry != other._entry; }
+
+    /**
+     * Returns true if this symbol was interned before the given symbol.
+     *
+     * This ordering is not alphabetical. It is provided so that symbols may
+     * be used in ordered containers.
+     *
+     * @param other The symbol to compare against
+     *
+     * @return true if this symbol was interned before the given symbol.
+     */
+    bool operator<(const Symbol other) const { return _entry->id < other._entry->id; }
+
+    /**
+     * Returns true if this symbol represents the given string.
+     *
+     * @param other The string to compare against
+     *
+     * @return true if this symbol represents the given string.
+     */
+    bool operator==(const std::string& other) const { return _entry->name == other; }
+
+    /**
+     * Returns true if this symbol does not represent the given string.
+     *
+     * @param other The string to compare against
+     *
+     * @return true if this symbol does not represent the given string.
+     */
+    bool operator!=(const std::string& other) const { return _entry->name != other; }
+
+    /**
+     * Casts from a symbol to its interned string.
+     */
+    operator const std::string&() const { return _entry->name; }
+};
+
+}
+
+namespace std {
+    /**
+     * The hash function for symbols.
+     *
+     * As symbols are unique, this hashes the handle and not the string.
+     */
+    template <>
+    struct hash<cugl::Symbol> {
+        /**
+         * Returns the hash of the given symbol.
+         *
+         * @param symbol    The symbol to hash
+         *
+         * @return the hash of the given symbol.
+         */
+        size_t operator()(const cugl::Symbol& symbol) const {
+            return std::hash<Uint32>()(symbol.id());
+        }
+    };
+}
+
+#endif /* __CU_SYMBOL_H__ */
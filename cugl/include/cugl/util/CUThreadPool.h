@@ -220,6 +220,13 @@ public:
      * @return whether the thread pool has been shut down.
      */
     bool isShutdown() const { return _workers.size() == _complete; }
+
+    /**
+     * Returns the number of worker threads in this thread pool.
+     *
+     * @return the number of worker threads in this thread pool.
+     */
+    size_t getThreadCount() const { return _workers.size(); }
   
 private:  
     /** Copying is only allowed via shared pointer. */
@@ -46,9 +46,55 @@
 //  Version: 5/20/19
 //
 #include <cugl/cugl.h>
+#include <algorithm>
+#include <cmath>
+#include <set>
 
 using namespace cugl;
 
+/**
+ * Returns true if the JSON tree contains a string in the given key set
+ *
+ * This function is used to determine which scenes depend upon a reloaded
+ * asset, since scenes reference assets by their keys.
+ *
+ * @param json  The JSON tree to search
+ * @param keys  The asset keys
+ *
+ * @return true if the JSON tree contains a string in the given key set
+ */
+static bool references(const std::shared_ptr<JsonValue>& json, const std::unordered_set<std::string>& keys) {
+    if (json->isString()) {
+        return keys.find(json->asString()) != keys.end();
+    }
+    for(int ii = 0; ii < json->size(); ii++) {
+        if (references(json->get(ii),keys)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Returns the asset file for the given directory entry
+ *
+ * Assets such as JSON files are specified by a path string, while other
+ * assets specify the path with the "file" attribute. This function returns
+ * the empty string if the entry has no file (e.g. a scene or waveform).
+ *
+ * @param json  The directory entry
+ *
+ * @return the asset file for the given directory entry
+ */
+static std::string entry_source(const std::shared_ptr<JsonValue>& json) {
+    if (json->isString()) {
+        return json->asString();
+    } else if (json->isObject()) {
+        return json->getString("file","");
+    }
+    return "";
+}
+
 #pragma mark -
 #pragma mark Constructors
 /**
@@ -65,6 +111,8 @@ using namespace cugl;
  */
 bool AssetManager::init() {
     _workers = ThreadPool::alloc(1);
+    _mainThread = SDL_ThreadID();
+    _evictStart.mark();
     return true;
 }
 
@@ -76,8 +124,21 @@ bool AssetManager::init() {
  * threads) and reattach all loaders to use the asset manager again.
  */
 void AssetManager::dispose() {
+    stopWatching();
     detachAll();
     _workers = nullptr;
+    _entries.clear();
+    _sources.clear();
+    _directories.clear();
+    _reloader = nullptr;
+    _budgets.clear();
+    _peaks.clear();
+    _evicted.clear();
+    _budget = 0;
+    _peak = 0;
+    _evictCount = 0;
+    _evictBytes = 0;
+    _restoreCount = 0;
 }
 
 #pragma mark -
@@ -121,6 +182,7 @@ bool AssetManager::readCategory(size_t hash, const std::shared_ptr<JsonValue>& j
         std::shared_ptr<JsonValue> child = json->get(ii);
         success = loader->load(child) && success;
     }
+    recordCategory(hash,json);
     
     return success;
 }
@@ -176,6 +238,12 @@ void AssetManager::readCategory(size_t hash, const std::shared_ptr<JsonValue>& j
         std::shared_ptr<JsonValue> child = json->get(ii);
         loader->loadAsync(child, callback);
     }
+    
+    // This may be called outside of the main thread
+    Application::get()->schedule([=](void) {
+        this->recordCategory(hash,json);
+        return false;
+    });
 }
 
 /**
@@ -207,10 +275,108 @@ bool AssetManager::purgeCategory(size_t hash, const std::shared_ptr<JsonValue>&
         std::shared_ptr<JsonValue> child = json->get(ii);
         success = loader->unload(child) && success;
     }
+    forgetCategory(hash,json);
     
     return success;
 }
 
+/**
+ * Records the directory entries for an asset category
+ *
+ * This method records the entries so that they may be reloaded when
+ * their asset files change.  It must be called in the main thread.
+ *
+ * @param hash  The hash of the asset type
+ * @param json  The child of asset directory with these assets
+ */
+void AssetManager::recordCategory(size_t hash, const std::shared_ptr<JsonValue>& json) {
+    auto& entries = _entries[hash];
+    for(int ii = 0; ii < json->size(); ii++) {
+        std::shared_ptr<JsonValue> child = json->get(ii);
+        entries[child->key()] = child;
+        
+        std::string source = entry_source(child);
+        if (source.empty()) {
+            continue;
+        }
+        
+        std::string path = AssetWatcher::resolve(source);
+        std::pair<size_t,std::string> item(hash,child->key());
+        auto& assets = _sources[path];
+        if (std::find(assets.begin(), assets.end(), item) == assets.end()) {
+            assets.push_back(item);
+        }
+        if (_watcher != nullptr) {
+            _watcher->watch(path);
+        }
+    }
+}
+
+/**
+ * Forgets the directory entries for an asset category
+ *
+ * This method is the inverse of {@link #recordCategory}, and is called
+ * when the assets are unloaded.
+ *
+ * @param hash  The hash of the asset type
+ * @param json  The child of asset directory with these assets
+ */
+void AssetManager::forgetCategory(size_t hash, const std::shared_ptr<JsonValue>& json) {
+    auto it = _entries.find(hash);
+    if (it == _entries.end()) {
+        return;
+    }
+    
+    auto& evicted = _evicted[hash];
+    for(int ii = 0; ii < json->size(); ii++) {
+        std::shared_ptr<JsonValue> child = json->get(ii);
+        it->second.erase(child->key());
+        evicted.erase(child->key());
+        
+        std::string source = entry_source(child);
+        auto jt = source.empty() ? _sources.end() : _sources.find(AssetWatcher::resolve(source));
+        if (jt == _sources.end()) {
+            continue;
+        }
+        
+        std::pair<size_t,std::string> item(hash,child->key());
+        jt->second.erase(std::remove(jt->second.begin(), jt->second.end(), item), jt->second.end());
+        if (jt->second.empty()) {
+            if (_watcher != nullptr) {
+                _watcher->unwatch(jt->first);
+            }
+            _sources.erase(jt);
+        }
+    }
+}
+
+/**
+ * Returns the asset type hash for the given category name
+ *
+ * The category names are the keys of a JSON asset directory (e.g.
+ * "textures"). This method returns 0 if the category is unknown.
+ *
+ * @param name  The category name
+ *
+ * @return the asset type hash for the given category name
+ */
+size_t AssetManager::categoryHash(const std::string& name) {
+    if (name == "textures") {
+        return typeid(Texture).hash_code();
+    } else if (name == "sounds") {
+        return typeid(Sound).hash_code();
+    } else if (name == "fonts") {
+        return typeid(Font).hash_code();
+    } else if (name == "jsons") {
+        return typeid(JsonValue).hash_code();
+    } else if (name == "widgets") {
+        return typeid(WidgetValue).hash_code();
+    } else if (name == "scene2s") {
+        return typeid(scene2::SceneNode).hash_code();
+    }
+    return 0;
+}
+
 /**
  * Synchronizes the asset manager to wait until all assets have finished.
  *
@@ -305,6 +471,7 @@ bool AssetManager::loadDirectory(const std::shared_ptr<JsonValue>& json) {
             success = false;
         }
     }
+    trim();
     return success;
 }
 
@@ -341,6 +508,11 @@ bool AssetManager::loadDirectory(const std::string& directory) {
     }
     
     std::shared_ptr<JsonValue> json = reader->readJson();
+    std::string path = AssetWatcher::resolve(directory);
+    _directories[path] = directory;
+    if (_watcher != nullptr) {
+        _watcher->watch(path);
+    }
     return loadDirectory(json);
 }
 
@@ -443,6 +615,12 @@ void AssetManager::loadDirectoryAsync(const std::string& directory, LoaderCallba
         return;
     }
     
+    std::string path = AssetWatcher::resolve(directory);
+    _directories[path] = directory;
+    if (_watcher != nullptr) {
+        _watcher->watch(path);
+    }
+    
     _workers->addTask([=](void) {
         std::shared_ptr<JsonValue> json = reader->readJson();
         loadDirectoryAsync(json,callback);
@@ -503,6 +681,11 @@ bool AssetManager::unloadDirectory(const std::string& directory) {
     }
     
     std::shared_ptr<JsonValue> json = reader->readJson();
+    std::string path = AssetWatcher::resolve(directory);
+    _directories.erase(path);
+    if (_watcher != nullptr) {
+        _watcher->unwatch(path);
+    }
     return unloadDirectory(json);
 }
 
@@ -548,3 +731,362 @@ size_t AssetManager::waitCount() const {
     }
     return _preload ? result+1 : result;
 }
+
+#pragma mark -
+#pragma mark Hot Reloading
+/**
+ * Starts watching the asset files for changes.
+ *
+ * Once watching, any asset loaded from a JSON directory will be reloaded
+ * when its file changes.  The JSON directory files are watched as well,
+ * so that editing an entry (or a scene) will reload it.  Assets loaded
+ * directly from a file, without a directory, are not watched.
+ *
+ * Changes are reported in batches, once the files have not changed for
+ * the given interval. This keeps us from reloading a file that is still
+ * being written. The assets are reloaded in the main thread.
+ *
+ * @param interval  The quiet interval in milliseconds
+ *
+ * @return true if watching was started
+ */
+bool AssetManager::startWatching(Uint32 interval) {
+    if (_watcher != nullptr) {
+        return false;
+    }
+    
+    std::shared_ptr<AssetWatcher> watcher = AssetWatcher::alloc(interval);
+    if (watcher == nullptr) {
+        return false;
+    }
+    for(auto it = _sources.begin(); it != _sources.end(); ++it) {
+        watcher->watch(it->first);
+    }
+    for(auto it = _directories.begin(); it != _directories.end(); ++it) {
+        watcher->watch(it->first);
+    }
+    
+    // The weak reference discards changes detected before we stopped
+    std::weak_ptr<AssetWatcher> weak = watcher;
+    watcher->setListener([=](const std::vector<std::string>& files, const Timestamp& stamp) {
+        Application::get()->schedule([=](void) {
+            if (weak.lock() != nullptr) {
+                this->refresh(files,stamp);
+            }
+            return false;
+        });
+    });
+    
+    if (!watcher->start()) {
+        return false;
+    }
+    _watcher = watcher;
+    return true;
+}
+
+/**
+ * Stops watching the asset files for changes.
+ *
+ * Any changes already detected, but not yet reloaded, are discarded.
+ */
+void AssetManager::stopWatching() {
+    if (_watcher != nullptr) {
+        _watcher->dispose();
+        _watcher = nullptr;
+    }
+}
+
+/**
+ * Reloads the assets defined by the given files
+ *
+ * This method is called (in the main thread) when the asset watcher
+ * detects changes.  Any scene that references a reloaded asset is
+ * rebuilt as well.  Changes to an asset directory reload those entries
+ * which have changed.
+ *
+ * @param files The absolute paths of the changed files
+ * @param stamp The time the first change was detected
+ */
+void AssetManager::refresh(const std::vector<std::string>& files, const Timestamp& stamp) {
+    typedef std::pair<size_t,std::shared_ptr<JsonValue>> Entry;
+    size_t scenehash = typeid(scene2::SceneNode).hash_code();
+    std::vector<Entry> assets;
+    std::vector<Entry> scenes;
+    
+    for(auto it = files.begin(); it != files.end(); ++it) {
+        // Directory changes reload the entries that changed
+        auto dt = _directories.find(*it);
+        if (dt != _directories.end()) {
+            std::shared_ptr<JsonReader> reader = JsonReader::allocWithAsset(dt->second);
+            std::shared_ptr<JsonValue> json = (reader == nullptr ? nullptr : reader->readJson());
+            if (json == nullptr) {
+                CULogError("Could not reload asset directory '%s'",dt->second.c_str());
+                continue;
+            }
+            
+            for(int ii = 0; ii < json->size(); ii++) {
+                std::shared_ptr<JsonValue> category = json->get(ii);
+                size_t hash = categoryHash(category->key());
+                if (hash == 0 || _handlers.find(hash) == _handlers.end()) {
+                    continue;
+                }
+                
+                auto& entries = _entries[hash];
+                for(int jj = 0; jj < category->size(); jj++) {
+                    std::shared_ptr<JsonValue> child = category->get(jj);
+                    auto et = entries.find(child->key());
+                    if (et == entries.end() || et->second->toString(false) != child->toString(false)) {
+                        (hash == scenehash ? scenes : assets).push_back(Entry(hash,child));
+                    }
+                }
+                recordCategory(hash,category);
+            }
+        }
+        
+        // File changes reload every asset defined by that file
+        auto st = _sources.find(*it);
+        if (st != _sources.end()) {
+            for(auto jt = st->second.begin(); jt != st->second.end(); ++jt) {
+                auto& entries = _entries[jt->first];
+                auto et = entries.find(jt->second);
+                if (et != entries.end()) {
+                    (jt->first == scenehash ? scenes : assets).push_back(Entry(jt->first,et->second));
+                }
+            }
+        }
+    }
+    
+    // Scenes are reloaded last, as they depend on everything else
+    std::set<std::pair<size_t,std::string>> done;
+    std::unordered_set<std::string> changed;
+    for(int pass = 0; pass < 2; pass++) {
+        std::vector<Entry>& work = (pass == 0 ? assets : scenes);
+        if (pass == 1 && !changed.empty()) {
+            auto st = _entries.find(scenehash);
+            if (st != _entries.end()) {
+                for(auto jt = st->second.begin(); jt != st->second.end(); ++jt) {
+                    if (references(jt->second,changed)) {
+                        work.push_back(Entry(scenehash,jt->second));
+                    }
+                }
+            }
+        }
+        
+        for(auto it = work.begin(); it != work.end(); ++it) {
+            std::string key = it->second->key();
+            auto ht = _handlers.find(it->first);
+            if (ht == _handlers.end() || !done.emplace(it->first,key).second) {
+                continue;
+            }
+            
+            bool success = ht->second->reload(it->second);
+            if (success) {
+                changed.emplace(key);
+            } else {
+                CULogError("Could not reload asset '%s'",key.c_str());
+            }
+            if (_reloader) {
+                _reloader(key,success);
+            }
+        }
+    }
+    
+    if (done.empty()) {
+        return;
+    }
+    
+    // Measure the latency once the reloaded assets have been drawn
+    size_t amount = done.size();
+    std::weak_ptr<AssetWatcher> weak = _watcher;
+    Application::get()->schedule([=](void) {
+        if (weak.lock() != nullptr) {
+            Timestamp now;
+            _reloadLatency = now.ellapsedMicros(stamp);
+            _reloadTotal += _reloadLatency;
+            _reloadCount++;
+            CULog("Reloaded %zu assets in %.1f ms",amount,_reloadLatency/1000.0f);
+        }
+        return false;
+    });
+}
+
+#pragma mark -
+#pragma mark Memory Management
+/**
+ * Evicts assets of the given type until it is within the given budget
+ *
+ * Only assets loaded from a JSON directory may be evicted, as those are
+ * the only assets that we can restore. In addition, an asset is only
+ * evicted if the asset manager is its sole owner.
+ *
+ * @param hash      The hash of the asset type
+ * @param budget    The memory budget in bytes
+ *
+ * @return the number of assets evicted
+ */
+size_t AssetManager::evict(size_t hash, size_t budget) {
+    auto it = _handlers.find(hash);
+    auto jt = _entries.find(hash);
+    if (it == _handlers.end() || jt == _entries.end()) {
+        return 0;
+    }
+    
+    const auto& entries = jt->second;
+    size_t before = it->second->getMemoryUsage();
+    std::vector<std::string> keys = it->second->evict(budget, [&](const std::string& key) {
+        return entries.find(key) != entries.end();
+    });
+    if (keys.empty()) {
+        return 0;
+    }
+    
+    _evicted[hash].insert(keys.begin(), keys.end());
+    _evictCount += keys.size();
+    _evictBytes += before-it->second->getMemoryUsage();
+    return keys.size();
+}
+
+/**
+ * Synchronously restores a missing asset of the given type
+ *
+ * This method is called by {@link #get} when an asset is missing. It
+ * restores the asset if it was evicted, or if the loader can build it
+ * on demand (see {@link BaseLoader#request}). It does nothing unless
+ * it is called in the main thread.
+ *
+ * @param hash  The hash of the asset type
+ * @param key   The key associated with the asset
+ *
+ * @return true if the asset was restored
+ */
+bool AssetManager::restore(size_t hash, const std::string& key) const {
+    auto ht = _handlers.find(hash);
+    if (ht == _handlers.end() || SDL_ThreadID() != _mainThread) {
+        return false;
+    }
+    
+    auto it = _evicted.find(hash);
+    if (it == _evicted.end() || it->second.find(key) == it->second.end()) {
+        return ht->second->request(key);
+    }
+    
+    it->second.erase(key);
+    auto et = _entries.find(hash);
+    if (et == _entries.end()) {
+        return false;
+    }
+    auto kt = et->second.find(key);
+    if (kt == et->second.end()) {
+        return false;
+    }
+    if (ht->second->load(kt->second)) {
+        _restoreCount++;
+        return true;
+    }
+    CULogError("Could not restore evicted asset '%s'",key.c_str());
+    return false;
+}
+
+/**
+ * Returns the memory usage of all assets in bytes.
+ *
+ * This is an estimate computed by the individual loaders. See the method
+ * {@link BaseLoader#getMemoryUsage} for details.
+ *
+ * @return the memory usage of all assets in bytes.
+ */
+size_t AssetManager::getMemoryUsage() const {
+    size_t total = 0;
+    for(auto it = _handlers.begin(); it != _handlers.end(); ++it) {
+        total += it->second->getMemoryUsage();
+    }
+    return total;
+}
+
+/**
+ * Returns the number of assets evicted per second.
+ *
+ * The rate is measured from the last call to {@link #resetTelemetry}
+ * (or the initialization of this asset manager).
+ *
+ * @return the number of assets evicted per second.
+ */
+float AssetManager::getEvictionRate() const {
+    Timestamp now;
+    Uint64 millis = now.ellapsedMillis(_evictStart);
+    return millis == 0 ? 0.0f : (_evictCount*1000.0f)/millis;
+}
+
+/**
+ * Resets the peak usage and eviction statistics.
+ */
+void AssetManager::resetTelemetry() {
+    _peaks.clear();
+    _peak = 0;
+    _evictCount = 0;
+    _evictBytes = 0;
+    _restoreCount = 0;
+    _evictStart.mark();
+}
+
+/**
+ * Evicts the least recently used assets to meet the memory budgets.
+ *
+ * Only assets loaded from a JSON directory may be evicted, and only if
+ * the asset manager is their sole owner. Hence this method never
+ * invalidates an asset in use. An evicted asset is restored when it is
+ * next requested with {@link #get}.
+ *
+ * This method is called automatically after a directory is loaded
+ * synchronously. It is never called while assets are loading
+ * asynchronously, as restoring an asset outside of the main thread is not
+ * safe. Hence games that load asynchronously should call this method once
+ * loading is complete.
+ *
+ * @return the number of assets evicted
+ */
+size_t AssetManager::trim() {
+    if (!complete()) {
+        return 0;
+    }
+    
+    // Sample the usage before eviction for the peaks
+    std::unordered_map<size_t,size_t> usage;
+    size_t total = 0;
+    for(auto it = _handlers.begin(); it != _handlers.end(); ++it) {
+        size_t bytes = it->second->getMemoryUsage();
+        size_t& peak = _peaks[it->first];
+        peak = std::max(peak,bytes);
+        usage[it->first] = bytes;
+        total += bytes;
+    }
+    _peak = std::max(_peak,total);
+    
+    size_t count = 0;
+    for(auto it = _budgets.begin(); it != _budgets.end(); ++it) {
+        auto jt = usage.find(it->first);
+        if (it->second > 0 && jt != usage.end() && jt->second > it->second) {
+            count += evict(it->first,it->second);
+        }
+    }
+    
+    if (_budget == 0) {
+        return count;
+    }
+    
+    // Split the excess across the types in proportion to their usage
+    total = getMemoryUsage();
+    if (total <= _budget) {
+        return count;
+    }
+    double excess = (double)(total-_budget);
+    for(auto it = _handlers.begin(); it != _handlers.end(); ++it) {
+        size_t bytes = it->second->getMemoryUsage();
+        if (bytes == 0) {
+            continue;
+        }
+        size_t share = (size_t)std::ceil(excess*bytes/total);
+        count += evict(it->first, share >= bytes ? 0 : bytes-share);
+    }
+    return count;
+}
@@ -0,0 +1,401 @@
+//
+//  CUAssetWatcher.cpp
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides a class to monitor asset files for changes. It is
+//  used by the asset manager to support hot reloading, so that an edited
+//  texture, sound, or JSON file can be reloaded without restarting the game.
+//
+//  On Linux, this class uses inotify to watch the directories that contain
+//  the asset files.  We watch the directories and not the files, because
+//  most editors save files by writing a temporary file and renaming it.  On
+//  all other platforms, this class polls the file modification times.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#include <cugl/assets/CUAssetWatcher.h>
+#include <cugl/base/CUApplication.h>
+#include <cugl/util/CUFiletools.h>
+#include <algorithm>
+
+#if defined (__LINUX__)
+    #include <sys/inotify.h>
+    #include <poll.h>
+    #include <unistd.h>
+    /** The inotify events that indicate a completed save */
+    #define NOTIFY_MASK (IN_CLOSE_WRITE | IN_MOVED_TO)
+#endif
+
+/** The size of the inotify read buffer */
+#define NOTIFY_BUFFER   4096
+
+using namespace cugl;
+
+#pragma mark Constructors
+/**
+ * Creates a degenerate asset watcher with no files.
+ *
+ * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an object on
+ * the heap, use one of the static constructors instead.
+ */
+AssetWatcher::AssetWatcher() :
+_interval(0),
+_notify(-1),
+_thread(nullptr),
+_active(false) {
+}
+
+/**
+ * Stops the watcher thread and releases all resources.
+ *
+ * You must reinitialize the watcher to use it again.
+ */
+void AssetWatcher::dispose() {
+    stop();
+    unwatchAll();
+#if defined (__LINUX__)
+    if (_notify >= 0) {
+        close(_notify);
+    }
+#endif
+    _notify = -1;
+    _interval = 0;
+    _listener = nullptr;
+}
+
+/**
+ * Initializes an asset watcher with the given interval.
+ *
+ * The interval is how long the file system must be quiet before a batch
+ * of changes is reported. When polling, it is also the polling period.
+ * The watcher will not be active until {@link #start} is called.
+ *
+ * @param interval  The interval in milliseconds
+ *
+ * @return true if initialization was successful.
+ */
+bool AssetWatcher::init(Uint32 interval) {
+    if (_interval) {
+        CUAssertLog(false, "Asset watcher is already initialized");
+        return false;
+    }
+    _interval = std::max(interval,(Uint32)1);
+#if defined (__LINUX__)
+    _notify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (_notify < 0) {
+        CULogError("Could not initialize inotify; polling asset files instead");
+    }
+#endif
+    return true;
+}
+
+#pragma mark -
+#pragma mark File Management
+/**
+ * Returns the absolute path for the given asset file.
+ *
+ * Relative paths are resolved against the application asset directory.
+ *
+ * @param path  The (relative or absolute) path to the file
+ *
+ * @return the absolute path for the given asset file.
+ */
+std::string AssetWatcher::resolve(const std::string& path) {
+    if (filetool::is_absolute(path) || Application::get() == nullptr) {
+        return filetool::normalize_path(path);
+    }
+    return filetool::normalize_path(Application::get()->getAssetDirectory()+path);
+}
+
+/**
+ * Starts watching the given file.
+ *
+ * The file does not need to exist yet; it will be reported once it
+ * is created. Relative paths are resolved against the application
+ * asset directory. This method may be called while the watcher is
+ * active.
+ *
+ * @param path  The (relative or absolute) path to the file
+ *
+ * @return true if the file was not already watched
+ */
+bool AssetWatcher::watch(const std::string& path) {
+    std::string full = resolve(path);
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_files.find(full) != _files.end()) {
+        return false;
+    }
+    _files[full] = filetool::file_timestamp(full);
+    attachDirectory(filetool::dir_name(full));
+    return true;
+}
+
+/**
+ * Stops watching the given file.
+ *
+ * This method may be called while the watcher is active.
+ *
+ * @param path  The (relative or absolute) path to the file
+ *
+ * @return true if the file was being watched
+ */
+bool AssetWatcher::unwatch(const std::string& path) {
+    std::string full = resolve(path);
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _files.find(full);
+    if (it == _files.end()) {
+        return false;
+    }
+    _files.erase(it);
+    detachDirectory(filetool::dir_name(full));
+    return true;
+}
+
+/**
+ * Stops watching all files.
+ *
+ * This method may be called while the watcher is active.
+ */
+void AssetWatcher::unwatchAll() {
+    std::lock_guard<std::mutex> lock(_mutex);
+#if defined (__LINUX__)
+    for(auto it = _handles.begin(); it != _handles.end(); ++it) {
+        inotify_rm_watch(_notify, it->first);
+    }
+#endif
+    _handles.clear();
+    _files.clear();
+    _dirs.clear();
+}
+
+/**
+ * Returns true if the given file is being watched.
+ *
+ * @param path  The (relative or absolute) path to the file
+ *
+ * @return true if the given file is being watched.
+ */
+bool AssetWatcher::isWatched(const std::string& path) {
+    std::string full = resolve(path);
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _files.find(full) != _files.end();
+}
+
+/**
+ * Returns the number of files being watched.
+ *
+ * @return the number of files being watched.
+ */
+size_t AssetWatcher::size() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _files.size();
+}
+
+/**
+ * Starts watching the given directory, increasing its reference count.
+ *
+ * This method assumes that the mutex is held.
+ *
+ * @param dir   The absolute path of the directory
+ */
+void AssetWatcher::attachDirectory(const std::string& dir) {
+    Uint32 count = _dirs[dir]++;
+#if defined (__LINUX__)
+    if (count == 0 && _notify >= 0) {
+        int handle = inotify_add_watch(_notify, dir.c_str(), NOTIFY_MASK);
+        if (handle < 0) {
+            CULogError("Could not watch directory '%s'",dir.c_str());
+        } else {
+            _handles[handle] = dir;
+        }
+    }
+#endif
+}
+
+/**
+ * Stops watching the given directory, decreasing its reference count.
+ *
+ * This method assumes that the mutex is held.
+ *
+ * @param dir   The absolute path of the directory
+ */
+void AssetWatcher::detachDirectory(const std::string& dir) {
+    auto it = _dirs.find(dir);
+    if (it == _dirs.end() || --(it->second) > 0) {
+        return;
+    }
+    _dirs.erase(it);
+    for(auto jt = _handles.begin(); jt != _handles.end(); ++jt) {
+        if (jt->second == dir) {
+#if defined (__LINUX__)
+            inotify_rm_watch(_notify, jt->first);
+#endif
+            _handles.erase(jt);
+            return;
+        }
+    }
+}
+
+#pragma mark -
+#pragma mark Monitoring
+/**
+ * Starts the watcher thread.
+ *
+ * @return true if the watcher thread was started.
+ */
+bool AssetWatcher::start() {
+    if (_active.load() || !_interval) {
+        return false;
+    }
+    _active.store(true);
+    _thread = SDL_CreateThread(monitor, "AssetWatcher", this);
+    if (_thread == nullptr) {
+        CULogError("Could not start asset watcher. %s",SDL_GetError());
+        _active.store(false);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Stops the watcher thread.
+ *
+ * This method blocks until the watcher thread has completed, which
+ * takes at most one interval.
+ */
+void AssetWatcher::stop() {
+    if (!_active.load()) {
+        return;
+    }
+    _active.store(false);
+    SDL_WaitThread(_thread, nullptr);
+    _thread = nullptr;
+}
+
+/**
+ * The body function of the watcher thread.
+ *
+ * This function detects the changes and reports them to the listener.
+ *
+ * @param data  A pointer to this watcher
+ *
+ * @return 0 on thread completion
+ */
+int AssetWatcher::monitor(void* data) {
+    AssetWatcher* watcher = (AssetWatcher*)data;
+    std::vector<std::string> pending;
+    Timestamp first;
+    while (watcher->_active.load()) {
+        bool fresh = pending.empty();
+        if (watcher->scan(pending)) {
+            if (fresh) {
+                first.mark();
+            }
+        } else if (!pending.empty()) {
+            // The file system has been quiet for an entire interval
+            if (watcher->_listener) {
+                watcher->_listener(pending,first);
+            }
+            pending.clear();
+        }
+    }
+    return 0;
+}
+
+/**
+ * Waits for at most one interval, adding any changed files to pending.
+ *
+ * This method uses inotify if it is available, and polls the files
+ * otherwise.
+ *
+ * @param pending   The files changed so far
+ *
+ * @return true if any file changed during this interval
+ */
+bool AssetWatcher::scan(std::vector<std::string>& pending) {
+    bool changed = false;
+#if defined (__LINUX__)
+    if (_notify >= 0) {
+        struct pollfd request;
+        request.fd = _notify;
+        request.events = POLLIN;
+        request.revents = 0;
+        if (poll(&request, 1, (int)_interval) <= 0) {
+            return false;
+        }
+
+        alignas(struct inotify_event) char buffer[NOTIFY_BUFFER];
+        ssize_t amt;
+        while ((amt = read(_notify, buffer, NOTIFY_BUFFER)) > 0) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for(char* pos = buffer; pos < buffer+amt; ) {
+                const struct inotify_event* event = (const struct inotify_event*)pos;
+                pos += sizeof(struct inotify_event)+event->len;
+                auto it = _handles.find(event->wd);
+                if (event->len == 0 || it == _handles.end()) {
+                    continue;
+                }
+
+                std::string path = it->second;
+                path.push_back(filetool::path_sep);
+                path.append(event->name);
+                if (_files.find(path) != _files.end()) {
+                    if (std::find(pending.begin(), pending.end(), path) == pending.end()) {
+                        pending.push_back(path);
+                    }
+                    changed = true;
+                }
+            }
+        }
+        return changed;
+    }
+#endif
+
+    SDL_Delay(_interval);
+    std::lock_guard<std::mutex> lock(_mutex);
+    for(auto it = _files.begin(); it != _files.end(); ++it) {
+        Uint64 time = filetool::file_timestamp(it->first);
+        if (time != it->second) {
+            it->second = time;
+            if (time != 0) {
+                if (std::find(pending.begin(), pending.end(), it->first) == pending.end()) {
+                    pending.push_back(it->first);
+                }
+                changed = true;
+            }
+        }
+    }
+    return changed;
+}
@@ -311,3 +311,19 @@ bool FontLoader::read(const std::shared_ptr<JsonValue>& json, LoaderCallback cal
     
     return success;
 }
+
+#pragma mark -
+#pragma mark Memory Management
+/**
+ * Returns the number of bytes used by the given font.
+ *
+ * This is the size of the font atlas textures (see
+ * {@link Font#getAtlasBytes}).
+ *
+ * @param asset The font to measure
+ *
+ * @return the number of bytes used by the given font.
+ */
+size_t FontLoader::measure(const std::shared_ptr<Font>& asset) const {
+    return asset == nullptr ? 0 : asset->getAtlasBytes();
+}
@@ -0,0 +1,373 @@
+//
+//  CULevelChunk.cpp
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides a single chunk of a streamed level. Large levels are
+//  divided into a grid of spatial chunks, and each chunk stores the scene
+//  graph JSON, polygons, and physics obstacles in its region. Chunks are
+//  stored in a compact binary format so that they can be read quickly in a
+//  background thread. See LevelStreamer for how chunks are loaded.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#include <cugl/assets/CULevelChunk.h>
+#include <cugl/io/CUBinaryReader.h>
+#include <cugl/io/CUBinaryWriter.h>
+#include <cugl/physics2/CUBoxObstacle.h>
+#include <cugl/physics2/CUWheelObstacle.h>
+#include <cugl/physics2/CUCapsuleObstacle.h>
+#include <cugl/physics2/CUPolygonObstacle.h>
+#include <cugl/util/CUDebug.h>
+
+using namespace cugl;
+using namespace cugl::physics2;
+
+/** The magic number identifying a chunk file ("CULC") */
+#define CHUNK_MAGIC     0x43554C43
+/** The current version of the chunk format */
+#define CHUNK_VERSION   1
+
+#pragma mark -
+#pragma mark Binary Helpers
+/**
+ * Returns a string of the given length read from the stream
+ *
+ * BinaryReader only refills its buffer on single element reads, so this
+ * reads one character at a time.
+ *
+ * @param reader    The binary reader
+ * @param length    The string length
+ *
+ * @return a string of the given length read from the stream
+ */
+static std::string read_string(BinaryReader* reader, Uint32 length) {
+    std::string result;
+    result.resize(length);
+    for(Uint32 ii = 0; ii < length; ii++) {
+        result[ii] = reader->readChar();
+    }
+    return result;
+}
+
+/**
+ * Writes the given string to the stream, prefixed by its length.
+ *
+ * @param writer    The binary writer
+ * @param value     The string to write
+ */
+static void write_string(BinaryWriter* writer, const std::string& value) {
+    writer->writeUint32((Uint32)value.size());
+    if (!value.empty()) {
+        writer->write(value.c_str(),value.size());
+    }
+}
+
+#pragma mark -
+#pragma mark Constructors
+/**
+ * Disposes all of the resources used by this chunk.
+ *
+ * The obstacles are released, but they are not removed from any physics
+ * world. A disposed chunk can be safely reinitialized.
+ */
+void LevelChunk::dispose() {
+    _scene = nullptr;
+    _node = nullptr;
+    _polygons.clear();
+    _bodies.clear();
+    _obstacles.clear();
+    _bounds = Rect::ZERO;
+    _col = 0;
+    _row = 0;
+    _active = false;
+}
+
+/**
+ * Initializes an empty chunk for the given grid cell.
+ *
+ * This initializer is for building chunks in code, typically in a tool
+ * that divides a level into chunks and calls {@link #save}.
+ *
+ * @param col       The column of the chunk in the level grid
+ * @param row       The row of the chunk in the level grid
+ * @param bounds    The region of the level covered by the chunk
+ *
+ * @return true if initialization was successful.
+ */
+bool LevelChunk::init(int col, int row, const Rect bounds) {
+    if (_active) {
+        CUAssertLog(false, "Level chunk is already initialized");
+        return false;
+    }
+    _col = col;
+    _row = row;
+    _bounds = bounds;
+    _active = true;
+    return true;
+}
+
+/**
+ * Initializes a chunk from the given binary file.
+ *
+ * The file must be in the format described in the class documentation.
+ * Relative paths are resolved as in {@link BinaryReader}. This method
+ * is safe to call in a background thread.
+ *
+ * @param file  The chunk file
+ *
+ * @return true if initialization was successful.
+ */
+bool LevelChunk::initWithFile(const std::string file) {
+    if (_active) {
+        CUAssertLog(false, "Level chunk is already initialized");
+        return false;
+    }
+
+    std::shared_ptr<BinaryReader> reader = BinaryReader::alloc(file);
+    if (reader == nullptr || !reader->ready(8)) {
+        CULogError("Could not read level chunk %s", file.c_str());
+        return false;
+    }
+    if (reader->readUint32() != CHUNK_MAGIC || reader->readUint32() != CHUNK_VERSION) {
+        CULogError("Level chunk %s has the wrong format", file.c_str());
+        return false;
+    }
+
+    // The counts are checked against the remaining bytes before allocating
+    bool valid = reader->ready(28);
+    if (valid) {
+        _col = reader->readSint32();
+        _row = reader->readSint32();
+        _bounds.origin.x = reader->readFloat();
+        _bounds.origin.y = reader->readFloat();
+        _bounds.size.width  = reader->readFloat();
+        _bounds.size.height = reader->readFloat();
+
+        Uint32 length = reader->readUint32();
+        valid = reader->ready(length+4);
+        if (valid && length) {
+            _scene = JsonValue::allocWithJson(read_string(reader.get(),length));
+            valid = _scene != nullptr;
+        }
+    }
+
+    if (valid) {
+        Uint32 count = reader->readUint32();
+        valid = reader->ready(8*count);
+        _polygons.resize(valid ? count : 0);
+        for(auto it = _polygons.begin(); valid && it != _polygons.end(); ++it) {
+            Uint32 size = reader->readUint32();
+            valid = reader->ready(8*size+4);
+            if (valid) {
+                it->vertices.resize(size);
+                for(Uint32 ii = 0; ii < size; ii++) {
+                    it->vertices[ii].x = reader->readFloat();
+                    it->vertices[ii].y = reader->readFloat();
+                }
+                size = reader->readUint32();
+                valid = reader->ready(4*size);
+            }
+            if (valid) {
+                it->indices.resize(size);
+                for(Uint32 ii = 0; ii < size; ii++) {
+                    it->indices[ii] = reader->readUint32();
+                }
+            }
+        }
+    }
+
+    if (valid) {
+        valid = reader->ready(4);
+        Uint32 count = valid ? reader->readUint32() : 0;
+        valid = valid && reader->ready(44*count);
+        _bodies.resize(valid ? count : 0);
+        for(auto it = _bodies.begin(); valid && it != _bodies.end(); ++it) {
+            it->shape  = (Shape)reader->readByte();
+            it->type   = (b2BodyType)reader->readByte();
+            it->sensor = reader->readByte() != 0;
+            reader->readByte();
+            it->position.x  = reader->readFloat();
+            it->position.y  = reader->readFloat();
+            it->angle       = reader->readFloat();
+            it->size.width  = reader->readFloat();
+            it->size.height = reader->readFloat();
+            it->density     = reader->readFloat();
+            it->friction    = reader->readFloat();
+            it->restitution = reader->readFloat();
+            it->polygon = reader->readUint32();
+            Uint32 length = reader->readUint32();
+            valid = reader->ready(length);
+            if (valid) {
+                it->name = read_string(reader.get(),length);
+            }
+        }
+    }
+    reader->close();
+
+    if (!valid) {
+        CULogError("Level chunk %s is truncated", file.c_str());
+        dispose();
+        return false;
+    }
+    _active = true;
+    return true;
+}
+
+/**
+ * Writes this chunk to the given binary file.
+ *
+ * The file will be in the format described in the class documentation.
+ *
+ * @param file  The chunk file
+ *
+ * @return true if the chunk was successfully written
+ */
+bool LevelChunk::save(const std::string file) const {
+    std::shared_ptr<BinaryWriter> writer = BinaryWriter::alloc(file);
+    if (writer == nullptr) {
+        CULogError("Could not write level chunk %s", file.c_str());
+        return false;
+    }
+
+    writer->writeUint32(CHUNK_MAGIC);
+    writer->writeUint32(CHUNK_VERSION);
+    writer->writeSint32(_col);
+    writer->writeSint32(_row);
+    writer->writeFloat(_bounds.origin.x);
+    writer->writeFloat(_bounds.origin.y);
+    writer->writeFloat(_bounds.size.width);
+    writer->writeFloat(_bounds.size.height);
+    write_string(writer.get(), _scene == nullptr ? "" : _scene->toString(false));
+
+    writer->writeUint32((Uint32)_polygons.size());
+    for(auto it = _polygons.begin(); it != _polygons.end(); ++it) {
+        writer->writeUint32((Uint32)it->vertices.size());
+        for(auto jt = it->vertices.begin(); jt != it->vertices.end(); ++jt) {
+            writer->writeFloat(jt->x);
+            writer->writeFloat(jt->y);
+        }
+        writer->writeUint32((Uint32)it->indices.size());
+        if (!it->indices.empty()) {
+            writer->write(it->indices.data(),it->indices.size());
+        }
+    }
+
+    writer->writeUint32((Uint32)_bodies.size());
+    for(auto it = _bodies.begin(); it != _bodies.end(); ++it) {
+        writer->writeUint8((Uint8)it->shape);
+        writer->writeUint8((Uint8)it->type);
+        writer->writeUint8(it->sensor ? 1 : 0);
+        writer->writeUint8(0);
+        writer->writeFloat(it->position.x);
+        writer->writeFloat(it->position.y);
+        writer->writeFloat(it->angle);
+        writer->writeFloat(it->size.width);
+        writer->writeFloat(it->size.height);
+        writer->writeFloat(it->density);
+        writer->writeFloat(it->friction);
+        writer->writeFloat(it->restitution);
+        writer->writeUint32(it->polygon);
+        write_string(writer.get(), it->name);
+    }
+    writer->close();
+    return true;
+}
+
+#pragma mark -
+#pragma mark Content
+/**
+ * Returns the approximate memory used by this chunk in bytes.
+ *
+ * This includes the polygon data, the body descriptions and the obstacles,
+ * but not the scene graph.
+ *
+ * @return the approximate memory used by this chunk in bytes.
+ */
+size_t LevelChunk::getMemory() const {
+    size_t total = sizeof(LevelChunk);
+    for(auto it = _polygons.begin(); it != _polygons.end(); ++it) {
+        total += sizeof(Poly2)+it->vertices.capacity()*sizeof(Vec2);
+        total += it->indices.capacity()*sizeof(Uint32);
+    }
+    total += _bodies.capacity()*sizeof(Body);
+    total += _obstacles.size()*sizeof(SimpleObstacle);
+    return total;
+}
+
+/**
+ * Builds the obstacles for the body descriptions.
+ *
+ * The obstacles are not added to any physics world, so this method is
+ * safe to call in a background thread. Bodies that fail to build (such
+ * as polygon bodies with a bad polygon index) are skipped.
+ *
+ * @return the number of obstacles built
+ */
+size_t LevelChunk::buildObstacles() {
+    _obstacles.clear();
+    _obstacles.reserve(_bodies.size());
+    for(auto it = _bodies.begin(); it != _bodies.end(); ++it) {
+        std::shared_ptr<Obstacle> obstacle = nullptr;
+        switch (it->shape) {
+            case Shape::BOX:
+                obstacle = BoxObstacle::alloc(it->position,it->size);
+                break;
+            case Shape::WHEEL:
+                obstacle = WheelObstacle::alloc(it->position,it->size.width);
+                break;
+            case Shape::CAPSULE:
+                obstacle = CapsuleObstacle::alloc(it->position,it->size);
+                break;
+            case Shape::POLYGON:
+                if (it->polygon < _polygons.size()) {
+                    obstacle = PolygonObstacle::alloc(_polygons[it->polygon],it->position);
+                }
+                break;
+        }
+        if (obstacle == nullptr) {
+            CULogError("Could not build body '%s' in chunk (%d,%d)",
+                       it->name.c_str(), _col, _row);
+            continue;
+        }
+        obstacle->setName(it->name);
+        obstacle->setBodyType(it->type);
+        obstacle->setAngle(it->angle);
+        obstacle->setSensor(it->sensor);
+        obstacle->setDensity(it->density);
+        obstacle->setFriction(it->friction);
+        obstacle->setRestitution(it->restitution);
+        _obstacles.push_back(obstacle);
+    }
+    return _obstacles.size();
+}
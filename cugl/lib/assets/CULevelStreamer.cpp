@@ -0,0 +1,432 @@
+//
+//  CULevelStreamer.cpp
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides chunk-based streaming for large levels. A level is
+//  divided offline into a grid of chunks (see LevelChunk). At runtime, only
+//  the chunks near a focus point (typically the camera or the player) are
+//  resident. Chunks are read in a background thread, and their physics bodies
+//  and scene graphs are added at the start of the next physics step. Hence
+//  the memory footprint and load time of a level depend on the streaming
+//  radius, and not on the size of the level.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#include <cugl/assets/CULevelStreamer.h>
+#include <cugl/base/CUApplication.h>
+#include <cugl/io/CUJsonReader.h>
+#include <cugl/util/CUFiletools.h>
+#include <cugl/util/CUDebug.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace cugl;
+
+/** The file extension of a chunk file */
+#define CHUNK_EXTENSION ".chunk"
+
+#pragma mark Constructors
+/**
+ * Creates a degenerate level streamer.
+ *
+ * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an object on
+ * the heap, use one of the static constructors instead.
+ */
+LevelStreamer::LevelStreamer() :
+_cols(0),
+_rows(0),
+_radius(1),
+_inserts(1),
+_col(0),
+_row(0) {
+    onLoad = nullptr;
+    onUnload = nullptr;
+}
+
+/**
+ * Disposes all of the resources used by this streamer.
+ *
+ * This method blocks until any chunk being read is complete. All resident
+ * chunks are removed from the world and the scene graph. A disposed
+ * streamer can be safely reinitialized.
+ */
+void LevelStreamer::dispose() {
+    if (_workers != nullptr) {
+        _workers->dispose();
+        _workers = nullptr;
+    }
+    unloadAll();
+    _missing.clear();
+    _world = nullptr;
+    _root = nullptr;
+    _loader = nullptr;
+    _directory.clear();
+    _origin = Vec2::ZERO;
+    _chunksize = Size::ZERO;
+    _cols = 0;
+    _rows = 0;
+    _radius = 1;
+    _inserts = 1;
+    _col = 0;
+    _row = 0;
+    onLoad = nullptr;
+    onUnload = nullptr;
+}
+
+/**
+ * Initializes a streamer for the level with the given manifest.
+ *
+ * The manifest is a JSON file, as described in the class documentation.
+ * If the path is relative, it is relative to the asset directory. The
+ * chunk obstacles are added to the given world. If the loader and root
+ * are not nullptr, the chunk scene graphs are built with the loader and
+ * attached to the root.
+ *
+ * No chunks are loaded until the first call to {@link #update}.
+ *
+ * @param manifest  The level manifest
+ * @param world     The physics world for the chunk obstacles
+ * @param root      The scene graph node for the chunk scenes
+ * @param loader    The loader to build the chunk scenes
+ * @param radius    The streaming radius in chunks
+ * @param threads   The number of threads to read chunks
+ *
+ * @return true if initialization was successful.
+ */
+bool LevelStreamer::init(const std::string manifest,
+                         const std::shared_ptr<physics2::ObstacleWorld>& world,
+                         const std::shared_ptr<scene2::SceneNode>& root,
+                         const std::shared_ptr<Scene2Loader>& loader,
+                         Uint32 radius, Uint32 threads) {
+    if (_workers != nullptr) {
+        CUAssertLog(false, "Level streamer is already initialized");
+        return false;
+    } else if (world == nullptr) {
+        CUAssertLog(false, "Level streamer requires a physics world");
+        return false;
+    }
+
+    std::string path = manifest;
+    if (!filetool::is_absolute(path) && Application::get() != nullptr) {
+        path = Application::get()->getAssetDirectory()+path;
+    }
+    path = filetool::normalize_path(path);
+
+    std::shared_ptr<JsonReader> reader = JsonReader::alloc(path);
+    std::shared_ptr<JsonValue> json = (reader == nullptr ? nullptr : reader->readJson());
+    if (json == nullptr) {
+        CULogError("Could not read level manifest %s", manifest.c_str());
+        return false;
+    }
+
+    std::shared_ptr<JsonValue> child = json->get("origin");
+    if (child != nullptr && child->size() >= 2) {
+        _origin.set(child->get(0)->asFloat(0),child->get(1)->asFloat(0));
+    }
+    child = json->get("chunk");
+    if (child != nullptr && child->size() >= 2) {
+        _chunksize.set(child->get(0)->asFloat(0),child->get(1)->asFloat(0));
+    }
+    child = json->get("grid");
+    if (child != nullptr && child->size() >= 2) {
+        _cols = child->get(0)->asInt(0);
+        _rows = child->get(1)->asInt(0);
+    }
+    if (_chunksize.width <= 0 || _chunksize.height <= 0 || _cols <= 0 || _rows <= 0) {
+        CULogError("Level manifest %s is invalid", manifest.c_str());
+        _origin = Vec2::ZERO;
+        _chunksize = Size::ZERO;
+        _cols = _rows = 0;
+        return false;
+    }
+
+    _directory = filetool::dir_name(path);
+    _world  = world;
+    _root   = root;
+    _loader = loader;
+    _radius = radius;
+    _workers = ThreadPool::alloc(std::max(threads,(Uint32)1));
+    return true;
+}
+
+#pragma mark -
+#pragma mark Attributes
+/**
+ * Returns the resident chunk in the given grid cell.
+ *
+ * This method returns nullptr if the chunk is not resident.
+ *
+ * @param col   The chunk column
+ * @param row   The chunk row
+ *
+ * @return the resident chunk in the given grid cell.
+ */
+std::shared_ptr<LevelChunk> LevelStreamer::getChunk(int col, int row) const {
+    auto it = _resident.find(makeKey(col,row));
+    return (it == _resident.end() ? nullptr : it->second);
+}
+
+/**
+ * Returns true if every chunk within the streaming radius is resident.
+ *
+ * Missing chunks (cells with no file) count as resident. This method is
+ * useful for holding the game (e.g. on a loading screen) until the area
+ * around the player has been loaded.
+ *
+ * @return true if every chunk within the streaming radius is resident.
+ */
+bool LevelStreamer::isSettled() const {
+    int mincol = std::max(_col-(int)_radius,0);
+    int maxcol = std::min(_col+(int)_radius,_cols-1);
+    int minrow = std::max(_row-(int)_radius,0);
+    int maxrow = std::min(_row+(int)_radius,_rows-1);
+    for(int row = minrow; row <= maxrow; row++) {
+        for(int col = mincol; col <= maxcol; col++) {
+            Uint64 key = makeKey(col,row);
+            if (!_resident.count(key) && !_missing.count(key)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+#pragma mark -
+#pragma mark Streaming
+/**
+ * Streams the chunks around the given focus point.
+ *
+ * This method must be called in the main thread, and should be called
+ * once a frame before the physics world is updated. It requests the
+ * chunks within the streaming radius, unloads the chunks out of range,
+ * and inserts chunks that have finished reading (up to the insert
+ * limit).
+ *
+ * @param focus The focus point in physics coordinates
+ */
+void LevelStreamer::update(const Vec2 focus) {
+    if (_workers == nullptr) {
+        return;
+    }
+    _col = (int)std::floor((focus.x-_origin.x)/_chunksize.width);
+    _row = (int)std::floor((focus.y-_origin.y)/_chunksize.height);
+
+    // Unload (and cancel) anything beyond the hysteresis band
+    for(auto it = _resident.begin(); it != _resident.end(); ) {
+        if (!inRange(it->second->getColumn(),it->second->getRow(),_radius+1)) {
+            remove(it->second);
+            it = _resident.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for(auto it = _pending.begin(); it != _pending.end(); ) {
+        int col = (int)(Uint32)(*it >> 32);
+        int row = (int)(Uint32)(*it & 0xFFFFFFFF);
+        if (!inRange(col,row,_radius+1)) {
+            it = _pending.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // Request the nearest chunks first
+    for(int ring = 0; ring <= (int)_radius; ring++) {
+        int mincol = std::max(_col-ring,0);
+        int maxcol = std::min(_col+ring,_cols-1);
+        int minrow = std::max(_row-ring,0);
+        int maxrow = std::min(_row+ring,_rows-1);
+        for(int row = minrow; row <= maxrow; row++) {
+            for(int col = mincol; col <= maxcol; col++) {
+                if (std::max(std::abs(col-_col),std::abs(row-_row)) == ring) {
+                    request(col,row);
+                }
+            }
+        }
+    }
+
+    // Insert the chunks that have finished
+    std::vector<std::pair<Uint64,std::shared_ptr<LevelChunk>>> ready;
+    _mutex.lock();
+    ready.swap(_ready);
+    _mutex.unlock();
+
+    Uint32 inserted = 0;
+    auto it = ready.begin();
+    for(; it != ready.end() && (!_inserts || inserted < _inserts); ++it) {
+        if (!_pending.erase(it->first) || _resident.count(it->first)) {
+            continue;   // Cancelled while reading
+        } else if (it->second == nullptr) {
+            _missing.insert(it->first);
+        } else {
+            insert(it->first,it->second);
+            inserted++;
+        }
+    }
+
+    // Return the rest for the next frame
+    if (it != ready.end()) {
+        _mutex.lock();
+        _ready.insert(_ready.begin(),std::make_move_iterator(it),
+                      std::make_move_iterator(ready.end()));
+        _mutex.unlock();
+    }
+}
+
+/**
+ * Blocks until every chunk around the focus point is resident.
+ *
+ * This method is equivalent to calling {@link #update} until the
+ * streamer {@link #isSettled}, ignoring the insert limit. It is useful
+ * for loading the starting area of a level.
+ *
+ * @param focus The focus point in physics coordinates
+ */
+void LevelStreamer::settle(const Vec2 focus) {
+    if (_workers == nullptr) {
+        return;
+    }
+    Uint32 limit = _inserts;
+    _inserts = 0;
+    update(focus);
+    while (!isSettled()) {
+        SDL_Delay(1);
+        update(focus);
+    }
+    _inserts = limit;
+}
+
+/**
+ * Unloads all resident chunks.
+ *
+ * Outstanding requests are cancelled, though chunks currently being read
+ * will finish reading before they are discarded.
+ */
+void LevelStreamer::unloadAll() {
+    for(auto it = _resident.begin(); it != _resident.end(); ++it) {
+        remove(it->second);
+    }
+    _resident.clear();
+    _pending.clear();
+    _mutex.lock();
+    _ready.clear();
+    _mutex.unlock();
+}
+
+#pragma mark -
+#pragma mark Internal Helpers
+/**
+ * Requests the chunk in the given grid cell
+ *
+ * The chunk is read in a background thread.
+ *
+ * @param col   The chunk column
+ * @param row   The chunk row
+ */
+void LevelStreamer::request(int col, int row) {
+    Uint64 key = makeKey(col,row);
+    if (_resident.count(key) || _pending.count(key) || _missing.count(key)) {
+        return;
+    }
+    _pending.insert(key);
+    std::string file = std::to_string(col)+"_"+std::to_string(row)+CHUNK_EXTENSION;
+    file = filetool::join_path({_directory,file});
+    _workers->addTask([=](void) { this->read(key,file); });
+}
+
+/**
+ * Reads the chunk in the given file.
+ *
+ * This method is executed in a worker thread. The obstacles are built,
+ * but not added to the world.
+ *
+ * @param key   The chunk key
+ * @param file  The chunk file
+ */
+void LevelStreamer::read(Uint64 key, const std::string file) {
+    std::shared_ptr<LevelChunk> chunk = nullptr;
+    if (filetool::file_exists(file)) {
+        chunk = LevelChunk::allocWithFile(file);
+        if (chunk != nullptr) {
+            chunk->buildObstacles();
+        }
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    _ready.push_back(std::make_pair(key,chunk));
+}
+
+/**
+ * Inserts a chunk into the world and the scene graph.
+ *
+ * This method must be called in the main thread.
+ *
+ * @param key   The chunk key
+ * @param chunk The chunk to insert
+ */
+void LevelStreamer::insert(Uint64 key, const std::shared_ptr<LevelChunk>& chunk) {
+    _world->setBounds(_world->getBounds().getMerge(chunk->getBounds()));
+    _world->addObstacles(chunk->getObstacles(),true);
+    if (_loader != nullptr && _root != nullptr && chunk->getScene() != nullptr) {
+        std::string name = "chunk_"+std::to_string(chunk->getColumn())+"_"+std::to_string(chunk->getRow());
+        std::shared_ptr<scene2::SceneNode> node = _loader->build(name,chunk->getScene());
+        if (node != nullptr) {
+            chunk->setNode(node);
+            _root->addChild(node);
+        }
+    }
+    _resident[key] = chunk;
+    if (onLoad) {
+        onLoad(chunk);
+    }
+}
+
+/**
+ * Removes a chunk from the world and the scene graph.
+ *
+ * This method must be called in the main thread.
+ *
+ * @param chunk The chunk to remove
+ */
+void LevelStreamer::remove(const std::shared_ptr<LevelChunk>& chunk) {
+    if (onUnload) {
+        onUnload(chunk);
+    }
+    if (_world != nullptr) {
+        _world->removeObstacles(chunk->getObstacles(),true);
+    }
+    if (chunk->getNode() != nullptr) {
+        chunk->getNode()->removeFromParent();
+        chunk->setNode(nullptr);
+    }
+}
@@ -64,6 +64,73 @@ using namespace cugl;
 /** If the type is unknown */
 #define UNKNOWN_STR  "<unknown>"
 
+#pragma mark Deferred Placeholder
+/**
+ * A placeholder for a deferred scene subtree.
+ *
+ * This node stands in for a subtree whose widget is marked "deferred". It
+ * is initialized from the "data" of that widget, so it has the position and
+ * size of the subtree (if specified), but it draws nothing. The first time
+ * that it is drawn, it asks the loader to materialize the subtree, which
+ * then takes the place of this node in the scene graph.
+ */
+namespace {
+class DeferredNode : public scene2::SceneNode {
+public:
+    /** The JSON object defining the subtree */
+    std::shared_ptr<JsonValue> json;
+    /** The asset key of the subtree (assigned when attached) */
+    std::string key;
+    /** The loader that owns this placeholder (assigned when attached) */
+    std::weak_ptr<BaseLoader> loader;
+    /** Whether the subtree has been queued for materialization */
+    bool requested;
+    
+    /**
+     * Creates an uninitialized placeholder.
+     */
+    DeferredNode() : SceneNode(), requested(false) {}
+    
+    /**
+     * Returns a newly allocated placeholder for the given subtree.
+     *
+     * @param loader    The loader building the scene
+     * @param json      The JSON object defining the subtree
+     *
+     * @return a newly allocated placeholder for the given subtree.
+     */
+    static std::shared_ptr<DeferredNode> alloc(const Scene2Loader* loader,
+                                               const std::shared_ptr<JsonValue>& json) {
+        std::shared_ptr<DeferredNode> result = std::make_shared<DeferredNode>();
+        if (!result->initWithData(loader, json->get("data"))) {
+            return nullptr;
+        }
+        result->json = json;
+        return result;
+    }
+    
+    /**
+     * Requests the subtree the first time this placeholder is drawn.
+     *
+     * The subtree cannot replace this node while the scene graph is being
+     * rendered, so it is always materialized asynchronously.
+     *
+     * @param batch     The SpriteBatch to draw with.
+     * @param transform The global transformation matrix.
+     * @param tint      The tint to blend with the Node color.
+     */
+    void draw(const std::shared_ptr<SpriteBatch>&, const Affine2&, Color4) override {
+        if (requested) {
+            return;
+        }
+        std::shared_ptr<Scene2Loader> owner = std::dynamic_pointer_cast<Scene2Loader>(loader.lock());
+        if (owner != nullptr) {
+            owner->expandAsync(key);
+        }
+    }
+};
+}
+
 /**
  * Initializes a new asset loader.
  *
@@ -132,8 +199,17 @@ bool Scene2Loader::init(const std::shared_ptr<ThreadPool>& threads) {
  *                  layout-specific format.
  *      "children": Any child Nodes of this one. This JSON object has a
  *                  named attribute for each child.
+ *      "deferred": Whether to defer building this subtree until it is
+ *                  first drawn or accessed (see {@link #expand}).
  *
- * With the exception of "type", all of these attributes are JSON objects.
+ * With the exception of "type" and "deferred", all of these attributes
+ * are JSON objects. The root of the scene is never deferred. Children
+ * that fail to build are omitted from their parent.
+ *
+ * Deferred placeholders are only registered with this loader when the
+ * scene is attached to the asset dictionary. A scene built directly with
+ * this method, such as a {@link LevelStreamer} chunk, keeps any deferred
+ * subtrees as empty placeholders that are never expanded.
  *
  * @param key       The key to access the scene after loading
  * @param json      The JSON object defining the scene
@@ -246,11 +322,23 @@ std::shared_ptr<scene2::SceneNode> Scene2Loader::build(const std::string& key,
 			std::string key = item->key();
 			if (key != "comment") {
 				// If this is a widget, use the loaded widget json instead
+				bool deferred = item->getBool("deferred",false);
 				if (item->has("type") && item->getString("type") == "Widget") {
 					item = getWidgetJson(item);
 				}
 
-				std::shared_ptr<scene2::SceneNode> kid = build(key, item);
+				std::shared_ptr<scene2::SceneNode> kid = nullptr;
+				if (deferred) {
+					kid = DeferredNode::alloc(this, item);
+					if (kid != nullptr) {
+						kid->setName(key);
+					}
+				} else {
+					kid = build(key, item);
+				}
+				if (kid == nullptr) {
+					continue;
+				}
                 if (nonrelative) {
                     kid->setRelativeColor(false);
                 }
@@ -508,6 +596,35 @@ bool Scene2Loader::purge(const std::shared_ptr<JsonValue>& json) {
     return false;
 }
 
+/**
+ * Synchronously reloads the asset for the given directory entry
+ *
+ * This method rebuilds the scene from the directory entry, using the
+ * current versions of any assets (textures, fonts, widgets) that it
+ * references. The new scene replaces the old one (and all of its
+ * named descendants) in the asset dictionary. Objects that reference
+ * the old scene will continue to use it, so they should fetch the
+ * scene again after it is reloaded.
+ *
+ * @param json      The directory entry for the asset
+ *
+ * @return true if the asset was successfully reloaded
+ */
+bool Scene2Loader::refresh(const std::shared_ptr<JsonValue>& json) {
+    std::string key = json->key();
+    std::shared_ptr<scene2::SceneNode> node = build(key,json);
+    if (node == nullptr) {
+        return false;
+    }
+    node->doLayout();
+    
+    auto it = _assets.find(key);
+    if (it != _assets.end()) {
+        detach(key,it->second);
+    }
+    return attach(key,node);
+}
+
 /**
  * Attaches all generate nodes to the asset dictionary.
  *
@@ -521,6 +638,14 @@ bool Scene2Loader::purge(const std::shared_ptr<JsonValue>& json) {
  * @return true if the node was successfully attached
  */
 bool Scene2Loader::attach(const std::string& key, const std::shared_ptr<scene2::SceneNode>& node) {
+    std::shared_ptr<DeferredNode> holder = std::dynamic_pointer_cast<DeferredNode>(node);
+    if (holder != nullptr) {
+        holder->key = key;
+        holder->loader = shared_from_this();
+        _deferred[key] = holder;
+        return true;
+    }
+    
     _assets[key] = node;
     bool success = true;
     for(int ii = 0; ii < node->getChildren().size(); ii++) {
@@ -531,5 +656,202 @@ bool Scene2Loader::attach(const std::string& key, const std::shared_ptr<scene2::
     return success;
 }
 
+/**
+ * Detaches a previously attached node tree from the asset dictionary.
+ *
+ * This method is the inverse of {@link #attach}, and assumes that the
+ * keys for the descendants were generated by that method.
+ *
+ * @param key       The key to access the asset
+ * @param node      The scene asset
+ */
+void Scene2Loader::detach(const std::string& key, const std::shared_ptr<scene2::SceneNode>& node) {
+    if (std::dynamic_pointer_cast<DeferredNode>(node) != nullptr) {
+        _deferred.erase(key);
+        return;
+    }
+    
+    _assets.erase(key);
+    for(int ii = 0; ii < node->getChildren().size(); ii++) {
+        std::shared_ptr<scene2::SceneNode> item = node->getChild(ii);
+        detach(key+"_"+item->getName(), item);
+    }
+}
+
+/**
+ * Replaces the placeholder of a deferred subtree with the given node.
+ *
+ * The node takes the place of the placeholder in its parent, and is
+ * positioned by the layout manager of the parent. The node (and all of
+ * its named descendants) are then attached to the asset dictionary.
+ * This method must be called in the main thread.
+ *
+ * @param holder    The placeholder for the deferred subtree
+ * @param node      The materialized subtree
+ *
+ * @return true if the node was successfully attached
+ */
+bool Scene2Loader::replace(const std::shared_ptr<scene2::SceneNode>& holder,
+                           const std::shared_ptr<scene2::SceneNode>& node) {
+    std::shared_ptr<DeferredNode> deferred = std::dynamic_pointer_cast<DeferredNode>(holder);
+    std::string key = deferred->key;
+    _deferred.erase(key);
+    
+    node->setRelativeColor(holder->hasRelativeColor());
+    scene2::SceneNode* parent = holder->getParent();
+    if (parent != nullptr) {
+        parent->swapChild(holder, node);
+        if (parent->getLayout() != nullptr) {
+            parent->getLayout()->layout(parent);
+        }
+    }
+    return attach(key, node);
+}
+
+/**
+ * Materializes the deferred subtree containing the given key.
+ *
+ * The key may either be the key of the deferred subtree, or the key of
+ * one of its descendants. In the latter case, any deferred subtrees
+ * nested inside of the first one are materialized as well. This method
+ * must be called in the main thread.
+ *
+ * @param key   The key associated with the asset
+ *
+ * @return true if the asset was materialized
+ */
+bool Scene2Loader::demand(const std::string key) {
+    bool progress = true;
+    while (progress && _assets.find(key) == _assets.end()) {
+        // Descendant keys are prefixed by the key of the subtree
+        std::string prefix;
+        for(auto it = _deferred.begin(); prefix.empty() && it != _deferred.end(); ++it) {
+            const std::string& local = it->first;
+            if (key.compare(0, local.size(), local) == 0 &&
+                (key.size() == local.size() || key[local.size()] == '_')) {
+                prefix = local;
+            }
+        }
+        progress = !prefix.empty() && expand(prefix);
+    }
+    return _assets.find(key) != _assets.end();
+}
 
+/**
+ * Returns true if the given key refers to an unmaterialized subtree.
+ *
+ * A subtree is deferred if its widget has the attribute "deferred" set
+ * to true. Such a subtree is built as a placeholder node, which has the
+ * position and size of the subtree (if specified in its "data"), but
+ * draws nothing. The subtree is materialized when the placeholder is
+ * first drawn, when any key inside of it is requested from the asset
+ * manager, or when it is explicitly expanded. Until then, neither the
+ * subtree nor its descendants are in the asset dictionary.
+ *
+ * @param key   The key associated with the subtree
+ *
+ * @return true if the given key refers to an unmaterialized subtree.
+ */
+bool Scene2Loader::isDeferred(const std::string& key) const {
+    auto it = _deferred.find(key);
+    return it != _deferred.end() && !it->second.expired();
+}
+
+/**
+ * Synchronously materializes the given deferred subtree.
+ *
+ * The subtree replaces its placeholder in the scene graph, and it (and
+ * all of its named descendants) are added to the asset dictionary. Any
+ * deferred subtrees nested inside of it remain deferred. This method
+ * must be called in the main thread.
+ *
+ * @param key   The key associated with the subtree
+ *
+ * @return true if the subtree was materialized
+ */
+bool Scene2Loader::expand(const std::string& key) {
+    auto it = _deferred.find(key);
+    if (it == _deferred.end()) {
+        return false;
+    }
+    std::shared_ptr<DeferredNode> holder = std::dynamic_pointer_cast<DeferredNode>(it->second.lock());
+    if (holder == nullptr) {
+        // The scene was discarded before the subtree was needed
+        _deferred.erase(it);
+        return false;
+    }
+    
+    std::shared_ptr<scene2::SceneNode> node = build(holder->getName(), holder->json);
+    if (node == nullptr) {
+        CULogError("Could not build deferred scene '%s'",key.c_str());
+        _deferred.erase(it);
+        return false;
+    }
+    node->doLayout();
+    return replace(holder, node);
+}
 
+/**
+ * Asynchronously materializes the given deferred subtree.
+ *
+ * The scene nodes are built in the thread pool of this loader, while
+ * the subtree replaces its placeholder in the main thread, via
+ * {@link Application#schedule}. If this loader has no thread pool,
+ * the subtree is materialized synchronously in the next animation frame.
+ * This method is called automatically when a placeholder is first drawn.
+ *
+ * The optional callback function will be called with the key of the
+ * subtree when it is materialized or fails to materialize.
+ *
+ * @param key       The key associated with the subtree
+ * @param callback  An optional callback for when the subtree is built
+ *
+ * @return true if the subtree was queued for materialization
+ */
+bool Scene2Loader::expandAsync(const std::string& key, LoaderCallback callback) {
+    auto it = _deferred.find(key);
+    std::shared_ptr<DeferredNode> holder = nullptr;
+    if (it != _deferred.end()) {
+        holder = std::dynamic_pointer_cast<DeferredNode>(it->second.lock());
+    }
+    if (holder == nullptr || holder->requested) {
+        return false;
+    }
+    holder->requested = true;
+    
+    if (_loader == nullptr) {
+        Application::get()->schedule([=](void) {
+            bool success = this->expand(key);
+            if (callback != nullptr) {
+                callback(key,success);
+            }
+            return false;
+        });
+        return true;
+    }
+    
+    std::string name = holder->getName();
+    std::shared_ptr<JsonValue> json = holder->json;
+    std::weak_ptr<scene2::SceneNode> weak = holder;
+    _loader->addTask([=](void) {
+        std::shared_ptr<scene2::SceneNode> node = build(name,json);
+        if (node != nullptr) {
+            node->doLayout();
+        }
+        Application::get()->schedule([=](void) {
+            // The subtree may have been expanded or discarded in the meantime
+            std::shared_ptr<scene2::SceneNode> current = weak.lock();
+            auto jt = this->_deferred.find(key);
+            bool success = false;
+            if (node != nullptr && current != nullptr && jt != this->_deferred.end() &&
+                jt->second.lock() == current) {
+                success = this->replace(current, node);
+            }
+            if (callback != nullptr) {
+                callback(key,success);
+            }
+            return false;
+        });
+    });
+    return true;
+}
@@ -237,3 +237,23 @@ bool SoundLoader::read(const std::shared_ptr<JsonValue>& json, LoaderCallback ca
     
     return success;
 }
+
+#pragma mark -
+#pragma mark Memory Management
+/**
+ * Returns the number of bytes used by the given sound.
+ *
+ * This is the size of the in-memory sample buffer. Streamed samples
+ * only hold a small page buffer, and so return 0.
+ *
+ * @param asset The sound to measure
+ *
+ * @return the number of bytes used by the given sound.
+ */
+size_t SoundLoader::measure(const std::shared_ptr<Sound>& asset) const {
+    std::shared_ptr<AudioSample> sample = std::dynamic_pointer_cast<AudioSample>(asset);
+    if (sample == nullptr || sample->isStreamed() || sample->getLength() <= 0) {
+        return 0;
+    }
+    return (size_t)sample->getLength()*sample->getChannels()*sizeof(float);
+}
@@ -456,6 +456,53 @@ bool TextureLoader::purge(const std::shared_ptr<JsonValue>& json) {
     return success;
 }
 
+/**
+ * Synchronously reloads the asset for the given directory entry
+ *
+ * If the texture is already loaded, the image is replaced in place
+ * (see {@link Texture#set}). Therefore any object that references the
+ * texture, including any atlas subtextures, will see the new image.
+ * The texture settings (filters, wrap, mipmaps) are reapplied from the
+ * directory entry. If the texture is not loaded, it is read as normal.
+ *
+ * @param json      The directory entry for the asset
+ *
+ * @return true if the asset was successfully reloaded
+ */
+bool TextureLoader::refresh(const std::shared_ptr<JsonValue>& json) {
+    std::string key = json->key();
+    auto it = _assets.find(key);
+    if (it == _assets.end()) {
+        return read(json,nullptr,false);
+    }
+    
+    std::string source = json->getString("file",UNKNOWN_SOURCE);
+    SDL_Surface* surface = preload(source);
+    if (surface == nullptr) {
+        CULogError("Could not reload texture '%s' from '%s'",key.c_str(),source.c_str());
+        return false;
+    }
+
+    GLuint minflt = decodeMinFilter(json->getString("minfilter",UNKNOWN_MINFLT));
+    GLuint magflt = decodeMinFilter(json->getString("magfilter",UNKNOWN_MAGFLT));
+    GLuint wrapS = decodeWrap(json->getString("wrapS",UNKNOWN_WRAP));
+    GLuint wrapT = decodeWrap(json->getString("wrapT",UNKNOWN_WRAP));
+    bool mipmaps = json->getBool("mipmaps",false);
+
+    std::shared_ptr<Texture> texture = it->second;
+    texture->bind();
+    texture->set(surface->pixels, surface->w, surface->h);
+    if (mipmaps && !texture->hasMipMaps()) { texture->buildMipMaps(); }
+    texture->setMinFilter(minflt);
+    texture->setMagFilter(magflt);
+    texture->setWrapS(wrapS);
+    texture->setWrapT(wrapT);
+    texture->unbind();
+    parseAtlas(json,texture);
+    SDL_FreeSurface(surface);
+    return true;
+}
+
 #pragma mark -
 #pragma mark Atlas Support
 /**
@@ -485,3 +532,23 @@ void TextureLoader::parseAtlas(const std::shared_ptr<JsonValue>& json, const std
     }
 }
 
+#pragma mark -
+#pragma mark Memory Management
+/**
+ * Returns the number of bytes used by the given texture.
+ *
+ * This is the size of the pixel data on the GPU, including mipmaps.
+ * Subtextures share the memory of their parent, and so return 0.
+ *
+ * @param asset The texture to measure
+ *
+ * @return the number of bytes used by the given texture.
+ */
+size_t TextureLoader::measure(const std::shared_ptr<Texture>& asset) const {
+    if (asset == nullptr || asset->isSubTexture()) {
+        return 0;
+    }
+    size_t bytes = (size_t)asset->getWidth()*asset->getHeight()*asset->getByteSize();
+    // A full mipmap chain adds a third to the base level
+    return asset->hasMipMaps() ? bytes+bytes/3 : bytes;
+}
@@ -567,7 +567,7 @@ void AudioEngine::freeQueue(const std::shared_ptr<AudioQueue>& queue) {
  *
  * @return true if there was an available channel for the sound
  */
-bool AudioEngine::play(const std::string key, const std::shared_ptr<Sound>& sound,
+bool AudioEngine::play(const std::string& key, const std::shared_ptr<Sound>& sound,
                        bool loop, float volume, bool force) {
     CUAssertLog(_output != nullptr, "Attempt to use an unintiatialized audio engine");
 
@@ -655,7 +655,7 @@ bool AudioEngine::play(const std::string key, const std::shared_ptr<Sound>& soun
  *
  * @return true if there was an available channel for the sound
  */
-bool AudioEngine::play(const std::string key, const std::shared_ptr<audio::AudioNode>& graph,
+bool AudioEngine::play(const std::string& key, const std::shared_ptr<audio::AudioNode>& graph,
                        bool loop, float volume, bool force) {
     CUAssertLog(_output != nullptr, "Attempt to use an unintiatialized audio engine");
     CUAssertLog(graph->getName() != "__engine_playback__",  "Audio node uses reserved name '__engine_playback__'");
@@ -723,7 +723,7 @@ bool AudioEngine::play(const std::string key, const std::shared_ptr<audio::Audio
  *
  * @return the current state of the sound effect for the given key.
  */
-AudioEngine::State AudioEngine::getState(const std::string key) const {
+AudioEngine::State AudioEngine::getState(const std::string& key) const {
     CUAssertLog(_output != nullptr, "Attempt to use an unintiatialized audio engine");
     if (_actives.find(key) == _actives.end()) {
         return State::INACTIVE;
@@ -751,7 +751,7 @@ AudioEngine::State AudioEngine::getState(const std::string key) const {
  *
  * @return the identifier for the asset attached to the given key.
  */
-const std::string AudioEngine::getSource(const std::string key) const {
+const std::string AudioEngine::getSource(const std::string& key) const {
     CUAssertLog(_output != nullptr, "Attempt to use an unintiatialized audio engine");
     if (_actives.find(key) == _actives.end()) {
         return std::string();
@@ -777,7 +777,7 @@ const std::string AudioEngine::getSource(const std::string key) const {
  *
  * @return true if the sound effect is in a continuous loop.
  */
-bool AudioEngine::isLoop(const std::string key) const {
+bool AudioEngine::isLoop(const std::string& key) const {
     CUAssertLog(_output != nullptr, "Attempt to use an unintiatialized audio engine");
     if (_actives.find(key) != _actives.end()) {
         std::shared_ptr<AudioNode> node = _actives.at(key);
@@ -796,7 +796,7 @@ bool AudioEngine::isLoop(const std::string key) const {
  * @param  key  the reference key for the sound effect
  * @param  loop whether the sound effect is in a continuous loop
  */
-void AudioEngine::setLoop(const std::string key, bool loop) {
+void AudioEngine::setLoop(const std::string& key, bool loop) {
     CUAssertLog(_output != nullptr, "Attempt to use an unintiatialized audio engine");
     if (_actives.find(key) != _actives.end()) {
         std::shared_ptr<AudioNode> node = _actives.at(key);
@@ -820,7 +820,7 @@ void AudioEngine::setLoop(const std::string key, bool loop) {
  *
  * @return the current volume of the sound effect
  */
-float AudioEngine::getVolume(const std::string key) const {
+float AudioEngine::getVolume(const std::string& key) const {
     CUAssertLog(_output != nullptr, "Attempt to use an unintiatialized audio engine");
     if (_actives.find(key) != _actives.end()) {
         Uint32 tag = _actives.at(key)->getTag();
@@ -845,7 +845,7 @@ float AudioEngine::getVolume(const std::string key) const {
  * @param  key      the reference key for the sound effect
  * @param  volume   the current volume of the sound effect
  */
-void AudioEngine::setVolume(const std::string key, float volume) {
+void AudioEngine::setVolume(const std::string& key, float volume) {
     CUAssertLog(_output != nullptr, "Attempt to use an unintiatialized audio engine");
     if (_actives.find(key) != _actives.end()) {
         Uint32 tag = _actives.at(key)->getTag();
@@ -907,7 +907,7 @@ float AudioEngine::getPanFactor(const std::string& key) const {
  * @param  key  the reference key for the sound effect
  * @param  pan  the stereo pan of the sound effect
  */
-void AudioEngine::setPanFactor(const std::string key, float pan) {
+void AudioEngine::setPanFactor(const std::string& key, float pan) {
     CUAssertLog(_output != nullptr, "Attempt to use an unintiatialized audio engine");
     CUAssertLog(pan >= -1 && pan <= 1, "Pan value %f is out of range",pan);
     if (_actives.find(key) != _actives.end()) {
@@ -946,7 +946,7 @@ void AudioEngine::setPanFactor(const std::string key, float pan) {
  *
  * @return the duration of the sound effect, in seconds.
  */
-float AudioEngine::getDuration(const std::string key) const  {
+float AudioEngine::getDuration(const std::string& key) const  {
     CUAssertLog(_output != nullptr, "Attempt to use an unintiatialized audio engine");
     if (_actives.find(key) != _actives.end()) {
         std::shared_ptr<audio::AudioNode> source = accessInstance(_actives.at(key));
@@ -982,7 +982,7 @@ float AudioEngine::getDuration(const std::string key) const  {
  *
  * @return the elapsed time of the sound effect, in seconds
  */
-float AudioEngine::getTimeElapsed(const std::string key) const {
+float AudioEngine::getTimeElapsed(const std::string& key) const {
     CUAssertLog(_output != nullptr, "Attempt to use an unintiatialized audio engine");
     if (_actives.find(key) != _actives.end()) {
         return _actives.at(key)->getElapsed();
@@ -1007,7 +1007,7 @@ float AudioEngine::getTimeElapsed(const std::string key) const {
  * @param  key  the reference key for the sound effect
  * @param  time the new position of the sound effect
  */
-void AudioEngine::setTimeElapsed(const std::string key, float time) {
+void AudioEngine::setTimeElapsed(const std::string& key, float time) {
     CUAssertLog(_output != nullptr, "Attempt to use an unintiatialized audio engine");
     if (_actives.find(key) != _actives.end()) {
         _actives.at(key)->setElapsed(time);
@@ -1030,7 +1030,7 @@ void AudioEngine::setTimeElapsed(const std::string key, float time) {
  *
  * @return the time remaining for the sound effect, in seconds
  */
-float AudioEngine::geTimeRemaining(const std::string key) const  {
+float AudioEngine::geTimeRemaining(const std::string& key) const  {
     CUAssertLog(_output != nullptr, "Attempt to use an unintiatialized audio engine");
     if (_actives.find(key) != _actives.end()) {
         return _actives.at(key)->getRemaining();
@@ -1053,7 +1053,7 @@ float AudioEngine::geTimeRemaining(const std::string key) const  {
  * @param  key  the reference key for the sound effect
  * @param  time the new time remaining for the sound effect
  */
-void AudioEngine::setTimeRemaining(const std::string key, float time) {
+void AudioEngine::setTimeRemaining(const std::string& key, float time) {
     CUAssertLog(_output != nullptr, "Attempt to use an unintiatialized audio engine");
     if (_actives.find(key) != _actives.end()) {
         _actives.at(key)->setRemaining(time);
@@ -1079,7 +1079,7 @@ void AudioEngine::setTimeRemaining(const std::string key, float time) {
  * @param  key  the reference key for the sound effect
  * @param fade  the number of seconds to fade out
  */
-void AudioEngine::clear(const std::string key,float fade) {
+void AudioEngine::clear(const std::string& key,float fade) {
     CUAssertLog(_output != nullptr, "Attempt to use an unintiatialized audio engine");
     if (_actives.find(key) != _actives.end()) {
         std::shared_ptr<AudioFader> node = _actives.at(key);
@@ -1105,7 +1105,7 @@ void AudioEngine::clear(const std::string key,float fade) {
  * @param  key  the reference key for the sound effect
  * @param fade  the number of seconds to fade out
  */
-void AudioEngine::pause(const std::string key,float fade) {
+void AudioEngine::pause(const std::string& key,float fade) {
     CUAssertLog(_output != nullptr, "Attempt to use an unintiatialized audio engine");
     if (_actives.find(key) != _actives.end()) {
         std::shared_ptr<AudioFader> node = _actives.at(key);
@@ -1120,7 +1120,7 @@ void AudioEngine::pause(const std::string key,float fade) {
  *
  * @param  key  the reference key for the sound effect
  */
-void AudioEngine::resume(std::string key) {
+void AudioEngine::resume(const std::string& key) {
     CUAssertLog(_output != nullptr, "Attempt to use an unintiatialized audio engine");
     if (_actives.find(key) != _actives.end()) {
         std::shared_ptr<AudioFader> node = _actives.at(key);
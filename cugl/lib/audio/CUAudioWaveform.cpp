@@ -45,6 +45,7 @@
 #include <cugl/util/CUStrings.h>
 #include <chrono>
 #include <algorithm>
+#include <vector>
 
 using namespace cugl;
 
@@ -76,6 +77,269 @@ double poly_blep(double t, double dt) {
     return 0.0;
 }
 
+#pragma mark -
+#pragma mark Wavetables
+/** The number of bits in a wavetable index */
+#define TABLE_BITS      11
+/** The number of samples in a single wavetable period */
+#define TABLE_SIZE      (1 << TABLE_BITS)
+/** The number of mipmap levels (level l has at most TABLE_SIZE/2 >> l harmonics) */
+#define TABLE_LEVELS    TABLE_BITS
+
+/**
+ * The shapes supported by wavetable mode
+ *
+ * The naive and band-limited versions of a waveform share the same shape.
+ * Upper (nonnegative) sines and impulse trains have different harmonics,
+ * and so they have their own shapes.
+ */
+enum class TableShape : int {
+    SINE      = 0,
+    RECTIFIED = 1,
+    TRIANGLE  = 2,
+    SQUARE    = 3,
+    SAWTOOTH  = 4,
+    BIPOLAR   = 5,
+    UNIPOLAR  = 6,
+    UNKNOWN   = 7
+};
+
+/**
+ * This class represents a mipmapped band-limited wavetable
+ *
+ * Each level is a single period of TABLE_SIZE samples, plus a guard sample
+ * for interpolation. Level l contains only the harmonics up to TABLE_SIZE/2
+ * >> l, so it is alias-free for any frequency whose ratio to the sample
+ * rate is at most 1/(TABLE_SIZE >> l).
+ */
+class Wavetable {
+public:
+    /** The samples for all of the levels */
+    std::vector<float> data;
+    
+    /**
+     * Returns the samples for the given level
+     *
+     * @param level The mipmap level
+     *
+     * @return the samples for the given level
+     */
+    const float* level(Uint32 level) const {
+        return data.data()+level*(TABLE_SIZE+1);
+    }
+};
+
+/**
+ * Returns the amplitude of the given harmonic for a wavetable shape
+ *
+ * The harmonic is a cosine term if cosine is true and a sine term
+ * otherwise. The 0th harmonic is the DC offset. Impulse trains are not
+ * normalized by this function.
+ *
+ * @param shape     The wavetable shape
+ * @param harmonic  The harmonic number
+ * @param cosine    Set to true if this is a cosine term
+ *
+ * @return the amplitude of the given harmonic for a wavetable shape
+ */
+static double table_harmonic(TableShape shape, Uint32 harmonic, bool& cosine) {
+    double k = harmonic;
+    bool odd = (harmonic & 1) == 1;
+    cosine = false;
+    switch (shape) {
+        case TableShape::SINE:
+            return harmonic == 1 ? 1.0 : 0.0;
+        case TableShape::RECTIFIED:
+            // |sin x| = 2/pi - 4/pi sum cos(2mx)/(4m^2-1)
+            cosine = true;
+            if (harmonic == 0) {
+                return 2.0/M_PI;
+            }
+            return odd ? 0.0 : -4.0/(M_PI*(k*k-1));
+        case TableShape::TRIANGLE:
+            // Peaks at 1 at the start of the period, like NAIVE_TRIANG
+            cosine = true;
+            return odd ? 8.0/(M_PI*M_PI*k*k) : 0.0;
+        case TableShape::SQUARE:
+            // 1 on the first half of the period, -1 on the second
+            return odd ? 4.0/(M_PI*k) : 0.0;
+        case TableShape::SAWTOOTH:
+            // Rises from -1 to 1, like POLY_TOOTH
+            return harmonic == 0 ? 0.0 : -2.0/(M_PI*k);
+        case TableShape::BIPOLAR:
+            cosine = true;
+            return odd ? 1.0 : 0.0;
+        case TableShape::UNIPOLAR:
+            cosine = true;
+            if (harmonic == 0) {
+                return 1.0;
+            }
+            return odd ? 0.0 : 2.0;
+        case TableShape::UNKNOWN:
+            break;
+    }
+    return 0.0;
+}
+
+/**
+ * Returns a newly built mipmapped wavetable for the given shape
+ *
+ * The levels are built by additive synthesis, starting with the level with
+ * the fewest harmonics. Each level is a copy of the one before it, plus the
+ * harmonics that are new to that level. The impulse trains are normalized
+ * so that each level peaks at 1.
+ *
+ * @param shape The wavetable shape
+ *
+ * @return a newly built mipmapped wavetable for the given shape
+ */
+static Wavetable* build_table(TableShape shape) {
+    // Exact sines for every harmonic of the table
+    std::vector<double> sines(TABLE_SIZE);
+    for(Uint32 ii = 0; ii < TABLE_SIZE; ii++) {
+        sines[ii] = std::sin(2*M_PI*ii/TABLE_SIZE);
+    }
+    
+    Wavetable* result = new Wavetable();
+    result->data.resize(TABLE_LEVELS*(TABLE_SIZE+1),0.0f);
+    std::vector<double> accum(TABLE_SIZE,0.0);
+    
+    bool cosine = false;
+    double peak = table_harmonic(shape,0,cosine);
+    for(Uint32 ii = 0; ii < TABLE_SIZE; ii++) {
+        accum[ii] = peak;
+    }
+    
+    Uint32 harmonic = 1;
+    for(int level = TABLE_LEVELS-1; level >= 0; level--) {
+        Uint32 limit = (TABLE_SIZE/2) >> level;
+        for(; harmonic <= limit; harmonic++) {
+            double amp = table_harmonic(shape,harmonic,cosine);
+            if (amp == 0) {
+                continue;
+            }
+            Uint32 offset = cosine ? TABLE_SIZE/4 : 0;
+            for(Uint32 ii = 0; ii < TABLE_SIZE; ii++) {
+                accum[ii] += amp*sines[(harmonic*ii+offset) % TABLE_SIZE];
+            }
+            peak += amp;
+        }
+        
+        // Impulse trains are normalized so that the pulses have height 1
+        double scale = 1.0;
+        if (shape == TableShape::BIPOLAR || shape == TableShape::UNIPOLAR) {
+            scale = 1.0/peak;
+        }
+        float* dst = result->data.data()+level*(TABLE_SIZE+1);
+        for(Uint32 ii = 0; ii < TABLE_SIZE; ii++) {
+            dst[ii] = (float)(accum[ii]*scale);
+        }
+        dst[TABLE_SIZE] = dst[0];
+    }
+    return result;
+}
+
+/**
+ * Returns the shared wavetable for the given shape
+ *
+ * The tables are built on first use, which is thread safe. They are never
+ * deallocated.
+ *
+ * @param shape The wavetable shape
+ *
+ * @return the shared wavetable for the given shape
+ */
+static const Wavetable* acquire_table(TableShape shape) {
+    switch (shape) {
+        case TableShape::SINE:
+        {
+            static const Wavetable* table = build_table(TableShape::SINE);
+            return table;
+        }
+        case TableShape::RECTIFIED:
+        {
+            static const Wavetable* table = build_table(TableShape::RECTIFIED);
+            return table;
+        }
+        case TableShape::TRIANGLE:
+        {
+            static const Wavetable* table = build_table(TableShape::TRIANGLE);
+            return table;
+        }
+        case TableShape::SQUARE:
+        {
+            static const Wavetable* table = build_table(TableShape::SQUARE);
+            return table;
+        }
+        case TableShape::SAWTOOTH:
+        {
+            static const Wavetable* table = build_table(TableShape::SAWTOOTH);
+            return table;
+        }
+        case TableShape::BIPOLAR:
+        {
+            static const Wavetable* table = build_table(TableShape::BIPOLAR);
+            return table;
+        }
+        case TableShape::UNIPOLAR:
+        {
+            static const Wavetable* table = build_table(TableShape::UNIPOLAR);
+            return table;
+        }
+        case TableShape::UNKNOWN:
+            break;
+    }
+    return nullptr;
+}
+
+/**
+ * Returns the wavetable shape for the given waveform type
+ *
+ * @param type  The waveform type
+ * @param upper Whether the waveform has only nonnegative samples
+ *
+ * @return the wavetable shape for the given waveform type
+ */
+static TableShape table_shape(AudioWaveform::Type type, bool upper) {
+    switch (type) {
+        case AudioWaveform::Type::SINE:
+            return upper ? TableShape::RECTIFIED : TableShape::SINE;
+        case AudioWaveform::Type::NAIVE_TRIANG:
+        case AudioWaveform::Type::POLY_TRIANG:
+            return TableShape::TRIANGLE;
+        case AudioWaveform::Type::NAIVE_SQUARE:
+        case AudioWaveform::Type::POLY_SQUARE:
+            return TableShape::SQUARE;
+        case AudioWaveform::Type::NAIVE_TOOTH:
+        case AudioWaveform::Type::POLY_TOOTH:
+            return TableShape::SAWTOOTH;
+        case AudioWaveform::Type::NAIVE_TRAIN:
+        case AudioWaveform::Type::BLIT_TRAIN:
+            return upper ? TableShape::UNIPOLAR : TableShape::BIPOLAR;
+        default:
+            break;
+    }
+    return TableShape::UNKNOWN;
+}
+
+/**
+ * Returns the mipmap level for the given frequency ratio
+ *
+ * This is the level with the most harmonics such that no harmonic exceeds
+ * the Nyquist frequency.
+ *
+ * @param ratio The ratio of the frequency to the sample rate
+ *
+ * @return the mipmap level for the given frequency ratio
+ */
+static Uint32 table_level(double ratio) {
+    Uint32 level = 0;
+    while (level < TABLE_LEVELS-1 && ((TABLE_SIZE/2) >> level)*ratio > 0.5) {
+        level++;
+    }
+    return level;
+}
+
 #pragma mark -
 #pragma mark AudioWaveNode Interface
 
@@ -660,7 +924,8 @@ _type(0),
 _upper(false),
 _newfreq(false),
 _duration(-1),
-_frequency(-1) {
+_frequency(-1),
+_wavetable(false) {
 }
 
 /**
@@ -730,6 +995,7 @@ bool AudioWaveform::init(Uint8 channels, Uint32 rate, Type type, float frequency
  *      "rate":     An int, representing the sample rate
  *      "volume":   A float, representing the volume
  *      "duration"  A float, representing the duration in seconds
+ *      "wavetable" A boolean, indicating whether to use wavetable mode
  *
  * All attributes are optional.  There are no required attributes. The
  * recognized shapes are as follows: noise, sine, native triangle, naive
@@ -775,6 +1041,7 @@ std::shared_ptr<AudioWaveform> AudioWaveform::allocWithData(const std::shared_pt
     if (wave) {
         wave->setUpper(data->getBool("upper",false));
         wave->setDuration(data->getFloat("duration",-1));
+        wave->setWavetable(data->getBool("wavetable",false));
     }
     return wave;
 }
@@ -792,6 +1059,7 @@ void AudioWaveform::dispose() {
     _newfreq.store(false);
     _frequency.store(-1);
     _duration.store(-1);
+    _wavetable.store(false);
 }
 
 #pragma mark Generator Attributes
@@ -812,6 +1080,10 @@ AudioWaveform::Type AudioWaveform::getType() const {
 void AudioWaveform::setType(Type type) {
     int value = (int)type;
     _type.store(value,std::memory_order_relaxed);
+    if (_wavetable.load(std::memory_order_relaxed)) {
+        acquire_table(table_shape(type,false));
+        acquire_table(table_shape(type,true));
+    }
 }
 
 /**
@@ -846,6 +1118,43 @@ void AudioWaveform::setUpper(bool upper) {
     _upper.store(upper,std::memory_order_relaxed);
 }
 
+/**
+ * Returns true if this waveform is read from a precomputed wavetable.
+ *
+ * In wavetable mode, all waveforms other than noise are read from
+ * band-limited tables using interpolated lookups. The tables are
+ * mipmapped by octave, so that no harmonic exceeds the Nyquist frequency.
+ * The naive and band-limited versions of a waveform share the same table.
+ *
+ * @return true if this waveform is read from a precomputed wavetable.
+ */
+bool AudioWaveform::isWavetable() const {
+    return _wavetable.load(std::memory_order_relaxed);
+}
+
+/**
+ * Sets whether this waveform is read from a precomputed wavetable.
+ *
+ * In wavetable mode, all waveforms other than noise are read from
+ * band-limited tables using interpolated lookups. The tables are
+ * mipmapped by octave, so that no harmonic exceeds the Nyquist frequency.
+ * The naive and band-limited versions of a waveform share the same table.
+ *
+ * The tables are shared by all waveforms, and are built the first time
+ * they are needed. This method builds the tables for the current type
+ * so that this cost is not paid in the audio thread.
+ *
+ * @param value Whether this waveform is read from a precomputed wavetable.
+ */
+void AudioWaveform::setWavetable(bool value) {
+    if (value) {
+        Type type = (Type)_type.load(std::memory_order_relaxed);
+        acquire_table(table_shape(type,false));
+        acquire_table(table_shape(type,true));
+    }
+    _wavetable.store(value,std::memory_order_relaxed);
+}
+
 /**
  * Returns the fundamental frequency of this waveform.
  *
@@ -958,6 +1267,33 @@ Uint32 AudioWaveform::generate(float* buffer, Uint32 frames, Uint64 offset, floa
     
     Uint32 pos = (Uint32)offset;
     float* output = buffer;
+    
+    // Wavetable mode has the same cost for all types
+    TableShape shape = table_shape(type,upper);
+    if (shape != TableShape::UNKNOWN && _wavetable.load(std::memory_order_relaxed)) {
+        const Wavetable* table = acquire_table(shape);
+        const double FIXED = 4294967296.0;
+        double start = ratio*(double)offset;
+        Uint32 phase = (Uint32)((start-std::floor(start))*FIXED);
+        Uint32 step  = (Uint32)((ratio-std::floor(ratio))*FIXED);
+        dsp::DSPMath::wavetable(table->level(table_level(std::fabs(ratio))),TABLE_BITS,phase,step,buffer,amt);
+        
+        // Rescale the upper waveforms and expand the channels in place
+        bool affine = upper && shape != TableShape::RECTIFIED && shape != TableShape::UNIPOLAR;
+        if (affine || _channels > 1) {
+            float gain = affine ? 0.5f : 1.0f;
+            float bias = affine ? 0.5f : 0.0f;
+            for(Uint32 ii = amt; ii > 0; ii--) {
+                float value = buffer[ii-1]*gain+bias;
+                float* dst = buffer+(ii-1)*_channels;
+                for(int jj = 0; jj < _channels; jj++) {
+                    dst[jj] = value;
+                }
+            }
+        }
+        return amt;
+    }
+    
     switch (type) {
         case Type::NOISE:
             while (tmp--) {
@@ -36,6 +36,7 @@
 //  Version: 8/20/18
 //
 #include <cugl/audio/codecs/CUFLACDecoder.h>
+#include <cugl/math/dsp/CUDSPMath.h>
 #include <cassert>
 #include <climits>
 
@@ -340,15 +341,9 @@ Sint32 FLACDecoder::pagein(float* buffer) {
         Sint32 avail = (Sint32)(_buffsize - _bufflast);
         avail = (_pagesize - read < avail ? _pagesize - read : avail);
         
-        Uint32 temp = avail*_channels;
-        float* output = buffer+(_bufflast*_channels);
-        Sint32* input = _buffer;
-        double factor = 1/(1L << _sampsize);
-        while (temp--) {
-            *output = (float)(*input*factor);
-            output++;
-            input++;
-        }
+        float factor = 1.0f/(1L << _sampsize);
+        dsp::DSPMath::s32_to_float(_buffer+_bufflast*_channels, buffer+read*_channels,
+                                   avail*_channels, factor);
         read += avail;
         _bufflast += avail;
         
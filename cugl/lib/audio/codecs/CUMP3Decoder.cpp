@@ -35,6 +35,7 @@
 //  Version: 8/20/18
 //
 #include <cugl/audio/codecs/CUMP3Decoder.h>
+#include <cugl/math/dsp/CUDSPMath.h>
 #include <cassert>
 #include <climits>
 
@@ -174,17 +175,8 @@ Sint32 MP3Decoder::pagein(float* buffer) {
     }
     
     Uint32 amount = (Uint32)_decoder->run(_chunker,1);
-    double factor = 1/(SHRT_MAX+1);
-
-    Uint32 temp = amount;
-    float* output = buffer;
-    short* input  = _chunker;
-
-    while (temp--) {
-        *output = (float)((*input)*factor);
-        output++;
-        input++;
-    }
+    float factor = 1.0f/(SHRT_MAX+1);
+    dsp::DSPMath::s16_to_float(_chunker, buffer, amount, factor);
     
     _currpage++;
     return amount/_channels;
@@ -37,6 +37,7 @@
 //  Version: 6/29/17
 //
 #include <cugl/audio/codecs/CUOGGDecoder.h>
+#include <cugl/math/dsp/CUDSPMath.h>
 #include <cassert>
 #include <climits>
 
@@ -45,6 +46,8 @@ using namespace cugl::audio;
 #pragma mark OGG Utilities
 /** The default page size (in bytes) */
 #define PAGE_SIZE   4096
+/** The maximum number of channels to interleave with a single call */
+#define MAX_PLANES  8
 
 /**
  * Returns the SDL channel for the given OGG channel
@@ -279,17 +282,23 @@ Sint32 OGGDecoder::pagein(float* buffer) {
         }
         
         // Copy everything into its place
-        for (Uint32 ch = 0; ch < _channels; ++ch) {
+        if (_channels <= MAX_PLANES) {
             // OGG representation differs from SDL representation
-            Uint32 outch = ogg2sdl(ch,_channels);
-            
-            float* output = buffer+(read*_channels)+outch;
-            float* input  = pcmb[ch];
-            Uint32 temp = avail;
-            while (temp--) {
-                *output = *input;
-                output += _channels;
-                input++;
+            const float* planes[MAX_PLANES];
+            for (Uint32 ch = 0; ch < _channels; ++ch) {
+                planes[ogg2sdl(ch,_channels)] = pcmb[ch];
+            }
+            dsp::DSPMath::interleave(planes, buffer+(read*_channels), _channels, avail);
+        } else {
+            for (Uint32 ch = 0; ch < _channels; ++ch) {
+                float* output = buffer+(read*_channels)+ch;
+                float* input  = pcmb[ch];
+                Uint32 temp = avail;
+                while (temp--) {
+                    *output = *input;
+                    output += _channels;
+                    input++;
+                }
             }
         }
         
@@ -35,9 +35,16 @@
 //  Version: 6/29/17
 //
 #include <cugl/audio/codecs/CUWAVDecoder.h>
+#include <cugl/math/dsp/CUDSPMath.h>
 #include <cugl/util/CUDebug.h>
+#include <cugl/util/CUThreadPool.h>
 #include <cassert>
 #include <climits>
+#include <cstring>
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <atomic>
 
 using namespace cugl::audio;
 
@@ -63,6 +70,13 @@ using namespace cugl::audio;
 #define WAVE_STEREO     2
 #define PAGE_SIZE       4096
 
+/** The maximum number of threads to use when decoding ADPCM data */
+#define ADPCM_MAX_THREADS   4
+/** The minimum number of ADPCM blocks to assign to a decoding thread */
+#define ADPCM_MIN_BLOCKS    64
+/** The number of helper threads shared by all ADPCM decoders */
+#define ADPCM_POOL_THREADS  (ADPCM_MAX_THREADS-1)
+
 
 #pragma mark -
 #pragma mark Chunk Management
@@ -140,6 +154,38 @@ bool ADPCMDecoder::init(WaveFMT * format) {
     return true;
 }
 
+/**
+ * Reads a single page from the given file.
+ *
+ * The buffer should be able to store block size * channels * 2 bytes of
+ * data (the latter 2 representing sizeof(Sint16) ). If the read fails,
+ * this method returns -1.
+ *
+ * @param source    The source file
+ * @param buffer    The buffer to store the decoded data
+ *
+ * @return the number of bytes read (or -1 on error)
+ */
+Sint32 ADPCMDecoder::read(SDL_RWops* source, Uint8* buffer) {
+    // Read in a single block align
+    if (!SDL_RWread(source, _blkbuffer, _wavefmt.blockalign, 1)) {
+        return -1;
+    }
+    decode(_blkbuffer, (Sint16*)buffer);
+    return _blocksize * _wavefmt.channels * sizeof(Sint16);
+}
+
+/**
+ * Returns a signed 16 bit value read from little endian encoded data
+ *
+ * @param encoded   The encoded data
+ *
+ * @return a signed 16 bit value read from little endian encoded data
+ */
+static inline Sint16 read_s16(const Uint8* encoded) {
+    return (Sint16)((encoded[1] << 8) | encoded[0]);
+}
+
 
 #pragma mark -
 #pragma mark MS ADPCM Decoder
@@ -149,10 +195,10 @@ bool ADPCMDecoder::init(WaveFMT * format) {
  * This data is stored as a struct to simplify stereo decoding.
  */
 typedef struct MS_state {
-    Uint8 hPredictor;
-    Uint16 iDelta;
-    Sint16 iSamp1;
-    Sint16 iSamp2;
+    Sint32 iDelta;
+    Sint32 iSamp1;
+    Sint32 iSamp2;
+    const Sint16* coeff;
 } MS_state;
 
 /**
@@ -167,8 +213,6 @@ protected:
     Uint16   _numCoef;
     /** The decoding coefficients */
     Sint16   _coeff[7][2];
-    /** The decoding state (for mono or stereo decoding) */
-    MS_state _state[2];
     
 public:
     /**
@@ -214,24 +258,21 @@ public:
      *
      * @param state     The decoder state
      * @param nybble    The byte to convert
-     * @param coeff     The decoder coefficients
      *
      * @return a single sample extracted from the encoded data
      */
-    Sint32 nibble(MS_state* state, Uint8 nybble, Sint16 * coeff);
+    static Sint32 nibble(MS_state* state, Uint8 nybble);
     
     /**
-     * Reads a single page from the given file.
-     *
-     * The buffer should be able to store block size * channels * 2 bytes of
-     * data (the latter 2 representing sizeof(Sint16) ).
+     * Decodes a single encoded block into the given buffer.
      *
-     * @param source    The source file
-     * @param buffer    The buffer to store the decoded data
+     * The block must have block align many bytes, and the buffer must be
+     * able to store block size * channels many samples.
      *
-     * @return the number of bytes read
+     * @param block     The encoded block
+     * @param output    The buffer to store the decoded samples
      */
-    Sint32 read(SDL_RWops* _source, Uint8* buffer) final;
+    void decode(const Uint8* block, Sint16* output) const override;
 };
 
 
@@ -276,149 +317,164 @@ bool MSDecoder::init(WaveFMT * format) {
  *
  * @param state     The decoder state
  * @param nybble    The byte to convert
- * @param coeff     The decoder coefficients
  *
  * @return a single sample extracted from the encoded data
  */
-Sint32 MSDecoder::nibble(MS_state *state, Uint8 nybble, Sint16 * coeff) {
+Sint32 MSDecoder::nibble(MS_state *state, Uint8 nybble) {
     const Sint32 max_audioval = ((1 << (16 - 1)) - 1);
     const Sint32 min_audioval = -(1 << (16 - 1));
-    const Sint32 adaptive[] = {
+    static const Sint32 adaptive[] = {
         230, 230, 230, 230, 307, 409, 512, 614,
         768, 614, 512, 409, 307, 230, 230, 230
     };
-    Sint32 new_sample, delta;
+    static const Sint32 signs[] = {
+         0,  1,  2,  3,  4,  5,  6,  7,
+        -8, -7, -6, -5, -4, -3, -2, -1
+    };
     
-    new_sample = ((state->iSamp1 * coeff[0]) +
-                  (state->iSamp2 * coeff[1])) / 256;
-    if (nybble & 0x08) {
-        new_sample += state->iDelta * (nybble - 0x10);
-    } else {
-        new_sample += state->iDelta * nybble;
-    }
-    if (new_sample < min_audioval) {
-        new_sample = min_audioval;
-    } else if (new_sample > max_audioval) {
-        new_sample = max_audioval;
-    }
-    delta = ((Sint32) state->iDelta * adaptive[nybble]) / 256;
-    if (delta < 16) {
-        delta = 16;
-    }
-    state->iDelta = (Uint16) delta;
+    Sint32 new_sample = ((state->iSamp1 * state->coeff[0]) +
+                         (state->iSamp2 * state->coeff[1])) / 256;
+    new_sample += state->iDelta * signs[nybble];
+    new_sample = std::min(std::max(new_sample,min_audioval),max_audioval);
+    
+    // iDelta is stored in 16 bits in the original format
+    Sint32 delta = ((Sint32)(Uint16)state->iDelta * adaptive[nybble]) / 256;
+    state->iDelta = (Uint16)std::max(delta,16);
     state->iSamp2 = state->iSamp1;
-    state->iSamp1 = (Sint16) new_sample;
-    return (new_sample);
+    state->iSamp1 = new_sample;
+    return new_sample;
 }
 
 /**
- * Reads a single page from the given file.
+ * Decodes a single encoded block into the given buffer.
  *
- * The buffer should be able to store block size * channels * 2 bytes of
- * data (the latter 2 representing sizeof(Sint16) ).  If the read fails,
- * this method returns -1.
- *
- * @param source    The source file
- * @param buffer    The buffer to store the decoded data
+ * The block must have block align many bytes, and the buffer must be
+ * able to store block size * channels many samples.
  *
- * @return the number of bytes read (or -1 on error)
+ * @param block     The encoded block
+ * @param output    The buffer to store the decoded samples
  */
-Sint32 MSDecoder::read(SDL_RWops* _source, Uint8* buffer) {
-    // Read in a single block align
-    if (!SDL_RWread(_source, _blkbuffer, _wavefmt.blockalign, 1)) {
-        return -1;
-    }
-    
-    MS_state *state[2];
-    Uint8 *encoded, *decoded;
-    Sint32 samplesleft;
-    Sint32 output_len;
-    Sint32 new_sample;
-    Sint16 *coeff[2];
-    Sint8 nybble;
-    Uint8 stereo;
-    
-    // Adjustable pointers to input and output
-    output_len = _blocksize * _wavefmt.channels * sizeof(Sint16);
-    encoded = _blkbuffer;
-    decoded = buffer;
-    
+void MSDecoder::decode(const Uint8* block, Sint16* output) const {
     // Handle mono or stereo
-    stereo = (_wavefmt.channels == 2);
-    state[0] = &(_state[0]);
-    state[1] = &(_state[stereo]);
+    MS_state local[2];
+    Uint8 stereo = (_wavefmt.channels == 2);
+    MS_state* state[2];
+    state[0] = &(local[0]);
+    state[1] = &(local[stereo]);
     
     // Grab the initial information for this block
-    state[0]->hPredictor = *encoded++;
-    if (stereo) {
-        state[1]->hPredictor = *encoded++;
-    }
-    state[0]->iDelta = ((encoded[1] << 8) | encoded[0]);
-    encoded += sizeof(Sint16);
-    if (stereo) {
-        state[1]->iDelta = ((encoded[1] << 8) | encoded[0]);
+    const Uint8* encoded = block;
+    Uint8 predictor[2];
+    predictor[0] = *encoded++;
+    predictor[1] = stereo ? *encoded++ : predictor[0];
+    for(int ii = 0; ii <= stereo; ii++) {
+        state[ii]->iDelta = (Uint16)read_s16(encoded);
         encoded += sizeof(Sint16);
     }
-    state[0]->iSamp1 = ((encoded[1] << 8) | encoded[0]);
-    encoded += sizeof(Sint16);
-    if (stereo) {
-        state[1]->iSamp1 = ((encoded[1] << 8) | encoded[0]);
+    for(int ii = 0; ii <= stereo; ii++) {
+        state[ii]->iSamp1 = read_s16(encoded);
         encoded += sizeof(Sint16);
     }
-    state[0]->iSamp2 = ((encoded[1] << 8) | encoded[0]);
-    encoded += sizeof(Sint16);
-    if (stereo) {
-        state[1]->iSamp2 = ((encoded[1] << 8) | encoded[0]);
+    for(int ii = 0; ii <= stereo; ii++) {
+        state[ii]->iSamp2 = read_s16(encoded);
         encoded += sizeof(Sint16);
     }
-    coeff[0] = _coeff[state[0]->hPredictor];
-    coeff[1] = _coeff[state[1]->hPredictor];
-        
+    
+    // The predictor is not validated by the format
+    state[0]->coeff = _coeff[predictor[0] % 7];
+    state[1]->coeff = _coeff[predictor[1] % 7];
+    
     // Store the two initial samples we start with
-    decoded[0] = state[0]->iSamp2 & 0xFF;
-    decoded[1] = state[0]->iSamp2 >> 8;
-    decoded += 2;
+    Sint16* decoded = output;
+    *decoded++ = (Sint16)state[0]->iSamp2;
     if (stereo) {
-        decoded[0] = state[1]->iSamp2 & 0xFF;
-        decoded[1] = state[1]->iSamp2 >> 8;
-        decoded += 2;
+        *decoded++ = (Sint16)state[1]->iSamp2;
     }
-    decoded[0] = state[0]->iSamp1 & 0xFF;
-    decoded[1] = state[0]->iSamp1 >> 8;
-    decoded += 2;
+    *decoded++ = (Sint16)state[0]->iSamp1;
     if (stereo) {
-        decoded[0] = state[1]->iSamp1 & 0xFF;
-        decoded[1] = state[1]->iSamp1 >> 8;
-        decoded += 2;
+        *decoded++ = (Sint16)state[1]->iSamp1;
     }
-        
+    
     // Decode and store the other samples in this block
-    samplesleft = (_blocksize - 2) * _wavefmt.channels;
+    Sint32 samplesleft = (_blocksize - 2) * _wavefmt.channels;
     while (samplesleft > 0) {
-        nybble = (*encoded) >> 4;
-        new_sample = nibble(state[0], nybble, coeff[0]);
-        decoded[0] = new_sample & 0xFF;
-        new_sample >>= 8;
-        decoded[1] = new_sample & 0xFF;
-        decoded += 2;
-            
-        nybble = (*encoded) & 0x0F;
-        new_sample = nibble(state[1], nybble, coeff[1]);
-        decoded[0] = new_sample & 0xFF;
-        new_sample >>= 8;
-        decoded[1] = new_sample & 0xFF;
-        decoded += 2;
-            
-        ++encoded;
+        Uint8 byte = *encoded++;
+        *decoded++ = (Sint16)nibble(state[0], byte >> 4);
+        *decoded++ = (Sint16)nibble(state[1], byte & 0x0F);
         samplesleft -= 2;
     }
-    
-    return output_len;
 }
 
 
 #pragma mark -
 #pragma mark IMA ADPCM Decoder
+/** The number of entries in the IMA step table */
+#define IMA_STEPS   89
+
+/**
+ * This struct represents the precomputed IMA ADPCM decoding tables
+ *
+ * IMA decoding is a function of the current step index and the nybble. As
+ * there are only 89*16 combinations, we precompute the sample delta and the
+ * next step index for each one. This removes all branches from decoding.
+ */
+typedef struct IMA_tables {
+    /** The sample delta for each step index and nybble */
+    Sint32 delta[IMA_STEPS][16];
+    /** The next (clamped) step index for each step index and nybble */
+    Uint8  index[IMA_STEPS][16];
+} IMA_tables;
+
+/**
+ * Returns the precomputed IMA ADPCM decoding tables
+ *
+ * The tables are built on first use, which is thread safe.
+ *
+ * @return the precomputed IMA ADPCM decoding tables
+ */
+static const IMA_tables& ima_tables() {
+    static const IMA_tables tables = [] {
+        const int index_table[16] = {
+            -1, -1, -1, -1,
+            2, 4, 6, 8,
+            -1, -1, -1, -1,
+            2, 4, 6, 8
+        };
+        const Sint32 step_table[IMA_STEPS] = {
+            7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31,
+            34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130,
+            143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408,
+            449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282,
+            1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+            3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630,
+            9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350,
+            22385, 24623, 27086, 29794, 32767
+        };
+        
+        IMA_tables result;
+        for(int ii = 0; ii < IMA_STEPS; ii++) {
+            Sint32 step = step_table[ii];
+            for(int nybble = 0; nybble < 16; nybble++) {
+                Sint32 delta = step >> 3;
+                if (nybble & 0x04)
+                    delta += step;
+                if (nybble & 0x02)
+                    delta += (step >> 1);
+                if (nybble & 0x01)
+                    delta += (step >> 2);
+                if (nybble & 0x08)
+                    delta = -delta;
+                result.delta[ii][nybble] = delta;
+                
+                int next = ii+index_table[nybble];
+                result.index[ii][nybble] = (Uint8)std::min(std::max(next,0),IMA_STEPS-1);
+            }
+        }
+        return result;
+    }();
+    return tables;
+}
+
 /**
  * This struct represents the decoding state for IMA ADPCM decoding
  *
@@ -427,7 +483,7 @@ Sint32 MSDecoder::read(SDL_RWops* _source, Uint8* buffer) {
 typedef struct IMA_state
 {
     Sint32 sample;
-    Sint8 index;
+    Uint8 index;
 } IMA_state;
 
 /**
@@ -437,10 +493,6 @@ typedef struct IMA_state
  * This class is a object oriented rewrite of the code in SDL_wave.c.
  */
 class IMADecoder : public ADPCMDecoder {
-protected:
-    /** The decoding state (for mono or stereo decoding) */
-    IMA_state _state[2];
-    
 public:
     /**
      * Creates an initialized decoder proxy
@@ -480,16 +532,6 @@ public:
         return nullptr;
     }
 
-    /**
-     * Returns a single sample extracted from the encoded data
-     *
-     * @param state     The decoder state
-     * @param nybble    The byte to convert
-     *
-     * @return a single sample extracted from the encoded data
-     */
-    Sint32 nibble(IMA_state* state, Uint8 nybble);
-    
     /**
      * Fills the array with a single data block for the given channel
      *
@@ -497,25 +539,21 @@ public:
      *
      * @param decoded       The place to store the decoded data
      * @param encoded       The encoded data to read
-     * @param channel       The channel to decode
      * @param numchannels   The total number of channels
      * @param state         The decoder state
      */
-    void fill(Uint8 * decoded, Uint8 * encoded, int channel, int numchannels, IMA_state *state);
+    static void fill(Sint16* decoded, const Uint8* encoded, int numchannels, IMA_state *state);
 
     /**
-     * Reads a single page from the given file.
-     *
-     * The buffer should be able to store block size * channels * 2 bytes of
-     * data (the latter 2 representing sizeof(Sint16) ). If the read fails,
-     * this method returns -1.
+     * Decodes a single encoded block into the given buffer.
      *
-     * @param source    The source file
-     * @param buffer    The buffer to store the decoded data
+     * The block must have block align many bytes, and the buffer must be
+     * able to store block size * channels many samples.
      *
-     * @return the number of bytes read (or -1 on error)
+     * @param block     The encoded block
+     * @param output    The buffer to store the decoded samples
      */
-    Sint32 read(SDL_RWops* _source, Uint8* buffer) final;
+    void decode(const Uint8* block, Sint16* output) const override;
 };
 
 
@@ -531,6 +569,12 @@ public:
  * @return true if the decoder proxy was initialized successfully
  */
 bool IMADecoder::init(WaveFMT * format) {
+    // Check to make sure we have enough variables in the state array
+    if (SDL_SwapLE16(format->channels) > 2) {
+        SDL_SetError("IMA ADPCM decoder can only handle %u channels", 2);
+        return false;
+    }
+    
     Uint8 *rogue_feel = (Uint8 *) format + sizeof(*format);
     if (sizeof(*format) == 16) {
         rogue_feel += sizeof(Uint16);
@@ -539,67 +583,6 @@ bool IMADecoder::init(WaveFMT * format) {
     return ADPCMDecoder::init(format);
 }
 
-/**
- * Returns a single sample extracted from the encoded data
- *
- * @param state     The decoder state
- * @param nybble    The byte to convert
- *
- * @return a single sample extracted from the encoded data
- */
-Sint32 IMADecoder::nibble(IMA_state* state, Uint8 nybble) {
-    const Sint32 max_audioval = ((1 << (16 - 1)) - 1);
-    const Sint32 min_audioval = -(1 << (16 - 1));
-    const int index_table[16] = {
-        -1, -1, -1, -1,
-        2, 4, 6, 8,
-        -1, -1, -1, -1,
-        2, 4, 6, 8
-    };
-    const Sint32 step_table[89] = {
-        7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31,
-        34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130,
-        143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408,
-        449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282,
-        1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
-        3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630,
-        9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350,
-        22385, 24623, 27086, 29794, 32767
-    };
-    Sint32 delta, step;
-    
-    // Compute difference and new sample value
-    if (state->index > 88) {
-        state->index = 88;
-    } else if (state->index < 0) {
-        state->index = 0;
-    }
-    
-    // Explicit cast to avoid gcc warning about using 'char' as array index
-    step = step_table[(int)state->index];
-    delta = step >> 3;
-    if (nybble & 0x04)
-        delta += step;
-    if (nybble & 0x02)
-        delta += (step >> 1);
-    if (nybble & 0x01)
-        delta += (step >> 2);
-    if (nybble & 0x08)
-        delta = -delta;
-    state->sample += delta;
-    
-    // Update index value
-    state->index += index_table[nybble];
-    
-    // Clamp output sample
-    if (state->sample > max_audioval) {
-        state->sample = max_audioval;
-    } else if (state->sample < min_audioval) {
-        state->sample = min_audioval;
-    }
-    return (state->sample);
-}
-
 /**
  * Fills the array with a single data block for the given channel
  *
@@ -607,79 +590,54 @@ Sint32 IMADecoder::nibble(IMA_state* state, Uint8 nybble) {
  *
  * @param decoded       The place to store the decoded data
  * @param encoded       The encoded data to read
- * @param channel       The channel to decode
  * @param numchannels   The total number of channels
  * @param state         The decoder state
  */
-void IMADecoder::fill(Uint8 * decoded, Uint8 * encoded, int channel,
+void IMADecoder::fill(Sint16* decoded, const Uint8* encoded,
                       int numchannels, IMA_state *state) {
-    Sint8 nybble;
-    Sint32 new_sample;
+    const Sint32 max_audioval = ((1 << (16 - 1)) - 1);
+    const Sint32 min_audioval = -(1 << (16 - 1));
+    const IMA_tables& tables = ima_tables();
     
-    decoded += (channel * 2);
-    for (int i = 0; i < 4; ++i) {
-        nybble = (*encoded) & 0x0F;
-        new_sample = nibble(state, nybble);
-        decoded[0] = new_sample & 0xFF;
-        new_sample >>= 8;
-        decoded[1] = new_sample & 0xFF;
-        decoded += 2 * numchannels;
-        
-        nybble = (*encoded) >> 4;
-        new_sample = nibble(state, nybble);
-        decoded[0] = new_sample & 0xFF;
-        new_sample >>= 8;
-        decoded[1] = new_sample & 0xFF;
-        decoded += 2 * numchannels;
-        
-        ++encoded;
+    Sint32 sample = state->sample;
+    Uint8  index  = state->index;
+    for (int ii = 0; ii < 8; ++ii) {
+        // Low nybble first
+        Uint8 nybble = (encoded[ii >> 1] >> ((ii & 1) << 2)) & 0x0F;
+        sample += tables.delta[index][nybble];
+        sample = std::min(std::max(sample,min_audioval),max_audioval);
+        index  = tables.index[index][nybble];
+        *decoded = (Sint16)sample;
+        decoded += numchannels;
     }
+    state->sample = sample;
+    state->index  = index;
 }
 
 /**
- * Reads a single page from the given file.
- *
- * The buffer should be able to store block size * channels * 2 bytes of
- * data (the latter 2 representing sizeof(Sint16) ). If the read fails,
- * this method returns -1.
+ * Decodes a single encoded block into the given buffer.
  *
- * @param source    The source file
- * @param buffer    The buffer to store the decoded data
+ * The block must have block align many bytes, and the buffer must be
+ * able to store block size * channels many samples.
  *
- * @return the number of bytes read (or -1 on error)
+ * @param block     The encoded block
+ * @param output    The buffer to store the decoded samples
  */
-Sint32 IMADecoder::read(SDL_RWops* _source, Uint8* buffer) {
-    IMA_state *state;
-    Uint8 *encoded, *decoded;
-    Sint32 output_len, samplesleft;
-    
-    // Check to make sure we have enough variables in the state array
-    if (_wavefmt.channels > SDL_arraysize(_state)) {
-        SDL_SetError("IMA ADPCM decoder can only handle %u channels",
-                     (unsigned int)SDL_arraysize(_state));
-        return false;
-    }
-    state = _state;
-    
-    // Read in a single block align
-    if (!SDL_RWread(_source, _blkbuffer, _wavefmt.blockalign, 1)) {
-        return -1;
-    }
-    
-    // Allocate the proper sized output buffer
-    output_len = _blocksize * _wavefmt.channels * sizeof(Sint16);
-    encoded = _blkbuffer;
-    decoded = buffer;
+void IMADecoder::decode(const Uint8* block, Sint16* output) const {
+    IMA_state state[2];
+    const Uint8* encoded = block;
+    Sint16* decoded = output;
     
     // Grab the initial information for this block
     for (Uint32 c = 0; c < _wavefmt.channels; ++c) {
         // Fill the state information for this block
-        state[c].sample = ((encoded[1] << 8) | encoded[0]);
+        state[c].sample = read_s16(encoded);
         encoded += 2;
-        if (state[c].sample & 0x8000) {
-            state[c].sample -= 0x10000;
-        }
-        state[c].index = *encoded++;
+        
+        // The index is clamped (as a signed byte) before first use
+        Sint8 index = (Sint8)*encoded++;
+        state[c].index = (Uint8)std::min(std::max((int)index,0),IMA_STEPS-1);
+        
         // Reserved byte in buffer header, should be 0
         if (*encoded++ != 0) {
             // Uh oh, corrupt data?  Buggy code?
@@ -687,23 +645,129 @@ Sint32 IMADecoder::read(SDL_RWops* _source, Uint8* buffer) {
         }
             
         // Store the initial sample we start with
-        decoded[0] = (Uint8) (state[c].sample & 0xFF);
-        decoded[1] = (Uint8) (state[c].sample >> 8);
-        decoded += 2;
+        *decoded++ = (Sint16)state[c].sample;
     }
         
     // Decode and store the other samples in this block
-    samplesleft = (_blocksize - 1) * _wavefmt.channels;
+    Sint32 samplesleft = (_blocksize - 1) * _wavefmt.channels;
     while (samplesleft > 0) {
         for (Uint32 c = 0; c < _wavefmt.channels; ++c) {
-            fill(decoded, encoded, c, _wavefmt.channels, &state[c]);
+            fill(decoded+c, encoded, _wavefmt.channels, &state[c]);
             encoded += 4;
             samplesleft -= 8;
         }
-        decoded += (_wavefmt.channels * 8 * 2);
+        decoded += (_wavefmt.channels * 8);
     }
+}
 
-    return output_len;
+
+#pragma mark -
+#pragma mark ADPCM Workers
+/**
+ * This struct represents a range of ADPCM blocks to decode
+ *
+ * Blocks are independent of one another, so each range may be decoded on
+ * its own thread.
+ */
+typedef struct ADPCM_task {
+    /** The proxy decoder */
+    const ADPCMDecoder* decoder;
+    /** The first encoded block in this range */
+    const Uint8* input;
+    /** The output buffer for the first block in this range */
+    float* output;
+    /** The number of blocks in this range */
+    Uint64 blocks;
+    /** The number of channels */
+    Uint32 channels;
+} ADPCM_task;
+
+/**
+ * This struct represents a complete ADPCM decode split into ranges
+ *
+ * Ranges are claimed in order by the calling thread and the shared helper
+ * pool. The calling thread keeps claiming ranges until none are left, so a
+ * busy pool only reduces the parallelism of a decode and never stalls it.
+ * The job is shared with the helper tasks, as a task may not start until
+ * long after the decode that queued it has finished.
+ */
+typedef struct ADPCM_job {
+    /** The ranges to decode */
+    ADPCM_task tasks[ADPCM_MAX_THREADS];
+    /** The number of ranges in this job */
+    Uint32 ranges;
+    /** The next range to claim */
+    std::atomic<Uint32> next;
+    /** The number of ranges decoded so far */
+    Uint32 finished;
+    /** The least status of the decoded ranges */
+    int status;
+    /** The mutex guarding the finished ranges */
+    std::mutex mutex;
+    /** The condition signalled when every range is decoded */
+    std::condition_variable done;
+} ADPCM_job;
+
+/**
+ * Decodes the range of ADPCM blocks in the given task
+ *
+ * @param task  The ADPCM_task to process
+ *
+ * @return 0 on success and -1 on failure
+ */
+static int adpcm_worker(const ADPCM_task* task) {
+    Uint32 blocksize = task->decoder->getBlockSize();
+    Uint32 blockalign = task->decoder->getBlockAlign();
+    Uint32 samples = blocksize*task->channels;
+    
+    Sint16* scratch = (Sint16*)SDL_malloc(samples*sizeof(Sint16));
+    if (scratch == nullptr) {
+        return -1;
+    }
+    
+    const Uint8* input = task->input;
+    float* output = task->output;
+    for(Uint64 ii = 0; ii < task->blocks; ii++) {
+        task->decoder->decode(input, scratch);
+        cugl::dsp::DSPMath::s16_to_float(scratch, output, samples, 1.0f/(1 << 16));
+        input  += blockalign;
+        output += samples;
+    }
+    SDL_free(scratch);
+    return 0;
+}
+
+/**
+ * Decodes unclaimed ranges of the given job until there are none left
+ *
+ * @param job   The ADPCM_job to process
+ */
+static void adpcm_claim(ADPCM_job* job) {
+    Uint32 index = job->next++;
+    while (index < job->ranges) {
+        int result = adpcm_worker(&job->tasks[index]);
+        std::unique_lock<std::mutex> lk(job->mutex);
+        job->status = std::min(job->status,result);
+        if (++job->finished == job->ranges) {
+            job->done.notify_all();
+        }
+        lk.unlock();
+        index = job->next++;
+    }
+}
+
+/**
+ * Returns the helper pool shared by all ADPCM decoders
+ *
+ * Sounds are often preloaded several at a time. A single pool bounds the
+ * number of decoding threads no matter how many decoders are active.
+ *
+ * @return the helper pool shared by all ADPCM decoders
+ */
+static cugl::ThreadPool* adpcm_pool() {
+    static std::shared_ptr<cugl::ThreadPool> pool = cugl::ThreadPool::alloc(
+        std::max(std::min(ADPCM_POOL_THREADS,SDL_GetCPUCount()-1),1));
+    return pool.get();
 }
 
 
@@ -822,7 +886,7 @@ Sint32 WAVDecoder::pagein(float* buffer) {
     if (avail == 0) {
         return 0;
     } else if (isADPCM()) {
-        if (!_adpcm->read(_source, _chunker)) {
+        if (_adpcm->read(_source, _chunker) <= 0) {
             return 0;
         }
     } else {
@@ -831,54 +895,29 @@ Sint32 WAVDecoder::pagein(float* buffer) {
         }
     }
     
-    // Now convert
+    // Now convert (WAV data is always little endian, but ADPCM is native)
     Uint32 temp = avail/_sampsize;
-    float* output = buffer;
+    bool swap = !isADPCM() && (SDL_BYTEORDER == SDL_BIG_ENDIAN);
     switch (_sampbits) {
         case AUDIO_S16:
-        {
-            Sint16* input = (Sint16*)_chunker;
-            double factor = 1.0/(1 << 16);
-            while(temp--) {
-                *output = *input*factor;
-                output++;
-                input++;
-            }
-        }
+            dsp::DSPMath::s16_to_float((Sint16*)_chunker, buffer, temp, 1.0f/(1 << 16), swap);
             break;
         case AUDIO_S8:
-        {
-            Sint8* input = (Sint8*)_chunker;
-            double factor = 1.0/(1 << 8);
-            while(temp--) {
-                *output = *input*(factor);
-                output++;
-                input++;
-            }
-        }
+            dsp::DSPMath::s8_to_float((Sint8*)_chunker, buffer, temp, 1.0f/(1 << 8));
+            break;
+        case AUDIO_U8:
+            dsp::DSPMath::u8_to_float((Uint8*)_chunker, buffer, temp, 1.0f/(1 << 8));
             break;
         case AUDIO_S32:
-        {
-            Sint32* input = (Sint32*)_chunker;
-            double factor = 1.0/(((Uint64)1) << 32);
-            while(temp--) {
-                *output = *input*(factor);
-                output++;
-                input++;
-            }
-        }
+            dsp::DSPMath::s32_to_float((Sint32*)_chunker, buffer, temp, 1.0f/(((Uint64)1) << 32), swap);
             break;
         case AUDIO_F32:
-        {
-            float* input = (float*)_chunker;
-            while(temp--) {
-                *output = *input;
-                output++;
-                input++;
+            if (swap) {
+                dsp::DSPMath::swap_float((float*)_chunker, buffer, temp);
+            } else {
+                std::memcpy(buffer, _chunker, temp*sizeof(float));
             }
-        }
             break;
-            
         default:
             break;
     }
@@ -887,6 +926,95 @@ Sint32 WAVDecoder::pagein(float* buffer) {
     return avail/(_channels*_sampsize);
 }
 
+/**
+ * Decodes the entire audio file, storing its value in buffer.
+ *
+ * The buffer should be able to hold channels * frames many elements.
+ * The data is interpretted as floats and channels are all interleaved.
+ * If the method returns -1, then an error occurred during reading.
+ *
+ * ADPCM blocks are independent of one another. Therefore, for ADPCM
+ * data this method reads the encoded data in a single pass and decodes
+ * the blocks in parallel. The helper threads are shared by all decoders,
+ * so preloading many sounds at once does not oversubscribe the CPU.
+ * Other encodings are paged in as normal.
+ *
+ * @param buffer    The buffer to store the audio data
+ *
+ * @return the number of frames actually read (-1 on error).
+ */
+Sint32 WAVDecoder::decode(float* buffer) {
+    if (!isADPCM()) {
+        return AudioDecoder::decode(buffer);
+    }
+    
+    CUAssertLog(getPage() == 0, "Decoding must start at the first page");
+    Uint64 blocks = _lastpage;
+    Uint32 blockalign = _adpcm->getBlockAlign();
+    Uint8* data = nullptr;
+    if (blocks > 0) {
+        data = (Uint8*)SDL_malloc((size_t)(blocks*blockalign));
+        if (data == nullptr || !SDL_RWread(_source, data, (size_t)(blocks*blockalign), 1)) {
+            SDL_free(data);
+            setPage(0);
+            return AudioDecoder::decode(buffer);
+        }
+    }
+    
+    // Partition the complete blocks among the threads
+    Uint64 threads = std::min((Uint64)ADPCM_MAX_THREADS, blocks/ADPCM_MIN_BLOCKS);
+    threads = std::min(threads, (Uint64)SDL_GetCPUCount());
+    threads = std::max(threads, (Uint64)1);
+    
+    std::shared_ptr<ADPCM_job> job = std::make_shared<ADPCM_job>();
+    job->ranges = (Uint32)threads;
+    job->next = 0;
+    job->finished = 0;
+    job->status = 0;
+    
+    Uint64 offset = 0;
+    for(Uint64 ii = 0; ii < threads; ii++) {
+        Uint64 amt = blocks/threads + (ii < blocks % threads ? 1 : 0);
+        job->tasks[ii].decoder  = _adpcm.get();
+        job->tasks[ii].input    = data+offset*blockalign;
+        job->tasks[ii].output   = buffer+offset*_pagesize*_channels;
+        job->tasks[ii].blocks   = amt;
+        job->tasks[ii].channels = _channels;
+        offset += amt;
+    }
+    
+    // The calling thread decodes any range the pool has not claimed
+    if (threads > 1) {
+        cugl::ThreadPool* pool = adpcm_pool();
+        for(Uint64 ii = 1; ii < threads; ii++) {
+            pool->addTask([=] { adpcm_claim(job.get()); });
+        }
+    }
+    adpcm_claim(job.get());
+    
+    int status = 0;
+    {
+        std::unique_lock<std::mutex> lk(job->mutex);
+        job->done.wait(lk, [&] { return job->finished == job->ranges; });
+        status = job->status;
+    }
+    SDL_free(data);
+    
+    if (status < 0) {
+        return -1;
+    }
+    
+    // Any partial page at the end is paged in as normal
+    _currpage = blocks;
+    Sint32 total = (Sint32)(blocks*_pagesize);
+    Sint32 amt = 0;
+    do {
+        amt = pagein(buffer+total*_channels);
+        total += amt;
+    } while (amt > 0);
+    return (amt >= 0 ? total : amt);
+}
+
 /**
  * Sets the current page of this decoder
  *
@@ -1088,7 +1216,7 @@ bool WAVDecoder::bootstrap(const std::string& file) {
     
     if (isADPCM()) {
         _pagesize = _adpcm->getBlockSize();
-        _lastpage = (Uint32)(_frames/_pagesize);
+        _lastpage = (Uint32)(_frames/_adpcm->getBlockAlign());
         _frames  = _adpcm->getFrames(_frames);
     } else {
         // Good default buffer size
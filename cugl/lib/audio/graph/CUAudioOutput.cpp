@@ -48,6 +48,7 @@
 #include <cugl/audio/graph/CUAudioResampler.h>
 #include <cugl/audio/graph/CUAudioRedistributor.h>
 #include <cugl/audio/CUAudioDevices.h>
+#include <cugl/math/dsp/CUDSPMath.h>
 #include <cugl/util/CUDebug.h>
 #include <cugl/util/CUTimestamp.h>
 #include <atomic>
@@ -86,20 +87,8 @@ static void audioCallback(void*  userdata, Uint8* stream, int len) {
  * @param swap      Whether to swap the endianness of the data
  */
 static void float_to_s8(const float *input, Uint8* output, size_t size, bool swap) {
-    const float *src = input;
-    Sint8 *dst = (Sint8 *)output;
-
-    for (size_t ii = 0; ii < size; ++ii, ++src, ++dst) {
-        const float sample = *src;
-        if (sample >= 1.0f) {
-            *dst = 127;
-        } else if (sample <= -1.0f) {
-            *dst = -128;
-        } else {
-            *dst = (Sint8)(sample * 127.0f);
-        }
-        // Swap is ignored
-    }
+    // Swap is ignored
+    cugl::dsp::DSPMath::float_to_s8(input, (Sint8*)output, size);
 }
 
 /**
@@ -117,20 +106,8 @@ static void float_to_s8(const float *input, Uint8* output, size_t size, bool swa
  * @param swap      Whether to swap the endianness of the data
  */
 static void float_to_u8(const float *input, Uint8* output, size_t size, bool swap) {
-    const float *src = input;
-    Uint8 *dst = output;
-
-    for (size_t ii = 0; ii < size; ++ii, ++src, ++dst) {
-        const float sample = *src;
-        if (sample >= 1.0f) {
-            *dst = 255;
-        } else if (sample <= -1.0f) {
-            *dst = 0;
-        } else {
-            *dst = (Uint8)((sample + 1.0f) * 127.0f);
-        }
-        // Swap is ignored
-    }
+    // Swap is ignored
+    cugl::dsp::DSPMath::float_to_u8(input, output, size);
 }
 
 /**
@@ -148,22 +125,7 @@ static void float_to_u8(const float *input, Uint8* output, size_t size, bool swa
  * @param swap      Whether to swap the endianness of the data
  */
 static void float_to_s16(const float *input, Uint8* output, size_t size, bool swap) {
-    const float *src = input;
-    Sint16 *dst = (Sint16 *)output;
-
-    for (size_t ii = 0; ii < size; ++ii, ++src, ++dst) {
-        const float sample = *src;
-        if (sample >= 1.0f) {
-            *dst = 32767;
-        } else if (sample <= -1.0f) {
-            *dst = -32768;
-        } else {
-            *dst = (Sint16)(sample * 32767.0f);
-        }
-        if (swap) {
-            *dst = (Sint16)SDL_Swap16(*dst);
-        }
-    }
+    cugl::dsp::DSPMath::float_to_s16(input, (Sint16*)output, size, swap);
 }
 
 /**
@@ -181,22 +143,7 @@ static void float_to_s16(const float *input, Uint8* output, size_t size, bool sw
  * @param swap      Whether to swap the endianness of the data
  */
 static void float_to_u16(const float *input, Uint8* output, size_t size, bool swap) {
-    const float *src = input;
-    Uint16 *dst = (Uint16 *) output;
-
-    for (size_t ii = 0; ii < size; ++ii, ++src, ++dst) {
-        const float sample = *src;
-        if (sample >= 1.0f) {
-            *dst = 65535;
-        } else if (sample <= -1.0f) {
-            *dst = 0;
-        } else {
-            *dst = (Uint16)((sample + 1.0f) * 32767.0f);
-        }
-        if (swap) {
-            *dst = SDL_Swap16(*dst);
-        }
-    }
+    cugl::dsp::DSPMath::float_to_u16(input, (Uint16*)output, size, swap);
 }
 
 /**
@@ -214,22 +161,7 @@ static void float_to_u16(const float *input, Uint8* output, size_t size, bool sw
  * @param swap      Whether to swap the endianness of the data
  */
 static void float_to_s32(const float *input, Uint8* output, size_t size, bool swap) {
-    const float *src = input;
-    Sint32 *dst = (Sint32 *) output;
-
-    for (size_t ii = 0; ii < size; ++ii, ++src, ++dst) {
-        const float sample = *src;
-        if (sample >= 1.0f) {
-            *dst = 2147483647;
-        } else if (sample <= -1.0f) {
-            *dst = (Sint32) -2147483648LL;
-        } else {
-            *dst = ((Sint32)(sample * 8388607.0f)) << 8;
-        }
-        if (swap) {
-            *dst = (Sint32)SDL_Swap32(*dst);
-        }
-    }
+    cugl::dsp::DSPMath::float_to_s32(input, (Sint32*)output, size, swap);
 }
 
 /**
@@ -247,15 +179,10 @@ static void float_to_s32(const float *input, Uint8* output, size_t size, bool sw
  * @param swap      Whether to swap the endianness of the data
  */
 static void float_to_float(const float *input, Uint8* output, size_t size, bool swap) {
-    const float *src = input;
-    float *dst = (float *) output;
-
     if (swap) {
-        for (size_t ii = 0; ii < size; ++ii, ++src, ++dst) {
-            *dst = SDL_Swap32(*src);
-        }
+        cugl::dsp::DSPMath::swap_float(input, (float*)output, size);
     } else {
-        std::memmove(dst, src, size*sizeof(float));
+        std::memmove(output, input, size*sizeof(float));
     }
 }
 
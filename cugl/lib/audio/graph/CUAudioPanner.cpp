@@ -33,9 +33,15 @@
 //
 #include <cugl/audio/graph/CUAudioPanner.h>
 #include <cugl/audio/CUAudioDevices.h>
+#include <cugl/math/dsp/CUDSPMath.h>
 #include <cugl/util/CUDebug.h>
 #include <cmath>
 
+/** The bits of the mixer state that store the published index */
+#define MIX_INDEX   0x03
+/** The bit of the mixer state indicating an unread update */
+#define MIX_FRESH   0x04
+
 using namespace cugl::audio;
 
 /**
@@ -49,7 +55,11 @@ using namespace cugl::audio;
  */
 AudioPanner::AudioPanner() : AudioNode(),
 _field(0),
-_mapper(nullptr) {
+_capacity(0),
+_mapper(nullptr),
+_mixstate(1),
+_mixfront(0),
+_mixback(2) {
     _input = nullptr;
     _classname = "AudioPanner";
 }
@@ -102,9 +112,8 @@ bool AudioPanner::init(Uint8 channels, Uint32 rate) {
  */
 bool AudioPanner::init(Uint8 channels, Uint8 field, Uint32 rate) {
     if (AudioNode::init(channels,rate)) {
-        setField(field);
         _capacity = AudioDevices::get()->getReadSize();
-        _buffer = (float*)malloc(_capacity*_field*sizeof(float));
+        setField(field);
         return true;
     }
     return false;
@@ -119,9 +128,21 @@ bool AudioPanner::init(Uint8 channels, Uint8 field, Uint32 rate) {
 void AudioPanner::dispose() {
     if (_booted) {
         AudioNode::dispose();
-        delete[] _mapper;
-        free(_buffer);
-        _buffer = nullptr;
+        free(_mapper);
+        _mapper = nullptr;
+        for(int ii = 0; ii < 3; ii++) {
+            Mixer* mixer = &(_mixers[ii]);
+            if (mixer->matrix != nullptr) {
+                free(mixer->matrix);
+            }
+            if (mixer->buffer != nullptr) {
+                free(mixer->buffer);
+            }
+            *mixer = Mixer();
+        }
+        _mixstate.store(1,std::memory_order_relaxed);
+        _mixfront = 0;
+        _mixback  = 2;
         _capacity = 0;
         _input = nullptr;
         _field = 0;
@@ -196,8 +217,12 @@ bool AudioPanner::setField(Uint8 field) {
         return false;
     }
     
+    // The audio thread never sees this matrix, so it is safe to replace
+    if (_mapper == nullptr || _field != field) {
+        free(_mapper);
+        _mapper = (float*)malloc(field*_channels*sizeof(float));
+    }
     _field  = field;
-    _mapper = new std::atomic<float>[field*_channels];
     for(int ii = 0; ii < field; ii++) {
         for(int jj = 0; jj < _channels; jj++) {
             if (ii == jj) {
@@ -207,6 +232,7 @@ bool AudioPanner::setField(Uint8 field) {
             }
         }
     }
+    publish();
     return true;
 }
 
@@ -220,7 +246,7 @@ bool AudioPanner::setField(Uint8 field) {
  * @return the matrix pan value for input field and output channel.
  */
 float AudioPanner::getPan(Uint32 field, Uint32 channel) const {
-    return _mapper[field*_channels+channel].load(std::memory_order_relaxed);
+    return _mapper[field*_channels+channel];
 }
 
 
@@ -238,7 +264,51 @@ float AudioPanner::getPan(Uint32 field, Uint32 channel) const {
 void AudioPanner::setPan(Uint32 field, Uint32 channel, float value) {
     CUAssertLog(field < _field, "Field %d is out of range",field);
     CUAssertLog(channel < _channels, "Channel %d is out of range",channel);
-    _mapper[field*_channels+channel].store(value,std::memory_order_relaxed);
+    _mapper[field*_channels+channel] = value;
+    publish();
+}
+
+/**
+ * Publishes the current field and panning matrix to the audio thread
+ *
+ * This method writes the current field and matrix to the state owned by
+ * the main thread and swaps it with the published state. The audio thread
+ * picks up the change at the start of its next read, and the state that
+ * it releases becomes the new back state. Hence no state is freed or
+ * resized while the audio thread is using it, and neither thread ever
+ * waits on the other.
+ */
+void AudioPanner::publish() {
+    Mixer* mixer = &(_mixers[_mixback]);
+    Uint32 size = _field*_channels;
+    if (mixer->matcap < size) {
+        if (mixer->matrix != nullptr) {
+            free(mixer->matrix);
+        }
+        mixer->matrix = (float*)malloc(size*sizeof(float));
+        mixer->matcap = size;
+    }
+    
+    Uint32 buffsize = _capacity*_field;
+    if (mixer->bufcap < buffsize) {
+        if (mixer->buffer != nullptr) {
+            free(mixer->buffer);
+        }
+        mixer->buffer = (float*)malloc(buffsize*sizeof(float));
+        mixer->bufcap = buffsize;
+    }
+    
+    // Transpose the pan values (negative values are ignored)
+    mixer->field = _field;
+    for(int ii = 0; ii < _field; ii++) {
+        for(int jj = 0; jj < _channels; jj++) {
+            float percent = _mapper[ii*_channels+jj];
+            mixer->matrix[jj*_field+ii] = percent > 0 ? percent : 0;
+        }
+    }
+    
+    Uint8 previous = _mixstate.exchange(_mixback | MIX_FRESH,std::memory_order_acq_rel);
+    _mixback = previous & MIX_INDEX;
 }
 
 
@@ -278,28 +348,24 @@ bool AudioPanner::completed() {
  * @return the actual number of frames read
  */
 Uint32 AudioPanner::read(float* buffer, Uint32 frames) {
+    // Pick up any published change to the field or matrix
+    if (_mixstate.load(std::memory_order_relaxed) & MIX_FRESH) {
+        Uint8 previous = _mixstate.exchange(_mixfront,std::memory_order_acq_rel);
+        _mixfront = previous & MIX_INDEX;
+    }
+    const Mixer* mixer = &(_mixers[_mixfront]);
+    
     std::shared_ptr<AudioNode> input = std::atomic_load_explicit(&_input,std::memory_order_relaxed);
     if (input == nullptr || _paused.load(std::memory_order_relaxed)) {
         std::memset(buffer,0,frames*_channels*sizeof(float));
+    } else if (mixer->field == 0 || mixer->field != input->getChannels()) {
+        // Prevent a subtle race
+        std::memset(buffer,0,frames*_channels*sizeof(float));
     } else {
         frames = std::min(frames,_capacity);
-        std::memset(buffer,0,frames*_channels*sizeof(float));
-        Uint32 amt = input->read(_buffer, frames);
-        for(int ii = 0; ii < _field; ii++) {
-            for(int jj = 0; jj < _channels; jj++) {
-                float percent =  _mapper[ii*_channels+jj].load(std::memory_order_relaxed);
-                if (percent > 0) {
-                    float* output = buffer+jj;
-                    float* input  = _buffer+ii;
-                    Uint32 tmp = amt;
-                    while (tmp--) {
-                        *output += *input*percent;
-                        output += _channels;
-                        input += _field;
-                    }
-                }
-            }
-        }
+        Uint32 amt = input->read(mixer->buffer, frames);
+        dsp::DSPMath::mix_matrix(mixer->buffer, buffer, mixer->matrix, mixer->field, _channels, amt);
+        std::memset(buffer+amt*_channels,0,(frames-amt)*_channels*sizeof(float));
         return amt;
     }
     return frames;
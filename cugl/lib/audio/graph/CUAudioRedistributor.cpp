@@ -38,9 +38,17 @@
 //
 #include <cugl/audio/graph/CUAudioRedistributor.h>
 #include <cugl/audio/CUAudioDevices.h>
+#include <cugl/math/dsp/CUDSPMath.h>
 #include <cugl/util/CUDebug.h>
+#include <algorithm>
+#include <vector>
 #include <cmath>
 
+/** The bits of the mixer state that store the published index */
+#define MIX_INDEX   0x03
+/** The bit of the mixer state indicating an unread update */
+#define MIX_FRESH   0x04
+
 using namespace cugl::audio;
 
 // The following are all safe to do in place
@@ -277,7 +285,7 @@ static void convert_mono_to_stereo(const float* input, float* output, size_t siz
  */
 static void convert_stereo_to_tri(const float* input, float* output, size_t size) {
     const float *src = (input + size*2);
-    float *dst = (output + size*4);
+    float *dst = (output + size*3);
     float lf, rf;
 
     for (size_t ii = 0; ii < size; ii++) {
@@ -662,6 +670,52 @@ static std::function<void(const float*, float*, size_t)> select_algorithm(Uint8
     return nullptr;
 }
 
+/**
+ * Returns true if it could compute the default redistribution matrix
+ *
+ * The default conversion algorithms are all linear, so they can be
+ * represented as an outsize x insize matrix. We compute each column of
+ * this matrix by applying the algorithm to a single input channel. If
+ * there is no default algorithm for these sizes, this function returns
+ * false.
+ *
+ * @param insize    The number of input channels
+ * @param outsize   The number of output channels
+ * @param matrix    The matrix to store the result
+ * @param identity  Set to true if the matrix is the identity
+ *
+ * @return true if it could compute the default redistribution matrix
+ */
+static bool default_matrix(Uint8 insize, Uint8 outsize, float* matrix, bool& identity) {
+    identity = (insize == outsize);
+    if (identity) {
+        for(Uint32 ii = 0; ii < outsize; ii++) {
+            for(Uint32 jj = 0; jj < insize; jj++) {
+                matrix[ii*insize+jj] = (ii == jj ? 1.0f : 0.0f);
+            }
+        }
+        return true;
+    }
+    
+    std::function<void(const float*, float*, size_t)> director = select_algorithm(insize, outsize);
+    if (director == nullptr) {
+        return false;
+    }
+    
+    // The algorithms may need room for intermediate results
+    std::vector<float> input(insize,0.0f);
+    std::vector<float> output(std::max<size_t>({insize,outsize,8}),0.0f);
+    for(Uint32 jj = 0; jj < insize; jj++) {
+        input[jj] = 1.0f;
+        director(input.data(), output.data(), 1);
+        for(Uint32 ii = 0; ii < outsize; ii++) {
+            matrix[ii*insize+jj] = output[ii];
+        }
+        input[jj] = 0.0f;
+    }
+    return true;
+}
+
 #pragma mark -
 #pragma mark Constructors
 /**
@@ -672,14 +726,14 @@ static std::function<void(const float*, float*, size_t)> select_algorithm(Uint8
  */
 AudioRedistributor::AudioRedistributor() :
 _matrix(nullptr),
-_buffer(nullptr),
 _conduits(0),
 _pagesize(0),
-_matsize(0) {
+_matsize(0),
+_mixstate(1),
+_mixfront(0),
+_mixback(2) {
     _input = nullptr;
-    _director = nullptr;
     _classname = "AudioRedistributor";
-
 }
 
 /**
@@ -771,16 +825,26 @@ void AudioRedistributor::dispose() {
     if (_booted) {
         AudioNode::dispose();
         _input = nullptr;
-        _director = nullptr;
         _pagesize = 0;
+        _matsize  = 0;
+        _conduits = 0;
         if (_matrix != nullptr) {
             free(_matrix);
             _matrix = nullptr;
         }
-        if (_buffer != nullptr) {
-            free(_buffer);
-            _buffer = nullptr;
+        for(int ii = 0; ii < 3; ii++) {
+            Mixer* mixer = &(_mixers[ii]);
+            if (mixer->matrix != nullptr) {
+                free(mixer->matrix);
+            }
+            if (mixer->buffer != nullptr) {
+                free(mixer->buffer);
+            }
+            *mixer = Mixer();
         }
+        _mixstate.store(1,std::memory_order_relaxed);
+        _mixfront = 0;
+        _mixback  = 2;
     }
 }
 
@@ -882,24 +946,13 @@ std::shared_ptr<AudioNode> AudioRedistributor::detach() {
 void AudioRedistributor::setConduits(Uint8 number) {
     Uint8 original = _conduits.load(std::memory_order_acquire);
     if (original != number) {
-        std::unique_lock<std::mutex> lk(_buffmtex);
-        _matsize  = 0;
-        _pagesize = 0;
         if (_matrix != nullptr) {
             free(_matrix);
             _matrix = nullptr;
         }
-        if (_buffer != nullptr) {
-            free(_buffer);
-            _buffer = nullptr;
-        }
-        if (number > _channels) {
-            _pagesize = AudioDevices::get()->getReadSize()*number+number;
-            _buffer = (float*)malloc(_pagesize*sizeof(float));
-        }
-        
-        _director = select_algorithm(number, _channels);
-        _conduits = number;
+        _matsize  = 0;
+        _conduits.store(number,std::memory_order_release);
+        publish();
     }
 }
 
@@ -928,40 +981,17 @@ void AudioRedistributor::setConduits(Uint8 number) {
  * @param number    The number of input channels for this redistributor.
  */
 void AudioRedistributor::setConduits(Uint8 number, const float* matrix) {
-    Uint8 original = _conduits.load(std::memory_order_acquire);
-    if (original != number) {
-        std::unique_lock<std::mutex> lk(_buffmtex);
-        _matsize  = 0;
-        _pagesize = 0;
+    Uint32 size = number*_channels;
+    if (_matsize != size) {
         if (_matrix != nullptr) {
             free(_matrix);
-            _matrix = nullptr;
-        }
-        if (_buffer != nullptr) {
-            free(_buffer);
-            _buffer = nullptr;
-        }
-        if (number > _channels) {
-            _pagesize = AudioDevices::get()->getReadSize()*number;
-            _buffer = (float*)malloc(_pagesize*sizeof(float));
         }
-        
-        Uint32 size = (number+1)*_channels;
         _matrix = (float*)malloc(size*sizeof(float));
-        std::memcpy(_matrix,matrix,size*sizeof(float));
-
-        if (number > _channels) {
-            _director = [this](const float* input, float* output, size_t size) {
-                            scaleDown(input,output,size);
-                        };
-        } else {
-            _director = [this](const float* input, float* output, size_t size) {
-                            scaleUp(input,output,size);
-                        };
-        }
         _matsize = size;
-        _conduits = number;
     }
+    std::memcpy(_matrix,matrix,size*sizeof(float));
+    _conduits.store(number,std::memory_order_release);
+    publish();
 }
 
 /**
@@ -975,12 +1005,7 @@ void AudioRedistributor::setConduits(Uint8 number, const float* matrix) {
  * @return the current redistribution matrix for this redistributor.
  */
 const float* const AudioRedistributor::getMatrix() {
-    Uint32 size = _matsize.load(std::memory_order_acquire);
-    if (size > 0) {
-        std::unique_lock<std::mutex> lk(_buffmtex);
-        return _matrix;
-    }
-    return nullptr;
+    return _matrix;
 }
 
 /**
@@ -996,18 +1021,53 @@ const float* const AudioRedistributor::getMatrix() {
  * @param matrix    The redistribution matrix
  */
 void AudioRedistributor::setMatrix(const float* matrix) {
-    std::unique_lock<std::mutex> lk(_buffmtex);
-    Uint32 size = _conduits;
-    size = (size+1)*_channels;
-    _matsize = 0;
+    setConduits(_conduits.load(std::memory_order_acquire),matrix);
+}
+
+/**
+ * Publishes the current redistribution settings to the audio thread
+ *
+ * This method writes the current number of conduits and matrix to the
+ * state owned by the main thread and swaps it with the published state.
+ * The audio thread picks up the change at the start of its next read.
+ * Neither thread ever waits on the other.
+ */
+void AudioRedistributor::publish() {
+    if (_pagesize == 0) {
+        _pagesize = AudioDevices::get()->getReadSize();
+    }
+    
+    Mixer* mixer = &(_mixers[_mixback]);
+    Uint8 conduits = _conduits.load(std::memory_order_relaxed);
+    Uint32 size = conduits*_channels;
+    if (mixer->matcap < size) {
+        if (mixer->matrix != nullptr) {
+            free(mixer->matrix);
+        }
+        mixer->matrix = (float*)malloc(size*sizeof(float));
+        mixer->matcap = size;
+    }
+    
+    Uint32 buffsize = _pagesize*conduits;
+    if (mixer->bufcap < buffsize) {
+        if (mixer->buffer != nullptr) {
+            free(mixer->buffer);
+        }
+        mixer->buffer = (float*)malloc(buffsize*sizeof(float));
+        mixer->bufcap = buffsize;
+    }
+    
+    mixer->conduits = conduits;
     if (_matrix != nullptr) {
-        free(_matrix);
-        _matrix = nullptr;
+        std::memcpy(mixer->matrix,_matrix,size*sizeof(float));
+        mixer->identity = false;
+    } else if (size == 0 || !default_matrix(conduits,_channels,mixer->matrix,mixer->identity)) {
+        // There is no valid redistribution
+        mixer->conduits = 0;
     }
-    _matrix = (float*)malloc(size*sizeof(float));
-    std::memcpy(_matrix,matrix,size*sizeof(float));
-    _director = nullptr;
-    _matsize = size;
+    
+    Uint8 previous = _mixstate.exchange(_mixback | MIX_FRESH,std::memory_order_acq_rel);
+    _mixback = previous & MIX_INDEX;
 }
 
 #pragma mark -
@@ -1031,33 +1091,33 @@ void AudioRedistributor::setMatrix(const float* matrix) {
  * @return the actual number of frames read
  */
 Uint32 AudioRedistributor::read(float* buffer, Uint32 frames) {
+    // Pick up any published change to the matrix
+    if (_mixstate.load(std::memory_order_relaxed) & MIX_FRESH) {
+        Uint8 previous = _mixstate.exchange(_mixfront,std::memory_order_acq_rel);
+        _mixfront = previous & MIX_INDEX;
+    }
+    const Mixer* mixer = &(_mixers[_mixfront]);
+    
     std::shared_ptr<AudioNode> input = std::atomic_load_explicit(&_input,std::memory_order_relaxed);
     Uint32 take = 0;
     if (input == nullptr || _paused.load(std::memory_order_relaxed)) {
         std::memset(buffer,0,frames*_channels*sizeof(float));
         take = frames;
-    } else {
-        std::unique_lock<std::mutex> lk(_buffmtex);
+    } else if (mixer->conduits == 0 || mixer->conduits != input->getChannels()) {
         // Prevent a subtle race
-        if (_conduits != input->getChannels() || _director == nullptr) {
-            std::memset(buffer,0,frames*_channels*sizeof(float));
-            take = frames;
-        } else {
-            bool abort = false;
-            while (take < frames && !abort) {
-                Uint32 amt = frames;
-                if (_buffer != nullptr) {
-                    amt = _pagesize < frames-take ? _pagesize : frames-take;
-                    amt = input->read(_buffer,amt);
-                    _director(_buffer,_buffer,amt);
-                    std::memcpy(buffer+take*_channels, _buffer, amt*_channels*sizeof(float));
-                } else {
-                    amt = input->read(buffer+take*_channels,amt);
-                    _director(buffer+take*_channels,buffer+take*_channels,amt);
-                }
-                take += amt;
-                abort = (amt == 0);
-            }
+        std::memset(buffer,0,frames*_channels*sizeof(float));
+        take = frames;
+    } else if (mixer->identity) {
+        take = input->read(buffer,frames);
+    } else {
+        bool abort = false;
+        while (take < frames && !abort) {
+            Uint32 amt = _pagesize < frames-take ? _pagesize : frames-take;
+            amt = input->read(mixer->buffer,amt);
+            dsp::DSPMath::mix_matrix(mixer->buffer, buffer+take*_channels, mixer->matrix,
+                                     mixer->conduits, _channels, amt);
+            take += amt;
+            abort = (amt == 0);
         }
     }
     return take;
@@ -1277,85 +1337,3 @@ double AudioRedistributor::setRemaining(double time) {
     }
     return -1;
 }
-
-#pragma mark -
-#pragma mark Matrix Redistribution
-
-/**
- * Redistribute from buffer input to buffer output
- *
- * The buffer input should have {@link #getConduits()} channels
- * worth of data, while output should support {@link #getChannels()}
- * channels. However, this method is safe to call in-place,
- * provided that the buffer is large enough to support the
- * new output data.
- *
- * This version of the method assumes that output has more channels
- * than input. This distinction is necessary to support in-place
- * redistribution. The value size is specified in terms of frames,
- * not samples, so that it does not include any channel information.
- *
- * @param input     The input buffer
- * @param output    The output buffer
- * @param size      The number of audio frames to process
- */
-void AudioRedistributor::scaleUp(const float* input, float* output, size_t size) {
-    Uint32 rows = _channels;
-    Uint32 cols = _conduits;
-    Uint32 work = rows*cols;
-    
-    const float* src = input + size*cols;
-    float* dst = output + size*rows;
-    
-    for(size_t ii = 0; ii < size; ii++) {
-        dst -= rows;
-        src -= cols;
-        
-        for(Uint32 ii = 0; ii < rows; ii++) {
-            float total = 0;
-            for (Uint32 jj = 0; jj < cols; jj++) {
-                total += _matrix[ii*cols+jj]*src[jj];
-            }
-            _matrix[work+ii] = total;
-        }
-        std::memcpy(dst, _matrix+work, rows*sizeof(float));
-    }
-}
-
-/**
- * Redistribute from buffer input to buffer output
- *
- * The buffer input should have {@link #getConduits()} channels
- * worth of data, while output should support {@link #getChannels()}
- * channels. However, this method is safe to call in-place,
- * provided that the buffer is large enough to support the
- * new output data.
- *
- * This version of the method assumes that input has more channels
- * than output. This distinction is necessary to support in-place
- * redistribution. The value size is specified in terms of frames,
- * not samples, so that it does not include any channel information.
- *
- * @param input     The input buffer
- * @param output    The output buffer
- * @param size      The number of audio frames to process
- */
-void AudioRedistributor::scaleDown(const float* input, float* output, size_t size) {
-    Uint32 rows = _channels;
-    Uint32 cols = _conduits;
-    Uint32 work = rows*cols;
-    
-    const float* src = input;
-    float* dst = output;
-    
-    for(size_t ii = 0; ii < size; ii++, dst += rows, src += cols) {
-        for(Uint32 ii = 0; ii < rows; ii++) {
-            float total = 0;
-            for (Uint32 jj = 0; jj < cols; jj++) {
-                total += _matrix[ii*cols+jj]*src[jj];
-            }
-            _matrix[work+ii] = total;
-        }
-        std::memcpy(dst, _matrix+work, rows*sizeof(float));
-    }
-}
@@ -33,6 +33,7 @@
 #include <cugl/base/CUApplication.h>
 #include <cugl/base/CUDisplay.h>
 #include <cugl/render/CUTexture.h>
+#include <cugl/render/CUGLState.h>
 #include <cugl/input/CUInput.h>
 #include <cugl/util/CUDebug.h>
 #include <algorithm>
@@ -280,7 +281,7 @@ bool Application::step() {
         update(micros/1000000.0f);
 
         glClearColor(_clearColor.r, _clearColor.g, _clearColor.b, _clearColor.a);
-        glStencilMask(0xffffffff);
+        GLState::stencilMask(0xffffffff);
         glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 
         draw();
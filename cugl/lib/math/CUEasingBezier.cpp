@@ -43,6 +43,15 @@
 #include <cugl/cugl.h>
 #include <cugl/math/CUEasingBezier.h>
 
+/** The number of cells in the lookup table */
+#define TABLE_CELLS     256
+/** The number of Newton iterations to refine a table look-up */
+#define NEWTON_STEPS    2
+/** The number of bisection iterations for a flat cell */
+#define BISECT_STEPS    24
+/** The minimum slope dx/dt for a cell to use Newton's method */
+#define MIN_SLOPE       0.05
+
 using namespace cugl;
 
 #pragma mark Constructors
@@ -52,7 +61,8 @@ using namespace cugl;
  * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an object on
  * the heap, use one of the static constructors instead.
  */
-EasingBezier::EasingBezier() {
+EasingBezier::EasingBezier() :
+_hasflat(false) {
     _c1 = Vec2::ZERO;
     _c2 = Vec2::ZERO;
     _c3 = Vec2::ZERO;
@@ -144,6 +154,7 @@ bool EasingBezier::init(float x1, float y1, float x2, float y2) {
     _c1.set(3*x1,3*y1);
     _c2.set(3*x2-6*x1,3*y2-6*y1);
     _c3.set(1-3*x2+3*x1,1-3*y2+3*y1);
+    buildTable();
     return true;
 }
 
@@ -156,7 +167,9 @@ void EasingBezier::dispose() {
     _c1 = Vec2::ZERO;
     _c2 = Vec2::ZERO;
     _c3 = Vec2::ZERO;
-    _rootset.clear();
+    _table.clear();
+    _flat.clear();
+    _hasflat = false;
 }
 
 #pragma mark -
@@ -165,19 +178,149 @@ void EasingBezier::dispose() {
 /**
  * Returns the value of the easing function at t.
  *
- * The easing function is only well-defined when 0 <= t <= 1.
+ * The easing function is only well-defined when 0 <= t <= 1. Values
+ * outside of this range are clamped.
+ *
+ * This method is constant time. It looks up an initial guess for the
+ * bezier parameter in a precomputed table of 256 cells, and refines it
+ * with two Newton iterations. For any curve whose handles have x-values
+ * strictly inside (0,1) the error is less than 5e-5 (less than 5e-6 for
+ * the standard easing types). If a handle x-value is 0 or 1, the curve
+ * may have a vertical tangent, and the error near that tangent is limited
+ * by float precision (about 1e-2 for {@link EasingFunction::Type::EXPO_IN_OUT}).
+ *
+ * @param t The time value to ease
  *
  * @return the value of the easing function at t.
  */
-float EasingBezier::evaluate(float t) {
-    _rootset.clear();
-    solveCubicEquation(_c3.x, _c2.x, _c1.x, -t);
-    float choice = 0;
-    if (!_rootset.empty()) {
-        choice = _rootset[0];
+float EasingBezier::evaluate(float t) const {
+    CUAssertLog(!_table.empty(), "Easing function is not initialized");
+    float x = std::min(std::max(t,0.0f),1.0f);
+    float pos = x*TABLE_CELLS;
+    size_t cell = std::min((size_t)pos,(size_t)(TABLE_CELLS-1));
+    if (_flat[cell]) {
+        return polyY(bisect(x,cell));
+    }
+
+    float p = _table[cell]+(_table[cell+1]-_table[cell])*(pos-cell);
+    for(int ii = 0; ii < NEWTON_STEPS; ii++) {
+        float err = ((_c3.x*p+_c2.x)*p+_c1.x)*p-x;
+        float slope = (3*_c3.x*p+2*_c2.x)*p+_c1.x;
+        p -= err/slope;
+    }
+    return polyY(p);
+}
+
+/**
+ * Evaluates the easing function for an array of time values.
+ *
+ * This method is equivalent to calling {@link #evaluate} on each
+ * element of input, storing the result in output. However, it is
+ * vectorized when {@link CU_MATH_VECTOR_SSE} or {@link CU_MATH_VECTOR_NEON64}
+ * is defined, and so it is the preferred way to ease many tweens that
+ * share the same curve. The arrays may be the same.
+ *
+ * @param input     The time values to ease
+ * @param output    The array to store the eased values
+ * @param size      The number of values to ease
+ */
+void EasingBezier::evaluate(const float* input, float* output, size_t size) const {
+    CUAssertLog(!_table.empty(), "Easing function is not initialized");
+    size_t ii = 0;
+#if defined CU_MATH_VECTOR_SSE || defined CU_MATH_VECTOR_NEON64
+    const float* table = _table.data();
+    alignas(16) int   cells[4];
+    alignas(16) float lower[4];
+    alignas(16) float upper[4];
+    alignas(16) float inputs[4];
+#if defined CU_MATH_VECTOR_SSE
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one  = _mm_set1_ps(1.0f);
+    const __m128 size4 = _mm_set1_ps((float)TABLE_CELLS);
+    const __m128i last = _mm_set1_epi32(TABLE_CELLS-1);
+    const __m128 c1x = _mm_set1_ps(_c1.x);
+    const __m128 c2x = _mm_set1_ps(_c2.x);
+    const __m128 c3x = _mm_set1_ps(_c3.x);
+    const __m128 d2x = _mm_set1_ps(2*_c2.x);
+    const __m128 d3x = _mm_set1_ps(3*_c3.x);
+    const __m128 c1y = _mm_set1_ps(_c1.y);
+    const __m128 c2y = _mm_set1_ps(_c2.y);
+    const __m128 c3y = _mm_set1_ps(_c3.y);
+    for(; ii+4 <= size; ii += 4) {
+        __m128 x = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(input+ii),zero),one);
+        __m128 pos = _mm_mul_ps(x,size4);
+        __m128i cell = _mm_min_epi32(_mm_cvttps_epi32(pos),last);
+        _mm_store_si128((__m128i*)cells,cell);
+        _mm_store_ps(inputs,x);
+        for(int jj = 0; jj < 4; jj++) {
+            lower[jj] = table[cells[jj]];
+            upper[jj] = table[cells[jj]+1];
+        }
+        __m128 lo = _mm_load_ps(lower);
+        __m128 frac = _mm_sub_ps(pos,_mm_cvtepi32_ps(cell));
+        __m128 p = _mm_add_ps(lo,_mm_mul_ps(_mm_sub_ps(_mm_load_ps(upper),lo),frac));
+        for(int jj = 0; jj < NEWTON_STEPS; jj++) {
+            __m128 err = _mm_add_ps(_mm_mul_ps(c3x,p),c2x);
+            err = _mm_add_ps(_mm_mul_ps(err,p),c1x);
+            err = _mm_sub_ps(_mm_mul_ps(err,p),x);
+            __m128 slope = _mm_add_ps(_mm_mul_ps(d3x,p),d2x);
+            slope = _mm_add_ps(_mm_mul_ps(slope,p),c1x);
+            p = _mm_sub_ps(p,_mm_div_ps(err,slope));
+        }
+        __m128 y = _mm_add_ps(_mm_mul_ps(c3y,p),c2y);
+        y = _mm_add_ps(_mm_mul_ps(y,p),c1y);
+        _mm_storeu_ps(output+ii,_mm_mul_ps(y,p));
+#elif defined CU_MATH_VECTOR_NEON64
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t one  = vdupq_n_f32(1.0f);
+    const float32x4_t size4 = vdupq_n_f32((float)TABLE_CELLS);
+    const int32x4_t last = vdupq_n_s32(TABLE_CELLS-1);
+    const float32x4_t c1x = vdupq_n_f32(_c1.x);
+    const float32x4_t c2x = vdupq_n_f32(_c2.x);
+    const float32x4_t c3x = vdupq_n_f32(_c3.x);
+    const float32x4_t d2x = vdupq_n_f32(2*_c2.x);
+    const float32x4_t d3x = vdupq_n_f32(3*_c3.x);
+    const float32x4_t c1y = vdupq_n_f32(_c1.y);
+    const float32x4_t c2y = vdupq_n_f32(_c2.y);
+    const float32x4_t c3y = vdupq_n_f32(_c3.y);
+    for(; ii+4 <= size; ii += 4) {
+        float32x4_t x = vminq_f32(vmaxq_f32(vld1q_f32(input+ii),zero),one);
+        float32x4_t pos = vmulq_f32(x,size4);
+        int32x4_t cell = vminq_s32(vcvtq_s32_f32(pos),last);
+        vst1q_s32(cells,cell);
+        vst1q_f32(inputs,x);
+        for(int jj = 0; jj < 4; jj++) {
+            lower[jj] = table[cells[jj]];
+            upper[jj] = table[cells[jj]+1];
+        }
+        float32x4_t lo = vld1q_f32(lower);
+        float32x4_t frac = vsubq_f32(pos,vcvtq_f32_s32(cell));
+        float32x4_t p = vmlaq_f32(lo,vsubq_f32(vld1q_f32(upper),lo),frac);
+        for(int jj = 0; jj < NEWTON_STEPS; jj++) {
+            float32x4_t err = vmlaq_f32(c2x,c3x,p);
+            err = vmlaq_f32(c1x,err,p);
+            err = vsubq_f32(vmulq_f32(err,p),x);
+            float32x4_t slope = vmlaq_f32(d2x,d3x,p);
+            slope = vmlaq_f32(c1x,slope,p);
+            p = vsubq_f32(p,vdivq_f32(err,slope));
+        }
+        float32x4_t y = vmlaq_f32(c2y,c3y,p);
+        y = vmlaq_f32(c1y,y,p);
+        vst1q_f32(output+ii,vmulq_f32(y,p));
+#endif
+        // Flat cells are rare; patch them after the fact
+        if (_hasflat) {
+            for(int jj = 0; jj < 4; jj++) {
+                if (_flat[cells[jj]]) {
+                    output[ii+jj] = polyY(bisect(inputs[jj],cells[jj]));
+                }
+            }
+        }
+    }
+#endif
+    for(; ii < size; ii++) {
+        output[ii] = evaluate(input[ii]);
     }
-    
-    return choice*choice*choice*_c3.y+choice*choice*_c2.y+choice*_c1.y;
 }
 
 /**
@@ -197,69 +340,74 @@ std::function<float(float)> EasingBezier::getEvaluator() {
 #pragma mark -
 #pragma mark Internal Helpers
 /**
- * Stores the roots of a x^2 + b x + c into the rootset.
+ * Builds the lookup table for inverting the x-component.
  *
- * This is a helper function for computing the root set from the
- * bezier polynomial.
- *
- * @param a The 2nd degree coefficient
- * @param b The linear coefficient
- * @param c The constant factor
+ * The table stores the parameter t for evenly spaced values of x,
+ * computed to double precision. It also marks the cells where the
+ * x-component is too flat for Newton's method to converge quickly.
+ * This only happens when a handle lies on the boundary of the unit
+ * square (e.g. {@link EasingFunction::Type::EXPO_IN_OUT}).
  */
-void EasingBezier::solveQuadraticEquation(float a, float b, float c) {
-    float  discriminant = b * b - 4 * a * c;
-    if (discriminant >= 0) {
-        _rootset.push_back((-b + sqrtf(discriminant)) / (2.0f * a));
-        _rootset.push_back((-b - sqrtf(discriminant)) / (2.0f * a));
+void EasingBezier::buildTable() {
+    double c1 = _c1.x;
+    double c2 = _c2.x;
+    double c3 = _c3.x;
+
+    _table.resize(TABLE_CELLS+1);
+    _table[0] = 0;
+    _table[TABLE_CELLS] = 1;
+    for(int ii = 1; ii < TABLE_CELLS; ii++) {
+        double x = (double)ii/TABLE_CELLS;
+        double lo = 0;
+        double hi = 1;
+        while (hi-lo > 1e-12) {
+            double mid = (lo+hi)/2;
+            if (((c3*mid+c2)*mid+c1)*mid < x) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+        _table[ii] = (float)((lo+hi)/2);
     }
 
+    // The slope dx/dt is a parabola; its minimum is at an end or the vertex
+    double vertex = (c3 != 0 ? -c2/(3*c3) : -1);
+    _flat.resize(TABLE_CELLS);
+    _hasflat = false;
+    for(int ii = 0; ii < TABLE_CELLS; ii++) {
+        double a = _table[ii];
+        double b = _table[ii+1];
+        double slope = std::min((3*c3*a+2*c2)*a+c1,(3*c3*b+2*c2)*b+c1);
+        if (c3 > 0 && a < vertex && vertex < b) {
+            slope = std::min(slope,(3*c3*vertex+2*c2)*vertex+c1);
+        }
+        _flat[ii] = (slope < MIN_SLOPE ? 1 : 0);
+        _hasflat = _hasflat || _flat[ii];
+    }
 }
 
 /**
- * Stores the roots of a x^3 + b x^2 + c x + d into the rootset.
+ * Returns the parameter t for x in the given cell, using bisection.
+ *
+ * This is the slow path for cells marked as flat. It is still
+ * constant time, as the number of iterations is fixed.
  *
- * This is a helper function for computing the root set from the
- * bezier polynomial.
+ * @param x     The x value to invert
+ * @param cell  The table cell containing x
  *
- * @param a The 3rd degree coefficient
- * @param b The 2nd degree coefficient
- * @param c The linear coefficient
- * @param d The constant factor
+ * @return the parameter t for x in the given cell, using bisection.
  */
-void EasingBezier::solveCubicEquation(float a, float b, float c, float d) {
-    if (a == 0) {
-        solveQuadraticEquation(b, c, d);
-        return;
-    }
-    
-    b /= a;
-    c /= a;
-    d /= a;
-    
-    float p = (3 * c - b * b)/3.0f;
-    float q = (2 * b * b * b - 9 * b * c + 27 * d)/27.0f;
-    
-    if (p == 0) {
-        _rootset.push_back(powf(-q, 1.0f/3.0f));
-    } else if (q == 0) {
-        _rootset.push_back(sqrtf(-p));
-        _rootset.push_back(-sqrtf(-p));
-    } else {
-        float discriminant = q*q/4.0f + p*p*p/27.0f;
-        if (discriminant == 0) {
-            _rootset.push_back(powf(q/2.0f, 1.0f/3.0f) - b/3.0f);
-        } else if (discriminant > 0) {
-            _rootset.push_back(powf(-(q/2.0f) + sqrtf(discriminant), 1.0f/3.0f) -
-                               powf((q/2.0f)  + sqrtf(discriminant), 1.0f/3.0f) - b/3.0f);
+float EasingBezier::bisect(float x, size_t cell) const {
+    float lo = _table[cell];
+    float hi = _table[cell+1];
+    for(int ii = 0; ii < BISECT_STEPS; ii++) {
+        float mid = (lo+hi)/2;
+        if (((_c3.x*mid+_c2.x)*mid+_c1.x)*mid < x) {
+            lo = mid;
         } else {
-            float r = sqrtf( powf(-(p/3.0f), 3.0f) );
-            float phi = acosf(-(q / (2 * sqrtf(-p*p*p/27.0f))));
-            float s = 2 * powf(r, 1.0f/3.0f);
-            _rootset.push_back(s * cosf(phi / 3.0f) - b / 3.0f);
-            _rootset.push_back(s * cosf((phi + 2 * (float)M_PI) / 3.0f) - b / 3.0f);
-            _rootset.push_back(s * cosf((phi + 4 * (float)M_PI) / 3.0f) - b / 3.0f);
+            hi = mid;
         }
     }
+    return (lo+hi)/2;
 }
-
-
@@ -33,6 +33,7 @@
 //
 #include <cugl/math/dsp/CUDSPMath.h>
 #include <cugl/util/CUDebug.h>
+#include <cstring>
 #include "cuDSP128.inl"
 
 using namespace cugl;
@@ -572,3 +573,1114 @@ size_t DSPMath::ease(float* data, float bound, float knee, size_t size) {
     }
     return size;
 }
+
+#pragma mark -
+#pragma mark Conversion Methods
+/**
+ * Returns the sample converted to an integer in the range [lower,upper]
+ *
+ * This is the scalar version of the vectorized conversions. The sample is
+ * assumed to be in the range [-1,1], with -1 converting to lower and 1
+ * converting to upper. All other values are the truncation of the value
+ * (sample+offset)*gain.
+ *
+ * @param sample    The float sample
+ * @param offset    The offset to add before scaling
+ * @param gain      The scalar to multiply by
+ * @param lower     The result for samples at or below -1
+ * @param upper     The result for samples at or above 1
+ *
+ * @return the sample converted to an integer in the range [lower,upper]
+ */
+static inline Sint32 float_to_sample(float sample, float offset, float gain, Sint32 lower, Sint32 upper) {
+    if (sample >= 1.0f) {
+        return upper;
+    } else if (sample <= -1.0f) {
+        return lower;
+    }
+    return (Sint32)((sample + offset) * gain);
+}
+
+/**
+ * Converts a buffer of signed bytes into a buffer of floats
+ *
+ * Each value is multiplied by scale after conversion. So a scale of
+ * 1/128 will map the bytes onto the range [-1,1).
+ *
+ * @param input     The input buffer
+ * @param output    The output buffer
+ * @param size      The number of elements to convert
+ * @param scale     The scalar to multiply by
+ *
+ * @return the number of elements successfully converted
+ */
+size_t DSPMath::s8_to_float(const Sint8* input, float* output, size_t size, float scale) {
+    size_t ii = 0;
+#if defined (CU_MATH_VECTOR_SSE)
+    if (VECTORIZE) {
+        const __m128 gain = _mm_set1_ps(scale);
+        for(; ii+16 <= size; ii += 16) {
+            __m128i value = _mm_loadu_si128((const __m128i*)(input+ii));
+            for(int jj = 0; jj < 4; jj++) {
+                __m128i part = _mm_cvtepi8_epi32(value);
+                _mm_storeu_ps(output+ii+4*jj, _mm_mul_ps(_mm_cvtepi32_ps(part),gain));
+                value = _mm_srli_si128(value,4);
+            }
+        }
+    }
+#elif defined (CU_MATH_VECTOR_NEON64)
+#if defined (__ANDROID__)
+    if (VECTORIZE && android_getCpuFamily() == ANDROID_CPU_FAMILY_ARM &&
+        (android_getCpuFeatures() & ANDROID_CPU_ARM_FEATURE_NEON) != 0) {
+#else
+    if (VECTORIZE) {
+#endif
+        for(; ii+8 <= size; ii += 8) {
+            int16x8_t value = vmovl_s8(vld1_s8(input+ii));
+            int32x4_t lo = vmovl_s16(vget_low_s16(value));
+            int32x4_t hi = vmovl_s16(vget_high_s16(value));
+            vst1q_f32(output+ii,  vmulq_n_f32(vcvtq_f32_s32(lo),scale));
+            vst1q_f32(output+ii+4,vmulq_n_f32(vcvtq_f32_s32(hi),scale));
+        }
+    }
+#endif
+    for(; ii < size; ii++) {
+        output[ii] = input[ii]*scale;
+    }
+    return size;
+}
+
+/**
+ * Converts a buffer of unsigned bytes into a buffer of floats
+ *
+ * The bytes are centered on 128 (so 128 converts to 0), and each value
+ * is multiplied by scale after conversion. So a scale of 1/128 will map
+ * the bytes onto the range [-1,1).
+ *
+ * @param input     The input buffer
+ * @param output    The output buffer
+ * @param size      The number of elements to convert
+ * @param scale     The scalar to multiply by
+ *
+ * @return the number of elements successfully converted
+ */
+size_t DSPMath::u8_to_float(const Uint8* input, float* output, size_t size, float scale) {
+    size_t ii = 0;
+#if defined (CU_MATH_VECTOR_SSE)
+    if (VECTORIZE) {
+        const __m128 gain = _mm_set1_ps(scale);
+        const __m128i center = _mm_set1_epi32(128);
+        for(; ii+16 <= size; ii += 16) {
+            __m128i value = _mm_loadu_si128((const __m128i*)(input+ii));
+            for(int jj = 0; jj < 4; jj++) {
+                __m128i part = _mm_sub_epi32(_mm_cvtepu8_epi32(value),center);
+                _mm_storeu_ps(output+ii+4*jj, _mm_mul_ps(_mm_cvtepi32_ps(part),gain));
+                value = _mm_srli_si128(value,4);
+            }
+        }
+    }
+#elif defined (CU_MATH_VECTOR_NEON64)
+#if defined (__ANDROID__)
+    if (VECTORIZE && android_getCpuFamily() == ANDROID_CPU_FAMILY_ARM &&
+        (android_getCpuFeatures() & ANDROID_CPU_ARM_FEATURE_NEON) != 0) {
+#else
+    if (VECTORIZE) {
+#endif
+        const int16x8_t center = vdupq_n_s16(128);
+        for(; ii+8 <= size; ii += 8) {
+            int16x8_t value = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(input+ii))),center);
+            int32x4_t lo = vmovl_s16(vget_low_s16(value));
+            int32x4_t hi = vmovl_s16(vget_high_s16(value));
+            vst1q_f32(output+ii,  vmulq_n_f32(vcvtq_f32_s32(lo),scale));
+            vst1q_f32(output+ii+4,vmulq_n_f32(vcvtq_f32_s32(hi),scale));
+        }
+    }
+#endif
+    for(; ii < size; ii++) {
+        output[ii] = ((Sint32)input[ii]-128)*scale;
+    }
+    return size;
+}
+
+/**
+ * Converts a buffer of signed shorts into a buffer of floats
+ *
+ * Each value is multiplied by scale after conversion. So a scale of
+ * 1/32768 will map the shorts onto the range [-1,1). If swap is true,
+ * the endianness of each short is reversed before it is converted.
+ *
+ * @param input     The input buffer
+ * @param output    The output buffer
+ * @param size      The number of elements to convert
+ * @param scale     The scalar to multiply by
+ * @param swap      Whether to swap the endianness of the input
+ *
+ * @return the number of elements successfully converted
+ */
+size_t DSPMath::s16_to_float(const Sint16* input, float* output, size_t size, float scale, bool swap) {
+    size_t ii = 0;
+#if defined (CU_MATH_VECTOR_SSE)
+    if (VECTORIZE) {
+        const __m128 gain = _mm_set1_ps(scale);
+        for(; ii+8 <= size; ii += 8) {
+            __m128i value = _mm_loadu_si128((const __m128i*)(input+ii));
+            if (swap) {
+                value = _mm_swap_epi16(value);
+            }
+            __m128i lo = _mm_cvtepi16_epi32(value);
+            __m128i hi = _mm_cvtepi16_epi32(_mm_srli_si128(value,8));
+            _mm_storeu_ps(output+ii,  _mm_mul_ps(_mm_cvtepi32_ps(lo),gain));
+            _mm_storeu_ps(output+ii+4,_mm_mul_ps(_mm_cvtepi32_ps(hi),gain));
+        }
+    }
+#elif defined (CU_MATH_VECTOR_NEON64)
+#if defined (__ANDROID__)
+    if (VECTORIZE && android_getCpuFamily() == ANDROID_CPU_FAMILY_ARM &&
+        (android_getCpuFeatures() & ANDROID_CPU_ARM_FEATURE_NEON) != 0) {
+#else
+    if (VECTORIZE) {
+#endif
+        for(; ii+8 <= size; ii += 8) {
+            int16x8_t value = vld1q_s16(input+ii);
+            if (swap) {
+                value = vswapq_s16(value);
+            }
+            int32x4_t lo = vmovl_s16(vget_low_s16(value));
+            int32x4_t hi = vmovl_s16(vget_high_s16(value));
+            vst1q_f32(output+ii,  vmulq_n_f32(vcvtq_f32_s32(lo),scale));
+            vst1q_f32(output+ii+4,vmulq_n_f32(vcvtq_f32_s32(hi),scale));
+        }
+    }
+#endif
+    if (swap) {
+        for(; ii < size; ii++) {
+            output[ii] = ((Sint16)SDL_Swap16(input[ii]))*scale;
+        }
+    } else {
+        for(; ii < size; ii++) {
+            output[ii] = input[ii]*scale;
+        }
+    }
+    return size;
+}
+
+/**
+ * Converts a buffer of signed ints into a buffer of floats
+ *
+ * Each value is multiplied by scale after conversion. So a scale of
+ * 1/2^31 will map the ints onto the range [-1,1). If swap is true,
+ * the endianness of each int is reversed before it is converted.
+ *
+ * @param input     The input buffer
+ * @param output    The output buffer
+ * @param size      The number of elements to convert
+ * @param scale     The scalar to multiply by
+ * @param swap      Whether to swap the endianness of the input
+ *
+ * @return the number of elements successfully converted
+ */
+size_t DSPMath::s32_to_float(const Sint32* input, float* output, size_t size, float scale, bool swap) {
+    size_t ii = 0;
+#if defined (CU_MATH_VECTOR_SSE)
+    if (VECTORIZE) {
+        const __m128 gain = _mm_set1_ps(scale);
+        for(; ii+4 <= size; ii += 4) {
+            __m128i value = _mm_loadu_si128((const __m128i*)(input+ii));
+            if (swap) {
+                value = _mm_swap_epi32(value);
+            }
+            _mm_storeu_ps(output+ii, _mm_mul_ps(_mm_cvtepi32_ps(value),gain));
+        }
+    }
+#elif defined (CU_MATH_VECTOR_NEON64)
+#if defined (__ANDROID__)
+    if (VECTORIZE && android_getCpuFamily() == ANDROID_CPU_FAMILY_ARM &&
+        (android_getCpuFeatures() & ANDROID_CPU_ARM_FEATURE_NEON) != 0) {
+#else
+    if (VECTORIZE) {
+#endif
+        for(; ii+4 <= size; ii += 4) {
+            int32x4_t value = vld1q_s32(input+ii);
+            if (swap) {
+                value = vswapq_s32(value);
+            }
+            vst1q_f32(output+ii, vmulq_n_f32(vcvtq_f32_s32(value),scale));
+        }
+    }
+#endif
+    if (swap) {
+        for(; ii < size; ii++) {
+            output[ii] = ((float)(Sint32)SDL_Swap32(input[ii]))*scale;
+        }
+    } else {
+        for(; ii < size; ii++) {
+            output[ii] = ((float)input[ii])*scale;
+        }
+    }
+    return size;
+}
+
+/**
+ * Converts a buffer of floats into a buffer of signed bytes
+ *
+ * The floats are assumed to be in the range [-1,1]. Values outside of
+ * this range are clamped, with -1 converting to the minimum byte and
+ * 1 converting to the maximum.
+ *
+ * @param input     The input buffer
+ * @param output    The output buffer
+ * @param size      The number of elements to convert
+ *
+ * @return the number of elements successfully converted
+ */
+size_t DSPMath::float_to_s8(const float* input, Sint8* output, size_t size) {
+    size_t ii = 0;
+#if defined (CU_MATH_VECTOR_SSE)
+    if (VECTORIZE) {
+        const __m128  offset = _mm_setzero_ps();
+        const __m128  gain  = _mm_set1_ps(127.0f);
+        const __m128i lower = _mm_set1_epi32(-128);
+        const __m128i upper = _mm_set1_epi32(127);
+        __m128i part[4];
+        for(; ii+16 <= size; ii += 16) {
+            for(int jj = 0; jj < 4; jj++) {
+                part[jj] = _mm_cvtsample_ps(_mm_loadu_ps(input+ii+4*jj),offset,gain,lower,upper);
+            }
+            __m128i lo = _mm_packs_epi32(part[0],part[1]);
+            __m128i hi = _mm_packs_epi32(part[2],part[3]);
+            _mm_storeu_si128((__m128i*)(output+ii),_mm_packs_epi16(lo,hi));
+        }
+    }
+#elif defined (CU_MATH_VECTOR_NEON64)
+#if defined (__ANDROID__)
+    if (VECTORIZE && android_getCpuFamily() == ANDROID_CPU_FAMILY_ARM &&
+        (android_getCpuFeatures() & ANDROID_CPU_ARM_FEATURE_NEON) != 0) {
+#else
+    if (VECTORIZE) {
+#endif
+        const float32x4_t offset = vdupq_n_f32(0.0f);
+        const float32x4_t gain   = vdupq_n_f32(127.0f);
+        const int32x4_t lower = vdupq_n_s32(-128);
+        const int32x4_t upper = vdupq_n_s32(127);
+        for(; ii+8 <= size; ii += 8) {
+            int32x4_t lo = vcvtsampleq_f32(vld1q_f32(input+ii),  offset,gain,lower,upper);
+            int32x4_t hi = vcvtsampleq_f32(vld1q_f32(input+ii+4),offset,gain,lower,upper);
+            vst1_s8(output+ii,vqmovn_s16(vcombine_s16(vqmovn_s32(lo),vqmovn_s32(hi))));
+        }
+    }
+#endif
+    for(; ii < size; ii++) {
+        output[ii] = (Sint8)float_to_sample(input[ii],0.0f,127.0f,-128,127);
+    }
+    return size;
+}
+
+/**
+ * Converts a buffer of floats into a buffer of unsigned bytes
+ *
+ * The floats are assumed to be in the range [-1,1]. Values outside of
+ * this range are clamped, with -1 converting to the minimum byte and
+ * 1 converting to the maximum.
+ *
+ * @param input     The input buffer
+ * @param output    The output buffer
+ * @param size      The number of elements to convert
+ *
+ * @return the number of elements successfully converted
+ */
+size_t DSPMath::float_to_u8(const float* input, Uint8* output, size_t size) {
+    size_t ii = 0;
+#if defined (CU_MATH_VECTOR_SSE)
+    if (VECTORIZE) {
+        const __m128  offset = _mm_set1_ps(1.0f);
+        const __m128  gain  = _mm_set1_ps(127.0f);
+        const __m128i lower = _mm_set1_epi32(0);
+        const __m128i upper = _mm_set1_epi32(255);
+        __m128i part[4];
+        for(; ii+16 <= size; ii += 16) {
+            for(int jj = 0; jj < 4; jj++) {
+                part[jj] = _mm_cvtsample_ps(_mm_loadu_ps(input+ii+4*jj),offset,gain,lower,upper);
+            }
+            __m128i lo = _mm_packs_epi32(part[0],part[1]);
+            __m128i hi = _mm_packs_epi32(part[2],part[3]);
+            _mm_storeu_si128((__m128i*)(output+ii),_mm_packus_epi16(lo,hi));
+        }
+    }
+#elif defined (CU_MATH_VECTOR_NEON64)
+#if defined (__ANDROID__)
+    if (VECTORIZE && android_getCpuFamily() == ANDROID_CPU_FAMILY_ARM &&
+        (android_getCpuFeatures() & ANDROID_CPU_ARM_FEATURE_NEON) != 0) {
+#else
+    if (VECTORIZE) {
+#endif
+        const float32x4_t offset = vdupq_n_f32(1.0f);
+        const float32x4_t gain   = vdupq_n_f32(127.0f);
+        const int32x4_t lower = vdupq_n_s32(0);
+        const int32x4_t upper = vdupq_n_s32(255);
+        for(; ii+8 <= size; ii += 8) {
+            int32x4_t lo = vcvtsampleq_f32(vld1q_f32(input+ii),  offset,gain,lower,upper);
+            int32x4_t hi = vcvtsampleq_f32(vld1q_f32(input+ii+4),offset,gain,lower,upper);
+            vst1_u8(output+ii,vqmovun_s16(vcombine_s16(vqmovn_s32(lo),vqmovn_s32(hi))));
+        }
+    }
+#endif
+    for(; ii < size; ii++) {
+        output[ii] = (Uint8)float_to_sample(input[ii],1.0f,127.0f,0,255);
+    }
+    return size;
+}
+
+/**
+ * Converts a buffer of floats into a buffer of signed shorts
+ *
+ * The floats are assumed to be in the range [-1,1]. Values outside of
+ * this range are clamped, with -1 converting to the minimum short and
+ * 1 converting to the maximum. If swap is true, the endianness of each
+ * short is reversed before it is stored.
+ *
+ * @param input     The input buffer
+ * @param output    The output buffer
+ * @param size      The number of elements to convert
+ * @param swap      Whether to swap the endianness of the output
+ *
+ * @return the number of elements successfully converted
+ */
+size_t DSPMath::float_to_s16(const float* input, Sint16* output, size_t size, bool swap) {
+    size_t ii = 0;
+#if defined (CU_MATH_VECTOR_SSE)
+    if (VECTORIZE) {
+        const __m128  offset = _mm_setzero_ps();
+        const __m128  gain  = _mm_set1_ps(32767.0f);
+        const __m128i lower = _mm_set1_epi32(-32768);
+        const __m128i upper = _mm_set1_epi32(32767);
+        for(; ii+8 <= size; ii += 8) {
+            __m128i lo = _mm_cvtsample_ps(_mm_loadu_ps(input+ii),  offset,gain,lower,upper);
+            __m128i hi = _mm_cvtsample_ps(_mm_loadu_ps(input+ii+4),offset,gain,lower,upper);
+            __m128i value = _mm_packs_epi32(lo,hi);
+            if (swap) {
+                value = _mm_swap_epi16(value);
+            }
+            _mm_storeu_si128((__m128i*)(output+ii),value);
+        }
+    }
+#elif defined (CU_MATH_VECTOR_NEON64)
+#if defined (__ANDROID__)
+    if (VECTORIZE && android_getCpuFamily() == ANDROID_CPU_FAMILY_ARM &&
+        (android_getCpuFeatures() & ANDROID_CPU_ARM_FEATURE_NEON) != 0) {
+#else
+    if (VECTORIZE) {
+#endif
+        const float32x4_t offset = vdupq_n_f32(0.0f);
+        const float32x4_t gain   = vdupq_n_f32(32767.0f);
+        const int32x4_t lower = vdupq_n_s32(-32768);
+        const int32x4_t upper = vdupq_n_s32(32767);
+        for(; ii+8 <= size; ii += 8) {
+            int32x4_t lo = vcvtsampleq_f32(vld1q_f32(input+ii),  offset,gain,lower,upper);
+            int32x4_t hi = vcvtsampleq_f32(vld1q_f32(input+ii+4),offset,gain,lower,upper);
+            int16x8_t value = vcombine_s16(vqmovn_s32(lo),vqmovn_s32(hi));
+            if (swap) {
+                value = vswapq_s16(value);
+            }
+            vst1q_s16(output+ii,value);
+        }
+    }
+#endif
+    for(; ii < size; ii++) {
+        output[ii] = (Sint16)float_to_sample(input[ii],0.0f,32767.0f,-32768,32767);
+        if (swap) {
+            output[ii] = (Sint16)SDL_Swap16(output[ii]);
+        }
+    }
+    return size;
+}
+
+/**
+ * Converts a buffer of floats into a buffer of unsigned shorts
+ *
+ * The floats are assumed to be in the range [-1,1]. Values outside of
+ * this range are clamped, with -1 converting to the minimum short and
+ * 1 converting to the maximum. If swap is true, the endianness of each
+ * short is reversed before it is stored.
+ *
+ * @param input     The input buffer
+ * @param output    The output buffer
+ * @param size      The number of elements to convert
+ * @param swap      Whether to swap the endianness of the output
+ *
+ * @return the number of elements successfully converted
+ */
+size_t DSPMath::float_to_u16(const float* input, Uint16* output, size_t size, bool swap) {
+    size_t ii = 0;
+#if defined (CU_MATH_VECTOR_SSE)
+    if (VECTORIZE) {
+        const __m128  offset = _mm_set1_ps(1.0f);
+        const __m128  gain  = _mm_set1_ps(32767.0f);
+        const __m128i lower = _mm_set1_epi32(0);
+        const __m128i upper = _mm_set1_epi32(65535);
+        for(; ii+8 <= size; ii += 8) {
+            __m128i lo = _mm_cvtsample_ps(_mm_loadu_ps(input+ii),  offset,gain,lower,upper);
+            __m128i hi = _mm_cvtsample_ps(_mm_loadu_ps(input+ii+4),offset,gain,lower,upper);
+            __m128i value = _mm_packus_epi32(lo,hi);
+            if (swap) {
+                value = _mm_swap_epi16(value);
+            }
+            _mm_storeu_si128((__m128i*)(output+ii),value);
+        }
+    }
+#elif defined (CU_MATH_VECTOR_NEON64)
+#if defined (__ANDROID__)
+    if (VECTORIZE && android_getCpuFamily() == ANDROID_CPU_FAMILY_ARM &&
+        (android_getCpuFeatures() & ANDROID_CPU_ARM_FEATURE_NEON) != 0) {
+#else
+    if (VECTORIZE) {
+#endif
+        const float32x4_t offset = vdupq_n_f32(1.0f);
+        const float32x4_t gain   = vdupq_n_f32(32767.0f);
+        const int32x4_t lower = vdupq_n_s32(0);
+        const int32x4_t upper = vdupq_n_s32(65535);
+        for(; ii+8 <= size; ii += 8) {
+            int32x4_t lo = vcvtsampleq_f32(vld1q_f32(input+ii),  offset,gain,lower,upper);
+            int32x4_t hi = vcvtsampleq_f32(vld1q_f32(input+ii+4),offset,gain,lower,upper);
+            uint16x8_t value = vcombine_u16(vqmovun_s32(lo),vqmovun_s32(hi));
+            if (swap) {
+                value = vreinterpretq_u16_u8(vrev16q_u8(vreinterpretq_u8_u16(value)));
+            }
+            vst1q_u16(output+ii,value);
+        }
+    }
+#endif
+    for(; ii < size; ii++) {
+        output[ii] = (Uint16)float_to_sample(input[ii],1.0f,32767.0f,0,65535);
+        if (swap) {
+            output[ii] = SDL_Swap16(output[ii]);
+        }
+    }
+    return size;
+}
+
+/**
+ * Converts a buffer of floats into a buffer of signed ints
+ *
+ * The floats are assumed to be in the range [-1,1]. Values outside of
+ * this range are clamped, with -1 converting to the minimum int and
+ * 1 converting to the maximum. Values inside this range have 24 bits
+ * of precision (the precision of a float). If swap is true, the
+ * endianness of each int is reversed before it is stored.
+ *
+ * @param input     The input buffer
+ * @param output    The output buffer
+ * @param size      The number of elements to convert
+ * @param swap      Whether to swap the endianness of the output
+ *
+ * @return the number of elements successfully converted
+ */
+size_t DSPMath::float_to_s32(const float* input, Sint32* output, size_t size, bool swap) {
+    size_t ii = 0;
+#if defined (CU_MATH_VECTOR_SSE)
+    if (VECTORIZE) {
+        const __m128  vmin = _mm_set1_ps(-1.0f);
+        const __m128  vmax = _mm_set1_ps( 1.0f);
+        const __m128  gain = _mm_set1_ps(8388607.0f);
+        const __m128i lower = _mm_set1_epi32(SDL_MIN_SINT32);
+        const __m128i upper = _mm_set1_epi32(SDL_MAX_SINT32);
+        for(; ii+4 <= size; ii += 4) {
+            __m128 sample = _mm_loadu_ps(input+ii);
+            __m128 clamp  = _mm_min_ps(_mm_max_ps(sample,vmin),vmax);
+            __m128i value = _mm_slli_epi32(_mm_cvttps_epi32(_mm_mul_ps(clamp,gain)),8);
+            value = _mm_blendv_epi8(value,upper,_mm_castps_si128(_mm_cmpge_ps(sample,vmax)));
+            value = _mm_blendv_epi8(value,lower,_mm_castps_si128(_mm_cmple_ps(sample,vmin)));
+            if (swap) {
+                value = _mm_swap_epi32(value);
+            }
+            _mm_storeu_si128((__m128i*)(output+ii),value);
+        }
+    }
+#elif defined (CU_MATH_VECTOR_NEON64)
+#if defined (__ANDROID__)
+    if (VECTORIZE && android_getCpuFamily() == ANDROID_CPU_FAMILY_ARM &&
+        (android_getCpuFeatures() & ANDROID_CPU_ARM_FEATURE_NEON) != 0) {
+#else
+    if (VECTORIZE) {
+#endif
+        const float32x4_t vmin = vdupq_n_f32(-1.0f);
+        const float32x4_t vmax = vdupq_n_f32( 1.0f);
+        const int32x4_t lower = vdupq_n_s32(SDL_MIN_SINT32);
+        const int32x4_t upper = vdupq_n_s32(SDL_MAX_SINT32);
+        for(; ii+4 <= size; ii += 4) {
+            float32x4_t sample = vld1q_f32(input+ii);
+            float32x4_t clamp  = vminq_f32(vmaxq_f32(sample,vmin),vmax);
+            int32x4_t value = vshlq_n_s32(vcvtq_s32_f32(vmulq_n_f32(clamp,8388607.0f)),8);
+            value = vbslq_s32(vcgeq_f32(sample,vmax),upper,value);
+            value = vbslq_s32(vcleq_f32(sample,vmin),lower,value);
+            if (swap) {
+                value = vswapq_s32(value);
+            }
+            vst1q_s32(output+ii,value);
+        }
+    }
+#endif
+    for(; ii < size; ii++) {
+        float sample = input[ii];
+        if (sample >= 1.0f) {
+            output[ii] = SDL_MAX_SINT32;
+        } else if (sample <= -1.0f) {
+            output[ii] = SDL_MIN_SINT32;
+        } else {
+            output[ii] = ((Sint32)(sample * 8388607.0f)) << 8;
+        }
+        if (swap) {
+            output[ii] = (Sint32)SDL_Swap32(output[ii]);
+        }
+    }
+    return size;
+}
+
+/**
+ * Reverses the endianness of a buffer of floats
+ *
+ * It is safe for output to be the same as the input buffer.
+ *
+ * @param input     The input buffer
+ * @param output    The output buffer
+ * @param size      The number of elements to swap
+ *
+ * @return the number of elements successfully swapped
+ */
+size_t DSPMath::swap_float(const float* input, float* output, size_t size) {
+    size_t ii = 0;
+#if defined (CU_MATH_VECTOR_SSE)
+    if (VECTORIZE) {
+        for(; ii+4 <= size; ii += 4) {
+            __m128i value = _mm_loadu_si128((const __m128i*)(input+ii));
+            _mm_storeu_si128((__m128i*)(output+ii),_mm_swap_epi32(value));
+        }
+    }
+#elif defined (CU_MATH_VECTOR_NEON64)
+#if defined (__ANDROID__)
+    if (VECTORIZE && android_getCpuFamily() == ANDROID_CPU_FAMILY_ARM &&
+        (android_getCpuFeatures() & ANDROID_CPU_ARM_FEATURE_NEON) != 0) {
+#else
+    if (VECTORIZE) {
+#endif
+        for(; ii+4 <= size; ii += 4) {
+            uint8x16_t value = vld1q_u8((const Uint8*)(input+ii));
+            vst1q_u8((Uint8*)(output+ii),vrev32q_u8(value));
+        }
+    }
+#endif
+    const Uint32* src = (const Uint32*)input;
+    Uint32* dst = (Uint32*)output;
+    for(; ii < size; ii++) {
+        dst[ii] = SDL_Swap32(src[ii]);
+    }
+    return size;
+}
+
+#pragma mark -
+#pragma mark Interleave Methods
+/**
+ * Interleaves several planar channels into a single buffer
+ *
+ * The array input should have one buffer for each channel, in the order
+ * that they should appear in the output. Each of those buffers must
+ * have (at least) frames many elements. The output buffer must be able
+ * to hold channels * frames many elements.
+ *
+ * @param input     The planar channel buffers
+ * @param output    The interleaved output buffer
+ * @param channels  The number of channels
+ * @param frames    The number of frames to interleave
+ *
+ * @return the number of frames successfully interleaved
+ */
+size_t DSPMath::interleave(const float* const* input, float* output, size_t channels, size_t frames) {
+    if (channels == 1) {
+        std::memmove(output, input[0], frames*sizeof(float));
+        return frames;
+    }
+    
+    size_t ii = 0;
+    if (channels == 2) {
+        const float* left = input[0];
+        const float* rght = input[1];
+#if defined (CU_MATH_VECTOR_SSE)
+        if (VECTORIZE) {
+            for(; ii+4 <= frames; ii += 4) {
+                __m128 lval = _mm_loadu_ps(left+ii);
+                __m128 rval = _mm_loadu_ps(rght+ii);
+                _mm_storeu_ps(output+2*ii,  _mm_unpacklo_ps(lval,rval));
+                _mm_storeu_ps(output+2*ii+4,_mm_unpackhi_ps(lval,rval));
+            }
+        }
+#elif defined (CU_MATH_VECTOR_NEON64)
+#if defined (__ANDROID__)
+        if (VECTORIZE && android_getCpuFamily() == ANDROID_CPU_FAMILY_ARM &&
+            (android_getCpuFeatures() & ANDROID_CPU_ARM_FEATURE_NEON) != 0) {
+#else
+        if (VECTORIZE) {
+#endif
+            for(; ii+4 <= frames; ii += 4) {
+                float32x4x2_t value = { vld1q_f32(left+ii), vld1q_f32(rght+ii) };
+                vst2q_f32(output+2*ii,value);
+            }
+        }
+#endif
+        for(; ii < frames; ii++) {
+            output[2*ii  ] = left[ii];
+            output[2*ii+1] = rght[ii];
+        }
+        return frames;
+    }
+    
+    for(size_t ch = 0; ch < channels; ch++) {
+        const float* src = input[ch];
+        float* dst = output+ch;
+        for(ii = 0; ii < frames; ii++) {
+            *dst = src[ii];
+            dst += channels;
+        }
+    }
+    return frames;
+}
+
+/**
+ * Deinterleaves a single buffer into several planar channels
+ *
+ * The array output should have one buffer for each channel of the input.
+ * Each of those buffers must be able to hold (at least) frames many
+ * elements. The input buffer must have channels * frames many elements.
+ *
+ * @param input     The interleaved input buffer
+ * @param output    The planar channel buffers
+ * @param channels  The number of channels
+ * @param frames    The number of frames to deinterleave
+ *
+ * @return the number of frames successfully deinterleaved
+ */
+size_t DSPMath::deinterleave(const float* input, float* const* output, size_t channels, size_t frames) {
+    if (channels == 1) {
+        std::memmove(output[0], input, frames*sizeof(float));
+        return frames;
+    }
+    
+    size_t ii = 0;
+    if (channels == 2) {
+        float* left = output[0];
+        float* rght = output[1];
+#if defined (CU_MATH_VECTOR_SSE)
+        if (VECTORIZE) {
+            for(; ii+4 <= frames; ii += 4) {
+                __m128 first = _mm_loadu_ps(input+2*ii);
+                __m128 secnd = _mm_loadu_ps(input+2*ii+4);
+                _mm_storeu_ps(left+ii,_mm_shuffle_ps(first,secnd,_MM_SHUFFLE(2,0,2,0)));
+                _mm_storeu_ps(rght+ii,_mm_shuffle_ps(first,secnd,_MM_SHUFFLE(3,1,3,1)));
+            }
+        }
+#elif defined (CU_MATH_VECTOR_NEON64)
+#if defined (__ANDROID__)
+        if (VECTORIZE && android_getCpuFamily() == ANDROID_CPU_FAMILY_ARM &&
+            (android_getCpuFeatures() & ANDROID_CPU_ARM_FEATURE_NEON) != 0) {
+#else
+        if (VECTORIZE) {
+#endif
+            for(; ii+4 <= frames; ii += 4) {
+                float32x4x2_t value = vld2q_f32(input+2*ii);
+                vst1q_f32(left+ii,value.val[0]);
+                vst1q_f32(rght+ii,value.val[1]);
+            }
+        }
+#endif
+        for(; ii < frames; ii++) {
+            left[ii] = input[2*ii  ];
+            rght[ii] = input[2*ii+1];
+        }
+        return frames;
+    }
+    
+    for(size_t ch = 0; ch < channels; ch++) {
+        const float* src = input+ch;
+        float* dst = output[ch];
+        for(ii = 0; ii < frames; ii++) {
+            dst[ii] = *src;
+            src += channels;
+        }
+    }
+    return frames;
+}
+
+#pragma mark -
+#pragma mark Matrix Mixing
+/**
+ * Mixes input into output for fixed channel counts
+ *
+ * The matrix is an OUT x IN matrix in row major order. This kernel starts
+ * at the given frame, so that it can finish what a vector kernel started.
+ * Because the channel counts are known at compile time, the inner loops
+ * are fully unrolled.
+ *
+ * @param input     The interleaved input buffer
+ * @param output    The interleaved output buffer
+ * @param matrix    The mixing matrix
+ * @param start     The first frame to mix
+ * @param frames    The total number of frames
+ */
+template <size_t IN, size_t OUT>
+static void mix_fixed(const float* input, float* output, const float* matrix,
+                      size_t start, size_t frames) {
+    const float* src = input+start*IN;
+    float* dst = output+start*OUT;
+    for(size_t ii = start; ii < frames; ii++, src += IN, dst += OUT) {
+        for(size_t kk = 0; kk < OUT; kk++) {
+            float total = 0;
+            for(size_t jj = 0; jj < IN; jj++) {
+                total += matrix[kk*IN+jj]*src[jj];
+            }
+            dst[kk] = total;
+        }
+    }
+}
+
+/**
+ * Mixes input into output for arbitrary channel counts
+ *
+ * The matrix is a channels x conduits matrix in row major order.
+ *
+ * @param input     The interleaved input buffer
+ * @param output    The interleaved output buffer
+ * @param matrix    The mixing matrix
+ * @param conduits  The number of input channels
+ * @param channels  The number of output channels
+ * @param frames    The total number of frames
+ */
+static void mix_general(const float* input, float* output, const float* matrix,
+                        size_t conduits, size_t channels, size_t frames) {
+    const float* src = input;
+    float* dst = output;
+    for(size_t ii = 0; ii < frames; ii++, src += conduits, dst += channels) {
+        for(size_t kk = 0; kk < channels; kk++) {
+            float total = 0;
+            for(size_t jj = 0; jj < conduits; jj++) {
+                total += matrix[kk*conduits+jj]*src[jj];
+            }
+            dst[kk] = total;
+        }
+    }
+}
+
+#if defined (CU_MATH_VECTOR_SSE) || defined (CU_MATH_VECTOR_NEON64)
+/**
+ * Returns the number of frames mixed from mono to stereo
+ *
+ * This kernel processes four frames at a time, leaving the remainder to
+ * the scalar kernel.
+ *
+ * @param input     The interleaved input buffer
+ * @param output    The interleaved output buffer
+ * @param matrix    The 2x1 mixing matrix
+ * @param frames    The total number of frames
+ *
+ * @return the number of frames mixed
+ */
+static size_t mix_mono_stereo128(const float* input, float* output, const float* matrix, size_t frames) {
+    size_t ii = 0;
+#if defined (CU_MATH_VECTOR_SSE)
+    __m128 coeff = _mm_setr_ps(matrix[0],matrix[1],matrix[0],matrix[1]);
+    for(; ii+4 <= frames; ii += 4) {
+        __m128 value = _mm_loadu_ps(input+ii);
+        _mm_storeu_ps(output+2*ii,  _mm_mul_ps(_mm_unpacklo_ps(value,value),coeff));
+        _mm_storeu_ps(output+2*ii+4,_mm_mul_ps(_mm_unpackhi_ps(value,value),coeff));
+    }
+#else
+    const float temp[4] = { matrix[0], matrix[1], matrix[0], matrix[1] };
+    float32x4_t coeff = vld1q_f32(temp);
+    for(; ii+4 <= frames; ii += 4) {
+        float32x4_t value = vld1q_f32(input+ii);
+        vst1q_f32(output+2*ii,  vmulq_f32(vzip1q_f32(value,value),coeff));
+        vst1q_f32(output+2*ii+4,vmulq_f32(vzip2q_f32(value,value),coeff));
+    }
+#endif
+    return ii;
+}
+
+/**
+ * Returns the number of frames mixed from IN channels to stereo
+ *
+ * The number of input channels must be even. This kernel processes two
+ * frames at a time, so that each output vector is a pair of stereo frames.
+ * It leaves the remainder to the scalar kernel.
+ *
+ * @param input     The interleaved input buffer
+ * @param output    The interleaved output buffer
+ * @param matrix    The 2xIN mixing matrix
+ * @param frames    The total number of frames
+ *
+ * @return the number of frames mixed
+ */
+template <size_t IN>
+static size_t mix_stereo128(const float* input, float* output, const float* matrix, size_t frames) {
+    size_t ii = 0;
+#if defined (CU_MATH_VECTOR_SSE)
+    __m128 coeff[IN];
+    for(size_t jj = 0; jj < IN; jj++) {
+        coeff[jj] = _mm_setr_ps(matrix[jj],matrix[IN+jj],matrix[jj],matrix[IN+jj]);
+    }
+    for(; ii+2 <= frames; ii += 2) {
+        const float* src = input+ii*IN;
+        __m128 total = _mm_setzero_ps();
+        for(size_t jj = 0; jj < IN; jj += 2) {
+            __m128 pair = _mm_loadl_pi(_mm_setzero_ps(),(const __m64*)(src+jj));
+            pair = _mm_loadh_pi(pair,(const __m64*)(src+IN+jj));
+            total = _mm_add_ps(total,_mm_mul_ps(_mm_shuffle_ps(pair,pair,_MM_SHUFFLE(2,2,0,0)),coeff[jj]));
+            total = _mm_add_ps(total,_mm_mul_ps(_mm_shuffle_ps(pair,pair,_MM_SHUFFLE(3,3,1,1)),coeff[jj+1]));
+        }
+        _mm_storeu_ps(output+2*ii,total);
+    }
+#else
+    float32x4_t coeff[IN];
+    for(size_t jj = 0; jj < IN; jj++) {
+        const float temp[4] = { matrix[jj], matrix[IN+jj], matrix[jj], matrix[IN+jj] };
+        coeff[jj] = vld1q_f32(temp);
+    }
+    for(; ii+2 <= frames; ii += 2) {
+        const float* src = input+ii*IN;
+        float32x4_t total = vdupq_n_f32(0.0f);
+        for(size_t jj = 0; jj < IN; jj += 2) {
+            float32x4_t pair = vcombine_f32(vld1_f32(src+jj),vld1_f32(src+IN+jj));
+            total = vaddq_f32(total,vmulq_f32(vtrn1q_f32(pair,pair),coeff[jj]));
+            total = vaddq_f32(total,vmulq_f32(vtrn2q_f32(pair,pair),coeff[jj+1]));
+        }
+        vst1q_f32(output+2*ii,total);
+    }
+#endif
+    return ii;
+}
+
+/**
+ * Returns the number of frames mixed from stereo to 5.1 surround
+ *
+ * This kernel processes two frames at a time, producing three output
+ * vectors. It leaves the remainder to the scalar kernel.
+ *
+ * @param input     The interleaved input buffer
+ * @param output    The interleaved output buffer
+ * @param matrix    The 6x2 mixing matrix
+ * @param frames    The total number of frames
+ *
+ * @return the number of frames mixed
+ */
+static size_t mix_stereo_51128(const float* input, float* output, const float* matrix, size_t frames) {
+    size_t ii = 0;
+    // Coefficients for [FL FR FC LFE], [BL BR FL FR], [FC LFE BL BR]
+    const float lanes[6][4] = {
+        { matrix[0], matrix[2],  matrix[4], matrix[6]  },
+        { matrix[1], matrix[3],  matrix[5], matrix[7]  },
+        { matrix[8], matrix[10], matrix[0], matrix[2]  },
+        { matrix[9], matrix[11], matrix[1], matrix[3]  },
+        { matrix[4], matrix[6],  matrix[8], matrix[10] },
+        { matrix[5], matrix[7],  matrix[9], matrix[11] }
+    };
+#if defined (CU_MATH_VECTOR_SSE)
+    __m128 coeff[6];
+    for(size_t jj = 0; jj < 6; jj++) {
+        coeff[jj] = _mm_loadu_ps(lanes[jj]);
+    }
+    for(; ii+2 <= frames; ii += 2) {
+        __m128 value = _mm_loadu_ps(input+2*ii);
+        float* dst = output+6*ii;
+        __m128 left = _mm_shuffle_ps(value,value,_MM_SHUFFLE(0,0,0,0));
+        __m128 rght = _mm_shuffle_ps(value,value,_MM_SHUFFLE(1,1,1,1));
+        _mm_storeu_ps(dst,  _mm_add_ps(_mm_mul_ps(left,coeff[0]),_mm_mul_ps(rght,coeff[1])));
+        left = _mm_shuffle_ps(value,value,_MM_SHUFFLE(2,2,0,0));
+        rght = _mm_shuffle_ps(value,value,_MM_SHUFFLE(3,3,1,1));
+        _mm_storeu_ps(dst+4,_mm_add_ps(_mm_mul_ps(left,coeff[2]),_mm_mul_ps(rght,coeff[3])));
+        left = _mm_shuffle_ps(value,value,_MM_SHUFFLE(2,2,2,2));
+        rght = _mm_shuffle_ps(value,value,_MM_SHUFFLE(3,3,3,3));
+        _mm_storeu_ps(dst+8,_mm_add_ps(_mm_mul_ps(left,coeff[4]),_mm_mul_ps(rght,coeff[5])));
+    }
+#else
+    float32x4_t coeff[6];
+    for(size_t jj = 0; jj < 6; jj++) {
+        coeff[jj] = vld1q_f32(lanes[jj]);
+    }
+    for(; ii+2 <= frames; ii += 2) {
+        float32x4_t value = vld1q_f32(input+2*ii);
+        float* dst = output+6*ii;
+        float32x4_t left = vdupq_laneq_f32(value,0);
+        float32x4_t rght = vdupq_laneq_f32(value,1);
+        vst1q_f32(dst,  vaddq_f32(vmulq_f32(left,coeff[0]),vmulq_f32(rght,coeff[1])));
+        left = vtrn1q_f32(value,value);
+        rght = vtrn2q_f32(value,value);
+        vst1q_f32(dst+4,vaddq_f32(vmulq_f32(left,coeff[2]),vmulq_f32(rght,coeff[3])));
+        left = vdupq_laneq_f32(value,2);
+        rght = vdupq_laneq_f32(value,3);
+        vst1q_f32(dst+8,vaddq_f32(vmulq_f32(left,coeff[4]),vmulq_f32(rght,coeff[5])));
+    }
+#endif
+    return ii;
+}
+#endif
+
+/**
+ * Mixes the channels of input into output with the given matrix
+ *
+ * The matrix should be an MxN matrix in row major order, where N is the
+ * number of input channels (conduits) and M is the number of output
+ * channels. Each output frame is the product of this matrix with the
+ * corresponding input frame. The input buffer must have conduits * frames
+ * many elements, and the output buffer must be able to hold channels *
+ * frames many elements. The buffers should not overlap.
+ *
+ * The common layouts (mono, stereo, 5.1 and 7.1 to stereo, as well as
+ * stereo to 5.1) have specialized kernels. All other layouts use a
+ * general purpose loop.
+ *
+ * @param input     The interleaved input buffer
+ * @param output    The interleaved output buffer
+ * @param matrix    The mixing matrix
+ * @param conduits  The number of input channels
+ * @param channels  The number of output channels
+ * @param frames    The number of frames to mix
+ *
+ * @return the number of frames successfully mixed
+ */
+size_t DSPMath::mix_matrix(const float* input, float* output, const float* matrix,
+                           size_t conduits, size_t channels, size_t frames) {
+    size_t ii = 0;
+#if defined (CU_MATH_VECTOR_SSE) || defined (CU_MATH_VECTOR_NEON64)
+#if defined (CU_MATH_VECTOR_NEON64) && defined (__ANDROID__)
+    if (VECTORIZE && android_getCpuFamily() == ANDROID_CPU_FAMILY_ARM &&
+        (android_getCpuFeatures() & ANDROID_CPU_ARM_FEATURE_NEON) != 0) {
+#else
+    if (VECTORIZE) {
+#endif
+        if (channels == 2) {
+            switch (conduits) {
+                case 1:
+                    ii = mix_mono_stereo128(input,output,matrix,frames);
+                    break;
+                case 2:
+                    ii = mix_stereo128<2>(input,output,matrix,frames);
+                    break;
+                case 6:
+                    ii = mix_stereo128<6>(input,output,matrix,frames);
+                    break;
+                case 8:
+                    ii = mix_stereo128<8>(input,output,matrix,frames);
+                    break;
+                default:
+                    break;
+            }
+        } else if (conduits == 2 && channels == 6) {
+            ii = mix_stereo_51128(input,output,matrix,frames);
+        }
+    }
+#endif
+    if (channels == 2) {
+        switch (conduits) {
+            case 1:
+                mix_fixed<1,2>(input,output,matrix,ii,frames);
+                return frames;
+            case 2:
+                mix_fixed<2,2>(input,output,matrix,ii,frames);
+                return frames;
+            case 6:
+                mix_fixed<6,2>(input,output,matrix,ii,frames);
+                return frames;
+            case 8:
+                mix_fixed<8,2>(input,output,matrix,ii,frames);
+                return frames;
+            default:
+                break;
+        }
+    } else if (conduits == 2 && channels == 6) {
+        mix_fixed<2,6>(input,output,matrix,ii,frames);
+        return frames;
+    }
+    
+    mix_general(input,output,matrix,conduits,channels,frames);
+    return frames;
+}
+
+#pragma mark -
+#pragma mark Wavetable Methods
+/**
+ * Fills output with interpolated samples from a periodic table
+ *
+ * The table should have 2^bits + 1 elements, where the last element is a
+ * copy of the first (so that interpolation can wrap around). The phase
+ * is a 32 bit fixed point value, where 2^32 represents a full period of
+ * the table. Each sample advances the phase by step (wrapping around on
+ * overflow), and is linearly interpolated between adjacent table entries.
+ *
+ * The value bits must be between 1 and 31.
+ *
+ * @param table     The periodic table
+ * @param bits      The number of bits in a table index
+ * @param phase     The initial phase as a fixed point value
+ * @param step      The phase increment per sample
+ * @param output    The output buffer
+ * @param size      The number of samples to generate
+ *
+ * @return the number of samples successfully generated
+ */
+size_t DSPMath::wavetable(const float* table, Uint32 bits, Uint32 phase, Uint32 step,
+                          float* output, size_t size) {
+    CUAssertLog(bits > 0 && bits < 32, "Table bits %d are out of range",bits);
+    const Uint32 shift = 32-bits;
+    const Uint32 mask  = (1u << shift)-1;
+    const float  fscale = 1.0f/(float)(1u << shift);
+
+    size_t ii = 0;
+#if defined (CU_MATH_VECTOR_SSE)
+    if (VECTORIZE) {
+        __m128i phases = _mm_setr_epi32((int)phase,(int)(phase+step),(int)(phase+2*step),(int)(phase+3*step));
+        __m128i stride = _mm_set1_epi32((int)(4*step));
+        __m128i vmask  = _mm_set1_epi32((int)mask);
+        __m128  vscale = _mm_set1_ps(fscale);
+        __m128i vshift = _mm_cvtsi32_si128((int)shift);
+        alignas(16) Uint32 index[4];
+        for(; ii+4 <= size; ii += 4) {
+            _mm_store_si128((__m128i*)index,_mm_srl_epi32(phases,vshift));
+            __m128 frac = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(phases,vmask)),vscale);
+            __m128 lowr = _mm_setr_ps(table[index[0]],  table[index[1]],  table[index[2]],  table[index[3]]);
+            __m128 uppr = _mm_setr_ps(table[index[0]+1],table[index[1]+1],table[index[2]+1],table[index[3]+1]);
+            _mm_storeu_ps(output+ii,_mm_add_ps(lowr,_mm_mul_ps(frac,_mm_sub_ps(uppr,lowr))));
+            phases = _mm_add_epi32(phases,stride);
+        }
+        phase += (Uint32)ii*step;
+    }
+#elif defined (CU_MATH_VECTOR_NEON64)
+#if defined (__ANDROID__)
+    if (VECTORIZE && android_getCpuFamily() == ANDROID_CPU_FAMILY_ARM &&
+        (android_getCpuFeatures() & ANDROID_CPU_ARM_FEATURE_NEON) != 0) {
+#else
+    if (VECTORIZE) {
+#endif
+        const Uint32 start[4] = { phase, phase+step, phase+2*step, phase+3*step };
+        uint32x4_t phases = vld1q_u32(start);
+        uint32x4_t stride = vdupq_n_u32(4*step);
+        uint32x4_t vmask  = vdupq_n_u32(mask);
+        int32x4_t  vshift = vdupq_n_s32(-(int)shift);
+        Uint32 index[4];
+        for(; ii+4 <= size; ii += 4) {
+            vst1q_u32(index,vshlq_u32(phases,vshift));
+            float32x4_t frac = vmulq_n_f32(vcvtq_f32_s32(vreinterpretq_s32_u32(vandq_u32(phases,vmask))),fscale);
+            const float lvals[4] = { table[index[0]],  table[index[1]],  table[index[2]],  table[index[3]]   };
+            const float uvals[4] = { table[index[0]+1],table[index[1]+1],table[index[2]+1],table[index[3]+1] };
+            float32x4_t lowr = vld1q_f32(lvals);
+            float32x4_t uppr = vld1q_f32(uvals);
+            vst1q_f32(output+ii,vaddq_f32(lowr,vmulq_f32(frac,vsubq_f32(uppr,lowr))));
+            phases = vaddq_u32(phases,stride);
+        }
+        phase += (Uint32)ii*step;
+    }
+#endif
+    for(; ii < size; ii++) {
+        Uint32 index = phase >> shift;
+        float frac = (float)(Sint32)(phase & mask)*fscale;
+        float lowr = table[index];
+        output[ii] = lowr+frac*(table[index+1]-lowr);
+        phase += step;
+    }
+    return size;
+}
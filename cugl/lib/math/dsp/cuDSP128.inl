@@ -115,3 +115,104 @@ static inline float32x2_t vld1_skip_f32(float* src, size_t stride) {
 }
 
 #endif
+
+#pragma mark -
+#pragma mark Sample Conversion
+#if defined (CU_MATH_VECTOR_SSE)
+/**
+ * Returns the truncated samples (value+offset)*gain as a __m128i vector
+ *
+ * Values are clamped to [-1,1] before conversion so that the conversion
+ * cannot overflow. Any value at or below -1 is replaced by lower, while any
+ * value at or above 1 is replaced by upper.
+ *
+ * @param value     The float samples
+ * @param offset    The offset to add before scaling
+ * @param gain      The scalar to multiply by
+ * @param lower     The result for values at or below -1
+ * @param upper     The result for values at or above 1
+ *
+ * @return the truncated samples (value+offset)*gain as a __m128i vector
+ */
+static inline __m128i _mm_cvtsample_ps(__m128 value, __m128 offset, __m128 gain,
+                                       __m128i lower, __m128i upper) {
+    const __m128 vmin = _mm_set1_ps(-1.0f);
+    const __m128 vmax = _mm_set1_ps( 1.0f);
+    __m128 clamp = _mm_min_ps(_mm_max_ps(value,vmin),vmax);
+    __m128i result = _mm_cvttps_epi32(_mm_mul_ps(_mm_add_ps(clamp,offset),gain));
+    result = _mm_blendv_epi8(result,upper,_mm_castps_si128(_mm_cmpge_ps(value,vmax)));
+    return _mm_blendv_epi8(result,lower,_mm_castps_si128(_mm_cmple_ps(value,vmin)));
+}
+
+/**
+ * Returns the __m128i vector with the bytes of each short reversed
+ *
+ * @param value     The vector of shorts
+ *
+ * @return the __m128i vector with the bytes of each short reversed
+ */
+static inline __m128i _mm_swap_epi16(__m128i value) {
+    return _mm_or_si128(_mm_slli_epi16(value,8),_mm_srli_epi16(value,8));
+}
+
+/**
+ * Returns the __m128i vector with the bytes of each int reversed
+ *
+ * @param value     The vector of ints
+ *
+ * @return the __m128i vector with the bytes of each int reversed
+ */
+static inline __m128i _mm_swap_epi32(__m128i value) {
+    const __m128i order = _mm_setr_epi8(3,2,1,0,7,6,5,4,11,10,9,8,15,14,13,12);
+    return _mm_shuffle_epi8(value,order);
+}
+
+#elif defined (CU_MATH_VECTOR_NEON64)
+/**
+ * Returns the truncated samples (value+offset)*gain as an int32x4_t vector
+ *
+ * Values are clamped to [-1,1] before conversion so that the conversion
+ * cannot overflow. Any value at or below -1 is replaced by lower, while any
+ * value at or above 1 is replaced by upper.
+ *
+ * @param value     The float samples
+ * @param offset    The offset to add before scaling
+ * @param gain      The scalar to multiply by
+ * @param lower     The result for values at or below -1
+ * @param upper     The result for values at or above 1
+ *
+ * @return the truncated samples (value+offset)*gain as an int32x4_t vector
+ */
+static inline int32x4_t vcvtsampleq_f32(float32x4_t value, float32x4_t offset, float32x4_t gain,
+                                        int32x4_t lower, int32x4_t upper) {
+    const float32x4_t vmin = vdupq_n_f32(-1.0f);
+    const float32x4_t vmax = vdupq_n_f32( 1.0f);
+    float32x4_t clamp = vminq_f32(vmaxq_f32(value,vmin),vmax);
+    int32x4_t result = vcvtq_s32_f32(vmulq_f32(vaddq_f32(clamp,offset),gain));
+    result = vbslq_s32(vcgeq_f32(value,vmax),upper,result);
+    return vbslq_s32(vcleq_f32(value,vmin),lower,result);
+}
+
+/**
+ * Returns the int16x8_t vector with the bytes of each short reversed
+ *
+ * @param value     The vector of shorts
+ *
+ * @return the int16x8_t vector with the bytes of each short reversed
+ */
+static inline int16x8_t vswapq_s16(int16x8_t value) {
+    return vreinterpretq_s16_u8(vrev16q_u8(vreinterpretq_u8_s16(value)));
+}
+
+/**
+ * Returns the int32x4_t vector with the bytes of each int reversed
+ *
+ * @param value     The vector of ints
+ *
+ * @return the int32x4_t vector with the bytes of each int reversed
+ */
+static inline int32x4_t vswapq_s32(int32x4_t value) {
+    return vreinterpretq_s32_u8(vrev32q_u8(vreinterpretq_u8_s32(value)));
+}
+
+#endif
@@ -1313,6 +1313,7 @@ size_t SimpleExtruder::getBorder(std::vector<Path2>& buffer) const {
  */
 Mesh<SpriteVertex2> SimpleExtruder::getMesh(Color4 color) const {
     Mesh<SpriteVertex2> mesh;
+    mesh.command = GL_TRIANGLES;
     getMesh(&mesh,color);
     return mesh;
 }
@@ -1359,6 +1360,29 @@ Mesh<SpriteVertex2>* SimpleExtruder::getMesh(Mesh<SpriteVertex2>* mesh, Color4 c
     return mesh;
 }
 
+/**
+ * Returns a mesh representing the path extrusion, reusing the given buffer
+ *
+ * The buffer is cleared before the extrusion is added, but its vertex and
+ * index storage keeps its capacity. The buffer is then moved into the
+ * result, so a mesh taken from a {@link MeshPool} can be filled without any
+ * allocation. It is unsafe to use the original buffer after this call.
+ *
+ * If the calculation is not yet performed, this method will return the
+ * empty mesh.
+ *
+ * @param buffer    The buffer to reuse
+ * @param color     The default mesh color
+ *
+ * @return a mesh representing the path extrusion.
+ */
+Mesh<SpriteVertex2> SimpleExtruder::getMesh(Mesh<SpriteVertex2>&& buffer, Color4 color) const {
+    buffer.clear();
+    buffer.command = GL_TRIANGLES;
+    getMesh(&buffer,color);
+    return std::move(buffer);
+}
+
 /**
  * Returns a mesh representing the path extrusion.
  *
@@ -1375,6 +1399,7 @@ Mesh<SpriteVertex2>* SimpleExtruder::getMesh(Mesh<SpriteVertex2>* mesh, Color4 c
  */
 cugl::Mesh<SpriteVertex2> SimpleExtruder::getMesh(Color4 inner, Color4 outer) const {
     Mesh<SpriteVertex2> mesh;
+    mesh.command = GL_TRIANGLES;
     getMesh(&mesh,inner,outer);
     return mesh;
 }
@@ -1427,6 +1452,30 @@ cugl::Mesh<SpriteVertex2>* SimpleExtruder::getMesh(cugl::Mesh<SpriteVertex2>* me
     return mesh;
 }
 
+/**
+ * Returns a mesh representing the path extrusion, reusing the given buffer
+ *
+ * The buffer is cleared before the extrusion is added, but its vertex and
+ * index storage keeps its capacity. The buffer is then moved into the
+ * result, so a mesh taken from a {@link MeshPool} can be filled without any
+ * allocation. It is unsafe to use the original buffer after this call.
+ *
+ * If the calculation is not yet performed, this method will return the
+ * empty mesh.
+ *
+ * @param buffer    The buffer to reuse
+ * @param inner     The interior mesh color
+ * @param outer     The exterior mesh color
+ *
+ * @return a mesh representing the path extrusion.
+ */
+cugl::Mesh<SpriteVertex2> SimpleExtruder::getMesh(cugl::Mesh<SpriteVertex2>&& buffer, Color4 inner, Color4 outer) const {
+    buffer.clear();
+    buffer.command = GL_TRIANGLES;
+    getMesh(&buffer,inner,outer);
+    return std::move(buffer);
+}
+
 /**
  * Returns the side information for the vertex at the given index
  *
@@ -215,9 +215,19 @@ bool ComplexObstacle::activatePhysics(b2World& realworld, b2World& drawworld) {
     }
     createFixtures();
 
-    // Active all other bodies.
+    // Active all other bodies, packing their handles for syncing
+    _realchildren.reserve(_bodies.size());
+    _drawchildren.reserve(_bodies.size());
     for (auto it = _bodies.begin(); it != _bodies.end(); ++it) {
-        success = success && (*it)->activatePhysics(realworld, drawworld);
+        success = (*it)->activatePhysics(realworld, drawworld);
+        if (!success) {
+            break;
+        } else if (dynamic_cast<ComplexObstacle*>(it->get()) != nullptr) {
+            _nested.push_back(it->get());
+        } else if ((*it)->getRealBody() != nullptr && (*it)->getDrawBody() != nullptr) {
+            _realchildren.push_back((*it)->getRealBody());
+            _drawchildren.push_back((*it)->getDrawBody());
+        }
     }
     success = success && createJoints(realworld, drawworld);
 
@@ -247,6 +257,9 @@ void ComplexObstacle::deactivatePhysics(b2World& realworld, b2World& drawworld)
         }
         _drawjoints.clear();
 
+        _realchildren.clear();
+        _drawchildren.clear();
+        _nested.clear();
         for (auto it = _bodies.begin(); it != _bodies.end(); ++it) {
             (*it)->deactivatePhysics(realworld, drawworld);
         }
@@ -408,6 +421,33 @@ void ComplexObstacle::syncBodies() {
     _drawbody->SetLinearDamping(_realbody->GetLinearDamping());
 }
 
+/**
+ * Copies the pose of the real bodies to the draw bodies, if they changed.
+ *
+ * This method syncs the root body and every component body. The
+ * component bodies are packed into parallel arrays when physics is
+ * activated, so they are synced in a single loop with no virtual
+ * calls. Components that do not have a body of their own (such as
+ * nested complex obstacles) are synced individually.
+ *
+ * @return true if any draw body pose was changed
+ */
+bool ComplexObstacle::syncPose() {
+    if (_realbody == nullptr || _drawbody == nullptr) {
+        return false;
+    }
+    bool moved = Obstacle::syncPose(_realbody, _drawbody);
+    b2Body** real = _realchildren.data();
+    b2Body** draw = _drawchildren.data();
+    for (size_t ii = 0; ii < _realchildren.size(); ii++) {
+        moved = Obstacle::syncPose(real[ii], draw[ii]) || moved;
+    }
+    for (auto it = _nested.begin(); it != _nested.end(); ++it) {
+        moved = (*it)->syncPose() || moved;
+    }
+    return moved;
+}
+
 BodyNetData ComplexObstacle::getBodyData() {
     BodyNetData data;
     data.id = _id;
@@ -418,8 +458,9 @@ BodyNetData ComplexObstacle::getBodyData() {
     data.awake = _realbody->IsAwake();
     data.bullet = _realbody->IsBullet();
     data.linearVelocity = _realbody->GetLinearVelocity();
+    data.angularVelocity = _realbody->GetAngularVelocity();
     data.sleepingAllowed = _realbody->IsSleepingAllowed();
-    data.fixedRotation = _realbody->GetGravityScale();
+    data.fixedRotation = _realbody->IsFixedRotation();
     data.gravityScale = _realbody->GetGravityScale();
     data.angularDamping = _realbody->GetAngularDamping();
     data.linearDamping = _realbody->GetLinearDamping();
@@ -433,6 +474,7 @@ void ComplexObstacle::setBodyFromData(BodyNetData data) {
     _realbody->SetAwake(data.awake);
     _realbody->SetBullet(data.bullet);
     _realbody->SetLinearVelocity(data.linearVelocity);
+    _realbody->SetAngularVelocity(data.angularVelocity);
     _realbody->SetSleepingAllowed(data.sleepingAllowed);
     _realbody->SetFixedRotation(data.fixedRotation);
     _realbody->SetGravityScale(data.gravityScale);
@@ -0,0 +1,264 @@
+//
+//  CUNetTransport.cpp
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides the transport interface for networked physics. A
+//  transport is an unreliable, unordered datagram channel between peers, which
+//  is all that a physics session needs (lost state is replaced by newer state).
+//  This module also provides an in-process loopback network with configurable
+//  latency and packet loss, for testing and benchmarking sessions without a
+//  real network. See CUUDPTransport.h for the socket implementation.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#include <cugl/physics2/CUNetTransport.h>
+#include <cugl/util/CUDebug.h>
+
+using namespace cugl;
+using namespace cugl::physics2;
+
+#pragma mark -
+#pragma mark Loopback Network
+/**
+ * Disposes all of the resources used by this network.
+ *
+ * All packets in flight are discarded, and all endpoints are closed.
+ */
+void LoopbackNetwork::dispose() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _inboxes.clear();
+    _open.clear();
+    _buffers.clear();
+    _time = 0;
+    _latency = 0;
+    _loss = 0;
+    _dropped = 0;
+}
+
+/**
+ * Initializes a loopback network with the given latency and loss.
+ *
+ * The latency is the one-way delay of each packet. The loss is the
+ * probability (0 to 1) that a packet is dropped. The seed makes the
+ * packet loss reproducible.
+ *
+ * @param latency   The one-way latency in seconds
+ * @param loss      The probability that a packet is dropped
+ * @param seed      The random seed for packet loss
+ *
+ * @return true if initialization was successful.
+ */
+bool LoopbackNetwork::init(float latency, float loss, Uint32 seed) {
+    CUAssertLog(latency >= 0, "Latency %f is negative", latency);
+    CUAssertLog(loss >= 0 && loss <= 1, "Loss %f is not a probability", loss);
+    _latency = latency;
+    _loss = loss;
+    _random.seed(seed);
+    return true;
+}
+
+/**
+ * Advances the network clock by the given amount.
+ *
+ * Packets are only delivered once the clock passes their delivery time.
+ *
+ * @param dt    The elapsed time in seconds
+ */
+void LoopbackNetwork::update(float dt) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _time += dt;
+}
+
+/**
+ * Returns the address of a newly opened endpoint.
+ *
+ * @return the address of a newly opened endpoint.
+ */
+Uint32 LoopbackNetwork::open() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _inboxes.emplace_back();
+    _open.push_back(true);
+    return (Uint32)(_open.size()-1);
+}
+
+/**
+ * Closes the endpoint with the given address.
+ *
+ * Any packets in flight to the endpoint are discarded.
+ *
+ * @param address   The endpoint address
+ */
+void LoopbackNetwork::close(Uint32 address) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (address < _open.size()) {
+        _open[address] = false;
+        _inboxes[address].clear();
+    }
+}
+
+/**
+ * Posts a packet from one endpoint to another.
+ *
+ * This method returns false if either endpoint is closed. A packet lost to
+ * the loss rate still counts as posted.
+ *
+ * @param source    The address of the sender
+ * @param dest      The address of the receiver
+ * @param data      The packet payload
+ * @param size      The number of bytes in the payload
+ *
+ * @return true if the packet was posted.
+ */
+bool LoopbackNetwork::post(Uint32 source, Uint32 dest, const Uint8* data, size_t size) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (source >= _open.size() || dest >= _open.size() || !_open[source] || !_open[dest]) {
+        return false;
+    }
+    if (_loss > 0 && std::uniform_real_distribution<float>(0,1)(_random) < _loss) {
+        _dropped++;
+        return true;
+    }
+
+    Packet packet;
+    packet.time = _time+_latency;
+    packet.source = source;
+    if (!_buffers.empty()) {
+        packet.data = std::move(_buffers.back());
+        _buffers.pop_back();
+    }
+    packet.data.assign(data,data+size);
+    _inboxes[dest].push_back(std::move(packet));
+    return true;
+}
+
+/**
+ * Polls the next delivered packet for the given endpoint.
+ *
+ * This method returns false if no packet has reached the endpoint yet.
+ *
+ * @param dest      The address of the receiver
+ * @param source    The address of the sender
+ * @param data      The buffer to store the payload
+ *
+ * @return true if a packet was delivered.
+ */
+bool LoopbackNetwork::poll(Uint32 dest, Uint32& source, std::vector<Uint8>& data) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (dest >= _open.size() || _inboxes[dest].empty()) {
+        return false;
+    }
+    Packet& packet = _inboxes[dest].front();
+    if (packet.time > _time) {
+        return false;
+    }
+    source = packet.source;
+    data.assign(packet.data.begin(),packet.data.end());
+    // Recycle the payload so that a steady stream does not allocate
+    _buffers.push_back(std::move(packet.data));
+    _inboxes[dest].pop_front();
+    return true;
+}
+
+#pragma mark -
+#pragma mark Loopback Transport
+/**
+ * Closes this transport, releasing all resources.
+ *
+ * Once closed, a transport can neither send nor receive packets.
+ */
+void LoopbackTransport::close() {
+    if (_network != nullptr) {
+        _network->close(_address);
+        _network = nullptr;
+    }
+    _address = NET_NO_PEER;
+}
+
+/**
+ * Initializes a transport as a new endpoint on the given network.
+ *
+ * @param network   The loopback network
+ *
+ * @return true if initialization was successful.
+ */
+bool LoopbackTransport::init(const std::shared_ptr<LoopbackNetwork>& network) {
+    CUAssertLog(_network == nullptr, "Transport is already initialized");
+    if (network == nullptr) {
+        return false;
+    }
+    _network = network;
+    _address = network->open();
+    return true;
+}
+
+/**
+ * Sends a packet to the given peer.
+ *
+ * This method returns true if the packet was handed off to the network.
+ * That is no guarantee that the packet will arrive.
+ *
+ * @param peer  The address of the destination peer
+ * @param data  The packet payload
+ * @param size  The number of bytes in the payload
+ *
+ * @return true if the packet was sent.
+ */
+bool LoopbackTransport::send(Uint32 peer, const Uint8* data, size_t size) {
+    if (_network == nullptr || !_network->post(_address,peer,data,size)) {
+        return false;
+    }
+    _packetsSent++;
+    _bytesSent += size;
+    return true;
+}
+
+/**
+ * Receives the next available packet, if any.
+ *
+ * The payload is stored in data, which is resized to fit. This method
+ * returns false immediately if there is no packet available.
+ *
+ * @param peer  The address of the source peer
+ * @param data  The buffer to store the payload
+ *
+ * @return true if a packet was received.
+ */
+bool LoopbackTransport::receive(Uint32& peer, std::vector<Uint8>& data) {
+    if (_network == nullptr || !_network->poll(_address,peer,data)) {
+        return false;
+    }
+    _packetsReceived++;
+    _bytesReceived += data.size();
+    return true;
+}
@@ -105,6 +105,76 @@ bool Obstacle::init(const Vec2 vec) {
     return true;
 }
 
+/**
+ * Copies the pose of the real body to the draw body, if it changed.
+ *
+ * This is a cheaper version of {@link #syncBodies} used by the
+ * obstacle world every frame. Unlike that method, it only calls the
+ * Box2D setters for flags that have changed, and it skips the pose
+ * entirely if the bodies are already in the same place (which is
+ * always the case for static and sleeping bodies). The pose and
+ * velocities are written with b2Body::SetPose, which defers the
+ * broad-phase update. Hence you must call b2World::SynchronizePoses
+ * on the draw world before it is stepped.
+ *
+ * @return true if the draw body pose was changed
+ */
+bool Obstacle::syncPose() {
+    b2Body* real = getRealBody();
+    b2Body* draw = getDrawBody();
+    if (real == nullptr || draw == nullptr) {
+        return false;
+    }
+    return syncPose(real, draw);
+}
+
+/**
+ * Copies the pose of the given real body to the draw body, if it changed.
+ *
+ * This is the body of {@link #syncPose()}, factored out so that composite
+ * objects can sync their component bodies in a single loop, without a
+ * virtual call per component.  Neither body may be nullptr.
+ *
+ * @param real  The body in the real world
+ * @param draw  The matching body in the draw world
+ *
+ * @return true if the draw body pose was changed
+ */
+bool Obstacle::syncPose(b2Body* real, b2Body* draw) {
+    // These setters touch fixtures or contacts, so only call them on change
+    if (draw->GetType() != real->GetType()) {
+        draw->SetType(real->GetType());
+    }
+    if (draw->IsEnabled() != real->IsEnabled()) {
+        draw->SetEnabled(real->IsEnabled());
+    }
+    if (draw->IsBullet() != real->IsBullet()) {
+        draw->SetBullet(real->IsBullet());
+    }
+    if (draw->IsSleepingAllowed() != real->IsSleepingAllowed()) {
+        draw->SetSleepingAllowed(real->IsSleepingAllowed());
+    }
+    if (draw->IsFixedRotation() != real->IsFixedRotation()) {
+        draw->SetFixedRotation(real->IsFixedRotation());
+    }
+    draw->SetGravityScale(real->GetGravityScale());
+    draw->SetAngularDamping(real->GetAngularDamping());
+    draw->SetLinearDamping(real->GetLinearDamping());
+
+    bool moved = false;
+    if (draw->GetPosition() != real->GetPosition() || draw->GetAngle() != real->GetAngle() ||
+        draw->GetLinearVelocity() != real->GetLinearVelocity() ||
+        draw->GetAngularVelocity() != real->GetAngularVelocity()) {
+        draw->SetPose(real->GetPosition(), real->GetAngle(),
+                      real->GetLinearVelocity(), real->GetAngularVelocity());
+        moved = true;
+    }
+    if (draw->IsAwake() != real->IsAwake()) {
+        draw->SetAwake(real->IsAwake());
+    }
+    return moved;
+}
+
 /**
  * Copies the state from the given body to the body def.
  *
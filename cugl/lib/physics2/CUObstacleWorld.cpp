@@ -48,6 +48,9 @@
 #include <box2d/b2_collision.h>
 #include <cugl/physics2/CUObstacleWorld.h>
 #include <cugl/physics2/CUObstacle.h>
+#include <cugl/util/CUTimestamp.h>
+#include <algorithm>
+#include <cmath>
 
 using namespace cugl;
 using namespace cugl::physics2;
@@ -153,6 +156,94 @@ public:
 };
 
 
+#pragma mark -
+#pragma mark Profile
+/**
+ * Resets all values of this profile to zero.
+ */
+void ObstacleWorld::Profile::reset() {
+    step = 0;
+    collide = 0;
+    solve = 0;
+    solveInit = 0;
+    solveVelocity = 0;
+    solvePosition = 0;
+    broadphase = 0;
+    solveTOI = 0;
+    sync = 0;
+    ministeps = 0;
+    bodies = 0;
+    awake = 0;
+    islands = 0;
+    contacts = 0;
+    proxies = 0;
+    tois = 0;
+}
+
+/**
+ * Adds the given profile to this one, field by field.
+ *
+ * @param other The profile to add
+ *
+ * @return this profile after modification
+ */
+ObstacleWorld::Profile& ObstacleWorld::Profile::operator+=(const Profile& other) {
+    step += other.step;
+    collide += other.collide;
+    solve += other.solve;
+    solveInit += other.solveInit;
+    solveVelocity += other.solveVelocity;
+    solvePosition += other.solvePosition;
+    broadphase += other.broadphase;
+    solveTOI += other.solveTOI;
+    sync += other.sync;
+    ministeps += other.ministeps;
+    bodies += other.bodies;
+    awake += other.awake;
+    islands += other.islands;
+    contacts += other.contacts;
+    proxies += other.proxies;
+    tois += other.tois;
+    return *this;
+}
+
+/**
+ * Adds the profile of the last step of the given world to the profile.
+ *
+ * @param profile   The profile to accumulate into
+ * @param world     The world that was just stepped
+ */
+static void accumulate(ObstacleWorld::Profile& profile, const b2World* world) {
+    const b2Profile& step = world->GetProfile();
+    profile.step += step.step;
+    profile.collide += step.collide;
+    profile.solve += step.solve;
+    profile.solveInit += step.solveInit;
+    profile.solveVelocity += step.solveVelocity;
+    profile.solvePosition += step.solvePosition;
+    profile.broadphase += step.broadphase;
+    profile.solveTOI += step.solveTOI;
+    profile.islands += world->GetIslandCount();
+    profile.tois += world->GetTOICount();
+}
+
+/**
+ * Records the population counts of the given world in the profile.
+ *
+ * @param profile   The profile to record into
+ * @param world     The real world
+ */
+static void census(ObstacleWorld::Profile& profile, const b2World* world) {
+    profile.bodies = (Uint32)world->GetBodyCount();
+    profile.contacts = (Uint32)world->GetContactCount();
+    profile.proxies = (Uint32)world->GetProxyCount();
+    for(const b2Body* body = world->GetBodyList(); body; body = body->GetNext()) {
+        if (body->GetType() != b2_staticBody && body->IsAwake()) {
+            profile.awake++;
+        }
+    }
+}
+
 #pragma mark -
 #pragma mark Constructors
 
@@ -164,6 +255,9 @@ public:
 ObstacleWorld::ObstacleWorld() :
 _real_world(nullptr),
 _draw_world(nullptr),
+_collect(false),
+_syncTime(0),
+_syncCount(0),
 _collide(false),
 _filters(false),
 _destroy(false) {
@@ -308,6 +402,90 @@ void ObstacleWorld::removeObstacle(Obstacle* obj) {
     CUAssertLog(false, "Physics object not present in world");
 }
 
+/**
+ * Adds a batch of obstacles to the physics world
+ *
+ * This method is the batch version of {@link #addObstacle}, and should be
+ * used when adding many obstacles at once (e.g. when a level chunk is
+ * loaded). If defer is true, the obstacles are not activated until the
+ * start of the next call to {@link #update}. This guarantees that the
+ * obstacles are added at a step boundary, and allows this method to be
+ * called from inside of a collision callback.
+ *
+ * The obstacles will be retained by this world, preventing them from being
+ * garbage collected.
+ *
+ * @param objs  The obstacles to add
+ * @param defer Whether to wait until the next update to add the obstacles
+ */
+void ObstacleWorld::addObstacles(const std::vector<std::shared_ptr<Obstacle>>& objs, bool defer) {
+    if (defer) {
+        _pending.insert(_pending.end(), objs.begin(), objs.end());
+        return;
+    }
+    _objects.reserve(_objects.size()+objs.size());
+    for(auto it = objs.begin(); it != objs.end(); ++it) {
+        CUAssertLog(inBounds(it->get()), "Obstacle is not in bounds");
+        _objects.push_back(*it);
+        (*it)->activatePhysics(*_real_world, *_draw_world);
+    }
+}
+
+/**
+ * Removes a batch of obstacles from the physics world
+ *
+ * This method marks the obstacles for removal and garbage collects them
+ * in a single pass over the world. If defer is true, the collection does
+ * not happen until the start of the next call to {@link #update}. This
+ * guarantees that the obstacles are removed at a step boundary, and allows
+ * this method to be called from inside of a collision callback.
+ *
+ * Obstacles queued by {@link #addObstacles} that have not been added yet
+ * are simply dropped.
+ *
+ * @param objs  The obstacles to remove
+ * @param defer Whether to wait until the next update to remove the obstacles
+ */
+void ObstacleWorld::removeObstacles(const std::vector<std::shared_ptr<Obstacle>>& objs, bool defer) {
+    for(auto it = objs.begin(); it != objs.end(); ++it) {
+        (*it)->markRemoved(true);
+    }
+    _collect = true;
+    if (!defer) {
+        applyPending();
+    }
+}
+
+/**
+ * Applies any deferred additions and removals.
+ *
+ * Removals are applied first, so an obstacle that is queued for addition
+ * and then marked for removal is never activated. This method is called
+ * at the start of every {@link #update} and {@link #step}, but it may be
+ * called earlier by code that needs the obstacle list to stay fixed over
+ * several steps.
+ */
+void ObstacleWorld::applyPending() {
+    if (_collect) {
+        garbageCollect();
+        _collect = false;
+    }
+    if (_pending.empty()) {
+        return;
+    }
+    
+    _objects.reserve(_objects.size()+_pending.size());
+    for(auto it = _pending.begin(); it != _pending.end(); ++it) {
+        if ((*it)->isRemoved()) {
+            continue;
+        }
+        CUAssertLog(inBounds(it->get()), "Obstacle is not in bounds");
+        _objects.push_back(*it);
+        (*it)->activatePhysics(*_real_world, *_draw_world);
+    }
+    _pending.clear();
+}
+
 /**
  * Remove all objects marked for removal.
  *
@@ -347,6 +525,8 @@ void ObstacleWorld::clear() {
         obj->deactivatePhysics(*_real_world, *_draw_world);
     }
     _objects.clear();
+    _pending.clear();
+    _collect = false;
     update(0);
 }
 
@@ -390,6 +570,9 @@ void ObstacleWorld::resetTime() {
  * @param delta Number of seconds since last animation frame
  */
 void ObstacleWorld::update(float dt) {
+    // Add and remove any deferred obstacles at the step boundary
+    applyPending();
+    
     // Turn the physics engine crank.
     // The mini step size. This is the "mini" steps we will use to get "close enough" to the amount of time that has actually passed.
     float ministep = 0.003f;
@@ -397,25 +580,41 @@ void ObstacleWorld::update(float dt) {
     float totaltime = _remainingtime + dt;
     // The total sim time (needed for obj->update)
     float totalsimtime = _remainingtime + dt;
+    _profile.reset();
 
     while (totaltime > ministep) {
         for (auto it : _objects) {
             it->updatePhysics(ministep, time, true);
         }
         _real_world->Step(ministep, _itvelocity, _itposition);
+        accumulate(_profile,_real_world);
+        _profile.ministeps++;
         totaltime -= ministep;
         time++;
     }
 
     // Now our real world is in the right state. Make one final step to set up the draw world and remember the remaining time from this frame
     _remainingtime = totaltime;
-    // Sync real body to draw body
+    // Sync real body to draw body, updating the broadphase in one pass
+    Timestamp start;
+    _syncCount = 0;
+    for (auto it : _objects) {
+        if (it->syncPose()) {
+            _syncCount++;
+        }
+    }
+    _draw_world->SynchronizePoses();
+    _syncTime = Timestamp().ellapsedMicros(start);
     for (auto it : _objects) {
-        it->syncBodies();
         it->updatePhysics(_remainingtime, time, false);
     }
     // Step the draw world by the remaining time
     _draw_world->Step(_remainingtime, _itvelocity, _itposition);
+    accumulate(_profile,_draw_world);
+    
+    // The population counts are those of the real world
+    _profile.sync = _syncTime/1000.0f;
+    census(_profile,_real_world);
 
     // Post process all objects after physics (this updates graphics)
     for (auto it : _objects) {
@@ -430,6 +629,67 @@ void ObstacleWorld::update(float dt) {
 
 }
 
+/**
+ * Advances the real world by a single fixed tick.
+ *
+ * Unlike {@link #update}, this method carries no time from one call to the
+ * next. The tick is divided into equal engine steps no longer than the step
+ * size (see {@link #getStepsize}), so a tick of the same length is always
+ * simulated the same way. This is what allows a tick to be replayed, as in
+ * network prediction.
+ *
+ * Only the real world is stepped. The obstacles are not updated, and the draw
+ * world is left as it is. Call {@link #syncDraw} once the ticks for this
+ * frame are done.
+ *
+ * @param dt    The length of the tick in seconds
+ */
+void ObstacleWorld::step(float dt) {
+    applyPending();
+
+    // Allow for round-off so that a tick of exactly the step size is one step
+    int steps = std::max(1,(int)ceilf(dt/_stepssize-0.001f));
+    float ministep = dt/steps;
+    _profile.reset();
+    for(int ii = 0; ii < steps; ii++) {
+        for (auto it = _objects.begin(); it != _objects.end(); ++it) {
+            (*it)->updatePhysics(ministep, time, true);
+        }
+        _real_world->Step(ministep, _itvelocity, _itposition);
+        accumulate(_profile,_real_world);
+        _profile.ministeps++;
+        time++;
+    }
+    census(_profile,_real_world);
+}
+
+/**
+ * Synchronizes the draw world with the real world.
+ *
+ * This copies every real body to its draw body, and then updates the
+ * obstacles (and hence the scene graph). It is the companion of {@link #step}.
+ * The draw world is not stepped, so the draw bodies are exactly the real
+ * bodies afterwards.
+ *
+ * @param dt    The time since the last synchronization in seconds
+ */
+void ObstacleWorld::syncDraw(float dt) {
+    Timestamp start;
+    _syncCount = 0;
+    for (auto it = _objects.begin(); it != _objects.end(); ++it) {
+        if ((*it)->syncPose()) {
+            _syncCount++;
+        }
+    }
+    _draw_world->SynchronizePoses();
+    _syncTime = Timestamp().ellapsedMicros(start);
+    _profile.sync += _syncTime/1000.0f;
+
+    for (auto it = _objects.begin(); it != _objects.end(); ++it) {
+        (*it)->update(dt);
+    }
+}
+
 /**
  * Returns true if the object is in bounds.
  *
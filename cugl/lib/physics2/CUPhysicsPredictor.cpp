@@ -0,0 +1,763 @@
+//
+//  CUPhysicsPredictor.cpp
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides a predicting client for a networked physics session.
+//  A plain PhysicsClient shows the world as the server last saw it, so local
+//  inputs take a round trip to have any effect. A predictor instead runs ahead
+//  of the server, applying its inputs at once. It keeps the inputs and the
+//  predicted state of recent ticks, so that when the server state for a tick
+//  arrives, it can rewind to that tick and replay its inputs to the present.
+//  The jump this causes is blended out through the draw bodies.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#include <cugl/physics2/CUPhysicsPredictor.h>
+#include <cugl/physics2/CUObstacle.h>
+#include <cugl/util/CUTimestamp.h>
+#include <cugl/util/CUDebug.h>
+#include <box2d/b2_body.h>
+#include <box2d/b2_world.h>
+#include <box2d/b2_contact.h>
+#include <box2d/b2_joint.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace cugl;
+using namespace cugl::physics2;
+
+/** The number of ticks that inputs should reach the server early, for jitter */
+#define PREDICT_MARGIN  2
+/** The maximum number of ticks the predictor will advance in one update */
+#define PREDICT_CATCHUP 8
+/** The tolerance to decide if there is time left for a tick */
+#define PREDICT_EPSILON 1e-6f
+/** The visual error below which a replay is invisible */
+#define PREDICT_SETTLED 1e-4f
+/** The weight of a new measurement in the average cost of a tick */
+#define PREDICT_COST_WEIGHT 0.125
+/** The share of the spare time that a replay is planned to take (the rest absorbs the variance) */
+#define PREDICT_HEADROOM    0.6
+
+#pragma mark -
+#pragma mark Constructors
+/**
+ * Creates a degenerate physics predictor.
+ *
+ * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an object on
+ * the heap, use one of the static constructors instead.
+ */
+PhysicsPredictor::PhysicsPredictor() : PhysicsClient(),
+_window(DEFAULT_NET_WINDOW),
+_present(0),
+_predicting(false),
+_accum(0),
+_tolerance(DEFAULT_NET_TOLERANCE),
+_budget(DEFAULT_NET_BUDGET),
+_tickCost(0),
+_fitWork(0),
+_fitTime(0),
+_fitVar(0),
+_fitCov(0),
+_starved(0),
+_tailCost(0),
+_awake(0),
+_stateTick(0),
+_replayed(0),
+_restored(0),
+_deferred(0),
+_replayTime(0) {
+}
+
+/**
+ * Disposes all of the resources used by this predictor.
+ *
+ * If the predictor is connected, it tells the server that it is leaving.
+ * The world and transport are released, but not closed. A disposed
+ * predictor can be safely reinitialized.
+ */
+void PhysicsPredictor::dispose() {
+    _history.clear();
+    _window = DEFAULT_NET_WINDOW;
+    _present = 0;
+    _predicting = false;
+    _accum = 0;
+    _tolerance = DEFAULT_NET_TOLERANCE;
+    _budget = DEFAULT_NET_BUDGET;
+    _tickCost = 0;
+    _fitWork = 0;
+    _fitTime = 0;
+    _fitVar = 0;
+    _fitCov = 0;
+    _starved = 0;
+    _tailCost = 0;
+    _awake = 0;
+    _input.clear();
+    _states.clear();
+    _stateTick = 0;
+    _diverged.clear();
+    _misses.clear();
+    _saved.clear();
+    _affected.clear();
+    _frontier.clear();
+    _boundary.clear();
+    _submitted.clear();
+    _replayed = 0;
+    _restored = 0;
+    _deferred = 0;
+    _replayTime = 0;
+    onInput = nullptr;
+    PhysicsClient::dispose();
+}
+
+/**
+ * Initializes a predictor for the given world and server.
+ *
+ * The predictor takes over the stepping of the world. The game should
+ * call {@link #update} instead of {@link ObstacleWorld#update}. The
+ * predictor connects to the server on the first update.
+ *
+ * @param world     The client copy of the world
+ * @param transport The transport to the server
+ * @param server    The address of the server on the transport
+ * @param window    The number of ticks that can be rewound
+ *
+ * @return true if initialization was successful.
+ */
+bool PhysicsPredictor::init(const std::shared_ptr<ObstacleWorld>& world,
+                            const std::shared_ptr<NetTransport>& transport, Uint32 server,
+                            Uint32 window) {
+    if (window == 0 || !PhysicsClient::init(world,transport,server)) {
+        return false;
+    }
+    _window = window;
+    _history.resize(window+1);
+    for(auto it = _history.begin(); it != _history.end(); ++it) {
+        it->tick = 0;
+    }
+    _submitted.reserve(window);
+    return true;
+}
+
+#pragma mark -
+#pragma mark Simulation
+/**
+ * Advances the predictor by the given amount of time.
+ *
+ * This reconciles any server states that have arrived, simulates the
+ * ticks that fit in the elapsed time (with a tick more or less to keep
+ * the lead on the server), and sends the recent inputs to the server.
+ * It then synchronizes the draw world and applies the visual error.
+ *
+ * @param dt    The elapsed time in seconds
+ */
+void PhysicsPredictor::update(float dt) {
+    Timestamp begin;
+    heartbeat(dt);
+    _corrected = 0;
+    _remapped = false;
+    _replayed = 0;
+    _restored = 0;
+    _deferred = 0;
+    _replayTime = 0;
+    receive();
+
+    _accum += dt;
+    Uint32 ticks = 0;
+    while (_accum+PREDICT_EPSILON >= _step && ticks < PREDICT_CATCHUP) {
+        _accum -= _step;
+        ticks++;
+    }
+    if (_accum >= _step) {
+        _accum = std::fmod(_accum,_step);
+    }
+
+    // Keep the lead on the server, gaining or losing at most a tick at a time
+    if (_rtt >= 0) {
+        Uint32 goal = target();
+        if (!_predicting || goal > _present+ticks+_window) {
+            // Too far behind to catch up, so jump ahead (the history is lost)
+            _predicting = true;
+            _present = goal-std::min(goal,ticks);
+        } else if (goal > _present+ticks+1) {
+            ticks++;
+        } else if (_present+ticks > goal+1 && ticks > 0) {
+            ticks--;
+        }
+    }
+
+    // The replay gets what the forward ticks leave of the budget
+    double spare = std::numeric_limits<double>::infinity();
+    if (_budget >= 0) {
+        spare = _budget*1000000.0-ticks*_tickCost-_tailCost-(double)Timestamp().ellapsedMicros(begin);
+    }
+    reconcile(spare);
+
+    for(Uint32 ii = 0; ii < ticks; ii++) {
+        _present++;
+        Frame& frame = _history[_present % _history.size()];
+        frame.tick = _present;
+        frame.input = _input;
+        Timestamp start;
+        simulate(frame);
+        double cost = (double)Timestamp().ellapsedMicros(start);
+        _tickCost = (_tickCost == 0 ? cost : _tickCost+PREDICT_COST_WEIGHT*(cost-_tickCost));
+    }
+
+    Timestamp tail;
+    if (_predicting && ticks > 0) {
+        send();
+    }
+
+    _world->syncDraw(dt);
+    smooth(dt);
+    double cost = (double)Timestamp().ellapsedMicros(tail);
+    _tailCost = (_tailCost == 0 ? cost : _tailCost+PREDICT_COST_WEIGHT*(cost-_tailCost));
+}
+
+/**
+ * Stores a state packet from the server, to be reconciled.
+ *
+ * Only the latest tick is kept. Older states are discarded.
+ *
+ * @param data  The packet payload
+ * @param size  The number of bytes in the payload
+ */
+void PhysicsPredictor::apply(const Uint8* data, size_t size) {
+    Uint32 tick;
+    if (!decode(data,size,tick) || tick < _tick) {
+        return;
+    }
+    if (tick != _stateTick) {
+        _states.clear();
+        _stateTick = tick;
+    }
+    _tick = tick;
+    _states.insert(_states.end(),_records.begin(),_records.end());
+}
+
+/**
+ * Reconciles the stored server states with the prediction.
+ *
+ * This replays the mispredicted bodies, worst first, for as many as fit
+ * in the given time. The rest are deferred to a later server state.
+ *
+ * @param spare The time (in microseconds) left for the replay
+ */
+void PhysicsPredictor::reconcile(double spare) {
+    if (_states.empty()) {
+        return;
+    }
+
+    // A replay needs the same obstacles throughout, so add or remove them now
+    _world->applyPending();
+    const std::vector<std::shared_ptr<Obstacle>>& objects = _world->getObstacles();
+    Frame* frame = nullptr;
+    if (_predicting && _stateTick < _present && _present-_stateTick <= _window) {
+        Frame& past = _history[_stateTick % _history.size()];
+        if (past.tick == _stateTick && past.bodies.size() == objects.size()) {
+            frame = &past;
+        }
+    }
+
+    // Without a prediction for this tick, apply the state as a plain client
+    if (frame == nullptr) {
+        for(auto it = _states.begin(); it != _states.end(); ++it) {
+            Obstacle* obstacle = lookup(it->id);
+            b2Body* body = (obstacle != nullptr ? obstacle->getRealBody() : nullptr);
+            if (body != nullptr) {
+                correct(body,*it);
+            }
+        }
+        _states.clear();
+        return;
+    }
+
+    // The frame takes the server state, whether or not we replay
+    float limit = _tolerance*_tolerance;
+    _diverged.clear();
+    _misses.resize(objects.size());
+    for(auto it = _states.begin(); it != _states.end(); ++it) {
+        size_t index = locate(it->id);
+        if (index >= frame->bodies.size() || !frame->bodies[index].valid ||
+            frame->bodies[index].id != it->id) {
+            continue;
+        }
+
+        // Prediction never changes these, so they are applied at once
+        b2Body* body = objects[index]->getRealBody();
+        if (body->IsEnabled() != it->enabled) {
+            body->SetEnabled(it->enabled);
+        }
+        if (body->IsBullet() != it->bullet) {
+            body->SetBullet(it->bullet);
+        }
+
+        Snapshot& snap = frame->bodies[index];
+        float turn = std::remainder(snap.angle-it->angle,(float)(2*M_PI));
+        float miss = (snap.position-it->position).LengthSquared();
+        if (miss > limit || fabsf(turn) > _tolerance) {
+            _diverged.push_back(index);
+            _misses[index] = std::max(miss,turn*turn);
+            _corrected++;
+        }
+        snap.position = it->position;
+        snap.angle = it->angle;
+        snap.linear = it->linear;
+        snap.angular = it->angular;
+        snap.awake = it->awake;
+    }
+    _states.clear();
+
+    if (_diverged.empty()) {
+        return;
+    }
+
+    // Worst first, so that what does not fit is what matters least
+    std::sort(_diverged.begin(),_diverged.end(),[this](size_t a, size_t b) {
+        return _misses[a] > _misses[b];
+    });
+
+    // A replay tick has a fixed cost for the world, and a cost per unit of work
+    Uint32 ticks = _present-frame->tick;
+    double slope = (_fitVar > 0 ? std::max(_fitCov/_fitVar,0.0) : 0.0);
+    if (slope == 0) {
+        slope = _tickCost/std::max(_awake,(size_t)1);
+    }
+    double base = std::max(_fitTime-slope*_fitWork,0.0);
+    double room = PREDICT_HEADROOM*spare/ticks-base;
+    if (slope > 0) {
+        room /= slope;
+    } else if (room > 0) {
+        room = std::numeric_limits<double>::infinity();
+    }
+    bool forced = (spare <= 0 || room <= 0);
+    if (forced && _starved < _window) {
+        // The forward ticks come first, so nothing is replayed if they use it all.
+        // But after a window of this, the worst body is replayed anyway (in case
+        // the estimate is too high), and the rest take the server state as is.
+        _deferred = _diverged.size();
+        _starved++;
+        return;
+    }
+    _starved = 0;
+
+    Timestamp start;
+    size_t work = 0;
+    _affected.assign(objects.size(),false);
+    for(auto it = _diverged.begin(); it != _diverged.end(); ++it) {
+        if (_affected[*it]) {
+            continue;
+        }
+        size_t more = affect(*it);
+        if (work > 0 && work+more > room) {
+            // Undo it, as it does not fit
+            for(auto jt = _frontier.begin(); jt != _frontier.end(); ++jt) {
+                _affected[*jt] = false;
+            }
+            _deferred++;
+            continue;
+        }
+        work += more;
+    }
+
+    bool complete = replay(*frame);
+    if (forced) {
+        // Nothing deferred may drift from the server for more than a window
+        for(auto it = _diverged.begin(); it != _diverged.end(); ++it) {
+            if (!_affected[*it] && *it < objects.size()) {
+                conform(*it,frame->bodies[*it]);
+            }
+        }
+        _deferred = 0;
+    }
+    double time = (double)Timestamp().ellapsedMicros(start);
+    _replayTime += time;
+    if (!complete) {
+        _affected.clear();
+        return;
+    }
+
+    // Refit the cost of a replay tick to the work (a weighted least squares)
+    double dx = work-_fitWork;
+    double dy = time/ticks-_fitTime;
+    if (_fitTime == 0) {
+        _fitWork = work;
+        _fitTime = time/ticks;
+    } else {
+        _fitWork += PREDICT_COST_WEIGHT*dx;
+        _fitTime += PREDICT_COST_WEIGHT*dy;
+        _fitVar = (1-PREDICT_COST_WEIGHT)*(_fitVar+PREDICT_COST_WEIGHT*dx*dx);
+        _fitCov = (1-PREDICT_COST_WEIGHT)*(_fitCov+PREDICT_COST_WEIGHT*dx*dy);
+    }
+    _affected.clear();
+}
+
+/**
+ * Adds an obstacle, and every obstacle touching it, to the affected set.
+ *
+ * This follows touching contacts and joints, but never crosses a static
+ * body. The obstacles added are stored in {@link #_frontier}. The work is
+ * the number of obstacles added, plus their contacts and joints. The cost
+ * of a replay tick is proportional to the work.
+ *
+ * @param index The index of the obstacle in the world
+ *
+ * @return the work added to a replay tick
+ */
+size_t PhysicsPredictor::affect(size_t index) {
+    const std::vector<std::shared_ptr<Obstacle>>& objects = _world->getObstacles();
+    _frontier.clear();
+    _affected[index] = true;
+    _frontier.push_back(index);
+
+    b2Body* body = objects[index]->getRealBody();
+    if (body == nullptr) {
+        return 1;
+    }
+    for(b2ContactEdge* edge = body->GetContactList(); edge; edge = edge->next) {
+        if (edge->contact->IsTouching()) {
+            touch(edge->other);
+        }
+    }
+    for(b2JointEdge* edge = body->GetJointList(); edge; edge = edge->next) {
+        touch(edge->other);
+    }
+
+    // The work of a replay grows with the contacts (and joints) to solve
+    size_t work = 0;
+    for(auto it = _frontier.begin(); it != _frontier.end(); ++it) {
+        work++;
+        body = objects[*it]->getRealBody();
+        for(b2ContactEdge* edge = body->GetContactList(); edge; edge = edge->next) {
+            work++;
+        }
+        for(b2JointEdge* edge = body->GetJointList(); edge; edge = edge->next) {
+            work++;
+        }
+    }
+    return work;
+}
+
+/**
+ * Adds the given body to the affected set, unless it is static or already there.
+ *
+ * The obstacle of the body is added to {@link #_frontier}.
+ *
+ * @param body  The body to add
+ */
+void PhysicsPredictor::touch(b2Body* body) {
+    if (body->GetType() == b2_staticBody) {
+        return;
+    }
+    Obstacle* obstacle = reinterpret_cast<Obstacle*>(body->GetUserData().pointer);
+    size_t index = (obstacle != nullptr ? locate((Uint32)obstacle->getId()) : _affected.size());
+    if (index < _affected.size() && !_affected[index]) {
+        _affected[index] = true;
+        _frontier.push_back(index);
+    }
+}
+
+/**
+ * Rewinds the affected obstacles to the given frame, and replays it to the present.
+ *
+ * The other obstacles are frozen for the replay, and are returned to their
+ * present state afterwards. Those that touch an affected obstacle follow
+ * their recorded prediction during the replay.
+ *
+ * If an obstacle is added or removed during the replay (such as by
+ * {@link #onInput}), the replay is abandoned (see {@link #abandon}).
+ *
+ * @param frame The frame to rewind to
+ *
+ * @return true if the replay reached the present
+ */
+bool PhysicsPredictor::replay(const Frame& frame) {
+    const std::vector<std::shared_ptr<Obstacle>>& objects = _world->getObstacles();
+    size_t size = objects.size();
+
+    // Remember the present, to restore the others and blend out the difference
+    _saved.resize(size);
+    for(size_t ii = 0; ii < size; ii++) {
+        const b2Body* body = objects[ii]->getRealBody();
+        Snapshot& save = _saved[ii];
+        save.valid = (body != nullptr && body->GetType() != b2_staticBody);
+        if (save.valid) {
+            save.id = (Uint32)objects[ii]->getId();
+            save.position = body->GetPosition();
+            save.angle = body->GetAngle();
+            save.linear = body->GetLinearVelocity();
+            save.angular = body->GetAngularVelocity();
+            save.awake = body->IsAwake();
+        }
+    }
+
+    // Rewind in a single batch. SetPose defers the broad phase to the end.
+    for(size_t ii = 0; ii < size; ii++) {
+        b2Body* body = objects[ii]->getRealBody();
+        const Snapshot& snap = frame.bodies[ii];
+        if (!_saved[ii].valid) {
+            continue;
+        } else if (!_affected[ii] || !snap.valid || objects[ii]->getId() != snap.id) {
+            // Hold it still, so that Box2D treats it as static
+            _affected[ii] = false;
+            body->SetFrozen(true);
+            continue;
+        }
+        // A body that has slept since the tick is already there
+        if (!snap.awake && !body->IsAwake() && body->GetPosition() == snap.position &&
+            body->GetAngle() == snap.angle) {
+            continue;
+        }
+        body->SetPose(snap.position,snap.angle,snap.linear,snap.angular);
+        if (body->IsAwake() != snap.awake) {
+            body->SetAwake(snap.awake);
+        }
+        _restored++;
+    }
+
+    // The frozen bodies in reach of the replay follow their prediction
+    _boundary.clear();
+    for(size_t ii = 0; ii < size; ii++) {
+        if (!_affected[ii]) {
+            continue;
+        }
+        for(b2ContactEdge* edge = objects[ii]->getRealBody()->GetContactList(); edge; edge = edge->next) {
+            Obstacle* obstacle = reinterpret_cast<Obstacle*>(edge->other->GetUserData().pointer);
+            size_t index = (obstacle != nullptr ? locate((Uint32)obstacle->getId()) : size);
+            if (index < size && _saved[index].valid && !_affected[index]) {
+                _boundary.push_back(index);
+            }
+        }
+    }
+    std::sort(_boundary.begin(),_boundary.end());
+    _boundary.erase(std::unique(_boundary.begin(),_boundary.end()),_boundary.end());
+
+    for(Uint32 tick = frame.tick+1; tick <= _present; tick++) {
+        if (objects.size() != size) {
+            abandon(frame);
+            return false;
+        }
+        const Frame& prior = _history[(tick-1) % _history.size()];
+        for(auto it = _boundary.begin(); it != _boundary.end(); ++it) {
+            const Snapshot& snap = prior.bodies[*it];
+            if (snap.valid && snap.id == objects[*it]->getId()) {
+                objects[*it]->getRealBody()->SetPose(snap.position,snap.angle,snap.linear,snap.angular);
+            }
+        }
+        _world->getWorld()->SynchronizePoses();
+        simulate(_history[tick % _history.size()]);
+        _replayed++;
+    }
+    if (objects.size() != size) {
+        abandon(frame);
+        return false;
+    }
+
+    for(size_t ii = 0; ii < size; ii++) {
+        b2Body* body = objects[ii]->getRealBody();
+        const Snapshot& save = _saved[ii];
+        if (!save.valid) {
+            continue;
+        } else if (_affected[ii]) {
+            b2Vec2 offset = save.position-body->GetPosition();
+            float turn = std::remainder(save.angle-body->GetAngle(),(float)(2*M_PI));
+            if (offset.LengthSquared() > PREDICT_SETTLED*PREDICT_SETTLED || fabsf(turn) > PREDICT_SETTLED) {
+                blend((Uint32)objects[ii]->getId(),offset,turn);
+            }
+        } else {
+            // Release the held bodies, and undo anything the replay did to them
+            body->SetFrozen(false);
+            if (body->IsAwake() != save.awake) {
+                body->SetAwake(save.awake);
+            }
+            if (body->GetPosition() != save.position || body->GetAngle() != save.angle) {
+                body->SetPose(save.position,save.angle,save.linear,save.angular);
+            } else if (save.awake) {
+                body->SetLinearVelocity(save.linear);
+                body->SetAngularVelocity(save.angular);
+            }
+        }
+    }
+    _world->getWorld()->SynchronizePoses();
+    return true;
+}
+
+/**
+ * Abandons a replay after the obstacles of the world have changed.
+ *
+ * The indices of the replay no longer match the world, so the obstacles are
+ * found again by id. Every obstacle is released and returned to its state
+ * before the replay. The affected obstacles then take their state in the
+ * given frame, exactly as for a {@link PhysicsClient}.
+ *
+ * @param frame The frame of the replay
+ */
+void PhysicsPredictor::abandon(const Frame& frame) {
+    const std::vector<std::shared_ptr<Obstacle>>& objects = _world->getObstacles();
+    for(auto it = objects.begin(); it != objects.end(); ++it) {
+        b2Body* body = (*it)->getRealBody();
+        if (body != nullptr && body->IsFrozen()) {
+            body->SetFrozen(false);
+        }
+    }
+
+    _remapped = false;
+    for(size_t ii = 0; ii < _saved.size(); ii++) {
+        const Snapshot& save = _saved[ii];
+        size_t index = (save.valid ? locate(save.id) : objects.size());
+        if (index >= objects.size()) {
+            continue;
+        }
+        b2Body* body = objects[index]->getRealBody();
+        body->SetPose(save.position,save.angle,save.linear,save.angular);
+        body->SetAwake(save.awake);
+
+        if (_affected[ii]) {
+            conform(index,frame.bodies[ii]);
+        }
+    }
+    _world->getWorld()->SynchronizePoses();
+}
+
+/**
+ * Moves an obstacle to a state of the given frame, exactly as a {@link PhysicsClient}.
+ *
+ * The snapshot is ignored if it is not for this obstacle. The difference
+ * is blended out over the smoothing time.
+ *
+ * @param index The index of the obstacle in the world
+ * @param snap  The state to take
+ */
+void PhysicsPredictor::conform(size_t index, const Snapshot& snap) {
+    const std::shared_ptr<Obstacle>& obstacle = _world->getObstacles()[index];
+    b2Body* body = obstacle->getRealBody();
+    if (body == nullptr || !snap.valid || snap.id != (Uint32)obstacle->getId()) {
+        return;
+    }
+    Record state;
+    state.id = snap.id;
+    state.position = snap.position;
+    state.angle = snap.angle;
+    state.linear = snap.linear;
+    state.angular = snap.angular;
+    state.awake = snap.awake;
+    state.enabled = body->IsEnabled();
+    state.bullet = body->IsBullet();
+    correct(body,state);
+}
+
+/**
+ * Applies the input of the given frame, steps the world, and records the result.
+ *
+ * @param frame The frame to simulate
+ */
+void PhysicsPredictor::simulate(Frame& frame) {
+    if (onInput) {
+        onInput(frame.tick,frame.input.data(),frame.input.size());
+    }
+    _world->step(_step);
+    record(frame);
+}
+
+/**
+ * Records the state of every obstacle in the given frame.
+ *
+ * During a replay, only the affected obstacles are recorded.
+ *
+ * @param frame The frame to record
+ */
+void PhysicsPredictor::record(Frame& frame) {
+    const std::vector<std::shared_ptr<Obstacle>>& objects = _world->getObstacles();
+    bool replaying = !_affected.empty();
+    if (replaying && _affected.size() != objects.size()) {
+        // The world changed during the replay, which is abandoned
+        return;
+    } else if (!replaying) {
+        _awake = 0;
+    }
+    frame.bodies.resize(objects.size());
+    for(size_t ii = 0; ii < objects.size(); ii++) {
+        if (replaying && !_affected[ii]) {
+            continue;
+        }
+        Snapshot& snap = frame.bodies[ii];
+        const b2Body* body = objects[ii]->getRealBody();
+        snap.valid = (body != nullptr);
+        if (snap.valid) {
+            snap.id = (Uint32)objects[ii]->getId();
+            snap.position = body->GetPosition();
+            snap.angle = body->GetAngle();
+            snap.linear = body->GetLinearVelocity();
+            snap.angular = body->GetAngularVelocity();
+            snap.awake = body->IsAwake();
+            if (snap.awake && !replaying) {
+                _awake++;
+            }
+        }
+    }
+}
+
+/**
+ * Sends the inputs in the window to the server.
+ *
+ * Inputs are sent redundantly, so that a lost packet does not lose one.
+ */
+void PhysicsPredictor::send() {
+    // Only send the unbroken run of inputs that ends at the present
+    Uint32 first = _present;
+    while (first > 1 && _present-first+1 < _window &&
+           _history[(first-1) % _history.size()].tick == first-1) {
+        first--;
+    }
+    _submitted.clear();
+    for(Uint32 tick = first; tick <= _present; tick++) {
+        _submitted.push_back(&(_history[tick % _history.size()].input));
+    }
+    submit(first,_submitted);
+}
+
+/**
+ * Returns the tick that this predictor should have simulated by now.
+ *
+ * This is the server tick at which an input sent now arrives, plus a
+ * small margin for jitter.
+ *
+ * @return the tick that this predictor should have simulated by now.
+ */
+Uint32 PhysicsPredictor::target() const {
+    double ahead = (_clock-_echoTime)+_rtt;
+    return _echoTick+(Uint32)std::ceil(ahead/_step)+PREDICT_MARGIN;
+}
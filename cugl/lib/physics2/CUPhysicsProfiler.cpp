@@ -0,0 +1,402 @@
+//
+//  CUPhysicsProfiler.cpp
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides a rolling profiler for the physics engine. It records
+//  the per-frame profile of one or more obstacle worlds, and computes averages
+//  and percentiles over a window of recent frames. These statistics can be
+//  displayed with a ProfilerNode or written to a CSV or JSON file, so that
+//  the physics cost can be measured in production builds.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#include <cugl/physics2/CUPhysicsProfiler.h>
+#include <cugl/io/CUTextWriter.h>
+#include <cugl/io/CUJsonWriter.h>
+#include <cugl/util/CUDebug.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace cugl;
+using namespace cugl::physics2;
+
+/** Shorthand for the profile class */
+typedef ObstacleWorld::Profile Profile;
+
+/** The timing values of a profile, in output order */
+static float Profile::* const TIMES[] = {
+    &Profile::step, &Profile::collide, &Profile::solve,
+    &Profile::solveInit, &Profile::solveVelocity, &Profile::solvePosition,
+    &Profile::broadphase, &Profile::solveTOI, &Profile::sync
+};
+
+/** The names of the timing values */
+static const char* TIME_NAMES[] = {
+    "step", "collide", "solve",
+    "solveInit", "solveVelocity", "solvePosition",
+    "broadphase", "solveTOI", "sync"
+};
+
+/** The count values of a profile, in output order */
+static Uint32 Profile::* const COUNTS[] = {
+    &Profile::ministeps, &Profile::bodies, &Profile::awake,
+    &Profile::islands, &Profile::contacts, &Profile::proxies, &Profile::tois
+};
+
+/** The names of the count values */
+static const char* COUNT_NAMES[] = {
+    "ministeps", "bodies", "awake",
+    "islands", "contacts", "proxies", "tois"
+};
+
+/** The number of timing values */
+#define TIME_SIZE   (sizeof(TIMES)/sizeof(TIMES[0]))
+/** The number of count values */
+#define COUNT_SIZE  (sizeof(COUNTS)/sizeof(COUNTS[0]))
+
+/**
+ * Returns a JSON object for the given profile
+ *
+ * @param profile   The profile to convert
+ *
+ * @return a JSON object for the given profile
+ */
+static std::shared_ptr<JsonValue> profile_to_json(const Profile& profile) {
+    std::shared_ptr<JsonValue> result = JsonValue::allocObject();
+    for(size_t ii = 0; ii < TIME_SIZE; ii++) {
+        result->appendValue(TIME_NAMES[ii], (double)(profile.*TIMES[ii]));
+    }
+    for(size_t ii = 0; ii < COUNT_SIZE; ii++) {
+        result->appendValue(COUNT_NAMES[ii], (long)(profile.*COUNTS[ii]));
+    }
+    return result;
+}
+
+#pragma mark -
+#pragma mark Constructors
+/**
+ * Disposes all of the resources used by this profiler.
+ *
+ * All worlds are detached. A disposed profiler can be safely reinitialized.
+ */
+void PhysicsProfiler::dispose() {
+    _worlds.clear();
+    _history.clear();
+    _head = 0;
+    _count = 0;
+    _frames = 0;
+}
+
+/**
+ * Initializes a profiler with the given window size.
+ *
+ * The window is the number of recent frames used to compute statistics.
+ *
+ * @param window    The number of frames in the window
+ *
+ * @return true if initialization was successful.
+ */
+bool PhysicsProfiler::init(size_t window) {
+    if (!_history.empty()) {
+        CUAssertLog(false, "Physics profiler is already initialized");
+        return false;
+    } else if (window == 0) {
+        CUAssertLog(false, "The profiler window must be positive");
+        return false;
+    }
+    _history.resize(window);
+    return true;
+}
+
+#pragma mark -
+#pragma mark Recording
+/**
+ * Attaches a world to this profiler.
+ *
+ * The profile of each attached world is added to the frame recorded by
+ * {@link #update}. Attaching a world twice has no effect.
+ *
+ * @param world The world to attach
+ */
+void PhysicsProfiler::attach(const std::shared_ptr<ObstacleWorld>& world) {
+    if (world != nullptr && std::find(_worlds.begin(),_worlds.end(),world) == _worlds.end()) {
+        _worlds.push_back(world);
+    }
+}
+
+/**
+ * Detaches a world from this profiler.
+ *
+ * Detaching a world does not affect any frames already recorded.
+ *
+ * @param world The world to detach
+ */
+void PhysicsProfiler::detach(const std::shared_ptr<ObstacleWorld>& world) {
+    auto it = std::find(_worlds.begin(),_worlds.end(),world);
+    if (it != _worlds.end()) {
+        _worlds.erase(it);
+    }
+}
+
+/**
+ * Records the summed profile of the attached worlds as a new frame.
+ *
+ * This method should be called once per frame, after the worlds have
+ * been updated.
+ */
+void PhysicsProfiler::update() {
+    Profile total;
+    for(auto it = _worlds.begin(); it != _worlds.end(); ++it) {
+        total += (*it)->getProfile();
+    }
+    record(total);
+}
+
+/**
+ * Records the given profile as a new frame.
+ *
+ * If the window is full, the oldest frame is discarded.
+ *
+ * @param profile   The profile to record
+ */
+void PhysicsProfiler::record(const Profile& profile) {
+    if (_history.empty()) {
+        return;
+    }
+    _history[_head] = profile;
+    _head = (_head+1) % _history.size();
+    _count = std::min(_count+1,_history.size());
+    _frames++;
+}
+
+/**
+ * Discards all recorded frames.
+ *
+ * The attached worlds are unaffected.
+ */
+void PhysicsProfiler::reset() {
+    _head = 0;
+    _count = 0;
+    _frames = 0;
+}
+
+#pragma mark -
+#pragma mark Statistics
+/**
+ * Returns the frame at the given position in the window.
+ *
+ * Position 0 is the oldest frame in the window, while position
+ * {@link #getCount}-1 is the most recent.
+ *
+ * @param index The position in the window
+ *
+ * @return the frame at the given position in the window.
+ */
+const Profile& PhysicsProfiler::getFrame(size_t index) const {
+    CUAssertLog(index < _count, "Frame index %zu is out of range", index);
+    size_t size = _history.size();
+    return _history[(_head+size-_count+index) % size];
+}
+
+/**
+ * Returns the most recently recorded frame.
+ *
+ * If no frames have been recorded, this is a zero profile.
+ *
+ * @return the most recently recorded frame.
+ */
+Profile PhysicsProfiler::getLast() const {
+    return _count == 0 ? Profile() : getFrame(_count-1);
+}
+
+/**
+ * Returns the average profile over the window.
+ *
+ * The integer counts are rounded to the nearest value.
+ *
+ * @return the average profile over the window.
+ */
+Profile PhysicsProfiler::getAverage() const {
+    Profile result;
+    if (_count == 0) {
+        return result;
+    }
+
+    // Sum the counts in 64 bits to avoid overflow
+    Uint64 counts[COUNT_SIZE] = { 0 };
+    for(size_t ii = 0; ii < _count; ii++) {
+        const Profile& frame = getFrame(ii);
+        for(size_t jj = 0; jj < TIME_SIZE; jj++) {
+            result.*TIMES[jj] += frame.*TIMES[jj];
+        }
+        for(size_t jj = 0; jj < COUNT_SIZE; jj++) {
+            counts[jj] += frame.*COUNTS[jj];
+        }
+    }
+    for(size_t jj = 0; jj < TIME_SIZE; jj++) {
+        result.*TIMES[jj] /= _count;
+    }
+    for(size_t jj = 0; jj < COUNT_SIZE; jj++) {
+        result.*COUNTS[jj] = (Uint32)((counts[jj]+_count/2)/_count);
+    }
+    return result;
+}
+
+/**
+ * Returns the given percentile of the profile over the window.
+ *
+ * The percentile is computed separately for each value with the nearest
+ * rank method. The percent should be between 0 and 100.
+ *
+ * @param percent   The percentile to compute
+ *
+ * @return the given percentile of the profile over the window.
+ */
+Profile PhysicsProfiler::getPercentile(float percent) const {
+    Profile result;
+    if (_count == 0) {
+        return result;
+    }
+
+    percent = std::max(0.0f,std::min(percent,100.0f));
+    size_t rank = (size_t)std::ceil(percent*_count/100.0f);
+    size_t index = rank == 0 ? 0 : std::min(rank,_count)-1;
+
+    std::vector<float> times(_count);
+    for(size_t jj = 0; jj < TIME_SIZE; jj++) {
+        for(size_t ii = 0; ii < _count; ii++) {
+            times[ii] = getFrame(ii).*TIMES[jj];
+        }
+        std::nth_element(times.begin(),times.begin()+index,times.end());
+        result.*TIMES[jj] = times[index];
+    }
+
+    std::vector<Uint32> counts(_count);
+    for(size_t jj = 0; jj < COUNT_SIZE; jj++) {
+        for(size_t ii = 0; ii < _count; ii++) {
+            counts[ii] = getFrame(ii).*COUNTS[jj];
+        }
+        std::nth_element(counts.begin(),counts.begin()+index,counts.end());
+        result.*COUNTS[jj] = counts[index];
+    }
+    return result;
+}
+
+#pragma mark -
+#pragma mark Output
+/**
+ * Returns a JSON summary of the window.
+ *
+ * The summary is an object with the number of frames, and the average,
+ * median (p50), p95 and maximum profiles. Each profile is an object keyed
+ * by the value names used in the CSV header.
+ *
+ * @return a JSON summary of the window.
+ */
+std::shared_ptr<JsonValue> PhysicsProfiler::toJson() const {
+    std::shared_ptr<JsonValue> result = JsonValue::allocObject();
+    result->appendValue("frames", (long)_count);
+    result->appendChild("average", profile_to_json(getAverage()));
+    result->appendChild("p50", profile_to_json(getPercentile(50)));
+    result->appendChild("p95", profile_to_json(getPercentile(95)));
+    result->appendChild("max", profile_to_json(getMaximum()));
+    return result;
+}
+
+/**
+ * Writes the frames in the window to the given CSV file.
+ *
+ * The file has a header row naming each value, followed by one row per
+ * frame from oldest to most recent. Times are in milliseconds. Relative
+ * paths are resolved as in {@link TextWriter}.
+ *
+ * @param file  The CSV file
+ *
+ * @return true if the file was successfully written
+ */
+bool PhysicsProfiler::writeCSV(const std::string file) const {
+    std::shared_ptr<TextWriter> writer = TextWriter::alloc(file);
+    if (writer == nullptr) {
+        CULogError("Could not write profile %s", file.c_str());
+        return false;
+    }
+
+    std::string line;
+    for(size_t jj = 0; jj < TIME_SIZE; jj++) {
+        line += TIME_NAMES[jj];
+        line += ",";
+    }
+    for(size_t jj = 0; jj < COUNT_SIZE; jj++) {
+        line += COUNT_NAMES[jj];
+        line += (jj+1 < COUNT_SIZE ? "," : "");
+    }
+    writer->writeLine(line);
+
+    for(size_t ii = 0; ii < _count; ii++) {
+        const Profile& frame = getFrame(ii);
+        line.clear();
+        for(size_t jj = 0; jj < TIME_SIZE; jj++) {
+            line += strtool::to_string(frame.*TIMES[jj]);
+            line += ",";
+        }
+        for(size_t jj = 0; jj < COUNT_SIZE; jj++) {
+            line += strtool::to_string(frame.*COUNTS[jj]);
+            line += (jj+1 < COUNT_SIZE ? "," : "");
+        }
+        writer->writeLine(line);
+    }
+    writer->close();
+    return true;
+}
+
+/**
+ * Writes the JSON summary of the window to the given file.
+ *
+ * See {@link #toJson} for the format. Relative paths are resolved as in
+ * {@link JsonWriter}.
+ *
+ * @param file  The JSON file
+ *
+ * @return true if the file was successfully written
+ */
+bool PhysicsProfiler::writeJson(const std::string file) const {
+    std::shared_ptr<JsonWriter> writer = JsonWriter::alloc(file);
+    if (writer == nullptr) {
+        CULogError("Could not write profile %s", file.c_str());
+        return false;
+    }
+    writer->writeJson(toJson());
+    writer->close();
+    return true;
+}
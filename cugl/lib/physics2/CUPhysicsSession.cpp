@@ -0,0 +1,910 @@
+//
+//  CUPhysicsSession.cpp
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides a networked physics session for an ObstacleWorld.
+//  The server is authoritative: it steps its world at a fixed tick and
+//  broadcasts the state of the moving bodies to all clients. A client keeps
+//  simulating its own copy of the world, and applies the server state to the
+//  real bodies as it arrives. The jump this causes is hidden by smoothing the
+//  error through the draw bodies, which are only used for display.
+//
+//  Sessions communicate through a NetTransport, so the same session runs over
+//  UDP or over an in-process loopback network.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#include <cugl/physics2/CUPhysicsSession.h>
+#include <cugl/physics2/CUObstacle.h>
+#include <cugl/base/CUEndian.h>
+#include <cugl/util/CUTimestamp.h>
+#include <cugl/util/CUDebug.h>
+#include <box2d/b2_body.h>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+
+using namespace cugl;
+using namespace cugl::physics2;
+
+#pragma mark -
+#pragma mark Wire Format
+/** A client request to join the session: clock (4) */
+#define NET_HELLO       1
+/** A server reply accepting a client: tick (4), step (4), echoed clock (4) */
+#define NET_WELCOME     2
+/** A server state: tick (4), body count (2), flags (1), then the bodies */
+#define NET_STATE       3
+/** A client notice that it is leaving the session: clock (4) */
+#define NET_BYE         4
+/** A client heartbeat: clock (4); the server echo: tick (4), echoed clock (4) */
+#define NET_ALIVE       5
+/** The client inputs: first tick (4), count (1), then each input as size (1) and bytes */
+#define NET_INPUT       6
+
+/** The size of a client message with a clock */
+#define SIGNAL_SIZE     5
+/** The size of a welcome message */
+#define WELCOME_SIZE    13
+/** The size of a heartbeat echo */
+#define ECHO_SIZE       9
+/** The size of the header of an input message */
+#define INPUT_HEADER    6
+/** The size of the header of a state message */
+#define STATE_HEADER    8
+/** The size of a body in a state message: id, position, angle, velocities, flags */
+#define STATE_RECORD    29
+/** The state flag for a keyframe */
+#define STATE_KEYFRAME  1
+
+/** The body flag for an awake body */
+#define BODY_AWAKE      1
+/** The body flag for an enabled body */
+#define BODY_ENABLED    2
+/** The body flag for a bullet */
+#define BODY_BULLET     4
+
+/** The time between connection attempts in seconds */
+#define NET_RETRY       0.25f
+/** The time between client heartbeats in seconds */
+#define NET_HEARTBEAT   0.5f
+/** The maximum number of ticks the server will catch up in one update */
+#define NET_CATCHUP     8
+/** The furthest ahead of the server that a client input may be */
+#define NET_HORIZON     256
+/** The weight of a new sample in the smoothed round trip time */
+#define NET_RTT_WEIGHT  0.125f
+/** The tolerance to decide if the server has time left for a tick */
+#define NET_EPSILON     1e-6f
+/** The visual error below which a correction is finished */
+#define NET_SETTLED     1e-4f
+
+/**
+ * Writes the given value to the buffer in network order.
+ *
+ * @param out   The buffer to write to
+ * @param value The value to write
+ *
+ * @return the position in the buffer after the value
+ */
+static Uint8* write32(Uint8* out, Uint32 value) {
+    value = marshall(value);
+    std::memcpy(out,&value,sizeof(Uint32));
+    return out+sizeof(Uint32);
+}
+
+/**
+ * Writes the given value to the buffer in network order.
+ *
+ * @param out   The buffer to write to
+ * @param value The value to write
+ *
+ * @return the position in the buffer after the value
+ */
+static Uint8* writeFloat(Uint8* out, float value) {
+    value = marshall(value);
+    std::memcpy(out,&value,sizeof(float));
+    return out+sizeof(float);
+}
+
+/**
+ * Returns the value read from the buffer in network order.
+ *
+ * @param in    The buffer to read from (advanced past the value)
+ *
+ * @return the value read from the buffer in network order.
+ */
+static Uint32 read32(const Uint8*& in) {
+    Uint32 value;
+    std::memcpy(&value,in,sizeof(Uint32));
+    in += sizeof(Uint32);
+    return marshall(value);
+}
+
+/**
+ * Returns the value read from the buffer in network order.
+ *
+ * @param in    The buffer to read from (advanced past the value)
+ *
+ * @return the value read from the buffer in network order.
+ */
+static float readFloat(const Uint8*& in) {
+    float value;
+    std::memcpy(&value,in,sizeof(float));
+    in += sizeof(float);
+    return marshall(value);
+}
+
+#pragma mark -
+#pragma mark Server Constructors
+/**
+ * Creates a degenerate physics server.
+ *
+ * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an object on
+ * the heap, use one of the static constructors instead.
+ */
+PhysicsServer::PhysicsServer() :
+_clock(0),
+_timeout(DEFAULT_NET_TIMEOUT),
+_step(DEFAULT_NET_TICK),
+_accum(0),
+_tick(0),
+_keyrate(DEFAULT_NET_KEYFRAME),
+_keyframe(true),
+_stepTime(0),
+_sendTime(0),
+_tickBytes(0),
+_tickBodies(0) {
+}
+
+/**
+ * Disposes all of the resources used by this server.
+ *
+ * The world and transport are released, but not closed. A disposed
+ * server can be safely reinitialized.
+ */
+void PhysicsServer::dispose() {
+    _world = nullptr;
+    _transport = nullptr;
+    _clients.clear();
+    _heard.clear();
+    _inputs.clear();
+    _packet.clear();
+    _incoming.clear();
+    _clock = 0;
+    _timeout = DEFAULT_NET_TIMEOUT;
+    _step = DEFAULT_NET_TICK;
+    _accum = 0;
+    _tick = 0;
+    _keyrate = DEFAULT_NET_KEYFRAME;
+    _keyframe = true;
+    _stepTime = 0;
+    _sendTime = 0;
+    _tickBytes = 0;
+    _tickBodies = 0;
+}
+
+/**
+ * Initializes a server for the given world and transport.
+ *
+ * The server takes over the stepping of the world. The game should call
+ * {@link #update} instead of {@link ObstacleWorld#update}.
+ *
+ * @param world     The authoritative world
+ * @param transport The transport to the clients
+ * @param step      The fixed tick in seconds
+ *
+ * @return true if initialization was successful.
+ */
+bool PhysicsServer::init(const std::shared_ptr<ObstacleWorld>& world,
+                         const std::shared_ptr<NetTransport>& transport, float step) {
+    CUAssertLog(_world == nullptr, "Server is already initialized");
+    if (world == nullptr || transport == nullptr || step <= 0) {
+        return false;
+    }
+    _world = world;
+    _transport = transport;
+    _step = step;
+    _packet.resize(NET_MAX_PACKET);
+    return true;
+}
+
+#pragma mark -
+#pragma mark Server Simulation
+/**
+ * Advances the server by the given amount of time.
+ *
+ * This processes any client packets, and then simulates as many fixed
+ * ticks as fit in the elapsed time (plus any time left over from the last
+ * call). The state is broadcast after every tick. Each tick is simulated
+ * with {@link ObstacleWorld#step}, so that clients can replay it exactly.
+ * The draw world is synchronized once all of the ticks are done.
+ *
+ * @param dt    The elapsed time in seconds
+ *
+ * @return the number of ticks simulated
+ */
+Uint32 PhysicsServer::update(float dt) {
+    _clock += dt;
+    receive();
+    _accum += dt;
+    Uint32 ticks = 0;
+    while (_accum+NET_EPSILON >= _step && ticks < NET_CATCHUP) {
+        tick();
+        _accum -= _step;
+        ticks++;
+    }
+    // Drop any backlog rather than spiral after a long stall
+    if (_accum >= _step) {
+        _accum = std::fmod(_accum,_step);
+    } else if (_accum < 0) {
+        _accum = 0;
+    }
+    if (ticks > 0) {
+        _world->syncDraw(ticks*_step);
+    }
+    return ticks;
+}
+
+/**
+ * Simulates a single tick and broadcasts the result.
+ *
+ * This applies the client inputs due by this tick, but does not process
+ * any client packets. It does not synchronize the draw world.
+ */
+void PhysicsServer::tick() {
+    Timestamp start;
+    _tick++;
+    for(auto it = _clients.begin(); it != _clients.end() && !_inputs.empty(); ++it) {
+        auto jt = _inputs.find(*it);
+        if (jt == _inputs.end()) {
+            continue;
+        }
+        // Late inputs are applied now, in order
+        std::map<Uint32, std::vector<Uint8>>& pending = jt->second.pending;
+        while (!pending.empty() && pending.begin()->first <= _tick) {
+            if (onInput) {
+                const std::vector<Uint8>& input = pending.begin()->second;
+                onInput(*it,pending.begin()->first,input.data(),input.size());
+            }
+            pending.erase(pending.begin());
+        }
+    }
+    _world->step(_step);
+    Timestamp mark;
+    broadcast();
+    Timestamp end;
+    _stepTime = mark.ellapsedMicros(start);
+    _sendTime = end.ellapsedMicros(mark);
+}
+
+/**
+ * Processes all of the packets received from the clients.
+ *
+ * This also drops any client that has timed out.
+ */
+void PhysicsServer::receive() {
+    Uint32 peer;
+    while (_transport->receive(peer,_incoming)) {
+        if (_incoming.empty()) {
+            continue;
+        }
+        size_t pos = std::find(_clients.begin(),_clients.end(),peer)-_clients.begin();
+        const Uint8* in = _incoming.data()+1;
+        Uint32 sent = (_incoming.size() >= SIGNAL_SIZE ? read32(in) : 0);
+        switch (_incoming[0]) {
+            case NET_HELLO:
+            {
+                // Always reply, as an earlier welcome may have been lost
+                if (pos == _clients.size()) {
+                    _clients.push_back(peer);
+                    _heard.push_back(_clock);
+                    _keyframe = true;
+                }
+                Uint8 reply[WELCOME_SIZE];
+                reply[0] = NET_WELCOME;
+                write32(writeFloat(write32(reply+1,_tick),_step),sent);
+                _transport->send(peer,reply,WELCOME_SIZE);
+            }
+                break;
+            case NET_ALIVE:
+                if (pos < _clients.size()) {
+                    Uint8 reply[ECHO_SIZE];
+                    reply[0] = NET_ALIVE;
+                    write32(write32(reply+1,_tick),sent);
+                    _transport->send(peer,reply,ECHO_SIZE);
+                }
+                break;
+            case NET_INPUT:
+                if (pos < _clients.size()) {
+                    store(peer,_incoming.data(),_incoming.size());
+                }
+                break;
+            case NET_BYE:
+                if (pos < _clients.size()) {
+                    drop(pos);
+                    pos = _clients.size();
+                }
+                break;
+            default:
+                break;
+        }
+        if (pos < _clients.size()) {
+            _heard[pos] = _clock;
+        } else {
+            // Only clients are remembered by the transport
+            _transport->removePeer(peer);
+        }
+    }
+
+    if (_timeout <= 0) {
+        return;
+    }
+    for(size_t ii = 0; ii < _clients.size(); ) {
+        if (_clock-_heard[ii] > _timeout) {
+            drop(ii);
+        } else {
+            ii++;
+        }
+    }
+}
+
+/**
+ * Stores the inputs of an input message from the given client.
+ *
+ * @param client    The client address
+ * @param data      The packet payload
+ * @param size      The number of bytes in the payload
+ */
+void PhysicsServer::store(Uint32 client, const Uint8* data, size_t size) {
+    if (size < INPUT_HEADER) {
+        return;
+    }
+    const Uint8* in = data+1;
+    const Uint8* end = data+size;
+    Uint32 first = read32(in);
+    Uint8 count = *in++;
+
+    // Each message repeats the recent inputs, so most have been seen before
+    Inputs& inputs = _inputs[client];
+    for(Uint8 ii = 0; ii < count && in < end; ii++) {
+        size_t length = *in++;
+        if (in+length > end) {
+            break;
+        }
+        Uint32 tick = first+ii;
+        if (tick > inputs.received && tick <= _tick+NET_HORIZON) {
+            inputs.pending.emplace(tick,std::vector<Uint8>(in,in+length));
+            inputs.received = tick;
+        }
+        in += length;
+    }
+}
+
+/**
+ * Drops the client at the given position in the client list.
+ *
+ * The transport forgets the client too.
+ *
+ * @param pos   The position of the client
+ */
+void PhysicsServer::drop(size_t pos) {
+    _transport->removePeer(_clients[pos]);
+    _inputs.erase(_clients[pos]);
+    _clients.erase(_clients.begin()+pos);
+    _heard.erase(_heard.begin()+pos);
+}
+
+/**
+ * Sends the state of the world to all clients.
+ */
+void PhysicsServer::broadcast() {
+    _tickBytes = 0;
+    _tickBodies = 0;
+    if (_clients.empty()) {
+        return;
+    }
+
+    bool keyframe = _keyframe || _keyrate == 0 || _tick % _keyrate == 0;
+    _keyframe = false;
+    Uint64 before = _transport->getBytesSent();
+
+    const size_t capacity = (NET_MAX_PACKET-STATE_HEADER)/STATE_RECORD;
+    Uint8* head = _packet.data();
+    head[0] = NET_STATE;
+    write32(head+1,_tick);
+    head[7] = keyframe ? STATE_KEYFRAME : 0;
+
+    Uint8* out = head+STATE_HEADER;
+    Uint16 count = 0;
+    for(auto it = _world->getObstacles().begin(); it != _world->getObstacles().end(); ++it) {
+        b2Body* body = (*it)->getRealBody();
+        if (body == nullptr || body->GetType() == b2_staticBody) {
+            continue;
+        } else if (!keyframe && !body->IsAwake()) {
+            continue;
+        }
+
+        if (count == capacity) {
+            Uint16 total = marshall(count);
+            std::memcpy(head+5,&total,sizeof(Uint16));
+            post(out-head);
+            out = head+STATE_HEADER;
+            count = 0;
+        }
+
+        BodyNetData data = (*it)->getBodyData();
+        out = write32(out,(Uint32)data.id);
+        out = writeFloat(out,data.position.x);
+        out = writeFloat(out,data.position.y);
+        out = writeFloat(out,data.angle);
+        out = writeFloat(out,data.linearVelocity.x);
+        out = writeFloat(out,data.linearVelocity.y);
+        out = writeFloat(out,data.angularVelocity);
+        *out++ = (data.awake ? BODY_AWAKE : 0) | (data.enabled ? BODY_ENABLED : 0) |
+                 (data.bullet ? BODY_BULLET : 0);
+        count++;
+        _tickBodies++;
+    }
+
+    // Always send the last packet, so that clients know the current tick
+    Uint16 total = marshall(count);
+    std::memcpy(head+5,&total,sizeof(Uint16));
+    post(out-head);
+    _tickBytes = _transport->getBytesSent()-before;
+}
+
+/**
+ * Sends the given packet to all clients.
+ *
+ * @param size  The number of bytes of the packet buffer to send
+ */
+void PhysicsServer::post(size_t size) {
+    for(auto it = _clients.begin(); it != _clients.end(); ++it) {
+        _transport->send(*it,_packet.data(),size);
+    }
+}
+
+#pragma mark -
+#pragma mark Client Constructors
+/**
+ * Creates a degenerate physics client.
+ *
+ * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an object on
+ * the heap, use one of the static constructors instead.
+ */
+PhysicsClient::PhysicsClient() :
+_server(NET_NO_PEER),
+_connected(false),
+_retry(0),
+_clock(0),
+_rtt(-1),
+_echoTick(0),
+_echoTime(0),
+_tick(0),
+_step(DEFAULT_NET_TICK),
+_smoothing(DEFAULT_NET_SMOOTHING),
+_snap(DEFAULT_NET_SNAP),
+_remapped(false),
+_corrected(0) {
+}
+
+/**
+ * Disposes all of the resources used by this client.
+ *
+ * If the client is connected, it tells the server that it is leaving. The
+ * world and transport are released, but not closed. A disposed client can
+ * be safely reinitialized.
+ */
+void PhysicsClient::dispose() {
+    if (_transport != nullptr && _connected) {
+        signal(NET_BYE);
+    }
+    _world = nullptr;
+    _transport = nullptr;
+    _server = NET_NO_PEER;
+    _connected = false;
+    _retry = 0;
+    _clock = 0;
+    _rtt = -1;
+    _echoTick = 0;
+    _echoTime = 0;
+    _tick = 0;
+    _step = DEFAULT_NET_TICK;
+    _smoothing = DEFAULT_NET_SMOOTHING;
+    _snap = DEFAULT_NET_SNAP;
+    _obstacles.clear();
+    _errors.clear();
+    _incoming.clear();
+    _records.clear();
+    _outgoing.clear();
+    _remapped = false;
+    _corrected = 0;
+}
+
+/**
+ * Initializes a client for the given world and server.
+ *
+ * The client takes over the stepping of the world. The game should call
+ * {@link #update} instead of {@link ObstacleWorld#update}. The client
+ * connects to the server on the first update.
+ *
+ * @param world     The client copy of the world
+ * @param transport The transport to the server
+ * @param server    The address of the server on the transport
+ *
+ * @return true if initialization was successful.
+ */
+bool PhysicsClient::init(const std::shared_ptr<ObstacleWorld>& world,
+                         const std::shared_ptr<NetTransport>& transport, Uint32 server) {
+    CUAssertLog(_world == nullptr, "Client is already initialized");
+    if (world == nullptr || transport == nullptr || server == NET_NO_PEER) {
+        return false;
+    }
+    _world = world;
+    _transport = transport;
+    _server = server;
+    return true;
+}
+
+#pragma mark -
+#pragma mark Client Simulation
+/**
+ * Advances the client by the given amount of time.
+ *
+ * This applies any server states that have arrived, steps the world, and
+ * then applies the visual error to the draw bodies. If the client is not
+ * yet connected, it (re)sends its connection request. Otherwise, it sends
+ * a periodic heartbeat so that the server does not drop it.
+ *
+ * @param dt    The elapsed time in seconds
+ */
+void PhysicsClient::update(float dt) {
+    heartbeat(dt);
+    _corrected = 0;
+    _remapped = false;
+    receive();
+    _world->update(dt);
+    smooth(dt);
+}
+
+/**
+ * Advances the client clock, and sends a connection request or heartbeat if due.
+ *
+ * @param dt    The elapsed time in seconds
+ */
+void PhysicsClient::heartbeat(float dt) {
+    _clock += dt;
+    _retry -= dt;
+    if (_retry <= 0) {
+        signal(_connected ? NET_ALIVE : NET_HELLO);
+        _retry = (_connected ? NET_HEARTBEAT : NET_RETRY);
+    }
+}
+
+/**
+ * Processes all of the packets received from the server.
+ */
+void PhysicsClient::receive() {
+    Uint32 peer;
+    while (_transport->receive(peer,_incoming)) {
+        if (peer != _server) {
+            // Only the server is remembered by the transport
+            _transport->removePeer(peer);
+            continue;
+        } else if (_incoming.empty()) {
+            continue;
+        }
+        switch (_incoming[0]) {
+            case NET_WELCOME:
+                if (_incoming.size() >= WELCOME_SIZE) {
+                    const Uint8* in = _incoming.data()+1;
+                    Uint32 tick = read32(in);
+                    _step = readFloat(in);
+                    _tick = std::max(_tick,tick);
+                    _connected = true;
+                    measure(tick,read32(in));
+                }
+                break;
+            case NET_ALIVE:
+                if (_incoming.size() >= ECHO_SIZE) {
+                    const Uint8* in = _incoming.data()+1;
+                    Uint32 tick = read32(in);
+                    measure(tick,read32(in));
+                }
+                break;
+            case NET_STATE:
+                // A state implies the welcome was sent, even if it was lost
+                _connected = true;
+                apply(_incoming.data(),_incoming.size());
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+/**
+ * Records an echo of the client clock from the server.
+ *
+ * @param tick  The server tick when the echo was sent
+ * @param sent  The client clock (in milliseconds) that was echoed
+ */
+void PhysicsClient::measure(Uint32 tick, Uint32 sent) {
+    // Unsigned arithmetic handles the wrap of the millisecond clock
+    float sample = ((Uint32)(_clock*1000)-sent)/1000.0f;
+    _rtt = (_rtt < 0 ? sample : _rtt+NET_RTT_WEIGHT*(sample-_rtt));
+    if (tick >= _echoTick) {
+        _echoTick = tick;
+        _echoTime = _clock;
+    }
+}
+
+/**
+ * Applies a state packet from the server.
+ *
+ * @param data  The packet payload
+ * @param size  The number of bytes in the payload
+ */
+void PhysicsClient::apply(const Uint8* data, size_t size) {
+    Uint32 tick;
+    if (!decode(data,size,tick) || tick < _tick) {
+        return;
+    }
+    _tick = tick;
+
+    for(auto it = _records.begin(); it != _records.end(); ++it) {
+        Obstacle* obstacle = lookup(it->id);
+        b2Body* body = (obstacle != nullptr ? obstacle->getRealBody() : nullptr);
+        if (body != nullptr) {
+            correct(body,*it);
+        }
+    }
+}
+
+/**
+ * Decodes a state packet from the server into {@link #_records}.
+ *
+ * This method returns false if the packet is malformed.
+ *
+ * @param data  The packet payload
+ * @param size  The number of bytes in the payload
+ * @param tick  The server tick of the state
+ *
+ * @return true if the packet was decoded.
+ */
+bool PhysicsClient::decode(const Uint8* data, size_t size, Uint32& tick) {
+    _records.clear();
+    if (size < STATE_HEADER) {
+        return false;
+    }
+    const Uint8* in = data+1;
+    tick = read32(in);
+    Uint16 count;
+    std::memcpy(&count,in,sizeof(Uint16));
+    count = marshall(count);
+    if (size < STATE_HEADER+(size_t)count*STATE_RECORD) {
+        return false;
+    }
+
+    in = data+STATE_HEADER;
+    _records.resize(count);
+    for(auto it = _records.begin(); it != _records.end(); ++it) {
+        it->id = read32(in);
+        it->position.x = readFloat(in);
+        it->position.y = readFloat(in);
+        it->angle = readFloat(in);
+        it->linear.x = readFloat(in);
+        it->linear.y = readFloat(in);
+        it->angular = readFloat(in);
+        Uint8 flags = *in++;
+        it->awake = (flags & BODY_AWAKE) != 0;
+        it->enabled = (flags & BODY_ENABLED) != 0;
+        it->bullet = (flags & BODY_BULLET) != 0;
+    }
+    return true;
+}
+
+/**
+ * Sends the given inputs to the server.
+ *
+ * The inputs are for consecutive ticks, starting at the given one. Inputs
+ * that do not fit in a single packet are not sent.
+ *
+ * @param first     The tick of the first input
+ * @param inputs    The inputs in tick order
+ */
+void PhysicsClient::submit(Uint32 first, const std::vector<const std::vector<Uint8>*>& inputs) {
+    _outgoing.resize(NET_MAX_PACKET);
+    Uint8* head = _outgoing.data();
+    head[0] = NET_INPUT;
+    write32(head+1,first);
+
+    Uint8* out = head+INPUT_HEADER;
+    Uint8 count = 0;
+    for(auto it = inputs.begin(); it != inputs.end() && count < 255; ++it) {
+        size_t length = std::min((*it)->size(),(size_t)255);
+        if (out+1+length > head+NET_MAX_PACKET) {
+            break;
+        }
+        *out++ = (Uint8)length;
+        if (length > 0) {
+            std::memcpy(out,(*it)->data(),length);
+        }
+        out += length;
+        count++;
+    }
+    head[5] = count;
+    _transport->send(_server,head,out-head);
+}
+
+/**
+ * Applies the given server state to a real body at the present time.
+ *
+ * The difference between the old and the new pose is added to the visual
+ * error of the body.
+ *
+ * @param body  The real body
+ * @param state The server state of the body
+ */
+void PhysicsClient::correct(b2Body* body, const Record& state) {
+    b2Vec2 prev = body->GetPosition();
+    float turn = body->GetAngle();
+    body->SetTransform(state.position,state.angle);
+    body->SetLinearVelocity(state.linear);
+    body->SetAngularVelocity(state.angular);
+    if (body->IsEnabled() != state.enabled) {
+        body->SetEnabled(state.enabled);
+    }
+    if (body->IsBullet() != state.bullet) {
+        body->SetBullet(state.bullet);
+    }
+    body->SetAwake(state.awake);
+    _corrected++;
+    blend(state.id,prev-state.position,turn-state.angle);
+}
+
+/**
+ * Adds the given pose difference to the visual error of a body.
+ *
+ * The error is dropped (so the body snaps) if it exceeds the snap distance.
+ *
+ * @param id        The obstacle id
+ * @param offset    The position difference (old minus new)
+ * @param angle     The angle difference (old minus new)
+ */
+void PhysicsClient::blend(Uint32 id, const b2Vec2& offset, float angle) {
+    if (_smoothing <= 0) {
+        return;
+    }
+    auto it = _errors.find(id);
+    if (it == _errors.end()) {
+        it = _errors.emplace(id,Correction()).first;
+        it->second.offset.setZero();
+        it->second.angle = 0;
+    }
+    Correction& error = it->second;
+    error.offset.x += offset.x;
+    error.offset.y += offset.y;
+    error.angle = std::remainder(error.angle+angle,(float)(2*M_PI));
+    if (error.offset.lengthSquared() > _snap*_snap) {
+        _errors.erase(it);
+    }
+}
+
+/**
+ * Applies the decaying visual error to the draw bodies.
+ *
+ * @param dt    The elapsed time in seconds
+ */
+void PhysicsClient::smooth(float dt) {
+    if (_errors.empty()) {
+        return;
+    }
+    float decay = (_smoothing > 0 ? expf(-dt/_smoothing) : 0);
+    for(auto it = _errors.begin(); it != _errors.end(); ) {
+        Obstacle* obstacle = lookup(it->first);
+        b2Body* draw = (obstacle != nullptr ? obstacle->getDrawBody() : nullptr);
+        if (draw == nullptr) {
+            it = _errors.erase(it);
+            continue;
+        }
+
+        // The next world update resyncs the draw body, so this never accumulates
+        Correction& error = it->second;
+        b2Vec2 pos = draw->GetPosition();
+        draw->SetTransform(b2Vec2(pos.x+error.offset.x,pos.y+error.offset.y),
+                           draw->GetAngle()+error.angle);
+        error.offset *= decay;
+        error.angle *= decay;
+        if (error.offset.lengthSquared() < NET_SETTLED*NET_SETTLED && fabsf(error.angle) < NET_SETTLED) {
+            it = _errors.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+/**
+ * Returns the obstacle with the given id, or nullptr if there is none.
+ *
+ * @param id    The obstacle id
+ *
+ * @return the obstacle with the given id.
+ */
+Obstacle* PhysicsClient::lookup(Uint32 id) {
+    const std::vector<std::shared_ptr<Obstacle>>& objects = _world->getObstacles();
+    size_t index = locate(id);
+    return (index < objects.size() ? objects[index].get() : nullptr);
+}
+
+/**
+ * Returns the index of the obstacle with the given id in the world.
+ *
+ * If there is no such obstacle, this returns the number of obstacles.
+ *
+ * @param id    The obstacle id
+ *
+ * @return the index of the obstacle with the given id in the world.
+ */
+size_t PhysicsClient::locate(Uint32 id) {
+    const std::vector<std::shared_ptr<Obstacle>>& objects = _world->getObstacles();
+    auto it = _obstacles.find(id);
+    if (it != _obstacles.end() && it->second < objects.size() && objects[it->second]->getId() == id) {
+        return it->second;
+    } else if (_remapped) {
+        return objects.size();
+    }
+
+    // The world changed, so rebuild the index (at most once an update)
+    _remapped = true;
+    _obstacles.clear();
+    for(size_t ii = 0; ii < objects.size(); ii++) {
+        _obstacles[(Uint32)objects[ii]->getId()] = ii;
+    }
+    it = _obstacles.find(id);
+    return (it != _obstacles.end() ? it->second : objects.size());
+}
+
+/**
+ * Sends a message with the client clock to the server.
+ *
+ * @param type  The message type
+ */
+void PhysicsClient::signal(Uint8 type) {
+    Uint8 message[SIGNAL_SIZE];
+    message[0] = type;
+    write32(message+1,(Uint32)(_clock*1000));
+    _transport->send(_server,message,SIGNAL_SIZE);
+}
@@ -0,0 +1,226 @@
+//
+//  CUProfilerNode.cpp
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides a scene graph node to display a physics profiler. It
+//  draws a bar graph of the recent frames, with each bar divided into the
+//  major phases of the physics step. If it has a font, it also displays the
+//  average and p95 times together with the world population counts. It is
+//  intended as a debugging overlay on top of a game scene.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#include <cugl/physics2/CUProfilerNode.h>
+#include <cugl/render/CUSpriteBatch.h>
+#include <cugl/util/CUStrings.h>
+#include <algorithm>
+
+using namespace cugl;
+using namespace cugl::physics2;
+
+/** The number of phases in each bar */
+#define PHASE_COUNT 4
+/** The margin of the summary text */
+#define TEXT_MARGIN 4.0f
+
+/** The phases of each bar, from bottom to top */
+static float ObstacleWorld::Profile::* const PHASES[PHASE_COUNT] = {
+    &ObstacleWorld::Profile::collide,
+    &ObstacleWorld::Profile::solve,
+    &ObstacleWorld::Profile::solveTOI,
+    &ObstacleWorld::Profile::sync
+};
+
+/** The colors of each phase */
+static const Color4 PHASE_COLORS[PHASE_COUNT] = {
+    Color4(255, 196,  64),
+    Color4( 64, 196, 255),
+    Color4(255,  96,  96),
+    Color4(128, 255, 128)
+};
+
+#pragma mark Constructors
+/**
+ * Creates an uninitialized node.
+ *
+ * You must initialize this node before use.
+ *
+ * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate a Node on the
+ * heap, use one of the static constructors instead.
+ */
+ProfilerNode::ProfilerNode() : SceneNode(),
+_budget(DEFAULT_PROFILE_BUDGET) {
+    _classname = "ProfilerNode";
+}
+
+/**
+ * Disposes all of the resources used by this node.
+ *
+ * A disposed Node can be safely reinitialized. Any children owned by this
+ * node will be released. They will be deleted if no other object owns them.
+ *
+ * It is unsafe to call this on a Node that is still currently inside of
+ * a scene graph.
+ */
+void ProfilerNode::dispose() {
+    _profiler = nullptr;
+    _font = nullptr;
+    _budget = DEFAULT_PROFILE_BUDGET;
+    SceneNode::dispose();
+}
+
+/**
+ * Initializes a node to display the given profiler with the given font.
+ *
+ * The font is used to display the summary text. If it is nullptr, the
+ * node will only display the bar graph.
+ *
+ * @param profiler  The profiler to display
+ * @param size      The content size of the node
+ * @param font      The font for the summary text
+ *
+ * @return true if initialization was successful.
+ */
+bool ProfilerNode::initWithFont(const std::shared_ptr<PhysicsProfiler>& profiler, const Size size,
+                                const std::shared_ptr<Font>& font) {
+    if (profiler == nullptr) {
+        return false;
+    } else if (!SceneNode::initWithBounds(size)) {
+        return false;
+    }
+    _profiler = profiler;
+    _font = font;
+    _tintColor = Color4(0,0,0,160);
+    return true;
+}
+
+/**
+ * Performs a shallow copy of this Node into dst.
+ *
+ * No children from this node are copied, and no children of dst are
+ * modified. In addition, the parents of both Nodes are unchanged. However,
+ * all other attributes of this node are copied. The profiler and font are
+ * shared, not copied.
+ *
+ * @param dst   The Node to copy into
+ *
+ * @return A reference to dst for chaining.
+ */
+std::shared_ptr<scene2::SceneNode> ProfilerNode::copy(const std::shared_ptr<SceneNode>& dst) const {
+    SceneNode::copy(dst);
+    std::shared_ptr<ProfilerNode> node = std::dynamic_pointer_cast<ProfilerNode>(dst);
+    if (node) {
+        node->_profiler = _profiler;
+        node->_font = _font;
+        node->_budget = _budget;
+    }
+    return dst;
+}
+
+#pragma mark -
+#pragma mark Rendering
+/**
+ * Draws this Node via the given SpriteBatch.
+ *
+ * This method draws the background, the bar graph and (if there is a
+ * font) the summary text of the profiler.
+ *
+ * @param batch     The SpriteBatch to draw with.
+ * @param transform The global transformation matrix.
+ * @param tint      The tint to blend with the Node color.
+ */
+void ProfilerNode::draw(const std::shared_ptr<SpriteBatch>& batch,
+                        const Affine2& transform, Color4 tint) {
+    if (_profiler == nullptr || _budget <= 0) {
+        return;
+    }
+
+    batch->setTexture(nullptr);
+    batch->setColor(tint);
+    batch->fill(Rect(Vec2::ZERO,_contentSize),Vec2::ZERO,transform);
+
+    // One bar per frame in the window, most recent on the right
+    size_t count  = _profiler->getCount();
+    float width  = _contentSize.width/_profiler->getWindow();
+    float scale  = _contentSize.height/_budget;
+    float offset = _contentSize.width-count*width;
+    for(int jj = 0; jj < PHASE_COUNT; jj++) {
+        Color4 color = PHASE_COLORS[jj];
+        color.a = tint.a;
+        batch->setColor(color);
+        for(size_t ii = 0; ii < count; ii++) {
+            const ObstacleWorld::Profile& frame = _profiler->getFrame(ii);
+            float bottom = 0;
+            for(int kk = 0; kk < jj; kk++) {
+                bottom += frame.*PHASES[kk];
+            }
+            bottom = std::min(bottom*scale,_contentSize.height);
+            float top = std::min(bottom+(frame.*PHASES[jj])*scale,_contentSize.height);
+            if (top > bottom) {
+                Rect bar(offset+ii*width,bottom,width,top-bottom);
+                batch->fill(bar,Vec2::ZERO,transform);
+            }
+        }
+    }
+
+    if (_font == nullptr || count == 0) {
+        return;
+    }
+
+    ObstacleWorld::Profile average = _profiler->getAverage();
+    ObstacleWorld::Profile p95 = _profiler->getPercentile(95);
+    std::string lines[3];
+    lines[0] = "step "+strtool::to_string(average.step,2)+" ms (p95 "+
+               strtool::to_string(p95.step,2)+" ms)";
+    lines[1] = "collide "+strtool::to_string(average.collide,2)+
+               " solve "+strtool::to_string(average.solve,2)+
+               " toi "+strtool::to_string(average.solveTOI,2)+
+               " sync "+strtool::to_string(average.sync,2);
+    lines[2] = "bodies "+strtool::to_string(average.bodies)+
+               " awake "+strtool::to_string(average.awake)+
+               " islands "+strtool::to_string(average.islands)+
+               " contacts "+strtool::to_string(average.contacts)+
+               " proxies "+strtool::to_string(average.proxies)+
+               " tois "+strtool::to_string(average.tois);
+
+    Color4 color = Color4::WHITE;
+    color.a = tint.a;
+    batch->setColor(color);
+    float height = (float)_font->getHeight();
+    Vec2 baseline(TEXT_MARGIN,_contentSize.height-TEXT_MARGIN-_font->getAscent());
+    for(int ii = 0; ii < 3; ii++) {
+        batch->drawText(lines[ii],_font,-baseline,transform);
+        baseline.y -= height;
+    }
+}
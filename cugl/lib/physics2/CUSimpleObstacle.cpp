@@ -300,8 +300,9 @@ BodyNetData SimpleObstacle::getBodyData() {
     data.awake = _realbody->IsAwake();
     data.bullet = _realbody->IsBullet();
     data.linearVelocity = _realbody->GetLinearVelocity();
+    data.angularVelocity = _realbody->GetAngularVelocity();
     data.sleepingAllowed = _realbody->IsSleepingAllowed();
-    data.fixedRotation = _realbody->GetGravityScale();
+    data.fixedRotation = _realbody->IsFixedRotation();
     data.gravityScale = _realbody->GetGravityScale();
     data.angularDamping = _realbody->GetAngularDamping();
     data.linearDamping = _realbody->GetLinearDamping();
@@ -315,6 +316,7 @@ void SimpleObstacle::setBodyFromData(BodyNetData data) {
     _realbody->SetAwake(data.awake);
     _realbody->SetBullet(data.bullet);
     _realbody->SetLinearVelocity(data.linearVelocity);
+    _realbody->SetAngularVelocity(data.angularVelocity);
     _realbody->SetSleepingAllowed(data.sleepingAllowed);
     _realbody->SetFixedRotation(data.fixedRotation);
     _realbody->SetGravityScale(data.gravityScale);
@@ -0,0 +1,335 @@
+//
+//  CUUDPTransport.cpp
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides a UDP implementation of the networked physics
+//  transport. It wraps a single non-blocking IPv4 datagram socket. Remote
+//  peers are assigned integer addresses as they are added (or as they first
+//  send a packet), so that sessions never need to deal with socket addresses.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+// Winsock must come before windows.h, which CUGL includes on Windows
+#if defined (_WIN32)
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+    #pragma comment(lib, "Ws2_32.lib")
+    typedef int socklen_t;
+    #define INVALID_SOCKET_ID   ((intptr_t)INVALID_SOCKET)
+    #define SOCKET_HANDLE(s)    ((SOCKET)(s))
+#else
+    #include <sys/types.h>
+    #include <sys/socket.h>
+    #include <netinet/in.h>
+    #include <arpa/inet.h>
+    #include <netdb.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #define INVALID_SOCKET_ID   ((intptr_t)-1)
+    #define SOCKET_HANDLE(s)    ((int)(s))
+#endif
+#include <cugl/physics2/CUUDPTransport.h>
+#include <cugl/util/CUDebug.h>
+#include <cstring>
+
+using namespace cugl;
+using namespace cugl::physics2;
+
+/** The size of the receive buffer (the largest UDP payload) */
+#define UDP_MAX_DATAGRAM    65507
+
+#if defined (_WIN32)
+/** The number of open UDP transports (Winsock is started by the first one) */
+static int winsock_count = 0;
+#endif
+
+#pragma mark -
+#pragma mark Constructors
+/**
+ * Creates a degenerate UDP transport with no socket.
+ *
+ * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an object on
+ * the heap, use one of the static constructors instead.
+ */
+UDPTransport::UDPTransport() : NetTransport(),
+_socket(INVALID_SOCKET_ID),
+_port(0) {
+}
+
+/**
+ * Closes this transport, releasing all resources.
+ *
+ * The socket is closed, and all peers are forgotten.
+ */
+void UDPTransport::close() {
+    if (_socket != INVALID_SOCKET_ID) {
+#if defined (_WIN32)
+        closesocket(SOCKET_HANDLE(_socket));
+        if (--winsock_count == 0) {
+            WSACleanup();
+        }
+#else
+        ::close(SOCKET_HANDLE(_socket));
+#endif
+        _socket = INVALID_SOCKET_ID;
+    }
+    _port = 0;
+    _hosts.clear();
+    _ports.clear();
+    _peers.clear();
+    _unused.clear();
+    _buffer.clear();
+}
+
+/**
+ * Initializes a transport bound to the given port.
+ *
+ * If the port is 0, the socket is bound to an ephemeral port.
+ *
+ * @param port  The port to bind
+ *
+ * @return true if initialization was successful.
+ */
+bool UDPTransport::init(Uint16 port) {
+    CUAssertLog(_socket == INVALID_SOCKET_ID, "Transport is already initialized");
+#if defined (_WIN32)
+    if (winsock_count == 0) {
+        WSADATA data;
+        if (WSAStartup(MAKEWORD(2,2),&data) != 0) {
+            CULogError("Could not start Winsock");
+            return false;
+        }
+    }
+    winsock_count++;
+    SOCKET handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    _socket = (intptr_t)handle;
+#else
+    _socket = (intptr_t)socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+#endif
+    if (_socket == INVALID_SOCKET_ID) {
+        CULogError("Could not create a UDP socket");
+#if defined (_WIN32)
+        if (--winsock_count == 0) {
+            WSACleanup();
+        }
+#endif
+        return false;
+    }
+
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    bool success = bind(SOCKET_HANDLE(_socket), (sockaddr*)&addr, sizeof(addr)) == 0;
+
+    socklen_t length = sizeof(addr);
+    success = success && getsockname(SOCKET_HANDLE(_socket), (sockaddr*)&addr, &length) == 0;
+#if defined (_WIN32)
+    u_long mode = 1;
+    success = success && ioctlsocket(SOCKET_HANDLE(_socket), FIONBIO, &mode) == 0;
+#else
+    int flags = fcntl(SOCKET_HANDLE(_socket), F_GETFL, 0);
+    success = success && flags != -1 && fcntl(SOCKET_HANDLE(_socket), F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+    if (!success) {
+        CULogError("Could not bind a UDP socket to port %d", port);
+        close();
+        return false;
+    }
+
+    _port = ntohs(addr.sin_port);
+    _buffer.resize(UDP_MAX_DATAGRAM);
+    return true;
+}
+
+#pragma mark -
+#pragma mark Peers
+/**
+ * Returns the peer address for the given host and port, adding it if necessary.
+ *
+ * @param host  The IPv4 address in network order
+ * @param port  The port in network order
+ *
+ * @return the peer address for the given host and port
+ */
+Uint32 UDPTransport::lookup(Uint32 host, Uint16 port) {
+    Uint64 key = ((Uint64)host << 16) | port;
+    auto it = _peers.find(key);
+    if (it != _peers.end()) {
+        return it->second;
+    }
+    Uint32 result;
+    if (_unused.empty()) {
+        result = (Uint32)_hosts.size();
+        _hosts.push_back(host);
+        _ports.push_back(port);
+    } else {
+        result = _unused.back();
+        _unused.pop_back();
+        _hosts[result] = host;
+        _ports[result] = port;
+    }
+    _peers.emplace(key,result);
+    return result;
+}
+
+/**
+ * Forgets the given peer.
+ *
+ * The address may be reused for a later peer. Nothing can be sent to
+ * the address until then.
+ *
+ * @param peer  The address of the peer to forget
+ */
+void UDPTransport::removePeer(Uint32 peer) {
+    if (peer >= _hosts.size() || _ports[peer] == 0) {
+        return;
+    }
+    _peers.erase(((Uint64)_hosts[peer] << 16) | _ports[peer]);
+    _hosts[peer] = 0;
+    _ports[peer] = 0;
+    _unused.push_back(peer);
+}
+
+/**
+ * Returns the peer address for the given host and port.
+ *
+ * The host may be a numeric IPv4 address or a host name. The peer is added
+ * if it is not already known. This method returns NET_NO_PEER if the host
+ * cannot be resolved.
+ *
+ * @param host  The host name or IPv4 address
+ * @param port  The port of the host
+ *
+ * @return the peer address for the given host and port.
+ */
+Uint32 UDPTransport::addPeer(const std::string& host, Uint16 port) {
+    if (_socket == INVALID_SOCKET_ID) {
+        return NET_NO_PEER;
+    }
+
+    addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    addrinfo* info = nullptr;
+    if (getaddrinfo(host.c_str(), nullptr, &hints, &info) != 0 || info == nullptr) {
+        CULogError("Could not resolve host '%s'", host.c_str());
+        return NET_NO_PEER;
+    }
+    Uint32 addr = ((sockaddr_in*)info->ai_addr)->sin_addr.s_addr;
+    freeaddrinfo(info);
+    return lookup(addr,htons(port));
+}
+
+#pragma mark -
+#pragma mark Communication
+/**
+ * Returns true if this transport is open.
+ *
+ * @return true if this transport is open.
+ */
+bool UDPTransport::isOpen() const {
+    return _socket != INVALID_SOCKET_ID;
+}
+
+/**
+ * Sends a packet to the given peer.
+ *
+ * This method returns true if the packet was handed off to the socket.
+ * That is no guarantee that the packet will arrive.
+ *
+ * @param peer  The address of the destination peer
+ * @param data  The packet payload
+ * @param size  The number of bytes in the payload
+ *
+ * @return true if the packet was sent.
+ */
+bool UDPTransport::send(Uint32 peer, const Uint8* data, size_t size) {
+    if (_socket == INVALID_SOCKET_ID || peer >= _hosts.size() || _ports[peer] == 0) {
+        return false;
+    }
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = _hosts[peer];
+    addr.sin_port = _ports[peer];
+#if defined (_WIN32)
+    int sent = sendto(SOCKET_HANDLE(_socket), (const char*)data, (int)size, 0, (sockaddr*)&addr, sizeof(addr));
+#else
+    ssize_t sent = sendto(SOCKET_HANDLE(_socket), data, size, 0, (sockaddr*)&addr, sizeof(addr));
+#endif
+    if (sent < 0 || (size_t)sent != size) {
+        return false;
+    }
+    _packetsSent++;
+    _bytesSent += size;
+    return true;
+}
+
+/**
+ * Receives the next available packet, if any.
+ *
+ * The payload is stored in data, which is resized to fit. This method
+ * returns false immediately if there is no packet available.
+ *
+ * @param peer  The address of the source peer
+ * @param data  The buffer to store the payload
+ *
+ * @return true if a packet was received.
+ */
+bool UDPTransport::receive(Uint32& peer, std::vector<Uint8>& data) {
+    if (_socket == INVALID_SOCKET_ID) {
+        return false;
+    }
+    sockaddr_in addr;
+    socklen_t length = sizeof(addr);
+#if defined (_WIN32)
+    int amount = recvfrom(SOCKET_HANDLE(_socket), (char*)_buffer.data(), (int)_buffer.size(), 0,
+                          (sockaddr*)&addr, &length);
+#else
+    ssize_t amount = recvfrom(SOCKET_HANDLE(_socket), _buffer.data(), _buffer.size(), 0,
+                              (sockaddr*)&addr, &length);
+#endif
+    // Would block (or an error, which a datagram socket can recover from)
+    if (amount < 0 || addr.sin_family != AF_INET) {
+        return false;
+    }
+    peer = lookup(addr.sin_addr.s_addr,addr.sin_port);
+    data.assign(_buffer.begin(),_buffer.begin()+amount);
+    _packetsReceived++;
+    _bytesReceived += amount;
+    return true;
+}
@@ -45,7 +45,6 @@
 
 #include <deque>
 #include <algorithm>
-#include <utf8/utf8.h>
 #include <cugl/util/CUDebug.h>
 #include <cugl/util/CUFiletools.h>
 #include <cugl/util/CUStrings.h>
@@ -67,6 +66,11 @@ using namespace cugl;
 /** The number of spaces to a tab character */
 #define TAB_SPACE       4
 
+/** The code point limit of the direct-indexed glyph table (the BMP) */
+#define GLYPH_TABLE_LIMIT   0x10000
+/** The largest character set with a dense kerning matrix (2 MB) */
+#define KERN_TABLE_LIMIT    1024
+
 /**
  * Returns true if thechar is a Unicode control character
  *
@@ -184,10 +188,10 @@ bool Font::Atlas::hasGlyphs(const std::string& glyphs) const {
     const char* begin = glyphs.c_str();
     const char* check = glyphs.c_str();
     const char* end   = begin+glyphs.size();
-    CUAssertLog(utf8::find_invalid(check, end) == end, "String '%s' has an invalid UTF-8 encoding",begin);
+    CUAssertLog(strtool::isValidUTF8(check, end), "String '%s' has an invalid UTF-8 encoding",begin);
     
     while (begin != end) {
-        if (!hasGlyph(utf8::next(begin, end))) { return false; }
+        if (!hasGlyph(strtool::nextCodePoint(begin, end))) { return false; }
     }
     return true;
 }
@@ -651,6 +655,9 @@ void Font::dispose() {
     _kernmap.clear();
     _atlases.clear();
     _atlasmap.clear();
+    _glyphindex.clear();
+    _glyphtable.clear();
+    _kerntable.clear();
 }
 
 /**
@@ -712,7 +719,7 @@ bool Font::init(const std::string file, Uint32 size) {
  * @return true if this font has a glyph for the given (UNICODE) character.
  */
 bool Font::hasGlyph(Uint32 a) const {
-    return a == TAB_CHAR || TTF_GlyphIsProvided(_data, a) != 0;
+    return a == TAB_CHAR || findMetrics(a) != nullptr || TTF_GlyphIsProvided(_data, a) != 0;
 }
 
 /**
@@ -734,10 +741,10 @@ bool Font::hasGlyphs(const std::string text) const {
     const char* begin = text.c_str();
     const char* check = text.c_str();
     const char* end   = begin+text.size();
-    CUAssertLog(utf8::find_invalid(check, end) == end, "String '%s' has an invalid UTF-8 encoding",begin);
+    CUAssertLog(strtool::isValidUTF8(check, end), "String '%s' has an invalid UTF-8 encoding",begin);
     
     while (begin != end) {
-        if (!hasGlyph(utf8::next(begin, end))) { return false; }
+        if (!hasGlyph(strtool::nextCodePoint(begin, end))) { return false; }
     }
     return true;
 }
@@ -851,8 +858,9 @@ void Font::setPadding(Uint32 padding) {
  * @return the glyph metrics for the given (Unicode) character.
  */
 const Font::Metrics Font::getMetrics(Uint32 thechar) const {
-    if (_glyphsize.find(thechar) != _glyphsize.end()) {
-        return _glyphsize.at(thechar);
+    const Metrics* cached = findMetrics(thechar);
+    if (cached != nullptr) {
+        return *cached;
     }
     
     if (thechar == TAB_CHAR) {
@@ -887,8 +895,8 @@ const Font::Metrics Font::getMetrics(Uint32 thechar) const {
  * @return the kerning adjustment between the two (Unicode) characters.
  */
 unsigned int Font::getKerning(Uint32 a, Uint32 b) const {
-    if (_glyphsize.find(a) != _glyphsize.end() && _glyphsize.find(b) != _glyphsize.end()) {
-        return _kernmap.at(a).at(b);
+    if (findMetrics(a) != nullptr && findMetrics(b) != nullptr) {
+        return findKerning(a, b);
     }
 
     if (is_control(a) || is_control(b)) {
@@ -960,14 +968,18 @@ Size Font::getSize(const char* substr, const char* end) const {
     
     const char* begin = substr;
     Uint32 prvchar = 0;
+    bool cached = false;
     while (begin != end) {
-        Uint32 thechar = utf8::next(begin,end);
-        if (_glyphsize.find(thechar) != _glyphsize.end()) {
-            if (prvchar > 0 && _glyphsize.find(prvchar) != _glyphsize.end()) {
-                result.width -= _kernmap.at(prvchar).at(thechar);
+        Uint32 thechar = strtool::nextCodePoint(begin,end);
+        const Metrics* metrics = findMetrics(thechar);
+        if (metrics != nullptr) {
+            if (prvchar > 0 && cached) {
+                result.width -= findKerning(prvchar,thechar);
             }
-            result.width += _glyphsize.at(thechar).advance;
+            result.width += metrics->advance;
+            cached = true;
         } else {
+            cached = false;
             if (prvchar > 0) {
                 result.width -= computeKerning(prvchar,thechar);
             }
@@ -1064,9 +1076,10 @@ Rect Font::getInternalBounds(const char* substr, const char* end) const {
     // First character
     const char* begin = substr;
     while(first == 0 && begin != end) {
-        Uint32 ch = utf8::next(begin,end);
+        Uint32 ch = strtool::nextCodePoint(begin,end);
         if (hasGlyph(ch)) {
-            metrics = (_glyphsize.find(ch) != _glyphsize.end() ? _glyphsize.at(ch) : computeMetrics(ch));
+            const Metrics* cached = findMetrics(ch);
+            metrics = (cached != nullptr ? *cached : computeMetrics(ch));
             result.origin.x = (float)metrics.minx;
             result.size.width = (float)(metrics.advance-metrics.minx);
             maxy = (metrics.maxy > maxy ? metrics.maxy : maxy);
@@ -1082,11 +1095,11 @@ Rect Font::getInternalBounds(const char* substr, const char* end) const {
     // Later characters
     last = first;
     while (begin != end) {
-        Uint32 ch = utf8::next(begin,end);
+        Uint32 ch = strtool::nextCodePoint(begin,end);
         if (hasGlyph(ch)) {
-            bool present = _glyphsize.find(ch) != _glyphsize.end();
-            result.size.width -= (present ? _kernmap.at(last).at(ch) : computeKerning(last, ch));
-            metrics = (present ? _glyphsize.at(ch) : computeMetrics(ch));
+            const Metrics* cached = findMetrics(ch);
+            result.size.width -= (cached != nullptr ? findKerning(last, ch) : computeKerning(last, ch));
+            metrics = (cached != nullptr ? *cached : computeMetrics(ch));
             result.size.width += metrics.advance;
             maxy = (metrics.maxy > maxy ? metrics.maxy : maxy);
             miny = (metrics.miny < miny ? metrics.miny : miny);
@@ -1170,6 +1183,50 @@ std::vector<int> Font::getTracking(const std::string text, float width) {
  * @return the tracking adjustments to fit the text in the given width
  */
 std::vector<int> Font::getTracking(const char* substr, const char* end, float width) {
+    std::vector<int> result;
+    getTracking(result, substr, end, width);
+    return result;
+}
+
+/**
+ * Stores the tracking adjustments to fit the text in the given vector
+ *
+ * Unlike kerning, tracking is used to dynamically adjust the spaces between
+ * characters. The purpose is to fix the text to the given width exactly (or
+ * as close as possible).  Usually this means shrinking the space when the
+ * text is larger than the width.  But in the case of justification, it may
+ * also be used to increase the space. The number of tracking measurements
+ * is one less than the number of characters.
+ *
+ * All tracking is measured in integer offsets. That is because text looks
+ * more uniform when glyph positions are at integral values (otherwise the
+ * texture may shimmer on movement). Whenever possible, the algorithm will
+ * try to track the text to within 1 unit of the width (under, not over).
+ * In the case of shrinking, this may not be possible if the shrink limit
+ * is too low.
+ *
+ * Tracking adjustments will be uniform between non-space characters. If
+ * any non-uniform adjustments need to be made, they will be made around
+ * white-space.
+ *
+ * The C-style string substr need not be null-terminated. Instead, the
+ * termination is indicated by the parameter end. This provides efficient
+ * substring processing. The string may either be in UTF8 or ASCII; the
+ * method will handle conversion automatically.
+ *
+ * The adjustments are stored in the vector adjusts, which is cleared first.
+ * As the vector keeps its capacity, this version allows a caller to compute
+ * tracking every frame without allocating.
+ *
+ * @param adjusts   The vector to store the tracking adjustments
+ * @param substr    The start of the string to measure
+ * @param end       The end of the string to measure
+ * @param width     The line width
+ *
+ * @return the number of tracking adjustments
+ */
+size_t Font::getTracking(std::vector<int>& adjusts, const char* substr, const char* end, float width) {
+    adjusts.clear();
     // Get the number of characters and the number of spaces;
     size_t length = 0;
     size_t spaces = 0;
@@ -1180,7 +1237,7 @@ std::vector<int> Font::getTracking(const char* substr, const char* end, float wi
         if (prvchar > 0 && is_whitespace(prvchar)) {
             spaces++;
         }
-        thechar = utf8::next(begin,end);
+        thechar = strtool::nextCodePoint(begin,end);
         if (is_whitespace(thechar)) {
             spaces++;
         }
@@ -1189,11 +1246,11 @@ std::vector<int> Font::getTracking(const char* substr, const char* end, float wi
     }
     
     if (length < 2) {
-        return std::vector<Sint32>();
+        return 0;
     }
 
     Size size = getSize(substr,end);
-    std::vector<Sint32> result;
+    std::vector<Sint32>& result = adjusts;
     result.reserve(length-1);
     if (size.width > width) {
         float diff = size.width-width;
@@ -1203,7 +1260,7 @@ std::vector<int> Font::getTracking(const char* substr, const char* end, float wi
         if (unit < _shrinkLimit) {
             // Shrink time
             begin = substr;
-            prvchar = utf8::next(begin,end);
+            prvchar = strtool::nextCodePoint(begin,end);
             while (begin != end) {
                 Sint32 amt = 0;
                 if (is_whitespace(prvchar)) {
@@ -1211,7 +1268,7 @@ std::vector<int> Font::getTracking(const char* substr, const char* end, float wi
                     amt += unit;
                     diff -= unit; spaces--;
                 }
-                thechar = utf8::next(begin,end);
+                thechar = strtool::nextCodePoint(begin,end);
                 if (is_whitespace(thechar)) {
                     unit = std::min(std::min((Sint32)round(diff/(spaces)),_shrinkLimit),(Sint32)diff);
                     amt += unit;
@@ -1230,7 +1287,7 @@ std::vector<int> Font::getTracking(const char* substr, const char* end, float wi
             
             // Shrink time
             begin = substr;
-            prvchar = utf8::next(begin,end);
+            prvchar = strtool::nextCodePoint(begin,end);
             while (begin != end) {
                 Sint32 amt = unit;
                 if (is_whitespace(prvchar)) {
@@ -1238,7 +1295,7 @@ std::vector<int> Font::getTracking(const char* substr, const char* end, float wi
                     amt += left;
                     diff -= left; spaces--;
                 }
-                thechar = utf8::next(begin,end);
+                thechar = strtool::nextCodePoint(begin,end);
                 if (is_whitespace(thechar)) {
                     left = std::min(std::min((Sint32)round(diff/(spaces)),_shrinkLimit-unit),(Sint32)diff);
                     amt += left;
@@ -1266,7 +1323,7 @@ std::vector<int> Font::getTracking(const char* substr, const char* end, float wi
         // Grow time
         result.reserve(length-1);
         begin = substr;
-        prvchar = utf8::next(begin,end);
+        prvchar = strtool::nextCodePoint(begin,end);
         while (begin != end) {
             Sint32 amt = unit;
             if (is_whitespace(prvchar)) {
@@ -1274,7 +1331,7 @@ std::vector<int> Font::getTracking(const char* substr, const char* end, float wi
                 amt += left;
                 diff -= left; spaces--;
             }
-            thechar = utf8::next(begin,end);
+            thechar = strtool::nextCodePoint(begin,end);
             if (is_whitespace(thechar)) {
                 left = std::min((Sint32)round(diff/(spaces)),(Sint32)diff);
                 amt += left;
@@ -1284,7 +1341,7 @@ std::vector<int> Font::getTracking(const char* substr, const char* end, float wi
             prvchar = thechar;
         }
     }
-    return result;
+    return result.size();
 }
 
 #pragma mark -
@@ -1574,6 +1631,25 @@ const std::vector<std::shared_ptr<Texture>> Font::getAtlases() {
     return result;
 }
 
+/**
+ * Returns the number of bytes used by the atlas textures.
+ *
+ * Only atlases that have been stored as OpenGL textures are counted.
+ * This value is used for memory accounting in {@link FontLoader}.
+ *
+ * @return the number of bytes used by the atlas textures.
+ */
+size_t Font::getAtlasBytes() const {
+    size_t total = 0;
+    for(auto it = _atlases.begin(); it != _atlases.end(); ++it) {
+        const std::shared_ptr<Texture>& texture = (*it)->texture;
+        if (texture != nullptr) {
+            total += (size_t)texture->getWidth()*texture->getHeight()*texture->getByteSize();
+        }
+    }
+    return total;
+}
+
 /**
  * Returns true if the given characters have atlas support.
  *
@@ -1591,10 +1667,10 @@ bool Font::hasAtlases(const std::string charset) const {
     const char* begin = charset.c_str();
     const char* check = charset.c_str();
     const char* end   = begin+charset.size();
-    CUAssertLog(utf8::find_invalid(check, end) == end, "String '%s' has an invalid UTF-8 encoding",begin);
+    CUAssertLog(strtool::isValidUTF8(check, end), "String '%s' has an invalid UTF-8 encoding",begin);
     
     while (begin != end) {
-        if (!hasAtlas(utf8::next(begin,end))) { return false; }
+        if (!hasAtlas(strtool::nextCodePoint(begin,end))) { return false; }
     }
     return true;
 }
@@ -1662,7 +1738,7 @@ bool Font::hasAtlases(const std::vector<Uint32>& charset) const {
  *
  * @return a set of glyph runs to render the given string
  */
-std::unordered_map<GLuint, std::shared_ptr<GlyphRun>> Font::getGlyphs(const std::string text, const Vec2 origin) {
+std::unordered_map<GLuint, std::shared_ptr<GlyphRun>> Font::getGlyphs(const std::string& text, const Vec2 origin) {
     std::unordered_map<GLuint, std::shared_ptr<GlyphRun>> result;
     const char* begin = text.c_str();
     const char* end = begin+text.size();
@@ -1770,7 +1846,7 @@ std::unordered_map<GLuint, std::shared_ptr<GlyphRun>> Font::getGlyphs(const char
  *
  * @return a set of glyph runs to render the given string
  */
-std::unordered_map<GLuint, std::shared_ptr<GlyphRun>> Font::getGlyphs(const std::string text, const Vec2 origin, const Rect rect, float track) {
+std::unordered_map<GLuint, std::shared_ptr<GlyphRun>> Font::getGlyphs(const std::string& text, const Vec2 origin, const Rect rect, float track) {
     std::unordered_map<GLuint, std::shared_ptr<GlyphRun>> result;
     const char* begin = text.c_str();
     const char* end = begin+text.size();
@@ -1880,7 +1956,7 @@ std::unordered_map<GLuint, std::shared_ptr<GlyphRun>> Font::getGlyphs(const char
  *
  * @return the number of glyphs successfully processed
  */
-size_t Font::getGlyphs(std::unordered_map<GLuint, std::shared_ptr<GlyphRun>>& runs, const std::string text, const Vec2 origin) {
+size_t Font::getGlyphs(std::unordered_map<GLuint, std::shared_ptr<GlyphRun>>& runs, const std::string& text, const Vec2 origin) {
     const char* begin = text.c_str();
     const char* end = begin+text.size();
     Rect bounds(origin,getSize(begin, end));
@@ -1988,7 +2064,7 @@ size_t Font::getGlyphs(std::unordered_map<GLuint, std::shared_ptr<GlyphRun>>& ru
  *
  * @return the number of glyphs successfully processed
  */
-size_t Font::getGlyphs(std::unordered_map<GLuint, std::shared_ptr<GlyphRun>>& runs, const std::string text, const Vec2 origin,
+size_t Font::getGlyphs(std::unordered_map<GLuint, std::shared_ptr<GlyphRun>>& runs, const std::string& text, const Vec2 origin,
                        const Rect rect, float track) {
     const char* begin = text.c_str();
     const char* end = begin+text.size();
@@ -2064,17 +2140,18 @@ size_t Font::getGlyphs(std::unordered_map<GLuint, std::shared_ptr<GlyphRun>>& ru
     const char* begin = substr;
     const char* check = substr;
 
-    CUAssertLog(utf8::find_invalid(check, end) == end, "String '%s' has an invalid UTF-8 encoding",begin);
-    std::vector<Sint32> adjusts;
+    CUAssertLog(strtool::isValidUTF8(check, end), "String '%s' has an invalid UTF-8 encoding",begin);
+    static thread_local std::vector<Sint32> adjusts;
+    adjusts.clear();
     if (track > 0) {
-        adjusts = getTracking(substr, end, track);
+        getTracking(adjusts, substr, end, track);
     }
     size_t total = 0;
     if (_fallback) {
         // See which any characters are missing
         std::vector<Uint32> missing;
         while (begin != end) {
-            Uint32 thechar = utf8::next(begin,end);
+            Uint32 thechar = strtool::nextCodePoint(begin,end);
             if (_atlasmap.find(thechar) == _atlasmap.end()) {
                 missing.push_back(thechar);
             }
@@ -2089,9 +2166,9 @@ size_t Font::getGlyphs(std::unordered_map<GLuint, std::shared_ptr<GlyphRun>>& ru
         Uint32 prvchar = 0;
         Uint32 pos = 0;
         while (begin != end) {
-            Uint32 thechar = utf8::next(begin,end);
+            Uint32 thechar = strtool::nextCodePoint(begin,end);
             if (prvchar > 0) {
-                offset.x -= _kernmap[prvchar][thechar];
+                offset.x -= findKerning(prvchar,thechar);
                 if (track > 0 && pos < adjusts.size()) {
                     offset.x += adjusts[pos++];
                 }
@@ -2102,9 +2179,9 @@ size_t Font::getGlyphs(std::unordered_map<GLuint, std::shared_ptr<GlyphRun>>& ru
             std::shared_ptr<Atlas> atlas;
 
             bool found = false;
-            if (_atlasmap.find(thechar) != _atlasmap.end()) {
-                size_t index = _atlasmap[thechar];
-                atlas = _atlases[index];
+            auto entry = _atlasmap.find(thechar);
+            if (entry != _atlasmap.end()) {
+                atlas = _atlases[entry->second];
                 GLuint key = atlas->texture->getBuffer();
                 auto find = runs.find(key);
                 if (find == runs.end()) {
@@ -2131,7 +2208,7 @@ size_t Font::getGlyphs(std::unordered_map<GLuint, std::shared_ptr<GlyphRun>>& ru
             }
      
             if (found && atlas->getQuad(thechar,offset,grun->mesh,bounds)) {
-                grun->contents.emplace(thechar);
+                grun->contents.insert(thechar);
                 total++;
             }
         }
@@ -2140,9 +2217,9 @@ size_t Font::getGlyphs(std::unordered_map<GLuint, std::shared_ptr<GlyphRun>>& ru
         Uint32 prvchar = 0;
         Uint32 pos = 0;
         while (begin != end) {
-            Uint32 thechar = utf8::next(begin,end);
+            Uint32 thechar = strtool::nextCodePoint(begin,end);
             if (prvchar > 0) {
-                offset.x -= _kernmap[prvchar][thechar];
+                offset.x -= findKerning(prvchar,thechar);
                 if (track > 0 && pos < adjusts.size()) {
                     offset.x += adjusts[pos++];
                 }
@@ -2153,9 +2230,9 @@ size_t Font::getGlyphs(std::unordered_map<GLuint, std::shared_ptr<GlyphRun>>& ru
             std::shared_ptr<Atlas> atlas;
 
             bool found = false;
-            if (_atlasmap.find(thechar) != _atlasmap.end()) {
-                size_t index = _atlasmap[thechar];
-                atlas = _atlases[index];
+            auto entry = _atlasmap.find(thechar);
+            if (entry != _atlasmap.end()) {
+                atlas = _atlases[entry->second];
                 GLuint key = atlas->texture->getBuffer();
                 auto find = runs.find(key);
                 if (find == runs.end()) {
@@ -2169,7 +2246,7 @@ size_t Font::getGlyphs(std::unordered_map<GLuint, std::shared_ptr<GlyphRun>>& ru
             }
      
             if (found && atlas->getQuad(thechar,offset,grun->mesh,bounds)) {
-                grun->contents.emplace(thechar);
+                grun->contents.insert(thechar);
                 total++;
             }
         }
@@ -2322,7 +2399,7 @@ std::shared_ptr<GlyphRun> Font::getGlyph(Uint32 thechar, Vec2& offset, const Rec
  *
  * @return a (line) mesh of the quad outlines for the text glyphs
  */
-Mesh<SpriteVertex2> Font::getGlyphBoxes(const std::string text, const Vec2 origin) {
+Mesh<SpriteVertex2> Font::getGlyphBoxes(const std::string& text, const Vec2 origin) {
     const char* begin = text.c_str();
     const char* end = begin+text.size();
     Rect bounds(origin,getSize(begin,end));
@@ -2419,7 +2496,7 @@ Mesh<SpriteVertex2> Font::getGlyphBoxes(const char* substr, const char* end, con
  *
  * @return a (line) mesh of the quad outlines for the text glyphs
  */
-Mesh<SpriteVertex2> Font::getGlyphBoxes(const std::string text, const Vec2 origin,
+Mesh<SpriteVertex2> Font::getGlyphBoxes(const std::string& text, const Vec2 origin,
                                         const Rect rect, float track) {
     const char* begin = text.c_str();
     const char* end = begin+text.size();
@@ -2515,7 +2592,7 @@ Mesh<SpriteVertex2> Font::getGlyphBoxes(const char* substr, const char* end,
  *
  * @return the number of quads generated
  */
-size_t Font::getGlyphBoxes(Mesh<SpriteVertex2>& mesh, const std::string text, const Vec2 origin) {
+size_t Font::getGlyphBoxes(Mesh<SpriteVertex2>& mesh, const std::string& text, const Vec2 origin) {
     const char* begin = text.c_str();
     const char* end = begin+text.size();
     Rect bounds(origin,getSize(begin,end));
@@ -2614,7 +2691,7 @@ size_t Font::getGlyphBoxes(Mesh<SpriteVertex2>& mesh, const char* substr, const
  *
  * @return the number of quads generated
  */
-size_t Font::getGlyphBoxes(Mesh<SpriteVertex2>& mesh, const std::string text,
+size_t Font::getGlyphBoxes(Mesh<SpriteVertex2>& mesh, const std::string& text,
                            const Vec2 origin, const Rect rect, float track) {
     const char* begin = text.c_str();
     const char* end = begin+text.size();
@@ -2682,20 +2759,21 @@ size_t Font::getGlyphBoxes(Mesh<SpriteVertex2>& mesh, const char* substr, const
     const char* begin = substr;
     const char* check = substr;
 
-    CUAssertLog(utf8::find_invalid(check, end) == end, "String '%s' has an invalid UTF-8 encoding",begin);
-    std::vector<Sint32> adjusts;
+    CUAssertLog(strtool::isValidUTF8(check, end), "String '%s' has an invalid UTF-8 encoding",begin);
+    static thread_local std::vector<Sint32> adjusts;
+    adjusts.clear();
     if (track > 0) {
-        adjusts = getTracking(substr, end, track);
+        getTracking(adjusts, substr, end, track);
     }
     
     size_t total = 0;
     Uint32 prvchar = 0;
     Uint32 pos = 0;
     while (begin != end) {
-        Uint32 thechar = utf8::next(begin,end);
-        if (_glyphsize.find(thechar) != _glyphsize.end()) {
+        Uint32 thechar = strtool::nextCodePoint(begin,end);
+        if (findMetrics(thechar) != nullptr) {
             if (prvchar > 0) {
-                offset.x -= _kernmap[prvchar][thechar];
+                offset.x -= findKerning(prvchar,thechar);
                 if (track > 0 && pos < adjusts.size()) {
                     offset.x += adjusts[pos++];
                 }
@@ -2778,7 +2856,7 @@ std::deque<Uint32> Font::gatherGlyphs(const std::string& charset) {
     const char* begin = charset.c_str();
     const char* end = begin+charset.size();
     while (begin != end) {
-        Uint32 thechar = utf8::next(begin,end);
+        Uint32 thechar = strtool::nextCodePoint(begin,end);
         if (thechar == TAB_CHAR && _atlasmap.find(thechar) == _atlasmap.end()) {
             if (_atlasmap.find(SPACE_CHAR) == _atlasmap.end() && TTF_GlyphIsProvided(_data, SPACE_CHAR)) {
                 Metrics metrics = computeMetrics(SPACE_CHAR);
@@ -2859,11 +2937,66 @@ std::deque<Uint32> Font::gatherGlyphs(const std::vector<Uint32>& charset) {
  */
 void Font::gatherKerning(const std::deque<Uint32>& glyphs) {
     for(auto it = _glyphsize.begin(); it != _glyphsize.end(); ++it) {
-        if (_kernmap.find(it->first) == _kernmap.end()) {
-            _kernmap.emplace(it->first, std::unordered_map<Uint32, Uint32>());
-        }
+        std::unordered_map<Uint32, Uint32>& row = _kernmap[it->first];
         for(auto jt = _glyphsize.begin(); jt != _glyphsize.end(); ++jt) {
-            _kernmap[it->first].emplace(jt->first, computeKerning(it->first, jt->first));
+            // Only measure the new pairs; this is an SDL_ttf call
+            if (row.find(jt->first) == row.end()) {
+                row.emplace(jt->first, computeKerning(it->first, jt->first));
+            }
+        }
+    }
+    buildTables();
+}
+
+/**
+ * Rebuilds the direct-indexed glyph tables from the glyph maps.
+ *
+ * The glyph maps are convenient for construction, but a hash look-up per
+ * character (and per pair of characters) dominates text layout. So once
+ * the glyphs are gathered, the metrics of every glyph in the basic
+ * multilingual plane are copied to a table indexed by code point, and
+ * the kerning is copied to a dense matrix. The matrix is omitted if the
+ * character set is too large, in which case kerning uses the map.
+ */
+void Font::buildTables() {
+    _glyphindex.clear();
+    _glyphtable.clear();
+    _kerntable.clear();
+
+    // Codes in dense order
+    std::vector<Uint32> codes;
+    Uint32 limit = 0;
+    for(auto it = _glyphsize.begin(); it != _glyphsize.end(); ++it) {
+        if (it->first < GLYPH_TABLE_LIMIT) {
+            codes.push_back(it->first);
+            limit = std::max(limit,it->first+1);
+        }
+    }
+    std::sort(codes.begin(),codes.end());
+
+    _glyphindex.resize(limit,0);
+    _glyphtable.reserve(codes.size());
+    for(auto it = codes.begin(); it != codes.end(); ++it) {
+        _glyphtable.push_back(_glyphsize[*it]);
+        _glyphindex[*it] = (Uint16)_glyphtable.size();
+    }
+
+    size_t size = codes.size();
+    if (size == 0 || size > KERN_TABLE_LIMIT) {
+        return;
+    }
+    _kerntable.resize(size*size,0);
+    for(size_t ii = 0; ii < size; ii++) {
+        auto row = _kernmap.find(codes[ii]);
+        if (row == _kernmap.end()) {
+            continue;
+        }
+        Sint16* dest = _kerntable.data()+ii*size;
+        for(size_t jj = 0; jj < size; jj++) {
+            auto entry = row->second.find(codes[jj]);
+            if (entry != row->second.end()) {
+                dest[jj] = (Sint16)(int)entry->second;
+            }
         }
     }
 }
@@ -2929,8 +3062,10 @@ int Font::computeKerning(Uint32 a, Uint32 b) const {
 
     int w1, w2;
     TTF_SizeUNICODE(_data, str, &w1, &w2);
-    w2 =  (_glyphsize.find(a) != _glyphsize.end() ? _glyphsize.at(a).advance : computeMetrics(a).advance);
-    w2 += (_glyphsize.find(b) != _glyphsize.end() ? _glyphsize.at(b).advance : computeMetrics(b).advance);
+    const Metrics* ma = findMetrics(a);
+    const Metrics* mb = findMetrics(b);
+    w2 =  (ma != nullptr ? ma->advance : computeMetrics(a).advance);
+    w2 += (mb != nullptr ? mb->advance : computeMetrics(b).advance);
     
     return w2-w1;
 }
@@ -3012,12 +3147,8 @@ bool Font::getOutline(Uint32 thechar, Vec2& offset, Mesh<SpriteVertex2>& mesh, c
     // Technically, this answer is correct
     if (!hasGlyph(thechar)) { return true; }
     
-    Metrics metrics;
-    if (_glyphsize.find(thechar) != _glyphsize.end()) {
-        metrics = _glyphsize[thechar];
-    } else {
-        metrics = computeMetrics(thechar);
-    }
+    const Metrics* cached = findMetrics(thechar);
+    Metrics metrics = (cached != nullptr ? *cached : computeMetrics(thechar));
     Rect quad(offset,Size(metrics.advance,metrics.maxy-metrics.miny));
     quad.origin.y += metrics.miny-_fontDescent;
     
@@ -0,0 +1,985 @@
+//
+//  CUGLState.cpp
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides a central cache of the OpenGL state. All of the render
+//  classes (SpriteBatch, Texture, Shader, UniformBuffer, VertexBuffer and
+//  RenderTarget) change the OpenGL state through this module instead of
+//  calling OpenGL directly. That way a change to a value that is already set
+//  (such as rebinding the current texture or resetting the blend function) is
+//  filtered before it reaches the driver. The module counts both the issued
+//  and the filtered calls so that the savings can be measured.
+//
+//  This class is a static class. It cannot be allocated, as there is only one
+//  OpenGL context per application. Because OpenGL is not thread safe, neither
+//  is this class. It should only be used on the main (rendering) thread.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#include <cugl/render/CUGLState.h>
+
+using namespace cugl;
+
+/** The value of a cache entry whose state is unknown */
+#define UNKNOWN_STATE   0xFFFFFFFF
+/** The number of texture units cached */
+#define TEXTURE_UNITS   32
+/** The number of uniform buffer indices cached */
+#define UNIFORM_INDICES 32
+/** The number of capabilities cached */
+#define CAPABILITIES    5
+/** The size of a buffer range bound with glBindBufferBase */
+#define WHOLE_BUFFER    -1
+
+/** The capabilities cached by this module */
+static const GLenum CAPABILITY_NAMES[CAPABILITIES] = {
+    GL_BLEND, GL_CULL_FACE, GL_DEPTH_TEST, GL_STENCIL_TEST, GL_SCISSOR_TEST
+};
+
+/**
+ * The cached OpenGL state.
+ *
+ * Every entry is either a known value or UNKNOWN_STATE. Boolean values are
+ * stored as GLuint so that they can be unknown as well.
+ */
+class GLCache {
+public:
+    /** The current program */
+    GLuint program;
+    /** The active texture unit */
+    GLuint activeUnit;
+    /** The 2D texture bound to each unit */
+    GLuint textures[TEXTURE_UNITS];
+    /** The bound array buffer */
+    GLuint arrayBuffer;
+    /** The bound element array buffer (part of the vertex array state) */
+    GLuint elementBuffer;
+    /** The buffer bound to the generic uniform buffer target */
+    GLuint uniformBuffer;
+    /** The buffer bound to each uniform buffer index */
+    GLuint uniformBases[UNIFORM_INDICES];
+    /** The range offset of each uniform buffer index */
+    GLintptr uniformOffsets[UNIFORM_INDICES];
+    /** The range size of each uniform buffer index (WHOLE_BUFFER for base) */
+    GLsizeiptr uniformSizes[UNIFORM_INDICES];
+    /** The bound vertex array */
+    GLuint vertexArray;
+    /** The bound draw framebuffer */
+    GLuint drawFramebuffer;
+    /** The bound read framebuffer */
+    GLuint readFramebuffer;
+    /** The viewport (x, y, width, height) */
+    GLint viewport[4];
+    /** Whether the viewport is known */
+    bool viewportKnown;
+    /** The state of each capability */
+    GLuint capabilities[CAPABILITIES];
+    /** The depth write mask */
+    GLuint depthMask;
+    /** The color write mask */
+    GLuint colorMask[4];
+    /** The blend equation */
+    GLuint blendEquation;
+    /** The blend function (srcRGB, dstRGB, srcAlpha, dstAlpha) */
+    GLuint blendFunc[4];
+    /** The stencil write mask */
+    GLuint stencilMask;
+    /** The stencil function (func, ref, mask) */
+    GLuint stencilFunc[3];
+    /** The stencil operations (sfail, dpfail, dppass) for the front face */
+    GLuint stencilFront[3];
+    /** The stencil operations (sfail, dpfail, dppass) for the back face */
+    GLuint stencilBack[3];
+
+    /** Whether redundant state changes are filtered */
+    bool filtering;
+    /** The number of state changes passed to OpenGL */
+    Uint64 issued;
+    /** The number of state changes filtered */
+    Uint64 filtered;
+
+    /**
+     * Creates a cache with all state unknown.
+     */
+    GLCache() : filtering(true), issued(0), filtered(0) {
+        invalidate();
+    }
+
+    /**
+     * Marks all of the cached state as unknown.
+     */
+    void invalidate() {
+        program = UNKNOWN_STATE;
+        activeUnit = UNKNOWN_STATE;
+        for(int ii = 0; ii < TEXTURE_UNITS; ii++) {
+            textures[ii] = UNKNOWN_STATE;
+        }
+        arrayBuffer   = UNKNOWN_STATE;
+        elementBuffer = UNKNOWN_STATE;
+        uniformBuffer = UNKNOWN_STATE;
+        for(int ii = 0; ii < UNIFORM_INDICES; ii++) {
+            uniformBases[ii] = UNKNOWN_STATE;
+            uniformOffsets[ii] = 0;
+            uniformSizes[ii] = WHOLE_BUFFER;
+        }
+        vertexArray = UNKNOWN_STATE;
+        drawFramebuffer = UNKNOWN_STATE;
+        readFramebuffer = UNKNOWN_STATE;
+        viewportKnown = false;
+        for(int ii = 0; ii < CAPABILITIES; ii++) {
+            capabilities[ii] = UNKNOWN_STATE;
+        }
+        depthMask = UNKNOWN_STATE;
+        blendEquation = UNKNOWN_STATE;
+        stencilMask = UNKNOWN_STATE;
+        for(int ii = 0; ii < 4; ii++) {
+            colorMask[ii] = UNKNOWN_STATE;
+            blendFunc[ii] = UNKNOWN_STATE;
+        }
+        for(int ii = 0; ii < 3; ii++) {
+            stencilFunc[ii]  = UNKNOWN_STATE;
+            stencilFront[ii] = UNKNOWN_STATE;
+            stencilBack[ii]  = UNKNOWN_STATE;
+        }
+    }
+
+    /**
+     * Returns true if a state change should be filtered.
+     *
+     * This method also updates the statistics.
+     *
+     * @param same  Whether the state change matches the cached value
+     *
+     * @return true if a state change should be filtered.
+     */
+    bool filter(bool same) {
+        if (same && filtering) {
+            filtered++;
+            return true;
+        }
+        issued++;
+        return false;
+    }
+};
+
+/** The OpenGL state cache */
+static GLCache _cache;
+
+/**
+ * Returns the cache index of the given capability
+ *
+ * @param cap   The capability
+ *
+ * @return the cache index of the given capability (-1 if not cached)
+ */
+static int capability_index(GLenum cap) {
+    for(int ii = 0; ii < CAPABILITIES; ii++) {
+        if (CAPABILITY_NAMES[ii] == cap) {
+            return ii;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Returns true if the stencil operations match the given values
+ *
+ * @param ops       The cached stencil operations
+ * @param sfail     The operation when the stencil test fails
+ * @param dpfail    The operation when the depth test fails
+ * @param dppass    The operation when both tests pass
+ *
+ * @return true if the stencil operations match the given values
+ */
+static bool stencil_match(const GLuint* ops, GLenum sfail, GLenum dpfail, GLenum dppass) {
+    return ops[0] == sfail && ops[1] == dpfail && ops[2] == dppass;
+}
+
+/**
+ * Stores the stencil operations in the given cache
+ *
+ * @param ops       The cached stencil operations
+ * @param sfail     The operation when the stencil test fails
+ * @param dpfail    The operation when the depth test fails
+ * @param dppass    The operation when both tests pass
+ */
+static void stencil_store(GLuint* ops, GLenum sfail, GLenum dpfail, GLenum dppass) {
+    ops[0] = sfail;
+    ops[1] = dpfail;
+    ops[2] = dppass;
+}
+
+#pragma mark Cache Control
+/**
+ * Marks all of the OpenGL state as unknown.
+ *
+ * This method should be called whenever the OpenGL state is changed
+ * outside of this class. The next call to each method will be issued,
+ * whatever its value. This method does not reset the statistics.
+ */
+void GLState::invalidate() {
+    _cache.invalidate();
+}
+
+/**
+ * Sets whether redundant state changes are filtered.
+ *
+ * If this value is false, all calls are passed to OpenGL, though the
+ * cache is still updated. This is useful for measuring the effect of the
+ * cache. This value is true by default.
+ *
+ * @param value Whether redundant state changes are filtered
+ */
+void GLState::setFiltering(bool value) {
+    _cache.filtering = value;
+}
+
+/**
+ * Returns true if redundant state changes are filtered.
+ *
+ * If this value is false, all calls are passed to OpenGL, though the
+ * cache is still updated. This is useful for measuring the effect of the
+ * cache. This value is true by default.
+ *
+ * @return true if redundant state changes are filtered.
+ */
+bool GLState::isFiltering() {
+    return _cache.filtering;
+}
+
+#pragma mark -
+#pragma mark Statistics
+/**
+ * Returns the number of state changes passed to OpenGL.
+ *
+ * This value is cumulative since the last call to {@link #resetStats}.
+ *
+ * @return the number of state changes passed to OpenGL.
+ */
+Uint64 GLState::getIssued() {
+    return _cache.issued;
+}
+
+/**
+ * Returns the number of redundant state changes filtered by the cache.
+ *
+ * This value is cumulative since the last call to {@link #resetStats}.
+ *
+ * @return the number of redundant state changes filtered by the cache.
+ */
+Uint64 GLState::getFiltered() {
+    return _cache.filtered;
+}
+
+/**
+ * Resets the issued and filtered counters to 0.
+ */
+void GLState::resetStats() {
+    _cache.issued = 0;
+    _cache.filtered = 0;
+}
+
+#pragma mark -
+#pragma mark Programs
+/**
+ * Makes the given program the current shader program.
+ *
+ * @param program   The program to use (0 for none)
+ */
+void GLState::useProgram(GLuint program) {
+    if (_cache.filter(_cache.program == program)) {
+        return;
+    }
+    glUseProgram(program);
+    _cache.program = program;
+}
+
+/**
+ * Returns the current shader program.
+ *
+ * @return the current shader program.
+ */
+GLuint GLState::getProgram() {
+    if (_cache.program == UNKNOWN_STATE) {
+        GLint value;
+        glGetIntegerv(GL_CURRENT_PROGRAM, &value);
+        _cache.program = (GLuint)value;
+    }
+    return _cache.program;
+}
+
+#pragma mark -
+#pragma mark Textures
+/**
+ * Sets the active texture unit.
+ *
+ * The unit should be an offset from GL_TEXTURE0, as in OpenGL.
+ *
+ * @param unit  The active texture unit
+ */
+void GLState::activeTexture(GLenum unit) {
+    if (_cache.filter(_cache.activeUnit == unit)) {
+        return;
+    }
+    glActiveTexture(unit);
+    _cache.activeUnit = unit;
+}
+
+/**
+ * Returns the active texture unit.
+ *
+ * The unit is an offset from GL_TEXTURE0, as in OpenGL.
+ *
+ * @return the active texture unit.
+ */
+GLenum GLState::getActiveTexture() {
+    if (_cache.activeUnit == UNKNOWN_STATE) {
+        GLint value;
+        glGetIntegerv(GL_ACTIVE_TEXTURE, &value);
+        _cache.activeUnit = (GLuint)value;
+    }
+    return _cache.activeUnit;
+}
+
+/**
+ * Binds the texture to the given target of the active texture unit.
+ *
+ * Only GL_TEXTURE_2D is cached. Other targets are always issued.
+ *
+ * @param target    The texture target
+ * @param texture   The texture to bind (0 for none)
+ */
+void GLState::bindTexture(GLenum target, GLuint texture) {
+    GLuint index = getActiveTexture()-GL_TEXTURE0;
+    if (target != GL_TEXTURE_2D || index >= TEXTURE_UNITS) {
+        _cache.issued++;
+        glBindTexture(target, texture);
+        return;
+    } else if (_cache.filter(_cache.textures[index] == texture)) {
+        return;
+    }
+    glBindTexture(target, texture);
+    _cache.textures[index] = texture;
+}
+
+/**
+ * Returns the 2D texture bound to the given texture unit.
+ *
+ * The unit should be an offset from GL_TEXTURE0, as in OpenGL. This
+ * method does not change the active texture unit.
+ *
+ * @param unit  The texture unit
+ *
+ * @return the 2D texture bound to the given texture unit.
+ */
+GLuint GLState::getTexture(GLenum unit) {
+    GLuint index = unit-GL_TEXTURE0;
+    if (index < TEXTURE_UNITS && _cache.textures[index] != UNKNOWN_STATE) {
+        return _cache.textures[index];
+    }
+
+    // Query without disturbing the active unit
+    GLenum orig = getActiveTexture();
+    if (orig != unit) {
+        glActiveTexture(unit);
+    }
+    GLint value;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &value);
+    if (orig != unit) {
+        glActiveTexture(orig);
+    }
+    if (index < TEXTURE_UNITS) {
+        _cache.textures[index] = (GLuint)value;
+    }
+    return (GLuint)value;
+}
+
+/**
+ * Deletes the given texture, removing it from the cache.
+ *
+ * @param texture   The texture to delete
+ */
+void GLState::deleteTexture(GLuint texture) {
+    glDeleteTextures(1, &texture);
+    for(int ii = 0; ii < TEXTURE_UNITS; ii++) {
+        if (_cache.textures[ii] == texture) {
+            _cache.textures[ii] = 0;
+        }
+    }
+}
+
+#pragma mark -
+#pragma mark Buffers
+/**
+ * Binds the buffer to the given target.
+ *
+ * Only GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER, and GL_UNIFORM_BUFFER
+ * are cached. Other targets are always issued. As in OpenGL, the element
+ * array buffer is part of the state of the current vertex array.
+ *
+ * @param target    The buffer target
+ * @param buffer    The buffer to bind (0 for none)
+ */
+void GLState::bindBuffer(GLenum target, GLuint buffer) {
+    GLuint* entry = nullptr;
+    switch (target) {
+        case GL_ARRAY_BUFFER:
+            entry = &_cache.arrayBuffer;
+            break;
+        case GL_ELEMENT_ARRAY_BUFFER:
+            entry = &_cache.elementBuffer;
+            break;
+        case GL_UNIFORM_BUFFER:
+            entry = &_cache.uniformBuffer;
+            break;
+        default:
+            _cache.issued++;
+            glBindBuffer(target, buffer);
+            return;
+    }
+    if (_cache.filter(*entry == buffer)) {
+        return;
+    }
+    glBindBuffer(target, buffer);
+    *entry = buffer;
+}
+
+/**
+ * Returns the buffer bound to the given target.
+ *
+ * @param target    The buffer target
+ *
+ * @return the buffer bound to the given target.
+ */
+GLuint GLState::getBuffer(GLenum target) {
+    GLuint* entry = nullptr;
+    GLenum query = 0;
+    switch (target) {
+        case GL_ARRAY_BUFFER:
+            entry = &_cache.arrayBuffer;
+            query = GL_ARRAY_BUFFER_BINDING;
+            break;
+        case GL_ELEMENT_ARRAY_BUFFER:
+            entry = &_cache.elementBuffer;
+            query = GL_ELEMENT_ARRAY_BUFFER_BINDING;
+            break;
+        case GL_UNIFORM_BUFFER:
+            entry = &_cache.uniformBuffer;
+            query = GL_UNIFORM_BUFFER_BINDING;
+            break;
+        default:
+            return 0;
+    }
+    if (*entry == UNKNOWN_STATE) {
+        GLint value;
+        glGetIntegerv(query, &value);
+        *entry = (GLuint)value;
+    }
+    return *entry;
+}
+
+/**
+ * Binds the buffer to the given index of an indexed target.
+ *
+ * Only GL_UNIFORM_BUFFER is cached. Other targets are always issued. If
+ * the call is issued, OpenGL also binds the buffer to the generic target.
+ * As a filtered call does not, code should not rely on this side effect.
+ *
+ * @param target    The indexed buffer target
+ * @param index     The binding index
+ * @param buffer    The buffer to bind (0 for none)
+ */
+void GLState::bindBufferBase(GLenum target, GLuint index, GLuint buffer) {
+    if (target != GL_UNIFORM_BUFFER || index >= UNIFORM_INDICES) {
+        _cache.issued++;
+        glBindBufferBase(target, index, buffer);
+        if (target == GL_UNIFORM_BUFFER) {
+            _cache.uniformBuffer = buffer;
+        }
+        return;
+    } else if (_cache.filter(_cache.uniformBases[index] == buffer &&
+                             _cache.uniformSizes[index] == WHOLE_BUFFER)) {
+        return;
+    }
+    glBindBufferBase(target, index, buffer);
+    _cache.uniformBases[index] = buffer;
+    _cache.uniformOffsets[index] = 0;
+    _cache.uniformSizes[index] = WHOLE_BUFFER;
+    _cache.uniformBuffer = buffer;
+}
+
+/**
+ * Binds a range of the buffer to the given index of an indexed target.
+ *
+ * Only GL_UNIFORM_BUFFER is cached. Other targets are always issued. If
+ * the call is issued, OpenGL also binds the buffer to the generic target.
+ * As a filtered call does not, code should not rely on this side effect.
+ *
+ * @param target    The indexed buffer target
+ * @param index     The binding index
+ * @param buffer    The buffer to bind
+ * @param offset    The start of the range in bytes
+ * @param size      The size of the range in bytes
+ */
+void GLState::bindBufferRange(GLenum target, GLuint index, GLuint buffer,
+                              GLintptr offset, GLsizeiptr size) {
+    if (target != GL_UNIFORM_BUFFER || index >= UNIFORM_INDICES) {
+        _cache.issued++;
+        glBindBufferRange(target, index, buffer, offset, size);
+        if (target == GL_UNIFORM_BUFFER) {
+            _cache.uniformBuffer = buffer;
+        }
+        return;
+    } else if (_cache.filter(_cache.uniformBases[index] == buffer &&
+                             _cache.uniformOffsets[index] == offset &&
+                             _cache.uniformSizes[index] == size)) {
+        return;
+    }
+    glBindBufferRange(target, index, buffer, offset, size);
+    _cache.uniformBases[index] = buffer;
+    _cache.uniformOffsets[index] = offset;
+    _cache.uniformSizes[index] = size;
+    _cache.uniformBuffer = buffer;
+}
+
+/**
+ * Returns the buffer bound to the given index of an indexed target.
+ *
+ * @param target    The indexed buffer target
+ * @param index     The binding index
+ *
+ * @return the buffer bound to the given index of an indexed target.
+ */
+GLuint GLState::getBufferBase(GLenum target, GLuint index) {
+    if (target != GL_UNIFORM_BUFFER) {
+        return 0;
+    } else if (index < UNIFORM_INDICES && _cache.uniformBases[index] != UNKNOWN_STATE) {
+        return _cache.uniformBases[index];
+    }
+
+    GLint value;
+    glGetIntegeri_v(GL_UNIFORM_BUFFER_BINDING, index, &value);
+    return (GLuint)value;
+}
+
+/**
+ * Deletes the given buffer, removing it from the cache.
+ *
+ * @param buffer    The buffer to delete
+ */
+void GLState::deleteBuffer(GLuint buffer) {
+    glDeleteBuffers(1, &buffer);
+    if (_cache.arrayBuffer == buffer) {
+        _cache.arrayBuffer = 0;
+    }
+    if (_cache.elementBuffer == buffer) {
+        _cache.elementBuffer = 0;
+    }
+    if (_cache.uniformBuffer == buffer) {
+        _cache.uniformBuffer = 0;
+    }
+    for(int ii = 0; ii < UNIFORM_INDICES; ii++) {
+        if (_cache.uniformBases[ii] == buffer) {
+            _cache.uniformBases[ii] = 0;
+            _cache.uniformOffsets[ii] = 0;
+            _cache.uniformSizes[ii] = WHOLE_BUFFER;
+        }
+    }
+}
+
+/**
+ * Binds the given vertex array.
+ *
+ * @param array The vertex array to bind (0 for none)
+ */
+void GLState::bindVertexArray(GLuint array) {
+    if (_cache.filter(_cache.vertexArray == array)) {
+        return;
+    }
+    glBindVertexArray(array);
+    _cache.vertexArray = array;
+    // The element buffer belongs to the vertex array
+    _cache.elementBuffer = UNKNOWN_STATE;
+}
+
+/**
+ * Returns the currently bound vertex array.
+ *
+ * @return the currently bound vertex array.
+ */
+GLuint GLState::getVertexArray() {
+    if (_cache.vertexArray == UNKNOWN_STATE) {
+        GLint value;
+        glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &value);
+        _cache.vertexArray = (GLuint)value;
+    }
+    return _cache.vertexArray;
+}
+
+/**
+ * Deletes the given vertex array, removing it from the cache.
+ *
+ * @param array The vertex array to delete
+ */
+void GLState::deleteVertexArray(GLuint array) {
+    glDeleteVertexArrays(1, &array);
+    if (_cache.vertexArray == array) {
+        _cache.vertexArray = 0;
+        _cache.elementBuffer = UNKNOWN_STATE;
+    }
+}
+
+#pragma mark -
+#pragma mark Framebuffers
+/**
+ * Binds the framebuffer to the given target.
+ *
+ * The target GL_FRAMEBUFFER binds both the draw and the read framebuffer.
+ *
+ * @param target        The framebuffer target
+ * @param framebuffer   The framebuffer to bind
+ */
+void GLState::bindFramebuffer(GLenum target, GLuint framebuffer) {
+    bool same;
+    switch (target) {
+        case GL_DRAW_FRAMEBUFFER:
+            same = _cache.drawFramebuffer == framebuffer;
+            break;
+        case GL_READ_FRAMEBUFFER:
+            same = _cache.readFramebuffer == framebuffer;
+            break;
+        default:
+            same = _cache.drawFramebuffer == framebuffer && _cache.readFramebuffer == framebuffer;
+            break;
+    }
+    if (_cache.filter(same)) {
+        return;
+    }
+    glBindFramebuffer(target, framebuffer);
+    if (target != GL_READ_FRAMEBUFFER) {
+        _cache.drawFramebuffer = framebuffer;
+    }
+    if (target != GL_DRAW_FRAMEBUFFER) {
+        _cache.readFramebuffer = framebuffer;
+    }
+}
+
+/**
+ * Returns the framebuffer bound to the given target.
+ *
+ * The target GL_FRAMEBUFFER is the same as GL_DRAW_FRAMEBUFFER.
+ *
+ * @param target    The framebuffer target
+ *
+ * @return the framebuffer bound to the given target.
+ */
+GLuint GLState::getFramebuffer(GLenum target) {
+    GLint value;
+    if (target == GL_READ_FRAMEBUFFER) {
+        if (_cache.readFramebuffer == UNKNOWN_STATE) {
+            glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &value);
+            _cache.readFramebuffer = (GLuint)value;
+        }
+        return _cache.readFramebuffer;
+    }
+    if (_cache.drawFramebuffer == UNKNOWN_STATE) {
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &value);
+        _cache.drawFramebuffer = (GLuint)value;
+    }
+    return _cache.drawFramebuffer;
+}
+
+/**
+ * Deletes the given framebuffer, removing it from the cache.
+ *
+ * @param framebuffer   The framebuffer to delete
+ */
+void GLState::deleteFramebuffer(GLuint framebuffer) {
+    glDeleteFramebuffers(1, &framebuffer);
+    if (_cache.drawFramebuffer == framebuffer) {
+        _cache.drawFramebuffer = 0;
+    }
+    if (_cache.readFramebuffer == framebuffer) {
+        _cache.readFramebuffer = 0;
+    }
+}
+
+/**
+ * Sets the OpenGL viewport.
+ *
+ * @param x         The left edge of the viewport
+ * @param y         The bottom edge of the viewport
+ * @param width     The viewport width
+ * @param height    The viewport height
+ */
+void GLState::viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    if (_cache.filter(_cache.viewportKnown &&
+                      _cache.viewport[0] == x && _cache.viewport[1] == y &&
+                      _cache.viewport[2] == width && _cache.viewport[3] == height)) {
+        return;
+    }
+    glViewport(x, y, width, height);
+    _cache.viewport[0] = x;
+    _cache.viewport[1] = y;
+    _cache.viewport[2] = width;
+    _cache.viewport[3] = height;
+    _cache.viewportKnown = true;
+}
+
+/**
+ * Stores the current viewport in the given array.
+ *
+ * The array must have room for four values: x, y, width, and height.
+ *
+ * @param viewport  The array to store the viewport
+ */
+void GLState::getViewport(GLint* viewport) {
+    if (!_cache.viewportKnown) {
+        glGetIntegerv(GL_VIEWPORT, _cache.viewport);
+        _cache.viewportKnown = true;
+    }
+    for(int ii = 0; ii < 4; ii++) {
+        viewport[ii] = _cache.viewport[ii];
+    }
+}
+
+#pragma mark -
+#pragma mark Capabilities
+/**
+ * Enables the given capability.
+ *
+ * Only GL_BLEND, GL_CULL_FACE, GL_DEPTH_TEST, GL_STENCIL_TEST, and
+ * GL_SCISSOR_TEST are cached. Other capabilities are always issued.
+ *
+ * @param cap   The capability to enable
+ */
+void GLState::enable(GLenum cap) {
+    int index = capability_index(cap);
+    if (index < 0) {
+        _cache.issued++;
+        glEnable(cap);
+        return;
+    } else if (_cache.filter(_cache.capabilities[index] == GL_TRUE)) {
+        return;
+    }
+    glEnable(cap);
+    _cache.capabilities[index] = GL_TRUE;
+}
+
+/**
+ * Disables the given capability.
+ *
+ * Only GL_BLEND, GL_CULL_FACE, GL_DEPTH_TEST, GL_STENCIL_TEST, and
+ * GL_SCISSOR_TEST are cached. Other capabilities are always issued.
+ *
+ * @param cap   The capability to disable
+ */
+void GLState::disable(GLenum cap) {
+    int index = capability_index(cap);
+    if (index < 0) {
+        _cache.issued++;
+        glDisable(cap);
+        return;
+    } else if (_cache.filter(_cache.capabilities[index] == GL_FALSE)) {
+        return;
+    }
+    glDisable(cap);
+    _cache.capabilities[index] = GL_FALSE;
+}
+
+/**
+ * Returns true if the given capability is enabled.
+ *
+ * @param cap   The capability to query
+ *
+ * @return true if the given capability is enabled.
+ */
+bool GLState::isEnabled(GLenum cap) {
+    int index = capability_index(cap);
+    if (index < 0) {
+        return glIsEnabled(cap) == GL_TRUE;
+    } else if (_cache.capabilities[index] == UNKNOWN_STATE) {
+        _cache.capabilities[index] = glIsEnabled(cap);
+    }
+    return _cache.capabilities[index] == GL_TRUE;
+}
+
+/**
+ * Sets whether the depth buffer is writable.
+ *
+ * @param flag  Whether the depth buffer is writable
+ */
+void GLState::depthMask(GLboolean flag) {
+    if (_cache.filter(_cache.depthMask == flag)) {
+        return;
+    }
+    glDepthMask(flag);
+    _cache.depthMask = flag;
+}
+
+/**
+ * Sets which color components are writable.
+ *
+ * @param red       Whether the red component is writable
+ * @param green     Whether the green component is writable
+ * @param blue      Whether the blue component is writable
+ * @param alpha     Whether the alpha component is writable
+ */
+void GLState::colorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha) {
+    if (_cache.filter(_cache.colorMask[0] == red && _cache.colorMask[1] == green &&
+                      _cache.colorMask[2] == blue && _cache.colorMask[3] == alpha)) {
+        return;
+    }
+    glColorMask(red, green, blue, alpha);
+    _cache.colorMask[0] = red;
+    _cache.colorMask[1] = green;
+    _cache.colorMask[2] = blue;
+    _cache.colorMask[3] = alpha;
+}
+
+#pragma mark -
+#pragma mark Blending
+/**
+ * Sets the blend equation for both the RGB and alpha components.
+ *
+ * @param mode  The blend equation
+ */
+void GLState::blendEquation(GLenum mode) {
+    if (_cache.filter(_cache.blendEquation == mode)) {
+        return;
+    }
+    glBlendEquation(mode);
+    _cache.blendEquation = mode;
+}
+
+/**
+ * Sets the blend function for both the RGB and alpha components.
+ *
+ * @param sfactor   The source blend factor
+ * @param dfactor   The destination blend factor
+ */
+void GLState::blendFunc(GLenum sfactor, GLenum dfactor) {
+    if (_cache.filter(_cache.blendFunc[0] == sfactor && _cache.blendFunc[1] == dfactor &&
+                      _cache.blendFunc[2] == sfactor && _cache.blendFunc[3] == dfactor)) {
+        return;
+    }
+    glBlendFunc(sfactor, dfactor);
+    _cache.blendFunc[0] = sfactor;
+    _cache.blendFunc[1] = dfactor;
+    _cache.blendFunc[2] = sfactor;
+    _cache.blendFunc[3] = dfactor;
+}
+
+/**
+ * Sets the blend function separately for the RGB and alpha components.
+ *
+ * @param srcRGB    The source RGB blend factor
+ * @param dstRGB    The destination RGB blend factor
+ * @param srcAlpha  The source alpha blend factor
+ * @param dstAlpha  The destination alpha blend factor
+ */
+void GLState::blendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha) {
+    if (_cache.filter(_cache.blendFunc[0] == srcRGB && _cache.blendFunc[1] == dstRGB &&
+                      _cache.blendFunc[2] == srcAlpha && _cache.blendFunc[3] == dstAlpha)) {
+        return;
+    }
+    glBlendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha);
+    _cache.blendFunc[0] = srcRGB;
+    _cache.blendFunc[1] = dstRGB;
+    _cache.blendFunc[2] = srcAlpha;
+    _cache.blendFunc[3] = dstAlpha;
+}
+
+#pragma mark -
+#pragma mark Stencils
+/**
+ * Sets the stencil write mask for both front and back faces.
+ *
+ * @param mask  The stencil write mask
+ */
+void GLState::stencilMask(GLuint mask) {
+    if (_cache.filter(_cache.stencilMask == mask)) {
+        return;
+    }
+    glStencilMask(mask);
+    _cache.stencilMask = mask;
+}
+
+/**
+ * Sets the stencil test function for both front and back faces.
+ *
+ * @param func  The stencil test function
+ * @param ref   The stencil reference value
+ * @param mask  The stencil test mask
+ */
+void GLState::stencilFunc(GLenum func, GLint ref, GLuint mask) {
+    if (_cache.filter(_cache.stencilFunc[0] == func && _cache.stencilFunc[1] == (GLuint)ref &&
+                      _cache.stencilFunc[2] == mask)) {
+        return;
+    }
+    glStencilFunc(func, ref, mask);
+    _cache.stencilFunc[0] = func;
+    _cache.stencilFunc[1] = (GLuint)ref;
+    _cache.stencilFunc[2] = mask;
+}
+
+/**
+ * Sets the stencil operations for both front and back faces.
+ *
+ * @param sfail     The operation when the stencil test fails
+ * @param dpfail    The operation when the depth test fails
+ * @param dppass    The operation when both tests pass
+ */
+void GLState::stencilOp(GLenum sfail, GLenum dpfail, GLenum dppass) {
+    if (_cache.filter(stencil_match(_cache.stencilFront, sfail, dpfail, dppass) &&
+                      stencil_match(_cache.stencilBack,  sfail, dpfail, dppass))) {
+        return;
+    }
+    glStencilOp(sfail, dpfail, dppass);
+    stencil_store(_cache.stencilFront, sfail, dpfail, dppass);
+    stencil_store(_cache.stencilBack,  sfail, dpfail, dppass);
+}
+
+/**
+ * Sets the stencil operations for the given face(s).
+ *
+ * @param face      The face (GL_FRONT, GL_BACK, or GL_FRONT_AND_BACK)
+ * @param sfail     The operation when the stencil test fails
+ * @param dpfail    The operation when the depth test fails
+ * @param dppass    The operation when both tests pass
+ */
+void GLState::stencilOpSeparate(GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass) {
+    bool front = face != GL_BACK;
+    bool back  = face != GL_FRONT;
+    if (_cache.filter((!front || stencil_match(_cache.stencilFront, sfail, dpfail, dppass)) &&
+                      (!back  || stencil_match(_cache.stencilBack,  sfail, dpfail, dppass)))) {
+        return;
+    }
+    glStencilOpSeparate(face, sfail, dpfail, dppass);
+    if (front) {
+        stencil_store(_cache.stencilFront, sfail, dpfail, dppass);
+    }
+    if (back) {
+        stencil_store(_cache.stencilBack, sfail, dpfail, dppass);
+    }
+}
@@ -43,6 +43,7 @@
 #include <cugl/render/CURenderTarget.h>
 #include <cugl/render/CUTexture.h>
 #include <cugl/base/CUDisplay.h>
+#include <cugl/render/CUGLState.h>
 #include <cugl/util/CUDebug.h>
 
 using namespace cugl;
@@ -61,7 +62,7 @@ using namespace cugl;
  * @return true if initialization was successful.
  */
 bool RenderTarget::prepareBuffer() {
-    glGetIntegerv(GL_VIEWPORT, _viewport);
+    GLState::getViewport(_viewport);
     
     GLenum error;
     glGenFramebuffers(1, &_framebo);
@@ -71,7 +72,7 @@ bool RenderTarget::prepareBuffer() {
         return false;
     }
     
-    glBindFramebuffer(GL_FRAMEBUFFER, _framebo);
+    GLState::bindFramebuffer(GL_FRAMEBUFFER, _framebo);
 
     // Attach the depth buffer first
     _depthst = Texture::alloc(_width,_height,Texture::PixelFormat::DEPTH_STENCIL);
@@ -389,7 +390,7 @@ bool RenderTarget::init(int width, int height, Texture::PixelFormat* outputs, si
  */
 void RenderTarget::dispose() {
     if (_framebo) {
-        glDeleteFramebuffers(1, &_framebo);
+        GLState::deleteFramebuffer(_framebo);
         _framebo = 0;
     }
     if (_renderbo) {
@@ -435,11 +436,11 @@ const std::shared_ptr<Texture>& RenderTarget::getTexture(size_t index) const {
  * return control to the default render target (the screen) when done.
  */
 void RenderTarget::begin() {
-    glGetIntegerv(GL_VIEWPORT, _viewport);
-    glBindFramebuffer(GL_FRAMEBUFFER, _framebo);
+    GLState::getViewport(_viewport);
+    GLState::bindFramebuffer(GL_FRAMEBUFFER, _framebo);
     //glBindRenderbuffer(GL_RENDERBUFFER, _renderbo);
 
-    glViewport(0, 0, _width, _height);
+    GLState::viewport(0, 0, _width, _height);
     glClearColor(_clearcol.r, _clearcol.g, _clearcol.b, _clearcol.a);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 }
@@ -456,6 +457,6 @@ void RenderTarget::begin() {
  */
 void RenderTarget::end() {
     Display::get()->restoreRenderTarget();
-    glViewport(_viewport[0], _viewport[1], _viewport[2], _viewport[3]);
+    GLState::viewport(_viewport[0], _viewport[1], _viewport[2], _viewport[3]);
 }
 
@@ -33,6 +33,9 @@
 #include <cugl/util/CUStrings.h>
 #include <cugl/render/CUShader.h>
 #include <cugl/render/CUTexture.h>
+#include <cugl/render/CUGLState.h>
+#include <algorithm>
+#include <cstring>
 
 using namespace cugl;
 
@@ -53,6 +56,63 @@ std::string preprocess_shader(const std::string code) {
     return source;
 }
 
+/**
+ * Returns the size in bytes of a single value of the given uniform type
+ *
+ * This method returns 0 for types it does not recognize. Such uniforms are
+ * not shadowed.
+ *
+ * @param type  The uniform type
+ *
+ * @return the size in bytes of a single value of the given uniform type
+ */
+static size_t uniform_bytes(GLenum type) {
+    switch (type) {
+        case GL_FLOAT:
+        case GL_INT:
+        case GL_UNSIGNED_INT:
+        case GL_BOOL:
+        case GL_SAMPLER_2D:
+        case GL_SAMPLER_3D:
+        case GL_SAMPLER_CUBE:
+        case GL_SAMPLER_2D_SHADOW:
+        case GL_SAMPLER_2D_ARRAY:
+        case GL_INT_SAMPLER_2D:
+        case GL_UNSIGNED_INT_SAMPLER_2D:
+            return 4;
+        case GL_FLOAT_VEC2:
+        case GL_INT_VEC2:
+        case GL_UNSIGNED_INT_VEC2:
+        case GL_BOOL_VEC2:
+            return 8;
+        case GL_FLOAT_VEC3:
+        case GL_INT_VEC3:
+        case GL_UNSIGNED_INT_VEC3:
+        case GL_BOOL_VEC3:
+            return 12;
+        case GL_FLOAT_VEC4:
+        case GL_INT_VEC4:
+        case GL_UNSIGNED_INT_VEC4:
+        case GL_BOOL_VEC4:
+        case GL_FLOAT_MAT2:
+            return 16;
+        case GL_FLOAT_MAT2x3:
+        case GL_FLOAT_MAT3x2:
+            return 24;
+        case GL_FLOAT_MAT2x4:
+        case GL_FLOAT_MAT4x2:
+            return 32;
+        case GL_FLOAT_MAT3:
+            return 36;
+        case GL_FLOAT_MAT3x4:
+        case GL_FLOAT_MAT4x3:
+            return 48;
+        case GL_FLOAT_MAT4:
+            return 64;
+    }
+    return 0;
+}
+
 #pragma mark -
 #pragma mark Compilation
 /**
@@ -121,10 +181,10 @@ bool Shader::compile() {
  * You must reinitialize the shader to use it.
  */
 void Shader::dispose() {
-    glUseProgram(NULL);
+    GLState::useProgram(0);
     if (_fragShader) { glDeleteShader(_fragShader); _fragShader = 0;}
     if (_vertShader) { glDeleteShader(_vertShader); _vertShader = 0;}
-    if (_program) { glDeleteShader(_program); _program = 0;}
+    if (_program) { glDeleteProgram(_program); _program = 0;}
     _vertSource.clear();
     _fragSource.clear();
 
@@ -137,6 +197,13 @@ void Shader::dispose() {
     _uniblocknames.clear();
     _uniblocksizes.clear();
     _uniblockfields.clear();
+    _uniformtable.clear();
+    _uniformslots.clear();
+    _locationslots.clear();
+    _shadow.clear();
+    _shadowed.clear();
+    _uniformsent = 0;
+    _uniformskip = 0;
 }
 
 /**
@@ -233,16 +300,17 @@ void Shader::cacheAttributes() {
     GLint size;     // size of the variable
     GLenum type;    // type of the variable (float, vec3 or mat4, etc)
 
-    const GLsizei bufSize = 16; // maximum name length
-    GLchar name[bufSize];       // variable name in GLSL
+    GLint bufSize;              // maximum name length
     GLsizei length;             // name length
+    glGetProgramiv(_program, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &bufSize);
+    std::vector<GLchar> name(std::max(bufSize,1));
     
     glGetProgramiv(_program, GL_ACTIVE_ATTRIBUTES, &count);
     for (GLuint ii = 0; ii < count; ii++) {
-        glGetActiveAttrib(_program, ii, bufSize, &length, &size, &type, name);
+        glGetActiveAttrib(_program, ii, (GLsizei)name.size(), &length, &size, &type, name.data());
         GLenum error = glGetError();
         if (!error) {
-            std::string key(name);
+            std::string key(name.data(),length);
             _attribtypes[key] = type;
             _attribsizes[key] = size;
             _attribnames[ii] = key;
@@ -261,28 +329,53 @@ void Shader::cacheUniforms() {
     GLint size;     // size of the variable
     GLenum type;    // type of the variable (float, vec3 or mat4, etc)
 
-    const GLsizei bufSize = 16; // maximum name length
-    GLchar name[bufSize];       // variable name in GLSL
+    GLint bufSize;              // maximum name length
     GLsizei length;             // name length
+    glGetProgramiv(_program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &bufSize);
+    std::vector<GLchar> name(std::max(bufSize,1));
     
     glGetProgramiv(_program, GL_ACTIVE_UNIFORMS, &count);
+    _uniformtable.reserve(count);
     for (GLuint ii = 0; ii < count; ii++) {
-        glGetActiveUniform(_program, ii, bufSize, &length, &size, &type, name);
+        glGetActiveUniform(_program, ii, (GLsizei)name.size(), &length, &size, &type, name.data());
         GLenum error = glGetError();
         if (!error) {
-            std::string key(name);
+            std::string key(name.data(),length);
             _uniformtypes[key] = type;
             _uniformsizes[key] = size;
             _uniformnames[ii]  = key;
+
+            Uniform uniform;
+            uniform.name = key;
+            uniform.type = type;
+            uniform.size = size;
+            uniform.location = glGetUniformLocation(_program, key.c_str());
+            uniform.block = -1;
+            uniform.offset = 0;
+            uniform.bytes  = 0;
+            
+            GLint slot = (GLint)_uniformtable.size();
+            _uniformslots[key] = slot;
+            if (uniform.location >= 0) {
+                _locationslots[uniform.location] = slot;
+            }
+            
+            // Arrays are reported as name[0]; they may be set by the base name
+            if (key.size() > 3 && key.compare(key.size()-3,3,"[0]") == 0) {
+                _uniformslots[key.substr(0,key.size()-3)] = slot;
+            }
+            _uniformtable.push_back(uniform);
         }
     }
     
+    glGetProgramiv(_program, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &bufSize);
+    name.resize(std::max(bufSize,1));
     glGetProgramiv(_program, GL_ACTIVE_UNIFORM_BLOCKS, &count);
     for (GLuint ii = 0; ii < count; ii++) {
-        glGetActiveUniformBlockName(_program, ii, bufSize, &length, name);
+        glGetActiveUniformBlockName(_program, ii, (GLsizei)name.size(), &length, name.data());
         GLenum error = glGetError();
         if (!error) {
-            std::string key(name);
+            std::string key(name.data(),length);
             glGetActiveUniformBlockiv(_program, ii, GL_UNIFORM_BLOCK_DATA_SIZE, &size);
             _uniblocksizes[key] = size;
             _uniblocknames[ii]  = key;
@@ -293,10 +386,83 @@ void Shader::cacheUniforms() {
             glGetActiveUniformBlockiv(_program, ii, GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES, ans);
             for(int jj = 0; jj < size; jj++) {
                 _uniblockfields[ans[jj]] = ii;
+                auto search = _uniformnames.find(ans[jj]);
+                if (search != _uniformnames.end()) {
+                    _uniformtable[_uniformslots[search->second]].block = ii;
+                }
             }
             delete[] ans;
         }
     }
+    
+    // Lay out the shadow values. Arrays and block uniforms are not shadowed.
+    size_t offset = 0;
+    for(auto it = _uniformtable.begin(); it != _uniformtable.end(); ++it) {
+        if (it->location >= 0 && it->size == 1) {
+            it->offset = offset;
+            it->bytes  = uniform_bytes(it->type);
+            offset += it->bytes;
+        }
+    }
+    _shadow.resize(offset);
+    _shadowed.assign(_uniformtable.size(),false);
+}
+
+/**
+ * Returns true if the value of the given slot must be sent to OpenGL.
+ *
+ * If the slot is shadowed and its last value is the same as data, this
+ * method returns false. Otherwise it records data as the new shadow value
+ * and returns true. If cache is false, the shadow value is invalidated
+ * instead (this is the case for transposed matrices).
+ *
+ * @param slot  The uniform slot
+ * @param data  The uniform value
+ * @param size  The size of the uniform value in bytes
+ * @param cache Whether the value may be cached
+ *
+ * @return true if the value of the given slot must be sent to OpenGL.
+ */
+bool Shader::updateSlot(GLint slot, const void* data, size_t size, bool cache) {
+    const Uniform& uniform = _uniformtable[slot];
+    if (!cache || uniform.bytes != size) {
+        _shadowed[slot] = false;
+        _uniformsent++;
+        return true;
+    }
+    
+    Uint8* shadow = _shadow.data()+uniform.offset;
+    if (_shadowed[slot] && std::memcmp(shadow, data, size) == 0) {
+        _uniformskip++;
+        return false;
+    }
+    std::memcpy(shadow, data, size);
+    _shadowed[slot] = true;
+    _uniformsent++;
+    return true;
+}
+
+/**
+ * Returns true if the value of the given location must be sent to OpenGL.
+ *
+ * This method is the same as {@link #updateSlot}, except that it looks up
+ * the slot of the location first. Locations that are not in the reflection
+ * table (such as array elements) are always sent.
+ *
+ * @param pos   The uniform location
+ * @param data  The uniform value
+ * @param size  The size of the uniform value in bytes
+ * @param cache Whether the value may be cached
+ *
+ * @return true if the value of the given location must be sent to OpenGL.
+ */
+bool Shader::updateShadow(GLint pos, const void* data, size_t size, bool cache) {
+    auto search = _locationslots.find(pos);
+    if (search == _locationslots.end()) {
+        _uniformsent++;
+        return true;
+    }
+    return updateSlot(search->second, data, size, cache);
 }
 
 
@@ -336,7 +502,7 @@ bool Shader::init(const std::string vsource, const std::string fsource) {
  */
 void Shader::bind() {
     CUAssertLog(_program, "Shader has not been initialized.");
-    glUseProgram( _program );
+    GLState::useProgram( _program );
 }
 
 /**
@@ -347,7 +513,7 @@ void Shader::bind() {
 void Shader::unbind() {
     CUAssertLog(_program, "Shader has not been initialized.");
     if (isBound()) {
-        glUseProgram( NULL );
+        GLState::useProgram( 0 );
     }
 }
 
@@ -359,9 +525,7 @@ void Shader::unbind() {
  * @return true if this shader is currently bound.
  */
 bool Shader::isBound() const {
-    GLint prog;
-    glGetIntegerv(GL_CURRENT_PROGRAM,&prog);
-    return prog == _program;
+    return GLState::getProgram() == _program;
 }
  
 
@@ -389,7 +553,7 @@ std::vector<std::string> Shader::getAttributes() const {
  *
  * @return the program offset of the given attribute
  */
-GLint Shader::getAttributeLocation(const std::string name) const {
+GLint Shader::getAttributeLocation(const std::string& name) const {
     return glGetAttribLocation(_program,name.c_str());
 }
 
@@ -400,7 +564,7 @@ GLint Shader::getAttributeLocation(const std::string name) const {
  *
  * @return the size (in bytes) of the given attribute
  */
-GLint Shader::getAttributeSize(const std::string name) const {
+GLint Shader::getAttributeSize(const std::string& name) const {
     auto search = _attribsizes.find(name);
     if (search == _attribsizes.end()) {
         return -1;
@@ -417,7 +581,7 @@ GLint Shader::getAttributeSize(const std::string name) const {
  *
  * @return the type of the given attribute
  */
-GLenum Shader::getAttributeType(const std::string name) const  {
+GLenum Shader::getAttributeType(const std::string& name) const  {
     auto search = _attribtypes.find(name);
     if (search == _attribtypes.end()) {
         return GL_FALSE;
@@ -446,7 +610,7 @@ GLenum Shader::getAttributeType(const std::string name) const  {
  *
  * @return the program offset of the given output variable.
  */
-GLint Shader::getOutputLocation(const std::string name) const {
+GLint Shader::getOutputLocation(const std::string& name) const {
     return glGetFragDataLocation(_program, name.c_str());
 }
 
@@ -475,8 +639,15 @@ std::vector<std::string> Shader::getUniforms() const {
  *
  * @return the program offset of the given uniform
  */
-GLint Shader::getUniformLocation(const std::string name) const {
-    return glGetUniformLocation(_program,name.c_str());
+GLint Shader::getUniformLocation(const std::string& name) const {
+    auto search = _uniformslots.find(name);
+    if (search != _uniformslots.end()) {
+        return _uniformtable[search->second].location;
+    } else if (name.find('[') != std::string::npos) {
+        // Individual array elements are not in the reflection table
+        return glGetUniformLocation(_program,name.c_str());
+    }
+    return -1;
 }
 
 /**
@@ -488,7 +659,7 @@ GLint Shader::getUniformLocation(const std::string name) const {
  *
  * @return the size (in bytes) of the given uniform
  */
-GLint Shader::getUniformSize(const std::string name) const {
+GLint Shader::getUniformSize(const std::string& name) const {
     auto search = _uniformsizes.find(name);
     if (search == _uniformsizes.end()) {
         return -1;
@@ -505,7 +676,7 @@ GLint Shader::getUniformSize(const std::string name) const {
  *
  * @return the type of the given uniform
  */
-GLenum Shader::getUniformType(const std::string name) const {
+GLenum Shader::getUniformType(const std::string& name) const {
     auto search = _uniformtypes.find(name);
     if (search == _uniformtypes.end()) {
         return GL_FALSE;
@@ -513,6 +684,43 @@ GLenum Shader::getUniformType(const std::string name) const {
     return search->second;
 }
 
+/**
+ * Returns a handle for the given uniform.
+ *
+ * The handle should be resolved once (such as when the shader is attached)
+ * and then used with the handle setters. If name is not an active uniform
+ * with a location, the handle is invalid.
+ *
+ * @param name  The uniform variable name
+ *
+ * @return a handle for the given uniform.
+ */
+Shader::UniformHandle Shader::getUniformHandle(const std::string& name) const {
+    UniformHandle result;
+    auto search = _uniformslots.find(name);
+    if (search != _uniformslots.end() && _uniformtable[search->second].location >= 0) {
+        result.location = _uniformtable[search->second].location;
+        result.slot = search->second;
+    }
+    return result;
+}
+
+
+#pragma mark -
+#pragma mark Shadow Cache
+/**
+ * Invalidates the shadow values of all uniforms.
+ *
+ * Every uniform setter compares the new value with the last value sent,
+ * and skips the OpenGL call if it is unchanged. Uniform values belong to
+ * the program, so this cache is correct as long as all uniforms are set
+ * through this class. Call this method if the program uniforms are ever
+ * modified with raw OpenGL calls.
+ */
+void Shader::invalidateUniforms() {
+    _shadowed.assign(_uniformtable.size(),false);
+}
+
 
 #pragma mark -
 #pragma mark Sampler Properties
@@ -548,8 +756,8 @@ std::vector<std::string> Shader::getSamplers() const {
  *
  * @return the program offset of the given sampler variable
  */
-GLint Shader::getSamplerLocation(const std::string name) const {
-    GLint result =  glGetUniformLocation(_program,name.c_str());
+GLint Shader::getSamplerLocation(const std::string& name) const {
+    GLint result = getUniformLocation(name);
     if (result != -1 && _uniformtypes.at(name) != GL_SAMPLER_2D) {
         result = -1;
     }
@@ -592,7 +800,7 @@ void Shader::setSampler(GLint pos, GLuint bpoint) {
  * @param name      The name of the sampler variable
  * @param bpoint   The bindpoint for the sampler
  */
-void Shader::setSampler(const std::string name, GLuint bpoint) {
+void Shader::setSampler(const std::string& name, GLuint bpoint) {
     setUniform1ui(name,bpoint);
 }
 
@@ -629,7 +837,7 @@ void Shader::setSampler(GLint pos, const std::shared_ptr<Texture>& texture) {
  * @param name      The name of the sampler variable
  * @param texture   The texture to initialize the bindpoint
  */
-void Shader::setSampler(const std::string name, const std::shared_ptr<Texture>& texture) {
+void Shader::setSampler(const std::string& name, const std::shared_ptr<Texture>& texture) {
     GLuint bpoint = texture == nullptr ? 0 : texture->getBindPoint();
     setUniform1ui(name,bpoint);
 }
@@ -662,7 +870,7 @@ GLuint Shader::getSampler(GLint pos) const {
  *
  * @return the texture bindpoint associated with the given sampler variable.
  */
-GLuint Shader::getSampler(const std::string name) const {
+GLuint Shader::getSampler(const std::string& name) const {
     GLuint result = 0;
     getUniformuiv(name,1,&result);
     return result;
@@ -773,7 +981,7 @@ void Shader::setUniformBlock(GLint pos, GLuint bindpoint) {
  * @param name      The name of the uniform block in the shader
  * @param bpoint   The bindpoint for the uniform block
  */
-void Shader::setUniformBlock(const std::string name, GLuint bindpoint) {
+void Shader::setUniformBlock(const std::string& name, GLuint bindpoint) {
     GLuint index = glGetUniformBlockIndex(_program, name.c_str());
     if (index != GL_INVALID_INDEX) {
         glUniformBlockBinding(_program, index, bindpoint);
@@ -804,7 +1012,7 @@ void Shader::setUniformBlock(GLint pos, const std::shared_ptr<UniformBuffer>& bu
     // Do some verification
     for(auto it = _uniblockfields.begin(); it != _uniblockfields.end(); ++it) {
         if (it->second == pos) {
-            const std::string name = _uniformnames.at(it->first);
+            const std::string& name = _uniformnames.at(it->first);
             GLsizei offset = buffer->getOffset(name);
             if (offset == cugl::UniformBuffer::INVALID_OFFSET) {
                 CUWarn("Uniform buffer is missing variable '%s'.",name.c_str());
@@ -850,7 +1058,7 @@ void Shader::setUniformBlock(GLint pos, const std::shared_ptr<UniformBuffer>& bu
  * @param name      The name of the uniform block in the shader
  * @param buffer    The buffer to bind to this uniform block
  */
-void Shader::setUniformBlock(const std::string name,
+void Shader::setUniformBlock(const std::string& name,
                              const std::shared_ptr<UniformBuffer>& buffer) {
     GLuint index = glGetUniformBlockIndex(_program, name.c_str());
     if (index != GL_INVALID_INDEX) {
@@ -886,7 +1094,7 @@ GLuint Shader::getUniformBlock(GLint pos) const {
  *
  * @return the buffer bindpoint associated with the given uniform block.
  */
-GLuint Shader::getUniformBlock(const std::string name) const {
+GLuint Shader::getUniformBlock(const std::string& name) const {
     GLuint index = glGetUniformBlockIndex(_program, name.c_str());
     if (index == GL_INVALID_INDEX) {
         return 0;
@@ -910,7 +1118,10 @@ GLuint Shader::getUniformBlock(const std::string name) const {
  */
 void Shader::setUniformVec2(GLint pos, const Vec2 vec) {
     CUAssertLog(isBound(), "Shader is not active.");
-    glUniform2f(pos,vec.x,vec.y);
+    const GLfloat data[2] = { vec.x, vec.y };
+    if (updateShadow(pos, data, sizeof(data))) {
+        glUniform2fv(pos, 1, data);
+    }
 }
 
 /**
@@ -921,10 +1132,9 @@ void Shader::setUniformVec2(GLint pos, const Vec2 vec) {
  * @param name  The name of the uniform
  * @param vec   The value for the uniform
  */
-void Shader::setUniformVec2(const std::string name, const Vec2 vec) {
-    CUAssertLog(isBound(), "Shader is not active.");
-    GLint locale = getUniformLocation(name.c_str());
-    if (locale >= 0) glUniform2f(locale,vec.x,vec.y);
+void Shader::setUniformVec2(const std::string& name, const Vec2 vec) {
+    GLint locale = getUniformLocation(name);
+    if (locale >= 0) setUniformVec2(locale, vec);
 }
 
 /**
@@ -954,7 +1164,7 @@ bool Shader::getUniformVec2(GLint pos, Vec2& vec) const {
  *
  * @return true if it can access the given uniform as a vector.
  */
-bool Shader::getUniformVec2(const std::string name, Vec2& vec) const {
+bool Shader::getUniformVec2(const std::string& name, Vec2& vec) const {
     float* data = reinterpret_cast<float*>(&vec);
     return getUniformfv(name, 2, data);
 }
@@ -969,7 +1179,10 @@ bool Shader::getUniformVec2(const std::string name, Vec2& vec) const {
  */
 void Shader::setUniformVec3(GLint pos, const Vec3 vec) {
     CUAssertLog(isBound(), "Shader is not active.");
-    glUniform3f(pos,vec.x,vec.y,vec.z);
+    const GLfloat data[3] = { vec.x, vec.y, vec.z };
+    if (updateShadow(pos, data, sizeof(data))) {
+        glUniform3fv(pos, 1, data);
+    }
 }
 
 /**
@@ -980,10 +1193,9 @@ void Shader::setUniformVec3(GLint pos, const Vec3 vec) {
  * @param name  The name of the uniform
  * @param vec   The value for the uniform
  */
-void Shader::setUniformVec3(const std::string name, const Vec3 vec) {
-    CUAssertLog(isBound(), "Shader is not active.");
-    GLint locale = getUniformLocation(name.c_str());
-    if (locale >= 0) glUniform3f(locale,vec.x,vec.y,vec.z);
+void Shader::setUniformVec3(const std::string& name, const Vec3 vec) {
+    GLint locale = getUniformLocation(name);
+    if (locale >= 0) setUniformVec3(locale, vec);
 }
 
 /**
@@ -1013,7 +1225,7 @@ bool Shader::getUniformVec3(GLint pos, Vec3& vec) const {
  *
  * @return true if it can access the given uniform as a vector.
  */
-bool Shader::getUniformVec3(const std::string name, Vec3& vec) const {
+bool Shader::getUniformVec3(const std::string& name, Vec3& vec) const {
     float* data = reinterpret_cast<float*>(&vec);
     return getUniformfv(name, 3, data);
 }
@@ -1028,7 +1240,10 @@ bool Shader::getUniformVec3(const std::string name, Vec3& vec) const {
  */
 void Shader::setUniformVec4(GLint pos, const Vec4 vec) {
     CUAssertLog(isBound(), "Shader is not active.");
-    glUniform4f(pos,vec.x,vec.y,vec.z,vec.w);
+    const GLfloat data[4] = { vec.x, vec.y, vec.z, vec.w };
+    if (updateShadow(pos, data, sizeof(data))) {
+        glUniform4fv(pos, 1, data);
+    }
 }
 
 /**
@@ -1039,10 +1254,9 @@ void Shader::setUniformVec4(GLint pos, const Vec4 vec) {
  * @param name  The name of the uniform
  * @param vec   The value for the uniform
  */
-void Shader::setUniformVec4(const std::string name, const Vec4 vec) {
-    CUAssertLog(isBound(), "Shader is not active.");
-    GLint locale = getUniformLocation(name.c_str());
-    if (locale >= 0) glUniform4f(locale,vec.x,vec.y,vec.z,vec.w);
+void Shader::setUniformVec4(const std::string& name, const Vec4 vec) {
+    GLint locale = getUniformLocation(name);
+    if (locale >= 0) setUniformVec4(locale, vec);
 }
 
 /**
@@ -1072,7 +1286,7 @@ bool Shader::getUniformVec4(GLint pos, Vec4& vec) const {
  *
  * @return true if it can access the given uniform as a vector.
  */
-bool Shader::getUniformVec4(const std::string name, Vec4& vec) const {
+bool Shader::getUniformVec4(const std::string& name, Vec4& vec) const {
     float* data = reinterpret_cast<float*>(&vec);
     return getUniformfv(name, 4, data);
 }
@@ -1097,7 +1311,7 @@ void Shader::setUniformColor4(GLint pos, const Color4 color) {
  * @param name      The name of the uniform
  * @param color   The value for the uniform
  */
-void Shader::setUniformColor4(const std::string name, const Color4 color) {
+void Shader::setUniformColor4(const std::string& name, const Color4 color) {
     setUniformVec4(name, (Vec4)color);
 }
 
@@ -1132,7 +1346,7 @@ bool Shader::getUniformColor4(GLint pos, Color4& color) const {
  *
  * @return true if it can access the given uniform as a color.
  */
-bool Shader::getUniformColor4(const std::string name, Color4& color) const {
+bool Shader::getUniformColor4(const std::string& name, Color4& color) const {
     float data[4];
     if (getUniformfv(name, 4, data)) {
         color.set(data);
@@ -1160,7 +1374,7 @@ void Shader::setUniformColor4f(GLint pos, const Color4f color) {
  * @param name      The name of the uniform
  * @param color   The value for the uniform
  */
-void Shader::setUniformColor4f(const std::string name, const Color4f color) {
+void Shader::setUniformColor4f(const std::string& name, const Color4f color) {
     setUniformVec4(name, (Vec4)color);
 }
 
@@ -1191,7 +1405,7 @@ bool Shader::getUniformColor4f(GLint pos, Color4f& color) const {
  *
  * @return true if it can access the given uniform as a color.
  */
-bool Shader::getUniformColor4f(const std::string name, Color4f& color) const {
+bool Shader::getUniformColor4f(const std::string& name, Color4f& color) const {
     float* data = reinterpret_cast<float*>(&color);
     return (getUniformfv(name, 4, data));
 }
@@ -1206,7 +1420,9 @@ bool Shader::getUniformColor4f(const std::string name, Color4f& color) const {
  */
 void Shader::setUniformMat4(GLint pos, const Mat4& mat) {
     CUAssertLog(isBound(), "Shader is not active.");
-    glUniformMatrix4fv(pos,1,false,mat.m);
+    if (updateShadow(pos, mat.m, 16*sizeof(GLfloat))) {
+        glUniformMatrix4fv(pos, 1, false, mat.m);
+    }
 }
 
 /**
@@ -1219,10 +1435,9 @@ void Shader::setUniformMat4(GLint pos, const Mat4& mat) {
  * @param name  The name of the uniform
  * @param mat   The value for the uniform
  */
-void Shader::setUniformMat4(const std::string name, const Mat4& mat) {
-    CUAssertLog(isBound(), "Shader is not active.");
-    GLint locale = getUniformLocation(name.c_str());
-    if (locale >= 0) glUniformMatrix4fv(locale,1,false,mat.m);
+void Shader::setUniformMat4(const std::string& name, const Mat4& mat) {
+    GLint locale = getUniformLocation(name);
+    if (locale >= 0) setUniformMat4(locale, mat);
 }
 
 /**
@@ -1251,7 +1466,7 @@ bool Shader::getUniformMat4(GLint pos, Mat4& mat) const {
  *
  * @return true if it can access the given uniform as a matrix.
  */
-bool Shader::getUniformMat4(const std::string name, Mat4& mat) const {
+bool Shader::getUniformMat4(const std::string& name, Mat4& mat) const {
     return getUniformfv(name, 16, mat.m);
 }
 
@@ -1270,7 +1485,9 @@ void Shader::setUniformAffine2(GLint pos, const Affine2& mat) {
     CUAssertLog(isBound(), "Shader is not active.");
     float data[9];
     mat.get3x3(data);
-    glUniformMatrix3fv(pos,1,false,data);
+    if (updateShadow(pos, data, 9*sizeof(GLfloat))) {
+        glUniformMatrix3fv(pos, 1, false, data);
+    }
 }
 
 /**
@@ -1284,14 +1501,9 @@ void Shader::setUniformAffine2(GLint pos, const Affine2& mat) {
  * @param name  The name of the uniform
  * @param mat   The value for the uniform
  */
-void Shader::setUniformAffine2(const std::string name, const Affine2& mat) {
-    CUAssertLog(isBound(), "Shader is not active.");
-    GLint locale = getUniformLocation(name.c_str());
-    if (locale >= 0) {
-        float data[9];
-        mat.get3x3(data);
-        glUniformMatrix3fv(locale,1,false,data);
-    }
+void Shader::setUniformAffine2(const std::string& name, const Affine2& mat) {
+    GLint locale = getUniformLocation(name);
+    if (locale >= 0) setUniformAffine2(locale, mat);
 }
 
 /**
@@ -1327,7 +1539,7 @@ bool Shader::getUniformAffine2(GLint pos, Affine2& mat) const {
  *
  * @return true if it can access the given uniform as an affine transform.
  */
-bool Shader::getUniformAffine2(const std::string name, Affine2& mat) const {
+bool Shader::getUniformAffine2(const std::string& name, Affine2& mat) const {
     float data[9];
     if (getUniformfv(name, 9, data)) {
         mat.set(data, 3);
@@ -1356,7 +1568,7 @@ void Shader::setUniformQuaternion(GLint pos, const Quaternion& quat) {
  * @param name  The name of the uniform
  * @param mat   The value for the uniform
  */
-void Shader::setUniformQuaternion(const std::string name, const Quaternion& quat) {
+void Shader::setUniformQuaternion(const std::string& name, const Quaternion& quat) {
     setUniformVec4(name, (Vec4)quat);
 }
 
@@ -1387,7 +1599,7 @@ bool Shader::getUniformQuaternion(GLint pos, Quaternion& quat) const {
  *
  * @return true if it can access the given uniform as a quaternion.
  */
-bool Shader::getUniformQuaternion(const std::string name, Quaternion& quat) const {
+bool Shader::getUniformQuaternion(const std::string& name, Quaternion& quat) const {
     float* data = reinterpret_cast<float*>(&quat);
     return getUniformfv(name, 4, data);
 }
@@ -1405,7 +1617,10 @@ bool Shader::getUniformQuaternion(const std::string name, Quaternion& quat) cons
  */
 void Shader::setUniform1f(GLint pos, GLfloat v0) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniform1f(pos, v0);
+	const GLfloat data[1] = { v0 };
+	if (updateShadow(pos, data, sizeof(data))) {
+		glUniform1fv(pos, 1, data);
+	}
 }
 
 /**
@@ -1418,10 +1633,9 @@ void Shader::setUniform1f(GLint pos, GLfloat v0) {
  * @param name  The name of the uniform
  * @param v0    The value for the uniform
  */
-void Shader::setUniform1f(const std::string name, GLfloat v0) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniform1f(locale, v0);
+void Shader::setUniform1f(const std::string& name, GLfloat v0) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniform1f(locale, v0);
 }
 
 /**
@@ -1435,7 +1649,10 @@ void Shader::setUniform1f(const std::string name, GLfloat v0) {
  */
 void Shader::setUniform2f(GLint pos, GLfloat v0, GLfloat v1) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniform2f(pos, v0, v1);
+	const GLfloat data[2] = { v0, v1 };
+	if (updateShadow(pos, data, sizeof(data))) {
+		glUniform2fv(pos, 1, data);
+	}
 }
 
 /**
@@ -1449,10 +1666,9 @@ void Shader::setUniform2f(GLint pos, GLfloat v0, GLfloat v1) {
  * @param v0    The first value for the uniform
  * @param v1    The second value for the uniform
  */
-void Shader::setUniform2f(const std::string name, GLfloat v0, GLfloat v1) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniform2f(locale, v0, v1);
+void Shader::setUniform2f(const std::string& name, GLfloat v0, GLfloat v1) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniform2f(locale, v0, v1);
 }
 
 /**
@@ -1467,7 +1683,10 @@ void Shader::setUniform2f(const std::string name, GLfloat v0, GLfloat v1) {
  */
 void Shader::setUniform3f(GLint pos, GLfloat v0, GLfloat v1, GLfloat v2) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniform3f(pos, v0, v1, v2);
+	const GLfloat data[3] = { v0, v1, v2 };
+	if (updateShadow(pos, data, sizeof(data))) {
+		glUniform3fv(pos, 1, data);
+	}
 }
 
 /**
@@ -1482,10 +1701,9 @@ void Shader::setUniform3f(GLint pos, GLfloat v0, GLfloat v1, GLfloat v2) {
  * @param v1    The second value for the uniform
  * @param v2    The third value for the uniform
  */
-void Shader::setUniform3f(const std::string name, GLfloat v0, GLfloat v1, GLfloat v2) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniform3f(locale, v0, v1, v2);
+void Shader::setUniform3f(const std::string& name, GLfloat v0, GLfloat v1, GLfloat v2) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniform3f(locale, v0, v1, v2);
 }
 
 /**
@@ -1501,7 +1719,10 @@ void Shader::setUniform3f(const std::string name, GLfloat v0, GLfloat v1, GLfloa
  */
 void Shader::setUniform4f(GLint pos, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniform4f(pos, v0, v1, v2, v3);
+	const GLfloat data[4] = { v0, v1, v2, v3 };
+	if (updateShadow(pos, data, sizeof(data))) {
+		glUniform4fv(pos, 1, data);
+	}
 }
 
 /**
@@ -1517,10 +1738,9 @@ void Shader::setUniform4f(GLint pos, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat
  * @param v2    The third value for the uniform
  * @param v3    The fourth value for the uniform
  */
-void Shader::setUniform4f(const std::string name, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniform4f(locale, v0, v1, v2, v3);
+void Shader::setUniform4f(const std::string& name, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniform4f(locale, v0, v1, v2, v3);
 }
 
 /**
@@ -1533,7 +1753,10 @@ void Shader::setUniform4f(const std::string name, GLfloat v0, GLfloat v1, GLfloa
  */
 void Shader::setUniform1i(GLint pos, GLint v0) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniform1i(pos, v0);
+	const GLint data[1] = { v0 };
+	if (updateShadow(pos, data, sizeof(data))) {
+		glUniform1iv(pos, 1, data);
+	}
 }
 
 /**
@@ -1546,10 +1769,9 @@ void Shader::setUniform1i(GLint pos, GLint v0) {
  * @param name  The name of the uniform
  * @param v0    The value for the uniform
  */
-void Shader::setUniform1i(const std::string name, GLint v0) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniform1i(locale, v0);
+void Shader::setUniform1i(const std::string& name, GLint v0) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniform1i(locale, v0);
 }
 
 /**
@@ -1563,7 +1785,10 @@ void Shader::setUniform1i(const std::string name, GLint v0) {
  */
 void Shader::setUniform2i(GLint pos, GLint v0, GLint v1) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniform2i(pos, v0, v1);
+	const GLint data[2] = { v0, v1 };
+	if (updateShadow(pos, data, sizeof(data))) {
+		glUniform2iv(pos, 1, data);
+	}
 }
 
 /**
@@ -1577,10 +1802,9 @@ void Shader::setUniform2i(GLint pos, GLint v0, GLint v1) {
  * @param v0    The first value for the uniform
  * @param v1    The second value for the uniform
  */
-void Shader::setUniform2i(const std::string name, GLint v0, GLint v1) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniform2i(locale, v0, v1);
+void Shader::setUniform2i(const std::string& name, GLint v0, GLint v1) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniform2i(locale, v0, v1);
 }
 
 /**
@@ -1595,7 +1819,10 @@ void Shader::setUniform2i(const std::string name, GLint v0, GLint v1) {
  */
 void Shader::setUniform3i(GLint pos, GLint v0, GLint v1, GLint v2) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniform3i(pos, v0, v1, v2);
+	const GLint data[3] = { v0, v1, v2 };
+	if (updateShadow(pos, data, sizeof(data))) {
+		glUniform3iv(pos, 1, data);
+	}
 }
 
 /**
@@ -1610,10 +1837,9 @@ void Shader::setUniform3i(GLint pos, GLint v0, GLint v1, GLint v2) {
  * @param v1    The second value for the uniform
  * @param v2    The third value for the uniform
  */
-void Shader::setUniform3i(const std::string name, GLint v0, GLint v1, GLint v2) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniform3i(locale, v0, v1, v2);
+void Shader::setUniform3i(const std::string& name, GLint v0, GLint v1, GLint v2) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniform3i(locale, v0, v1, v2);
 }
 
 /**
@@ -1629,7 +1855,10 @@ void Shader::setUniform3i(const std::string name, GLint v0, GLint v1, GLint v2)
  */
 void Shader::setUniform4i(GLint pos, GLint v0, GLint v1, GLint v2, GLint v3) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniform4i(pos, v0, v1, v2, v3);
+	const GLint data[4] = { v0, v1, v2, v3 };
+	if (updateShadow(pos, data, sizeof(data))) {
+		glUniform4iv(pos, 1, data);
+	}
 }
 
 /**
@@ -1645,10 +1874,9 @@ void Shader::setUniform4i(GLint pos, GLint v0, GLint v1, GLint v2, GLint v3) {
  * @param v2    The third value for the uniform
  * @param v3    The fourth value for the uniform
  */
-void Shader::setUniform4i(const std::string name, GLint v0, GLint v1, GLint v2, GLint v3) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniform4i(locale, v0, v1, v2, v3);
+void Shader::setUniform4i(const std::string& name, GLint v0, GLint v1, GLint v2, GLint v3) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniform4i(locale, v0, v1, v2, v3);
 }
 
 /**
@@ -1661,7 +1889,10 @@ void Shader::setUniform4i(const std::string name, GLint v0, GLint v1, GLint v2,
  */
 void Shader::setUniform1ui(GLint pos, GLuint v0) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniform1ui(pos, v0);
+	const GLuint data[1] = { v0 };
+	if (updateShadow(pos, data, sizeof(data))) {
+		glUniform1uiv(pos, 1, data);
+	}
 }
 
 /**
@@ -1674,10 +1905,9 @@ void Shader::setUniform1ui(GLint pos, GLuint v0) {
  * @param name  The name of the uniform
  * @param v0    The value for the uniform
  */
-void Shader::setUniform1ui(const std::string name, GLuint v0) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniform1ui(locale, v0);
+void Shader::setUniform1ui(const std::string& name, GLuint v0) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniform1ui(locale, v0);
 }
 
 /**
@@ -1691,7 +1921,10 @@ void Shader::setUniform1ui(const std::string name, GLuint v0) {
  */
 void Shader::setUniform2ui(GLint pos, GLuint v0, GLuint v1) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniform2ui(pos, v0, v1);
+	const GLuint data[2] = { v0, v1 };
+	if (updateShadow(pos, data, sizeof(data))) {
+		glUniform2uiv(pos, 1, data);
+	}
 }
 
 /**
@@ -1705,10 +1938,9 @@ void Shader::setUniform2ui(GLint pos, GLuint v0, GLuint v1) {
  * @param v0    The first value for the uniform
  * @param v1    The second value for the uniform
  */
-void Shader::setUniform2ui(const std::string name, GLuint v0, GLuint v1) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniform2ui(locale, v0, v1);
+void Shader::setUniform2ui(const std::string& name, GLuint v0, GLuint v1) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniform2ui(locale, v0, v1);
 }
 
 /**
@@ -1723,7 +1955,10 @@ void Shader::setUniform2ui(const std::string name, GLuint v0, GLuint v1) {
  */
 void Shader::setUniform3ui(GLint pos, GLuint v0, GLuint v1, GLuint v2) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniform3ui(pos, v0, v1, v2);
+	const GLuint data[3] = { v0, v1, v2 };
+	if (updateShadow(pos, data, sizeof(data))) {
+		glUniform3uiv(pos, 1, data);
+	}
 }
 
 /**
@@ -1738,10 +1973,9 @@ void Shader::setUniform3ui(GLint pos, GLuint v0, GLuint v1, GLuint v2) {
  * @param v1    The second value for the uniform
  * @param v2    The third value for the uniform
  */
-void Shader::setUniform3ui(const std::string name, GLuint v0, GLuint v1, GLuint v2) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniform3ui(locale, v0, v1, v2);
+void Shader::setUniform3ui(const std::string& name, GLuint v0, GLuint v1, GLuint v2) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniform3ui(locale, v0, v1, v2);
 }
 
 /**
@@ -1757,7 +1991,10 @@ void Shader::setUniform3ui(const std::string name, GLuint v0, GLuint v1, GLuint
  */
 void Shader::setUniform4ui(GLint pos, GLuint v0, GLuint v1, GLuint v2, GLuint v3) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniform4ui(pos, v0, v1, v2, v3);
+	const GLuint data[4] = { v0, v1, v2, v3 };
+	if (updateShadow(pos, data, sizeof(data))) {
+		glUniform4uiv(pos, 1, data);
+	}
 }
 
 /**
@@ -1773,10 +2010,9 @@ void Shader::setUniform4ui(GLint pos, GLuint v0, GLuint v1, GLuint v2, GLuint v3
  * @param v2    The third value for the uniform
  * @param v3    The fourth value for the uniform
  */
-void Shader::setUniform4ui(const std::string name, GLuint v0, GLuint v1, GLuint v2, GLuint v3) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniform4ui(locale, v0, v1, v2, v3);
+void Shader::setUniform4ui(const std::string& name, GLuint v0, GLuint v1, GLuint v2, GLuint v3) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniform4ui(locale, v0, v1, v2, v3);
 }
 
 /**
@@ -1790,7 +2026,9 @@ void Shader::setUniform4ui(const std::string name, GLuint v0, GLuint v1, GLuint
  */
 void Shader::setUniform1fv(GLint pos, GLsizei count, const GLfloat *value) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniform1fv(pos, count, value);
+	if (updateShadow(pos, value, count*sizeof(GLfloat))) {
+		glUniform1fv(pos, count, value);
+	}
 }
 
 /**
@@ -1804,10 +2042,9 @@ void Shader::setUniform1fv(GLint pos, GLsizei count, const GLfloat *value) {
  * @param count The number of elements in the array
  * @param value The array of floats
  */
-void Shader::setUniform1fv(const std::string name, GLsizei count, const GLfloat *value) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniform1fv(locale, count, value);
+void Shader::setUniform1fv(const std::string& name, GLsizei count, const GLfloat *value) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniform1fv(locale, count, value);
 }
 
 /**
@@ -1821,7 +2058,9 @@ void Shader::setUniform1fv(const std::string name, GLsizei count, const GLfloat
  */
 void Shader::setUniform2fv(GLint pos, GLsizei count, const GLfloat *value) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniform2fv(pos, count, value);
+	if (updateShadow(pos, value, count*2*sizeof(GLfloat))) {
+		glUniform2fv(pos, count, value);
+	}
 }
 
 /**
@@ -1835,10 +2074,9 @@ void Shader::setUniform2fv(GLint pos, GLsizei count, const GLfloat *value) {
  * @param count The number of elements in the array
  * @param value The array of floats
  */
-void Shader::setUniform2fv(const std::string name, GLsizei count, const GLfloat *value) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniform2fv(locale, count, value);
+void Shader::setUniform2fv(const std::string& name, GLsizei count, const GLfloat *value) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniform2fv(locale, count, value);
 }
 
 /**
@@ -1852,7 +2090,9 @@ void Shader::setUniform2fv(const std::string name, GLsizei count, const GLfloat
  */
 void Shader::setUniform3fv(GLint pos, GLsizei count, const GLfloat *value) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniform3fv(pos, count, value);
+	if (updateShadow(pos, value, count*3*sizeof(GLfloat))) {
+		glUniform3fv(pos, count, value);
+	}
 }
 
 /**
@@ -1866,10 +2106,9 @@ void Shader::setUniform3fv(GLint pos, GLsizei count, const GLfloat *value) {
  * @param count The number of elements in the array
  * @param value The array of floats
  */
-void Shader::setUniform3fv(const std::string name, GLsizei count, const GLfloat *value) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniform3fv(locale, count, value);
+void Shader::setUniform3fv(const std::string& name, GLsizei count, const GLfloat *value) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniform3fv(locale, count, value);
 }
 
 /**
@@ -1883,7 +2122,9 @@ void Shader::setUniform3fv(const std::string name, GLsizei count, const GLfloat
  */
 void Shader::setUniform4fv(GLint pos, GLsizei count, const GLfloat *value) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniform4fv(pos, count, value);
+	if (updateShadow(pos, value, count*4*sizeof(GLfloat))) {
+		glUniform4fv(pos, count, value);
+	}
 }
 
 /**
@@ -1897,10 +2138,9 @@ void Shader::setUniform4fv(GLint pos, GLsizei count, const GLfloat *value) {
  * @param count The number of elements in the array
  * @param value The array of floats
  */
-void Shader::setUniform4fv(const std::string name, GLsizei count, const GLfloat *value) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniform4fv(locale, count, value);
+void Shader::setUniform4fv(const std::string& name, GLsizei count, const GLfloat *value) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniform4fv(locale, count, value);
 }
 
 /**
@@ -1914,7 +2154,9 @@ void Shader::setUniform4fv(const std::string name, GLsizei count, const GLfloat
  */
 void Shader::setUniform1iv(GLint pos, GLsizei count, const GLint *value) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniform1iv(pos, count, value);
+	if (updateShadow(pos, value, count*sizeof(GLint))) {
+		glUniform1iv(pos, count, value);
+	}
 }
 
 /**
@@ -1928,10 +2170,9 @@ void Shader::setUniform1iv(GLint pos, GLsizei count, const GLint *value) {
  * @param count The number of elements in the array
  * @param value The array of ints
  */
-void Shader::setUniform1iv(const std::string name, GLsizei count, const GLint *value) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniform1iv(locale, count, value);
+void Shader::setUniform1iv(const std::string& name, GLsizei count, const GLint *value) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniform1iv(locale, count, value);
 }
 
 /**
@@ -1945,7 +2186,9 @@ void Shader::setUniform1iv(const std::string name, GLsizei count, const GLint *v
  */
 void Shader::setUniform2iv(GLint pos, GLsizei count, const GLint *value) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniform2iv(pos, count, value);
+	if (updateShadow(pos, value, count*2*sizeof(GLint))) {
+		glUniform2iv(pos, count, value);
+	}
 }
 
 /**
@@ -1959,10 +2202,9 @@ void Shader::setUniform2iv(GLint pos, GLsizei count, const GLint *value) {
  * @param count The number of elements in the array
  * @param value The array of ints
  */
-void Shader::setUniform2iv(const std::string name, GLsizei count, const GLint *value) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniform2iv(locale, count, value);
+void Shader::setUniform2iv(const std::string& name, GLsizei count, const GLint *value) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniform2iv(locale, count, value);
 }
 
 /**
@@ -1976,7 +2218,9 @@ void Shader::setUniform2iv(const std::string name, GLsizei count, const GLint *v
  */
 void Shader::setUniform3iv(GLint pos, GLsizei count, const GLint *value) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniform3iv(pos, count, value);
+	if (updateShadow(pos, value, count*3*sizeof(GLint))) {
+		glUniform3iv(pos, count, value);
+	}
 }
 
 /**
@@ -1990,10 +2234,9 @@ void Shader::setUniform3iv(GLint pos, GLsizei count, const GLint *value) {
  * @param count The number of elements in the array
  * @param value The array of ints
  */
-void Shader::setUniform3iv(const std::string name, GLsizei count, const GLint *value) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniform3iv(locale, count, value);
+void Shader::setUniform3iv(const std::string& name, GLsizei count, const GLint *value) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniform3iv(locale, count, value);
 }
 
 /**
@@ -2007,7 +2250,9 @@ void Shader::setUniform3iv(const std::string name, GLsizei count, const GLint *v
  */
 void Shader::setUniform4iv(GLint pos, GLsizei count, const GLint *value) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniform4iv(pos, count, value);
+	if (updateShadow(pos, value, count*4*sizeof(GLint))) {
+		glUniform4iv(pos, count, value);
+	}
 }
 
 /**
@@ -2021,10 +2266,9 @@ void Shader::setUniform4iv(GLint pos, GLsizei count, const GLint *value) {
  * @param count The number of elements in the array
  * @param value The array of ints
  */
-void Shader::setUniform4iv(const std::string name, GLsizei count, const GLint *value) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniform4iv(locale, count, value);
+void Shader::setUniform4iv(const std::string& name, GLsizei count, const GLint *value) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniform4iv(locale, count, value);
 }
 
 /**
@@ -2038,7 +2282,9 @@ void Shader::setUniform4iv(const std::string name, GLsizei count, const GLint *v
  */
 void Shader::setUniform1uiv(GLint pos, GLsizei count, const GLuint *value) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniform1uiv(pos, count, value);
+	if (updateShadow(pos, value, count*sizeof(GLuint))) {
+		glUniform1uiv(pos, count, value);
+	}
 }
 
 /**
@@ -2052,10 +2298,9 @@ void Shader::setUniform1uiv(GLint pos, GLsizei count, const GLuint *value) {
  * @param count The number of elements in the array
  * @param value The array of unsigned ints
  */
-void Shader::setUniform1uiv(const std::string name, GLsizei count, const GLuint *value) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniform1uiv(locale, count, value);
+void Shader::setUniform1uiv(const std::string& name, GLsizei count, const GLuint *value) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniform1uiv(locale, count, value);
 }
 
 /**
@@ -2069,7 +2314,9 @@ void Shader::setUniform1uiv(const std::string name, GLsizei count, const GLuint
  */
 void Shader::setUniform2uiv(GLint pos, GLsizei count, const GLuint *value) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniform2uiv(pos, count, value);
+	if (updateShadow(pos, value, count*2*sizeof(GLuint))) {
+		glUniform2uiv(pos, count, value);
+	}
 }
 
 /**
@@ -2083,10 +2330,9 @@ void Shader::setUniform2uiv(GLint pos, GLsizei count, const GLuint *value) {
  * @param count The number of elements in the array
  * @param value The array of unsigned ints
  */
-void Shader::setUniform2uiv(const std::string name, GLsizei count, const GLuint *value) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniform2uiv(locale, count, value);
+void Shader::setUniform2uiv(const std::string& name, GLsizei count, const GLuint *value) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniform2uiv(locale, count, value);
 }
 
 /**
@@ -2100,7 +2346,9 @@ void Shader::setUniform2uiv(const std::string name, GLsizei count, const GLuint
  */
 void Shader::setUniform3uiv(GLint pos, GLsizei count, const GLuint *value) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniform3uiv(pos, count, value);
+	if (updateShadow(pos, value, count*3*sizeof(GLuint))) {
+		glUniform3uiv(pos, count, value);
+	}
 }
 
 /**
@@ -2114,10 +2362,9 @@ void Shader::setUniform3uiv(GLint pos, GLsizei count, const GLuint *value) {
  * @param count The number of elements in the array
  * @param value The array of unsigned ints
  */
-void Shader::setUniform3uiv(const std::string name, GLsizei count, const GLuint *value) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniform3uiv(locale, count, value);
+void Shader::setUniform3uiv(const std::string& name, GLsizei count, const GLuint *value) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniform3uiv(locale, count, value);
 }
 
 /**
@@ -2131,7 +2378,9 @@ void Shader::setUniform3uiv(const std::string name, GLsizei count, const GLuint
  */
 void Shader::setUniform4uiv(GLint pos, GLsizei count, const GLuint *value) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniform4uiv(pos, count, value);
+	if (updateShadow(pos, value, count*4*sizeof(GLuint))) {
+		glUniform4uiv(pos, count, value);
+	}
 }
 
 /**
@@ -2145,10 +2394,9 @@ void Shader::setUniform4uiv(GLint pos, GLsizei count, const GLuint *value) {
  * @param count The number of elements in the array
  * @param value The array of unsigned ints
  */
-void Shader::setUniform4uiv(const std::string name, GLsizei count, const GLuint *value) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniform4uiv(locale, count, value);
+void Shader::setUniform4uiv(const std::string& name, GLsizei count, const GLuint *value) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniform4uiv(locale, count, value);
 }
 
 /**
@@ -2163,7 +2411,9 @@ void Shader::setUniform4uiv(const std::string name, GLsizei count, const GLuint
  */
 void Shader::setUniformMatrix2fv(GLint pos, GLsizei count, const GLfloat *value, GLboolean tpose) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniformMatrix2fv(pos, count, tpose, value);
+	if (updateShadow(pos, value, count*2*2*sizeof(GLfloat), !tpose)) {
+		glUniformMatrix2fv(pos, count, tpose, value);
+	}
 }
 
 /**
@@ -2178,10 +2428,9 @@ void Shader::setUniformMatrix2fv(GLint pos, GLsizei count, const GLfloat *value,
  * @param value The array of matrices
  * @param tpose Whether to transpose the matrices
  */
-void Shader::setUniformMatrix2fv(const std::string name, GLsizei count, const GLfloat *value, GLboolean tpose) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniformMatrix2fv(locale, count, tpose, value);
+void Shader::setUniformMatrix2fv(const std::string& name, GLsizei count, const GLfloat *value, GLboolean tpose) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniformMatrix2fv(locale, count, value, tpose);
 }
 
 /**
@@ -2196,7 +2445,9 @@ void Shader::setUniformMatrix2fv(const std::string name, GLsizei count, const GL
  */
 void Shader::setUniformMatrix3fv(GLint pos, GLsizei count, const GLfloat *value, GLboolean tpose) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniformMatrix3fv(pos, count, tpose, value);
+	if (updateShadow(pos, value, count*3*3*sizeof(GLfloat), !tpose)) {
+		glUniformMatrix3fv(pos, count, tpose, value);
+	}
 }
 
 /**
@@ -2211,10 +2462,9 @@ void Shader::setUniformMatrix3fv(GLint pos, GLsizei count, const GLfloat *value,
  * @param value The array of matrices
  * @param tpose Whether to transpose the matrices
  */
-void Shader::setUniformMatrix3fv(const std::string name, GLsizei count, const GLfloat *value, GLboolean tpose) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniformMatrix3fv(locale, count, tpose, value);
+void Shader::setUniformMatrix3fv(const std::string& name, GLsizei count, const GLfloat *value, GLboolean tpose) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniformMatrix3fv(locale, count, value, tpose);
 }
 
 /**
@@ -2229,7 +2479,9 @@ void Shader::setUniformMatrix3fv(const std::string name, GLsizei count, const GL
  */
 void Shader::setUniformMatrix4fv(GLint pos, GLsizei count, const GLfloat *value, GLboolean tpose) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniformMatrix4fv(pos, count, tpose, value);
+	if (updateShadow(pos, value, count*4*4*sizeof(GLfloat), !tpose)) {
+		glUniformMatrix4fv(pos, count, tpose, value);
+	}
 }
 
 /**
@@ -2244,10 +2496,9 @@ void Shader::setUniformMatrix4fv(GLint pos, GLsizei count, const GLfloat *value,
  * @param value The array of matrices
  * @param tpose Whether to transpose the matrices
  */
-void Shader::setUniformMatrix4fv(const std::string name, GLsizei count, const GLfloat *value, GLboolean tpose) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniformMatrix4fv(locale, count, tpose, value);
+void Shader::setUniformMatrix4fv(const std::string& name, GLsizei count, const GLfloat *value, GLboolean tpose) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniformMatrix4fv(locale, count, value, tpose);
 }
 
 /**
@@ -2262,7 +2513,9 @@ void Shader::setUniformMatrix4fv(const std::string name, GLsizei count, const GL
  */
 void Shader::setUniformMatrix2x3fv(GLint pos, GLsizei count, const GLfloat *value, GLboolean tpose) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniformMatrix2x3fv(pos, count, tpose, value);
+	if (updateShadow(pos, value, count*2*3*sizeof(GLfloat), !tpose)) {
+		glUniformMatrix2x3fv(pos, count, tpose, value);
+	}
 }
 
 /**
@@ -2277,10 +2530,9 @@ void Shader::setUniformMatrix2x3fv(GLint pos, GLsizei count, const GLfloat *valu
  * @param value The array of matrices
  * @param tpose Whether to transpose the matrices
  */
-void Shader::setUniformMatrix2x3fv(const std::string name, GLsizei count, const GLfloat *value, GLboolean tpose) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniformMatrix2x3fv(locale, count, tpose, value);
+void Shader::setUniformMatrix2x3fv(const std::string& name, GLsizei count, const GLfloat *value, GLboolean tpose) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniformMatrix2x3fv(locale, count, value, tpose);
 }
 
 /**
@@ -2295,7 +2547,9 @@ void Shader::setUniformMatrix2x3fv(const std::string name, GLsizei count, const
  */
 void Shader::setUniformMatrix3x2fv(GLint pos, GLsizei count, const GLfloat *value, GLboolean tpose) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniformMatrix3x2fv(pos, count, tpose, value);
+	if (updateShadow(pos, value, count*3*2*sizeof(GLfloat), !tpose)) {
+		glUniformMatrix3x2fv(pos, count, tpose, value);
+	}
 }
 
 /**
@@ -2310,10 +2564,9 @@ void Shader::setUniformMatrix3x2fv(GLint pos, GLsizei count, const GLfloat *valu
  * @param value The array of matrices
  * @param tpose Whether to transpose the matrices
  */
-void Shader::setUniformMatrix3x2fv(const std::string name, GLsizei count, const GLfloat *value, GLboolean tpose) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniformMatrix3x2fv(locale, count, tpose, value);
+void Shader::setUniformMatrix3x2fv(const std::string& name, GLsizei count, const GLfloat *value, GLboolean tpose) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniformMatrix3x2fv(locale, count, value, tpose);
 }
 
 /**
@@ -2328,7 +2581,9 @@ void Shader::setUniformMatrix3x2fv(const std::string name, GLsizei count, const
  */
 void Shader::setUniformMatrix2x4fv(GLint pos, GLsizei count, const GLfloat *value, GLboolean tpose) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniformMatrix2x4fv(pos, count, tpose, value);
+	if (updateShadow(pos, value, count*2*4*sizeof(GLfloat), !tpose)) {
+		glUniformMatrix2x4fv(pos, count, tpose, value);
+	}
 }
 
 /**
@@ -2343,10 +2598,9 @@ void Shader::setUniformMatrix2x4fv(GLint pos, GLsizei count, const GLfloat *valu
  * @param value The array of matrices
  * @param tpose Whether to transpose the matrices
  */
-void Shader::setUniformMatrix2x4fv(const std::string name, GLsizei count, const GLfloat *value, GLboolean tpose) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniformMatrix2x4fv(locale, count, tpose, value);
+void Shader::setUniformMatrix2x4fv(const std::string& name, GLsizei count, const GLfloat *value, GLboolean tpose) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniformMatrix2x4fv(locale, count, value, tpose);
 }
 
 /**
@@ -2361,7 +2615,9 @@ void Shader::setUniformMatrix2x4fv(const std::string name, GLsizei count, const
  */
 void Shader::setUniformMatrix4x2fv(GLint pos, GLsizei count, const GLfloat *value, GLboolean tpose) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniformMatrix4x2fv(pos, count, tpose, value);
+	if (updateShadow(pos, value, count*4*2*sizeof(GLfloat), !tpose)) {
+		glUniformMatrix4x2fv(pos, count, tpose, value);
+	}
 }
 
 /**
@@ -2376,10 +2632,9 @@ void Shader::setUniformMatrix4x2fv(GLint pos, GLsizei count, const GLfloat *valu
  * @param value The array of matrices
  * @param tpose Whether to transpose the matrices
  */
-void Shader::setUniformMatrix4x2fv(const std::string name, GLsizei count, const GLfloat *value, GLboolean tpose) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniformMatrix4x2fv(locale, count, tpose, value);
+void Shader::setUniformMatrix4x2fv(const std::string& name, GLsizei count, const GLfloat *value, GLboolean tpose) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniformMatrix4x2fv(locale, count, value, tpose);
 }
 
 /**
@@ -2394,7 +2649,9 @@ void Shader::setUniformMatrix4x2fv(const std::string name, GLsizei count, const
  */
 void Shader::setUniformMatrix3x4fv(GLint pos, GLsizei count, const GLfloat *value, GLboolean tpose) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniformMatrix3x4fv(pos, count, tpose, value);
+	if (updateShadow(pos, value, count*3*4*sizeof(GLfloat), !tpose)) {
+		glUniformMatrix3x4fv(pos, count, tpose, value);
+	}
 }
 
 /**
@@ -2409,10 +2666,9 @@ void Shader::setUniformMatrix3x4fv(GLint pos, GLsizei count, const GLfloat *valu
  * @param value The array of matrices
  * @param tpose Whether to transpose the matrices
  */
-void Shader::setUniformMatrix3x4fv(const std::string name, GLsizei count, const GLfloat *value, GLboolean tpose) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-	if (locale >= 0) glUniformMatrix3x4fv(locale, count, tpose, value);
+void Shader::setUniformMatrix3x4fv(const std::string& name, GLsizei count, const GLfloat *value, GLboolean tpose) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniformMatrix3x4fv(locale, count, value, tpose);
 }
 
 /**
@@ -2427,7 +2683,9 @@ void Shader::setUniformMatrix3x4fv(const std::string name, GLsizei count, const
  */
 void Shader::setUniformMatrix4x3fv(GLint pos, GLsizei count, const GLfloat *value, GLboolean tpose) {
 	CUAssertLog(isBound(), "Shader is not active.");
-	glUniformMatrix4x3fv(pos, count, tpose, value);
+	if (updateShadow(pos, value, count*4*3*sizeof(GLfloat), !tpose)) {
+		glUniformMatrix4x3fv(pos, count, tpose, value);
+	}
 }
 
 /**
@@ -2442,10 +2700,9 @@ void Shader::setUniformMatrix4x3fv(GLint pos, GLsizei count, const GLfloat *valu
  * @param value The array of matrices
  * @param tpose Whether to transpose the matrices
  */
-void Shader::setUniformMatrix4x3fv(const std::string name, GLsizei count, const GLfloat *value, GLboolean tpose) {
-	CUAssertLog(isBound(), "Shader is not active.");
-	GLint locale = getUniformLocation(name.c_str());
-    if (locale >= 0) glUniformMatrix4x3fv(locale, count, tpose, value);
+void Shader::setUniformMatrix4x3fv(const std::string& name, GLsizei count, const GLfloat *value, GLboolean tpose) {
+	GLint locale = getUniformLocation(name);
+	if (locale >= 0) setUniformMatrix4x3fv(locale, count, value, tpose);
 }
 
 /**
@@ -2478,7 +2735,7 @@ bool Shader::getUniformfv(GLint pos, GLsizei size, GLfloat *value) const {
  *
  * @return true if data was successfully read into value
  */
-bool Shader::getUniformfv(const std::string name, GLsizei size, GLfloat *value) const {
+bool Shader::getUniformfv(const std::string& name, GLsizei size, GLfloat *value) const {
     CUAssertLog(isBound(), "Shader is not active.");
     GLint locale = getUniformLocation(name.c_str());
     if (locale >= 0) {
@@ -2518,7 +2775,7 @@ bool Shader::getUniformiv(GLint pos, GLsizei size, GLint *value) const {
  *
  * @return true if data was successfully read into value
  */
-bool Shader::getUniformiv(const std::string name, GLsizei size, GLint *value) const {
+bool Shader::getUniformiv(const std::string& name, GLsizei size, GLint *value) const {
     CUAssertLog(isBound(), "Shader is not active.");
     GLint locale = getUniformLocation(name.c_str());
     if (locale >= 0) {
@@ -2558,7 +2815,7 @@ bool Shader::getUniformuiv(GLint pos, GLsizei size, GLuint *value) const {
  *
  * @return true if data was successfully read into value
  */
-bool Shader::getUniformuiv(const std::string name, GLsizei size, GLuint *value) const {
+bool Shader::getUniformuiv(const std::string& name, GLsizei size, GLuint *value) const {
     CUAssertLog(isBound(), "Shader is not active.");
     GLint locale = getUniformLocation(name.c_str());
     if (locale >= 0) {
@@ -2568,3 +2825,122 @@ bool Shader::getUniformuiv(const std::string name, GLsizei size, GLuint *value)
     return false;
 }
 
+
+#pragma mark -
+#pragma mark Handle Uniforms
+/**
+ * Sets the given uniform to a single float value.
+ *
+ * This method will only succeed if the shader is actively bound. It will
+ * silently fail (with no error) if the handle is invalid.
+ *
+ * @param handle    The uniform handle
+ * @param v0        The value for the uniform
+ */
+void Shader::setUniform1f(const UniformHandle& handle, GLfloat v0) {
+    CUAssertLog(isBound(), "Shader is not active.");
+    if (handle.isValid() && updateSlot(handle.slot, &v0, sizeof(GLfloat))) {
+        glUniform1f(handle.location, v0);
+    }
+}
+
+/**
+ * Sets the given uniform to a pair of float values.
+ *
+ * This method will only succeed if the shader is actively bound. It will
+ * silently fail (with no error) if the handle is invalid.
+ *
+ * @param handle    The uniform handle
+ * @param v0        The first value for the uniform
+ * @param v1        The second value for the uniform
+ */
+void Shader::setUniform2f(const UniformHandle& handle, GLfloat v0, GLfloat v1) {
+    CUAssertLog(isBound(), "Shader is not active.");
+    const GLfloat data[2] = { v0, v1 };
+    if (handle.isValid() && updateSlot(handle.slot, data, sizeof(data))) {
+        glUniform2fv(handle.location, 1, data);
+    }
+}
+
+/**
+ * Sets the given uniform to a single int value.
+ *
+ * This method will only succeed if the shader is actively bound. It will
+ * silently fail (with no error) if the handle is invalid.
+ *
+ * @param handle    The uniform handle
+ * @param v0        The value for the uniform
+ */
+void Shader::setUniform1i(const UniformHandle& handle, GLint v0) {
+    CUAssertLog(isBound(), "Shader is not active.");
+    if (handle.isValid() && updateSlot(handle.slot, &v0, sizeof(GLint))) {
+        glUniform1i(handle.location, v0);
+    }
+}
+
+/**
+ * Sets the given uniform to a vector value.
+ *
+ * This method will only succeed if the shader is actively bound. It will
+ * silently fail (with no error) if the handle is invalid.
+ *
+ * @param handle    The uniform handle
+ * @param vec       The value for the uniform
+ */
+void Shader::setUniformVec2(const UniformHandle& handle, const Vec2 vec) {
+    setUniform2f(handle, vec.x, vec.y);
+}
+
+/**
+ * Sets the given uniform to a vector value.
+ *
+ * This method will only succeed if the shader is actively bound. It will
+ * silently fail (with no error) if the handle is invalid.
+ *
+ * @param handle    The uniform handle
+ * @param vec       The value for the uniform
+ */
+void Shader::setUniformVec4(const UniformHandle& handle, const Vec4 vec) {
+    CUAssertLog(isBound(), "Shader is not active.");
+    const GLfloat data[4] = { vec.x, vec.y, vec.z, vec.w };
+    if (handle.isValid() && updateSlot(handle.slot, data, sizeof(data))) {
+        glUniform4fv(handle.location, 1, data);
+    }
+}
+
+/**
+ * Sets the given uniform to a matrix value.
+ *
+ * This method will only succeed if the shader is actively bound. It will
+ * silently fail (with no error) if the handle is invalid.
+ *
+ * @param handle    The uniform handle
+ * @param mat       The value for the uniform
+ */
+void Shader::setUniformMat4(const UniformHandle& handle, const Mat4& mat) {
+    CUAssertLog(isBound(), "Shader is not active.");
+    if (handle.isValid() && updateSlot(handle.slot, mat.m, 16*sizeof(GLfloat))) {
+        glUniformMatrix4fv(handle.location, 1, false, mat.m);
+    }
+}
+
+/**
+ * Sets the given uniform to an affine transform.
+ *
+ * Affine transforms are passed to a shader as a 3x3 matrix on
+ * homogenous coordinates.
+ *
+ * This method will only succeed if the shader is actively bound. It will
+ * silently fail (with no error) if the handle is invalid.
+ *
+ * @param handle    The uniform handle
+ * @param mat       The value for the uniform
+ */
+void Shader::setUniformAffine2(const UniformHandle& handle, const Affine2& mat) {
+    CUAssertLog(isBound(), "Shader is not active.");
+    float data[9];
+    mat.get3x3(data);
+    if (handle.isValid() && updateSlot(handle.slot, data, sizeof(data))) {
+        glUniformMatrix3fv(handle.location, 1, false, data);
+    }
+}
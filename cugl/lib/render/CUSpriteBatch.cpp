@@ -49,11 +49,13 @@
 #include <cugl/render/CUVertexBuffer.h>
 #include <cugl/render/CUTexture.h>
 #include <cugl/render/CUShader.h>
+#include <cugl/render/CUGLState.h>
 #include <cugl/render/CUGradient.h>
 #include <cugl/render/CUScissor.h>
 #include <cugl/render/CUFont.h>
 #include <cugl/render/CUGlyphRun.h>
 #include <cugl/render/CUTextLayout.h>
+#include <cstring>
 
 /**
  * Default fragment shader
@@ -210,23 +212,7 @@ public:
      * @param copy  The uniforms to copy
      */
     Context(Context* copy) {
-        first = copy->first;
-        last  = copy->last;
-        type  = copy->type;
-        command  = copy->command;
-        blendEq  = copy->blendEq;
-        srcRGB   = copy->srcRGB;
-        srcAlpha = copy->srcAlpha;
-        dstRGB   = copy->dstRGB;
-        dstAlpha = copy->dstAlpha;
-        perspective = copy->perspective;
-        stencil  = copy->stencil;
-        cleared  = STENCIL_NONE; // DO NOT COPY
-        texture  = copy->texture;
-        blockptr = copy->blockptr;
-        zDepth = copy->zDepth;
-        blur  = copy->blur;
-        dirty = 0;
+        set(copy);
     }
     
     /**
@@ -251,6 +237,34 @@ public:
         type = 0;
     }
     
+    /**
+     * Sets this context to be a copy of the given uniforms
+     *
+     * This has the same semantics as the copy constructor. It allows a
+     * recycled context to be reused without allocation.
+     *
+     * @param copy  The uniforms to copy
+     */
+    void set(Context* copy) {
+        first = copy->first;
+        last  = copy->last;
+        type  = copy->type;
+        command  = copy->command;
+        blendEq  = copy->blendEq;
+        srcRGB   = copy->srcRGB;
+        srcAlpha = copy->srcAlpha;
+        dstRGB   = copy->dstRGB;
+        dstAlpha = copy->dstAlpha;
+        perspective = copy->perspective;
+        stencil  = copy->stencil;
+        cleared  = STENCIL_NONE; // DO NOT COPY
+        texture  = copy->texture;
+        blockptr = copy->blockptr;
+        zDepth = copy->zDepth;
+        blur  = copy->blur;
+        dirty = 0;
+    }
+    
     /**
      *
      * Resets this context to its default values
@@ -358,11 +372,18 @@ void SpriteBatch::dispose() {
     if (_context != nullptr) {
         delete _context; _context = nullptr;
     }
+    unwind();
+    for(auto it = _contextpool.begin(); it != _contextpool.end(); ++it) {
+        delete *it;
+    }
+    _contextpool.clear();
     _shader = nullptr;
     _vertbuff = nullptr;
     _unifbuff = nullptr;
     _gradient = nullptr;
     _scissor  = nullptr;
+    _meshpool.clear();
+    _glyphruns.clear();
     
     _vertMax  = 0;
     _vertSize = 0;
@@ -491,6 +512,7 @@ bool SpriteBatch::init(unsigned int capacity, const std::shared_ptr<Shader>& sha
     _unifbuff->setOffset("gdFeathr", 156);
 
     _shader->setUniformBlock("uContext",_unifbuff);
+    resolveUniforms();
     
     _context = new Context();
     _context->dirty = DIRTY_ALL_VALS;
@@ -529,6 +551,7 @@ void SpriteBatch::setShader(const std::shared_ptr<Shader>& shader) {
     _shader = shader;
     _vertbuff->attach(_shader);
     _shader->setUniformBlock("uContext", _unifbuff);
+    resolveUniforms();
 }
 
 
@@ -1090,9 +1113,9 @@ void SpriteBatch::clearHalfStencil(bool lower) {
  * Calling this method will reset the vertex and OpenGL call counters to 0.
  */
 void SpriteBatch::begin() {
-    glDisable(GL_CULL_FACE);
-    glDepthMask(true);
-    glEnable(GL_BLEND);
+    GLState::disable(GL_CULL_FACE);
+    GLState::depthMask(true);
+    GLState::enable(GL_BLEND);
 
     // DO NOT CLEAR.  This responsibility lies elsewhere
     _shader->bind();
@@ -1117,8 +1140,8 @@ void SpriteBatch::end() {
     _context->dirty = DIRTY_ALL_VALS;
 
     // Undo any active stencil effects
-    glDisable(GL_STENCIL_TEST);
-    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    GLState::disable(GL_STENCIL_TEST);
+    GLState::colorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
     
     _shader->unbind();
     _active = false;
@@ -1155,23 +1178,23 @@ void SpriteBatch::flush() {
     for(auto it = _history.begin(); it != _history.end(); ++it) {
         Context* next = *it;
         if (next->dirty & DIRTY_BLENDEQUATION) {
-            glBlendEquation(next->blendEq);
+            GLState::blendEquation(next->blendEq);
         }
         if (next->dirty & DIRTY_SRC_FUNCTION || next->dirty & DIRTY_DST_FUNCTION) {
             if (next->srcRGB != next->srcAlpha || next->dstRGB != next->dstAlpha ) {
-                glBlendFuncSeparate(next->srcRGB, next->srcAlpha, next->dstRGB, next->dstAlpha);
+                GLState::blendFuncSeparate(next->srcRGB, next->dstRGB, next->srcAlpha, next->dstAlpha);
             } else {
-                glBlendFunc(next->srcRGB, next->dstRGB);
+                GLState::blendFunc(next->srcRGB, next->dstRGB);
             }
         }
         if (next->dirty & DIRTY_DEPTHVALUE) {
-            _shader->setUniform1f("uDepth", 0);
+            _shader->setUniform1f(_uDepth, 0);
         }
         if (next->dirty & DIRTY_DRAWTYPE) {
-             _shader->setUniform1i("uType", next->type);
+            _shader->setUniform1i(_uType, next->type);
         }
         if (next->dirty & DIRTY_PERSPECTIVE) {
-            _shader->setUniformMat4("uPerspective",*(next->perspective.get()));
+            _shader->setUniformMat4(_uPerspective,*(next->perspective.get()));
         }
         if (next->dirty & DIRTY_TEXTURE) {
             previous = next->texture;
@@ -2378,6 +2401,46 @@ void SpriteBatch::drawMesh(const Mesh<SpriteVertex2>& mesh, const Affine2& trans
     }
 }
 
+/**
+ * Draws the given mesh with the current texture and/or gradient, recycling it.
+ *
+ * This method is identical to the version taking a mesh reference, except
+ * that the sprite batch takes ownership of the mesh. Once it is drawn, its
+ * buffers are returned to the mesh pool of this sprite batch, so that they
+ * may be reused by {@link #acquireMesh}. This is the preferred way to draw
+ * transient meshes, such as those created each frame.
+ *
+ * It is unsafe to use the original mesh after this method is called.
+ *
+ * @param mesh      The sprite mesh
+ * @param offset    The coordinate offset for the mesh
+ * @param tint      Whether to tint with the active color
+ */
+void SpriteBatch::drawMesh(Mesh<SpriteVertex2>&& mesh, const Vec2 offset, bool tint) {
+    drawMesh(static_cast<const Mesh<SpriteVertex2>&>(mesh),offset,tint);
+    _meshpool.recycle(std::move(mesh));
+}
+
+/**
+ * Draws the given mesh with the current texture and/or gradient, recycling it.
+ *
+ * This method is identical to the version taking a mesh reference, except
+ * that the sprite batch takes ownership of the mesh. Once it is drawn, its
+ * buffers are returned to the mesh pool of this sprite batch, so that they
+ * may be reused by {@link #acquireMesh}. This is the preferred way to draw
+ * transient meshes, such as those created each frame.
+ *
+ * It is unsafe to use the original mesh after this method is called.
+ *
+ * @param mesh      The sprite mesh
+ * @param transform The coordinate transform
+ * @param tint      Whether to tint with the active color
+ */
+void SpriteBatch::drawMesh(Mesh<SpriteVertex2>&& mesh, const Affine2& transform, bool tint) {
+    drawMesh(static_cast<const Mesh<SpriteVertex2>&>(mesh),transform,tint);
+    _meshpool.recycle(std::move(mesh));
+}
+
 /**
  * Draws the vertices in a triangle fan with the current texture and/or gradient.
  *
@@ -2464,13 +2527,10 @@ void SpriteBatch::drawMesh(const SpriteVertex2* vertices, size_t size, const Aff
  * @param font      The font to render the text
  * @param position  The left edge of the text baseline
  */
-void SpriteBatch::drawText(const std::string text, const std::shared_ptr<Font>& font, const Vec2 position) {
-    std::unordered_map<GLuint, std::shared_ptr<GlyphRun>> runs;
-    font->getGlyphs(runs, text, position);
-    for(auto it = runs.begin(); it != runs.end(); ++it) {
-        setTexture(it->second->texture);
-        drawMesh(it->second->mesh,Vec2::ZERO);
-    }
+void SpriteBatch::drawText(const std::string& text, const std::shared_ptr<Font>& font, const Vec2 position) {
+    clearGlyphRuns();
+    font->getGlyphs(_glyphruns, text, position);
+    drawGlyphRuns(Affine2::IDENTITY);
 }
 
 /**
@@ -2492,13 +2552,10 @@ void SpriteBatch::drawText(const std::string text, const std::shared_ptr<Font>&
  * @param origin    The rotational origin relative to the baseline
  * @param transform The coordinate transform
  */
-void SpriteBatch::drawText(const std::string text, const std::shared_ptr<Font>& font, const Vec2 origin, const Affine2& transform) {
-    std::unordered_map<GLuint, std::shared_ptr<GlyphRun>> runs;
-    font->getGlyphs(runs, text, -origin);
-    for(auto it = runs.begin(); it != runs.end(); ++it) {
-        setTexture(it->second->texture);
-        drawMesh(it->second->mesh,transform);
-    }
+void SpriteBatch::drawText(const std::string& text, const std::shared_ptr<Font>& font, const Vec2 origin, const Affine2& transform) {
+    clearGlyphRuns();
+    font->getGlyphs(_glyphruns, text, -origin);
+    drawGlyphRuns(transform);
 }
 
 /**
@@ -2520,12 +2577,11 @@ void SpriteBatch::drawText(const std::string text, const std::shared_ptr<Font>&
  * @param transform The coordinate transform
  */
 void SpriteBatch::drawText(const std::shared_ptr<TextLayout>& text, const Vec2 position) {
-    std::unordered_map<GLuint, std::shared_ptr<GlyphRun>> runs;
-    text->getGlyphs(runs);
-    for(auto it = runs.begin(); it != runs.end(); ++it) {
-        setTexture(it->second->texture);
-        drawMesh(it->second->mesh,position);
-    }
+    clearGlyphRuns();
+    text->getGlyphs(_glyphruns);
+    Affine2 transform;
+    transform.translate(position);
+    drawGlyphRuns(transform);
 }
 
 /**
@@ -2546,12 +2602,9 @@ void SpriteBatch::drawText(const std::shared_ptr<TextLayout>& text, const Vec2 p
  * @param transform The coordinate transform
  */
 void SpriteBatch::drawText(const std::shared_ptr<TextLayout>& text, const Affine2& transform) {
-    std::unordered_map<GLuint, std::shared_ptr<GlyphRun>> runs;
-    text->getGlyphs(runs);
-    for(auto it = runs.begin(); it != runs.end(); ++it) {
-        setTexture(it->second->texture);
-        drawMesh(it->second->mesh,transform);
-    }
+    clearGlyphRuns();
+    text->getGlyphs(_glyphruns);
+    drawGlyphRuns(transform);
 }
 
 #pragma mark -
@@ -2564,7 +2617,14 @@ void SpriteBatch::drawText(const std::shared_ptr<TextLayout>& text, const Affine
  * will use the correct set of uniforms.
  */
 void SpriteBatch::record() {
-    Context* next = new Context(_context);
+    Context* next;
+    if (_contextpool.empty()) {
+        next = new Context(_context);
+    } else {
+        next = _contextpool.back();
+        _contextpool.pop_back();
+        next->set(_context);
+    }
     _context->last = _indxSize;
     next->first = _indxSize;
     _history.push_back(_context);
@@ -2573,17 +2633,56 @@ void SpriteBatch::record() {
 }
 
 /**
- * Deletes the recorded uniforms.
+ * Releases the recorded uniforms.
  *
- * This method is called upon flushing or cleanup.
+ * The contexts are returned to a pool to be reused by {@link #record}, so
+ * that a batch does not allocate contexts once it has warmed up. This
+ * method is called upon flushing or cleanup.
  */
 void SpriteBatch::unwind() {
     for(auto it = _history.begin(); it != _history.end(); ++it) {
-        delete *it;
+        (*it)->perspective = nullptr;
+        (*it)->texture = nullptr;
+        _contextpool.push_back(*it);
     }
     _history.clear();
 }
 
+/**
+ * Clears the glyph runs used by drawText for reuse.
+ *
+ * The meshes keep their capacity, so the next call to drawText does not
+ * allocate. The glyph contents are not cleared, as they are never read
+ * by this class and clearing them would release their storage. Runs for
+ * one-time atlases (whose texture is no longer referenced by any font)
+ * are removed.
+ */
+void SpriteBatch::clearGlyphRuns() {
+    for(auto it = _glyphruns.begin(); it != _glyphruns.end(); ) {
+        if (it->second->texture.use_count() <= 1) {
+            it = _glyphruns.erase(it);
+        } else {
+            it->second->mesh.vertices.clear();
+            it->second->mesh.indices.clear();
+            ++it;
+        }
+    }
+}
+
+/**
+ * Draws the glyph runs used by drawText with the given transform.
+ *
+ * @param transform The coordinate transform
+ */
+void SpriteBatch::drawGlyphRuns(const Affine2& transform) {
+    for(auto it = _glyphruns.begin(); it != _glyphruns.end(); ++it) {
+        if (!it->second->mesh.indices.empty()) {
+            setTexture(it->second->texture);
+            drawMesh(it->second->mesh, transform);
+        }
+    }
+}
+
 /**
  * Sets the active uniform block to agree with the gradient and stroke.
  *
@@ -2613,6 +2712,19 @@ void SpriteBatch::setUniformBlock(Context* context) {
     _unifbuff->setUniformfv(_context->blockptr,0,40,data);
 }
 
+/**
+ * Resolves the uniform handles of the current shader.
+ *
+ * This method is called whenever the shader is assigned, so that the
+ * uniforms are never looked up by name while flushing.
+ */
+void SpriteBatch::resolveUniforms() {
+    _uPerspective = _shader->getUniformHandle("uPerspective");
+    _uType  = _shader->getUniformHandle("uType");
+    _uDepth = _shader->getUniformHandle("uDepth");
+    _uBlur  = _shader->getUniformHandle("uBlur");
+}
+
 /**
  * Updates the shader with the current blur offsets
  *
@@ -2627,13 +2739,13 @@ void SpriteBatch::setUniformBlock(Context* context) {
  */
 void SpriteBatch::blurTexture(const std::shared_ptr<Texture>& texture, GLfloat step) {
     if (texture == nullptr) {
-        _shader->setUniform2f("uBlur", 0, 0);
+        _shader->setUniform2f(_uBlur, 0, 0);
         return;
     }
     Size size = texture->getSize();
     size.width  = step/size.width;
     size.height = step/size.height;
-    _shader->setUniform2f("uBlur",size.width,size.height);
+    _shader->setUniform2f(_uBlur,size.width,size.height);
 }
 
 /**
@@ -2646,17 +2758,17 @@ void SpriteBatch::clearStencilBuffer(GLenum buffer) {
         case STENCIL_NONE:
             return;
         case STENCIL_LOWER:
-            glStencilMask(0xf0);
+            GLState::stencilMask(0xf0);
             glClear(GL_STENCIL_BUFFER_BIT);
-            glStencilMask(0xff);
+            GLState::stencilMask(0xff);
             return;
         case STENCIL_UPPER:
-            glStencilMask(0x0f);
+            GLState::stencilMask(0x0f);
             glClear(GL_STENCIL_BUFFER_BIT);
-            glStencilMask(0xff);
+            GLState::stencilMask(0xff);
             return;
         case STENCIL_BOTH:
-            glStencilMask(0xff);
+            GLState::stencilMask(0xff);
             glClear(GL_STENCIL_BUFFER_BIT);
             return;
     }
@@ -2675,343 +2787,343 @@ void SpriteBatch::applyEffect(StencilEffect effect) {
             // Nothing more to do
             break;
         case NONE:
-            glDisable(GL_STENCIL_TEST);
-            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            GLState::disable(GL_STENCIL_TEST);
+            GLState::colorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
             break;
         case CLIP:
         case CLIP_JOIN:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0xff);
-            glStencilFunc(GL_NOTEQUAL, 0x00, 0xff);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
-            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0xff);
+            GLState::stencilFunc(GL_NOTEQUAL, 0x00, 0xff);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+            GLState::colorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
             break;
         case MASK:
         case MASK_JOIN:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0xff);
-            glStencilFunc(GL_EQUAL, 0x00, 0xff);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
-            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0xff);
+            GLState::stencilFunc(GL_EQUAL, 0x00, 0xff);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+            GLState::colorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
             break;
         case FILL:
         case FILL_JOIN:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0xff);
-            glStencilFunc(GL_NOTEQUAL, 0x00, 0xff);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_ZERO);
-            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0xff);
+            GLState::stencilFunc(GL_NOTEQUAL, 0x00, 0xff);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_ZERO);
+            GLState::colorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
             break;
         case WIPE:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0xff);
-            glStencilFunc(GL_ALWAYS, 0x00, 0xff);
-            glStencilOp(GL_ZERO, GL_ZERO, GL_ZERO);
-            glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0xff);
+            GLState::stencilFunc(GL_ALWAYS, 0x00, 0xff);
+            GLState::stencilOp(GL_ZERO, GL_ZERO, GL_ZERO);
+            GLState::colorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
             break;
         case STAMP:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0xff);
-            glStencilFunc(GL_ALWAYS, 0x00, 0xff);
-            glStencilOpSeparate(GL_FRONT, GL_KEEP, GL_KEEP, GL_INCR_WRAP);
-            glStencilOpSeparate(GL_BACK, GL_KEEP, GL_KEEP, GL_DECR_WRAP);
-            glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0xff);
+            GLState::stencilFunc(GL_ALWAYS, 0x00, 0xff);
+            GLState::stencilOpSeparate(GL_FRONT, GL_KEEP, GL_KEEP, GL_INCR_WRAP);
+            GLState::stencilOpSeparate(GL_BACK, GL_KEEP, GL_KEEP, GL_DECR_WRAP);
+            GLState::colorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
             break;
         case CARVE:
         case CARVE_NONE:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0xf0);
-            glStencilFunc(GL_EQUAL, 0x00, 0xf0);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
-            glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0xf0);
+            GLState::stencilFunc(GL_EQUAL, 0x00, 0xf0);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
+            GLState::colorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
             break;
         case CLAMP:
         case CLAMP_NONE:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0xf0);
-            glStencilFunc(GL_EQUAL, 0x00, 0xf0);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
-            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0xf0);
+            GLState::stencilFunc(GL_EQUAL, 0x00, 0xf0);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
+            GLState::colorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
             break;
         case NONE_CLIP:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0x0f);
-            glStencilFunc(GL_NOTEQUAL, 0x00, 0x0f);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
-            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0x0f);
+            GLState::stencilFunc(GL_NOTEQUAL, 0x00, 0x0f);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+            GLState::colorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
             break;
         case NONE_MASK:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0x0f);
-            glStencilFunc(GL_EQUAL, 0x00, 0x0f);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
-            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0x0f);
+            GLState::stencilFunc(GL_EQUAL, 0x00, 0x0f);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+            GLState::colorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
             break;
         case NONE_FILL:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0x0f);
-            glStencilFunc(GL_NOTEQUAL, 0x00, 0x0f);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_ZERO);
-            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0x0f);
+            GLState::stencilFunc(GL_NOTEQUAL, 0x00, 0x0f);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_ZERO);
+            GLState::colorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
             break;
         case NONE_WIPE:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0x0f);
-            glStencilFunc(GL_ALWAYS, 0x00, 0x0f);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_ZERO);
-            glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0x0f);
+            GLState::stencilFunc(GL_ALWAYS, 0x00, 0x0f);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_ZERO);
+            GLState::colorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
             break;
         case NONE_STAMP:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0x0f);
-            glStencilFunc(GL_ALWAYS, 0x00, 0x0f);
-            glStencilOpSeparate(GL_FRONT, GL_KEEP, GL_KEEP, GL_INVERT);
-            glStencilOpSeparate(GL_BACK, GL_KEEP, GL_KEEP, GL_INVERT);
-            glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0x0f);
+            GLState::stencilFunc(GL_ALWAYS, 0x00, 0x0f);
+            GLState::stencilOpSeparate(GL_FRONT, GL_KEEP, GL_KEEP, GL_INVERT);
+            GLState::stencilOpSeparate(GL_BACK, GL_KEEP, GL_KEEP, GL_INVERT);
+            GLState::colorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
             break;
         case NONE_CARVE:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0x0f);
-            glStencilFunc(GL_EQUAL, 0x00, 0x0f);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
-            glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0x0f);
+            GLState::stencilFunc(GL_EQUAL, 0x00, 0x0f);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
+            GLState::colorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
             break;
         case NONE_CLAMP:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0x0f);
-            glStencilFunc(GL_EQUAL, 0x00, 0x0f);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
-            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0x0f);
+            GLState::stencilFunc(GL_EQUAL, 0x00, 0x0f);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
+            GLState::colorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
             break;
         case CLIP_NONE:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0xff);
-            glStencilFunc(GL_NOTEQUAL, 0x00, 0xf0);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
-            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0xff);
+            GLState::stencilFunc(GL_NOTEQUAL, 0x00, 0xf0);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+            GLState::colorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
             break;
         case CLIP_MEET:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0xff);
-            glStencilFunc(GL_EQUAL, 0xff, 0xff);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
-            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0xff);
+            GLState::stencilFunc(GL_EQUAL, 0xff, 0xff);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+            GLState::colorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
             break;
         case CLIP_MASK:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0xff);
-            glStencilFunc(GL_EQUAL, 0xf0, 0xff);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
-            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0xff);
+            GLState::stencilFunc(GL_EQUAL, 0xf0, 0xff);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+            GLState::colorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
             break;
         case CLIP_FILL:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0x0f);
-            glStencilFunc(GL_NOTEQUAL, 0x00, 0xff);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_ZERO);
-            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0x0f);
+            GLState::stencilFunc(GL_NOTEQUAL, 0x00, 0xff);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_ZERO);
+            GLState::colorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
             break;
         case CLIP_WIPE:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0x0f);
-            glStencilFunc(GL_NOTEQUAL, 0x00, 0xf0);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_ZERO);
-            glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0x0f);
+            GLState::stencilFunc(GL_NOTEQUAL, 0x00, 0xf0);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_ZERO);
+            GLState::colorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
             break;
         case CLIP_STAMP:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0x0f);
-            glStencilFunc(GL_NOTEQUAL, 0x00, 0xf0);
-            glStencilOpSeparate(GL_FRONT, GL_KEEP, GL_KEEP, GL_INVERT);
-            glStencilOpSeparate(GL_BACK, GL_KEEP, GL_KEEP, GL_INVERT);
-            glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0x0f);
+            GLState::stencilFunc(GL_NOTEQUAL, 0x00, 0xf0);
+            GLState::stencilOpSeparate(GL_FRONT, GL_KEEP, GL_KEEP, GL_INVERT);
+            GLState::stencilOpSeparate(GL_BACK, GL_KEEP, GL_KEEP, GL_INVERT);
+            GLState::colorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
             break;
         case CLIP_CARVE:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0x0f);
-            glStencilFunc(GL_EQUAL, 0xf0, 0xff);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
-            glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0x0f);
+            GLState::stencilFunc(GL_EQUAL, 0xf0, 0xff);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
+            GLState::colorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
             break;
         case CLIP_CLAMP:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0x0f);
-            glStencilFunc(GL_EQUAL, 0xf0, 0xff);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
-            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0x0f);
+            GLState::stencilFunc(GL_EQUAL, 0xf0, 0xff);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
+            GLState::colorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
             break;
         case MASK_NONE:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0xff);
-            glStencilFunc(GL_EQUAL, 0x00, 0xf0);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
-            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0xff);
+            GLState::stencilFunc(GL_EQUAL, 0x00, 0xf0);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+            GLState::colorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
             break;
         case MASK_MEET:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0xff);
-            glStencilFunc(GL_NOTEQUAL, 0xff, 0xff);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
-            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0xff);
+            GLState::stencilFunc(GL_NOTEQUAL, 0xff, 0xff);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+            GLState::colorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
             break;
         case MASK_CLIP:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0xff);
-            glStencilFunc(GL_EQUAL, 0x0f, 0xff);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
-            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0xff);
+            GLState::stencilFunc(GL_EQUAL, 0x0f, 0xff);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+            GLState::colorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
             break;
         case MASK_FILL:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0x0f);
-            glStencilFunc(GL_EQUAL, 0x0f, 0xff);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_ZERO);
-            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0x0f);
+            GLState::stencilFunc(GL_EQUAL, 0x0f, 0xff);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_ZERO);
+            GLState::colorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
             break;
         case MASK_WIPE:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0x0f);
-            glStencilFunc(GL_EQUAL, 0x00, 0xf0);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_ZERO);
-            glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0x0f);
+            GLState::stencilFunc(GL_EQUAL, 0x00, 0xf0);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_ZERO);
+            GLState::colorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
             break;
         case MASK_STAMP:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0x0f);
-            glStencilFunc(GL_EQUAL, 0x00, 0xf0);
-            glStencilOpSeparate(GL_FRONT, GL_KEEP, GL_KEEP, GL_INVERT);
-            glStencilOpSeparate(GL_BACK, GL_KEEP, GL_KEEP, GL_INVERT);
-            glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0x0f);
+            GLState::stencilFunc(GL_EQUAL, 0x00, 0xf0);
+            GLState::stencilOpSeparate(GL_FRONT, GL_KEEP, GL_KEEP, GL_INVERT);
+            GLState::stencilOpSeparate(GL_BACK, GL_KEEP, GL_KEEP, GL_INVERT);
+            GLState::colorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
             break;
         case MASK_CARVE:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0x0f);
-            glStencilFunc(GL_EQUAL, 0x0, 0xff);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
-            glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0x0f);
+            GLState::stencilFunc(GL_EQUAL, 0x0, 0xff);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
+            GLState::colorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
             break;
         case MASK_CLAMP:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0x0f);
-            glStencilFunc(GL_EQUAL, 0x00, 0xff);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
-            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0x0f);
+            GLState::stencilFunc(GL_EQUAL, 0x00, 0xff);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
+            GLState::colorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
             break;
         case FILL_NONE:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0xf0);
-            glStencilFunc(GL_NOTEQUAL, 0x00, 0xf0);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_ZERO);
-            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0xf0);
+            GLState::stencilFunc(GL_NOTEQUAL, 0x00, 0xf0);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_ZERO);
+            GLState::colorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
             break;
         case FILL_MEET:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0xf0);
-            glStencilFunc(GL_EQUAL, 0xff, 0xff);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_ZERO);
-            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0xf0);
+            GLState::stencilFunc(GL_EQUAL, 0xff, 0xff);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_ZERO);
+            GLState::colorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
             break;
         case FILL_CLIP:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0xf0);
-            glStencilFunc(GL_EQUAL, 0xff, 0xff);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_ZERO);
-            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0xf0);
+            GLState::stencilFunc(GL_EQUAL, 0xff, 0xff);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_ZERO);
+            GLState::colorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
             break;
         case FILL_MASK:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0xf0);
-            glStencilFunc(GL_EQUAL, 0xf0, 0xff);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_ZERO);
-            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0xf0);
+            GLState::stencilFunc(GL_EQUAL, 0xf0, 0xff);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_ZERO);
+            GLState::colorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
             break;
         case WIPE_NONE:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0xf0);
-            glStencilFunc(GL_ALWAYS, 0x00, 0xf0);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_ZERO);
-            glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0xf0);
+            GLState::stencilFunc(GL_ALWAYS, 0x00, 0xf0);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_ZERO);
+            GLState::colorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
             break;
         case WIPE_CLIP:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0xf0);
-            glStencilFunc(GL_NOTEQUAL, 0x00, 0x0f);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_ZERO);
-            glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0xf0);
+            GLState::stencilFunc(GL_NOTEQUAL, 0x00, 0x0f);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_ZERO);
+            GLState::colorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
             break;
         case WIPE_MASK:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0xf0);
-            glStencilFunc(GL_EQUAL, 0x00, 0x0f);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_ZERO);
-            glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0xf0);
+            GLState::stencilFunc(GL_EQUAL, 0x00, 0x0f);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_ZERO);
+            GLState::colorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
             break;
         case STAMP_NONE:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0xf0);
-            glStencilFunc(GL_ALWAYS, 0x00, 0x0f);
-            glStencilOpSeparate(GL_FRONT, GL_KEEP, GL_KEEP, GL_INVERT);
-            glStencilOpSeparate(GL_BACK, GL_KEEP, GL_KEEP, GL_INVERT);
-            glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0xf0);
+            GLState::stencilFunc(GL_ALWAYS, 0x00, 0x0f);
+            GLState::stencilOpSeparate(GL_FRONT, GL_KEEP, GL_KEEP, GL_INVERT);
+            GLState::stencilOpSeparate(GL_BACK, GL_KEEP, GL_KEEP, GL_INVERT);
+            GLState::colorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
             break;
         case STAMP_CLIP:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0xf0);
-            glStencilFunc(GL_NOTEQUAL, 0x00, 0x0f);
-            glStencilOpSeparate(GL_FRONT, GL_KEEP, GL_KEEP, GL_INVERT);
-            glStencilOpSeparate(GL_BACK, GL_KEEP, GL_KEEP, GL_INVERT);
-            glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0xf0);
+            GLState::stencilFunc(GL_NOTEQUAL, 0x00, 0x0f);
+            GLState::stencilOpSeparate(GL_FRONT, GL_KEEP, GL_KEEP, GL_INVERT);
+            GLState::stencilOpSeparate(GL_BACK, GL_KEEP, GL_KEEP, GL_INVERT);
+            GLState::colorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
             break;
         case STAMP_MASK:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0xf0);
-            glStencilFunc(GL_EQUAL, 0x00, 0x0f);
-            glStencilOpSeparate(GL_FRONT, GL_KEEP, GL_KEEP, GL_INVERT);
-            glStencilOpSeparate(GL_BACK, GL_KEEP, GL_KEEP, GL_INVERT);
-            glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0xf0);
+            GLState::stencilFunc(GL_EQUAL, 0x00, 0x0f);
+            GLState::stencilOpSeparate(GL_FRONT, GL_KEEP, GL_KEEP, GL_INVERT);
+            GLState::stencilOpSeparate(GL_BACK, GL_KEEP, GL_KEEP, GL_INVERT);
+            GLState::colorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
             break;
         case STAMP_BOTH:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0xff);
-            glStencilFunc(GL_ALWAYS, 0x00, 0xff);
-            glStencilOpSeparate(GL_FRONT, GL_KEEP, GL_KEEP, GL_INVERT);
-            glStencilOpSeparate(GL_BACK, GL_KEEP, GL_KEEP, GL_INVERT);
-            glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0xff);
+            GLState::stencilFunc(GL_ALWAYS, 0x00, 0xff);
+            GLState::stencilOpSeparate(GL_FRONT, GL_KEEP, GL_KEEP, GL_INVERT);
+            GLState::stencilOpSeparate(GL_BACK, GL_KEEP, GL_KEEP, GL_INVERT);
+            GLState::colorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
             break;
         case CARVE_CLIP:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0xf0);
-            glStencilFunc(GL_NOTEQUAL, 0x0f, 0xff);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
-            glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0xf0);
+            GLState::stencilFunc(GL_NOTEQUAL, 0x0f, 0xff);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
+            GLState::colorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
             break;
         case CARVE_MASK:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0xf0);
-            glStencilFunc(GL_EQUAL, 0x0f, 0xff);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
-            glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0xf0);
+            GLState::stencilFunc(GL_EQUAL, 0x0f, 0xff);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
+            GLState::colorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
             break;
         case CARVE_BOTH:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0xff);
-            glStencilFunc(GL_EQUAL, 0x00, 0xff);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
-            glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0xff);
+            GLState::stencilFunc(GL_EQUAL, 0x00, 0xff);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
+            GLState::colorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
             break;
         case CLAMP_CLIP:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0xf0);
-            glStencilFunc(GL_EQUAL, 0x0f, 0xff);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
-            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0xf0);
+            GLState::stencilFunc(GL_EQUAL, 0x0f, 0xff);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
+            GLState::colorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
             break;
         case CLAMP_MASK:
-            glEnable(GL_STENCIL_TEST);
-            glStencilMask(0xf0);
-            glStencilFunc(GL_EQUAL, 0x00, 0xff);
-            glStencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
-            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            GLState::enable(GL_STENCIL_TEST);
+            GLState::stencilMask(0xf0);
+            GLState::stencilFunc(GL_EQUAL, 0x00, 0xff);
+            GLState::stencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
+            GLState::colorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
             break;
     }
 }
@@ -3496,18 +3608,19 @@ unsigned int SpriteBatch::prepare(const Mesh<SpriteVertex2>& mesh, const Affine2
     setUniformBlock(_context);
     int ii = 0;
     tint = tint && _color != Color4::WHITE;
-    for(auto it = mesh.vertices.begin(); it != mesh.vertices.end(); ++it) {
-        _vertData[_vertSize+ii] = *it;
-        _vertData[_vertSize+ii].position = it->position*mat;
-        if (tint) {
-            Uint32 c = marshall(_vertData[_vertSize+ii].color);
-            Uint32 r = round(_color.r*((c >> 24)/255.0f));
-            Uint32 g = round(_color.g*(((c >> 16) & 0xff)/255.0f));
-            Uint32 b = round(_color.b*(((c >> 8) & 0xff)/255.0f));
-            Uint32 a = round(_color.a*((c & 0xff)/255.0f));
-            _vertData[_vertSize+ii].color = marshall(r << 24 | g << 16 | b << 8 | a);
+    if (!tint && mat.isIdentity()) {
+        // Pre-transformed vertices (e.g. from a SpriteCache) are a block copy
+        ii = (int)mesh.vertices.size();
+        std::memcpy(_vertData+_vertSize, mesh.vertices.data(), ii*sizeof(SpriteVertex2));
+    } else {
+        for(auto it = mesh.vertices.begin(); it != mesh.vertices.end(); ++it) {
+            _vertData[_vertSize+ii] = *it;
+            _vertData[_vertSize+ii].position = it->position*mat;
+            if (tint) {
+                _vertData[_vertSize+ii].color = tintColor(it->color,_color);
+            }
+            ii++;
         }
-        ii++;
     }
     
     int jj = 0;
@@ -3558,9 +3671,7 @@ unsigned int SpriteBatch::chunkify(const Mesh<SpriteVertex2>& mesh, const Affine
                 _vertData[_vertSize] = mesh.vertices[ii+jj];
                 _vertData[_vertSize].position *= mat;
                 if (tint) {
-                    Color4 shade(_vertData[_vertSize].color);
-                    shade *= _color;
-                    _vertData[_vertSize].color = shade.getPacked();
+                    _vertData[_vertSize].color = tintColor(_vertData[_vertSize].color,_color);
                 }
                 _vertSize++;
             }
@@ -3610,12 +3721,7 @@ unsigned int SpriteBatch::prepare(const SpriteVertex2* vertices, size_t size, co
         _vertData[_vertSize+ii] = vertices[kk];
         _vertData[_vertSize+ii].position = vertices[kk].position*mat;
         if (tint) {
-            Uint32 c = marshall(_vertData[_vertSize+ii].color);
-            Uint32 r = round(_color.r*((c >> 24)/255.0f));
-            Uint32 g = round(_color.g*(((c >> 16) & 0xff)/255.0f));
-            Uint32 b = round(_color.b*(((c >> 8) & 0xff)/255.0f));
-            Uint32 a = round(_color.a*((c & 0xff)/255.0f));
-            _vertData[_vertSize+ii].color = marshall(r << 24 | g << 16 | b << 8 | a);
+            _vertData[_vertSize+ii].color = tintColor(vertices[kk].color,_color);
         }
         ii++;
     }
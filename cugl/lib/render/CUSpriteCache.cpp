@@ -0,0 +1,82 @@
+//
+//  CUSpriteCache.cpp
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides a cache of pre-transformed, pre-tinted sprite
+//  vertices. Scene graph nodes like NinePatch and Label already cache their
+//  meshes, but SpriteBatch still has to transform and tint every vertex on
+//  every frame. Most UI widgets do not move between frames, so this cache
+//  stores the final vertices and hands them to the batch as a block copy.
+//
+//  Unlike most classes in CUGL, this class is designed to be used on the
+//  stack (or as a field), like Mesh. It has no static constructors.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#include <cugl/render/CUSpriteCache.h>
+#include <cugl/render/CUSpriteBatch.h>
+
+using namespace cugl;
+
+/**
+ * Returns true if the cache may be drawn for this transform and tint.
+ *
+ * If the transform and tint match the previous call, the cache is built
+ * (if necessary) from the source mesh and this method returns true. The
+ * owner should then draw {@link #getMesh} with the identity transform
+ * and no tint. Otherwise, this method records the new transform and tint
+ * and returns false, and the owner should draw the source mesh as usual.
+ *
+ * @param source    The source mesh
+ * @param transform The global transform
+ * @param tint      The tint color
+ *
+ * @return true if the cache may be drawn for this transform and tint.
+ */
+bool SpriteCache::update(const Mesh<SpriteVertex2>& source, const Affine2& transform, Color4 tint) {
+    if (_state == 0 || _tint != tint || _transform != transform) {
+        _transform = transform;
+        _tint = tint;
+        _state = 1;
+        return false;
+    } else if (_state == 2) {
+        return true;
+    }
+
+    // Same as SpriteBatch, which skips the tint for white
+    bool shade = tint != Color4::WHITE;
+    size_t size = source.vertices.size();
+    _mesh.vertices.resize(size);
+    for(size_t ii = 0; ii < size; ii++) {
+        const SpriteVertex2& vert = source.vertices[ii];
+        _mesh.vertices[ii] = vert;
+        _mesh.vertices[ii].position = vert.position*transform;
+        if (shade) {
+            _mesh.vertices[ii].color = SpriteBatch::tintColor(vert.color,tint);
+        }
+    }
+    _mesh.indices = source.indices;
+    _mesh.command = source.command;
+    _state = 2;
+    return true;
+}
@@ -67,6 +67,9 @@ using namespace cugl::strtool;
  */
 static UnicodeType classify(Uint32 code, Uint32 pcode) {
     // Quick checks
+    if (code > 32 && code < 127) {
+        return UnicodeType::CHAR;
+    }
     switch (code) {
         case 10:        // \n
             return pcode == 13 ? UnicodeType::SPACE : UnicodeType::NEWLINE;
@@ -186,8 +189,7 @@ bool TextLayout::initWithWidth(float width) {
  */
 bool TextLayout::initWithText(const std::string text, const std::shared_ptr<Font>& font) {
     _text = text;
-    std::string::iterator end_it = utf8::find_invalid(_text.begin(), _text.end());
-    if (end_it == _text.end()) {
+    if (strtool::isValidUTF8(_text)) {
         _font = font;
         return true;
     }
@@ -217,8 +219,7 @@ bool TextLayout::initWithText(const std::string text, const std::shared_ptr<Font
  */
 bool TextLayout::initWithTextWidth(const std::string text, const std::shared_ptr<Font>& font, float width) {
     _text = text;
-    std::string::iterator end_it = utf8::find_invalid(_text.begin(), _text.end());
-    if (end_it == _text.end()) {
+    if (strtool::isValidUTF8(_text)) {
         _font = font;
         _breakline = width;
         return true;
@@ -240,8 +241,7 @@ bool TextLayout::initWithTextWidth(const std::string text, const std::shared_ptr
 void TextLayout::setText(const std::string text) {
     invalidate();
     _text = text;
-    std::string::iterator end_it = utf8::find_invalid(_text.begin(), _text.end());
-    CUAssertLog(end_it == _text.end(),"String '%s' has an invalid UTF-8 encoding",text.c_str());
+    CUAssertLog(strtool::isValidUTF8(_text),"String '%s' has an invalid UTF-8 encoding",text.c_str());
 }
 
 /**
@@ -403,7 +403,7 @@ const Rect TextLayout::getTrueBounds() const {
         bool start = true;
         size_t tpos = 0;
         while (begin != end) {
-            ccode = utf8::next(begin, end);
+            ccode = strtool::nextCodePoint(begin, end);
             if (_font->hasGlyph(ccode)) {
                 metrics = _font->getMetrics(ccode);
                 if (start) {
@@ -513,7 +513,7 @@ Rect TextLayout::getGlyphBounds(size_t index) const {
     const char* begin = cursr;
     const char* end   = _text.c_str()+row->end;
     Uint32 pcode = 0;
-    Uint32 ccode = utf8::next(begin,end);
+    Uint32 ccode = strtool::nextCodePoint(begin,end);
     if (!_font->hasGlyph(ccode)) {
         return Rect::ZERO;
     }
@@ -530,7 +530,7 @@ Rect TextLayout::getGlyphBounds(size_t index) const {
     float width = 0;
     size_t tpos = 0;
     while (begin != cursr) {
-        ccode = utf8::next(begin,cursr);
+        ccode = strtool::nextCodePoint(begin,cursr);
         if (_font->hasGlyph(ccode)) {
             metrics = _font->getMetrics(ccode);
             width += metrics.advance;
@@ -622,7 +622,7 @@ size_t TextLayout::getGlyphIndex(float x, float y) const {
     Uint32 ccode = 0;
     size_t index = 0;
     while (begin != end) {
-        ccode = utf8::next(begin,end);
+        ccode = strtool::nextCodePoint(begin,end);
         float advance = 0;
         if (_font->hasGlyph(ccode)) {
             advance = _font->getMetrics(ccode).advance;
@@ -714,7 +714,7 @@ size_t TextLayout::getNearestIndex(float x, float y) const {
     size_t index = 0;
     bool done = false;
     while (!done && begin != end) {
-        ccode = utf8::next(begin,end);
+        ccode = strtool::nextCodePoint(begin,end);
         if (_font->hasGlyph(ccode)) {
             width += _font->getMetrics(ccode).advance;
             if (pcode != 0) {
@@ -1225,7 +1225,7 @@ void TextLayout::breakLines() {
     UnicodeType ptype = UnicodeType::SPACE;
 
     while (curr != textEnd) {
-        Uint32 code = utf8::next(next, textEnd);
+        Uint32 code = strtool::nextCodePoint(next, textEnd);
         UnicodeType type = classify(code,pcode);
 
         // ALWAYS break at newlines
@@ -1337,7 +1337,7 @@ void TextLayout::breakLines() {
                         bool squeeze = *next == '\0';
                         const char* check = next;
                         if (!squeeze) {
-                            Uint32 ncode = utf8::next(check, textEnd);
+                            Uint32 ncode = strtool::nextCodePoint(check, textEnd);
                             UnicodeType ntype = classify(ncode,code);
                             if (ntype == UnicodeType::SPACE || ntype == UnicodeType::NEWLINE) {
                                 float value = nextWidth/(_breakline-1);
@@ -1506,7 +1506,7 @@ bool TextLayout::resizeRow(size_t row) {
         
     const char* text = _text.c_str()+line->begin;
     const char* end  = _text.c_str()+line->end;
-    Uint32 pcode = utf8::next(text,end);
+    Uint32 pcode = strtool::nextCodePoint(text,end);
     Font::Metrics metrics = _font->getMetrics(pcode);
     float minX = metrics.minx;
     float maxX = metrics.maxx;
@@ -1516,7 +1516,7 @@ bool TextLayout::resizeRow(size_t row) {
     
     Uint32 ccode = 0;
     while (text != end) {
-        ccode = utf8::next(text,end);
+        ccode = strtool::nextCodePoint(text,end);
         float kerning = _font->getKerning(pcode, ccode);
         if (_font->hasGlyph(ccode)) {
             metrics = _font->getMetrics(ccode);
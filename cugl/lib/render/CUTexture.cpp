@@ -35,6 +35,7 @@
 #include <cugl/util/CUDebug.h>
 #include <cugl/util/CUFiletools.h>
 #include <cugl/render/CUTexture.h>
+#include <cugl/render/CUGLState.h>
 
 using namespace cugl;
 
@@ -194,7 +195,7 @@ void Texture::dispose() {
     if (_buffer != 0) {
         // Do we own the texture?
         if (_parent == nullptr) {
-            glDeleteTextures(1, &_buffer);
+            GLState::deleteTexture(_buffer);
         }
         _buffer = 0;
         _width = 0; _height = 0;
@@ -248,8 +249,8 @@ bool Texture::initWithData(const void *data, int width, int height, Texture::Pix
     _width  = width;
     _height = height;
     _pixelFormat = format;
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, _buffer);
+    GLState::activeTexture(GL_TEXTURE0);
+    GLState::bindTexture(GL_TEXTURE_2D, _buffer);
 
     GLint  internal = internal_format(format);
     GLenum datatype = format_type(format);
@@ -258,7 +259,7 @@ bool Texture::initWithData(const void *data, int width, int height, Texture::Pix
     error = glGetError();
     if (error) {
         CULogError("Could not initialize texture. %s", gl_error_name(error).c_str());
-        glDeleteTextures(1, &_buffer);
+        GLState::deleteTexture(_buffer);
         _buffer = 0;
         return false;
     }
@@ -268,7 +269,7 @@ bool Texture::initWithData(const void *data, int width, int height, Texture::Pix
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, _wrapS);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, _wrapT);
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+    GLState::bindTexture(GL_TEXTURE_2D, 0);
     std::stringstream ss;
     ss << "@" << data;
     setName(ss.str());
@@ -373,6 +374,46 @@ const Texture& Texture::set(const void *data) {
     return *this;
 }
 
+/**
+ * Sets this texture to have the contents of the given buffer and size.
+ *
+ * This method replaces the texture image in place, keeping the same
+ * OpenGL texture. Therefore any object that references this texture
+ * (such as a scene graph node or subtexture) will see the new image.
+ * This is how textures are hot-reloaded by {@link TextureLoader}.
+ *
+ * The buffer must have the same data format as this texture, and it
+ * must be size width*height*bytesize. If this texture had mipmaps,
+ * they will be rebuilt. This method may not be called on a subtexture.
+ *
+ * This method is only successful if the texture is currently active.
+ *
+ * @param data      The buffer to read into the texture
+ * @param width     The new texture width in pixels
+ * @param height    The new texture height in pixels
+ *
+ * @return a reference to this (modified) texture for chaining.
+ */
+const Texture& Texture::set(const void *data, int width, int height) {
+    CUAssertLog(width > 0 && height > 0, "Texture size %dx%d is not valid",width,height);
+    CUAssertLog(_parent == nullptr, "Cannot resize a subtexture");
+    if (!isActive()) {
+        CUAssertLog(false,"Texture %s is not currently active.",_name.c_str());
+        return *this;
+    }
+    
+    _width  = width;
+    _height = height;
+    GLint  internal = internal_format(_pixelFormat);
+    GLenum datatype = format_type(_pixelFormat);
+    glTexImage2D(GL_TEXTURE_2D, 0, internal, _width, _height, 0,
+                 (GLenum)_pixelFormat, datatype, data);
+    if (_hasMipmaps) {
+        glGenerateMipmap(GL_TEXTURE_2D);
+    }
+    return *this;
+}
+
 
 #pragma mark -
 #pragma mark Attributes
@@ -593,18 +634,11 @@ std::shared_ptr<Texture> Texture::getSubTexture(GLfloat minS, GLfloat maxS,
  * @param the texture location to associate with this texture.
  */
 void Texture::setBindPoint(GLuint point) {
-    GLint orig;
-    glGetIntegerv(GL_ACTIVE_TEXTURE,&orig);
-    if (orig != _bindpoint+GL_TEXTURE0) {
-        glActiveTexture(GL_TEXTURE0+_bindpoint);
-    }
-    GLint bind;
-    glGetIntegerv(GL_TEXTURE_BINDING_2D, &bind);
-    if (bind == _buffer) {
-        glBindTexture(GL_TEXTURE_2D, 0);
-    }
-    if (orig != _bindpoint+GL_TEXTURE0) {
-        glActiveTexture(orig);
+    if (_buffer && GLState::getTexture(GL_TEXTURE0+_bindpoint) == _buffer) {
+        GLenum orig = GLState::getActiveTexture();
+        GLState::activeTexture(GL_TEXTURE0+_bindpoint);
+        GLState::bindTexture(GL_TEXTURE_2D, 0);
+        GLState::activeTexture(orig);
     }
     GLenum error = glGetError();
     CUAssertLog(error == GL_NO_ERROR, "Texture: %s", gl_error_name(error).c_str());
@@ -633,8 +667,8 @@ void Texture::bind() {
         return;
     }
     
-    glActiveTexture(GL_TEXTURE0+_bindpoint);
-    glBindTexture(GL_TEXTURE_2D,_buffer);
+    GLState::activeTexture(GL_TEXTURE0+_bindpoint);
+    GLState::bindTexture(GL_TEXTURE_2D,_buffer);
     if (_dirty) {
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, _minFilter);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, _magFilter);
@@ -661,14 +695,11 @@ void Texture::unbind() {
         return;
     }
 
-    GLint orig;
-    glGetIntegerv(GL_ACTIVE_TEXTURE,&orig);
-    if (orig != _bindpoint+GL_TEXTURE0) {
-        glActiveTexture(GL_TEXTURE0+_bindpoint);
-    }
-    glBindTexture(GL_TEXTURE_2D, 0);
-    if (orig != _bindpoint+GL_TEXTURE0) {
-        glActiveTexture(orig);
+    if (GLState::getTexture(GL_TEXTURE0+_bindpoint) != 0) {
+        GLenum orig = GLState::getActiveTexture();
+        GLState::activeTexture(GL_TEXTURE0+_bindpoint);
+        GLState::bindTexture(GL_TEXTURE_2D, 0);
+        GLState::activeTexture(orig);
     }
 }
 
@@ -690,18 +721,7 @@ bool Texture::isBound() const {
         return false;
     }
     
-    GLint orig;
-    glGetIntegerv(GL_ACTIVE_TEXTURE,&orig);
-    if (orig != _bindpoint+GL_TEXTURE0) {
-        glActiveTexture(GL_TEXTURE0+_bindpoint);
-    }
-    GLint bind;
-    glGetIntegerv(GL_TEXTURE_BINDING_2D, &bind);
-    bool result = (bind == _buffer);
-    if (orig != _bindpoint+GL_TEXTURE0) {
-        glActiveTexture(orig);
-    }
-    return result;
+    return GLState::getTexture(GL_TEXTURE0+_bindpoint) == _buffer;
 }
 
 /**
@@ -721,14 +741,10 @@ bool Texture::isActive() const {
     if (!_buffer) {
         return false;
     }
-    GLint orig;
-    glGetIntegerv(GL_ACTIVE_TEXTURE,&orig);
-    if (orig != _bindpoint+GL_TEXTURE0) {
+    if (GLState::getActiveTexture() != _bindpoint+GL_TEXTURE0) {
         return false;
     }
-    GLint bind;
-    glGetIntegerv(GL_TEXTURE_BINDING_2D, &bind);
-    return (bind == _buffer);
+    return GLState::getTexture(GL_TEXTURE0+_bindpoint) == _buffer;
 }
 
 
@@ -0,0 +1,601 @@
+//
+//  CUTiledTexture.cpp
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides a streaming texture for very large images, such as
+//  level backgrounds. A single texture is limited by the maximum texture size
+//  of the GPU, and must be entirely resident in memory. A tiled texture is an
+//  image that has been split offline into a pyramid of fixed size tiles, one
+//  pyramid level per mipmap level. Only the tiles that are visible are loaded,
+//  and they are decoded in a background thread and uploaded in the main thread.
+//  The tiles are kept in a cache of fixed capacity, so the memory use of this
+//  texture is constant, regardless of the size of the image.
+//
+//  The tiles are stored as image files in a directory, together with a JSON
+//  manifest describing the image. Use the static method bake to produce this
+//  directory from a source image.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#include <SDL/SDL.h>
+#include <SDL/SDL_image.h>
+#include <cugl/render/CUTiledTexture.h>
+#include <cugl/base/CUApplication.h>
+#include <cugl/assets/CUJsonValue.h>
+#include <cugl/io/CUJsonReader.h>
+#include <cugl/io/CUJsonWriter.h>
+#include <cugl/util/CUFiletools.h>
+#include <cugl/util/CUDebug.h>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+
+/** The pixel format matching Texture::PixelFormat::RGBA */
+#if CU_MEMORY_ORDER == CU_ORDER_REVERSED
+    #define TILE_FORMAT SDL_PIXELFORMAT_ABGR8888
+#else
+    #define TILE_FORMAT SDL_PIXELFORMAT_RGBA8888
+#endif
+
+/** The mask for the column or row of a tile key */
+#define KEY_MASK    0xffffff
+
+/** The name of the manifest produced by bake */
+#define MANIFEST    "tiles.json"
+
+using namespace cugl;
+
+#pragma mark Constructors
+/**
+ * Creates an uninitialized tiled texture.
+ *
+ * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an object on
+ * the heap, use one of the static constructors instead.
+ */
+TiledTexture::TiledTexture() :
+_width(0),
+_height(0),
+_tilesize(0),
+_levels(0),
+_capacity(0),
+_uploads(4),
+_frame(0) {
+}
+
+/**
+ * Disposes all of the resources used by this tiled texture.
+ *
+ * This method blocks until any tile being decoded is complete. A disposed
+ * texture can be safely reinitialized.
+ */
+void TiledTexture::dispose() {
+    if (_workers != nullptr) {
+        _workers->dispose();
+        _workers = nullptr;
+    }
+    _pending.clear();
+    _decoded.clear();
+    _cache.clear();
+    _lru.clear();
+    _spares.clear();
+    _directory.clear();
+    _format.clear();
+    _width = 0;
+    _height = 0;
+    _tilesize = 0;
+    _levels = 0;
+    _capacity = 0;
+    _frame = 0;
+}
+
+/**
+ * Initializes a tiled texture from the given manifest.
+ *
+ * The manifest is a JSON file, as described in the class documentation.
+ * Relative paths are resolved against the application asset directory.
+ * The capacity is the maximum number of resident tiles. It should be
+ * large enough to cover the screen at least twice over, plus the tiles
+ * of the last level.
+ *
+ * @param manifest  The manifest file
+ * @param capacity  The maximum number of resident tiles
+ * @param threads   The number of threads for decoding tiles
+ *
+ * @return true if initialization was successful.
+ */
+bool TiledTexture::initWithFile(const std::string& manifest, Uint32 capacity, Uint32 threads) {
+    if (_levels) {
+        CUAssertLog(false, "Tiled texture is already initialized");
+        return false;
+    }
+
+    std::string path = manifest;
+    if (!filetool::is_absolute(path) && Application::get() != nullptr) {
+        path = Application::get()->getAssetDirectory()+path;
+    }
+    path = filetool::normalize_path(path);
+
+    std::shared_ptr<JsonReader> reader = JsonReader::alloc(path);
+    std::shared_ptr<JsonValue> json = (reader == nullptr ? nullptr : reader->readJson());
+    if (json == nullptr) {
+        CULogError("Could not read tile manifest %s", manifest.c_str());
+        return false;
+    }
+
+    _width    = json->getInt("width",0);
+    _height   = json->getInt("height",0);
+    _tilesize = json->getInt("tile",0);
+    _levels   = json->getInt("levels",0);
+    _format   = json->getString("format","png");
+    if (!_width || !_height || !_tilesize || !_levels) {
+        CULogError("Tile manifest %s is invalid", manifest.c_str());
+        _levels = 0;
+        return false;
+    }
+
+    // The tiles of the last level are pinned, so make room for them
+    Uint32 scale = 1 << (_levels-1);
+    Uint32 cols = (_width +_tilesize*scale-1)/(_tilesize*scale);
+    Uint32 rows = (_height+_tilesize*scale-1)/(_tilesize*scale);
+    _capacity = std::max(capacity,cols*rows+1);
+    _directory = filetool::dir_name(path);
+    _workers = ThreadPool::alloc(std::max(threads,(Uint32)1));
+
+    _frame = 1;
+    for(Uint32 row = 0; row < rows; row++) {
+        for(Uint32 col = 0; col < cols; col++) {
+            request(makeKey(_levels-1,col,row));
+        }
+    }
+    return true;
+}
+
+/**
+ * Splits the given image into a tiled texture in the given directory.
+ *
+ * This is an offline tool. It loads the entire source image into memory,
+ * and so it should not be used at runtime. The directory will contain the
+ * manifest "tiles.json" and a subdirectory for each pyramid level. Each
+ * level is downsampled from the previous one with a box filter. All tiles
+ * are saved as PNG files.
+ *
+ * @param source    The source image file
+ * @param directory The directory to store the tiles
+ * @param tilesize  The size of each tile in pixels
+ *
+ * @return true if the image was successfully split
+ */
+bool TiledTexture::bake(const std::string& source, const std::string& directory, Uint32 tilesize) {
+    SDL_Surface* surface = IMG_Load(filetool::normalize_path(source).c_str());
+    if (surface == nullptr) {
+        CULogError("Could not load file %s. %s", source.c_str(), SDL_GetError());
+        return false;
+    }
+    SDL_Surface* level = SDL_ConvertSurfaceFormat(surface,TILE_FORMAT,0);
+    SDL_FreeSurface(surface);
+    if (level == nullptr || tilesize == 0) {
+        CULogError("Could not process file %s. %s", source.c_str(), SDL_GetError());
+        return false;
+    }
+
+    std::string root = filetool::normalize_path(directory);
+    if (!filetool::is_dir(root) && !filetool::dir_create(root)) {
+        CULogError("Could not create directory %s", directory.c_str());
+        SDL_FreeSurface(level);
+        return false;
+    }
+
+    int width  = level->w;
+    int height = level->h;
+    int tile = (int)tilesize;
+    Uint32 levels = 0;
+    bool success = true;
+    while (success) {
+        std::string folder = filetool::join_path({root,std::to_string(levels)});
+        success = filetool::is_dir(folder) || filetool::dir_create(folder);
+
+        // Split this level into padded tiles
+        SDL_SetSurfaceBlendMode(level, SDL_BLENDMODE_NONE);
+        SDL_Surface* piece = SDL_CreateRGBSurfaceWithFormat(0,tile,tile,32,TILE_FORMAT);
+        for(int row = 0; success && row*tile < level->h; row++) {
+            for(int col = 0; success && col*tile < level->w; col++) {
+                SDL_Rect src;
+                src.x = col*tile;
+                src.y = row*tile;
+                src.w = std::min(tile,level->w-src.x);
+                src.h = std::min(tile,level->h-src.y);
+                SDL_FillRect(piece, nullptr, 0);
+                SDL_BlitSurface(level, &src, piece, nullptr);
+                std::string file = std::to_string(col)+"_"+std::to_string(row)+".png";
+                success = IMG_SavePNG(piece,filetool::join_path({folder,file}).c_str()) == 0;
+            }
+        }
+        SDL_FreeSurface(piece);
+        levels++;
+        if (!success || (level->w <= tile && level->h <= tile)) {
+            break;
+        }
+
+        // Downsample with a box filter (edge pixels are repeated)
+        int w = (level->w+1)/2;
+        int h = (level->h+1)/2;
+        SDL_Surface* next = SDL_CreateRGBSurfaceWithFormat(0,w,h,32,TILE_FORMAT);
+        for(int y = 0; y < h; y++) {
+            const Uint8* row0 = (const Uint8*)level->pixels+(2*y)*level->pitch;
+            const Uint8* row1 = (const Uint8*)level->pixels+std::min(2*y+1,level->h-1)*level->pitch;
+            Uint8* dst = (Uint8*)next->pixels+y*next->pitch;
+            for(int x = 0; x < w; x++) {
+                int x0 = 8*x;
+                int x1 = 4*std::min(2*x+1,level->w-1);
+                for(int c = 0; c < 4; c++) {
+                    dst[4*x+c] = (Uint8)((row0[x0+c]+row0[x1+c]+row1[x0+c]+row1[x1+c]+2)/4);
+                }
+            }
+        }
+        SDL_FreeSurface(level);
+        level = next;
+    }
+    SDL_FreeSurface(level);
+    if (!success) {
+        CULogError("Could not save tiles to %s. %s", directory.c_str(), SDL_GetError());
+        return false;
+    }
+
+    std::shared_ptr<JsonValue> json = JsonValue::allocObject();
+    json->appendValue("width", (long)width);
+    json->appendValue("height", (long)height);
+    json->appendValue("tile", (long)tilesize);
+    json->appendValue("levels", (long)levels);
+    json->appendValue("format", std::string("png"));
+    std::shared_ptr<JsonWriter> writer = JsonWriter::alloc(filetool::join_path({root,MANIFEST}));
+    if (writer == nullptr) {
+        CULogError("Could not write tile manifest to %s", directory.c_str());
+        return false;
+    }
+    writer->writeJson(json);
+    writer->close();
+    return true;
+}
+
+#pragma mark -
+#pragma mark Attributes
+/**
+ * Returns the number of tiles requested, but not yet uploaded.
+ *
+ * @return the number of tiles requested, but not yet uploaded.
+ */
+size_t TiledTexture::getPendingCount() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _pending.size();
+}
+
+/**
+ * Returns the file for the given tile.
+ *
+ * @param key   The tile key
+ *
+ * @return the file for the given tile.
+ */
+std::string TiledTexture::getTileFile(Uint64 key) const {
+    Uint32 level = (Uint32)(key >> 48);
+    Uint32 row = (Uint32)((key >> 24) & KEY_MASK);
+    Uint32 col = (Uint32)(key & KEY_MASK);
+    std::string file = std::to_string(col)+"_"+std::to_string(row)+"."+_format;
+    return filetool::join_path({_directory,std::to_string(level),file});
+}
+
+#pragma mark -
+#pragma mark Streaming
+/**
+ * Returns the pyramid level for the given texel density.
+ *
+ * The density is the number of image pixels per screen pixel. The level
+ * is the coarsest one that still has at least one texel per pixel.
+ *
+ * @param density   The number of image pixels per screen pixel
+ *
+ * @return the pyramid level for the given texel density.
+ */
+Uint32 TiledTexture::getLevel(float density) const {
+    if (density <= 1 || !_levels) {
+        return 0;
+    }
+    Uint32 level = (Uint32)std::floor(std::log2(density));
+    return std::min(level,_levels-1);
+}
+
+/**
+ * Uploads decoded tiles and starts a new frame.
+ *
+ * This method must be called in the main thread, once per frame, before
+ * any calls to {@link #select}. It uploads at most {@link #getUploadLimit}
+ * tiles, and cancels any requests that were not renewed in the previous
+ * frame.
+ */
+void TiledTexture::update() {
+    if (!_levels) {
+        return;
+    }
+
+    std::vector<Decoded> ready;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        size_t amount = std::min(_decoded.size(),(size_t)_uploads);
+        ready.reserve(amount);
+        for(size_t ii = 0; ii < amount; ii++) {
+            ready.push_back(std::move(_decoded[ii]));
+        }
+        _decoded.erase(_decoded.begin(),_decoded.begin()+amount);
+
+        // Cancel stale requests; the pinned last level is never stale
+        for(auto it = _pending.begin(); it != _pending.end(); ) {
+            if (it->second+1 < _frame && (Uint32)(it->first >> 48) != _levels-1) {
+                it = _pending.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    for(auto it = ready.begin(); it != ready.end(); ++it) {
+        upload(*it);
+    }
+    _frame++;
+}
+
+/**
+ * Stores the patches needed to draw the given region in patches.
+ *
+ * The region is in image pixel coordinates, with the origin at the bottom
+ * left corner. The tiles are chosen from the given level. Any tile that is
+ * not resident is requested, and the corresponding part of the finest
+ * resident coarser tile is drawn instead. Regions with no resident tile
+ * (which can only happen in the first few frames) are skipped.
+ *
+ * The patches are appended to the given vector, which is not cleared.
+ *
+ * @param region    The region to draw, in image pixel coordinates
+ * @param level     The pyramid level to draw
+ * @param patches   The vector to store the patches
+ *
+ * @return the number of patches added
+ */
+size_t TiledTexture::select(const Rect& region, Uint32 level, std::vector<Patch>& patches) {
+    if (!_levels) {
+        return 0;
+    }
+    level = std::min(level,_levels-1);
+
+    // Convert to image coordinates with the origin at the top
+    float left   = std::max(region.getMinX(),0.0f);
+    float right  = std::min(region.getMaxX(),(float)_width);
+    float top    = std::max(_height-region.getMaxY(),0.0f);
+    float bottom = std::min(_height-region.getMinY(),(float)_height);
+    if (left >= right || top >= bottom) {
+        return 0;
+    }
+
+    size_t start = patches.size();
+    float span = (float)(_tilesize << level);
+    Uint32 col0 = (Uint32)(left/span);
+    Uint32 col1 = (Uint32)std::ceil(right/span);
+    Uint32 row0 = (Uint32)(top/span);
+    Uint32 row1 = (Uint32)std::ceil(bottom/span);
+    for(Uint32 row = row0; row < row1; row++) {
+        for(Uint32 col = col0; col < col1; col++) {
+            float x0 = col*span;
+            float y0 = row*span;
+            float x1 = std::min(x0+span,(float)_width);
+            float y1 = std::min(y0+span,(float)_height);
+
+            // Find the finest resident tile covering this one
+            Entry* entry = nullptr;
+            Uint32 found = level;
+            for(; entry == nullptr && found < _levels; found++) {
+                Uint32 shift = found-level;
+                Uint64 key = makeKey(found,col >> shift,row >> shift);
+                entry = touch(key);
+                if (entry == nullptr && found == level) {
+                    request(key);
+                }
+            }
+            if (entry == nullptr) {
+                continue;
+            }
+            found--;
+
+            Uint32 shift = found-level;
+            float extent = (float)(_tilesize << found);
+            float ox = (col >> shift)*extent;
+            float oy = (row >> shift)*extent;
+
+            Patch patch;
+            patch.texture = entry->texture;
+            patch.bounds.set(x0,_height-y1,x1-x0,y1-y0);
+            patch.minS = (x0-ox)/extent;
+            patch.maxS = (x1-ox)/extent;
+            patch.minT = (y0-oy)/extent;
+            patch.maxT = (y1-oy)/extent;
+            patches.push_back(patch);
+        }
+    }
+    return patches.size()-start;
+}
+
+#pragma mark -
+#pragma mark Internal Helpers
+/**
+ * Returns the resident tile for the given key, or nullptr if not resident.
+ *
+ * This method marks the tile as used in the current frame.
+ *
+ * @param key   The tile key
+ *
+ * @return the resident tile for the given key, or nullptr if not resident.
+ */
+TiledTexture::Entry* TiledTexture::touch(Uint64 key) {
+    auto it = _cache.find(key);
+    if (it == _cache.end()) {
+        return nullptr;
+    }
+    Entry* entry = &(it->second);
+    if (entry->frame != _frame) {
+        entry->frame = _frame;
+        _lru.splice(_lru.begin(),_lru,entry->position);
+    }
+    return entry;
+}
+
+/**
+ * Requests the given tile, if it is not already requested.
+ *
+ * The tile is decoded in a worker thread, and uploaded by a later call
+ * to {@link #update}.
+ *
+ * @param key   The tile key
+ */
+void TiledTexture::request(Uint64 key) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _pending.find(key);
+    if (it != _pending.end()) {
+        it->second = _frame;
+        return;
+    }
+    _pending[key] = _frame;
+    _workers->addTask([=](void) { this->decode(key); });
+}
+
+/**
+ * Decodes the given tile in a worker thread.
+ *
+ * The tile is skipped if it is no longer requested.
+ *
+ * @param key   The tile key
+ */
+void TiledTexture::decode(Uint64 key) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_pending.find(key) == _pending.end()) {
+            return;
+        }
+    }
+
+    Decoded result;
+    result.key = key;
+    std::string file = getTileFile(key);
+    SDL_Surface* surface = IMG_Load(file.c_str());
+    SDL_Surface* normal = nullptr;
+    if (surface != nullptr) {
+        normal = SDL_ConvertSurfaceFormat(surface,TILE_FORMAT,0);
+        SDL_FreeSurface(surface);
+    }
+    if (normal == nullptr || normal->w != (int)_tilesize || normal->h != (int)_tilesize) {
+        CULogError("Could not load tile %s. %s", file.c_str(), SDL_GetError());
+        if (normal != nullptr) {
+            SDL_FreeSurface(normal);
+        }
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pending.erase(key);
+        return;
+    }
+
+    size_t stride = 4*_tilesize;
+    result.pixels.resize(stride*_tilesize);
+    for(Uint32 row = 0; row < _tilesize; row++) {
+        std::memcpy(result.pixels.data()+row*stride,(Uint8*)normal->pixels+row*normal->pitch,stride);
+    }
+    SDL_FreeSurface(normal);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_pending.find(key) != _pending.end()) {
+        _decoded.push_back(std::move(result));
+    }
+}
+
+/**
+ * Uploads the given decoded tile to the GPU, adding it to the cache.
+ *
+ * This method may evict the least recently used tile. Tiles in the last
+ * level, and tiles used or uploaded in the current frame, are never evicted. If no
+ * tile can be evicted, the tile is discarded.
+ *
+ * @param tile  The decoded tile
+ *
+ * @return true if the tile was added to the cache
+ */
+bool TiledTexture::upload(Decoded& tile) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_pending.erase(tile.key) == 0) {
+            return false;
+        }
+    }
+
+    if (_cache.size() >= _capacity) {
+        // Evict the least recently used tile that is not pinned or visible
+        for(auto it = _lru.rbegin(); it != _lru.rend(); ++it) {
+            auto jt = _cache.find(*it);
+            if ((Uint32)(*it >> 48) != _levels-1 && jt->second.frame < _frame) {
+                _spares.push_back(jt->second.texture);
+                _lru.erase(jt->second.position);
+                _cache.erase(jt);
+                break;
+            }
+        }
+        if (_cache.size() >= _capacity) {
+            return false;
+        }
+    }
+
+    std::shared_ptr<Texture> texture;
+    if (_spares.empty()) {
+        texture = Texture::alloc(_tilesize,_tilesize);
+        if (texture == nullptr) {
+            return false;
+        }
+    } else {
+        texture = _spares.back();
+        _spares.pop_back();
+    }
+    texture->bind();
+    texture->set(tile.pixels.data());
+    texture->unbind();
+
+    _lru.push_front(tile.key);
+    Entry& entry = _cache[tile.key];
+    entry.texture = texture;
+    entry.position = _lru.begin();
+    entry.frame = _frame;
+    return true;
+}
@@ -33,6 +33,7 @@
 #include <cugl/render/CUVertexBuffer.h>
 #include <cugl/render/CUShader.h>
 #include <cugl/render/CUTexture.h>
+#include <cugl/render/CUGLState.h>
 
 using namespace cugl;
 
@@ -85,7 +86,7 @@ bool VertexBuffer::init(GLsizei stride) {
     glGenBuffers(1, &_vertBuffer);
     if (!_vertBuffer) {
         GLenum error = glGetError();
-        glDeleteVertexArrays(1,&_vertArray);
+        GLState::deleteVertexArray(_vertArray);
         CULogError("Could not create vertex buffer. %s", gl_error_name(error).c_str());
         return false;
     }
@@ -94,8 +95,8 @@ bool VertexBuffer::init(GLsizei stride) {
     if (!_indxBuffer) {
         GLenum error = glGetError();
         CULogError("Could not create index buffer. %s", gl_error_name(error).c_str());
-        glDeleteVertexArrays(1,&_vertArray);
-        glDeleteBuffers(1,&_vertBuffer);
+        GLState::deleteVertexArray(_vertArray);
+        GLState::deleteBuffer(_vertBuffer);
         return false;
     }
     
@@ -113,9 +114,9 @@ void VertexBuffer::dispose() {
     }
     _enabled.clear();
     _attributes.clear();
-    glDeleteBuffers(1,&_indxBuffer);
-    glDeleteBuffers(1,&_vertBuffer);
-    glDeleteVertexArrays(1,&_vertArray);
+    GLState::deleteBuffer(_indxBuffer);
+    GLState::deleteBuffer(_vertBuffer);
+    GLState::deleteVertexArray(_vertArray);
     _indxBuffer = 0;
     _vertBuffer = 0;
     _vertArray  = 0;
@@ -139,9 +140,9 @@ void VertexBuffer::dispose() {
  */
 void VertexBuffer::bind() {
     CUAssertLog(_vertBuffer, "VertexBuffer has not be initialized.");
-    glBindVertexArray(_vertArray);
-	glBindBuffer( GL_ARRAY_BUFFER, _vertBuffer );
-	glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, _indxBuffer );
+    GLState::bindVertexArray(_vertArray);
+    GLState::bindBuffer( GL_ARRAY_BUFFER, _vertBuffer );
+    GLState::bindBuffer( GL_ELEMENT_ARRAY_BUFFER, _indxBuffer );
     if (_shader != nullptr) {
         _shader->bind();
     }
@@ -160,9 +161,9 @@ void VertexBuffer::bind() {
  */
 void VertexBuffer::unbind() {
     if (isBound()) {
-        glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
-        glBindBuffer( GL_ARRAY_BUFFER, 0 );
-        glBindVertexArray(0);
+        GLState::bindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
+        GLState::bindBuffer( GL_ARRAY_BUFFER, 0 );
+        GLState::bindVertexArray(0);
     }
 }
 
@@ -225,9 +226,7 @@ std::shared_ptr<Shader> VertexBuffer::detach() {
  * @return true if this vertex is currently bound.
  */
 bool VertexBuffer::isBound() const {
-    GLint vao;
-    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &vao);
-    return vao == _vertArray;
+    return GLState::getVertexArray() == _vertArray;
 }
 
 
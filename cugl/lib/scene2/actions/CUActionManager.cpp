@@ -39,6 +39,8 @@
 //  Version: 3/12/17
 //
 #include <cugl/scene2/actions/CUActionManager.h>
+#include <mutex>
+#include <condition_variable>
 
 using namespace cugl;
 using namespace cugl::scene2;
@@ -56,6 +58,10 @@ void ActionManager::dispose() {
         it->second = nullptr;
     }
     _actions.clear();
+    _queue.clear();
+    _tasks.clear();
+    _threads = nullptr;
+    _dirty = false;
 }
 
 /**
@@ -76,7 +82,7 @@ ActionManager::ActionInstance::~ActionInstance() {
  *
  * @return true if the given key represents an active animation
  */
-bool ActionManager::isActive(std::string key) const {
+bool ActionManager::isActive(const Symbol key) const {
     auto action = _actions.find(key);
     return (action != _actions.end());
 }
@@ -97,7 +103,7 @@ bool ActionManager::isActive(std::string key) const {
  *
  * @return true if the animation was successfully started
  */
-bool ActionManager::activate(std::string key,
+bool ActionManager::activate(const Symbol key,
                              const std::shared_ptr<Action>& action,
                              const std::shared_ptr<scene2::SceneNode>& target,
                              std::function<float(float)>interpolation) {
@@ -107,12 +113,14 @@ bool ActionManager::activate(std::string key,
     }
     
     ActionInstance* instance = new ActionInstance();
+    instance->key = key;
     instance->action = action;
     instance->target = target;
     instance->interpolant = interpolation;
     action->load(target, &(instance->state));
     _actions.emplace(key,instance);
     _keys[target.get()].emplace(key);
+    _dirty = true;
     return true;
 }
 
@@ -129,7 +137,7 @@ bool ActionManager::activate(std::string key,
  *
  * @return true if the animation was successfully removed
  */
-bool ActionManager::remove(std::string key) {
+bool ActionManager::remove(const Symbol key) {
     auto action = _actions.find(key);
     if (action == _actions.end()) {
         return false;
@@ -139,6 +147,7 @@ bool ActionManager::remove(std::string key) {
     delete instance;
     action->second = nullptr;
     _actions.erase(action);
+    _dirty = true;
     return true;
 }
 
@@ -149,39 +158,150 @@ bool ActionManager::remove(std::string key) {
  * to reach its duration, the animation is removed and the key is once
  * again available.
  *
+ * If this manager has a thread pool and at least {@link #getParallelThreshold}
+ * active animations, the animations are updated in parallel. Completed
+ * animations are removed on the calling thread in either case.
+ *
  * @param dt    The number of seconds to animate
  */
 void ActionManager::update(float dt) {
-    auto completed = std::vector<std::unordered_map<std::string,ActionInstance*>::iterator>();
-    for(auto it = _actions.begin(); it != _actions.end(); ++it) {
-        ActionInstance* instance = it->second;
-        Action* action = instance->action.get();
-        float current = 1.0;
-        float future  = 1.0;
-        if (action->getDuration() > 0) {
-            current = (instance->elapsed) / action->getDuration();
-            future  = (instance->elapsed+dt)/ action->getDuration();
-        } else {
-            current = 0.0f;
+    if (_dirty) {
+        rebuild();
+    }
+    
+    if (_threads != nullptr && !_threads->isStopped() &&
+        _tasks.size() > 2 && _queue.size() >= _threshold) {
+        parallelUpdate(dt);
+    } else {
+        for(auto it = _queue.begin(); it != _queue.end(); ++it) {
+            step(*it, dt);
         }
-        
-        if (instance->interpolant) {
-            current = instance->interpolant(current);
-            future  = instance->interpolant(future);
+    }
+
+    // Removal is always serial and in queue order, whatever the thread count
+    for(auto it = _queue.begin(); it != _queue.end(); ++it) {
+        ActionInstance* instance = *it;
+        if (instance->complete) {
+            auto keys = _keys.find(instance->target.get());
+            if (keys != _keys.end()) {
+                keys->second.erase(instance->key);
+                if (keys->second.empty()) {
+                    _keys.erase(keys);
+                }
+            }
+            _actions.erase(instance->key);
+            delete instance;
+            *it = nullptr;
+            _dirty = true;
         }
-        
-        action->update(instance->target, &(instance->state), future-current);
-        instance->elapsed = instance->elapsed+dt;
-        if (instance->elapsed >= action->getDuration()) {
-            completed.push_back(it);
+    }
+    if (_dirty) {
+        _queue.clear();
+    }
+}
+
+
+#pragma mark -
+#pragma mark Internal Helpers
+/**
+ * Updates the given animation by dt seconds
+ *
+ * This method marks the animation as complete if it reaches its duration,
+ * but it does not remove it. It is safe to call this method concurrently
+ * on animations with different targets.
+ *
+ * @param instance  The animation to update
+ * @param dt        The number of seconds to animate
+ */
+void ActionManager::step(ActionInstance* instance, float dt) {
+    if (instance->paused) {
+        return;
+    }
+    
+    Action* action = instance->action.get();
+    float current = 1.0;
+    float future  = 1.0;
+    if (action->getDuration() > 0) {
+        current = (instance->elapsed) / action->getDuration();
+        future  = (instance->elapsed+dt)/ action->getDuration();
+    } else {
+        current = 0.0f;
+    }
+    
+    if (instance->interpolant) {
+        current = instance->interpolant(current);
+        future  = instance->interpolant(future);
+    }
+    
+    action->update(instance->target, &(instance->state), future-current);
+    instance->elapsed = instance->elapsed+dt;
+    instance->complete = instance->elapsed >= action->getDuration();
+}
+
+/**
+ * Rebuilds the queue of animations grouped by target node
+ *
+ * The queue is divided into contiguous tasks, one for each thread of the
+ * thread pool (plus the calling thread). Tasks are only divided between
+ * target nodes. The queue is cached until the set of animations, or the
+ * thread pool, changes.
+ */
+void ActionManager::rebuild() {
+    size_t parts = (_threads == nullptr ? 0 : _threads->getThreadCount())+1;
+    size_t chunk = (_actions.size()+parts-1)/parts;
+
+    _queue.clear();
+    _tasks.clear();
+    _tasks.push_back(0);
+    for(auto it = _keys.begin(); it != _keys.end(); ++it) {
+        for(auto jt = it->second.begin(); jt != it->second.end(); ++jt) {
+            auto action = _actions.find(*jt);
+            if (action != _actions.end()) {
+                _queue.push_back(action->second);
+            }
+        }
+        if (_queue.size()-_tasks.back() >= chunk) {
+            _tasks.push_back(_queue.size());
         }
     }
+    if (_tasks.back() != _queue.size()) {
+        _tasks.push_back(_queue.size());
+    }
+    _dirty = false;
+}
+
+/**
+ * Updates all non-paused animations by dt seconds using the thread pool
+ *
+ * The calling thread performs the first task in the queue and waits for
+ * the others to finish. This method does not remove completed animations.
+ *
+ * @param dt    The number of seconds to animate
+ */
+void ActionManager::parallelUpdate(float dt) {
+    std::mutex mutex;
+    std::condition_variable finished;
+    size_t pending = _tasks.size()-2;
+    for(size_t ii = 1; ii+1 < _tasks.size(); ii++) {
+        ActionInstance** first = _queue.data()+_tasks[ii];
+        ActionInstance** last  = _queue.data()+_tasks[ii+1];
+        _threads->addTask([&,first,last](void) {
+            for(ActionInstance** jj = first; jj != last; ++jj) {
+                step(*jj, dt);
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pending == 0) {
+                finished.notify_one();
+            }
+        });
+    }
     
-    for (auto it = completed.begin(); it != completed.end(); ++it) {
-        delete (*it)->second;
-        (*it)->second = nullptr;
-        _actions.erase(*it);
+    ActionInstance** last = _queue.data()+_tasks[1];
+    for(ActionInstance** jj = _queue.data(); jj != last; ++jj) {
+        step(*jj, dt);
     }
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [&](void) { return pending == 0; });
 }
 
 
@@ -197,7 +317,7 @@ void ActionManager::update(float dt) {
  *
  * @return true if the animation for the given key is paused
  */
-bool ActionManager::isPaused(std::string key) {
+bool ActionManager::isPaused(const Symbol key) {
     auto action = _actions.find(key);
     if (action == _actions.end()) {
         return false;
@@ -213,7 +333,7 @@ bool ActionManager::isPaused(std::string key) {
  *
  * @param key       The identifying key
  */
-void ActionManager::pause(std::string key) {
+void ActionManager::pause(const Symbol key) {
     auto action = _actions.find(key);
     if (action == _actions.end()) {
         return;
@@ -230,7 +350,7 @@ void ActionManager::pause(std::string key) {
  *
  * @param key       The identifying key
  */
-void ActionManager::unpause(std::string key) {
+void ActionManager::unpause(const Symbol key) {
     auto action = _actions.find(key);
     if (action == _actions.end()) {
         return;
@@ -262,6 +382,7 @@ void ActionManager::clearAllActions(const std::shared_ptr<scene2::SceneNode>& ta
         }
     }
     _keys.erase(target.get());
+    _dirty = true;
 }
 
 /**
@@ -323,7 +444,7 @@ std::vector<std::string> ActionManager::getAllActions(const std::shared_ptr<scen
         return std::vector<std::string>();
     }
     for(auto it = set->second.begin(); it != set->second.end(); ++it) {
-        result.push_back(*it);
+        result.push_back(it->str());
     }
     return result;
 }
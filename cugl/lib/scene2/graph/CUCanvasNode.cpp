@@ -1017,7 +1017,7 @@ public:
             for(auto it = runs.begin(); it != runs.end(); ) {
                 packet->blurStep = state->fontBlur;
                 packet->type = actual;
-                packet->mesh = it->second->mesh;
+                packet->mesh = std::move(it->second->mesh);
                 packet->texture = it->second->texture;
                 for(auto jt = packet->mesh.vertices.begin(); jt != packet->mesh.vertices.end(); ++jt) {
                     jt->position *= xform;
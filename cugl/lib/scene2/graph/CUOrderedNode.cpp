@@ -45,91 +45,34 @@
 //  Version: 3/7/21
 #include <cugl/scene2/graph/CUOrderedNode.h>
 #include <cugl/render/CUScissor.h>
+#include <algorithm>
+#include <cstring>
 
 using namespace cugl;
 using namespace cugl::scene2;
 
-#pragma mark Context
-/**
- * Creates a drawing context with the given parent object
- *
- * @param parent    The parent object for the inner class
- */
-OrderedNode::Context::Context(OrderedNode* parent) :
-node(nullptr),
-scissor(nullptr),
-canonical(0) {
-    this->parent = parent;
-    tint = Color4::WHITE;
-}
-       
+#pragma mark Sort Keys
+/** The mask for the canonical index of a sort key */
+#define CANONICAL_MASK  0xffffffff
 
 /**
- * Creates a copy of the given drawing context
+ * Returns the priority as an unsigned integer with the same sort order.
  *
- * @param copy      The drawing context to copy
- */
-OrderedNode::Context::Context(const Context& copy) {
-    node = copy.node;
-    scissor = copy.scissor;
-    canonical = copy.canonical;
-    transform = copy.transform;
-    tint = copy.tint;
-}
-
-/**
- * Deletes this drawing context, disposing of all resources.
- */
-OrderedNode::Context::~Context() {
-    node = nullptr;
-    scissor = nullptr;
-}
-
-/**
- * Returns the value *a < *b
+ * Negative floats have their bits flipped, while positive floats only have
+ * their sign bit flipped. This makes IEEE floats comparable as integers.
+ * Negative zero is treated as positive zero, so that they tie.
  *
- * This function implements a sort order on drawing contexts and
- * is used to sort the render queue.
+ * @param priority  The priority to convert
  *
- * @param a        The first (pointer) to compare
- * @param b        The first (pointer) to compare
- *
- * @return the value *a < *b
+ * @return the priority as an unsigned integer with the same sort order.
  */
-bool OrderedNode::Context::sortCompare(Context* a, Context* b) {
-    // NOTE: Pre or post is determined by canonical order
-    switch (a->parent->_order) {
-        case PRE_ORDER:
-        case POST_ORDER:
-            return a->canonical < b->canonical;
-        case ASCEND:
-            if (a->node->getPriority() == b->node->getPriority()) {
-                return a->canonical < b->canonical;
-            }
-            return a->node->getPriority() < b->node->getPriority();
-        case PRE_ASCEND:
-        case POST_ASCEND:
-            if (a->node->getParent() != b->node->getParent()) {
-                return a->canonical < b->canonical;
-            } else if (a->node->getPriority() == b->node->getPriority()) {
-                return a->canonical < b->canonical;
-            }
-            return a->node->getPriority() < b->node->getPriority();
-        case DESCEND:
-            if (a->node->getPriority() == b->node->getPriority()) {
-                return a->canonical < b->canonical;
-            }
-            return a->node->getPriority() > b->node->getPriority();
-        case PRE_DESCEND:
-        case POST_DESCEND:
-            if (a->node->getParent() != b->node->getParent()) {
-                return a->canonical < b->canonical;
-            } else if (a->node->getPriority() == b->node->getPriority()) {
-                return a->canonical < b->canonical;
-            }
-            return a->node->getPriority() > b->node->getPriority();
+static inline Uint32 priority_bits(float priority) {
+    if (priority == 0) {
+        priority = 0;
     }
-    return false;
+    Uint32 bits;
+    std::memcpy(&bits, &priority, sizeof(Uint32));
+    return (bits & 0x80000000) ? ~bits : (bits | 0x80000000);
 }
 
 #pragma mark -
@@ -143,9 +86,11 @@ bool OrderedNode::Context::sortCompare(Context* a, Context* b) {
  * on the heap, use one of the static constructors instead.
  */
 OrderedNode::OrderedNode() :
+_clipsUsed(0),
 _viewport(nullptr),
 _order(PRE_ORDER) {
     _classname = "OrderedNode";
+    _isBarrier = true;
 }
 
 /**
@@ -158,11 +103,12 @@ _order(PRE_ORDER) {
  * a scene graph.
  */
 void OrderedNode::dispose() {
-    for(auto it = _entries.begin(); it != _entries.end(); ++it) {
-        delete *it;
-        *it = nullptr;
-    }
     _entries.clear();
+    _keys.clear();
+    _scratch.clear();
+    _siblings.clear();
+    _clips.clear();
+    _clipsUsed = 0;
     _viewport = nullptr;
     SceneNode::dispose();
 }
@@ -279,15 +225,15 @@ bool OrderedNode::initWithData(const Scene2Loader* loader, const std::shared_ptr
  * Adds the given node ot the render queue.
  *
  * This method replaces {@link #render} to provide a delayed render command
- * (via a queue of {@link Context} objects). This method is recursive.
- * However, it will stop when it encounters any other {@link OrderedNode}
- * objects.
+ * (via a queue of {@link Entry} objects). This method is recursive.
+ * However, it will stop when it encounters any render barrier (such as
+ * another {@link OrderedNode}).
  *
  * @param node      The descendant node to render.
  * @param transform The global transformation matrix.
  * @param tint      The tint to blend with the node color.
  */
-void OrderedNode::visit(const std::shared_ptr<SceneNode>& node, const Affine2& transform, Color4 tint) {
+void OrderedNode::visit(SceneNode* node, const Affine2& transform, Color4 tint) {
     if (!node->isVisible()) { return; }
 
     Affine2 matrix;
@@ -298,46 +244,154 @@ void OrderedNode::visit(const std::shared_ptr<SceneNode>& node, const Affine2& t
     }
     
     // We need to capture the important sprite batch state
-    std::shared_ptr<Scissor> previous = _viewport;
-    std::shared_ptr<Scissor> current = nullptr;
-    if (node->getScissor()) {
-        current = Scissor::alloc(node->getScissor());
+    std::shared_ptr<Scissor> previous = nullptr;
+    std::shared_ptr<Scissor> local = node->getScissor();
+    bool clipped = local != nullptr;
+    if (clipped) {
+        // Reuse scissors from earlier frames
+        std::shared_ptr<Scissor> current;
+        if (_clipsUsed < _clips.size()) {
+            current = _clips[_clipsUsed];
+            current->set(local);
+        } else {
+            current = Scissor::alloc(local);
+            _clips.push_back(current);
+        }
+        _clipsUsed++;
         current->setTransform(matrix);
-        if (previous) {
-            current->intersect(previous);
+        if (_viewport) {
+            current->intersect(_viewport);
         }
-        _viewport = current;
+        previous = std::move(_viewport);
+        _viewport = std::move(current);
     }
     
-    // Identify pre or post. Block at child ordered nodes
+    // Identify pre or post. Block at render barriers
     bool ispost = (_order == POST_ORDER || _order == POST_ASCEND || _order == POST_DESCEND);
-    bool barrier = node->getClassName() == getClassName();
+    bool barrier = node->isRenderBarrier();
     if (ispost && !barrier) {
-        auto children = node->getChildren();
-        for(auto it = children.begin(); it != children.end(); ++it) {
-            visit(*it, matrix, color);
-        }
+        visitChildren(static_cast<const SceneNode*>(node)->getChildren(), matrix, color);
     }
     
     // Capture pre or post order traversal
-    Uint32 canonical = (_entries.empty() ? 0 : _entries.back()->canonical+1);
+    Uint32 canonical = (Uint32)_entries.size();
+    _entries.emplace_back();
+    Entry& entry = _entries.back();
+    entry.node = node;
+    entry.transform = barrier ? transform : matrix;
+    entry.scissor = _viewport;
+    entry.tint = barrier ? tint : color;
+    entry.barrier = barrier;
     
-    Context* context = new Context(this);
-    _entries.push_back(context);
-    context->node = node;
-    context->transform = barrier ? transform : matrix;
-    context->scissor = _viewport;
-    context->tint = barrier ? tint : color;
-    context->canonical = canonical;
+    if (_order == ASCEND || _order == DESCEND) {
+        Uint64 bits = priority_bits(node->getPriority());
+        if (_order == DESCEND) {
+            bits = ~bits & CANONICAL_MASK;
+        }
+        _keys.push_back((bits << 32) | canonical);
+    }
     
     if (!ispost && !barrier) {
-        auto children = node->getChildren();
+        visitChildren(static_cast<const SceneNode*>(node)->getChildren(), matrix, color);
+    }
+
+    if (clipped) {
+        _viewport = std::move(previous);
+    }
+}
+
+/**
+ * Adds the children of the given node to the render queue.
+ *
+ * If the render order sorts siblings by priority, the children are
+ * visited in sorted order (with ties broken by child position).
+ * Otherwise they are visited in the order that they are stored.
+ *
+ * @param children  The children to visit.
+ * @param transform The global transformation matrix.
+ * @param tint      The tint to blend with the node color.
+ */
+void OrderedNode::visitChildren(const std::vector<std::shared_ptr<SceneNode>>& children,
+                                const Affine2& transform, Color4 tint) {
+    bool ascend  = (_order == PRE_ASCEND  || _order == POST_ASCEND);
+    bool descend = (_order == PRE_DESCEND || _order == POST_DESCEND);
+    if (!(ascend || descend) || children.size() < 2) {
         for(auto it = children.begin(); it != children.end(); ++it) {
-            visit(*it, matrix, color);
+            visit(it->get(), transform, tint);
+        }
+        return;
+    }
+    
+    // The sibling keys are a stack shared by the entire traversal
+    size_t start = _siblings.size();
+    Uint32 size  = (Uint32)children.size();
+    for(Uint32 ii = 0; ii < size; ii++) {
+        Uint64 bits = priority_bits(children[ii]->getPriority());
+        if (descend) {
+            bits = ~bits & CANONICAL_MASK;
         }
+        _siblings.push_back((bits << 32) | ii);
     }
+    std::sort(_siblings.begin()+start, _siblings.end());
+    
+    // Recursive calls may reallocate the stack, so do not use iterators
+    for(size_t ii = start; ii < start+size; ii++) {
+        visit(children[_siblings[ii] & CANONICAL_MASK].get(), transform, tint);
+    }
+    _siblings.resize(start);
+}
 
-    _viewport = previous;
+/**
+ * Sorts the render queue by priority using the packed sort keys.
+ *
+ * This method is only necessary for the orders {@link Order#ASCEND} and
+ * {@link Order#DESCEND}. All other orders are resolved by the traversal
+ * itself. The keys are sorted with an LSD radix sort, which skips any
+ * byte that is the same for all keys. Ties are broken by canonical order.
+ */
+void OrderedNode::sortEntries() {
+    size_t size = _keys.size();
+    if (size < 2) {
+        return;
+    }
+    
+    // The keys are generated in canonical order, and the radix sort is
+    // stable. So we only need to sort on the four priority bytes.
+    size_t counts[4][256];
+    std::memset(counts, 0, sizeof(counts));
+    for(size_t ii = 0; ii < size; ii++) {
+        Uint64 key = _keys[ii];
+        for(int jj = 0; jj < 4; jj++) {
+            counts[jj][(key >> (32+8*jj)) & 0xff]++;
+        }
+    }
+    
+    _scratch.resize(size);
+    Uint64* source = _keys.data();
+    Uint64* target = _scratch.data();
+    for(int jj = 0; jj < 4; jj++) {
+        int shift = 32+8*jj;
+        size_t* bucket = counts[jj];
+        if (bucket[(source[0] >> shift) & 0xff] == size) {
+            continue;
+        }
+        
+        size_t total = 0;
+        for(int kk = 0; kk < 256; kk++) {
+            size_t amt = bucket[kk];
+            bucket[kk] = total;
+            total += amt;
+        }
+        for(size_t ii = 0; ii < size; ii++) {
+            Uint64 key = source[ii];
+            target[bucket[(key >> shift) & 0xff]++] = key;
+        }
+        std::swap(source,target);
+    }
+    
+    if (source != _keys.data()) {
+        std::memcpy(_keys.data(), source, size*sizeof(Uint64));
+    }
 }
 
 /**
@@ -381,28 +435,34 @@ void OrderedNode::render(const std::shared_ptr<SpriteBatch>& batch, const Affine
         }
 
         // Build and sort
-        for(auto it = _children.begin(); it != _children.end(); ++it) {
-            visit(*it, matrix, color);
+        _clipsUsed = 0;
+        visitChildren(_children, matrix, color);
+        
+        // Only change the scissor when it differs from the last one
+        Scissor* current = active.get();
+        bool sorted = (_order == ASCEND || _order == DESCEND);
+        if (sorted) {
+            sortEntries();
         }
-
-        std::sort(_entries.begin(), _entries.end(), Context::sortCompare);
-        for(auto it = _entries.begin(); it != _entries.end(); ++it) {
-            Context* context = *it;
-            batch->setScissor(context->scissor); // This is in render, so must be applied
-            if (context->node->getClassName() == getClassName()) {
+        size_t size = _entries.size();
+        for(size_t ii = 0; ii < size; ii++) {
+            Entry& entry = _entries[sorted ? (_keys[ii] & CANONICAL_MASK) : ii];
+            if (entry.scissor.get() != current) {
+                // This is in render, so must be applied
+                batch->setScissor(entry.scissor);
+                current = entry.scissor.get();
+            }
+            if (entry.barrier) {
                 // Render barrier at an ordered node
-                context->node->render(batch, context->transform, context->tint);
+                entry.node->render(batch, entry.transform, entry.tint);
             } else {
-                context->node->draw(batch, context->transform, context->tint);
+                entry.node->draw(batch, entry.transform, entry.tint);
             }
         }
 
-        // Clean up and restore state
-        for(auto it = _entries.begin(); it != _entries.end(); ++it) {
-            delete *it;
-            *it = nullptr;
-        }
+        // Clean up and restore state (but keep capacity for the next pass)
         _entries.clear();
+        _keys.clear();
         _viewport = nullptr;
         batch->setScissor(active);
     }
@@ -58,7 +58,6 @@ using namespace cugl::scene2;
 SceneNode::SceneNode() :
 _tag(0),
 _name(""),
-_hashOfName(0),
 _tintColor(Color4::WHITE),
 _hasParentColor(true),
 _isVisible(true),
@@ -69,7 +68,8 @@ _useTransform(false),
 _parent(nullptr),
 _graph(nullptr),
 _childOffset(-2),
-_priority(0) {
+_priority(0),
+_isBarrier(false) {
     _classname = "SceneNode";
 }
 
@@ -270,7 +270,7 @@ void SceneNode::dispose() {
     _childOffset = -2;
     _tag = 0;
     _name = "";
-    _hashOfName = 0;
+    _symbol = Symbol();
     _priority = 0.0f;
     _json = nullptr;
 }
@@ -300,7 +300,7 @@ std::shared_ptr<SceneNode> SceneNode::copy(const std::shared_ptr<SceneNode>& dst
     dst->_combined = _combined;
     dst->_tag = _tag;
     dst->_name = _name;
-    dst->_hashOfName = _hashOfName;
+    dst->_symbol = _symbol;
     dst->_priority = _priority;
     dst->_json = _json;
     return dst;
@@ -574,9 +574,34 @@ std::shared_ptr<SceneNode> SceneNode::getChildByTag(unsigned int tag) const {
  *
  * @return the (first) child with the given name.
  */
-std::shared_ptr<SceneNode> SceneNode::getChildByName(const std::string name) const {
+std::shared_ptr<SceneNode> SceneNode::getChildByName(const std::string& name) const {
     for(auto it = _children.begin(); it != _children.end(); ++it) {
-        if ((*it)->getName() == name) {
+        if ((*it)->_name == name) {
+            return *it;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Returns the (first) child with the given name.
+ *
+ * If there is more than one child of the given name, it returns the first
+ * one that is found. For the base SceneNode class, children are always
+ * enumerated in the order that they are added. However, this is not
+ * guaranteed for all subclasses of SceneNode. Hence it is very important
+ * that names be unique.
+ *
+ * This version compares the interned names of the children, and so
+ * does not perform any string comparisons.
+ *
+ * @param name  An identifier to find the child node.
+ *
+ * @return the (first) child with the given name.
+ */
+std::shared_ptr<SceneNode> SceneNode::getChildByName(const Symbol name) const {
+    for(auto it = _children.begin(); it != _children.end(); ++it) {
+        if ((*it)->_symbol == name) {
             return *it;
         }
     }
@@ -702,7 +727,25 @@ void SceneNode::removeChildByTag(unsigned int tag) {
  *
  * @param name  A string to identify the node.
  */
-void SceneNode::removeChildByName(const std::string name) {
+void SceneNode::removeChildByName(const std::string& name) {
+    std::shared_ptr<SceneNode> child = getChildByName(name);
+    if (child != nullptr) {
+        removeChild(child->_childOffset);
+    }
+}
+
+/**
+ * Removes a child from the Node by name.
+ *
+ * If there is more than one child of the given name, it removes the first
+ * one that is found. For the base SceneNode class, children are always
+ * enumerated in the order that they are added.  However, this is not
+ * guaranteed for subclasses of SceneNode. Hence it is very important
+ * that names be unique.
+ *
+ * @param name  A symbol to identify the node.
+ */
+void SceneNode::removeChildByName(const Symbol name) {
     std::shared_ptr<SceneNode> child = getChildByName(name);
     if (child != nullptr) {
         removeChild(child->_childOffset);
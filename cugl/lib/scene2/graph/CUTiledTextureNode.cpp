@@ -0,0 +1,226 @@
+//
+//  CUTiledTextureNode.cpp
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides a scene graph node for drawing a tiled texture. A
+//  tiled texture is a streaming texture for images that are too large to be
+//  a single texture, such as level backgrounds. This node only draws (and
+//  hence only loads) the tiles that are visible to the camera, at a level of
+//  detail appropriate for the camera zoom.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#include <cugl/scene2/graph/CUTiledTextureNode.h>
+#include <cugl/scene2/CUScene2.h>
+#include <cugl/render/CUSpriteBatch.h>
+#include <cugl/math/CUMat4.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace cugl;
+using namespace cugl::scene2;
+
+#pragma mark Constructors
+/**
+ * Creates an uninitialized node.
+ *
+ * You must initialize this node before use.
+ *
+ * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate a Node on the
+ * heap, use one of the static constructors instead.
+ */
+TiledTextureNode::TiledTextureNode() : SceneNode(),
+_bias(0),
+_level(0) {
+    _classname = "TiledTextureNode";
+}
+
+/**
+ * Disposes all of the resources used by this node.
+ *
+ * A disposed Node can be safely reinitialized. Any children owned by this
+ * node will be released. They will be deleted if no other object owns them.
+ *
+ * It is unsafe to call this on a Node that is still currently inside of
+ * a scene graph.
+ */
+void TiledTextureNode::dispose() {
+    _texture = nullptr;
+    _camera = nullptr;
+    _patches.clear();
+    _bias = 0;
+    _level = 0;
+    SceneNode::dispose();
+}
+
+/**
+ * Initializes a node with the given tiled texture.
+ *
+ * The content size of this node is the size of the image in pixels.
+ *
+ * @param texture   The tiled texture
+ *
+ * @return true if initialization was successful.
+ */
+bool TiledTextureNode::initWithTexture(const std::shared_ptr<TiledTexture>& texture) {
+    if (texture == nullptr) {
+        return false;
+    } else if (!SceneNode::initWithBounds(texture->getSize())) {
+        return false;
+    }
+    _texture = texture;
+    return true;
+}
+
+/**
+ * Performs a shallow copy of this Node into dst.
+ *
+ * No children from this node are copied, and no children of dst are
+ * modified. In addition, the parents of both Nodes are unchanged. However,
+ * all other attributes of this node are copied. The tiled texture is
+ * shared, not copied.
+ *
+ * @param dst   The Node to copy into
+ *
+ * @return A reference to dst for chaining.
+ */
+std::shared_ptr<SceneNode> TiledTextureNode::copy(const std::shared_ptr<SceneNode>& dst) const {
+    SceneNode::copy(dst);
+    std::shared_ptr<TiledTextureNode> node = std::dynamic_pointer_cast<TiledTextureNode>(dst);
+    if (node) {
+        node->_texture = _texture;
+        node->_camera = _camera;
+        node->_bias = _bias;
+    }
+    return dst;
+}
+
+#pragma mark -
+#pragma mark Rendering
+/**
+ * Draws this Node via the given SpriteBatch.
+ *
+ * This method only draws the visible tiles of the texture. Any missing
+ * tiles are requested, and drawn from a coarser level in the meantime.
+ *
+ * @param batch     The SpriteBatch to draw with.
+ * @param transform The global transformation matrix.
+ * @param tint      The tint to blend with the Node color.
+ */
+void TiledTextureNode::draw(const std::shared_ptr<SpriteBatch>& batch,
+                            const Affine2& transform, Color4 tint) {
+    if (_texture == nullptr || _contentSize.width <= 0 || _contentSize.height <= 0) {
+        return;
+    }
+
+    // The matrix from node space to clip space
+    std::shared_ptr<Camera> camera = _camera;
+    if (camera == nullptr && _graph != nullptr) {
+        camera = _graph->getCamera();
+    }
+    Mat4 matrix(transform);
+    matrix *= (camera != nullptr ? camera->getCombined() : batch->getPerspective());
+
+    // The visible content is the inverse image of the clip square
+    Mat4 inverse = matrix.getInverse();
+    Vec2 corner = inverse.transform(Vec2(-1,-1));
+    float minx = corner.x;
+    float maxx = corner.x;
+    float miny = corner.y;
+    float maxy = corner.y;
+    const Vec2 clips[3] = { Vec2(1,-1), Vec2(1,1), Vec2(-1,1) };
+    for(int ii = 0; ii < 3; ii++) {
+        corner = inverse.transform(clips[ii]);
+        minx = std::min(minx,corner.x);
+        maxx = std::max(maxx,corner.x);
+        miny = std::min(miny,corner.y);
+        maxy = std::max(maxy,corner.y);
+    }
+    Rect visible(minx,miny,maxx-minx,maxy-miny);
+    visible.intersect(Rect(Vec2::ZERO,_contentSize));
+    if (visible.size.width <= 0 || visible.size.height <= 0) {
+        return;
+    }
+
+    // Choose the level from the image pixels per screen pixel
+    float sx = _texture->getWidth()/_contentSize.width;
+    float sy = _texture->getHeight()/_contentSize.height;
+    _level = 0;
+    if (camera != nullptr) {
+        Rect view = camera->getViewport();
+        Vec2 origin = matrix.transform(Vec2::ZERO);
+        Vec2 axisx = matrix.transform(Vec2(1,0))-origin;
+        Vec2 axisy = matrix.transform(Vec2(0,1))-origin;
+        axisx.set(axisx.x*view.size.width/2,axisx.y*view.size.height/2);
+        axisy.set(axisy.x*view.size.width/2,axisy.y*view.size.height/2);
+        float density = std::max(sx/axisx.length(),sy/axisy.length());
+        if (std::isfinite(density)) {
+            _level = _texture->getLevel(density*std::exp2(_bias));
+        }
+    }
+
+    Rect region(visible.origin.x*sx,visible.origin.y*sy,
+                visible.size.width*sx,visible.size.height*sy);
+    _patches.clear();
+    _texture->select(region,_level,_patches);
+
+    SpriteVertex2 quad[4];
+    GLuint color = Color4::WHITE.getPacked();
+    for(int ii = 0; ii < 4; ii++) {
+        quad[ii].color = color;
+    }
+    quad[0].gradcoord.set(0,1);
+    quad[1].gradcoord.set(1,1);
+    quad[2].gradcoord.set(1,0);
+    quad[3].gradcoord.set(0,0);
+
+    batch->setColor(tint);
+    for(auto it = _patches.begin(); it != _patches.end(); ++it) {
+        float x0 = it->bounds.getMinX()/sx;
+        float x1 = it->bounds.getMaxX()/sx;
+        float y0 = it->bounds.getMinY()/sy;
+        float y1 = it->bounds.getMaxY()/sy;
+        quad[0].position.set(x0,y0);
+        quad[1].position.set(x1,y0);
+        quad[2].position.set(x1,y1);
+        quad[3].position.set(x0,y1);
+        quad[0].texcoord.set(it->minS,it->maxT);
+        quad[1].texcoord.set(it->maxS,it->maxT);
+        quad[2].texcoord.set(it->maxS,it->minT);
+        quad[3].texcoord.set(it->minS,it->minT);
+        batch->setTexture(it->texture);
+        batch->drawMesh(quad,4,transform);
+    }
+    _patches.clear();
+}
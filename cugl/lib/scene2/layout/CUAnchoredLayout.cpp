@@ -109,7 +109,8 @@ bool AnchoredLayout::add(const std::string key, const std::shared_ptr<JsonValue>
  * @return true if the layout information was assigned to that key
  */
 bool AnchoredLayout::addAbsolute(const std::string key, Anchor anchor, const Vec2 offset) {
-    auto last = _entries.find(key);
+    Symbol name(key);
+    auto last = _entries.find(name);
     if (last != _entries.end()) {
         return false;
     }
@@ -119,7 +120,7 @@ bool AnchoredLayout::addAbsolute(const std::string key, Anchor anchor, const Vec
     entry.x_offset = offset.x;
     entry.y_offset = offset.y;
     entry.absolute = true;
-    _entries[key] = entry;
+    _entries[name] = entry;
     return true;
 }
 
@@ -142,7 +143,8 @@ bool AnchoredLayout::addAbsolute(const std::string key, Anchor anchor, const Vec
  * @return true if the layout information was assigned to that key
  */
 bool AnchoredLayout::addRelative(const std::string key, Anchor anchor, const Vec2 offset) {
-    auto last = _entries.find(key);
+    Symbol name(key);
+    auto last = _entries.find(name);
     if (last != _entries.end()) {
         return false;
     }
@@ -152,7 +154,7 @@ bool AnchoredLayout::addRelative(const std::string key, Anchor anchor, const Vec
     entry.x_offset = offset.x;
     entry.y_offset = offset.y;
     entry.absolute = false;
-    _entries[key] = entry;
+    _entries[name] = entry;
     return true;
 }
 
@@ -171,7 +173,11 @@ bool AnchoredLayout::addRelative(const std::string key, Anchor anchor, const Vec
  * @return true if the layout information was removed for that key
  */
 bool AnchoredLayout::remove(const std::string key) {
-    auto entry = _entries.find(key);
+    Symbol name;
+    if (!Symbol::find(key,name)) {
+        return false;
+    }
+    auto entry = _entries.find(name);
     if (entry != _entries.end()) {
         _entries.erase(entry);
         return true;
@@ -207,7 +213,7 @@ void AnchoredLayout::layout(scene2::SceneNode* node) {
     auto kids = node->getChildren();
     Rect bounds = node->getLayoutBounds();
     for(auto it = kids.begin(); it != kids.end(); ++it) {
-        auto jt = _entries.find((*it)->getName());
+        auto jt = _entries.find((*it)->getSymbol());
         if (jt != _entries.end()) {
             Entry entry = jt->second;
             Vec2 offset;
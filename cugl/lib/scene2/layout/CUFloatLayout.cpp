@@ -152,7 +152,8 @@ void FloatLayout::dispose() {
  * @return true if the layout information was assigned to that key
  */
 bool FloatLayout::add(const std::string key, const std::shared_ptr<JsonValue>& data) {
-    auto search = _entries.find(key);
+    Symbol name(key);
+    auto search = _entries.find(name);
     if (search != _entries.end()) {
         CUAssertLog(false, "key '%s', is already in use", key.c_str());
         return false;
@@ -174,8 +175,8 @@ bool FloatLayout::add(const std::string key, const std::shared_ptr<JsonValue>& d
         entry.pad_top    = 0;
         entry.pad_bottom = 0;
     }
-    _entries[key] = entry;
-    _priority.push_back(key);
+    _entries[name] = entry;
+    _priority.push_back(name);
     return true;
 }
 
@@ -194,12 +195,16 @@ bool FloatLayout::add(const std::string key, const std::shared_ptr<JsonValue>& d
  * @return true if the layout information was removed for that key
  */
 bool FloatLayout::remove(const std::string key) {
-    auto it = _entries.find(key);
+    Symbol name;
+    if (!Symbol::find(key,name)) {
+        return false;
+    }
+    auto it = _entries.find(name);
     if (it == _entries.end()) {
         return false;
     }
     _entries.erase(it);
-    auto position = std::find(_priority.begin(), _priority.end(), key);
+    auto position = std::find(_priority.begin(), _priority.end(), name);
     if (position != _priority.end()) {
         _priority.erase(position);
     }
@@ -608,11 +613,11 @@ void FloatLayout::layoutVertical(SceneNode* node) {
  * queue to match the current layout values.
  */
 void FloatLayout::prioritize() {
-    auto sortrule = [this] (const std::string& s1, const std::string& s2) -> bool {
+    auto sortrule = [this] (const Symbol s1, const Symbol s2) -> bool {
         auto a = _entries.find(s1);
         auto b = _entries.find(s2);
         if (a == _entries.end()) {
-            return (b == _entries.end() ? s1.compare(s2) < 0 : false);
+            return (b == _entries.end() ? s1.str().compare(s2.str()) < 0 : false);
         } else if (b == _entries.end()) {
             return true;
         } else if (a->second.priority < 0) {
@@ -138,7 +138,8 @@ bool GridLayout::add(const std::string key, const std::shared_ptr<JsonValue>& da
  * @return true if the priority was assigned to that key
  */
 bool GridLayout::addPosition(const std::string key, unsigned int x, unsigned int y, Anchor anchor) {
-    auto last = _entries.find(key);
+    Symbol name(key);
+    auto last = _entries.find(name);
     if (last != _entries.end()) {
         return false;
     }
@@ -147,7 +148,7 @@ bool GridLayout::addPosition(const std::string key, unsigned int x, unsigned int
     entry.anchor = anchor;
     entry.x = x;
     entry.y = y;
-    _entries[key] = entry;
+    _entries[name] = entry;
     return true;
 }
 
@@ -166,7 +167,11 @@ bool GridLayout::addPosition(const std::string key, unsigned int x, unsigned int
  * @return true if the layout information was removed for that key
  */
 bool GridLayout::remove(const std::string key) {
-    auto entry = _entries.find(key);
+    Symbol name;
+    if (!Symbol::find(key,name)) {
+        return false;
+    }
+    auto entry = _entries.find(name);
     if (entry != _entries.end()) {
         _entries.erase(entry);
         return true;
@@ -197,7 +202,7 @@ void GridLayout::layout(SceneNode* node) {
     Rect bounds = node->getLayoutBounds();
     Size grid = Size(bounds.size.width/_gwidth,bounds.size.height/_gheight);
     for(auto it = kids.begin(); it != kids.end(); ++it) {
-        auto jt = _entries.find((*it)->getName());
+        auto jt = _entries.find((*it)->getSymbol());
         if (jt != _entries.end()) {
             Entry entry = jt->second;
             Vec2 pos(entry.x*grid.width+bounds.origin.x,entry.y*grid.height+bounds.origin.y);
@@ -1046,16 +1046,26 @@ void Label::draw(const std::shared_ptr<SpriteBatch>& batch, const Affine2& trans
         batch->setColor(tint*DROP_COLOR);
         Affine2 offset = Affine2::createTranslation(_dropOffset);
         offset *= transform;
-        for(auto it = _glyphrun.begin(); it != _glyphrun.end(); ++it) {
+        size_t pos = 0;
+        for(auto it = _glyphrun.begin(); it != _glyphrun.end(); ++it, ++pos) {
             batch->setTexture(it->second->texture);
-            batch->drawMesh(it->second->mesh, offset);
+            if (_shadow[pos].update(it->second->mesh, offset, tint*DROP_COLOR)) {
+                batch->drawMesh(_shadow[pos].getMesh(), Affine2::IDENTITY, false);
+            } else {
+                batch->drawMesh(it->second->mesh, offset);
+            }
         }
         batch->setBlur(0);
     }
     batch->setColor(tint);
-    for(auto it = _glyphrun.begin(); it != _glyphrun.end(); ++it) {
+    size_t pos = 0;
+    for(auto it = _glyphrun.begin(); it != _glyphrun.end(); ++it, ++pos) {
         batch->setTexture(it->second->texture);
-        batch->drawMesh(it->second->mesh, transform);
+        if (_cache[pos].update(it->second->mesh, transform, tint)) {
+            batch->drawMesh(_cache[pos].getMesh(), Affine2::IDENTITY, false);
+        } else {
+            batch->drawMesh(it->second->mesh, transform);
+        }
     }
 }
 
@@ -1080,6 +1090,7 @@ void Label::generateRenderData() {
             jt->color = _foreground.getPacked();
         }
     }
+    invalidateCache();
 
     _rendered = true;
 }
@@ -1089,6 +1100,7 @@ void Label::generateRenderData() {
  */
 void Label::clearRenderData() {
     _glyphrun.clear();
+    invalidateCache();
     _rendered = false;
 }
 
@@ -1108,6 +1120,24 @@ void Label::updateColor() {
             it->color = _foreground.getPacked();
         }
     }
+    invalidateCache();
+}
+
+/**
+ * Invalidates the cached vertices of the glyph runs.
+ *
+ * This method must be called whenever the glyph runs change. It also sizes
+ * the caches to match the glyph runs.
+ */
+void Label::invalidateCache() {
+    _cache.resize(_glyphrun.size());
+    _shadow.resize(_glyphrun.size());
+    for(auto it = _cache.begin(); it != _cache.end(); ++it) {
+        it->invalidate();
+    }
+    for(auto it = _shadow.begin(); it != _shadow.end(); ++it) {
+        it->invalidate();
+    }
 }
 
 /**
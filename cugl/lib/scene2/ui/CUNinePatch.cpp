@@ -86,6 +86,7 @@ void NinePatch::dispose() {
     _srcFactor = GL_SRC_ALPHA;
     _dstFactor = GL_ONE_MINUS_SRC_ALPHA;
     _mesh.clear();
+    _cache.invalidate();
     SceneNode::dispose();
 }
 
@@ -359,6 +360,7 @@ std::string NinePatch::toString(bool verbose) const {
  */
 void NinePatch::clearRenderData() {
     _mesh.clear();
+    _cache.invalidate();
     _indices.clear();
     _rendered = false;
 }
@@ -560,6 +562,10 @@ void NinePatch::draw(const std::shared_ptr<SpriteBatch>& batch, const Affine2& t
     batch->setBlendEquation(_blendEquation);
     batch->setSrcBlendFunc(_srcFactor);
     batch->setDstBlendFunc(_dstFactor);
-    batch->drawMesh(_mesh, transform);
+    if (_cache.update(_mesh, transform, tint)) {
+        batch->drawMesh(_cache.getMesh(), Affine2::IDENTITY, false);
+    } else {
+        batch->drawMesh(_mesh, transform);
+    }
 }
 
@@ -51,6 +51,8 @@
 //  Version: 11/18/21
 //
 #include <cugl/scene2/ui/CUScrollPane.h>
+#include <algorithm>
+#include <cmath>
 
 using namespace cugl;
 using namespace cugl::scene2;
@@ -467,7 +469,12 @@ _zoomamt(1.0f),
 _panemask(nullptr),
 _constrained(true),
 _reoriented(false),
-_simple(true) {
+_simple(true),
+_listmode(false),
+_rowcount(0),
+_rowheight(0),
+_rowmargin(2),
+_rowfirst(0) {
     _panetrans.setIdentity();
     _classname = "ScrollPane";
 }
@@ -490,6 +497,15 @@ void ScrollPane::dispose() {
     _reoriented = false;
     _simple = true;
     _panemask = nullptr;
+    _listmode = false;
+    _rowcount = 0;
+    _rowheight = 0;
+    _rowmargin = 2;
+    _rowfirst = 0;
+    _rowslots.clear();
+    _rowpool.clear();
+    _rowfactory = nullptr;
+    _rowbinder = nullptr;
     SceneNode::dispose();
 }
 
@@ -914,6 +930,7 @@ Vec2 ScrollPane::applyPan(const Vec2& delta) {
     } else {
         _panetrans.translate(delta);
     }
+    layoutRows();
     return result;
 }
 
@@ -976,6 +993,7 @@ float ScrollPane::applySpin(float angle) {
     _panetrans.translate(-center.x, -center.y);
     _panetrans.rotate(angle);
     _panetrans.translate(center.x, center.y);
+    layoutRows();
     return angle;
 }
 
@@ -1027,6 +1045,7 @@ float ScrollPane::applyZoom(float scale) {
     _panetrans.translate(-center.x, -center.y);
     _panetrans.scale(scale,scale);
     _panetrans.translate(center.x, center.y);
+    layoutRows();
     return scale;
 }
 
@@ -1064,8 +1083,243 @@ void ScrollPane::resetPane() {
         
         _panetrans.translate(offset);
     }
+    layoutRows();
 }
     
+#pragma mark -
+#pragma mark List Virtualization
+/**
+ * Makes this scroll pane a virtualized list with the given rows.
+ *
+ * The list is a single column of rows of the given height, with row 0 at
+ * the top. The interior is resized to fit all of the rows (or the content
+ * size, whichever is larger), and the pane is reset to show row 0.
+ *
+ * The pane only has nodes for the visible rows (plus the row margin).
+ * Row nodes are created by the factory as needed, and bound to a row
+ * with the binder. The binder is only called when a node is assigned to
+ * a new row, so it is not called every frame. Use {@link #refreshRows}
+ * if the data for the visible rows has changed.
+ *
+ * Row nodes are positioned with their bottom left corner at the bottom
+ * left corner of their row. They are children of this pane, but they
+ * should not be modified except by the binder. Any layout manager for
+ * this pane should ignore them.
+ *
+ * @param rows      The number of rows
+ * @param height    The height of each row
+ * @param factory   The function to create a row node
+ * @param binder    The function to bind a row node to a row
+ */
+void ScrollPane::setList(size_t rows, float height, RowFactory factory, RowBinder binder) {
+    CUAssertLog(height > 0, "Row height %f is not positive", height);
+    CUAssertLog(factory != nullptr && binder != nullptr, "List functions must be defined");
+    clearList();
+    _rowheight  = height;
+    _rowfactory = factory;
+    _rowbinder  = binder;
+    _listmode = true;
+    _rowcount = rows;
+    
+    float total = std::max(rows*height,_contentSize.height);
+    setInterior(Rect(0,_contentSize.height-total,_contentSize.width,total));
+}
+
+/**
+ * Removes the virtualized list from this scroll pane.
+ *
+ * All row nodes are removed from this pane. The interior is unchanged.
+ */
+void ScrollPane::clearList() {
+    for(auto it = _rowslots.begin(); it != _rowslots.end(); ++it) {
+        if (*it != nullptr) {
+            removeChild(*it);
+        }
+    }
+    for(auto it = _rowpool.begin(); it != _rowpool.end(); ++it) {
+        removeChild(*it);
+    }
+    _rowslots.clear();
+    _rowpool.clear();
+    _rowfactory = nullptr;
+    _rowbinder = nullptr;
+    _rowfirst = 0;
+    _rowcount = 0;
+    _rowheight = 0;
+    _listmode = false;
+}
+
+/**
+ * Sets the number of rows in the list.
+ *
+ * The interior is resized to fit the rows, keeping the top of the list
+ * in place, so appending rows does not disturb the current scroll
+ * position. Rows that stay visible are not rebound. Call
+ * {@link #refreshRows} if their data has changed as well.
+ *
+ * @param rows  The number of rows in the list.
+ */
+void ScrollPane::setRowCount(size_t rows) {
+    if (!_listmode) {
+        return;
+    }
+    _rowcount = rows;
+    float top = _interior.origin.y+_interior.size.height;
+    float total = std::max(rows*_rowheight,_contentSize.height);
+    _interior.set(_interior.origin.x,top-total,_interior.size.width,total);
+    if (_constrained) {
+        // A zero pan clamps the pane (and lays out the rows)
+        applyPan(Vec2::ZERO);
+    } else {
+        layoutRows();
+    }
+}
+
+/**
+ * Sets the number of extra rows bound above and below the visible rows.
+ *
+ * The margin allows small scrolls without binding any rows. The default
+ * is 2.
+ *
+ * @param margin    The number of extra rows bound above and below the visible rows.
+ */
+void ScrollPane::setRowMargin(Uint32 margin) {
+    _rowmargin = margin;
+    layoutRows();
+}
+
+/**
+ * Returns the row node bound to the given list row.
+ *
+ * This method returns nullptr if the row is not visible (or in the
+ * margin), and so has no node.
+ *
+ * @param row   The list row
+ *
+ * @return the row node bound to the given list row.
+ */
+std::shared_ptr<SceneNode> ScrollPane::getRowNode(size_t row) const {
+    if (row < _rowfirst || row >= _rowfirst+_rowslots.size()) {
+        return nullptr;
+    }
+    return _rowslots[row-_rowfirst];
+}
+
+/**
+ * Rebinds all of the row nodes to their rows.
+ *
+ * This method should be called when the data for the visible rows has
+ * changed.
+ */
+void ScrollPane::refreshRows() {
+    size_t row = _rowfirst;
+    for(auto it = _rowslots.begin(); it != _rowslots.end(); ++it, ++row) {
+        if (*it != nullptr) {
+            _rowbinder(row,*it);
+        }
+    }
+}
+
+/**
+ * Binds row nodes to the list rows that are visible.
+ *
+ * Row nodes for rows that are no longer visible (or in the margin) are
+ * hidden and returned to the pool. Rows that have become visible are
+ * assigned a node from the pool, or a new one if the pool is empty.
+ * Rows that stay visible are not rebound.
+ */
+void ScrollPane::layoutRows() {
+    if (!_listmode) {
+        return;
+    }
+    
+    // Find the rows under the content bounds
+    size_t first = 0;
+    size_t last  = 0;
+    if (_rowcount) {
+        Rect view(Vec2::ZERO,_contentSize);
+        view = _panetrans.getInverse().transform(view);
+        float top = _interior.origin.y+_interior.size.height;
+        double lo = std::floor((top-view.getMaxY())/_rowheight)-_rowmargin;
+        double hi = std::ceil((top-view.getMinY())/_rowheight)+_rowmargin;
+        lo = std::max(lo,0.0);
+        hi = std::min(hi,(double)_rowcount);
+        if (lo < hi) {
+            first = (size_t)lo;
+            last  = (size_t)hi;
+        }
+    }
+    
+    // Recycle the rows that are no longer visible
+    if (last <= _rowfirst || first >= _rowfirst+_rowslots.size()) {
+        for(auto it = _rowslots.begin(); it != _rowslots.end(); ++it) {
+            recycleRow(*it);
+        }
+        _rowslots.clear();
+        _rowfirst = first;
+    } else {
+        while (_rowfirst < first) {
+            recycleRow(_rowslots.front());
+            _rowslots.pop_front();
+            _rowfirst++;
+        }
+        while (_rowfirst+_rowslots.size() > last) {
+            recycleRow(_rowslots.back());
+            _rowslots.pop_back();
+        }
+    }
+    
+    // Bind the rows that are now visible
+    while (_rowfirst > first) {
+        _rowfirst--;
+        _rowslots.push_front(acquireRow(_rowfirst));
+    }
+    while (_rowfirst+_rowslots.size() < last) {
+        _rowslots.push_back(acquireRow(_rowfirst+_rowslots.size()));
+    }
+}
+
+/**
+ * Returns a row node bound to the given list row.
+ *
+ * @param row   The list row
+ *
+ * @return a row node bound to the given list row.
+ */
+std::shared_ptr<SceneNode> ScrollPane::acquireRow(size_t row) {
+    std::shared_ptr<SceneNode> node = nullptr;
+    if (!_rowpool.empty()) {
+        node = _rowpool.back();
+        _rowpool.pop_back();
+    } else {
+        node = _rowfactory();
+        if (node == nullptr) {
+            CUAssertLog(false, "Row factory did not create a node");
+            return nullptr;
+        }
+        addChild(node);
+    }
+    
+    float top = _interior.origin.y+_interior.size.height;
+    node->setAnchor(Vec2::ANCHOR_BOTTOM_LEFT);
+    node->setPosition(_interior.origin.x,top-(row+1)*_rowheight);
+    node->setVisible(true);
+    _rowbinder(row,node);
+    return node;
+}
+
+/**
+ * Hides the given row node and returns it to the pool.
+ *
+ * @param node  The row node to recycle
+ */
+void ScrollPane::recycleRow(const std::shared_ptr<SceneNode>& node) {
+    if (node != nullptr) {
+        node->setVisible(false);
+        _rowpool.push_back(node);
+    }
+}
+
 #pragma mark -
 #pragma mark Rendering
 /**
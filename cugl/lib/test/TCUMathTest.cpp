@@ -8963,6 +8963,661 @@ void cugl::testDSP() {
           cugl::Timestamp::ellapsedMicros(start,midl),
           cugl::Timestamp::ellapsedMicros(midl,end));
     
+#pragma mark DSP Conversion
+    // Sizes are odd so that the scalar tails run after the vector loops
+    int pcmsize = ARRAY_SIZE-7;
+    bool heard = false;
+    Sint8*  s8buff   = new Sint8[ARRAY_SIZE];
+    Uint8*  u8buff   = new Uint8[ARRAY_SIZE];
+    Sint16* s16buff  = new Sint16[ARRAY_SIZE];
+    Sint32* s32buff  = new Sint32[ARRAY_SIZE];
+    Sint8*  s8out1   = new Sint8[ARRAY_SIZE];
+    Sint8*  s8out2   = new Sint8[ARRAY_SIZE];
+    Uint8*  u8out1   = new Uint8[ARRAY_SIZE];
+    Uint8*  u8out2   = new Uint8[ARRAY_SIZE];
+    Sint16* s16out1  = new Sint16[ARRAY_SIZE];
+    Sint16* s16out2  = new Sint16[ARRAY_SIZE];
+    Uint16* u16out1  = new Uint16[ARRAY_SIZE];
+    Uint16* u16out2  = new Uint16[ARRAY_SIZE];
+    Sint32* s32out1  = new Sint32[ARRAY_SIZE];
+    Sint32* s32out2  = new Sint32[ARRAY_SIZE];
+    
+    Uint32 seed = 1;
+    for(int ii = 0; ii < ARRAY_SIZE; ii++) {
+        seed = seed*1664525u+1013904223u;
+        s8buff[ii]  = (Sint8)(seed >> 24);
+        u8buff[ii]  = (Uint8)(seed >> 24);
+        s16buff[ii] = (Sint16)(seed >> 16);
+        s32buff[ii] = (Sint32)seed;
+    }
+    
+    // 8-bit WAV pages
+    start.mark();
+    DSPMath::VECTORIZE = true;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::s8_to_float(s8buff,output1,pcmsize,1.0f/(1 << 8));
+    }
+    midl.mark();
+    DSPMath::VECTORIZE = false;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::s8_to_float(s8buff,output2,pcmsize,1.0f/(1 << 8));
+    }
+    end.mark();
+    
+    same = -1;
+    for(int ii = 0; same == -1 && ii < pcmsize; ii++) {
+        if (fabsf(output1[ii] - output2[ii]) >= CU_MATH_EPSILON) {
+            same = ii;
+        }
+    }
+    CUAssertAlwaysLog(same == -1, "%s failed at position %d [%f vs %f]",
+                      "s8_to_float",same,output1[same],output2[same]);
+    
+    CULog("%s time: %llu vs %llu micros","s8_to_float",
+          cugl::Timestamp::ellapsedMicros(start,midl),
+          cugl::Timestamp::ellapsedMicros(midl,end));
+    
+    same = -1;
+    heard = false;
+    for(int ii = 0; same == -1 && ii < pcmsize; ii++) {
+        heard = heard || output1[ii] != 0;
+        if (fabsf(output1[ii]) > 1.0f) {
+            same = ii;
+        }
+    }
+    CUAssertAlwaysLog(same == -1, "%s out of range at position %d [%f]",
+                      "s8_to_float",same,output1[same]);
+    CUAssertAlwaysLog(heard, "%s produced silence", "s8_to_float");
+    
+    start.mark();
+    DSPMath::VECTORIZE = true;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::u8_to_float(u8buff,output1,pcmsize,1.0f/(1 << 8));
+    }
+    midl.mark();
+    DSPMath::VECTORIZE = false;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::u8_to_float(u8buff,output2,pcmsize,1.0f/(1 << 8));
+    }
+    end.mark();
+    
+    same = -1;
+    for(int ii = 0; same == -1 && ii < pcmsize; ii++) {
+        if (fabsf(output1[ii] - output2[ii]) >= CU_MATH_EPSILON) {
+            same = ii;
+        }
+    }
+    CUAssertAlwaysLog(same == -1, "%s failed at position %d [%f vs %f]",
+                      "u8_to_float",same,output1[same],output2[same]);
+    
+    CULog("%s time: %llu vs %llu micros","u8_to_float",
+          cugl::Timestamp::ellapsedMicros(start,midl),
+          cugl::Timestamp::ellapsedMicros(midl,end));
+    
+    same = -1;
+    heard = false;
+    for(int ii = 0; same == -1 && ii < pcmsize; ii++) {
+        heard = heard || output1[ii] != 0;
+        if (fabsf(output1[ii]) > 1.0f) {
+            same = ii;
+        }
+    }
+    CUAssertAlwaysLog(same == -1, "%s out of range at position %d [%f]",
+                      "u8_to_float",same,output1[same]);
+    CUAssertAlwaysLog(heard, "%s produced silence", "u8_to_float");
+    
+    // MP3 pages and byte-swapped 16-bit WAV pages
+    start.mark();
+    DSPMath::VECTORIZE = true;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::s16_to_float(s16buff,output1,pcmsize,1.0f/(SHRT_MAX+1),false);
+    }
+    midl.mark();
+    DSPMath::VECTORIZE = false;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::s16_to_float(s16buff,output2,pcmsize,1.0f/(SHRT_MAX+1),false);
+    }
+    end.mark();
+    
+    same = -1;
+    for(int ii = 0; same == -1 && ii < pcmsize; ii++) {
+        if (fabsf(output1[ii] - output2[ii]) >= CU_MATH_EPSILON) {
+            same = ii;
+        }
+    }
+    CUAssertAlwaysLog(same == -1, "%s failed at position %d [%f vs %f]",
+                      "s16_to_float",same,output1[same],output2[same]);
+    
+    CULog("%s time: %llu vs %llu micros","s16_to_float",
+          cugl::Timestamp::ellapsedMicros(start,midl),
+          cugl::Timestamp::ellapsedMicros(midl,end));
+    
+    same = -1;
+    heard = false;
+    for(int ii = 0; same == -1 && ii < pcmsize; ii++) {
+        heard = heard || output1[ii] != 0;
+        if (fabsf(output1[ii]) > 1.0f) {
+            same = ii;
+        }
+    }
+    CUAssertAlwaysLog(same == -1, "%s out of range at position %d [%f]",
+                      "s16_to_float",same,output1[same]);
+    CUAssertAlwaysLog(heard, "%s produced silence", "s16_to_float");
+    
+    start.mark();
+    DSPMath::VECTORIZE = true;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::s16_to_float(s16buff,output1,pcmsize,1.0f/(1 << 16),true);
+    }
+    midl.mark();
+    DSPMath::VECTORIZE = false;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::s16_to_float(s16buff,output2,pcmsize,1.0f/(1 << 16),true);
+    }
+    end.mark();
+    
+    same = -1;
+    for(int ii = 0; same == -1 && ii < pcmsize; ii++) {
+        if (fabsf(output1[ii] - output2[ii]) >= CU_MATH_EPSILON) {
+            same = ii;
+        }
+    }
+    CUAssertAlwaysLog(same == -1, "%s failed at position %d [%f vs %f]",
+                      "s16_to_float (swap)",same,output1[same],output2[same]);
+    
+    CULog("%s time: %llu vs %llu micros","s16_to_float (swap)",
+          cugl::Timestamp::ellapsedMicros(start,midl),
+          cugl::Timestamp::ellapsedMicros(midl,end));
+    
+    same = -1;
+    heard = false;
+    for(int ii = 0; same == -1 && ii < pcmsize; ii++) {
+        heard = heard || output1[ii] != 0;
+        if (fabsf(output1[ii]) > 1.0f) {
+            same = ii;
+        }
+    }
+    CUAssertAlwaysLog(same == -1, "%s out of range at position %d [%f]",
+                      "s16_to_float (swap)",same,output1[same]);
+    CUAssertAlwaysLog(heard, "%s produced silence", "s16_to_float (swap)");
+    
+    // FLAC pages start at an offset into the decoded block
+    int offset = 3;
+    float flacscale = 1.0f/(1L << 24);
+    for(int ii = 0; ii < ARRAY_SIZE; ii++) {
+        s32buff[ii] = s32buff[ii] >> 8;
+    }
+    start.mark();
+    DSPMath::VECTORIZE = true;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::s32_to_float(s32buff+offset,output1,pcmsize,flacscale,false);
+    }
+    midl.mark();
+    DSPMath::VECTORIZE = false;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::s32_to_float(s32buff+offset,output2,pcmsize,flacscale,false);
+    }
+    end.mark();
+    
+    same = -1;
+    for(int ii = 0; same == -1 && ii < pcmsize; ii++) {
+        if (fabsf(output1[ii] - output2[ii]) >= CU_MATH_EPSILON) {
+            same = ii;
+        }
+    }
+    CUAssertAlwaysLog(same == -1, "%s failed at position %d [%f vs %f]",
+                      "s32_to_float",same,output1[same],output2[same]);
+    
+    CULog("%s time: %llu vs %llu micros","s32_to_float",
+          cugl::Timestamp::ellapsedMicros(start,midl),
+          cugl::Timestamp::ellapsedMicros(midl,end));
+    
+    same = -1;
+    heard = false;
+    for(int ii = 0; same == -1 && ii < pcmsize; ii++) {
+        heard = heard || output1[ii] != 0;
+        if (fabsf(output1[ii]) > 1.0f) {
+            same = ii;
+        }
+    }
+    CUAssertAlwaysLog(same == -1, "%s out of range at position %d [%f]",
+                      "s32_to_float",same,output1[same]);
+    CUAssertAlwaysLog(heard, "%s produced silence", "s32_to_float");
+    
+    same = -1;
+    for(int ii = 0; same == -1 && ii < pcmsize; ii++) {
+        if (output1[ii] != s32buff[ii+offset]*flacscale) {
+            same = ii;
+        }
+    }
+    CUAssertAlwaysLog(same == -1, "%s ignored the offset at position %d [%f vs %f]",
+                      "s32_to_float",same,output1[same],s32buff[same+offset]*flacscale);
+    
+    start.mark();
+    DSPMath::VECTORIZE = true;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::s32_to_float(s32buff,output1,pcmsize,1.0f/(((Uint64)1) << 32),true);
+    }
+    midl.mark();
+    DSPMath::VECTORIZE = false;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::s32_to_float(s32buff,output2,pcmsize,1.0f/(((Uint64)1) << 32),true);
+    }
+    end.mark();
+    
+    same = -1;
+    for(int ii = 0; same == -1 && ii < pcmsize; ii++) {
+        if (fabsf(output1[ii] - output2[ii]) >= CU_MATH_EPSILON) {
+            same = ii;
+        }
+    }
+    CUAssertAlwaysLog(same == -1, "%s failed at position %d [%f vs %f]",
+                      "s32_to_float (swap)",same,output1[same],output2[same]);
+    
+    CULog("%s time: %llu vs %llu micros","s32_to_float (swap)",
+          cugl::Timestamp::ellapsedMicros(start,midl),
+          cugl::Timestamp::ellapsedMicros(midl,end));
+    
+    same = -1;
+    heard = false;
+    for(int ii = 0; same == -1 && ii < pcmsize; ii++) {
+        heard = heard || output1[ii] != 0;
+        if (fabsf(output1[ii]) > 1.0f) {
+            same = ii;
+        }
+    }
+    CUAssertAlwaysLog(same == -1, "%s out of range at position %d [%f]",
+                      "s32_to_float (swap)",same,output1[same]);
+    CUAssertAlwaysLog(heard, "%s produced silence", "s32_to_float (swap)");
+    
+    // Overdrive the signal so that the conversions must clip
+    for(int ii = 0; ii < ARRAY_SIZE; ii++) {
+        output1[ii] = 1.25f*input1[ii];
+    }
+    
+    start.mark();
+    DSPMath::VECTORIZE = true;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::float_to_s8(output1,s8out1,pcmsize);
+    }
+    midl.mark();
+    DSPMath::VECTORIZE = false;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::float_to_s8(output1,s8out2,pcmsize);
+    }
+    end.mark();
+    
+    same = -1;
+    for(int ii = 0; same == -1 && ii < pcmsize; ii++) {
+        if (s8out1[ii] != s8out2[ii]) {
+            same = ii;
+        }
+    }
+    CUAssertAlwaysLog(same == -1, "%s failed at position %d [%d vs %d]",
+                      "float_to_s8",same,(int)s8out1[same],(int)s8out2[same]);
+    
+    CULog("%s time: %llu vs %llu micros","float_to_s8",
+          cugl::Timestamp::ellapsedMicros(start,midl),
+          cugl::Timestamp::ellapsedMicros(midl,end));
+    
+    start.mark();
+    DSPMath::VECTORIZE = true;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::float_to_u8(output1,u8out1,pcmsize);
+    }
+    midl.mark();
+    DSPMath::VECTORIZE = false;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::float_to_u8(output1,u8out2,pcmsize);
+    }
+    end.mark();
+    
+    same = -1;
+    for(int ii = 0; same == -1 && ii < pcmsize; ii++) {
+        if (u8out1[ii] != u8out2[ii]) {
+            same = ii;
+        }
+    }
+    CUAssertAlwaysLog(same == -1, "%s failed at position %d [%d vs %d]",
+                      "float_to_u8",same,(int)u8out1[same],(int)u8out2[same]);
+    
+    CULog("%s time: %llu vs %llu micros","float_to_u8",
+          cugl::Timestamp::ellapsedMicros(start,midl),
+          cugl::Timestamp::ellapsedMicros(midl,end));
+    
+    start.mark();
+    DSPMath::VECTORIZE = true;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::float_to_s16(output1,s16out1,pcmsize,false);
+    }
+    midl.mark();
+    DSPMath::VECTORIZE = false;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::float_to_s16(output1,s16out2,pcmsize,false);
+    }
+    end.mark();
+    
+    same = -1;
+    for(int ii = 0; same == -1 && ii < pcmsize; ii++) {
+        if (s16out1[ii] != s16out2[ii]) {
+            same = ii;
+        }
+    }
+    CUAssertAlwaysLog(same == -1, "%s failed at position %d [%d vs %d]",
+                      "float_to_s16",same,(int)s16out1[same],(int)s16out2[same]);
+    
+    CULog("%s time: %llu vs %llu micros","float_to_s16",
+          cugl::Timestamp::ellapsedMicros(start,midl),
+          cugl::Timestamp::ellapsedMicros(midl,end));
+    
+    start.mark();
+    DSPMath::VECTORIZE = true;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::float_to_s16(output1,s16out1,pcmsize,true);
+    }
+    midl.mark();
+    DSPMath::VECTORIZE = false;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::float_to_s16(output1,s16out2,pcmsize,true);
+    }
+    end.mark();
+    
+    same = -1;
+    for(int ii = 0; same == -1 && ii < pcmsize; ii++) {
+        if (s16out1[ii] != s16out2[ii]) {
+            same = ii;
+        }
+    }
+    CUAssertAlwaysLog(same == -1, "%s failed at position %d [%d vs %d]",
+                      "float_to_s16 (swap)",same,(int)s16out1[same],(int)s16out2[same]);
+    
+    CULog("%s time: %llu vs %llu micros","float_to_s16 (swap)",
+          cugl::Timestamp::ellapsedMicros(start,midl),
+          cugl::Timestamp::ellapsedMicros(midl,end));
+    
+    start.mark();
+    DSPMath::VECTORIZE = true;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::float_to_u16(output1,u16out1,pcmsize,false);
+    }
+    midl.mark();
+    DSPMath::VECTORIZE = false;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::float_to_u16(output1,u16out2,pcmsize,false);
+    }
+    end.mark();
+    
+    same = -1;
+    for(int ii = 0; same == -1 && ii < pcmsize; ii++) {
+        if (u16out1[ii] != u16out2[ii]) {
+            same = ii;
+        }
+    }
+    CUAssertAlwaysLog(same == -1, "%s failed at position %d [%d vs %d]",
+                      "float_to_u16",same,(int)u16out1[same],(int)u16out2[same]);
+    
+    CULog("%s time: %llu vs %llu micros","float_to_u16",
+          cugl::Timestamp::ellapsedMicros(start,midl),
+          cugl::Timestamp::ellapsedMicros(midl,end));
+    
+    start.mark();
+    DSPMath::VECTORIZE = true;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::float_to_u16(output1,u16out1,pcmsize,true);
+    }
+    midl.mark();
+    DSPMath::VECTORIZE = false;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::float_to_u16(output1,u16out2,pcmsize,true);
+    }
+    end.mark();
+    
+    same = -1;
+    for(int ii = 0; same == -1 && ii < pcmsize; ii++) {
+        if (u16out1[ii] != u16out2[ii]) {
+            same = ii;
+        }
+    }
+    CUAssertAlwaysLog(same == -1, "%s failed at position %d [%d vs %d]",
+                      "float_to_u16 (swap)",same,(int)u16out1[same],(int)u16out2[same]);
+    
+    CULog("%s time: %llu vs %llu micros","float_to_u16 (swap)",
+          cugl::Timestamp::ellapsedMicros(start,midl),
+          cugl::Timestamp::ellapsedMicros(midl,end));
+    
+    start.mark();
+    DSPMath::VECTORIZE = true;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::float_to_s32(output1,s32out1,pcmsize,false);
+    }
+    midl.mark();
+    DSPMath::VECTORIZE = false;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::float_to_s32(output1,s32out2,pcmsize,false);
+    }
+    end.mark();
+    
+    same = -1;
+    for(int ii = 0; same == -1 && ii < pcmsize; ii++) {
+        if (s32out1[ii] != s32out2[ii]) {
+            same = ii;
+        }
+    }
+    CUAssertAlwaysLog(same == -1, "%s failed at position %d [%d vs %d]",
+                      "float_to_s32",same,(int)s32out1[same],(int)s32out2[same]);
+    
+    CULog("%s time: %llu vs %llu micros","float_to_s32",
+          cugl::Timestamp::ellapsedMicros(start,midl),
+          cugl::Timestamp::ellapsedMicros(midl,end));
+    
+    start.mark();
+    DSPMath::VECTORIZE = true;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::float_to_s32(output1,s32out1,pcmsize,true);
+    }
+    midl.mark();
+    DSPMath::VECTORIZE = false;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::float_to_s32(output1,s32out2,pcmsize,true);
+    }
+    end.mark();
+    
+    same = -1;
+    for(int ii = 0; same == -1 && ii < pcmsize; ii++) {
+        if (s32out1[ii] != s32out2[ii]) {
+            same = ii;
+        }
+    }
+    CUAssertAlwaysLog(same == -1, "%s failed at position %d [%d vs %d]",
+                      "float_to_s32 (swap)",same,(int)s32out1[same],(int)s32out2[same]);
+    
+    CULog("%s time: %llu vs %llu micros","float_to_s32 (swap)",
+          cugl::Timestamp::ellapsedMicros(start,midl),
+          cugl::Timestamp::ellapsedMicros(midl,end));
+    
+    start.mark();
+    DSPMath::VECTORIZE = true;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::swap_float(input1,output1,pcmsize);
+    }
+    midl.mark();
+    DSPMath::VECTORIZE = false;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::swap_float(input1,output2,pcmsize);
+    }
+    end.mark();
+    
+    same = -1;
+    for(int ii = 0; same == -1 && ii < pcmsize; ii++) {
+        if (((Uint32*)output1)[ii] != ((Uint32*)output2)[ii]) {
+            same = ii;
+        }
+    }
+    CUAssertAlwaysLog(same == -1, "%s failed at position %d [%d vs %d]",
+                      "swap_float",same,(int)((Uint32*)output1)[same],(int)((Uint32*)output2)[same]);
+    
+    CULog("%s time: %llu vs %llu micros","swap_float",
+          cugl::Timestamp::ellapsedMicros(start,midl),
+          cugl::Timestamp::ellapsedMicros(midl,end));
+    
+#pragma mark DSP Interleave
+    // OGG pages are planar; three channels takes the scalar path
+    float* planes[3];
+    planes[0] = input1;
+    planes[1] = input2;
+    planes[2] = input1+1;
+    int frames = ARRAY_SIZE/3-1;
+    
+    start.mark();
+    DSPMath::VECTORIZE = true;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::interleave(planes,output1,2,frames);
+    }
+    midl.mark();
+    DSPMath::VECTORIZE = false;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::interleave(planes,output2,2,frames);
+    }
+    end.mark();
+    
+    same = -1;
+    for(int ii = 0; same == -1 && ii < 2*frames; ii++) {
+        if (fabsf(output1[ii] - output2[ii]) >= CU_MATH_EPSILON) {
+            same = ii;
+        }
+    }
+    CUAssertAlwaysLog(same == -1, "%s failed at position %d [%f vs %f]",
+                      "interleave (2)",same,output1[same],output2[same]);
+    
+    CULog("%s time: %llu vs %llu micros","interleave (2)",
+          cugl::Timestamp::ellapsedMicros(start,midl),
+          cugl::Timestamp::ellapsedMicros(midl,end));
+    
+    same = -1;
+    for(int ii = 0; same == -1 && ii < 2*frames; ii++) {
+        if (output1[ii] != planes[ii % 2][ii / 2]) {
+            same = ii;
+        }
+    }
+    CUAssertAlwaysLog(same == -1, "%s misplaced position %d [%f]",
+                      "interleave (2)",same,output1[same]);
+    
+    start.mark();
+    DSPMath::VECTORIZE = true;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::interleave(planes,output1,3,frames);
+    }
+    midl.mark();
+    DSPMath::VECTORIZE = false;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::interleave(planes,output2,3,frames);
+    }
+    end.mark();
+    
+    same = -1;
+    for(int ii = 0; same == -1 && ii < 3*frames; ii++) {
+        if (fabsf(output1[ii] - output2[ii]) >= CU_MATH_EPSILON) {
+            same = ii;
+        }
+    }
+    CUAssertAlwaysLog(same == -1, "%s failed at position %d [%f vs %f]",
+                      "interleave (3)",same,output1[same],output2[same]);
+    
+    CULog("%s time: %llu vs %llu micros","interleave (3)",
+          cugl::Timestamp::ellapsedMicros(start,midl),
+          cugl::Timestamp::ellapsedMicros(midl,end));
+    
+    same = -1;
+    for(int ii = 0; same == -1 && ii < 3*frames; ii++) {
+        if (output1[ii] != planes[ii % 3][ii / 3]) {
+            same = ii;
+        }
+    }
+    CUAssertAlwaysLog(same == -1, "%s misplaced position %d [%f]",
+                      "interleave (3)",same,output1[same]);
+    
+    float* split1[3];
+    float* split2[3];
+    for(int ii = 0; ii < 3; ii++) {
+        split1[ii] = new float[frames];
+        split2[ii] = new float[frames];
+    }
+    
+    DSPMath::interleave(planes,output1,2,frames);
+    start.mark();
+    DSPMath::VECTORIZE = true;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::deinterleave(output1,split1,2,frames);
+    }
+    midl.mark();
+    DSPMath::VECTORIZE = false;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::deinterleave(output1,split2,2,frames);
+    }
+    end.mark();
+    
+    same = -1;
+    for(int ii = 0; same == -1 && ii < 2*frames; ii++) {
+        float orig = planes[ii % 2][ii / 2];
+        if (split1[ii % 2][ii / 2] != orig || split2[ii % 2][ii / 2] != orig) {
+            same = ii;
+        }
+    }
+    CUAssertAlwaysLog(same == -1, "%s failed at position %d [%f vs %f]",
+                      "deinterleave (2)",same,
+                      split1[same % 2][same / 2],split2[same % 2][same / 2]);
+    
+    CULog("%s time: %llu vs %llu micros","deinterleave (2)",
+          cugl::Timestamp::ellapsedMicros(start,midl),
+          cugl::Timestamp::ellapsedMicros(midl,end));
+    
+    DSPMath::interleave(planes,output1,3,frames);
+    start.mark();
+    DSPMath::VECTORIZE = true;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::deinterleave(output1,split1,3,frames);
+    }
+    midl.mark();
+    DSPMath::VECTORIZE = false;
+    for(int ii = 0; ii < LOOP_SIZE; ii++) {
+        DSPMath::deinterleave(output1,split2,3,frames);
+    }
+    end.mark();
+    
+    same = -1;
+    for(int ii = 0; same == -1 && ii < 3*frames; ii++) {
+        float orig = planes[ii % 3][ii / 3];
+        if (split1[ii % 3][ii / 3] != orig || split2[ii % 3][ii / 3] != orig) {
+            same = ii;
+        }
+    }
+    CUAssertAlwaysLog(same == -1, "%s failed at position %d [%f vs %f]",
+                      "deinterleave (3)",same,
+                      split1[same % 3][same / 3],split2[same % 3][same / 3]);
+    
+    CULog("%s time: %llu vs %llu micros","deinterleave (3)",
+          cugl::Timestamp::ellapsedMicros(start,midl),
+          cugl::Timestamp::ellapsedMicros(midl,end));
+    
+    for(int ii = 0; ii < 3; ii++) {
+        delete[] split1[ii];
+        delete[] split2[ii];
+    }
+    delete[] s8buff;
+    delete[] u8buff;
+    delete[] s16buff;
+    delete[] s32buff;
+    delete[] s8out1;
+    delete[] s8out2;
+    delete[] u8out1;
+    delete[] u8out2;
+    delete[] s16out1;
+    delete[] s16out2;
+    delete[] u16out1;
+    delete[] u16out2;
+    delete[] s32out1;
+    delete[] s32out2;
+    
 #pragma mark Complete
     delete[] input1;
     delete[] input2;
@@ -9312,6 +9967,163 @@ void cugl::testFilters() {
     CULog("Filter tests complete.\n");
 }
 
+
+#pragma mark -
+#pragma mark ADPCM
+
+/** The standard MS ADPCM coefficient pairs */
+static const Sint16 MS_COEFFS[7][2] = {
+    {256, 0}, {512, -256}, {0, 0}, {192, 64}, {240, 0}, {460, -208}, {392, -232}
+};
+
+/**
+ * Writes a WAV file of random ADPCM blocks
+ *
+ * The blocks are not real audio, but every block is valid for the given
+ * encoding (0x0002 for MS and 0x0011 for IMA).
+ *
+ * @param file      The file to write
+ * @param encoding  The ADPCM encoding
+ * @param channels  The number of channels
+ * @param blocks    The number of blocks
+ *
+ * @return true if the file was written successfully
+ */
+static bool writeADPCM(const std::string& file, Uint16 encoding, Uint16 channels, Uint32 blocks) {
+    Uint16 blockalign = 512*channels;
+    bool isMS = (encoding == 0x0002);
+    Uint16 blocksize;
+    Uint16 extra;
+    if (isMS) {
+        blocksize = (blockalign-7*channels)*2/channels+2;
+        extra = 4+4*7;
+    } else {
+        blocksize = (blockalign-4*channels)*8/(4*channels)+1;
+        extra = 2;
+    }
+    
+    SDL_RWops* output = SDL_RWFromFile(file.c_str(),"wb");
+    if (output == nullptr) {
+        return false;
+    }
+    
+    Uint32 datalen = blocks*blockalign;
+    SDL_WriteLE32(output,0x46464952);   // RIFF
+    SDL_WriteLE32(output,4+(8+18+extra)+(8+datalen));
+    SDL_WriteLE32(output,0x45564157);   // WAVE
+    SDL_WriteLE32(output,0x20746D66);   // fmt
+    SDL_WriteLE32(output,18+extra);
+    SDL_WriteLE16(output,encoding);
+    SDL_WriteLE16(output,channels);
+    SDL_WriteLE32(output,22050);
+    SDL_WriteLE32(output,22050*blockalign/blocksize);
+    SDL_WriteLE16(output,blockalign);
+    SDL_WriteLE16(output,4);
+    SDL_WriteLE16(output,extra);
+    SDL_WriteLE16(output,blocksize);
+    if (isMS) {
+        SDL_WriteLE16(output,7);
+        for(int ii = 0; ii < 7; ii++) {
+            SDL_WriteLE16(output,(Uint16)MS_COEFFS[ii][0]);
+            SDL_WriteLE16(output,(Uint16)MS_COEFFS[ii][1]);
+        }
+    }
+    SDL_WriteLE32(output,0x61746164);   // data
+    SDL_WriteLE32(output,datalen);
+    
+    Uint8* block = new Uint8[blockalign];
+    for(Uint32 ii = 0; ii < blocks; ii++) {
+        for(Uint16 jj = 0; jj < blockalign; jj++) {
+            block[jj] = (Uint8)(rand() & 0xff);
+        }
+        if (isMS) {
+            for(Uint16 jj = 0; jj < channels; jj++) {
+                block[jj] %= 7;
+            }
+        } else {
+            // The step index is clamped, but the reserved byte must be 0
+            for(Uint16 jj = 0; jj < channels; jj++) {
+                block[4*jj+3] = 0;
+            }
+        }
+        SDL_RWwrite(output,block,blockalign,1);
+    }
+    delete[] block;
+    return SDL_RWclose(output) == 0;
+}
+
+/**
+ * Unit test for ADPCM decoding in WAV files
+ *
+ * The block decode splits the file into ranges that are decoded in
+ * parallel. It must match paging in one block at a time exactly.
+ */
+void cugl::testADPCM() {
+    CULog("Running tests for ADPCM decoding.\n");
+    
+    const std::string file = "adpcm.wav";
+    const Uint16 encodings[2] = {0x0002, 0x0011};
+    const char* names[2] = {"MS", "IMA"};
+    const Uint32 sizes[2] = {5, 301};
+    
+    srand(0);
+    cugl::Timestamp start, midl, end;
+    for(int ii = 0; ii < 2; ii++) {
+        for(Uint16 channels = 1; channels <= 2; channels++) {
+            for(int jj = 0; jj < 2; jj++) {
+                CUAssertAlwaysLog(writeADPCM(file,encodings[ii],channels,sizes[jj]),
+                                  "Could not write %s",file.c_str());
+                std::shared_ptr<audio::AudioDecoder> decoder = audio::WAVDecoder::alloc(file);
+                CUAssertAlwaysLog(decoder != nullptr, "%s decoder failed to load", names[ii]);
+                
+                Uint64 frames = decoder->getLength();
+                CUAssertAlwaysLog(frames == sizes[jj]*(Uint64)decoder->getPageSize(),
+                                  "%s has %llu frames, not %u blocks",
+                                  names[ii],(unsigned long long)frames,sizes[jj]);
+                float* output1 = new float[frames*channels];
+                float* output2 = new float[frames*channels];
+                
+                start.mark();
+                Sint32 total1 = decoder->decode(output1);
+                midl.mark();
+                decoder->rewind();
+                Sint32 total2 = 0;
+                Sint32 amt = 0;
+                do {
+                    amt = decoder->pagein(output2+total2*channels);
+                    total2 += amt;
+                } while (amt > 0);
+                end.mark();
+                
+                CUAssertAlwaysLog((Uint64)total1 == frames && (Uint64)total2 == frames,
+                                  "%s decoded %d and %d frames, not %llu",
+                                  names[ii],total1,total2,(unsigned long long)frames);
+                int same = -1;
+                for(Uint64 kk = 0; same == -1 && kk < frames*channels; kk++) {
+                    if (output1[kk] != output2[kk]) {
+                        same = (int)kk;
+                    }
+                }
+                CUAssertAlwaysLog(same == -1, "%s %s (%u blocks) failed at position %d [%f vs %f]",
+                                  names[ii],(channels == 1 ? "mono" : "stereo"),sizes[jj],
+                                  same,output1[same],output2[same]);
+                
+                CULog("%s %s (%u blocks) time: %llu vs %llu micros",
+                      names[ii],(channels == 1 ? "mono" : "stereo"),sizes[jj],
+                      cugl::Timestamp::ellapsedMicros(start,midl),
+                      cugl::Timestamp::ellapsedMicros(midl,end));
+                
+                delete[] output1;
+                delete[] output2;
+                decoder = nullptr;
+                remove(file.c_str());
+            }
+        }
+    }
+    
+    CULog("ADPCM tests complete.\n");
+}
+
 #pragma mark -
 #pragma mark Main
 
@@ -9336,6 +10148,7 @@ void cugl::mathUnitTest() {
     //testFrustum();
     testDSP();
     testFilters();
+    testADPCM();
     /*
     int i, count = SDL_GetNumAudioDevices(0);
     for (i = 0; i < count; ++i) {
@@ -122,6 +122,11 @@ void testDSP();
 
 void testFilters();
 
+/**
+ * Unit test for ADPCM decoding in WAV files
+ */
+void testADPCM();
+
 /**
  * Master unit test that invokes all others in this module.
  */
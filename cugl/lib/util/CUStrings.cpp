@@ -34,12 +34,14 @@
 //  Version: 2/10/21
 //
 #include <string>
+#include <cstring>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
 #include <utf8/utf8.h>
 #include <cugl/util/CUStrings.h>
 #include <cugl/util/CUDebug.h>
+#include <cugl/math/CUMathBase.h>
 
 #if defined (__ANDROID__)
 #include <cstdlib>
@@ -1258,8 +1260,7 @@ UnicodeType getUnicodeType(const char* substr, const char* end) {
 std::vector<Uint32> getCodePoints(const std::string str) {
     std::vector<Uint32> utf32;
     const char* begin = str.c_str();
-    const char* end = begin+str.size();
-    utf8::utf8to32(begin, end, back_inserter(utf32));
+    getCodePoints(begin, begin+str.size(), utf32);
     return utf32;
 }
 
@@ -1280,7 +1281,7 @@ std::vector<Uint32> getCodePoints(const std::string str) {
  */
 std::vector<Uint32> getCodePoints(const char* substr, const char* end) {
     std::vector<Uint32> utf32;
-    utf8::utf8to32(substr, end, back_inserter(utf32));
+    getCodePoints(substr, end, utf32);
     return utf32;
 }
 
@@ -1297,13 +1298,7 @@ std::vector<Uint32> getCodePoints(const char* substr, const char* end) {
  */
 size_t getUTF8Length(const std::string str) {
     const char* begin = str.c_str();
-    const char* end = begin+str.size();
-    size_t total = 0;
-    while (begin != end) {
-        utf8::next(begin,end);
-        total++;
-    }
-    return total;
+    return getUTF8Length(begin,begin+str.size());
 }
 
 /**
@@ -1326,11 +1321,158 @@ size_t getUTF8Length(const char* substr, const char* end)  {
     const char* begin = substr;
     size_t total = 0;
     while (begin != end) {
-        utf8::next(begin,end);
-        total++;
+        const char* ascii = skipASCII(begin,end);
+        total += ascii-begin;
+        begin = ascii;
+        if (begin != end) {
+            nextCodePoint(begin,end);
+            total++;
+        }
     }
     return total;
 }
 
+/**
+ * Returns true if str is a valid UTF8 string.
+ *
+ * ASCII runs are validated several bytes at a time (using SIMD where
+ * available), so this method is very fast on mostly ASCII text.
+ *
+ * @param str   The string to test
+ *
+ * @return true if str is a valid UTF8 string.
+ */
+bool isValidUTF8(const std::string& str) {
+    const char* begin = str.c_str();
+    return isValidUTF8(begin,begin+str.size());
+}
+
+/**
+ * Returns true if substr is a valid UTF8 string.
+ *
+ * The C-style string substr need not be null-terminated. Instead,
+ * the termination is indicated by the parameter end. This provides
+ * efficient substring processing.
+ *
+ * ASCII runs are validated several bytes at a time (using SIMD where
+ * available), so this method is very fast on mostly ASCII text.
+ *
+ * @param substr    The start of the string to test
+ * @param end       The end of the string to test
+ *
+ * @return true if substr is a valid UTF8 string.
+ */
+bool isValidUTF8(const char* substr, const char* end) {
+    const Uint8* pos  = (const Uint8*)skipASCII(substr,end);
+    const Uint8* last = (const Uint8*)end;
+    while (pos != last) {
+        Uint32 lead = *pos;
+        Uint32 code;
+        int extra;
+        if (lead < 0x80) {
+            pos = (const Uint8*)skipASCII((const char*)pos,end);
+            continue;
+        } else if (lead >= 0xC2 && lead <= 0xDF) {
+            extra = 1; code = lead & 0x1F;
+        } else if ((lead & 0xF0) == 0xE0) {
+            extra = 2; code = lead & 0x0F;
+        } else if (lead >= 0xF0 && lead <= 0xF4) {
+            extra = 3; code = lead & 0x07;
+        } else {
+            return false;
+        }
+
+        if (last-pos <= extra) {
+            return false;
+        }
+        for(int ii = 1; ii <= extra; ii++) {
+            if ((pos[ii] & 0xC0) != 0x80) {
+                return false;
+            }
+            code = (code << 6) | (pos[ii] & 0x3F);
+        }
+
+        // Reject overlong encodings, surrogates, and values past unicode
+        if ((extra == 2 && (code < 0x800 || (code >= 0xD800 && code <= 0xDFFF))) ||
+            (extra == 3 && (code < 0x10000 || code > 0x10FFFF))) {
+            return false;
+        }
+        pos += extra+1;
+    }
+    return true;
+}
+
+/**
+ * Returns a pointer to the first non-ASCII byte of substr.
+ *
+ * If substr is entirely ASCII, this function returns end. The bytes are
+ * scanned several at a time (using SIMD where available). Text decoders
+ * can use this to copy ASCII runs without decoding them.
+ *
+ * @param substr    The start of the string to scan
+ * @param end       The end of the string to scan
+ *
+ * @return a pointer to the first non-ASCII byte of substr.
+ */
+const char* skipASCII(const char* substr, const char* end) {
+#if defined (CU_MATH_VECTOR_SSE)
+    while (end-substr >= 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)substr);
+        if (_mm_movemask_epi8(chunk)) {
+            break;
+        }
+        substr += 16;
+    }
+#elif defined (CU_MATH_VECTOR_NEON64)
+    while (end-substr >= 16) {
+        uint8x16_t chunk = vld1q_u8((const uint8_t*)substr);
+        if (vmaxvq_u8(chunk) & 0x80) {
+            break;
+        }
+        substr += 16;
+    }
+#endif
+    // Eight bytes at a time (memcpy avoids unaligned access)
+    while (end-substr >= 8) {
+        Uint64 chunk;
+        std::memcpy(&chunk,substr,8);
+        if (chunk & 0x8080808080808080ULL) {
+            break;
+        }
+        substr += 8;
+    }
+    while (substr != end && (Uint8)*substr < 0x80) {
+        substr++;
+    }
+    return substr;
+}
+
+/**
+ * Appends the code points for the elements of substr to result.
+ *
+ * This is a version of {@link getCodePoints} that allows the caller to
+ * reuse a buffer. ASCII runs are copied without decoding. The string
+ * should be validated with {@link isValidUTF8} first.
+ *
+ * @param substr    The start of the string to convert
+ * @param end       The end of the string to convert
+ * @param result    The buffer to store the code points
+ *
+ * @return the number of code points appended
+ */
+size_t getCodePoints(const char* substr, const char* end, std::vector<Uint32>& result) {
+    size_t start = result.size();
+    const char* begin = substr;
+    while (begin != end) {
+        const char* ascii = skipASCII(begin,end);
+        result.insert(result.end(),(const Uint8*)begin,(const Uint8*)ascii);
+        begin = ascii;
+        if (begin != end) {
+            result.push_back(nextCodePoint(begin,end));
+        }
+    }
+    return result.size()-start;
+}
+
 }
 }
@@ -0,0 +1,162 @@
+//
+//  CUSymbol.cpp
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides interned strings (symbols). Much of the engine uses
+//  strings as keys (asset keys, node names, action keys, sound keys). These
+//  strings are hashed and compared on every look-up.  A symbol is a handle
+//  to a single, shared copy of a string, so two symbols are equal if and
+//  only if their handles are equal. This makes hashing and comparison O(1).
+//
+//  Symbols are never freed.  They should be used for a bounded set of names,
+//  like the keys in an asset directory, and not for arbitrary user text.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#include <cugl/util/CUSymbol.h>
+#include <unordered_map>
+#include <shared_mutex>
+#include <mutex>
+#include <deque>
+
+using namespace cugl;
+
+/**
+ * The global symbol table
+ *
+ * The entries are stored in a deque, as a deque never moves its elements
+ * when it grows. Look-ups take a shared lock, so that symbols may be found
+ * concurrently. Only interning a new string takes an exclusive lock.
+ */
+namespace {
+class SymbolTable {
+public:
+    /** The entries, which are never moved or freed */
+    std::deque<Symbol::Entry> entries;
+    /** The index from strings to entries */
+    std::unordered_map<std::string,const Symbol::Entry*> index;
+    /** The lock protecting the table */
+    std::shared_mutex mutex;
+
+    /**
+     * Creates the table with the empty symbol
+     */
+    SymbolTable() {
+        entries.push_back({std::string(),std::hash<std::string>()(std::string()),0});
+        index[entries.back().name] = &entries.back();
+    }
+
+    /**
+     * Returns the table singleton
+     *
+     * We use a function static so that symbols may be safely created
+     * during static initialization.
+     *
+     * @return the table singleton
+     */
+    static SymbolTable& get() {
+        static SymbolTable table;
+        return table;
+    }
+};
+}
+
+/**
+ * Returns the table entry for the empty string.
+ *
+ * @return the table entry for the empty string.
+ */
+const Symbol::Entry* Symbol::blank() {
+    static const Entry* entry = &SymbolTable::get().entries.front();
+    return entry;
+}
+
+/**
+ * Returns the table entry for the given string, adding it if necessary
+ *
+ * @param name  The string to intern
+ *
+ * @return the table entry for the given string
+ */
+const Symbol::Entry* Symbol::intern(const std::string& name) {
+    if (name.empty()) {
+        return blank();
+    }
+    
+    SymbolTable& table = SymbolTable::get();
+    {
+        std::shared_lock<std::shared_mutex> lock(table.mutex);
+        auto it = table.index.find(name);
+        if (it != table.index.end()) {
+            return it->second;
+        }
+    }
+    
+    std::unique_lock<std::shared_mutex> lock(table.mutex);
+    auto it = table.index.find(name);
+    if (it != table.index.end()) {
+        // Another thread interned it first
+        return it->second;
+    }
+    Uint32 id = (Uint32)table.entries.size();
+    table.entries.push_back({name,std::hash<std::string>()(name),id});
+    const Entry* entry = &table.entries.back();
+    table.index[entry->name] = entry;
+    return entry;
+}
+
+/**
+ * Returns the symbol for the given string, if it exists.
+ *
+ * Unlike the constructor, this method does not add the string to the
+ * global table. If the string has not been interned, this method returns
+ * false and leaves the symbol unchanged.
+ *
+ * @param name      The string to look up
+ * @param symbol    The symbol to store the result
+ *
+ * @return true if the string has been interned
+ */
+bool Symbol::find(const std::string& name, Symbol& symbol) {
+    SymbolTable& table = SymbolTable::get();
+    std::shared_lock<std::shared_mutex> lock(table.mutex);
+    auto it = table.index.find(name);
+    if (it == table.index.end()) {
+        return false;
+    }
+    symbol._entry = it->second;
+    return true;
+}
+
+/**
+ * Returns the number of symbols in the global table.
+ *
+ * This value includes the empty symbol.
+ *
+ * @return the number of symbols in the global table.
+ */
+size_t Symbol::count() {
+    SymbolTable& table = SymbolTable::get();
+    std::shared_lock<std::shared_mutex> lock(table.mutex);
+    return table.entries.size();
+}
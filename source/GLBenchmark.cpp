@@ -0,0 +1,257 @@
+//
+//  GLBenchmark.cpp
+//  Geometry Lab
+//
+//  This class runs the game scene without showing it, as a benchmark. It is
+//  not truly headless: SDL still creates a (hidden) window for the OpenGL
+//  context, so it needs a display. But it never shows the window, it draws to
+//  an offscreen render target, and it runs at a fixed tick with scripted input.
+//  The script drags each knob in turn, so every phase of the game loop
+//  (including the obstacle rebuild on release) is exercised. At the end it
+//  reports the time of each phase, the number of allocations per frame, and
+//  the number of OpenGL state changes per frame (both issued and filtered by
+//  GLState).
+//
+//  Allocations are only counted when the game is built with GEOMETRY_BENCHMARK
+//  defined, as that replaces the global operator new for the whole program.
+//  The CMake build defines it for the GeometryBenchmark target only.
+//
+//  Run it by passing --benchmark to the application (see main.cpp).
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#include "GLBenchmark.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace cugl;
+
+#pragma mark -
+#pragma mark Allocation Counting
+
+/** The number of calls to global operator new */
+static std::atomic<Uint64> alloc_count(0);
+
+#if defined (GEOMETRY_BENCHMARK)
+// Replacing the global allocator is the only portable way to count every
+// allocation (including those in CUGL and Box2D). It only adds a counter,
+// but it applies to the whole program, so it is not part of a normal build.
+void* operator new(std::size_t size) {
+    alloc_count.fetch_add(1,std::memory_order_relaxed);
+    void* result = std::malloc(size ? size : 1);
+    if (result == nullptr) {
+        throw std::bad_alloc();
+    }
+    return result;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+#endif
+
+#pragma mark -
+#pragma mark Script
+/** The fixed tick of the benchmark */
+#define TICK        (1.0f/60.0f)
+/** The frames to let the star settle */
+#define SETTLE      120
+/** The frames to drag each knob */
+#define DRAG        30
+/** The radius of the drag circle in screen coordinates */
+#define DRAG_RADIUS 40
+
+#pragma mark -
+#pragma mark Application State
+/**
+ * The method called after OpenGL is initialized.
+ *
+ * This creates the sprite batch, the offscreen target and the game scene.
+ * Unlike a normal application, it does not call the parent method, as
+ * that would show the window.
+ */
+void GeometryBenchmark::onStartup() {
+    _assets = AssetManager::alloc();
+    _batch  = SpriteBatch::alloc();
+    Size size = getDisplaySize();
+    _target = RenderTarget::alloc((int)size.width, (int)size.height);
+    _target->setClearColor(getClearColor());
+    _gameplay.init(_assets);
+}
+
+/**
+ * The method called when the benchmark is done.
+ */
+void GeometryBenchmark::onShutdown() {
+    _gameplay.dispose();
+    _target = nullptr;
+    _assets = nullptr;
+    _batch = nullptr;
+    Application::onShutdown();  // YOU MUST END with call to parent
+}
+
+#pragma mark -
+#pragma mark Benchmark
+/**
+ * Runs a single frame of the game with the given pointer state.
+ *
+ * @param down  Whether the pointer is pressed
+ * @param pos   The pointer position in screen coordinates
+ */
+void GeometryBenchmark::frame(bool down, const Vec2 pos) {
+    _gameplay.getInput().script(down,pos);
+
+    Uint64 allocs = alloc_count.load(std::memory_order_relaxed);
+    Timestamp start;
+    _gameplay.update(TICK);
+    GLState::resetStats();
+    _target->begin();
+    _gameplay.render(_batch);
+    _target->end();
+    // Include the GPU in the render time so that it is comparable
+    Timestamp mark;
+    glFinish();
+    Timestamp end;
+
+    GameScene::Profile profile = _gameplay.getProfile();
+    profile.render += end.ellapsedMicros(mark);
+    _profiles.push_back(profile);
+    _totals.push_back(end.ellapsedMicros(start));
+    _allocs.push_back(alloc_count.load(std::memory_order_relaxed)-allocs);
+    _issued.push_back(GLState::getIssued());
+    _filtered.push_back(GLState::getFiltered());
+}
+
+/**
+ * Runs the benchmark script the given number of times and logs the results.
+ *
+ * Each pass waits for the star to settle, and then drags each of the
+ * eight knobs around a small circle and releases it, waiting for the
+ * star to settle again after each release.
+ *
+ * @param passes    The number of times to run the script
+ */
+void GeometryBenchmark::run(int passes) {
+    size_t frames = passes*(SETTLE+8*(DRAG+2+SETTLE));
+    _profiles.clear();
+    _totals.clear();
+    _allocs.clear();
+    _issued.clear();
+    _filtered.clear();
+    _profiles.reserve(frames);
+    _totals.reserve(frames);
+    _allocs.reserve(frames);
+    _issued.reserve(frames);
+    _filtered.reserve(frames);
+
+    Vec2 pos;
+    for(int pass = 0; pass < passes; pass++) {
+        for(int ii = 0; ii < SETTLE; ii++) {
+            frame(false,pos);
+        }
+        for(int knob = 0; knob < 8; knob++) {
+            Vec2 center = _gameplay.getKnob(knob);
+            frame(true,center);
+            for(int ii = 1; ii <= DRAG; ii++) {
+                float angle = M_PI*2*ii/DRAG;
+                pos.set(center.x+DRAG_RADIUS*(1-cosf(angle)),center.y+DRAG_RADIUS*sinf(angle));
+                frame(true,pos);
+            }
+            frame(false,pos);
+            for(int ii = 0; ii < SETTLE; ii++) {
+                frame(false,pos);
+            }
+        }
+    }
+    report();
+}
+
+/**
+ * Returns the mean, median and maximum of the given values.
+ *
+ * @param values    The values to summarize
+ * @param mean      The mean of the values
+ * @param median    The median of the values
+ * @param most      The maximum of the values
+ */
+static void summarize(std::vector<Uint64> values, double& mean, Uint64& median, Uint64& most) {
+    mean = 0;
+    median = 0;
+    most = 0;
+    if (values.empty()) {
+        return;
+    }
+    for(auto it = values.begin(); it != values.end(); ++it) {
+        mean += *it;
+    }
+    mean /= values.size();
+    std::sort(values.begin(),values.end());
+    median = values[values.size()/2];
+    most = values.back();
+}
+
+/**
+ * Logs the statistics for the recorded frames.
+ */
+void GeometryBenchmark::report() const {
+    const char* names[] = { "input", "physics", "geometry", "rebuild", "render" };
+    Uint64 GameScene::Profile::* phases[] = {
+        &GameScene::Profile::input,
+        &GameScene::Profile::physics,
+        &GameScene::Profile::geometry,
+        &GameScene::Profile::rebuild,
+        &GameScene::Profile::render
+    };
+
+    double mean;
+    Uint64 median, most;
+    std::vector<Uint64> values;
+    values.reserve(_profiles.size());
+
+    CULog("Geometry benchmark: %zu frames at a fixed tick of %.4f s", _totals.size(), TICK);
+    CULog("%-10s %10s %10s %10s", "phase", "mean us", "median us", "max us");
+    for(int ii = 0; ii < 5; ii++) {
+        values.clear();
+        for(auto it = _profiles.begin(); it != _profiles.end(); ++it) {
+            values.push_back((*it).*phases[ii]);
+        }
+        summarize(values,mean,median,most);
+        CULog("%-10s %10.1f %10llu %10llu", names[ii], mean,
+              (unsigned long long)median, (unsigned long long)most);
+    }
+    summarize(_totals,mean,median,most);
+    CULog("%-10s %10.1f %10llu %10llu", "frame", mean,
+          (unsigned long long)median, (unsigned long long)most);
+#if defined (GEOMETRY_BENCHMARK)
+    summarize(_allocs,mean,median,most);
+    CULog("%-10s %10.1f %10llu %10llu", "allocs", mean,
+          (unsigned long long)median, (unsigned long long)most);
+#else
+    CULog("%-10s %10s (run the GeometryBenchmark build to count)", "allocs", "n/a");
+#endif
+    summarize(_issued,mean,median,most);
+    CULog("%-10s %10.1f %10llu %10llu", "gl issued", mean,
+          (unsigned long long)median, (unsigned long long)most);
+    summarize(_filtered,mean,median,most);
+    CULog("%-10s %10.1f %10llu %10llu", "gl skipped", mean,
+          (unsigned long long)median, (unsigned long long)most);
+}
@@ -0,0 +1,112 @@
+//
+//  GLBenchmark.h
+//  Geometry Lab
+//
+//  This class runs the game scene without showing it, as a benchmark. It is
+//  not truly headless: SDL still creates a (hidden) window for the OpenGL
+//  context, so it needs a display. But it never shows the window, it draws to
+//  an offscreen render target, and it runs at a fixed tick with scripted input.
+//  The script drags each knob in turn, so every phase of the game loop
+//  (including the obstacle rebuild on release) is exercised. At the end it
+//  reports the time of each phase and the number of allocations per frame.
+//
+//  Allocations are only counted when the game is built with GEOMETRY_BENCHMARK
+//  defined, as that replaces the global operator new for the whole program.
+//  The CMake build defines it for the GeometryBenchmark target only.
+//
+//  Run it by passing --benchmark to the application (see main.cpp).
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#ifndef __GL_BENCHMARK_H__
+#define __GL_BENCHMARK_H__
+#include <cugl/cugl.h>
+#include <vector>
+#include "GLGameScene.h"
+
+/**
+ * This class is a benchmark of the game scene that is never shown.
+ *
+ * This is an application so that the scene has a display size and an OpenGL
+ * context, but it never calls {@link Application#onStartup}, so the window
+ * that SDL creates for the context stays hidden. Instead of {@link Application#step}, the benchmark is driven
+ * by {@link #run}, which uses a fixed tick so that the results do not depend
+ * on the speed of the machine.
+ */
+class GeometryBenchmark : public cugl::Application {
+protected:
+    /** The sprite batch for drawing the scene */
+    std::shared_ptr<cugl::SpriteBatch> _batch;
+    /** The (empty) asset manager for the scene */
+    std::shared_ptr<cugl::AssetManager> _assets;
+    /** The offscreen render target */
+    std::shared_ptr<cugl::RenderTarget> _target;
+    /** The game scene to benchmark */
+    GameScene _gameplay;
+
+    /** The phase timings of each frame */
+    std::vector<GameScene::Profile> _profiles;
+    /** The total time of each frame in microseconds */
+    std::vector<Uint64> _totals;
+    /** The number of allocations in each frame */
+    std::vector<Uint64> _allocs;
+    /** The number of OpenGL state changes issued in each frame */
+    std::vector<Uint64> _issued;
+    /** The number of redundant OpenGL state changes filtered in each frame */
+    std::vector<Uint64> _filtered;
+
+    /**
+     * Runs a single frame of the game with the given pointer state.
+     *
+     * @param down  Whether the pointer is pressed
+     * @param pos   The pointer position in screen coordinates
+     */
+    void frame(bool down, const cugl::Vec2 pos);
+
+    /**
+     * Logs the statistics for the recorded frames.
+     */
+    void report() const;
+
+public:
+    /**
+     * Creates, but does not initialize, a new benchmark.
+     *
+     * As with {@link GeometryApp}, all initialization happens in init() and
+     * {@link #onStartup}.
+     */
+    GeometryBenchmark() : cugl::Application() {}
+
+    /**
+     * Disposes of all resources allocated by this benchmark.
+     */
+    ~GeometryBenchmark() { }
+
+    /**
+     * The method called after OpenGL is initialized.
+     *
+     * This creates the sprite batch, the offscreen target and the game scene.
+     * Unlike a normal application, it does not call the parent method, as
+     * that would show the window.
+     */
+    virtual void onStartup() override;
+
+    /**
+     * The method called when the benchmark is done.
+     */
+    virtual void onShutdown() override;
+
+    /**
+     * Runs the benchmark script the given number of times and logs the results.
+     *
+     * Each pass waits for the star to settle, and then drags each of the
+     * eight knobs around a small circle and releases it, waiting for the
+     * star to settle again after each release.
+     *
+     * @param passes    The number of times to run the script
+     */
+    void run(int passes);
+};
+
+#endif /* __GL_BENCHMARK_H__ */
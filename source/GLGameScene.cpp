@@ -162,6 +162,8 @@ void GameScene::dispose() {
 void GameScene::update(float timestep) {
     // We always need to call this to update the state of input variables
     // This SYNCHRONIZES the call back functions with the animation frame.
+    Timestamp start;
+    _profile.physics = 0;
     _input.update();
 
     //CULog("%f", timestep);
@@ -175,9 +177,11 @@ void GameScene::update(float timestep) {
         _spline.setTangent(sel, Vec2().add(_spline.getTangent(sel)).add(mouse_pos_vec2).subtract(mouse_pre_vec2), true);
     }
     else {
+        Timestamp step;
         _world->update(timestep);
         _duplicate_world->update(previous_timestep);
         previous_timestep = timestep;
+        _profile.physics = Timestamp().ellapsedMicros(step);
     }
 
     if (_input.didPress()) {
@@ -190,9 +194,15 @@ void GameScene::update(float timestep) {
         }
     }
 
+    // Input is everything before this point except for physics
+    Timestamp phase;
+    _profile.input = phase.ellapsedMicros(start)-_profile.physics;
+
     _handles.clear();
     _knobs.clear();
     buildGeometry();
+    start.mark();
+    _profile.geometry = start.ellapsedMicros(phase);
 
     if (_input.didRelease()) {
         sel = -1;
@@ -203,6 +213,8 @@ void GameScene::update(float timestep) {
         _world->resetTime();
         _duplicate_world->resetTime();
     }
+    phase.mark();
+    _profile.rebuild = phase.ellapsedMicros(start);
 
     //if (_world->getTime() % 100 == 0) {
     //    CULog("leftworld, %d, %f", _world->getTime(), _star->getPosition().x);
@@ -237,6 +249,7 @@ void GameScene::update(float timestep) {
  * @param batch     The SpriteBatch to draw with.
  */
 void GameScene::render(const std::shared_ptr<cugl::SpriteBatch>& batch) {
+    Timestamp start;
    
     // DO NOT DO THIS IN YOUR FINAL GAME
     batch->begin(getCamera()->getCombined());
@@ -269,6 +282,7 @@ void GameScene::render(const std::shared_ptr<cugl::SpriteBatch>& batch) {
     }
     // batch->drawText(to_string(previous_timestep), Font::Font(), getSize() / 2);
     batch->end();
+    _profile.render = Timestamp().ellapsedMicros(start);
 }
 
 /**
@@ -24,6 +24,32 @@
  * so that we can have a separate mode for the loading screen.
  */
 class GameScene : public cugl::Scene2 {
+public:
+    /**
+     * The time spent in each phase of the last frame, in microseconds.
+     *
+     * This is used by the headless benchmark. The update phases are set by
+     * {@link #update} and the render phase by {@link #render}.
+     */
+    class Profile {
+    public:
+        /** The time to read input and select a knob */
+        Uint64 input;
+        /** The time to step both physics worlds */
+        Uint64 physics;
+        /** The time to rebuild the spline, handle and star polygons */
+        Uint64 geometry;
+        /** The time to rebuild the obstacles after a knob is released */
+        Uint64 rebuild;
+        /** The time to draw the scene */
+        Uint64 render;
+
+        /**
+         * Creates a profile with all phases zero.
+         */
+        Profile() : input(0), physics(0), geometry(0), rebuild(0), render(0) {}
+    };
+
 protected:
     // CONTROLLERS are attached directly to the scene (no pointers)
     /** The controller to manage the ship */
@@ -60,6 +86,9 @@ protected:
     /** The falling star */
     std::shared_ptr<cugl::physics2::PolygonObstacle> _duplicate_star;
 
+    /** The phase timings of the last frame */
+    Profile _profile;
+
     // PUT OTHER ATTRIBUTES HERE AS NECESSARY
 
     /**
@@ -138,6 +167,38 @@ public:
      * @param batch     The SpriteBatch to draw with.
      */
     void render(const std::shared_ptr<cugl::SpriteBatch>& batch) override;
+
+#pragma mark -
+#pragma mark Benchmarking
+    /**
+     * Returns the phase timings of the last frame.
+     *
+     * @return the phase timings of the last frame.
+     */
+    const Profile& getProfile() const { return _profile; }
+
+    /**
+     * Returns the input controller for this scene.
+     *
+     * The headless benchmark uses this to script knob drags.
+     *
+     * @return the input controller for this scene.
+     */
+    InputController& getInput() { return _input; }
+
+    /**
+     * Returns the screen position of the given knob.
+     *
+     * The knobs are the spline tangents, indexed 0 to 7.
+     *
+     * @param index The knob index
+     *
+     * @return the screen position of the given knob.
+     */
+    cugl::Vec2 getKnob(int index) const {
+        cugl::Vec2 pos = _spline.getTangent(index)+getSize()/2;
+        return worldToScreenCoords(pos);
+    }
 };
 
 #endif /* __SG_GAME_SCENE_H__ */
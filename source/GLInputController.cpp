@@ -29,7 +29,9 @@ _active(false),
 _currDown(false),
 _prevDown(false),
 _mouseDown(false),
-_mouseKey(0) {
+_mouseKey(0),
+_touchKey(0),
+_touchDown(false) {
 }
 
 
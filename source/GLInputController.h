@@ -170,6 +170,21 @@ public:
         return _currDown;
     }
 
+    /**
+     * Sets the pointer state as if it came from a device.
+     *
+     * This method is used to script input when there is no mouse or touch
+     * screen, such as in the headless benchmark. The state takes effect at
+     * the next call to {@link #update}, exactly like a device callback.
+     *
+     * @param down  Whether the pointer is pressed
+     * @param pos   The pointer position in screen coordinates
+     */
+    void script(bool down, const cugl::Vec2 pos) {
+        _mouseDown = _touchDown = down;
+        _mousePos  = _touchPos  = pos;
+    }
+
 #pragma mark Mouse Callbacks
 private:
     /**
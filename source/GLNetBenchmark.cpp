@@ -0,0 +1,324 @@
+//
+//  GLNetBenchmark.cpp
+//  Geometry Lab
+//
+//  This class benchmarks a networked physics session on localhost. It builds
+//  a world of falling boxes, serves it over UDP to an increasing number of
+//  clients (all in this process), and reports the cost of a server tick and
+//  the bandwidth it uses for each client count. It then measures the cost of
+//  client-side prediction on a larger world, over a simulated network.
+//
+//  Run it by passing --netbench to the application (see main.cpp).
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#include "GLNetBenchmark.h"
+#include <algorithm>
+#include <cstdio>
+
+using namespace cugl;
+using namespace cugl::physics2;
+
+#pragma mark -
+#pragma mark Settings
+/** The fixed tick of the benchmark */
+#define TICK        (1.0f/60.0f)
+/** The number of frames to wait for all of the clients to connect */
+#define CONNECT     120
+/** The largest number of clients */
+#define MAX_CLIENTS 32
+/** The number of boxes in each row of the world */
+#define ROW_SIZE    30
+/** The width of the world in physics units */
+#define WORLD_WIDTH     64
+/** The height of the world in physics units */
+#define WORLD_HEIGHT    36
+/** The id of the floor (any id larger than the number of boxes) */
+#define FLOOR_ID    0xFFFFFF
+/** The number of boxes in the prediction benchmark */
+#define PREDICT_BODIES  1000
+/** The one-way latency of the prediction benchmark (enough to fill the window) */
+#define PREDICT_LATENCY 0.05f
+/** The number of ticks the predictor can rewind */
+#define PREDICT_WINDOW  8
+/** The number of ticks that the predictor pushes in each direction */
+#define PREDICT_PERIOD  40
+/** The impulse of a single push */
+#define PREDICT_IMPULSE 0.3f
+/** The index of the pushed box (after the floor and the walls) */
+#define PREDICT_TARGET  3
+
+#pragma mark -
+#pragma mark Benchmark
+/**
+ * Returns a newly allocated world for the benchmark.
+ *
+ * The world is a grid of boxes over a static floor between two walls. The
+ * boxes are given assorted initial velocities so that they stay awake for
+ * a while. The bodies have the same ids in every world built, so that the
+ * server and clients agree.
+ *
+ * @param bodies    The number of boxes
+ *
+ * @return a newly allocated world for the benchmark.
+ */
+std::shared_ptr<ObstacleWorld> NetBenchmark::build(int bodies) const {
+    Rect bounds(0,0,WORLD_WIDTH,WORLD_HEIGHT);
+    std::shared_ptr<ObstacleWorld> world = ObstacleWorld::alloc(bounds,Vec2(0,-9.8f));
+
+    std::shared_ptr<BoxObstacle> floor = BoxObstacle::alloc(Vec2(WORLD_WIDTH/2,0.5f),Size(WORLD_WIDTH,1));
+    floor->setBodyType(b2_staticBody);
+    floor->setId(FLOOR_ID);
+    world->addObstacle(floor);
+    for(int ii = 0; ii < 2; ii++) {
+        Vec2 pos(ii == 0 ? 0.5f : WORLD_WIDTH-0.5f,WORLD_HEIGHT);
+        std::shared_ptr<BoxObstacle> wall = BoxObstacle::alloc(pos,Size(1,2*WORLD_HEIGHT));
+        wall->setBodyType(b2_staticBody);
+        wall->setId(FLOOR_ID+ii+1);
+        world->addObstacle(wall);
+    }
+
+    for(int ii = 0; ii < bodies; ii++) {
+        Vec2 pos(2+(ii % ROW_SIZE)*2.0f,3+(ii / ROW_SIZE)*1.5f);
+        std::shared_ptr<BoxObstacle> box = BoxObstacle::alloc(pos,Size(1,1));
+        box->setId(ii+1);
+        box->setDensity(1.0f);
+        box->setLinearVelocity(Vec2((ii % 7)-3.0f,(float)(ii % 5)));
+        world->addObstacle(box);
+    }
+    return world;
+}
+
+/**
+ * Pushes the target box of the prediction benchmark.
+ *
+ * The input is a single byte for the direction: 1 for right, and any other
+ * value for left. This is the input function for both the server and the
+ * predictor.
+ *
+ * @param world The world to push in
+ * @param data  The input bytes
+ * @param size  The number of input bytes
+ */
+static void push(ObstacleWorld* world, const Uint8* data, size_t size) {
+    if (size == 0) {
+        return;
+    }
+    b2Body* body = world->getObstacles()[PREDICT_TARGET]->getRealBody();
+    float dir = (data[0] == 1 ? 1.0f : -1.0f);
+    body->ApplyLinearImpulseToCenter(b2Vec2(dir*PREDICT_IMPULSE,PREDICT_IMPULSE),true);
+}
+
+/**
+ * Runs a session with the given number of clients.
+ *
+ * The recorded statistics are replaced by those of this session. This
+ * method returns false if the session could not be set up.
+ *
+ * @param clients   The number of clients
+ * @param ticks     The number of server ticks to record
+ *
+ * @return true if the session ran successfully.
+ */
+bool NetBenchmark::session(int clients, int ticks) {
+    _steps.clear();
+    _sends.clear();
+    _bytes.clear();
+
+    std::shared_ptr<UDPTransport> transport = UDPTransport::alloc();
+    if (transport == nullptr) {
+        return false;
+    }
+    std::shared_ptr<PhysicsServer> server = PhysicsServer::alloc(build(_bodies),transport,TICK);
+    if (server == nullptr) {
+        return false;
+    }
+
+    std::vector<std::shared_ptr<PhysicsClient>> peers;
+    for(int ii = 0; ii < clients; ii++) {
+        std::shared_ptr<UDPTransport> local = UDPTransport::alloc();
+        if (local == nullptr) {
+            return false;
+        }
+        Uint32 address = local->addPeer("127.0.0.1",transport->getPort());
+        std::shared_ptr<PhysicsClient> client = PhysicsClient::alloc(build(_bodies),local,address);
+        if (client == nullptr) {
+            return false;
+        }
+        peers.push_back(client);
+    }
+
+    // Let every client join before we start recording
+    for(int ii = 0; ii < CONNECT && server->getClientCount() < (size_t)clients; ii++) {
+        server->update(TICK);
+        for(auto it = peers.begin(); it != peers.end(); ++it) {
+            (*it)->update(TICK);
+        }
+    }
+    if (server->getClientCount() < (size_t)clients) {
+        CULogError("Only %zu of %d clients connected", server->getClientCount(), clients);
+        return false;
+    }
+
+    _steps.reserve(ticks);
+    _sends.reserve(ticks);
+    _bytes.reserve(ticks);
+    while (_steps.size() < (size_t)ticks) {
+        Uint32 tick = server->getTick();
+        server->update(TICK);
+        if (server->getTick() != tick) {
+            _steps.push_back(server->getStepTime());
+            _sends.push_back(server->getSendTime());
+            _bytes.push_back(server->getTickBytes());
+        }
+        for(auto it = peers.begin(); it != peers.end(); ++it) {
+            (*it)->update(TICK);
+        }
+    }
+    return true;
+}
+
+/**
+ * Runs a session with a single predicting client.
+ *
+ * The recorded prediction statistics are replaced by those of this
+ * session. This method returns false if the session could not be set up.
+ *
+ * @param ticks     The number of ticks to record
+ *
+ * @return true if the session ran successfully.
+ */
+bool NetBenchmark::predict(int ticks) {
+    _frames.clear();
+    _replays.clear();
+    _replayTicks = 0;
+    _deferred = 0;
+    _overruns = 0;
+
+    std::shared_ptr<LoopbackNetwork> network = LoopbackNetwork::alloc(PREDICT_LATENCY);
+    std::shared_ptr<LoopbackTransport> transport = LoopbackTransport::alloc(network);
+    std::shared_ptr<LoopbackTransport> local = LoopbackTransport::alloc(network);
+    std::shared_ptr<ObstacleWorld> world = build(PREDICT_BODIES);
+    std::shared_ptr<ObstacleWorld> copy  = build(PREDICT_BODIES);
+    std::shared_ptr<PhysicsServer> server = PhysicsServer::alloc(world,transport,TICK);
+    std::shared_ptr<PhysicsPredictor> predictor = PhysicsPredictor::alloc(copy,local,transport->getAddress(),
+                                                                          PREDICT_WINDOW);
+    if (server == nullptr || predictor == nullptr) {
+        return false;
+    }
+    server->onInput = [&](Uint32, Uint32, const Uint8* data, size_t size) {
+        push(world.get(),data,size);
+    };
+    predictor->onInput = [&](Uint32, const Uint8* data, size_t size) {
+        push(copy.get(),data,size);
+    };
+
+    // Wait until the predictor has measured the latency and is running ahead
+    int frame = 0;
+    for(; frame < CONNECT && !predictor->isPredicting(); frame++) {
+        server->update(TICK);
+        predictor->update(TICK);
+        network->update(TICK);
+    }
+    if (!predictor->isPredicting()) {
+        CULogError("The predictor never connected");
+        return false;
+    }
+
+    _frames.reserve(ticks);
+    for(int ii = 0; ii < ticks; ii++, frame++) {
+        Uint8 input = ((frame / PREDICT_PERIOD) % 2 ? 1 : 2);
+        predictor->setInput(&input,1);
+        server->update(TICK);
+        Timestamp start;
+        predictor->update(TICK);
+        Uint64 time = Timestamp().ellapsedMicros(start);
+        _frames.push_back(time);
+        if (time > predictor->getBudget()*1000000) {
+            _overruns++;
+        }
+        if (predictor->getReplayTicks() > 0) {
+            _replays.push_back(predictor->getReplayTime());
+            _replayTicks = std::max(_replayTicks,predictor->getReplayTicks());
+        }
+        _deferred += predictor->getDeferred();
+        network->update(TICK);
+    }
+    return true;
+}
+
+/**
+ * Returns the mean, median and maximum of the given values.
+ *
+ * @param values    The values to summarize
+ * @param mean      The mean of the values
+ * @param median    The median of the values
+ * @param most      The maximum of the values
+ */
+static void summarize(std::vector<Uint64> values, double& mean, Uint64& median, Uint64& most) {
+    mean = 0;
+    median = 0;
+    most = 0;
+    if (values.empty()) {
+        return;
+    }
+    for(auto it = values.begin(); it != values.end(); ++it) {
+        mean += *it;
+    }
+    mean /= values.size();
+    std::sort(values.begin(),values.end());
+    median = values[values.size()/2];
+    most = values.back();
+}
+
+/**
+ * Runs the benchmark for each client count and logs the results.
+ *
+ * The client counts are the powers of two from 1 to 32. Afterwards,
+ * this runs and logs the prediction benchmark.
+ *
+ * @param ticks     The number of server ticks to record for each count
+ */
+void NetBenchmark::run(int ticks) {
+    CULog("Network benchmark: %d bodies, %d ticks of %.4f s over UDP on localhost",
+          _bodies, ticks, TICK);
+    CULog("%-8s %10s %10s %10s %10s %10s %10s %12s %10s", "clients",
+          "step us", "median us", "max us", "send us", "median us", "max us",
+          "bytes/tick", "KB/s");
+
+    double mean;
+    Uint64 median, most;
+    for(int clients = 1; clients <= MAX_CLIENTS; clients *= 2) {
+        if (!session(clients,ticks)) {
+            CULogError("Could not run a session with %d clients", clients);
+            return;
+        }
+        summarize(_steps,mean,median,most);
+        char step[40];
+        snprintf(step, sizeof(step), "%10.1f %10llu %10llu", mean,
+                 (unsigned long long)median, (unsigned long long)most);
+        summarize(_sends,mean,median,most);
+        char send[40];
+        snprintf(send, sizeof(send), "%10.1f %10llu %10llu", mean,
+                 (unsigned long long)median, (unsigned long long)most);
+        summarize(_bytes,mean,median,most);
+        CULog("%-8d %s %s %12.1f %10.1f", clients, step, send, mean, mean/(1024*TICK));
+    }
+
+    CULog("Prediction benchmark: %d bodies, window of %d ticks, %.0f ms latency, %.0f ms budget, %d ticks",
+          PREDICT_BODIES, PREDICT_WINDOW, PREDICT_LATENCY*1000, DEFAULT_NET_BUDGET*1000, ticks);
+    if (!predict(ticks)) {
+        CULogError("Could not run a prediction session");
+        return;
+    }
+    CULog("%10s %10s %10s %10s %10s %10s %10s %10s %10s %10s", "frame us", "median us", "max us",
+          "overruns", "replays", "replay us", "median us", "max us", "max ticks", "deferred");
+    summarize(_frames,mean,median,most);
+    char frame[40];
+    snprintf(frame, sizeof(frame), "%10.1f %10llu %10llu", mean,
+             (unsigned long long)median, (unsigned long long)most);
+    summarize(_replays,mean,median,most);
+    CULog("%s %10d %10zu %10.1f %10llu %10llu %10u %10zu", frame, _overruns, _replays.size(), mean,
+          (unsigned long long)median, (unsigned long long)most, _replayTicks, _deferred);
+}
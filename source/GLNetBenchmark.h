@@ -0,0 +1,117 @@
+//
+//  GLNetBenchmark.h
+//  Geometry Lab
+//
+//  This class benchmarks a networked physics session on localhost. It builds
+//  a world of falling boxes, serves it over UDP to an increasing number of
+//  clients (all in this process), and reports the cost of a server tick and
+//  the bandwidth it uses for each client count. It then measures the cost of
+//  client-side prediction on a larger world, over a simulated network.
+//
+//  Run it by passing --netbench to the application (see main.cpp).
+//
+//  Author: agent
+//  Version: 10/18/26
+//
+#ifndef __GL_NET_BENCHMARK_H__
+#define __GL_NET_BENCHMARK_H__
+#include <cugl/cugl.h>
+#include <vector>
+
+/**
+ * This class is a benchmark of a networked physics session.
+ *
+ * Unlike {@link GeometryBenchmark}, this is not an application, as it needs
+ * neither a window nor an OpenGL context. The server and the clients all
+ * run in this process and talk over UDP sockets on 127.0.0.1, so the results
+ * include the cost of the socket calls but not of a real network.
+ *
+ * Each client simulates its own copy of the world, as a real client would,
+ * but only the server is timed.
+ *
+ * The prediction benchmark is the other way around. A single predictor
+ * (see {@link cugl::physics2::PhysicsPredictor}) pushes a box around while
+ * connected over a loopback network with enough latency to fill its window.
+ * Only the predictor is timed.
+ */
+class NetBenchmark {
+protected:
+    /** The number of dynamic bodies in the world */
+    int _bodies;
+
+    /** The time to step the world each tick in microseconds */
+    std::vector<Uint64> _steps;
+    /** The time to send the state each tick in microseconds */
+    std::vector<Uint64> _sends;
+    /** The bytes sent by the server each tick */
+    std::vector<Uint64> _bytes;
+    /** The time of each predictor update in microseconds */
+    std::vector<Uint64> _frames;
+    /** The time of each predictor replay in microseconds */
+    std::vector<Uint64> _replays;
+    /** The largest number of ticks in a replay */
+    Uint32 _replayTicks;
+    /** The number of mispredicted bodies deferred to a later server state */
+    size_t _deferred;
+    /** The number of predictor updates over the budget */
+    int _overruns;
+
+    /**
+     * Returns a newly allocated world for the benchmark.
+     *
+     * The world is a grid of boxes over a static floor between two walls. The
+     * boxes are given assorted initial velocities so that they stay awake for
+     * a while. The bodies have the same ids in every world built, so that the
+     * server and clients agree.
+     *
+     * @param bodies    The number of boxes
+     *
+     * @return a newly allocated world for the benchmark.
+     */
+    std::shared_ptr<cugl::physics2::ObstacleWorld> build(int bodies) const;
+
+    /**
+     * Runs a session with the given number of clients.
+     *
+     * The recorded statistics are replaced by those of this session. This
+     * method returns false if the session could not be set up.
+     *
+     * @param clients   The number of clients
+     * @param ticks     The number of server ticks to record
+     *
+     * @return true if the session ran successfully.
+     */
+    bool session(int clients, int ticks);
+
+    /**
+     * Runs a session with a single predicting client.
+     *
+     * The recorded prediction statistics are replaced by those of this
+     * session. This method returns false if the session could not be set up.
+     *
+     * @param ticks     The number of ticks to record
+     *
+     * @return true if the session ran successfully.
+     */
+    bool predict(int ticks);
+
+public:
+    /**
+     * Creates a new benchmark with the given number of bodies.
+     *
+     * @param bodies    The number of dynamic bodies in the world
+     */
+    NetBenchmark(int bodies=300) : _bodies(bodies), _replayTicks(0), _deferred(0), _overruns(0) {}
+
+    /**
+     * Runs the benchmark for each client count and logs the results.
+     *
+     * The client counts are the powers of two from 1 to 32. Afterwards,
+     * this runs and logs the prediction benchmark.
+     *
+     * @param ticks     The number of server ticks to record for each count
+     */
+    void run(int ticks);
+};
+
+#endif /* __GL_NET_BENCHMARK_H__ */
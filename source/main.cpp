@@ -29,6 +29,9 @@
 
 // Include your application class
 #include "GLApp.h"
+#include "GLBenchmark.h"
+#include "GLNetBenchmark.h"
+#include <cstring>
 
 using namespace cugl;
 
@@ -42,6 +45,28 @@ using namespace cugl;
  * @return the exit status of the application
  */
 int main(int argc, char * argv[]) {
+    // Run headless with --benchmark [passes]
+    if (argc > 1 && strcmp(argv[1],"--benchmark") == 0) {
+        GeometryBenchmark bench;
+        bench.setName("Geometry Lab");
+        bench.setOrganization("GDIAC");
+        bench.setDisplaySize(1280, 720);
+        if (!bench.init()) {
+            return 1;
+        }
+        bench.onStartup();
+        bench.run(argc > 2 ? std::max(atoi(argv[2]),1) : 3);
+        bench.onShutdown();
+        return 0;
+    }
+
+    // Run the network benchmark with --netbench [ticks]
+    if (argc > 1 && strcmp(argv[1],"--netbench") == 0) {
+        NetBenchmark bench;
+        bench.run(argc > 2 ? std::max(atoi(argv[2]),1) : 600);
+        return 0;
+    }
+
     // Change this to your application class
     GeometryApp app;
     